@@ -7,6 +7,7 @@
 #include <cmath>
 #include <cstddef>
 
+#include "AudioCommon/Enums.h"
 #include "Common/Logging/Log.h"
 #include "Core/Config/MainSettings.h"
 
@@ -18,6 +19,16 @@ AudioStretcher::AudioStretcher(unsigned int sample_rate) : m_sample_rate(sample_
   m_sound_touch.setSampleRate(sample_rate);
   m_sound_touch.setPitch(1.0);
   m_sound_touch.setTempo(1.0);
+
+  if (Config::Get(Config::MAIN_AUDIO_STRETCH_QUALITY) == StretchQuality::Fast)
+  {
+    // Fixed, short sequences with a coarse overlap search, instead of SoundTouch's tempo-dependent
+    // sequence lengths and full search. This keeps the cost flat when emulation slows down.
+    m_sound_touch.setSetting(SETTING_USE_QUICKSEEK, 1);
+    m_sound_touch.setSetting(SETTING_SEQUENCE_MS, 40);
+    m_sound_touch.setSetting(SETTING_SEEKWINDOW_MS, 15);
+    m_sound_touch.setSetting(SETTING_OVERLAP_MS, 8);
+  }
 }
 
 void AudioStretcher::Clear()
@@ -32,7 +43,10 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
   // We were given actual_samples number of samples, and num_samples were requested from us.
   double current_ratio = static_cast<double>(num_in) / static_cast<double>(num_out);
 
-  const double max_latency = Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY);
+  // With a latency target, size the backlog so that the 50% point below lands on the target.
+  const int target_latency = Config::Get(Config::MAIN_AUDIO_TARGET_LATENCY);
+  const double max_latency = target_latency > 0 ? target_latency * 2.0 :
+                                                  Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY);
   const double max_backlog = m_sample_rate * max_latency / 1000.0 / m_stretch_ratio;
   const double backlog_fullness = m_sound_touch.numSamples() / max_backlog;
   if (backlog_fullness > 5.0)
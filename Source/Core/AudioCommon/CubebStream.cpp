@@ -13,6 +13,7 @@
 
 // ~10 ms - needs to be at least 240 for surround
 constexpr u32 BUFFER_SAMPLES = 512;
+constexpr u32 SURROUND_MIN_BUFFER_SAMPLES = 240;
 
 long CubebStream::DataCallback(cubeb_stream* stream, void* user_data, const void* /*input_buffer*/,
                                void* output_buffer, long num_frames)
@@ -59,9 +60,17 @@ bool CubebStream::Init()
     ERROR_LOG_FMT(AUDIO, "Error getting minimum latency");
   INFO_LOG_FMT(AUDIO, "Minimum latency: {} frames", minimum_latency);
 
+  // When targeting latency, ask for the smallest buffer the backend supports and let the mixer
+  // keep the rest of the target queued.
+  u32 buffer_samples = std::max(BUFFER_SAMPLES, minimum_latency);
+  if (Config::Get(Config::MAIN_AUDIO_TARGET_LATENCY) > 0 && minimum_latency != 0)
+    buffer_samples =
+        m_stereo ? minimum_latency : std::max(SURROUND_MIN_BUFFER_SAMPLES, minimum_latency);
+  INFO_LOG_FMT(AUDIO, "Requested latency: {} frames", buffer_samples);
+
   return cubeb_stream_init(m_ctx.get(), &m_stream, "Dolphin Audio Output", nullptr, nullptr,
-                           nullptr, &params, std::max(BUFFER_SAMPLES, minimum_latency),
-                           DataCallback, StateCallback, this) == CUBEB_OK;
+                           nullptr, &params, buffer_samples, DataCallback, StateCallback,
+                           this) == CUBEB_OK;
 }
 
 bool CubebStream::SetRunning(bool running)
@@ -12,4 +12,10 @@ enum class DPL2Quality
   High = 2,
   Highest = 3
 };
+
+enum class StretchQuality
+{
+  Fast = 0,
+  Normal = 1
+};
 }  // namespace AudioCommon
@@ -105,33 +105,63 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
+  // Copy the input frames this call can reach into a linear, host-endian block first, so that the
+  // interpolation loop below runs without index masking or byte swaps and can be vectorized.
+  const s32 available_frames = static_cast<s32>(((indexW - indexR) & INDEX_MASK) / 2);
+  const u64 reachable_frames =
+      numSamples ? ((m_frac + static_cast<u64>(ratio) * (numSamples - 1)) >> 16) + 2 : 0;
+  const u32 block_frames =
+      static_cast<u32>(std::min<u64>(static_cast<u64>(available_frames), reachable_frames));
+  {
+    const u32 start = indexR & INDEX_MASK;
+    const u32 first_part = std::min(block_frames * 2, MAX_SAMPLES * 2 - start);
+    std::memcpy(m_block.data(), &m_buffer[start], first_part * sizeof(s16));
+    std::memcpy(m_block.data() + first_part, m_buffer.data(),
+                (block_frames * 2 - first_part) * sizeof(s16));
+    if (!m_little_endian)
+    {
+      for (u32 i = 0; i < block_frames * 2; ++i)
+        m_block[i] = Common::swap16(m_block[i]);
+    }
+  }
+
   // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  s32 frame = 0;
+  u32 frac = m_frac;
+  for (; currentSample < numSamples * 2 && available_frames - frame >= 2; currentSample += 2)
   {
-    u32 indexR2 = indexR + 2;  // next sample
+    const s16* in = &m_block[frame * 2];
 
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
+    s16 l1 = in[0];  // current
+    s16 l2 = in[2];  // next
+    int sampleL = ((l1 << 16) + (l2 - l1) * static_cast<u16>(frac)) >> 16;
     sampleL = (sampleL * lvolume) >> 8;
     sampleL += samples[currentSample + 1];
     samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
 
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
+    s16 r1 = in[1];  // current
+    s16 r2 = in[3];  // next
+    int sampleR = ((r1 << 16) + (r2 - r1) * static_cast<u16>(frac)) >> 16;
     sampleR = (sampleR * rvolume) >> 8;
     sampleR += samples[currentSample];
     samples[currentSample] = std::clamp(sampleR, -32767, 32767);
 
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    frac += ratio;
+    frame += static_cast<u16>(frac >> 16);
+    frac &= 0xffff;
   }
+  m_frac = frac;
+  indexR += 2 * frame;
 
   // Actual number of samples written to the buffer without padding.
   unsigned int actual_sample_count = currentSample / 2;
 
+  // Count each time this source runs dry, rather than every callback it stays empty for.
+  const bool starved = actual_sample_count < numSamples;
+  if (starved && !m_starved)
+    m_underrun_count.fetch_add(1, std::memory_order_relaxed);
+  m_starved = starved;
+
   // Padding
   short s[2];
   s[0] = read_buffer((indexR - 1) & INDEX_MASK);
@@ -161,7 +191,8 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
   const float emulation_speed = m_config_emulation_speed;
-  const int timing_variance = m_config_timing_variance;
+  const int timing_variance =
+      m_config_target_latency > 0 ? m_config_target_latency : m_config_timing_variance;
   if (m_config_audio_stretch)
   {
     unsigned int available_samples =
@@ -427,6 +458,7 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_target_latency = Config::Get(Config::MAIN_AUDIO_TARGET_LATENCY);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
@@ -465,3 +497,19 @@ unsigned int Mixer::MixerFifo::AvailableSamples() const
   return (samples_in_fifo - 1) * static_cast<u64>(m_mixer->m_sampleRate) *
          m_input_sample_rate_divisor / FIXED_SAMPLE_RATE_DIVIDEND;
 }
+
+u32 Mixer::MixerFifo::GetUnderrunCount() const
+{
+  return m_underrun_count.load(std::memory_order_relaxed);
+}
+
+Mixer::UnderrunCounts Mixer::GetUnderrunCounts() const
+{
+  UnderrunCounts counts;
+  counts.dma = m_dma_mixer.GetUnderrunCount();
+  counts.streaming = m_streaming_mixer.GetUnderrunCount();
+  counts.wiimote_speaker = m_wiimote_speaker_mixer.GetUnderrunCount();
+  for (size_t i = 0; i < m_gba_mixers.size(); ++i)
+    counts.gba[i] = m_gba_mixers[i].GetUnderrunCount();
+  return counts;
+}
@@ -48,6 +48,16 @@ public:
   void StartLogDSPAudio(const std::string& filename);
   void StopLogDSPAudio();
 
+  // Number of times each source ran out of samples while the backend was asking for more.
+  struct UnderrunCounts
+  {
+    u32 dma = 0;
+    u32 streaming = 0;
+    u32 wiimote_speaker = 0;
+    std::array<u32, 4> gba{};
+  };
+  UnderrunCounts GetUnderrunCounts() const;
+
   float GetCurrentSpeed() const { return m_speed.load(); }
   void UpdateSpeed(float val) { m_speed.store(val); }
 
@@ -80,19 +90,26 @@ private:
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
     std::pair<s32, s32> GetVolume() const;
     unsigned int AvailableSamples() const;
+    u32 GetUnderrunCount() const;
 
   private:
     Mixer* m_mixer;
     unsigned m_input_sample_rate_divisor;
     bool m_little_endian;
     std::array<short, MAX_SAMPLES * 2> m_buffer{};
-    std::atomic<u32> m_indexW{0};
-    std::atomic<u32> m_indexR{0};
+    // The write index is only advanced by the emulation thread and the read index only by the
+    // audio thread. Keep them on separate cache lines so the two don't keep stealing each other's.
+    alignas(64) std::atomic<u32> m_indexW{0};
+    alignas(64) std::atomic<u32> m_indexR{0};
     // Volume ranges from 0-256
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+    // Audio thread only.
+    std::array<s16, MAX_SAMPLES * 2> m_block{};
+    bool m_starved = false;
+    std::atomic<u32> m_underrun_count{0};
   };
 
   void RefreshConfig();
@@ -123,6 +140,7 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  int m_config_target_latency;
 
   size_t m_config_changed_callback_id;
 };
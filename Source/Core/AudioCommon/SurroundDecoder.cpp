@@ -3,14 +3,23 @@
 
 #include "AudioCommon/SurroundDecoder.h"
 
-#include <FreeSurround/FreeSurroundDecoder.h>
+#include <array>
 #include <limits>
 
+#include <FreeSurround/FreeSurroundDecoder.h>
+
 namespace AudioCommon
 {
 constexpr size_t STEREO_CHANNELS = 2;
 constexpr size_t SURROUND_CHANNELS = 6;
 
+// FreeSurround:
+// FL | FC | FR | BL | BR | LFE
+// Most backends:
+// FL | FR | FC | LFE | BL | BR
+constexpr std::array<size_t, SURROUND_CHANNELS> FREESURROUND_TO_BACKEND_CHANNEL{0, 2, 1,
+                                                                               5, 3, 4};
+
 SurroundDecoder::SurroundDecoder(u32 sample_rate, u32 frame_block_size)
     : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size)
 {
@@ -32,8 +41,10 @@ size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_f
   if (m_decoded_fifo.size() < output_frames * SURROUND_CHANNELS)
   {
     // Output stereo frames needed to have at least the desired number of surround frames
-    size_t frames_needed = output_frames - m_decoded_fifo.size() / SURROUND_CHANNELS;
-    return frames_needed + m_frame_block_size - frames_needed % m_frame_block_size;
+    // Round up to whole blocks, as the decoder can only work on those. Don't add a block when the
+    // count is already a multiple, since that would only add latency and decoding work.
+    const size_t frames_needed = output_frames - m_decoded_fifo.size() / SURROUND_CHANNELS;
+    return (frames_needed + m_frame_block_size - 1) / m_frame_block_size * m_frame_block_size;
   }
 
   return 0;
@@ -42,40 +53,27 @@ size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_f
 // Receive and decode samples
 void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
 {
-  // Maybe check if it is really power-of-2?
-  s64 remaining_frames = static_cast<s64>(num_frames_in);
-  size_t frame_index = 0;
+  constexpr float scale = 1.0f / std::numeric_limits<short>::max();
 
-  while (remaining_frames > 0)
+  // num_frames_in comes from QueryFramesNeededForSurroundOutput, so it is a multiple of the block
+  // size.
+  for (size_t frame_index = 0; frame_index < num_frames_in; frame_index += m_frame_block_size)
   {
     // Convert to float
+    const short* block_in = in + frame_index * STEREO_CHANNELS;
     for (size_t i = 0, end = m_frame_block_size * STEREO_CHANNELS; i < end; ++i)
-    {
-      m_float_conversion_buffer[i] = in[i + frame_index * STEREO_CHANNELS] /
-                                     static_cast<float>(std::numeric_limits<short>::max());
-    }
+      m_float_conversion_buffer[i] = block_in[i] * scale;
 
     // Decode
     const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
 
     // Add to ring buffer and fix channel mapping
-    // Maybe modify FreeSurround to output the correct mapping?
-    // FreeSurround:
-    // FL | FC | FR | BL | BR | LFE
-    // Most backends:
-    // FL | FR | FC | LFE | BL | BR
     for (size_t i = 0; i < m_frame_block_size; ++i)
     {
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 0]);  // LEFTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 2]);  // RIGHTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 1]);  // CENTREFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 5]);  // sub/lfe
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 3]);  // LEFTREAR
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 4]);  // RIGHTREAR
+      const float* frame = dpl2_fs + i * SURROUND_CHANNELS;
+      for (size_t channel : FREESURROUND_TO_BACKEND_CHANNEL)
+        m_decoded_fifo.push(frame[channel]);
     }
-
-    remaining_frames = remaining_frames - static_cast<int>(m_frame_block_size);
-    frame_index = frame_index + m_frame_block_size;
   }
 }
 
@@ -223,7 +223,12 @@ bool WASAPIStream::SetRunning(bool running)
 
     result = audio_client->GetDevicePeriod(nullptr, &device_period);
 
-    device_period += Config::Get(Config::MAIN_AUDIO_LATENCY) * (10000 / m_format.Format.nChannels);
+    // When targeting latency, run at the device's minimum period and leave buffering to the mixer.
+    const int extra_latency =
+        Config::Get(Config::MAIN_AUDIO_TARGET_LATENCY) > 0 ? 0 :
+                                                             Config::Get(Config::MAIN_AUDIO_LATENCY);
+
+    device_period += extra_latency * (10000 / m_format.Format.nChannels);
     INFO_LOG_FMT(AUDIO, "Audio period set to {}", device_period);
 
     if (!HandleWinAPI("Failed to obtain device period", result))
@@ -259,7 +264,7 @@ bool WASAPIStream::SetRunning(bool running)
       device_period =
           static_cast<REFERENCE_TIME>(
               10000.0 * 1000 * m_frames_in_buffer / m_format.Format.nSamplesPerSec + 0.5) +
-          Config::Get(Config::MAIN_AUDIO_LATENCY) * 10000;
+          extra_latency * 10000;
 
       result = audio_client->Initialize(
           AUDCLNT_SHAREMODE_EXCLUSIVE,
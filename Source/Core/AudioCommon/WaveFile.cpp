@@ -5,6 +5,8 @@
 #include "AudioCommon/Mixer.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
@@ -16,8 +18,6 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 
-constexpr size_t WaveFileWriter::BUFFER_SIZE;
-
 WaveFileWriter::WaveFileWriter()
 {
 }
@@ -91,11 +91,18 @@ bool WaveFileWriter::Start(const std::string& filename, u32 sample_rate_divisor)
   if (file.Tell() != 44)
     PanicAlertFmt("Wrong offset: {}", file.Tell());
 
+  writer.Reset([this](std::vector<short> samples) {
+    file.WriteArray(samples.data(), samples.size());
+  });
+
   return true;
 }
 
 void WaveFileWriter::Stop()
 {
+  // Finishes writing everything that has been queued so far.
+  writer.Shutdown();
+
   file.Seek(4, File::SeekOrigin::Begin);
   Write(audio_size + 36);
 
@@ -119,10 +126,10 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
                                         u32 sample_rate_divisor, int l_volume, int r_volume)
 {
   if (!file)
+  {
     ERROR_LOG_FMT(AUDIO, "WaveFileWriter - file not open.");
-
-  if (count > BUFFER_SIZE * 2)
-    ERROR_LOG_FMT(AUDIO, "WaveFileWriter - buffer too small (count = {}).", count);
+    return;
+  }
 
   if (skip_silence)
   {
@@ -138,6 +145,7 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
       return;
   }
 
+  std::vector<short> conv_buffer(count * 2);
   for (u32 i = 0; i < count; i++)
   {
     // Flip the audio channels from RL to LR
@@ -159,6 +167,6 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
     current_sample_rate_divisor = sample_rate_divisor;
   }
 
-  file.WriteBytes(conv_buffer.data(), count * 4);
+  writer.EmplaceItem(std::move(conv_buffer));
   audio_size += count * 4;
 }
@@ -9,15 +9,17 @@
 // The float variant will convert from -1.0-1.0 range and clamp.
 // Alternatively, AddSamplesBE for big endian wave data.
 // If Stop is not called when it destructs, the destructor will call Stop().
+// Sample data is written to disk from a separate thread, so that dumping doesn't stall the caller.
 // ---------------------------------------------------------------------------------
 
 #pragma once
 
-#include <array>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 
 class WaveFileWriter
 {
@@ -40,8 +42,6 @@ public:
   u32 GetAudioSize() const { return audio_size; }
 
 private:
-  static constexpr size_t BUFFER_SIZE = 32 * 1024;
-
   void Write(u32 value);
   void Write4(const char* ptr);
 
@@ -51,7 +51,9 @@ private:
   u32 audio_size = 0;
 
   u32 current_sample_rate_divisor;
-  std::array<short, BUFFER_SIZE> conv_buffer{};
+
+  // Only touches the file between Start and Stop, while it's running.
+  Common::WorkQueueThread<std::vector<short>> writer;
 
   bool skip_silence = false;
 };
@@ -46,17 +46,32 @@ public:
     Verify,
   };
 
+  // A region that DoStableArray recorded instead of copying into the buffer.
+  struct GatheredSpan
+  {
+    size_t offset;
+    const u8* data;
+    size_t size;
+  };
+
 private:
   u8** m_ptr_current;
+  u8* m_ptr_begin;
   u8* m_ptr_end;
   Mode m_mode;
+  std::vector<GatheredSpan>* m_gathered_spans = nullptr;
 
 public:
   PointerWrap(u8** ptr, size_t size, Mode mode)
-      : m_ptr_current(ptr), m_ptr_end(*ptr + size), m_mode(mode)
+      : m_ptr_current(ptr), m_ptr_begin(*ptr), m_ptr_end(*ptr + size), m_mode(mode)
   {
   }
 
+  // In write mode, makes DoStableArray append to spans instead of copying into the buffer. Their
+  // part of the buffer is left unwritten, and the caller has to fill it in or read the data from
+  // the spans while that memory is still unchanged.
+  void EnableGathering(std::vector<GatheredSpan>* spans) { m_gathered_spans = spans; }
+
   void SetMeasureMode() { m_mode = Mode::Measure; }
   void SetVerifyMode() { m_mode = Mode::Verify; }
   bool IsReadMode() const { return m_mode == Mode::Read; }
@@ -214,6 +229,25 @@ public:
     DoArray(arr, static_cast<u32>(N));
   }
 
+  // Like DoArray, for large regions (emulated RAM and the like) that stay valid and unchanged until
+  // whoever started the save is done with it. These can be gathered, see EnableGathering.
+  template <typename T>
+  void DoStableArray(T* x, u32 count)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only sane for trivially copyable types");
+
+    const size_t size = count * sizeof(T);
+    if (!m_gathered_spans || !IsWriteMode() || *m_ptr_current + size > m_ptr_end)
+    {
+      DoArray(x, count);
+      return;
+    }
+
+    m_gathered_spans->push_back(
+        {static_cast<size_t>(*m_ptr_current - m_ptr_begin), reinterpret_cast<const u8*>(x), size});
+    *m_ptr_current += size;
+  }
+
   // The caller is required to inspect the mode of this PointerWrap
   // and deal with the pointer returned from this function themself.
   [[nodiscard]] u8* DoExternal(u32& count)
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <vector>
 
+#include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/MemoryUtil.h"
@@ -48,12 +49,14 @@ public:
   CodeBlock(CodeBlock&&) = delete;
   CodeBlock& operator=(CodeBlock&&) = delete;
 
-  // Call this before you generate any code.
-  void AllocCodeSpace(size_t size)
+  // Call this before you generate any code. With use_large_pages, the allocation is rounded up
+  // to whole large pages so that it can be backed by them, which reduces iTLB misses.
+  void AllocCodeSpace(size_t size, bool use_large_pages = false)
   {
     region_size = size;
-    total_region_size = size;
-    region = static_cast<u8*>(Common::AllocateExecutableMemory(total_region_size));
+    total_region_size = use_large_pages ? Common::AlignUp(size, LARGE_PAGE_SIZE) : size;
+    region = static_cast<u8*>(
+        Common::AllocateExecutableMemory(total_region_size, use_large_pages));
     T::SetCodePtr(region, region + size);
   }
 
@@ -99,6 +102,11 @@ public:
   }
 
   bool HasChildren() const { return region_size != total_region_size; }
+  // Includes the children, which are part of the region.
+  size_t GetResidentSize() const
+  {
+    return region ? Common::MemResidentSize(region, total_region_size) : 0;
+  }
   u8* AllocChildCodeSpace(size_t child_size)
   {
     ASSERT_MSG(DYNA_REC, child_size < GetSpaceLeft(), "Insufficient space for child allocation.");
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -39,12 +41,146 @@ struct CachedValue
   u64 config_version;
 };
 
+namespace detail
+{
+// Storage for a CachedValue that can be read and written from any thread.
+template <typename T, bool = std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(u64)>
+class CachedValueStorage
+{
+public:
+  CachedValueStorage() = default;
+  constexpr explicit CachedValueStorage(const CachedValue<T>& cached_value)
+      : m_cached_value{cached_value}
+  {
+  }
+
+  CachedValue<T> Load() const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_cached_value;
+  }
+
+  void Store(const CachedValue<T>& cached_value)
+  {
+    std::unique_lock lock(m_mutex);
+    m_cached_value = cached_value;
+  }
+
+  void StoreIfNewer(const CachedValue<T>& cached_value)
+  {
+    std::unique_lock lock(m_mutex);
+    if (m_cached_value.config_version < cached_value.config_version)
+      m_cached_value = cached_value;
+  }
+
+private:
+  CachedValue<T> m_cached_value{};
+  mutable std::shared_mutex m_mutex;
+};
+
+// Most settings are small values which are read very often from several threads at once, so they
+// are stored in a seqlock instead, which readers don't have to write to.
+template <typename T>
+class CachedValueStorage<T, true>
+{
+public:
+  CachedValueStorage() = default;
+  constexpr explicit CachedValueStorage(const CachedValue<T>& cached_value)
+      : m_value{ToBits(cached_value.value)}, m_config_version{cached_value.config_version}
+  {
+  }
+
+  CachedValue<T> Load() const
+  {
+    while (true)
+    {
+      const u32 sequence = m_sequence.load(std::memory_order_acquire);
+      if (sequence & 1)
+        continue;
+
+      const u64 value = m_value.load(std::memory_order_relaxed);
+      const u64 config_version = m_config_version.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (m_sequence.load(std::memory_order_relaxed) == sequence)
+        return CachedValue<T>{FromBits(value), config_version};
+    }
+  }
+
+  void Store(const CachedValue<T>& cached_value)
+  {
+    u32 sequence;
+    while (!TryBeginWrite(&sequence))
+    {
+    }
+    Write(cached_value, sequence);
+  }
+
+  void StoreIfNewer(const CachedValue<T>& cached_value)
+  {
+    // Another thread storing at the same time is just as up to date, so don't wait for it.
+    u32 sequence;
+    if (!TryBeginWrite(&sequence))
+      return;
+
+    if (m_config_version.load(std::memory_order_relaxed) < cached_value.config_version)
+      Write(cached_value, sequence);
+    else
+      m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+private:
+  static constexpr u64 ToBits(const T& value)
+  {
+    if (std::is_constant_evaluated())
+    {
+      if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+        return static_cast<u64>(value);
+    }
+
+    u64 bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    return bits;
+  }
+
+  static T FromBits(u64 bits)
+  {
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+  }
+
+  bool TryBeginWrite(u32* sequence)
+  {
+    *sequence = m_sequence.load(std::memory_order_relaxed);
+    if ((*sequence & 1) || !m_sequence.compare_exchange_strong(*sequence, *sequence + 1,
+                                                                std::memory_order_relaxed))
+    {
+      return false;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+  }
+
+  void Write(const CachedValue<T>& cached_value, u32 sequence)
+  {
+    m_value.store(ToBits(cached_value.value), std::memory_order_relaxed);
+    m_config_version.store(cached_value.config_version, std::memory_order_relaxed);
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  std::atomic<u32> m_sequence = 0;
+  std::atomic<u64> m_value = 0;
+  std::atomic<u64> m_config_version = 0;
+};
+}  // namespace detail
+
 template <typename T>
 class Info
 {
 public:
   constexpr Info(const Location& location, const T& default_value)
-      : m_location{location}, m_default_value{default_value}, m_cached_value{default_value, 0}
+      : m_location{location}, m_default_value{default_value},
+        m_cached_value{CachedValue<T>{default_value, 0}}
   {
   }
 
@@ -66,7 +202,7 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = other.GetDefaultValue();
-    m_cached_value = other.GetCachedValue();
+    m_cached_value.Store(other.GetCachedValue());
     return *this;
   }
 
@@ -75,7 +211,7 @@ public:
   {
     m_location = std::move(other.m_location);
     m_default_value = std::move(other.m_default_value);
-    m_cached_value = std::move(other.m_cached_value);
+    m_cached_value.Store(other.GetCachedValue());
     return *this;
   }
 
@@ -87,38 +223,31 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = static_cast<T>(other.GetDefaultValue());
-    m_cached_value = other.template GetCachedValueCasted<T>();
+    m_cached_value.Store(other.template GetCachedValueCasted<T>());
     return *this;
   }
 
   constexpr const Location& GetLocation() const { return m_location; }
   constexpr const T& GetDefaultValue() const { return m_default_value; }
 
-  CachedValue<T> GetCachedValue() const
-  {
-    std::shared_lock lock(m_cached_value_mutex);
-    return m_cached_value;
-  }
+  CachedValue<T> GetCachedValue() const { return m_cached_value.Load(); }
 
   template <typename U>
   CachedValue<U> GetCachedValueCasted() const
   {
-    std::shared_lock lock(m_cached_value_mutex);
-    return CachedValue<U>{static_cast<U>(m_cached_value.value), m_cached_value.config_version};
+    const CachedValue<T> cached_value = m_cached_value.Load();
+    return CachedValue<U>{static_cast<U>(cached_value.value), cached_value.config_version};
   }
 
   void SetCachedValue(const CachedValue<T>& cached_value) const
   {
-    std::unique_lock lock(m_cached_value_mutex);
-    if (m_cached_value.config_version < cached_value.config_version)
-      m_cached_value = cached_value;
+    m_cached_value.StoreIfNewer(cached_value);
   }
 
 private:
   Location m_location;
   T m_default_value;
 
-  mutable CachedValue<T> m_cached_value;
-  mutable std::shared_mutex m_cached_value_mutex;
+  mutable detail::CachedValueStorage<T> m_cached_value;
 };
 }  // namespace Config
@@ -4,7 +4,9 @@
 #include "SHA1.h"
 
 #include <array>
+#include <cstring>
 #include <memory>
+#include <utility>
 
 #include <mbedtls/sha1.h>
 
@@ -153,98 +155,177 @@ private:
 #ifdef _M_X86_64
 
 // Uses the dedicated SHA1 instructions. Normal SSE(AVX*) would be needed for parallel
-// multi-message processing. While Dolphin could gain from such implementation, it requires the
-// calling code to be modified and/or making the SHA1 implementation asynchronous so it can
-// optimistically batch.
-class ContextX64SHA1 final : public BlockContext
+// multi-message processing of more than a few messages. The SHA1 instructions themselves have a
+// latency of several cycles though, so a few independent messages can be interleaved to keep the
+// execution units busy (see CalculateDigests).
+namespace X64SHA1
 {
-public:
-  ContextX64SHA1()
+// 0: abcd, 1: e
+using State = std::array<__m128i, 2>;
+using WorkBlock = CyclicArray<__m128i, 4>;
+
+ATTRIBUTE_TARGET("ssse3")
+static inline __m128i byterev_16B(__m128i x)
+{
+  return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+template <size_t I>
+ATTRIBUTE_TARGET("sha")
+static inline __m128i MsgSchedule(WorkBlock* wblock)
+{
+  auto& w = *wblock;
+  // Update and return this location
+  auto& wx = w[I];
+  // Do all the xors and rol(x,1) required for 4 rounds of msg schedule
+  wx = _mm_sha1msg1_epu32(wx, w[I + 1]);
+  wx = _mm_xor_si128(wx, w[I + 2]);
+  wx = _mm_sha1msg2_epu32(wx, w[I + 3]);
+  return wx;
+}
+
+// Four rounds for each of the N messages. abcd and prev alternate between the current abcd and the
+// previous abcd (which is needed to compute the next e), like the two halves of State.
+template <size_t N, size_t I>
+ATTRIBUTE_TARGET("sha")
+static inline void FourRounds(std::array<__m128i, N>* abcd, std::array<__m128i, N>* prev,
+                              std::array<WorkBlock, N>* w)
+{
+  for (size_t n = 0; n < N; ++n)
   {
-    state[0] = _mm_set_epi32(H[0], H[1], H[2], H[3]);
-    state[1] = _mm_set_epi32(H[4], 0, 0, 0);
+    __m128i wx;
+    if constexpr (I < 4)
+      wx = (*w)[n][I];
+    else
+      wx = MsgSchedule<I>(&(*w)[n]);
+
+    // E0 += MSG0, special case of "nexte", can do normal add
+    const __m128i e = I == 0 ? _mm_add_epi32((*prev)[n], wx) : _mm_sha1nexte_epu32((*prev)[n], wx);
+    (*prev)[n] = _mm_sha1rnds4_epu32((*abcd)[n], e, I / 5);
   }
+  std::swap(*abcd, *prev);
+}
 
-private:
-  using WorkBlock = CyclicArray<__m128i, 4>;
+template <size_t N, size_t... I>
+ATTRIBUTE_TARGET("sha")
+static inline void AllRounds(std::array<__m128i, N>* abcd, std::array<__m128i, N>* prev,
+                             std::array<WorkBlock, N>* w, std::index_sequence<I...>)
+{
+  (FourRounds<N, I>(abcd, prev, w), ...);
+}
 
-  ATTRIBUTE_TARGET("ssse3")
-  static inline __m128i byterev_16B(__m128i x)
+// Processes one block of each of N independent messages.
+template <size_t N>
+ATTRIBUTE_TARGET("sha,ssse3")
+static inline void ProcessBlocks(State* const* states, const u8* const* msgs)
+{
+  // There are 80 rounds with 4 bytes per round, giving 0x140 byte work space, but we can keep
+  // active state in just 0x40 bytes.
+  // see FIPS 180-4 6.1.3 Alternate Method for Computing a SHA-1 Message Digest
+  std::array<WorkBlock, N> w;
+  std::array<__m128i, N> abcd;
+  std::array<__m128i, N> prev;
+  for (size_t n = 0; n < N; ++n)
   {
-    return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    auto msg_block = (const __m128i*)msgs[n];
+    for (size_t i = 0; i < w[n].size(); i++)
+      w[n][i] = byterev_16B(_mm_loadu_si128(&msg_block[i]));
+
+    abcd[n] = (*states[n])[0];
+    prev[n] = (*states[n])[1];
   }
 
-  template <size_t I>
-  ATTRIBUTE_TARGET("sha")
-  static inline __m128i MsgSchedule(WorkBlock* wblock)
+  AllRounds<N>(&abcd, &prev, &w, std::make_index_sequence<20>());
+
+  // state += abcde
+  for (size_t n = 0; n < N; ++n)
   {
-    auto& w = *wblock;
-    // Update and return this location
-    auto& wx = w[I];
-    // Do all the xors and rol(x,1) required for 4 rounds of msg schedule
-    wx = _mm_sha1msg1_epu32(wx, w[I + 1]);
-    wx = _mm_xor_si128(wx, w[I + 2]);
-    wx = _mm_sha1msg2_epu32(wx, w[I + 3]);
-    return wx;
+    (*states[n])[1] = _mm_sha1nexte_epu32(prev[n], (*states[n])[1]);
+    (*states[n])[0] = _mm_add_epi32(abcd[n], (*states[n])[0]);
   }
+}
 
-  ATTRIBUTE_TARGET("sha")
-  virtual void ProcessBlock(const u8* msg) override
+static inline State InitialState(const u32* h)
+{
+  return {_mm_set_epi32(h[0], h[1], h[2], h[3]), _mm_set_epi32(h[4], 0, 0, 0)};
+}
+
+ATTRIBUTE_TARGET("ssse3")
+static inline Digest GetDigest(const State& state)
+{
+  Digest digest;
+  _mm_storeu_si128((__m128i*)&digest[0], byterev_16B(state[0]));
+  u32 hi = _mm_cvtsi128_si32(byterev_16B(state[1]));
+  std::memcpy(&digest[sizeof(__m128i)], &hi, sizeof(hi));
+  return digest;
+}
+}  // namespace X64SHA1
+
+class ContextX64SHA1 final : public BlockContext
+{
+public:
+  ContextX64SHA1() : state(X64SHA1::InitialState(H)) {}
+
+  // Hashes N messages of the same length at once.
+  template <size_t N>
+  static void CalculateDigests(const u8* msgs, size_t msg_len, Digest* digests)
   {
-    // There are 80 rounds with 4 bytes per round, giving 0x140 byte work space, but we can keep
-    // active state in just 0x40 bytes.
-    // see FIPS 180-4 6.1.3 Alternate Method for Computing a SHA-1 Message Digest
-    WorkBlock w;
-    auto msg_block = (const __m128i*)msg;
-    for (size_t i = 0; i < w.size(); i++)
-      w[i] = byterev_16B(_mm_loadu_si128(&msg_block[i]));
+    std::array<X64SHA1::State, N> states;
+    std::array<X64SHA1::State*, N> state_ptrs;
+    std::array<const u8*, N> msg_ptrs;
+    for (size_t n = 0; n < N; ++n)
+    {
+      states[n] = X64SHA1::InitialState(H);
+      state_ptrs[n] = &states[n];
+      msg_ptrs[n] = msgs + n * msg_len;
+    }
+
+    const size_t full_blocks = msg_len / BLOCK_LEN;
+    for (size_t i = 0; i < full_blocks; ++i)
+    {
+      X64SHA1::ProcessBlocks<N>(state_ptrs.data(), msg_ptrs.data());
+      for (const u8*& msg_ptr : msg_ptrs)
+        msg_ptr += BLOCK_LEN;
+    }
+
+    // The messages have the same length, so they need the same number of padding blocks
+    constexpr size_t MSG_LEN_POS = BLOCK_LEN - sizeof(u64);
+    const size_t remaining = msg_len % BLOCK_LEN;
+    const size_t padding_blocks = remaining + 1 > MSG_LEN_POS ? 2 : 1;
 
-    // 0: abcd, 1: e
-    auto abcde = state;
+    alignas(64) std::array<std::array<u8, BLOCK_LEN * 2>, N> tails{};
+    const Common::BigEndianValue<u64> msg_bitlen(msg_len * 8);
+    for (size_t n = 0; n < N; ++n)
+    {
+      std::memcpy(tails[n].data(), msg_ptrs[n], remaining);
+      tails[n][remaining] = 0x80;
+      std::memcpy(&tails[n][padding_blocks * BLOCK_LEN - sizeof(u64)], &msg_bitlen,
+                  sizeof(msg_bitlen));
+    }
 
-    // Not sure of a (non-ugly) way to have constant-evaluated for-loop, so just rely on inlining.
-    // Problem is that sha1rnds4 requires imm8 arg, and first/last rounds have different behavior.
+    for (size_t i = 0; i < padding_blocks; ++i)
+    {
+      for (size_t n = 0; n < N; ++n)
+        msg_ptrs[n] = &tails[n][i * BLOCK_LEN];
+      X64SHA1::ProcessBlocks<N>(state_ptrs.data(), msg_ptrs.data());
+    }
 
-    // clang-format off
-    // E0 += MSG0, special case of "nexte", can do normal add
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_add_epi32(abcde[1], w[0]), 0);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], w[1]), 0);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], w[2]), 0);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], w[3]), 0);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<4>(&w)), 0);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<5>(&w)), 1);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<6>(&w)), 1);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<7>(&w)), 1);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<8>(&w)), 1);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<9>(&w)), 1);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<10>(&w)), 2);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<11>(&w)), 2);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<12>(&w)), 2);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<13>(&w)), 2);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<14>(&w)), 2);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<15>(&w)), 3);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<16>(&w)), 3);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<17>(&w)), 3);
-    abcde[1] = _mm_sha1rnds4_epu32(abcde[0], _mm_sha1nexte_epu32(abcde[1], MsgSchedule<18>(&w)), 3);
-    abcde[0] = _mm_sha1rnds4_epu32(abcde[1], _mm_sha1nexte_epu32(abcde[0], MsgSchedule<19>(&w)), 3);
-    // state += abcde
-    state[1] = _mm_sha1nexte_epu32(abcde[1], state[1]);
-    state[0] = _mm_add_epi32(abcde[0], state[0]);
-    // clang-format on
+    for (size_t n = 0; n < N; ++n)
+      digests[n] = X64SHA1::GetDigest(states[n]);
   }
 
-  virtual Digest GetDigest() override
+private:
+  virtual void ProcessBlock(const u8* msg) override
   {
-    Digest digest;
-    _mm_storeu_si128((__m128i*)&digest[0], byterev_16B(state[0]));
-    u32 hi = _mm_cvtsi128_si32(byterev_16B(state[1]));
-    std::memcpy(&digest[sizeof(__m128i)], &hi, sizeof(hi));
-    return digest;
+    X64SHA1::State* const states[]{&state};
+    X64SHA1::ProcessBlocks<1>(states, &msg);
   }
 
+  virtual Digest GetDigest() override { return X64SHA1::GetDigest(state); }
+
   virtual bool HwAccelerated() const override { return true; }
 
-  std::array<__m128i, 2> state{};
+  X64SHA1::State state{};
 };
 
 #endif
@@ -372,4 +453,25 @@ Digest CalculateDigest(const u8* msg, size_t len)
   ctx->Update(msg, len);
   return ctx->Finish();
 }
+
+void CalculateDigests(const u8* msgs, size_t msg_len, size_t count, Digest* digests)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bSHA1 && cpu_info.bSSSE3)
+  {
+    // Two messages at once hashes the H0 hashes of Wii discs about 10% faster than one at a time.
+    // More than that was slower, since the work blocks no longer fit in registers.
+    constexpr size_t MESSAGES_AT_ONCE = 2;
+    for (; count >= MESSAGES_AT_ONCE; count -= MESSAGES_AT_ONCE)
+    {
+      ContextX64SHA1::CalculateDigests<MESSAGES_AT_ONCE>(msgs, msg_len, digests);
+      msgs += MESSAGES_AT_ONCE * msg_len;
+      digests += MESSAGES_AT_ONCE;
+    }
+  }
+#endif
+
+  for (size_t i = 0; i < count; ++i)
+    digests[i] = CalculateDigest(msgs + i * msg_len, msg_len);
+}
 }  // namespace Common::SHA1
@@ -32,6 +32,11 @@ std::unique_ptr<Context> CreateContext();
 
 Digest CalculateDigest(const u8* msg, size_t len);
 
+// Calculates the digests of count messages of msg_len bytes each, stored one after another.
+// Where the hardware allows it, several messages are hashed at once, which is faster than
+// calling CalculateDigest for each of them.
+void CalculateDigests(const u8* msgs, size_t msg_len, size_t count, Digest* digests);
+
 template <typename T>
 inline Digest CalculateDigest(const std::vector<T>& msg)
 {
@@ -37,10 +37,12 @@ int ENET_CALLBACK InterceptCallback(ENetHost* host, ENetEvent* event)
   return 0;
 }
 
-bool SendPacket(ENetPeer* socket, const sf::Packet& packet, u8 channel_id)
+bool SendPacket(ENetPeer* socket, const sf::Packet& packet, u8 channel_id, bool reliable)
 {
-  ENetPacket* epac =
-      enet_packet_create(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE);
+  // Unreliable packets are still sequenced, so older ones are dropped instead of being delivered
+  // out of order.
+  ENetPacket* epac = enet_packet_create(packet.getData(), packet.getDataSize(),
+                                        reliable ? ENET_PACKET_FLAG_RELIABLE : 0);
   if (!epac)
   {
     ERROR_LOG_FMT(NETPLAY, "Failed to create ENetPacket ({} bytes).", packet.getDataSize());
@@ -480,6 +480,40 @@ static void SortFST(File::FSTEntry* root)
     SortFST(&child);
 }
 
+// Written next to the SD image after every sync. It lists the folder's files with their sizes and
+// modification times as well as the size and modification time of the image, so that an unchanged
+// folder doesn't need to be packed again on the next boot.
+static std::string GetSyncManifestPath(const std::string& image_path)
+{
+  return image_path + ".sync";
+}
+
+static void AppendToSyncManifest(const File::FSTEntry& entry, std::string* manifest)
+{
+  for (const File::FSTEntry& child : entry.children)
+  {
+    if (child.isDirectory)
+    {
+      *manifest += fmt::format("{}/\n", child.physicalName);
+      AppendToSyncManifest(child, manifest);
+    }
+    else
+    {
+      *manifest += fmt::format("{} {} {}\n", child.physicalName, child.size,
+                               File::FileInfo(child.physicalName).GetModificationTime());
+    }
+  }
+}
+
+static std::string GetSyncManifest(const File::FSTEntry& root, const std::string& image_path)
+{
+  const File::FileInfo image_info(image_path);
+  std::string manifest =
+      fmt::format("{} {}\n", image_info.GetSize(), image_info.GetModificationTime());
+  AppendToSyncManifest(root, &manifest);
+  return manifest;
+}
+
 bool SyncSDFolderToSDImage(bool deterministic)
 {
   const std::string source_dir = File::GetUserPath(D_WIISDCARDSYNCFOLDER_IDX);
@@ -502,6 +536,19 @@ bool SyncSDFolderToSDImage(bool deterministic)
   if (!CheckIfFATCompatible(root))
     return false;
 
+  // A deterministic image has to be packed from scratch, since the game may have changed its layout
+  // since it was last packed.
+  const std::string manifest_path = GetSyncManifestPath(image_path);
+  std::string old_manifest;
+  if (!deterministic && File::ReadFileToString(manifest_path, old_manifest) &&
+      old_manifest == GetSyncManifest(root, image_path))
+  {
+    INFO_LOG_FMT(COMMON, "SD folder {} is unchanged since it was last synced to {}", source_dir,
+                 image_path);
+    return true;
+  }
+  File::Delete(manifest_path, File::IfAbsentBehavior::NoConsoleWarning);
+
   u64 size = GetSize(root);
   // Allocate a reasonable amount of free space
   size += std::clamp(size / 2, MebibytesToBytes(512), GibibytesToBytes(8));
@@ -582,6 +629,9 @@ bool SyncSDFolderToSDImage(bool deterministic)
 
   image_delete_guard.Dismiss();  // no need to delete the temp file anymore after the rename
 
+  if (!deterministic)
+    File::WriteStringToFile(manifest_path, GetSyncManifest(root, image_path));
+
   INFO_LOG_FMT(COMMON, "Successfully packed folder {} to SD image at {}", source_dir, image_path);
   return true;
 }
@@ -814,6 +864,10 @@ bool SyncSDImageToSDFolder()
   if (!image.Close())
     ERROR_LOG_FMT(COMMON, "Failed to close SD image {}", image_path);
 
+  // The folder now matches the image, so it doesn't need to be packed again unless either changes.
+  File::WriteStringToFile(GetSyncManifestPath(image_path),
+                          GetSyncManifest(File::ScanDirectoryTree(target_dir, true), image_path));
+
   INFO_LOG_FMT(COMMON, "Successfully unpacked SD image {} to {}", image_path, target_dir);
   return true;
 }
@@ -943,6 +943,9 @@ PFNDOLMULTIDRAWELEMENTSBASEVERTEXPROC dolMultiDrawElementsBaseVertex;
 // ARB_sample_shading
 PFNDOLMINSAMPLESHADINGARBPROC dolMinSampleShading;
 
+// KHR_parallel_shader_compile
+PFNDOLMAXSHADERCOMPILERTHREADSKHRPROC dolMaxShaderCompilerThreads;
+
 // ARB_debug_output
 PFNDOLDEBUGMESSAGECALLBACKARBPROC dolDebugMessageCallbackARB;
 PFNDOLDEBUGMESSAGECONTROLARBPROC dolDebugMessageControlARB;
@@ -2032,6 +2035,11 @@ const GLFunc gl_function_array[] = {
     // ARB_sample_shading
     GLFUNC_SUFFIX(glMinSampleShading, ARB, "GL_ARB_sample_shading"),
 
+    // KHR_parallel_shader_compile
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, KHR, "GL_KHR_parallel_shader_compile"),
+    GLFUNC_SUFFIX(glMaxShaderCompilerThreads, ARB,
+                  "GL_ARB_parallel_shader_compile !GL_KHR_parallel_shader_compile"),
+
     // OES_sample_shading
     GLFUNC_SUFFIX(glMinSampleShading, OES, "GL_OES_sample_shading !VERSION_GLES_3_2"),
     GLFUNC_REQUIRES(glMinSampleShading, "VERSION_GLES_3_2"),
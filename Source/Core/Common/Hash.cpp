@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <initializer_list>
 #include <zlib.h>
 
 #include "Common/BitUtils.h"
@@ -357,6 +358,68 @@ static u64 GetHash64_SSE42_CRC32(const u8* src, u32 len, u32 samples)
   return h[0] + (h[1] << 10) + (h[2] << 21) + (h[3] << 32);
 }
 
+// Mixes 32 bytes of data into one lane of GetHash64_AVX2. Both halves of each word go through a
+// multiply, so that a change in one block can't be cancelled out by a change in the next one.
+FUNCTION_TARGET_AVX2
+static __m256i HashLane_AVX2(__m256i acc, const __m256i* data)
+{
+  const __m256i x = _mm256_xor_si256(acc, _mm256_loadu_si256(data));
+  const __m256i lo = _mm256_mul_epu32(x, _mm256_set1_epi64x(0x9E3779B1));
+  const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), _mm256_set1_epi64x(0x85EBCA77));
+  return _mm256_add_epi64(lo, hi);
+}
+
+// Hashes 8 independent lanes of 32 bytes at a time, for when the whole texture has to be hashed.
+FUNCTION_TARGET_AVX2
+static u64 GetHash64_AVX2(const u8* src, u32 len, u32 samples)
+{
+  constexpr u32 BLOCK_SIZE = 8 * sizeof(__m256i);
+
+  // Sampled hashes only touch a few words, which the CRC32 version already does well. The lanes
+  // don't pay for their setup on small inputs either.
+  if ((samples != 0 && samples < len / 8) || len < 16 * BLOCK_SIZE)
+    return GetHash64_SSE42_CRC32(src, len, samples);
+
+  const u64 seed = 0x27D4EB2F165667C5ULL ^ len;
+  const auto lane_seed = [seed](u64 lane) {
+    return static_cast<s64>(seed ^ (lane * 0x9E3779B97F4A7C15ULL));
+  };
+  __m256i acc0 = _mm256_set1_epi64x(lane_seed(1)), acc1 = _mm256_set1_epi64x(lane_seed(2));
+  __m256i acc2 = _mm256_set1_epi64x(lane_seed(3)), acc3 = _mm256_set1_epi64x(lane_seed(4));
+  __m256i acc4 = _mm256_set1_epi64x(lane_seed(5)), acc5 = _mm256_set1_epi64x(lane_seed(6));
+  __m256i acc6 = _mm256_set1_epi64x(lane_seed(7)), acc7 = _mm256_set1_epi64x(lane_seed(8));
+
+  const __m256i* data = reinterpret_cast<const __m256i*>(src);
+  const __m256i* const end = data + (len / BLOCK_SIZE) * 8;
+  for (; data != end; data += 8)
+  {
+    acc0 = HashLane_AVX2(acc0, data + 0);
+    acc1 = HashLane_AVX2(acc1, data + 1);
+    acc2 = HashLane_AVX2(acc2, data + 2);
+    acc3 = HashLane_AVX2(acc3, data + 3);
+    acc4 = HashLane_AVX2(acc4, data + 4);
+    acc5 = HashLane_AVX2(acc5, data + 5);
+    acc6 = HashLane_AVX2(acc6, data + 6);
+    acc7 = HashLane_AVX2(acc7, data + 7);
+  }
+
+  // Fold the lanes in order, so that swapping the contents of two lanes changes the result.
+  __m256i folded = _mm256_set1_epi64x(static_cast<s64>(seed));
+  for (const __m256i& acc : {acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7})
+    folded = HashLane_AVX2(folded, &acc);
+
+  u64 words[4];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(words), folded);
+  u64 h = len;
+  for (const u64 word : words)
+    h = fmix64(h ^ word);
+
+  const u32 tail = len % BLOCK_SIZE;
+  if (tail != 0)
+    h = fmix64(h ^ GetHash64_SSE42_CRC32(src + len - tail, tail, 0));
+  return h;
+}
+
 #elif defined(_M_X86)
 
 FUNCTION_TARGET_SSE42
@@ -431,7 +494,12 @@ static u64 SetHash64Function(const u8* src, u32 len, u32 samples)
 {
   if (cpu_info.bCRC32)
   {
-#if defined(_M_X86_64) || defined(_M_X86)
+#if defined(_M_X86_64)
+    if (cpu_info.bAVX2)
+      s_texture_hash_func = &GetHash64_AVX2;
+    else
+      s_texture_hash_func = &GetHash64_SSE42_CRC32;
+#elif defined(_M_X86)
     s_texture_hash_func = &GetHash64_SSE42_CRC32;
 #elif defined(_M_ARM_64)
     s_texture_hash_func = &GetHash64_ARMv8_CRC32;
@@ -8,6 +8,7 @@
 #include <mutex>
 
 #include <curl/curl.h>
+#include <fmt/format.h>
 
 #include "Common/Logging/Log.h"
 #include "Common/ScopeGuard.h"
@@ -31,7 +32,9 @@ public:
   void UseIPv4();
   void FollowRedirects(long max);
   Response Fetch(const std::string& url, Method method, const Headers& headers, const u8* payload,
-                 size_t size, AllowedReturnCodes codes = AllowedReturnCodes::Ok_Only);
+                 size_t size, AllowedReturnCodes codes = AllowedReturnCodes::Ok_Only,
+                 const char* range = nullptr);
+  std::optional<u64> GetContentLength(const std::string& url, const Headers& headers);
 
   static int CurlProgressCallback(Impl* impl, double dlnow, double dltotal, double ulnow,
                                   double ultotal);
@@ -95,6 +98,30 @@ HttpRequest::Response HttpRequest::Post(const std::string& url, const std::strin
                        reinterpret_cast<const u8*>(payload.data()), payload.size(), codes);
 }
 
+std::optional<u64> HttpRequest::GetContentLength(const std::string& url, const Headers& headers)
+{
+  return m_impl->GetContentLength(url, headers);
+}
+
+HttpRequest::Response HttpRequest::GetRange(const std::string& url, u64 offset, u64 size,
+                                            const Headers& headers)
+{
+  if (size == 0)
+    return std::vector<u8>();
+
+  const std::string range = fmt::format("{}-{}", offset, offset + size - 1);
+  Response response = m_impl->Fetch(url, Impl::Method::GET, headers, nullptr, 0,
+                                    AllowedReturnCodes::Ok_Only, range.c_str());
+  if (response && response->size() != size)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to GET {}: expected {} bytes but got {}", url, size,
+                  response->size());
+    return {};
+  }
+
+  return response;
+}
+
 int HttpRequest::Impl::CurlProgressCallback(Impl* impl, double dlnow, double dltotal, double ulnow,
                                             double ultotal)
 {
@@ -168,6 +195,34 @@ std::string HttpRequest::Impl::EscapeComponent(const std::string& string)
   return escaped_str;
 }
 
+std::optional<u64> HttpRequest::Impl::GetContentLength(const std::string& url,
+                                                       const Headers& headers)
+{
+  curl_easy_setopt(m_curl.get(), CURLOPT_NOBODY, 1L);
+  const Response response = Fetch(url, Method::GET, headers, nullptr, 0);
+  curl_easy_setopt(m_curl.get(), CURLOPT_NOBODY, 0L);
+  if (!response)
+    return std::nullopt;
+
+#if LIBCURL_VERSION_NUM >= 0x073700
+  curl_off_t length = -1;
+  if (curl_easy_getinfo(m_curl.get(), CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length) != CURLE_OK ||
+      length < 0)
+  {
+    return std::nullopt;
+  }
+#else
+  double length = -1;
+  if (curl_easy_getinfo(m_curl.get(), CURLINFO_CONTENT_LENGTH_DOWNLOAD, &length) != CURLE_OK ||
+      length < 0)
+  {
+    return std::nullopt;
+  }
+#endif
+
+  return static_cast<u64>(length);
+}
+
 static size_t CurlWriteCallback(char* data, size_t size, size_t nmemb, void* userdata)
 {
   auto* buffer = static_cast<std::vector<u8>*>(userdata);
@@ -178,7 +233,8 @@ static size_t CurlWriteCallback(char* data, size_t size, size_t nmemb, void* use
 
 HttpRequest::Response HttpRequest::Impl::Fetch(const std::string& url, Method method,
                                                const Headers& headers, const u8* payload,
-                                               size_t size, AllowedReturnCodes codes)
+                                               size_t size, AllowedReturnCodes codes,
+                                               const char* range)
 {
   curl_easy_setopt(m_curl.get(), CURLOPT_POST, method == Method::POST);
   curl_easy_setopt(m_curl.get(), CURLOPT_URL, url.c_str());
@@ -200,12 +256,15 @@ HttpRequest::Response HttpRequest::Impl::Fetch(const std::string& url, Method me
       list = curl_slist_append(list, (name + ": " + *value).c_str());
   }
   curl_easy_setopt(m_curl.get(), CURLOPT_HTTPHEADER, list);
+  curl_easy_setopt(m_curl.get(), CURLOPT_RANGE, range);
 
   std::vector<u8> buffer;
   curl_easy_setopt(m_curl.get(), CURLOPT_WRITEFUNCTION, CurlWriteCallback);
   curl_easy_setopt(m_curl.get(), CURLOPT_WRITEDATA, &buffer);
 
   const char* type = method == Method::POST ? "POST" : "GET";
+  // A server that ignores the range replies with 200 and the whole resource
+  const long expected_response_code = range ? 206 : 200;
   const CURLcode res = curl_easy_perform(m_curl.get());
   if (res != CURLE_OK)
   {
@@ -218,7 +277,7 @@ HttpRequest::Response HttpRequest::Impl::Fetch(const std::string& url, Method me
 
   long response_code = 0;
   curl_easy_getinfo(m_curl.get(), CURLINFO_RESPONSE_CODE, &response_code);
-  if (response_code != 200)
+  if (response_code != expected_response_code)
   {
     if (buffer.empty())
     {
@@ -47,6 +47,11 @@ public:
   Response Post(const std::string& url, const std::string& payload, const Headers& headers = {},
                 AllowedReturnCodes codes = AllowedReturnCodes::Ok_Only);
 
+  // Sends a HEAD request. Returns nothing if it fails or the server doesn't report the size.
+  std::optional<u64> GetContentLength(const std::string& url, const Headers& headers = {});
+  // Gets size bytes starting at offset. Fails unless the server supports range requests.
+  Response GetRange(const std::string& url, u64 offset, u64 size, const Headers& headers = {});
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
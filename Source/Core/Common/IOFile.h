@@ -89,6 +89,10 @@ public:
 
   bool WriteString(std::string_view str) { return WriteBytes(str.data(), str.size()); }
 
+  // Reads from the given offset without using or moving the file position, so several threads
+  // can read from the same file at once. Must not be mixed with buffered reads of the same range.
+  bool ReadBytesAt(void* data, size_t length, u64 offset);
+
   bool IsOpen() const { return nullptr != m_file; }
   // m_good is set to false when a read, write or other function fails
   bool IsGood() const { return m_good; }
@@ -3,10 +3,12 @@
 
 #include "Common/JitRegister.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <mutex>
 #include <string>
 
 #include <fmt/format.h>
@@ -21,6 +23,13 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <ctime>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 #if defined USE_OPROFILE && USE_OPROFILE
 #include <opagent.h>
 #endif
@@ -40,6 +49,139 @@ namespace JitRegister
 {
 static bool s_is_enabled = false;
 
+// Code can be registered from the CPU, DSP and video threads.
+static std::mutex s_mutex;
+
+#ifdef __linux__
+// Linux perf jitdump, which unlike the perf map includes the code itself, so that perf annotate
+// works on it. See tools/perf/Documentation/jitdump-specification.txt in the Linux sources.
+// Record with "perf record -k mono" and run "perf inject --jit" on the result before reporting.
+static File::IOFile s_jitdump_file;
+static void* s_jitdump_marker = nullptr;
+static u64 s_jitdump_code_index = 0;
+
+constexpr u32 JITDUMP_MAGIC = 0x4A695444;
+constexpr u32 JITDUMP_VERSION = 1;
+constexpr u32 JIT_CODE_LOAD = 0;
+constexpr u32 JIT_CODE_CLOSE = 3;
+
+#if defined(_M_X86_64)
+constexpr u32 JITDUMP_ELF_MACHINE = 62;  // EM_X86_64
+#elif defined(_M_ARM_64)
+constexpr u32 JITDUMP_ELF_MACHINE = 183;  // EM_AARCH64
+#else
+constexpr u32 JITDUMP_ELF_MACHINE = 0;
+#endif
+
+struct JitDumpHeader
+{
+  u32 magic;
+  u32 version;
+  u32 total_size;
+  u32 elf_mach;
+  u32 pad1;
+  u32 pid;
+  u64 timestamp;
+  u64 flags;
+};
+
+struct JitDumpRecordHeader
+{
+  u32 id;
+  u32 total_size;
+  u64 timestamp;
+};
+
+struct JitDumpCodeLoad
+{
+  JitDumpRecordHeader header;
+  u32 pid;
+  u32 tid;
+  u64 vma;
+  u64 code_addr;
+  u64 code_size;
+  u64 code_index;
+  // Followed by the null-terminated name and the code.
+};
+
+// Has to match the clock that perf records with.
+static u64 GetJitDumpTimestamp()
+{
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<u64>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+static void OpenJitDump(const std::string& dir)
+{
+  const std::string filename = fmt::format("{}/jit-{}.dump", dir, getpid());
+  if (!s_jitdump_file.Open(filename, "w+b"))
+    return;
+
+  // perf finds the file through an executable mapping of it showing up in the recording.
+  const long page_size = sysconf(_SC_PAGESIZE);
+  s_jitdump_marker = mmap(nullptr, page_size, PROT_READ | PROT_EXEC, MAP_PRIVATE,
+                          fileno(s_jitdump_file.GetHandle()), 0);
+  if (s_jitdump_marker == MAP_FAILED)
+  {
+    s_jitdump_marker = nullptr;
+    s_jitdump_file.Close();
+    return;
+  }
+
+  JitDumpHeader header{};
+  header.magic = JITDUMP_MAGIC;
+  header.version = JITDUMP_VERSION;
+  header.total_size = sizeof(JitDumpHeader);
+  header.elf_mach = JITDUMP_ELF_MACHINE;
+  header.pid = static_cast<u32>(getpid());
+  header.timestamp = GetJitDumpTimestamp();
+  s_jitdump_file.WriteBytes(&header, sizeof(header));
+  s_jitdump_file.Flush();
+}
+
+static void CloseJitDump()
+{
+  if (!s_jitdump_file.IsOpen())
+    return;
+
+  const JitDumpRecordHeader record{JIT_CODE_CLOSE, sizeof(JitDumpRecordHeader),
+                                   GetJitDumpTimestamp()};
+  s_jitdump_file.WriteBytes(&record, sizeof(record));
+
+  munmap(s_jitdump_marker, sysconf(_SC_PAGESIZE));
+  s_jitdump_marker = nullptr;
+  s_jitdump_file.Close();
+  s_jitdump_code_index = 0;
+}
+
+static void WriteJitDumpCodeLoad(const void* base_address, u32 code_size,
+                                 const std::string& symbol_name)
+{
+  if (!s_jitdump_file.IsOpen())
+    return;
+
+  const u64 address = reinterpret_cast<u64>(base_address);
+  JitDumpCodeLoad record{};
+  record.header.id = JIT_CODE_LOAD;
+  record.header.total_size =
+      static_cast<u32>(sizeof(JitDumpCodeLoad) + symbol_name.size() + 1 + code_size);
+  record.header.timestamp = GetJitDumpTimestamp();
+  record.pid = static_cast<u32>(getpid());
+  record.tid = static_cast<u32>(syscall(SYS_gettid));
+  record.vma = address;
+  record.code_addr = address;
+  record.code_size = code_size;
+  record.code_index = s_jitdump_code_index++;
+
+  s_jitdump_file.WriteBytes(&record, sizeof(record));
+  s_jitdump_file.WriteBytes(symbol_name.c_str(), symbol_name.size() + 1);
+  s_jitdump_file.WriteBytes(base_address, code_size);
+  // Keep the file complete in the event of a crash.
+  s_jitdump_file.Flush();
+}
+#endif
+
 void Init(const std::string& perf_dir)
 {
 #if defined USE_OPROFILE && USE_OPROFILE
@@ -55,6 +197,9 @@ void Init(const std::string& perf_dir)
     // Disable buffering in order to avoid missing some mappings
     // if the event of a crash:
     std::setvbuf(s_perf_map_file.GetHandle(), nullptr, _IONBF, 0);
+#ifdef __linux__
+    OpenJitDump(dir);
+#endif
     s_is_enabled = true;
   }
 }
@@ -70,9 +215,15 @@ void Shutdown()
   iJIT_NotifyEvent(iJVM_EVENT_TYPE_SHUTDOWN, nullptr);
 #endif
 
+  std::lock_guard lk(s_mutex);
+
   if (s_perf_map_file.IsOpen())
     s_perf_map_file.Close();
 
+#ifdef __linux__
+  CloseJitDump();
+#endif
+
   s_is_enabled = false;
 }
 
@@ -101,11 +252,20 @@ void Register(const void* base_address, u32 code_size, const std::string& symbol
   iJIT_NotifyEvent(iJVM_EVENT_TYPE_METHOD_LOAD_FINISHED, (void*)&jmethod);
 #endif
 
+  std::lock_guard lk(s_mutex);
+
+#ifdef __linux__
+  WriteJitDumpCodeLoad(base_address, code_size, symbol_name);
+#endif
+
   // Linux perf /tmp/perf-$pid.map:
   if (!s_perf_map_file.IsOpen())
     return;
 
-  const auto entry = fmt::format("{} {:x} {}\n", fmt::ptr(base_address), code_size, symbol_name);
+  // Each entry has to be a single line.
+  std::string name = symbol_name;
+  std::replace(name.begin(), name.end(), '\n', ' ');
+  const auto entry = fmt::format("{} {:x} {}\n", fmt::ptr(base_address), code_size, name);
   s_perf_map_file.WriteBytes(entry.data(), entry.size());
 }
 }  // namespace JitRegister
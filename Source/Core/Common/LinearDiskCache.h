@@ -8,23 +8,39 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/Version.h"
 
 // On disk format:
 // header{
-// u32 'DCAC';
-// u32 version;  // svn_rev
+// u32 'DCA2';
 // u16 sizeof(key_type);
 // u16 sizeof(value_type);
+// char version[40];  // scm revision
 //}
 
 // key_value_pair{
 // u32 value_size;
 // key_type   key;
 // value_type[value_size]   value;
+// u32 entry_number;
+//}
+
+// Once the file has been synced or closed, the pairs are followed by an index:
+// index_entry{
+// u64 offset;  // of the key_value_pair
+// u32 key_hash;
+// u32 value_size;
+//}[num_entries], sorted by key_hash
+// index_trailer{
+// u64 index_offset;
+// u32 num_entries;
+// u32 'DIDX';
 //}
 
 template <typename K, typename V>
@@ -35,7 +51,10 @@ public:
 };
 
 // Dead simple unsorted key-value store with append functionality.
-// No random read functionality, all reading is done in OpenAndRead.
+// Entries can either all be read in OpenAndRead, or opened with Open and then looked up
+// individually. Files with an index are memory-mapped, so values are only read when they are
+// looked up. Files without one (e.g. after a crash) are scanned once when they are opened.
+// New entries are appended over the index, which is written again by Sync and Close.
 // Keys and values can contain any characters, including \0.
 //
 // Suitable for caching generated shader bytecode between executions.
@@ -50,75 +69,112 @@ template <typename K, typename V>
 class LinearDiskCache
 {
 public:
-  // return number of read entries
-  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  ~LinearDiskCache() { Close(); }
+
+  // Opens the file, recreating it if it doesn't exist or is invalid, without reading any values.
+  // Returns the number of entries.
+  u32 Open(const std::string& filename)
   {
     // Since we're reading/writing directly to the storage of K instances,
     // K must be trivially copyable.
     static_assert(std::is_trivially_copyable<K>::value, "K must be a trivially copyable type");
+    static_assert(std::is_trivially_copyable<V>::value, "V must be a trivially copyable type");
 
     // close any currently opened file
     Close();
-    m_num_entries = 0;
 
     // try opening for reading/writing
-    m_file.Open(filename, "r+b");
+    m_header.Init();
+    if (m_file.Open(filename, "r+b") && m_mapping.Open(filename) && ValidateHeader())
+    {
+      if (!ReadIndex())
+        ScanEntries();
+      return m_num_entries;
+    }
 
-    const u64 file_size = m_file.GetSize();
+    // failed to open file for reading or bad header
+    // close and recreate file
+    Close();
+    m_file.Open(filename, "w+b");
+    WriteHeader();
+    m_records_end = m_file.Tell();
+    m_index_dirty = true;
+    return 0;
+  }
 
-    m_header.Init();
-    if (m_file.IsOpen() && ValidateHeader())
+  // return number of read entries
+  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  {
+    Open(filename);
+
+    // All entries of a freshly opened file are within the mapping.
+    u64 offset = sizeof(Header);
+    for (u32 i = 0; i < m_num_entries; i++)
     {
-      // good header, read some key/value pairs
+      u32 value_size;
+      std::memcpy(&value_size, m_mapping.GetData() + offset, sizeof(value_size));
       K key;
+      std::memcpy(&key, m_mapping.GetData() + offset + sizeof(value_size), sizeof(K));
+      const V* value =
+          reinterpret_cast<const V*>(m_mapping.GetData() + offset + sizeof(value_size) + sizeof(K));
+      reader.Read(key, value, value_size);
+      offset += GetRecordSize(value_size);
+    }
+
+    return m_num_entries;
+  }
 
-      std::unique_ptr<V[]> value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-      u64 last_valid_value_start = m_file.Tell();
+  // Reads the value most recently appended for key. Returns false if there is none.
+  bool Lookup(const K& key, std::vector<V>* value)
+  {
+    const u32 key_hash = HashKey(key);
+    const auto begin = std::lower_bound(m_index.begin(), m_index.end(), key_hash,
+                                        [](const IndexEntry& entry, u32 hash) {
+                                          return entry.key_hash < hash;
+                                        });
+    const auto end = std::upper_bound(begin, m_index.end(), key_hash,
+                                      [](u32 hash, const IndexEntry& entry) {
+                                        return hash < entry.key_hash;
+                                      });
 
-      while (m_file.ReadArray(&value_size, 1))
+    // Entries with the same hash stay in the order they were appended in.
+    for (auto it = end; it != begin;)
+    {
+      --it;
+      K stored_key;
+      if (!ReadAt(&stored_key, sizeof(K), it->offset + sizeof(u32)) ||
+          std::memcmp(&stored_key, &key, sizeof(K)) != 0)
       {
-        const u64 next_extent = m_file.Tell() + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
-
-        // TODO: use make_unique_for_overwrite in C++20
-        value = std::unique_ptr<V[]>(new V[value_size]);
-
-        // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
-        {
-          last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
-        }
-        else
-        {
-          break;
-        }
-
-        m_num_entries++;
+        continue;
       }
-      m_file.ClearError();
-      m_file.Seek(last_valid_value_start, File::SeekOrigin::Begin);
 
-      return m_num_entries;
+      value->resize(it->value_size);
+      return ReadAt(value->data(), sizeof(V) * it->value_size,
+                    it->offset + sizeof(u32) + sizeof(K));
     }
 
-    // failed to open file for reading or bad header
-    // close and recreate file
-    Close();
-    m_file.Open(filename, "wb");
-    WriteHeader();
-    return 0;
+    return false;
+  }
+
+  u32 GetNumEntries() const { return m_num_entries; }
+
+  void Sync()
+  {
+    WriteIndex();
+    m_file.Flush();
   }
 
-  void Sync() { m_file.Flush(); }
   void Close()
   {
+    WriteIndex();
     if (m_file.IsOpen())
       m_file.Close();
+    m_mapping.Close();
+    m_index.clear();
+    m_num_entries = 0;
+    m_records_end = 0;
+    m_index_end = 0;
+    m_index_dirty = false;
   }
 
   // Appends a key-value pair to the store.
@@ -126,21 +182,159 @@ public:
   {
     // TODO: Should do a check that we don't already have "key"? (I think each caller does that
     // already.)
+
+    // The new entry overwrites the index, so make sure that it isn't used if the file isn't
+    // closed properly.
+    if (!m_index_dirty)
+    {
+      const u32 invalid_magic = 0;
+      m_file.Seek(m_index_end - sizeof(invalid_magic), File::SeekOrigin::Begin);
+      m_file.WriteArray(&invalid_magic, 1);
+      m_index_dirty = true;
+    }
+
+    m_file.Seek(m_records_end, File::SeekOrigin::Begin);
     m_file.WriteArray(&value_size, 1);
     m_file.WriteArray(&key, 1);
     m_file.WriteArray(value, value_size);
     m_num_entries++;
     m_file.WriteArray(&m_num_entries, 1);
+
+    AddToIndex(key, m_records_end, value_size);
+    m_records_end += GetRecordSize(value_size);
   }
 
 private:
+  struct IndexEntry
+  {
+    u64 offset;
+    u32 key_hash;
+    u32 value_size;
+  };
+
+  struct IndexTrailer
+  {
+    u64 index_offset;
+    u32 num_entries;
+    u32 magic;
+  };
+
+  static constexpr u32 INDEX_MAGIC = 0x58444944;  // "DIDX"
+
+  static u32 HashKey(const K& key)
+  {
+    return Common::ComputeCRC32(reinterpret_cast<const u8*>(&key), sizeof(K));
+  }
+
+  static u64 GetRecordSize(u32 value_size)
+  {
+    return sizeof(u32) + sizeof(K) + sizeof(V) * u64{value_size} + sizeof(u32);
+  }
+
+  void AddToIndex(const K& key, u64 offset, u32 value_size)
+  {
+    const IndexEntry entry{offset, HashKey(key), value_size};
+    const auto it = std::upper_bound(
+        m_index.begin(), m_index.end(), entry,
+        [](const IndexEntry& a, const IndexEntry& b) { return a.key_hash < b.key_hash; });
+    m_index.insert(it, entry);
+  }
+
+  bool ReadAt(void* data, size_t size, u64 offset)
+  {
+    if (offset + size <= m_mapping.GetSize())
+    {
+      std::memcpy(data, m_mapping.GetData() + offset, size);
+      return true;
+    }
+
+    // Appended after the file was mapped, and possibly still buffered.
+    m_file.Flush();
+    return m_file.ReadBytesAt(data, size, offset);
+  }
+
+  // Uses the index at the end of the file, if it is valid.
+  bool ReadIndex()
+  {
+    const u64 file_size = m_mapping.GetSize();
+    if (file_size < sizeof(Header) + sizeof(IndexTrailer))
+      return false;
+
+    IndexTrailer trailer;
+    std::memcpy(&trailer, m_mapping.GetData() + file_size - sizeof(trailer), sizeof(trailer));
+    if (trailer.magic != INDEX_MAGIC || trailer.index_offset < sizeof(Header) ||
+        trailer.index_offset + u64{trailer.num_entries} * sizeof(IndexEntry) + sizeof(trailer) !=
+            file_size)
+    {
+      return false;
+    }
+
+    // The index isn't necessarily aligned.
+    m_index.resize(trailer.num_entries);
+    std::memcpy(m_index.data(), m_mapping.GetData() + trailer.index_offset,
+                m_index.size() * sizeof(IndexEntry));
+    m_num_entries = trailer.num_entries;
+    m_records_end = trailer.index_offset;
+    m_index_end = file_size;
+    m_index_dirty = false;
+    return true;
+  }
+
+  // Builds the index from the entries, for files which weren't closed properly.
+  void ScanEntries()
+  {
+    const u8* const data = m_mapping.GetData();
+    const u64 file_size = m_mapping.GetSize();
+    u64 offset = sizeof(Header);
+    while (offset + sizeof(u32) <= file_size)
+    {
+      u32 value_size;
+      std::memcpy(&value_size, data + offset, sizeof(value_size));
+      const u64 record_size = GetRecordSize(value_size);
+      if (offset + record_size > file_size)
+        break;
+
+      u32 entry_number;
+      std::memcpy(&entry_number, data + offset + record_size - sizeof(entry_number),
+                  sizeof(entry_number));
+      if (entry_number != m_num_entries + 1)
+        break;
+
+      K key;
+      std::memcpy(&key, data + offset + sizeof(value_size), sizeof(K));
+      AddToIndex(key, offset, value_size);
+      m_num_entries++;
+      offset += record_size;
+    }
+
+    m_records_end = offset;
+    m_index_dirty = true;
+  }
+
+  void WriteIndex()
+  {
+    if (!m_index_dirty || !m_file.IsOpen())
+      return;
+
+    // Truncating a file isn't possible while it's mapped on some platforms. Values are read from
+    // the file from now on.
+    m_mapping.Close();
+
+    const IndexTrailer trailer{m_records_end, static_cast<u32>(m_index.size()), INDEX_MAGIC};
+    m_file.Seek(m_records_end, File::SeekOrigin::Begin);
+    m_file.WriteArray(m_index.data(), m_index.size());
+    m_file.WriteArray(&trailer, 1);
+    m_file.Flush();
+    m_index_end = m_file.Tell();
+    m_file.Resize(m_index_end);
+    m_index_dirty = false;
+  }
+
   void WriteHeader() { m_file.WriteArray(&m_header, 1); }
   bool ValidateHeader()
   {
-    char file_header[sizeof(Header)];
-
-    return (m_file.ReadArray(file_header, sizeof(Header)) &&
-            !memcmp((const char*)&m_header, file_header, sizeof(Header)));
+    return m_mapping.GetSize() >= sizeof(Header) &&
+           !memcmp(&m_header, m_mapping.GetData(), sizeof(Header));
   }
 
   struct Header
@@ -148,7 +342,7 @@ private:
     void Init()
     {
       // Null-terminator is intentionally not copied.
-      std::memcpy(&id, "DCAC", sizeof(u32));
+      std::memcpy(&id, "DCA2", sizeof(u32));
       std::memcpy(ver, Common::GetScmRevGitStr().c_str(),
                   std::min(Common::GetScmRevGitStr().size(), sizeof(ver)));
     }
@@ -161,5 +355,13 @@ private:
   } m_header;
 
   File::IOFile m_file;
+  Common::MappedFile m_mapping;
+  // Sorted by key hash.
+  std::vector<IndexEntry> m_index;
   u32 m_num_entries = 0;
+  // End of the last entry, where the index starts.
+  u64 m_records_end = 0;
+  // End of the index on disk, if it is up to date.
+  u64 m_index_end = 0;
+  bool m_index_dirty = false;
 };
@@ -11,6 +11,8 @@
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -21,6 +23,7 @@
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 
 namespace Common::Log
 {
@@ -168,10 +171,17 @@ LogManager::LogManager()
   }
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  m_listener_thread = std::thread(&LogManager::ListenerThreadFunc, this);
 }
 
 LogManager::~LogManager()
 {
+  // Deliver the remaining messages.
+  m_shutdown.Set();
+  m_pending_event.Set();
+  m_listener_thread.join();
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -220,14 +230,47 @@ std::string LogManager::GetTimestamp()
 void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                                  const char* message)
 {
-  const std::string msg =
+  std::string msg =
       fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(), file, line,
                   LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), message);
 
-  for (const auto listener_id : m_listener_ids)
   {
-    if (m_listeners[listener_id])
-      m_listeners[listener_id]->Log(level, msg.c_str());
+    std::lock_guard lk(m_pending_mutex);
+    m_pending_messages.push_back({level, std::move(msg)});
+  }
+  m_pending_event.Set();
+}
+
+void LogManager::ListenerThreadFunc()
+{
+  Common::SetCurrentThreadName("Log listeners");
+
+  std::vector<PendingMessage> messages;
+  while (true)
+  {
+    m_pending_event.Wait();
+    const bool shutdown = m_shutdown.IsSet();
+
+    {
+      std::lock_guard lk(m_pending_mutex);
+      std::swap(messages, m_pending_messages);
+    }
+
+    {
+      std::lock_guard lk(m_listeners_mutex);
+      for (const PendingMessage& message : messages)
+      {
+        for (const auto listener_id : m_listener_ids)
+        {
+          if (m_listeners[listener_id])
+            m_listeners[listener_id]->Log(message.level, message.text.c_str());
+        }
+      }
+    }
+    messages.clear();
+
+    if (shutdown)
+      break;
   }
 }
 
@@ -273,6 +316,7 @@ const char* LogManager::GetFullName(LogType type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  std::lock_guard lk(m_listeners_mutex);
   m_listeners[id] = listener;
 }
 
@@ -6,10 +6,15 @@
 #include <array>
 #include <cstdarg>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/EnumMap.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 
 namespace Common::Log
@@ -53,6 +58,7 @@ public:
   const char* GetShortName(LogType type) const;
   const char* GetFullName(LogType type) const;
 
+  // Once this returns, the previous listener with this ID won't be called anymore.
   void RegisterListener(LogListener::LISTENER id, LogListener* listener);
   void EnableListener(LogListener::LISTENER id, bool enable);
   bool IsListenerEnabled(LogListener::LISTENER id) const;
@@ -75,12 +81,30 @@ private:
   LogManager(LogManager&&) = delete;
   LogManager& operator=(LogManager&&) = delete;
 
+  struct PendingMessage
+  {
+    LogLevel level;
+    std::string text;
+  };
+
   static std::string GetTimestamp();
 
+  void ListenerThreadFunc();
+
   LogLevel m_level;
   EnumMap<LogContainer, LAST_LOG_TYPE> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  // Messages are passed to the listeners on a separate thread, so that slow listeners (writing to
+  // a file or a console) don't hold up the threads that log.
+  std::thread m_listener_thread;
+  Common::Event m_pending_event;
+  Common::Flag m_shutdown;
+  std::mutex m_pending_mutex;
+  std::vector<PendingMessage> m_pending_messages;
+  // Held while messages are passed to the listeners.
+  std::mutex m_listeners_mutex;
 };
 }  // namespace Common::Log
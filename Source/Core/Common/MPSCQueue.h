@@ -0,0 +1,105 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a bounded lockless thread-safe,
+// multiple producer, single consumer queue
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+template <typename T, size_t Capacity>
+class MPSCQueue
+{
+  static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+public:
+  MPSCQueue() { Clear(); }
+
+  // Returns false without modifying the queue if it is full.
+  template <typename Arg>
+  bool TryPush(Arg&& t)
+  {
+    size_t pos = m_write_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+      Cell& cell = m_cells[pos & (Capacity - 1)];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      if (sequence == pos)
+      {
+        // The cell is free; try to claim it.
+        if (m_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          cell.value = std::forward<Arg>(t);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+        m_contention_count.fetch_add(1, std::memory_order_relaxed);
+      }
+      else if (sequence < pos)
+      {
+        // The consumer hasn't popped the element of the previous lap yet.
+        return false;
+      }
+      else
+      {
+        // Another producer claimed the cell first.
+        m_contention_count.fetch_add(1, std::memory_order_relaxed);
+        pos = m_write_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Only one thread at a time may pop. An element which has been claimed by a producer but not
+  // written yet is treated as absent, along with everything after it.
+  bool Pop(T& t)
+  {
+    Cell& cell = m_cells[m_read_pos & (Capacity - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != m_read_pos + 1)
+      return false;
+
+    t = std::move(cell.value);
+    cell.sequence.store(m_read_pos + Capacity, std::memory_order_release);
+    ++m_read_pos;
+    return true;
+  }
+
+  // How often a producer lost a race for a cell against another producer.
+  u64 GetContentionCount() const { return m_contention_count.load(std::memory_order_relaxed); }
+
+  // not thread-safe
+  void Clear()
+  {
+    for (size_t i = 0; i < Capacity; ++i)
+    {
+      m_cells[i].value = T{};
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_write_pos.store(0, std::memory_order_relaxed);
+    m_read_pos = 0;
+    m_contention_count.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  struct Cell
+  {
+    // Equal to the write position which may fill this cell next, or one past the write position
+    // which filled it if it holds an element.
+    std::atomic<size_t> sequence;
+    T value{};
+  };
+
+  std::array<Cell, Capacity> m_cells;
+  alignas(64) std::atomic<size_t> m_write_pos;
+  alignas(64) size_t m_read_pos;
+  std::atomic<u64> m_contention_count;
+};
+}  // namespace Common
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -34,8 +35,16 @@ public:
   /// CreateView() and ReleaseView(). Used to make a mappable region for emulated memory.
   ///
   /// @param size The amount of bytes that should be allocated in this region.
+  /// @param shareable Whether other processes should be able to open the segment by name while it
+  ///                  exists. See GetSHMSegmentName().
   ///
-  void GrabSHMSegment(size_t size);
+  void GrabSHMSegment(size_t size, bool shareable = false);
+
+  ///
+  /// Get the name under which other processes can open the memory segment, or an empty string if
+  /// it can't be opened from other processes.
+  ///
+  std::string GetSHMSegmentName() const;
 
   ///
   /// Release the memory segment previously allocated with GrabSHMSegment().
@@ -112,11 +121,13 @@ private:
   void* m_address_UnmapViewOfFileEx = nullptr;
   void* m_address_VirtualAlloc2 = nullptr;
   void* m_address_MapViewOfFile3 = nullptr;
+  std::string m_shm_name;
 #else
 #ifdef ANDROID
   int fd;
 #else
   int m_shm_fd;
+  std::string m_shm_name;
   void* m_reserved_region;
   std::size_t m_reserved_region_size;
 #endif
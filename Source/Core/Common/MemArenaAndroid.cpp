@@ -62,7 +62,7 @@ static int AshmemCreateFileMapping(const char* name, size_t size)
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool shareable)
 {
   fd = AshmemCreateFileMapping(("dolphin-emu." + std::to_string(getpid())).c_str(), size);
   if (fd < 0)
@@ -74,6 +74,12 @@ void MemArena::ReleaseSHMSegment()
   close(fd);
 }
 
+std::string MemArena::GetSHMSegmentName() const
+{
+  // Ashmem regions can't be opened by name.
+  return {};
+}
+
 void* MemArena::CreateView(s64 offset, size_t size)
 {
   return MapInMemoryRegion(offset, size, nullptr);
@@ -25,16 +25,24 @@ namespace Common
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool shareable)
 {
   const std::string file_name = "/dolphin-emu." + std::to_string(getpid());
+
+  // A segment with the same name can only be left over from a process that crashed.
+  if (shareable)
+    shm_unlink(file_name.c_str());
+
   m_shm_fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
   if (m_shm_fd == -1)
   {
     ERROR_LOG_FMT(MEMMAP, "shm_open failed: {}", strerror(errno));
     return;
   }
-  shm_unlink(file_name.c_str());
+  if (shareable)
+    m_shm_name = file_name;
+  else
+    shm_unlink(file_name.c_str());
   if (ftruncate(m_shm_fd, size) < 0)
     ERROR_LOG_FMT(MEMMAP, "Failed to allocate low memory space");
 }
@@ -42,6 +50,16 @@ void MemArena::GrabSHMSegment(size_t size)
 void MemArena::ReleaseSHMSegment()
 {
   close(m_shm_fd);
+  if (!m_shm_name.empty())
+  {
+    shm_unlink(m_shm_name.c_str());
+    m_shm_name.clear();
+  }
+}
+
+std::string MemArena::GetSHMSegmentName() const
+{
+  return m_shm_name;
 }
 
 void* MemArena::CreateView(s64 offset, size_t size)
@@ -97,11 +97,14 @@ MemArena::~MemArena()
   ReleaseSHMSegment();
 }
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool shareable)
 {
+  // Named mappings can always be opened by other processes.
   const std::string name = "dolphin-emu." + std::to_string(GetCurrentProcessId());
   m_memory_handle = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
                                       static_cast<DWORD>(size), UTF8ToTStr(name).c_str());
+  if (m_memory_handle)
+    m_shm_name = name;
 }
 
 void MemArena::ReleaseSHMSegment()
@@ -110,6 +113,12 @@ void MemArena::ReleaseSHMSegment()
     return;
   CloseHandle(m_memory_handle);
   m_memory_handle = nullptr;
+  m_shm_name.clear();
+}
+
+std::string MemArena::GetSHMSegmentName() const
+{
+  return m_shm_name;
 }
 
 void* MemArena::CreateView(s64 offset, size_t size)
@@ -3,9 +3,11 @@
 
 #include "Common/MemoryUtil.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
@@ -14,12 +16,15 @@
 
 #ifdef _WIN32
 #include <windows.h>
+#include <psapi.h>
 #include "Common/StringUtil.h"
 #else
 #include <pthread.h>
 #include <stdio.h>
 #include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/types.h>
+#include <unistd.h>
 #if defined __APPLE__ || defined __FreeBSD__ || defined __OpenBSD__ || defined __NetBSD__
 #include <sys/sysctl.h>
 #elif defined __HAIKU__
@@ -34,19 +39,61 @@ namespace Common
 // This is purposely not a full wrapper for virtualalloc/mmap, but it
 // provides exactly the primitive operations that Dolphin needs.
 
-void* AllocateExecutableMemory(size_t size)
+static void* AllocateExecutableLargePages(size_t size)
 {
+  if (size % LARGE_PAGE_SIZE != 0)
+    return nullptr;
+
 #if defined(_WIN32)
-  void* ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+  // This requires the "Lock pages in memory" privilege.
+  const size_t minimum = GetLargePageMinimum();
+  if (minimum == 0 || size % minimum != 0)
+    return nullptr;
+  return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES,
+                      PAGE_EXECUTE_READWRITE);
+#elif defined(__linux__)
+  // Explicit huge pages only work if the administrator has reserved some.
+  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC,
+                   MAP_ANON | MAP_PRIVATE | MAP_HUGETLB, -1, 0);
+  if (ptr != MAP_FAILED)
+    return ptr;
+
+  // Otherwise, ask for transparent huge pages.
+  ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_ANON | MAP_PRIVATE, -1, 0);
+  if (ptr == MAP_FAILED)
+    return nullptr;
+  if (madvise(ptr, size, MADV_HUGEPAGE) != 0)
+    WARN_LOG_FMT(MEMMAP, "madvise(MADV_HUGEPAGE) failed: {}", LastStrerrorString());
+  return ptr;
 #else
-  int map_flags = MAP_ANON | MAP_PRIVATE;
+  return nullptr;
+#endif
+}
+
+void* AllocateExecutableMemory(size_t size, bool use_large_pages)
+{
+  void* ptr = nullptr;
+  if (use_large_pages)
+  {
+    ptr = AllocateExecutableLargePages(size);
+    if (ptr == nullptr)
+      WARN_LOG_FMT(MEMMAP, "Failed to allocate large pages, falling back to normal pages");
+  }
+
+  if (ptr == nullptr)
+  {
+#if defined(_WIN32)
+    ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+#else
+    int map_flags = MAP_ANON | MAP_PRIVATE;
 #if defined(__APPLE__)
-  map_flags |= MAP_JIT;
+    map_flags |= MAP_JIT;
 #endif
-  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags, -1, 0);
-  if (ptr == MAP_FAILED)
-    ptr = nullptr;
+    ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags, -1, 0);
+    if (ptr == MAP_FAILED)
+      ptr = nullptr;
 #endif
+  }
 
   if (ptr == nullptr)
     PanicAlertFmt("Failed to allocate executable memory");
@@ -174,6 +221,21 @@ void FreeMemoryPages(void* ptr, size_t size)
   }
 }
 
+void DiscardMemoryPages(void* ptr, size_t size)
+{
+#ifdef _WIN32
+  if (!VirtualFree(ptr, size, MEM_DECOMMIT) || !VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE))
+    PanicAlertFmt("DiscardMemoryPages failed!\nVirtualAlloc: {}", GetLastErrorString());
+#else
+  // Replacing the mapping works everywhere, unlike madvise, which doesn't zero pages on all OSes.
+  if (mmap(ptr, size, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE | MAP_FIXED, -1, 0) ==
+      MAP_FAILED)
+  {
+    PanicAlertFmt("DiscardMemoryPages failed!\nmmap: {}", LastStrerrorString());
+  }
+#endif
+}
+
 void FreeAlignedMemory(void* ptr)
 {
   if (ptr)
@@ -263,4 +325,50 @@ size_t MemPhysical()
 #endif
 }
 
+size_t MemResidentSize(const void* ptr, size_t size)
+{
+#if defined(_WIN32) || defined(__HAIKU__)
+  return size;
+#else
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1);
+  const uintptr_t end = reinterpret_cast<uintptr_t>(ptr) + size;
+  std::vector<unsigned char> pages((end - begin + page_size - 1) / page_size);
+#ifdef __linux__
+  unsigned char* const vec = pages.data();
+#else
+  char* const vec = reinterpret_cast<char*>(pages.data());
+#endif
+  if (mincore(reinterpret_cast<void*>(begin), end - begin, vec) != 0)
+    return size;
+
+  size_t resident_pages = 0;
+  for (const unsigned char page : pages)
+    resident_pages += page & 1;
+  return std::min(resident_pages * page_size, size);
+#endif
+}
+
+size_t MemPeakProcessUsage()
+{
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return 0;
+  return counters.PeakWorkingSetSize;
+#elif defined __HAIKU__
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  // Bytes on macOS, kilobytes everywhere else.
+  return static_cast<size_t>(usage.ru_maxrss);
+#else
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
 }  // namespace Common
@@ -8,7 +8,12 @@
 
 namespace Common
 {
-void* AllocateExecutableMemory(size_t size);
+// Size of the large pages used by AllocateExecutableMemory.
+constexpr size_t LARGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// If use_large_pages is set and size is a multiple of LARGE_PAGE_SIZE, the memory is backed by
+// large pages when the OS allows it, and by normal pages otherwise.
+void* AllocateExecutableMemory(size_t size, bool use_large_pages = false);
 
 // These two functions control the executable/writable state of the W^X memory
 // allocations. More detailed documentation about them is in the .cpp file.
@@ -28,11 +33,19 @@ struct ScopedJITPageWriteAndNoExecute
 };
 void* AllocateMemoryPages(size_t size);
 void FreeMemoryPages(void* ptr, size_t size);
+// Gives the physical memory behind pages from AllocateMemoryPages back to the OS. The pages read as
+// zero afterwards and are only backed again once they are written to.
+void DiscardMemoryPages(void* ptr, size_t size);
 void* AllocateAlignedMemory(size_t size, size_t alignment);
 void FreeAlignedMemory(void* ptr);
 void ReadProtectMemory(void* ptr, size_t size);
 void WriteProtectMemory(void* ptr, size_t size, bool executable = false);
 void UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute = false);
 size_t MemPhysical();
+// How much of the given mapping is backed by physical memory. On platforms where this can't be
+// queried, the whole size is returned.
+size_t MemResidentSize(const void* ptr, size_t size);
+// The most physical memory that this process has used at once, or 0 if it can't be queried.
+size_t MemPeakProcessUsage();
 
 }  // namespace Common
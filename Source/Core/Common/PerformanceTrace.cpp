@@ -0,0 +1,251 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/PerformanceTrace.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace Common::PerformanceTrace
+{
+namespace
+{
+constexpr u64 RING_SIZE = 1 << 16;
+
+// Events store the stage in the low byte, and the duration (or frame number) above it.
+constexpr u64 FRAME_EVENT = 0xff;
+constexpr u32 VALUE_SHIFT = 8;
+
+struct ThreadRing
+{
+  // Atomics, since the events are read while the thread may be overwriting them. Only the
+  // recording thread writes to them.
+  std::array<std::atomic<u64>, RING_SIZE> starts{};
+  std::array<std::atomic<u64>, RING_SIZE> values{};
+  std::atomic<u64> write_index = 0;
+
+  // Guarded by s_lock.
+  u32 thread_id = 0;
+  std::string name;
+  bool thread_exited = false;
+};
+
+std::mutex s_lock;
+std::vector<std::unique_ptr<ThreadRing>> s_rings;
+u32 s_next_thread_id = 1;
+
+std::array<std::atomic<u64>, static_cast<size_t>(Stage::Count)> s_stage_totals{};
+
+// Marks the ring of a thread as unused when the thread exits, so that it is freed once a new trace
+// is started.
+struct RingOwner
+{
+  ~RingOwner()
+  {
+    if (!ring)
+      return;
+
+    std::lock_guard lk(s_lock);
+    ring->thread_exited = true;
+  }
+
+  ThreadRing* ring = nullptr;
+  std::string name;
+};
+
+thread_local RingOwner t_owner;
+
+ThreadRing* GetRing()
+{
+  if (t_owner.ring)
+    return t_owner.ring;
+
+  auto ring = std::make_unique<ThreadRing>();
+  std::lock_guard lk(s_lock);
+  ring->thread_id = s_next_thread_id++;
+  ring->name = t_owner.name.empty() ? fmt::format("Thread {}", ring->thread_id) : t_owner.name;
+  t_owner.ring = ring.get();
+  s_rings.push_back(std::move(ring));
+  return t_owner.ring;
+}
+
+void Record(u64 start, u64 value)
+{
+  ThreadRing* const ring = GetRing();
+  const u64 index = ring->write_index.load(std::memory_order_relaxed);
+  ring->starts[index % RING_SIZE].store(start, std::memory_order_relaxed);
+  ring->values[index % RING_SIZE].store(value, std::memory_order_relaxed);
+  ring->write_index.store(index + 1, std::memory_order_release);
+}
+}  // namespace
+
+std::atomic<bool> g_enabled = false;
+
+const char* GetStageName(Stage stage)
+{
+  static constexpr std::array<const char*, static_cast<size_t>(Stage::Count)> names = {
+      "CPU emulation",
+      "CPU throttle",
+      "JIT compile",
+      "FIFO decode",
+      "Vertex loading",
+      "Shader compile wait",
+      "Texture hashing",
+      "Texture decoding",
+      "Backend submit",
+      "Present wait",
+  };
+  return names[static_cast<size_t>(stage)];
+}
+
+void SetEnabled(bool enabled)
+{
+  if (enabled)
+  {
+    std::lock_guard lk(s_lock);
+    std::erase_if(s_rings, [](const auto& ring) { return ring->thread_exited; });
+    for (const auto& ring : s_rings)
+      ring->write_index.store(0, std::memory_order_relaxed);
+    for (auto& total : s_stage_totals)
+      total.store(0, std::memory_order_relaxed);
+  }
+
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+u64 GetTimestamp()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void RecordStage(Stage stage, u64 start, u64 end)
+{
+  Record(start, ((end - start) << VALUE_SHIFT) | static_cast<u64>(stage));
+  s_stage_totals[static_cast<size_t>(stage)].fetch_add(end - start, std::memory_order_relaxed);
+}
+
+void RecordFrame(u64 frame_number)
+{
+  if (IsEnabled())
+    Record(GetTimestamp(), (frame_number << VALUE_SHIFT) | FRAME_EVENT);
+}
+
+u64 GetStageTotal(Stage stage)
+{
+  return s_stage_totals[static_cast<size_t>(stage)].load(std::memory_order_relaxed);
+}
+
+void SetCurrentThreadName(const char* name)
+{
+  t_owner.name = name;
+  if (!t_owner.ring)
+    return;
+
+  std::lock_guard lk(s_lock);
+  t_owner.ring->name = name;
+}
+
+bool ExportChromeTrace(const std::string& path)
+{
+  struct Event
+  {
+    u64 start;
+    u64 value;
+  };
+
+  std::string json = "{\"traceEvents\":[\n";
+  std::lock_guard lk(s_lock);
+
+  std::vector<std::vector<Event>> thread_events;
+  u64 first_timestamp = std::numeric_limits<u64>::max();
+  for (const auto& ring : s_rings)
+  {
+    const u64 end = ring->write_index.load(std::memory_order_acquire);
+    std::vector<Event>& events = thread_events.emplace_back();
+    for (u64 i = end > RING_SIZE ? end - RING_SIZE : 0; i < end; ++i)
+    {
+      events.push_back({ring->starts[i % RING_SIZE].load(std::memory_order_relaxed),
+                        ring->values[i % RING_SIZE].load(std::memory_order_relaxed)});
+    }
+
+    // Drop the oldest events if the thread has overwritten them in the meantime, including the
+    // one which it may be in the middle of overwriting.
+    const u64 new_end = ring->write_index.load(std::memory_order_acquire);
+    if (new_end >= RING_SIZE)
+    {
+      const u64 first_valid = new_end - RING_SIZE + 1;
+      const u64 first_read = end > RING_SIZE ? end - RING_SIZE : 0;
+      if (first_valid > first_read)
+      {
+        const u64 overwritten = std::min<u64>(first_valid - first_read, events.size());
+        events.erase(events.begin(), events.begin() + overwritten);
+      }
+    }
+
+    for (const Event& event : events)
+      first_timestamp = std::min(first_timestamp, event.start);
+  }
+
+  bool first_entry = true;
+  const auto append = [&](const std::string& entry) {
+    if (!first_entry)
+      json += ",\n";
+    json += entry;
+    first_entry = false;
+  };
+  const auto to_us = [](u64 ns) { return static_cast<double>(ns) / 1000.0; };
+
+  for (size_t i = 0; i < s_rings.size(); ++i)
+  {
+    const ThreadRing& ring = *s_rings[i];
+    append(fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},)"
+                       R"("args":{{"name":"{}"}}}})",
+                       ring.thread_id, ring.name));
+
+    for (const Event& event : thread_events[i])
+    {
+      const u64 stage = event.value & ((u64{1} << VALUE_SHIFT) - 1);
+      const u64 value = event.value >> VALUE_SHIFT;
+      const double ts = to_us(event.start - first_timestamp);
+      if (stage == FRAME_EVENT)
+      {
+        append(fmt::format(R"({{"name":"Frame {}","ph":"i","s":"g","pid":1,"tid":{},)"
+                           R"("ts":{:.3f}}})",
+                           value, ring.thread_id, ts));
+      }
+      else if (stage < static_cast<u64>(Stage::Count))
+      {
+        append(fmt::format(R"({{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},)"
+                           R"("dur":{:.3f}}})",
+                           GetStageName(static_cast<Stage>(stage)), ring.thread_id, ts,
+                           to_us(value)));
+      }
+    }
+  }
+  json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  File::CreateFullPath(path);
+  File::IOFile file(path, "wb");
+  if (!file.WriteString(json))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to write performance trace to {}", path);
+    return false;
+  }
+
+  NOTICE_LOG_FMT(COMMON, "Wrote performance trace to {}", path);
+  return true;
+}
+}  // namespace Common::PerformanceTrace
@@ -0,0 +1,78 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Records how long each thread spends in the stages of emulating a frame, so that frame time
+// spikes can be attributed without attaching a profiler. Every thread records into its own
+// lock-free ring which keeps the most recent events, and the rings can be exported in the Chrome
+// trace event format, which chrome://tracing and Perfetto can load.
+namespace Common::PerformanceTrace
+{
+enum class Stage : u8
+{
+  CPUEmulation,
+  CPUThrottle,
+  JITCompile,
+  FIFODecode,
+  VertexLoading,
+  ShaderCompileWait,
+  TextureHashing,
+  TextureDecoding,
+  BackendSubmit,
+  PresentWait,
+  Count
+};
+
+const char* GetStageName(Stage stage);
+
+extern std::atomic<bool> g_enabled;
+
+inline bool IsEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+// Enabling also discards all previously recorded events.
+void SetEnabled(bool enabled);
+
+// In nanoseconds, on a clock which is shared between threads.
+u64 GetTimestamp();
+
+void RecordStage(Stage stage, u64 start, u64 end);
+void RecordFrame(u64 frame_number);
+
+// Nanoseconds recorded for a stage by all threads since tracing was last enabled. Unlike the
+// events, these are never overwritten.
+u64 GetStageTotal(Stage stage);
+
+// Names the events recorded by the current thread.
+void SetCurrentThreadName(const char* name);
+
+// Writes the recorded events of all threads to a JSON file.
+bool ExportChromeTrace(const std::string& path);
+
+// Records the time until the end of the scope, doing nothing if tracing is disabled.
+class ScopedStage
+{
+public:
+  explicit ScopedStage(Stage stage) : m_stage(stage), m_start(IsEnabled() ? GetTimestamp() : 0) {}
+  ~ScopedStage()
+  {
+    if (m_start != 0)
+      RecordStage(m_stage, m_start, GetTimestamp());
+  }
+
+  ScopedStage(const ScopedStage&) = delete;
+  ScopedStage& operator=(const ScopedStage&) = delete;
+
+private:
+  Stage m_stage;
+  u64 m_start;
+};
+}  // namespace Common::PerformanceTrace
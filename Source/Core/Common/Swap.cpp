@@ -0,0 +1,127 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/Swap.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(_M_X86_64)
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace Common
+{
+namespace
+{
+// Arrays are swapped in chunks of this many bytes, the rest one element at a time.
+constexpr size_t CHUNK_SIZE = 64;
+
+template <int size>
+void SwapElements(u8* dst, const u8* src, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    std::array<u8, size> element;
+    std::memcpy(element.data(), src + i * size, size);
+    swap<size>(element.data());
+    std::memcpy(dst + i * size, element.data(), size);
+  }
+}
+
+#if defined(_M_X86_64)
+template <int size>
+FUNCTION_TARGET_SSSE3 size_t SwapChunks(u8* dst, const u8* src, size_t bytes)
+{
+  static constexpr auto shuffle = [] {
+    std::array<u8, 16> result{};
+    for (int i = 0; i < 16; ++i)
+      result[i] = static_cast<u8>(i / size * size + size - 1 - i % size);
+    return result;
+  }();
+  const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle.data()));
+
+  size_t offset = 0;
+  for (; offset + CHUNK_SIZE <= bytes; offset += CHUNK_SIZE)
+  {
+    const auto* in = reinterpret_cast<const __m128i*>(src + offset);
+    auto* out = reinterpret_cast<__m128i*>(dst + offset);
+    const __m128i a = _mm_loadu_si128(in);
+    const __m128i b = _mm_loadu_si128(in + 1);
+    const __m128i c = _mm_loadu_si128(in + 2);
+    const __m128i d = _mm_loadu_si128(in + 3);
+    _mm_storeu_si128(out, _mm_shuffle_epi8(a, mask));
+    _mm_storeu_si128(out + 1, _mm_shuffle_epi8(b, mask));
+    _mm_storeu_si128(out + 2, _mm_shuffle_epi8(c, mask));
+    _mm_storeu_si128(out + 3, _mm_shuffle_epi8(d, mask));
+  }
+  return offset;
+}
+#elif defined(_M_ARM_64)
+template <int size>
+uint8x16_t Reverse(uint8x16_t value)
+{
+  if constexpr (size == 2)
+    return vrev16q_u8(value);
+  else if constexpr (size == 4)
+    return vrev32q_u8(value);
+  else
+    return vrev64q_u8(value);
+}
+
+template <int size>
+size_t SwapChunks(u8* dst, const u8* src, size_t bytes)
+{
+  size_t offset = 0;
+  for (; offset + CHUNK_SIZE <= bytes; offset += CHUNK_SIZE)
+  {
+    const uint8x16_t a = vld1q_u8(src + offset);
+    const uint8x16_t b = vld1q_u8(src + offset + 16);
+    const uint8x16_t c = vld1q_u8(src + offset + 32);
+    const uint8x16_t d = vld1q_u8(src + offset + 48);
+    vst1q_u8(dst + offset, Reverse<size>(a));
+    vst1q_u8(dst + offset + 16, Reverse<size>(b));
+    vst1q_u8(dst + offset + 32, Reverse<size>(c));
+    vst1q_u8(dst + offset + 48, Reverse<size>(d));
+  }
+  return offset;
+}
+#endif
+
+template <int size>
+void SwapArray(void* dst, const void* src, size_t count)
+{
+  auto* out = static_cast<u8*>(dst);
+  const auto* in = static_cast<const u8*>(src);
+  const size_t bytes = count * size;
+
+  size_t done = 0;
+#if defined(_M_X86_64)
+  if (cpu_info.bSSSE3)
+    done = SwapChunks<size>(out, in, bytes);
+#elif defined(_M_ARM_64)
+  done = SwapChunks<size>(out, in, bytes);
+#endif
+
+  SwapElements<size>(out + done, in + done, (bytes - done) / size);
+}
+}  // namespace
+
+void SwapArray16(void* dst, const void* src, size_t count)
+{
+  SwapArray<2>(dst, src, count);
+}
+
+void SwapArray32(void* dst, const void* src, size_t count)
+{
+  SwapArray<4>(dst, src, count);
+}
+
+void SwapArray64(void* dst, const void* src, size_t count)
+{
+  SwapArray<8>(dst, src, count);
+}
+}  // namespace Common
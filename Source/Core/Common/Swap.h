@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstring>
 #include <type_traits>
 
@@ -166,6 +167,37 @@ inline T FromBigEndian(T data)
   return data;
 }
 
+// Byteswap count elements of 2, 4 or 8 bytes from src to dst. src and dst must either be the same
+// or not overlap at all.
+void SwapArray16(void* dst, const void* src, size_t count);
+void SwapArray32(void* dst, const void* src, size_t count);
+void SwapArray64(void* dst, const void* src, size_t count);
+
+template <typename T>
+inline void FromBigEndianArray(T* dst, const T* src, size_t count)
+{
+  static_assert(std::is_arithmetic<T>::value, "function only makes sense with arithmetic types");
+
+  if constexpr (sizeof(T) == 1)
+  {
+    if (dst != src)
+      std::memcpy(dst, src, count);
+  }
+  else if constexpr (sizeof(T) == 2)
+  {
+    SwapArray16(dst, src, count);
+  }
+  else if constexpr (sizeof(T) == 4)
+  {
+    SwapArray32(dst, src, count);
+  }
+  else
+  {
+    static_assert(sizeof(T) == 8);
+    SwapArray64(dst, src, count);
+  }
+}
+
 template <typename value_type>
 struct BigEndianValue
 {
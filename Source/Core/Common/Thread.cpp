@@ -27,6 +27,7 @@
 
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/PerformanceTrace.h"
 #include "Common/StringUtil.h"
 
 namespace Common
@@ -113,6 +114,7 @@ void SetCurrentThreadName(const char* name)
 {
   SetCurrentThreadNameViaException(name);
   SetCurrentThreadNameViaApi(name);
+  PerformanceTrace::SetCurrentThreadName(name);
 }
 
 #else  // !WIN32, so must be POSIX threads
@@ -183,6 +185,7 @@ void SetCurrentThreadName(const char* name)
   // API.
   __itt_thread_set_name(name);
 #endif
+  PerformanceTrace::SetCurrentThreadName(name);
 }
 
 #endif
@@ -5,16 +5,25 @@
 
 #include <chrono>
 
+#include <algorithm>
+#include <thread>
+
 #ifdef _WIN32
 #include <Windows.h>
 #include <ctime>
 #include <timeapi.h>
 #else
+#include <cerrno>
 #include <sys/time.h>
+#include <time.h>
 #endif
 
 #include "Common/CommonTypes.h"
 
+#if defined(_WIN32) && !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 namespace Common
 {
 template <typename Clock, typename Duration>
@@ -119,4 +128,86 @@ void Timer::RestoreResolution()
 #endif
 }
 
+// Wakeups later than this are preemption rather than timer imprecision, and shouldn't make every
+// following sleep spin for that long.
+constexpr u64 MAX_WAKEUP_LATENCY_US = 2000;
+
+PreciseSleeper::~PreciseSleeper()
+{
+#ifdef _WIN32
+  if (m_timer)
+    CloseHandle(m_timer);
+#endif
+}
+
+void PreciseSleeper::SleepFor(u64 duration_us)
+{
+#ifdef _WIN32
+  if (!m_timer)
+  {
+    // High resolution timers need Windows 10 1803. Older versions get a regular one, which
+    // timeBeginPeriod(1) makes precise to about a millisecond.
+    m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                     TIMER_ALL_ACCESS);
+    if (!m_timer)
+      m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+  }
+
+  // Negative due times are relative, in 100 ns units.
+  LARGE_INTEGER due_time;
+  due_time.QuadPart = -static_cast<LONGLONG>(duration_us * 10);
+  if (m_timer && SetWaitableTimer(m_timer, &due_time, 0, nullptr, nullptr, FALSE))
+    WaitForSingleObject(m_timer, INFINITE);
+  else
+    Sleep(static_cast<DWORD>(duration_us / 1000));
+#elif defined(__linux__)
+  // An absolute deadline doesn't drift when the sleep gets interrupted by a signal.
+  timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += static_cast<time_t>(duration_us / 1000000);
+  deadline.tv_nsec += static_cast<long>(duration_us % 1000000) * 1000;
+  if (deadline.tv_nsec >= 1000000000)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000;
+  }
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+  {
+  }
+#else
+  std::this_thread::sleep_for(std::chrono::microseconds(duration_us));
+#endif
+}
+
+void PreciseSleeper::SleepUntil(u64 deadline_us)
+{
+  u64 now = Timer::NowUs();
+  if (deadline_us > now + m_wakeup_latency_us)
+  {
+    const u64 wakeup_target = deadline_us - m_wakeup_latency_us;
+    SleepFor(wakeup_target - now);
+    now = Timer::NowUs();
+
+    const u64 latency =
+        now > wakeup_target ? std::min(now - wakeup_target, MAX_WAKEUP_LATENCY_US) : 0;
+    if (latency > m_wakeup_latency_us)
+      m_wakeup_latency_us = latency;
+    else
+      m_wakeup_latency_us = (m_wakeup_latency_us * 15 + latency) / 16;
+  }
+
+  const u64 spin_start = now;
+  while (now < deadline_us)
+  {
+    std::this_thread::yield();
+    now = Timer::NowUs();
+  }
+
+  m_stats.sleeps++;
+  m_stats.total_spin_us += now - spin_start;
+  const u64 lateness = now - deadline_us;
+  m_stats.total_lateness_us += lateness;
+  m_stats.max_lateness_us = std::max(m_stats.max_lateness_us, lateness);
+}
+
 }  // Namespace Common
@@ -32,4 +32,43 @@ private:
   bool m_running{false};
 };
 
+// Sleeps until a deadline with the most precise timer the OS has: a high resolution waitable
+// timer on Windows and an absolute clock_nanosleep on Linux. Since these still wake up late, the
+// sleep ends early by how late recent wakeups were, and the rest is spent yielding. That keeps
+// the spinning, and the host CPU time it costs, to a few dozen microseconds.
+class PreciseSleeper
+{
+public:
+  struct Stats
+  {
+    u64 sleeps = 0;
+    // How long past the deadline SleepUntil returned.
+    u64 total_lateness_us = 0;
+    u64 max_lateness_us = 0;
+    u64 total_spin_us = 0;
+  };
+
+  PreciseSleeper() = default;
+  ~PreciseSleeper();
+  PreciseSleeper(const PreciseSleeper&) = delete;
+  PreciseSleeper& operator=(const PreciseSleeper&) = delete;
+
+  // deadline_us is in Timer::NowUs() time.
+  void SleepUntil(u64 deadline_us);
+
+  const Stats& GetStats() const { return m_stats; }
+  void ResetStats() { m_stats = {}; }
+
+private:
+  void SleepFor(u64 duration_us);
+
+  // How late the OS timer has recently woken up. Follows increases immediately and decreases
+  // slowly, like the frame pacing estimate in SystemTimers.
+  u64 m_wakeup_latency_us = 500;
+  Stats m_stats;
+#ifdef _WIN32
+  void* m_timer = nullptr;
+#endif
+};
+
 }  // Namespace Common
@@ -1,7 +1,9 @@
 // SPDX-License-Identifier: CC0-1.0
 
 // The central server implementation.
+#include <algorithm>
 #include <arpa/inet.h>
+#include <array>
 #include <cerrno>
 #include <chrono>
 #include <cstdio>
@@ -26,9 +28,17 @@
 #define DEBUG 0
 #define NUMBER_OF_TRIES 5
 #define PORT 6262
+// Packets are received and sent in batches of up to this many.
+#define BATCH_SIZE 64
+#define STATS_INTERVAL (60 * 1000000)  // 60s
 
 static u64 currentTime;
 
+// Hosts which haven't pinged the server for this long are forgotten.
+static constexpr u64 HOST_EXPIRY_TIME = 30 * 1000000;  // 30s
+// Packets which haven't been acknowledged are resent after this times the number of tries.
+static constexpr u64 RESEND_INTERVAL = 300000;  // 300ms
+
 struct OutgoingPacketInfo
 {
   TraversalPacket packet;
@@ -38,68 +48,71 @@ struct OutgoingPacketInfo
   u64 sendTime;
 };
 
-template <typename T>
-struct EvictEntry
+struct HostInfo
 {
   u64 updateTime;
-  T value;
+  TraversalInetAddress address;
 };
 
-template <typename V>
-struct EvictFindResult
+struct Datagram
 {
-  bool found;
-  V* value;
+  TraversalPacket packet;
+  sockaddr_in6 addr;
+  size_t size;
 };
 
-template <typename K, typename V>
-EvictFindResult<V> EvictFind(std::unordered_map<K, EvictEntry<V>>& map, const K& key,
-                             bool refresh = false)
+struct Stats
 {
-retry:
-  const u64 expiryTime = 30 * 1000000;  // 30s
-  EvictFindResult<V> result;
-  if (map.bucket_count())
+  u64 received = 0;
+  u64 sent = 0;
+  u64 resent = 0;
+  u64 clientsDidntRespond = 0;
+};
+
+// Sorts keys into slots by the time they are due at, so that finding the ones which are due
+// doesn't require looking at all of them. Keys are never removed, so the callback passed to Advance
+// has to check whether a key is still relevant, and can schedule it again if it isn't due yet.
+template <typename K, size_t NumSlots>
+class TimingWheel
+{
+public:
+  explicit TimingWheel(u64 slotTime) : m_slotTime(slotTime) {}
+
+  void Start(u64 now) { m_nextTick = now / m_slotTime; }
+
+  // time must be less than NumSlots slots after the last call to Advance.
+  void Schedule(const K& key, u64 time)
   {
-    auto bucket = map.bucket(key);
-    auto it = map.begin(bucket);
-    for (; it != map.end(bucket); ++it)
-    {
-      if (currentTime - it->second.updateTime > expiryTime)
-      {
-        map.erase(it->first);
-        goto retry;
-      }
-      if (it->first == key)
-      {
-        if (refresh)
-          it->second.updateTime = currentTime;
-        result.found = true;
-        result.value = &it->second.value;
-        return result;
-      }
-    }
+    const u64 tick = std::max(time / m_slotTime, m_nextTick);
+    m_slots[tick % NumSlots].push_back(key);
   }
-#if DEBUG
-  printf("failed to find key '");
-  for (size_t i = 0; i < sizeof(key); i++)
+
+  // Calls callback for the keys in all slots which have passed since the last call. Keys are at
+  // most one slot late.
+  template <typename F>
+  void Advance(u64 now, F&& callback)
   {
-    printf("%02x", ((u8*)&key)[i]);
+    const u64 currentTick = now / m_slotTime;
+    // After a long pause, every slot is due anyway.
+    if (currentTick - m_nextTick > NumSlots)
+      m_nextTick = currentTick - NumSlots;
+
+    while (m_nextTick < currentTick)
+    {
+      m_due.swap(m_slots[m_nextTick % NumSlots]);
+      m_nextTick++;
+      for (const K& key : m_due)
+        callback(key);
+      m_due.clear();
+    }
   }
-  printf("'\n");
-#endif
-  result.found = false;
-  return result;
-}
 
-template <typename K, typename V>
-V* EvictSet(std::unordered_map<K, EvictEntry<V>>& map, const K& key)
-{
-  // can't use a local_iterator to emplace...
-  auto& result = map[key];
-  result.updateTime = currentTime;
-  return &result.value;
-}
+private:
+  u64 m_slotTime;
+  u64 m_nextTick = 0;
+  std::array<std::vector<K>, NumSlots> m_slots;
+  std::vector<K> m_due;
+};
 
 namespace std
 {
@@ -116,7 +129,69 @@ struct hash<TraversalHostId>
 
 static int sock;
 static std::unordered_map<TraversalRequestId, OutgoingPacketInfo> outgoingPackets;
-static std::unordered_map<TraversalHostId, EvictEntry<TraversalInetAddress>> connectedClients;
+static std::unordered_map<TraversalHostId, HostInfo> connectedClients;
+// Packets allocated since the last call to ResendPackets, which haven't been sent yet.
+static std::vector<TraversalRequestId> newPackets;
+static TimingWheel<TraversalRequestId, 32> resendWheel(100000);  // 100ms slots
+static TimingWheel<TraversalHostId, 64> hostExpiryWheel(1000000);  // 1s slots
+static std::array<Datagram, BATCH_SIZE> received;
+static std::vector<Datagram> sendQueue;
+static Stats stats;
+static u64 lastStatsTime;
+
+static u64 GetCurrentTime()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+static TraversalInetAddress* FindHost(const TraversalHostId& hostId, bool refresh = false)
+{
+  auto it = connectedClients.find(hostId);
+  // Hosts stay in the map for up to a second after expiring.
+  if (it == connectedClients.end() || currentTime - it->second.updateTime > HOST_EXPIRY_TIME)
+  {
+#if DEBUG
+    printf("failed to find key '");
+    for (size_t i = 0; i < sizeof(hostId); i++)
+    {
+      printf("%02x", ((u8*)&hostId)[i]);
+    }
+    printf("'\n");
+#endif
+    return nullptr;
+  }
+  if (refresh)
+    it->second.updateTime = currentTime;
+  return &it->second.address;
+}
+
+static TraversalInetAddress* AddHost(const TraversalHostId& hostId)
+{
+  auto [it, inserted] = connectedClients.try_emplace(hostId);
+  it->second.updateTime = currentTime;
+  // An expired host which is still in the map already has a slot in the wheel.
+  if (inserted)
+    hostExpiryWheel.Schedule(hostId, currentTime + HOST_EXPIRY_TIME + 1);
+  return &it->second.address;
+}
+
+static void ExpireHosts()
+{
+  hostExpiryWheel.Advance(currentTime, [](const TraversalHostId& hostId) {
+    auto it = connectedClients.find(hostId);
+    if (it == connectedClients.end())
+      return;
+
+    // Pings only refresh the update time, so the host is moved to its new slot here.
+    const u64 expiryTime = it->second.updateTime + HOST_EXPIRY_TIME;
+    if (currentTime > expiryTime)
+      connectedClients.erase(it);
+    else
+      hostExpiryWheel.Schedule(hostId, expiryTime + 1);
+  });
+}
 
 static TraversalInetAddress MakeInetAddress(const sockaddr_in6& addr)
 {
@@ -182,17 +257,94 @@ static const char* SenderName(sockaddr_in6* addr)
   return buf;
 }
 
-static void TrySend(const void* buffer, size_t size, sockaddr_in6* addr)
+static void TrySend(const TraversalPacket& packet, const sockaddr_in6& addr)
 {
 #if DEBUG
-  const auto* packet = static_cast<const TraversalPacket*>(buffer);
-  printf("-> %d %llu %s\n", static_cast<int>(packet->type),
-         static_cast<long long>(packet->requestId), SenderName(addr));
+  sockaddr_in6 dest = addr;
+  printf("-> %d %llu %s\n", static_cast<int>(packet.type), static_cast<long long>(packet.requestId),
+         SenderName(&dest));
+#endif
+  sendQueue.push_back({packet, addr, sizeof(packet)});
+}
+
+static void FlushSends()
+{
+#ifdef __linux__
+  std::array<mmsghdr, BATCH_SIZE> msgs{};
+  std::array<iovec, BATCH_SIZE> iovs;
+  for (size_t i = 0; i < sendQueue.size();)
+  {
+    const size_t count = std::min<size_t>(sendQueue.size() - i, BATCH_SIZE);
+    for (size_t j = 0; j < count; j++)
+    {
+      Datagram& datagram = sendQueue[i + j];
+      iovs[j].iov_base = &datagram.packet;
+      iovs[j].iov_len = datagram.size;
+      msgs[j].msg_hdr.msg_name = &datagram.addr;
+      msgs[j].msg_hdr.msg_namelen = sizeof(datagram.addr);
+      msgs[j].msg_hdr.msg_iov = &iovs[j];
+      msgs[j].msg_hdr.msg_iovlen = 1;
+    }
+    int rv = sendmmsg(sock, msgs.data(), static_cast<unsigned int>(count), 0);
+    if (rv < 0)
+    {
+      // Drop the packet which couldn't be sent, as with sendto.
+      perror("sendmmsg");
+      rv = 1;
+    }
+    else
+    {
+      stats.sent += rv;
+    }
+    i += rv;
+  }
+#else
+  for (Datagram& datagram : sendQueue)
+  {
+    if ((size_t)sendto(sock, &datagram.packet, datagram.size, 0, (sockaddr*)&datagram.addr,
+                       sizeof(datagram.addr)) != datagram.size)
+    {
+      perror("sendto");
+    }
+    else
+    {
+      stats.sent++;
+    }
+  }
 #endif
-  if ((size_t)sendto(sock, buffer, size, 0, (sockaddr*)addr, sizeof(*addr)) != size)
+  sendQueue.clear();
+}
+
+// Returns the number of packets received into the received array, or -1 on errors and timeouts.
+static int ReceivePackets()
+{
+#ifdef __linux__
+  std::array<mmsghdr, BATCH_SIZE> msgs{};
+  std::array<iovec, BATCH_SIZE> iovs;
+  for (size_t i = 0; i < BATCH_SIZE; i++)
   {
-    perror("sendto");
+    iovs[i].iov_base = &received[i].packet;
+    iovs[i].iov_len = sizeof(received[i].packet);
+    msgs[i].msg_hdr.msg_name = &received[i].addr;
+    msgs[i].msg_hdr.msg_namelen = sizeof(received[i].addr);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
   }
+  // Waits for the first packet (or the receive timeout), then takes the ones which are already
+  // queued without waiting.
+  const int rv = recvmmsg(sock, msgs.data(), BATCH_SIZE, MSG_WAITFORONE, nullptr);
+  for (int i = 0; i < rv; i++)
+    received[i].size = msgs[i].msg_len;
+  return rv;
+#else
+  socklen_t addrLen = sizeof(received[0].addr);
+  const ssize_t rv = recvfrom(sock, &received[0].packet, sizeof(received[0].packet), 0,
+                              (sockaddr*)&received[0].addr, &addrLen);
+  if (rv < 0)
+    return -1;
+  received[0].size = rv;
+  return 1;
+#endif
 }
 
 static TraversalPacket* AllocPacket(const sockaddr_in6& dest, TraversalRequestId misc = 0)
@@ -207,41 +359,49 @@ static TraversalPacket* AllocPacket(const sockaddr_in6& dest, TraversalRequestId
   TraversalPacket* result = &info->packet;
   memset(result, 0, sizeof(*result));
   result->requestId = requestId;
+  newPackets.push_back(requestId);
   return result;
 }
 
 static void SendPacket(OutgoingPacketInfo* info)
 {
+  if (info->tries != 0)
+    stats.resent++;
   info->tries++;
   info->sendTime = currentTime;
-  TrySend(&info->packet, sizeof(info->packet), &info->dest);
+  TrySend(info->packet, info->dest);
+  resendWheel.Schedule(info->packet.requestId, currentTime + RESEND_INTERVAL * info->tries);
 }
 
 static void ResendPackets()
 {
   std::vector<std::pair<TraversalInetAddress, TraversalRequestId>> todoFailures;
-  todoFailures.clear();
-  for (auto it = outgoingPackets.begin(); it != outgoingPackets.end();)
-  {
+  resendWheel.Advance(currentTime, [&todoFailures](TraversalRequestId requestId) {
+    auto it = outgoingPackets.find(requestId);
+    // Already acknowledged.
+    if (it == outgoingPackets.end())
+      return;
+
     OutgoingPacketInfo* info = &it->second;
-    if (currentTime - info->sendTime >= (u64)(300000 * info->tries))
+    const u64 resendTime = info->sendTime + RESEND_INTERVAL * info->tries;
+    if (currentTime < resendTime)
     {
-      if (info->tries >= NUMBER_OF_TRIES)
-      {
-        if (info->packet.type == TraversalPacketType::PleaseSendPacket)
-        {
-          todoFailures.push_back(std::make_pair(info->packet.pleaseSendPacket.address, info->misc));
-        }
-        it = outgoingPackets.erase(it);
-        continue;
-      }
-      else
+      resendWheel.Schedule(requestId, resendTime);
+      return;
+    }
+
+    if (info->tries >= NUMBER_OF_TRIES)
+    {
+      if (info->packet.type == TraversalPacketType::PleaseSendPacket)
       {
-        SendPacket(info);
+        todoFailures.push_back(std::make_pair(info->packet.pleaseSendPacket.address, info->misc));
       }
+      outgoingPackets.erase(it);
+      return;
     }
-    ++it;
-  }
+
+    SendPacket(info);
+  });
 
   for (const auto& p : todoFailures)
   {
@@ -250,6 +410,41 @@ static void ResendPackets()
     fail->connectFailed.requestId = p.second;
     fail->connectFailed.reason = TraversalConnectFailedReason::ClientDidntRespond;
   }
+  stats.clientsDidntRespond += todoFailures.size();
+
+  for (TraversalRequestId requestId : newPackets)
+  {
+    auto it = outgoingPackets.find(requestId);
+    if (it != outgoingPackets.end())
+      SendPacket(&it->second);
+  }
+  newPackets.clear();
+}
+
+static void ReportStats()
+{
+  const u64 elapsed = currentTime - lastStatsTime;
+  if (elapsed < STATS_INTERVAL)
+    return;
+
+  const auto perSecond = [elapsed](u64 count) {
+    return static_cast<unsigned long long>(count * 1000000 / elapsed);
+  };
+  char status[256];
+  snprintf(status, sizeof(status),
+           "%zu hosts, %zu packets awaiting ack, %llu received/s, %llu sent/s, %llu resent/s, "
+           "%llu connects failed",
+           connectedClients.size(), outgoingPackets.size(), perSecond(stats.received),
+           perSecond(stats.sent), perSecond(stats.resent),
+           static_cast<unsigned long long>(stats.clientsDidntRespond));
+  printf("%s\n", status);
+  fflush(stdout);
+#ifdef HAVE_LIBSYSTEMD
+  sd_notifyf(0, "STATUS=Listening on port %d: %s", PORT, status);
+#endif
+
+  stats = {};
+  lastStatsTime = currentTime;
 }
 
 static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
@@ -291,8 +486,7 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
   }
   case TraversalPacketType::Ping:
   {
-    auto r = EvictFind(connectedClients, packet->ping.hostId, true);
-    packetOk = r.found;
+    packetOk = FindHost(packet->ping.hostId, true) != nullptr;
     break;
   }
   case TraversalPacketType::HelloFromClient:
@@ -307,16 +501,11 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
       TraversalInetAddress* iaddr;
       // not that there is any significant change of
       // duplication, but...
-      GetRandomHostId(&hostId);
-      while (true)
+      do
       {
-        auto r = EvictFind(connectedClients, hostId);
-        if (!r.found)
-        {
-          iaddr = EvictSet(connectedClients, hostId);
-          break;
-        }
-      }
+        GetRandomHostId(&hostId);
+      } while (FindHost(hostId));
+      iaddr = AddHost(hostId);
 
       *iaddr = MakeInetAddress(*addr);
 
@@ -328,8 +517,8 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
   case TraversalPacketType::ConnectPlease:
   {
     TraversalHostId& hostId = packet->connectPlease.hostId;
-    auto r = EvictFind(connectedClients, hostId);
-    if (!r.found)
+    TraversalInetAddress* hostAddr = FindHost(hostId);
+    if (!hostAddr)
     {
       TraversalPacket* reply = AllocPacket(*addr);
       reply->type = TraversalPacketType::ConnectFailed;
@@ -338,7 +527,7 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
     }
     else
     {
-      TraversalPacket* please = AllocPacket(MakeSinAddr(*r.value), packet->requestId);
+      TraversalPacket* please = AllocPacket(MakeSinAddr(*hostAddr), packet->requestId);
       please->type = TraversalPacketType::PleaseSendPacket;
       please->pleaseSendPacket.address = MakeInetAddress(*addr);
     }
@@ -355,7 +544,7 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
     ack.type = TraversalPacketType::Ack;
     ack.requestId = packet->requestId;
     ack.ack.ok = packetOk;
-    TrySend(&ack, sizeof(ack), addr);
+    TrySend(ack, *addr);
   }
 }
 
@@ -393,9 +582,10 @@ int main()
     return 1;
   }
 
+  // Also bounds how late packets are resent when the server is idle.
   timeval tv;
   tv.tv_sec = 0;
-  tv.tv_usec = 300000;
+  tv.tv_usec = 100000;
   rv = setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
   if (rv < 0)
   {
@@ -407,34 +597,40 @@ int main()
   sd_notifyf(0, "READY=1\nSTATUS=Listening on port %d", PORT);
 #endif
 
+  currentTime = GetCurrentTime();
+  lastStatsTime = currentTime;
+  resendWheel.Start(currentTime);
+  hostExpiryWheel.Start(currentTime);
+
   while (true)
   {
-    sockaddr_in6 raddr;
-    socklen_t addrLen = sizeof(raddr);
-    TraversalPacket packet;
-    // note: switch to recvmmsg (yes, mmsg) if this becomes
-    // expensive
-    rv = recvfrom(sock, &packet, sizeof(packet), 0, (sockaddr*)&raddr, &addrLen);
-    currentTime = std::chrono::duration_cast<std::chrono::microseconds>(
-                      std::chrono::system_clock::now().time_since_epoch())
-                      .count();
+    rv = ReceivePackets();
+    currentTime = GetCurrentTime();
     if (rv < 0)
     {
       if (errno != EINTR && errno != EAGAIN)
       {
-        perror("recvfrom");
+        perror("recv");
         return 1;
       }
     }
-    else if ((size_t)rv < sizeof(packet))
-    {
-      fprintf(stderr, "received short packet from %s\n", SenderName(&raddr));
-    }
-    else
+    for (int i = 0; i < rv; i++)
     {
-      HandlePacket(&packet, &raddr);
+      Datagram& datagram = received[i];
+      if (datagram.size < sizeof(datagram.packet))
+      {
+        fprintf(stderr, "received short packet from %s\n", SenderName(&datagram.addr));
+      }
+      else
+      {
+        stats.received++;
+        HandlePacket(&datagram.packet, &datagram.addr);
+      }
     }
     ResendPackets();
+    ExpireHosts();
+    FlushSends();
+    ReportStats();
 #ifdef HAVE_LIBSYSTEMD
     sd_notify(0, "WATCHDOG=1");
 #endif
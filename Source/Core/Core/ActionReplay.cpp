@@ -22,8 +22,10 @@
 
 #include <algorithm>
 #include <atomic>
+#include <functional>
 #include <iterator>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <utility>
 #include <variant>
@@ -81,9 +83,21 @@ enum
   SUB_MASTER_CODE = 0x03,
 };
 
+// A code which only uses operations that can't fail, turned into a closure per operation so
+// that it doesn't have to be decoded again every frame.
+struct CompiledOp
+{
+  // Returns false if execution continues at skip_target instead of the next operation.
+  std::function<bool()> run;
+  size_t skip_target = 0;
+};
+using CompiledCode = std::vector<CompiledOp>;
+
 // General lock. Protects codes list and internal log.
 static std::mutex s_lock;
 static std::vector<ARCode> s_active_codes;
+// Same order as s_active_codes. Codes which couldn't be compiled are left empty.
+static std::vector<CompiledCode> s_compiled_codes;
 static std::vector<ARCode> s_synced_codes;
 static std::vector<std::string> s_internal_log;
 static std::atomic<bool> s_use_internal_log{false};
@@ -110,6 +124,16 @@ struct ARAddr
   operator u32() const { return address; }
 };
 
+static CompiledCode CompileCode(const ARCode& arcode);
+
+static void CompileActiveCodesLocked()
+{
+  s_compiled_codes.clear();
+  s_compiled_codes.reserve(s_active_codes.size());
+  for (const ARCode& code : s_active_codes)
+    s_compiled_codes.push_back(CompileCode(code));
+}
+
 // ----------------------
 // AR Remote Functions
 void ApplyCodes(const std::vector<ARCode>& codes)
@@ -123,6 +147,7 @@ void ApplyCodes(const std::vector<ARCode>& codes)
   std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                [](const ARCode& code) { return code.enabled; });
   s_active_codes.shrink_to_fit();
+  CompileActiveCodesLocked();
 }
 
 void SetSyncedCodesAsActive()
@@ -130,6 +155,7 @@ void SetSyncedCodesAsActive()
   s_active_codes.clear();
   s_active_codes.reserve(s_synced_codes.size());
   s_active_codes = s_synced_codes;
+  CompileActiveCodesLocked();
 }
 
 void UpdateSyncedCodes(const std::vector<ARCode>& codes)
@@ -150,6 +176,7 @@ std::vector<ARCode> ApplyAndReturnCodes(const std::vector<ARCode>& codes)
     s_active_codes.clear();
     std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                  [](const ARCode& code) { return code.enabled; });
+    CompileActiveCodesLocked();
   }
   s_active_codes.shrink_to_fit();
 
@@ -165,6 +192,7 @@ void AddCode(ARCode code)
   {
     std::lock_guard guard(s_lock);
     s_disable_logging = false;
+    s_compiled_codes.push_back(CompileCode(code));
     s_active_codes.emplace_back(std::move(code));
   }
 }
@@ -977,6 +1005,179 @@ static bool RunCodeLocked(const ARCode& arcode)
   return true;
 }
 
+static std::optional<std::function<bool()>> CompileNormalCode(const ARAddr& addr, const u32 data)
+{
+  const u32 new_addr = addr.GCAddress();
+
+  switch (addr.subtype)
+  {
+  case SUB_RAM_WRITE:
+    switch (addr.size)
+    {
+    case DATATYPE_8BIT:
+      return [new_addr, data] {
+        for (u32 i = 0; i <= data >> 8; ++i)
+          PowerPC::HostWrite_U8(data & 0xFF, new_addr + i);
+        return true;
+      };
+    case DATATYPE_16BIT:
+      return [new_addr, data] {
+        for (u32 i = 0; i <= data >> 16; ++i)
+          PowerPC::HostWrite_U16(data & 0xFFFF, new_addr + i * 2);
+        return true;
+      };
+    default:
+      return [new_addr, data] {
+        PowerPC::HostWrite_U32(data, new_addr);
+        return true;
+      };
+    }
+
+  case SUB_WRITE_POINTER:
+    switch (addr.size)
+    {
+    case DATATYPE_8BIT:
+      return [new_addr, data] {
+        PowerPC::HostWrite_U8(data & 0xFF, PowerPC::HostRead_U32(new_addr) + (data >> 8));
+        return true;
+      };
+    case DATATYPE_16BIT:
+      return [new_addr, data] {
+        PowerPC::HostWrite_U16(data & 0xFFFF,
+                               PowerPC::HostRead_U32(new_addr) + ((data >> 16) << 1));
+        return true;
+      };
+    default:
+      return [new_addr, data] {
+        PowerPC::HostWrite_U32(data, PowerPC::HostRead_U32(new_addr));
+        return true;
+      };
+    }
+
+  case SUB_ADD_CODE:
+    switch (addr.size)
+    {
+    case DATATYPE_8BIT:
+      return [new_addr, data] {
+        PowerPC::HostWrite_U8(PowerPC::HostRead_U8(new_addr) + data, new_addr);
+        return true;
+      };
+    case DATATYPE_16BIT:
+      return [new_addr, data] {
+        PowerPC::HostWrite_U16(PowerPC::HostRead_U16(new_addr) + data, new_addr);
+        return true;
+      };
+    case DATATYPE_32BIT:
+      return [new_addr, data] {
+        PowerPC::HostWrite_U32(PowerPC::HostRead_U32(new_addr) + data, new_addr);
+        return true;
+      };
+    default:
+      return [new_addr, data] {
+        const float value = Common::BitCast<float>(PowerPC::HostRead_U32(new_addr));
+        PowerPC::HostWrite_U32(Common::BitCast<u32>(value + static_cast<float>(data)), new_addr);
+        return true;
+      };
+    }
+
+  default:
+    return std::nullopt;
+  }
+}
+
+static std::function<bool()> CompileConditionalCode(const ARAddr& addr, const u32 data)
+{
+  const u32 new_addr = addr.GCAddress();
+  const int type = addr.type;
+
+  switch (addr.size)
+  {
+  case DATATYPE_8BIT:
+    return [new_addr, data, type] {
+      return CompareValues(PowerPC::HostRead_U8(new_addr), data & 0xFF, type);
+    };
+  case DATATYPE_16BIT:
+    return [new_addr, data, type] {
+      return CompareValues(PowerPC::HostRead_U16(new_addr), data & 0xFFFF, type);
+    };
+  default:
+    return [new_addr, data, type] {
+      return CompareValues(PowerPC::HostRead_U32(new_addr), data, type);
+    };
+  }
+}
+
+// Returns an empty list for codes that have to be interpreted, which are the ones with operations
+// that can fail or that depend on the previous line.
+static CompiledCode CompileCode(const ARCode& arcode)
+{
+  const std::vector<AREntry>& ops = arcode.ops;
+  CompiledCode compiled;
+  compiled.reserve(ops.size());
+
+  for (size_t i = 0; i < ops.size(); ++i)
+  {
+    const ARAddr addr(ops[i].cmd_addr);
+    const u32 data = ops[i].value;
+
+    if (addr >= 0x00002000 && addr < 0x00003000)
+      return {};
+
+    if (0x0 == addr)
+    {
+      switch (data >> 29)
+      {
+      case ZCODE_END:
+        compiled.push_back({[] { return false; }, ops.size()});
+        continue;
+      case ZCODE_NORM:
+        compiled.push_back({[] { return true; }});
+        continue;
+      default:
+        return {};
+      }
+    }
+
+    if (addr.type == 0x00)
+    {
+      std::optional<std::function<bool()>> run = CompileNormalCode(addr, data);
+      if (!run)
+        return {};
+      compiled.push_back({std::move(*run)});
+      continue;
+    }
+
+    // The lines that are skipped when the comparison fails, counted like RunCodeLocked does.
+    size_t skip_target = ops.size();
+    switch (addr.subtype)
+    {
+    case CONDTIONAL_ONE_LINE:
+    case CONDTIONAL_TWO_LINES:
+      skip_target = std::min(i + addr.subtype + 2, ops.size());
+      break;
+    case CONDTIONAL_ALL_LINES_UNTIL:
+      for (size_t j = i + 1; j < ops.size(); ++j)
+      {
+        if (ops[j].cmd_addr == 0 && ops[j].value == 0x40000000)
+        {
+          skip_target = j + 1;
+          break;
+        }
+      }
+      break;
+    }
+    compiled.push_back({CompileConditionalCode(addr, data), skip_target});
+  }
+
+  return compiled;
+}
+
+static void RunCompiledCodeLocked(const CompiledCode& code)
+{
+  for (size_t i = 0; i < code.size();)
+    i = code[i].run() ? i + 1 : code[i].skip_target;
+}
+
 void RunAllActive()
 {
   if (!Config::Get(Config::MAIN_ENABLE_CHEATS))
@@ -986,13 +1187,34 @@ void RunAllActive()
   // are only atomic ops unless contested. It should be rare for this to
   // be contested.
   std::lock_guard guard(s_lock);
-  s_active_codes.erase(std::remove_if(s_active_codes.begin(), s_active_codes.end(),
-                                      [](const ARCode& code) {
-                                        bool success = RunCodeLocked(code);
-                                        LogInfo("\n");
-                                        return !success;
-                                      }),
-                       s_active_codes.end());
+
+  // Codes are interpreted the first time they run, which logs them and removes the ones that fail,
+  // and whenever the log is being looked at.
+  const bool interpret = !s_disable_logging || IsSelfLogging();
+  size_t kept = 0;
+  for (size_t i = 0; i < s_active_codes.size(); ++i)
+  {
+    if (!interpret && !s_compiled_codes[i].empty())
+    {
+      RunCompiledCodeLocked(s_compiled_codes[i]);
+    }
+    else
+    {
+      const bool success = RunCodeLocked(s_active_codes[i]);
+      LogInfo("\n");
+      if (!success)
+        continue;
+    }
+
+    if (kept != i)
+    {
+      s_active_codes[kept] = std::move(s_active_codes[i]);
+      s_compiled_codes[kept] = std::move(s_compiled_codes[i]);
+    }
+    ++kept;
+  }
+  s_active_codes.resize(kept);
+  s_compiled_codes.resize(kept);
   s_disable_logging = true;
 }
 
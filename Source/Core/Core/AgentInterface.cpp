@@ -0,0 +1,195 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/AgentInterface.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Common/Align.h"
+#include "Common/Config/Config.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/HW/Memmap.h"
+
+namespace AgentInterface
+{
+constexpr u32 FRAME_SLOT_SIZE = MAX_FRAME_WIDTH * MAX_FRAME_HEIGHT * 4;
+constexpr u64 FRAME_DATA_OFFSET = Common::AlignUp(sizeof(SharedHeader), 4096);
+constexpr u64 SHARED_SIZE = FRAME_DATA_OFFSET + u64{NUM_FRAME_SLOTS} * FRAME_SLOT_SIZE;
+
+// Only Init and Shutdown take this exclusively, so reading input doesn't have to wait for frames
+// being copied.
+static std::shared_mutex s_mutex;
+static SharedHeader* s_header = nullptr;
+static std::string s_name;
+static int s_fd = -1;
+
+// Used while an agent is in the middle of updating a port.
+static std::mutex s_pad_mutex;
+static std::array<GCPadStatus, NUM_PADS> s_last_pad_status;
+
+void Init()
+{
+  if (!Config::Get(Config::MAIN_AGENT_INTERFACE))
+    return;
+
+  std::lock_guard lk(s_mutex);
+
+  s_name = "/dolphin-agent." + std::to_string(getpid());
+  // An object with the same name can only be left over from a process that crashed.
+  shm_unlink(s_name.c_str());
+  s_fd = shm_open(s_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (s_fd == -1)
+  {
+    ERROR_LOG_FMT(CORE, "Agent interface: shm_open failed: {}", strerror(errno));
+    return;
+  }
+
+  void* memory = MAP_FAILED;
+  if (ftruncate(s_fd, SHARED_SIZE) == 0)
+    memory = mmap(nullptr, SHARED_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, s_fd, 0);
+  if (memory == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(CORE, "Agent interface: Failed to map {}: {}", s_name, strerror(errno));
+    close(s_fd);
+    s_fd = -1;
+    shm_unlink(s_name.c_str());
+    return;
+  }
+
+  s_header = new (memory) SharedHeader{};
+  s_header->magic = MAGIC;
+  s_header->version = VERSION;
+  s_header->header_size = sizeof(SharedHeader);
+  s_header->frame_slot_size = FRAME_SLOT_SIZE;
+  s_header->frame_data_offset = FRAME_DATA_OFFSET;
+
+  const std::string ram_segment_name = Memory::GetSharedSegmentName();
+  ram_segment_name.copy(s_header->ram_segment_name, sizeof(s_header->ram_segment_name) - 1);
+  s_header->mem1_offset = Memory::GetSharedSegmentOffset(0x00000000).value_or(0);
+  s_header->mem1_size = Memory::GetRamSizeReal();
+  if (const auto mem2_offset = Memory::GetSharedSegmentOffset(0x10000000))
+  {
+    s_header->mem2_offset = *mem2_offset;
+    s_header->mem2_size = Memory::GetExRamSizeReal();
+  }
+
+  {
+    std::lock_guard pad_lk(s_pad_mutex);
+    s_last_pad_status = {};
+  }
+
+  NOTICE_LOG_FMT(CORE, "Agent interface available at {}", s_name);
+}
+
+void Shutdown()
+{
+  std::lock_guard lk(s_mutex);
+
+  if (!s_header)
+    return;
+
+  munmap(s_header, SHARED_SIZE);
+  s_header = nullptr;
+  close(s_fd);
+  s_fd = -1;
+  shm_unlink(s_name.c_str());
+}
+
+std::optional<GCPadStatus> GetPadOverride(int pad_num)
+{
+  std::shared_lock lk(s_mutex);
+
+  if (!s_header || pad_num < 0 || pad_num >= static_cast<int>(NUM_PADS))
+    return std::nullopt;
+
+  PadOverride& pad = s_header->pads[pad_num];
+  if (pad.enabled.load(std::memory_order_acquire) == 0)
+    return std::nullopt;
+
+  std::lock_guard pad_lk(s_pad_mutex);
+  GCPadStatus& status = s_last_pad_status[pad_num];
+
+  // Don't wait for an agent that stopped in the middle of an update.
+  for (int attempt = 0; attempt < 16; ++attempt)
+  {
+    const u32 sequence = pad.sequence.load(std::memory_order_acquire);
+    if (sequence & 1)
+      continue;
+
+    const u32 buttons = pad.buttons.load(std::memory_order_relaxed);
+    const u32 sticks = pad.sticks.load(std::memory_order_relaxed);
+    const u32 analog = pad.analog.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (pad.sequence.load(std::memory_order_relaxed) != sequence)
+      continue;
+
+    status.button = static_cast<u16>(buttons);
+    status.stickX = static_cast<u8>(sticks);
+    status.stickY = static_cast<u8>(sticks >> 8);
+    status.substickX = static_cast<u8>(sticks >> 16);
+    status.substickY = static_cast<u8>(sticks >> 24);
+    status.triggerLeft = static_cast<u8>(analog);
+    status.triggerRight = static_cast<u8>(analog >> 8);
+    status.analogA = static_cast<u8>(analog >> 16);
+    status.analogB = static_cast<u8>(analog >> 24);
+    break;
+  }
+
+  return status;
+}
+
+bool WantsFrames()
+{
+  std::shared_lock lk(s_mutex);
+
+  return s_header && s_header->frames_requested.load(std::memory_order_relaxed) != 0;
+}
+
+void PublishFrame(const u8* data, int width, int height, int stride, u64 ticks, int frame_number)
+{
+  std::shared_lock lk(s_mutex);
+
+  if (!s_header || s_header->frames_requested.load(std::memory_order_relaxed) == 0)
+    return;
+
+  if (width <= 0 || height <= 0 || static_cast<u32>(width) > MAX_FRAME_WIDTH ||
+      static_cast<u32>(height) > MAX_FRAME_HEIGHT)
+  {
+    s_header->frames_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  const u32 slot_index =
+      (s_header->latest_frame_slot.load(std::memory_order_relaxed) + 1) % NUM_FRAME_SLOTS;
+  FrameSlot& slot = s_header->frames[slot_index];
+  u8* const pixels = reinterpret_cast<u8*>(s_header) + FRAME_DATA_OFFSET +
+                     u64{slot_index} * FRAME_SLOT_SIZE;
+
+  const u32 sequence = slot.sequence.load(std::memory_order_relaxed);
+  slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.width = width;
+  slot.height = height;
+  slot.frame_number = frame_number;
+  slot.ticks = ticks;
+  const size_t row_size = static_cast<size_t>(width) * 4;
+  for (int y = 0; y < height; ++y)
+    std::memcpy(pixels + y * row_size, data + static_cast<size_t>(y) * stride, row_size);
+
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+  s_header->latest_frame_slot.store(slot_index, std::memory_order_release);
+  s_header->frames_published.fetch_add(1, std::memory_order_release);
+}
+}  // namespace AgentInterface
@@ -0,0 +1,106 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+
+#include "Common/CommonTypes.h"
+#include "InputCommon/GCPadStatus.h"
+
+// Shared memory interface for external agents (bots, training environments and the like) which
+// need emulated RAM, rendered frames and controller input at a high rate, without going through
+// sockets, pipes or files.
+//
+// When General/AgentInterface is enabled, Dolphin creates the POSIX shared memory object
+// "/dolphin-agent.<pid>" for as long as emulation is running. It starts with a SharedHeader, which
+// is followed by the pixel data of the frame slots. All fields are native endian, and the atomic
+// fields are lock-free 32-bit and 64-bit integers.
+//
+// Emulated RAM: ram_segment_name names the shared memory object which backs emulated memory
+// itself. MEM1 is mem1_size bytes at mem1_offset in it, and on Wii MEM2 is mem2_size bytes at
+// mem2_offset. It should be mapped read-only. Its contents are big endian, like on the console.
+//
+// Frames: while frames_requested is nonzero, every rendered frame is read back asynchronously and
+// copied into the next of the NUM_FRAME_SLOTS slots, after which latest_frame_slot points to it.
+// Pixels are RGBA8 rows of width * 4 bytes, starting at frame_data_offset + slot * frame_slot_size.
+// A slot's sequence is odd while the slot is being written, so a copy of a slot is only valid if
+// its sequence was even and the same before and after copying it. Frames too large for a slot are
+// counted in frames_dropped instead.
+//
+// Input: to control a GameCube controller port, increment the port's sequence, write the
+// PadOverride fields, increment the sequence again and set enabled to 1. Setting enabled back to 0
+// returns the port to its mapped controller.
+namespace AgentInterface
+{
+constexpr u32 MAGIC = 0x31474144;  // "DAG1"
+constexpr u32 VERSION = 1;
+
+constexpr u32 NUM_PADS = 4;
+constexpr u32 NUM_FRAME_SLOTS = 3;
+constexpr u32 MAX_FRAME_WIDTH = 2560;
+constexpr u32 MAX_FRAME_HEIGHT = 1440;
+
+struct PadOverride
+{
+  std::atomic<u32> enabled;
+  std::atomic<u32> sequence;
+  // PAD_BUTTON_* and PAD_TRIGGER_* bits.
+  std::atomic<u32> buttons;
+  // Main stick X and Y, then C-stick X and Y, one byte each from the least significant byte up.
+  std::atomic<u32> sticks;
+  // Left and right triggers, then analog A and B, one byte each from the least significant byte up.
+  std::atomic<u32> analog;
+};
+
+struct FrameSlot
+{
+  std::atomic<u32> sequence;
+  u32 width;
+  u32 height;
+  u32 frame_number;
+  // Emulated CPU ticks at which the frame was output.
+  u64 ticks;
+};
+
+struct SharedHeader
+{
+  u32 magic;
+  u32 version;
+  u32 header_size;
+  u32 frame_slot_size;
+  u64 frame_data_offset;
+
+  char ram_segment_name[64];
+  u32 mem1_offset;
+  u32 mem1_size;
+  u32 mem2_offset;
+  u32 mem2_size;
+
+  // Written by the agent.
+  std::atomic<u32> frames_requested;
+
+  std::atomic<u32> latest_frame_slot;
+  std::atomic<u64> frames_published;
+  std::atomic<u64> frames_dropped;
+
+  // Written by the agent.
+  PadOverride pads[NUM_PADS];
+
+  FrameSlot frames[NUM_FRAME_SLOTS];
+};
+
+static_assert(std::atomic<u32>::is_always_lock_free && std::atomic<u64>::is_always_lock_free);
+
+// Must be called on the CPU thread once emulated memory has been initialized.
+void Init();
+void Shutdown();
+
+// Returns the input set by an agent for the given GameCube controller port, if any.
+std::optional<GCPadStatus> GetPadOverride(int pad_num);
+
+// Whether frames should be read back for PublishFrame.
+bool WantsFrames();
+void PublishFrame(const u8* data, int width, int height, int stride, u64 ticks, int frame_number);
+}  // namespace AgentInterface
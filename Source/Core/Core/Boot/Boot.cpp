@@ -55,6 +55,7 @@ namespace fs = std::filesystem;
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SignatureDB/SignatureDB.h"
 
 #include "DiscIO/Enums.h"
 #include "DiscIO/GameModDescriptor.h"
@@ -402,6 +403,19 @@ bool CBoot::LoadMapFromFilename()
   return false;
 }
 
+bool CBoot::LoadSymbolsFromSignatureDB()
+{
+  SignatureDB db(SignatureDB::HandlerType::DSY);
+  if (!db.Load(File::GetSysDirectory() + TOTALDB))
+    return false;
+
+  PPCAnalyst::FindFunctions(Memory::MEM1_BASE_ADDR,
+                            Memory::MEM1_BASE_ADDR + Memory::GetRamSizeReal(), &g_symbolDB);
+  db.Apply(&g_symbolDB);
+  UpdateDebugger_MapLoaded();
+  return true;
+}
+
 // If ipl.bin is not found, this function does *some* of what BS1 does:
 // loading IPL(BS2) and jumping to it.
 // It does not initialize the hardware or anything else like BS1 does.
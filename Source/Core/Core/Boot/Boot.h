@@ -157,6 +157,8 @@ public:
   // Returns true if a map file exists, false if none could be found.
   static bool FindMapFile(std::string* existing_map_file, std::string* writable_map_file);
   static bool LoadMapFromFilename();
+  // Names the functions in MEM1 which match the signatures in the Sys directory's database.
+  static bool LoadSymbolsFromSignatureDB();
 
 private:
   static bool DVDRead(const DiscIO::VolumeDisc& disc, u64 dvd_offset, u32 output_address,
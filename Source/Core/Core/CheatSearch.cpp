@@ -4,6 +4,7 @@
 #include "Core/CheatSearch.h"
 
 #include <cassert>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -15,6 +16,7 @@
 #include "Common/Align.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -185,6 +187,42 @@ TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
 {
   return PowerPC::HostTryReadF64(addr, space);
 }
+// Reads values straight from the host pages backing emulated memory, so that addresses only have to
+// be translated once per page rather than once per value. Values that cross a page boundary go
+// through the regular path.
+template <typename T>
+class PageCachedReader
+{
+public:
+  explicit PageCachedReader(PowerPC::RequestedAddressSpace space) : m_space(space) {}
+
+  std::optional<PowerPC::ReadResult<T>> Read(u32 addr)
+  {
+    const u32 offset = addr & PowerPC::HW_PAGE_MASK;
+    if (offset + sizeof(T) > PowerPC::HW_PAGE_SIZE)
+      return TryReadValueFromEmulatedMemory<T>(addr, m_space);
+
+    const u32 page_address = addr - offset;
+    if (!m_page_looked_up || page_address != m_page_address)
+    {
+      m_page = PowerPC::HostTryGetRAMPointer(page_address, m_space);
+      m_page_address = page_address;
+      m_page_looked_up = true;
+    }
+    if (!m_page)
+      return std::nullopt;
+
+    T value;
+    std::memcpy(&value, m_page->value + offset, sizeof(T));
+    return PowerPC::ReadResult<T>(m_page->translated, Common::FromBigEndian(value));
+  }
+
+private:
+  PowerPC::RequestedAddressSpace m_space;
+  std::optional<PowerPC::ReadResult<const u8*>> m_page;
+  u32 m_page_address = 0;
+  bool m_page_looked_up = false;
+};
 }  // namespace
 
 template <typename T>
@@ -210,6 +248,7 @@ Cheats::NewSearch(const std::vector<Cheats::MemoryRange>& memory_ranges,
       return;
     }
 
+    PageCachedReader<T> reader(address_space);
     for (const Cheats::MemoryRange& range : memory_ranges)
     {
       if (range.m_length < data_size)
@@ -226,7 +265,7 @@ Cheats::NewSearch(const std::vector<Cheats::MemoryRange>& memory_ranges,
       for (u64 i = 0; i < length; i += increment_per_loop)
       {
         const u32 addr = start_address + i;
-        const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
+        const auto current_value = reader.Read(addr);
         if (!current_value)
           continue;
 
@@ -269,10 +308,11 @@ Cheats::NextSearch(const std::vector<Cheats::SearchResult<T>>& previous_results,
       return;
     }
 
+    PageCachedReader<T> reader(address_space);
     for (const auto& previous_result : previous_results)
     {
       const u32 addr = previous_result.m_address;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
+      const auto current_value = reader.Read(addr);
       if (!current_value)
       {
         auto& r = results.emplace_back();
@@ -29,6 +29,7 @@ enum class CPUCore;
 namespace AudioCommon
 {
 enum class DPL2Quality;
+enum class StretchQuality;
 }
 
 namespace ExpansionInterface
@@ -37,6 +38,11 @@ enum class EXIDeviceType : int;
 enum class Slot : int;
 }  // namespace ExpansionInterface
 
+namespace State
+{
+enum class CompressionType : u32;
+}
+
 namespace SerialInterface
 {
 enum SIDevices : int;
@@ -54,6 +60,14 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_PERSISTENT_CACHE;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
+extern const Info<bool> MAIN_JIT_INTERPRETER_FALLBACK;
+extern const Info<bool> MAIN_JIT_LARGE_PAGES;
+// Shrinks the JIT's code spaces so that more instances fit on one host. Old blocks get evicted
+// sooner, so this costs some recompilation.
+extern const Info<bool> MAIN_LOW_MEMORY_MODE;
+extern const Info<bool> MAIN_PRECISE_CYCLE_COUNTING;
 extern const Info<bool> MAIN_FASTMEM;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
@@ -69,6 +83,10 @@ extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
+extern const Info<AudioCommon::StretchQuality> MAIN_AUDIO_STRETCH_QUALITY;
+// When non-zero, audio output is tuned for latency: backends use their smallest buffers, and the
+// mixer keeps this many milliseconds of audio queued instead of following the timing variance.
+extern const Info<int> MAIN_AUDIO_TARGET_LATENCY;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
 extern const Info<std::string> MAIN_MEMCARD_B_PATH;
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot);
@@ -93,6 +111,7 @@ const Info<bool>& GetInfoForAdapterRumble(int channel);
 const Info<bool>& GetInfoForSimulateKonga(int channel);
 extern const Info<bool> MAIN_WII_SD_CARD;
 extern const Info<bool> MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC;
+extern const Info<bool> MAIN_NAND_OVERLAY;
 extern const Info<bool> MAIN_WII_KEYBOARD;
 extern const Info<bool> MAIN_WIIMOTE_CONTINUOUS_SCANNING;
 extern const Info<bool> MAIN_WIIMOTE_ENABLE_SPEAKER;
@@ -104,12 +123,17 @@ extern const Info<bool> MAIN_SYNC_GPU;
 extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
+extern const Info<bool> MAIN_SYNC_GPU_ADAPTIVE;
+extern const Info<bool> MAIN_STREAM_GATHER_PIPE;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
+extern const Info<bool> MAIN_DISC_ACCESS_TRACES;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
 extern const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS;
 extern const Info<bool> MAIN_FPRF;
 extern const Info<bool> MAIN_ACCURATE_NANS;
+extern const Info<bool> MAIN_FAST_MEMORY_HLE;
+extern const Info<bool> MAIN_VALIDATE_FAST_MEMORY_HLE;
 extern const Info<bool> MAIN_DISABLE_ICACHE;
 extern const Info<float> MAIN_EMULATION_SPEED;
 extern const Info<float> MAIN_OVERCLOCK;
@@ -143,10 +167,16 @@ extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
 extern const Info<std::string> MAIN_WII_NUS_SHOP_URL;
+extern const Info<bool> MAIN_REWIND_ENABLE;
+// In emulated fields (half-frames for interlaced video).
+extern const Info<int> MAIN_REWIND_INTERVAL;
+extern const Info<int> MAIN_REWIND_MEMORY_MB;
+extern const Info<State::CompressionType> MAIN_STATE_COMPRESSION;
 
 // Main.DSP
 
 extern const Info<bool> MAIN_DSP_THREAD;
+extern const Info<int> MAIN_DSP_HLE_VOICE_THREADS;
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
 extern const Info<bool> MAIN_DUMP_AUDIO;
@@ -180,6 +210,7 @@ extern const Info<std::string> MAIN_DUMP_PATH;
 extern const Info<std::string> MAIN_LOAD_PATH;
 extern const Info<std::string> MAIN_RESOURCEPACK_PATH;
 extern const Info<std::string> MAIN_FS_PATH;
+extern const Info<std::string> MAIN_NAND_OVERLAY_PERSIST_PATH;
 extern const Info<std::string> MAIN_WII_SD_CARD_IMAGE_PATH;
 extern const Info<std::string> MAIN_WII_SD_CARD_SYNC_FOLDER_PATH;
 extern const Info<std::string> MAIN_WFS_PATH;
@@ -188,6 +219,8 @@ extern const Info<bool> MAIN_SHOW_FRAME_COUNT;
 extern const Info<std::string> MAIN_WIRELESS_MAC;
 extern const Info<std::string> MAIN_GDB_SOCKET;
 extern const Info<int> MAIN_GDB_PORT;
+extern const Info<bool> MAIN_MEMORY_WATCHER_BINARY_OUTPUT;
+extern const Info<bool> MAIN_AGENT_INTERFACE;
 extern const Info<int> MAIN_ISO_PATH_COUNT;
 std::vector<std::string> GetIsoPaths();
 void SetIsoPaths(const std::vector<std::string>& paths);
@@ -303,6 +336,7 @@ extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT;
 extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
+extern const Info<int> MAIN_MOVIE_KEYFRAME_INTERVAL;
 
 // Main.Input
 
@@ -323,6 +357,7 @@ extern const Info<bool> MAIN_DEBUG_JIT_PAIRED_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_SYSTEM_REGISTERS_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_BRANCH_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_REGISTER_CACHE_OFF;
+extern const Info<bool> MAIN_DEBUG_PERFORMANCE_TRACE;
 
 // Main.BluetoothPassthrough
 
@@ -334,6 +369,7 @@ extern const Info<std::string> MAIN_BLUETOOTH_PASSTHROUGH_LINK_KEYS;
 // Main.USBPassthrough
 
 extern const Info<std::string> MAIN_USB_PASSTHROUGH_DEVICES;
+extern const Info<int> MAIN_USB_PASSTHROUGH_READ_AHEAD;
 std::set<std::pair<u16, u16>> GetUSBDeviceWhitelist();
 void SetUSBDeviceWhitelist(const std::set<std::pair<u16, u16>>& devices);
 
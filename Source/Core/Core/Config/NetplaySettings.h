@@ -47,6 +47,7 @@ extern const Info<bool> NETPLAY_SAVEDATA_SYNC_ALL_WII;
 extern const Info<bool> NETPLAY_SYNC_CODES;
 extern const Info<bool> NETPLAY_RECORD_INPUTS;
 extern const Info<bool> NETPLAY_STRICT_SETTINGS_SYNC;
+extern const Info<bool> NETPLAY_STATE_HASHING;
 extern const Info<std::string> NETPLAY_NETWORK_MODE;
 extern const Info<bool> NETPLAY_GOLF_MODE_OVERLAY;
 extern const Info<bool> NETPLAY_HIDE_REMOTE_GBAS;
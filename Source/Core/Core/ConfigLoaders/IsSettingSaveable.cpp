@@ -64,6 +64,8 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_AUDIO_LATENCY.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH_LATENCY.GetLocation(),
+      &Config::MAIN_AUDIO_STRETCH_QUALITY.GetLocation(),
+      &Config::MAIN_AUDIO_TARGET_LATENCY.GetLocation(),
       &Config::MAIN_OVERCLOCK.GetLocation(),
       &Config::MAIN_OVERCLOCK_ENABLE.GetLocation(),
       &Config::MAIN_RAM_OVERRIDE_ENABLE.GetLocation(),
@@ -88,11 +90,19 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_CUSTOM_RTC_ENABLE.GetLocation(),
       &Config::MAIN_CUSTOM_RTC_VALUE.GetLocation(),
       &Config::MAIN_JIT_FOLLOW_BRANCH.GetLocation(),
+      &Config::MAIN_JIT_PERSISTENT_CACHE.GetLocation(),
+      &Config::MAIN_JIT_TIERED_COMPILATION.GetLocation(),
+      &Config::MAIN_JIT_INTERPRETER_FALLBACK.GetLocation(),
+      &Config::MAIN_JIT_LARGE_PAGES.GetLocation(),
+      &Config::MAIN_LOW_MEMORY_MODE.GetLocation(),
+      &Config::MAIN_PRECISE_CYCLE_COUNTING.GetLocation(),
       &Config::MAIN_FLOAT_EXCEPTIONS.GetLocation(),
       &Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS.GetLocation(),
       &Config::MAIN_LOW_DCBZ_HACK.GetLocation(),
       &Config::MAIN_FPRF.GetLocation(),
       &Config::MAIN_ACCURATE_NANS.GetLocation(),
+      &Config::MAIN_FAST_MEMORY_HLE.GetLocation(),
+      &Config::MAIN_VALIDATE_FAST_MEMORY_HLE.GetLocation(),
       &Config::GetInfoForAdapterRumble(0).GetLocation(),
       &Config::GetInfoForAdapterRumble(1).GetLocation(),
       &Config::GetInfoForAdapterRumble(2).GetLocation(),
@@ -106,6 +116,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_GPU_DETERMINISM_MODE.GetLocation(),
       &Config::MAIN_DISABLE_ICACHE.GetLocation(),
       &Config::MAIN_FAST_DISC_SPEED.GetLocation(),
+      &Config::MAIN_DISC_ACCESS_TRACES.GetLocation(),
       &Config::MAIN_SYNC_ON_SKIP_IDLE.GetLocation(),
       &Config::MAIN_FASTMEM.GetLocation(),
       &Config::MAIN_TIMING_VARIANCE.GetLocation(),
@@ -130,7 +141,13 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_SYNC_GPU_MAX_DISTANCE.GetLocation(),
       &Config::MAIN_SYNC_GPU_MIN_DISTANCE.GetLocation(),
       &Config::MAIN_SYNC_GPU_OVERCLOCK.GetLocation(),
+      &Config::MAIN_SYNC_GPU_ADAPTIVE.GetLocation(),
+      &Config::MAIN_STREAM_GATHER_PIPE.GetLocation(),
       &Config::MAIN_OVERRIDE_BOOT_IOS.GetLocation(),
+      &Config::MAIN_REWIND_ENABLE.GetLocation(),
+      &Config::MAIN_REWIND_INTERVAL.GetLocation(),
+      &Config::MAIN_REWIND_MEMORY_MB.GetLocation(),
+      &Config::MAIN_STATE_COMPRESSION.GetLocation(),
 
       // UI.General
 
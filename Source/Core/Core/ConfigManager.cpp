@@ -195,7 +195,10 @@ void SConfig::OnNewTitleLoad()
     g_symbolDB.Clear();
     Host_NotifyMapLoaded();
   }
-  CBoot::LoadMapFromFilename();
+  // The native memory functions need symbols to be patched in, so find them by their signatures
+  // if the game doesn't have a map file.
+  if (!CBoot::LoadMapFromFilename() && Config::Get(Config::MAIN_FAST_MEMORY_HLE))
+    CBoot::LoadSymbolsFromSignatureDB();
   HLE::Reload();
   PatchEngine::Reload();
   HiresTexture::Update();
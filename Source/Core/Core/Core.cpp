@@ -6,10 +6,13 @@
 #include <algorithm>
 #include <atomic>
 #include <cstring>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -32,6 +35,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/PerformanceTrace.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
@@ -55,6 +59,7 @@
 #include "Core/HW/GCKeyboard.h"
 #include "Core/HW/GCPad.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
@@ -65,9 +70,11 @@
 #include "Core/NetPlayClient.h"
 #include "Core/NetPlayProto.h"
 #include "Core/PatchEngine.h"
+#include "Core/PerformanceReport.h"
 #include "Core/PowerPC/GDBStub.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/Rewind.h"
 #include "Core/State.h"
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
@@ -75,8 +82,13 @@
 #ifdef USE_MEMORYWATCHER
 #include "Core/MemoryWatcher.h"
 #endif
+#ifdef USE_AGENT_INTERFACE
+#include "Core/AgentInterface.h"
+#endif
 
+#include "DiscIO/DiscUtils.h"
 #include "DiscIO/RiivolutionPatcher.h"
+#include "DiscIO/Volume.h"
 
 #include "InputCommon/ControlReference/ControlReference.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
@@ -115,6 +127,8 @@ static bool s_is_throttler_temp_disabled = false;
 static std::atomic<double> s_last_actual_emulation_speed{1.0};
 static bool s_frame_step = false;
 static std::atomic<bool> s_stop_frame_step;
+// When the CPU thread last finished emulating a field, for the performance trace.
+static u64 s_last_frame_end_time = 0;
 
 #ifdef USE_MEMORYWATCHER
 static std::unique_ptr<MemoryWatcher> s_memory_watcher;
@@ -152,11 +166,27 @@ double GetActualEmulationSpeed()
 void FrameUpdateOnCPUThread()
 {
   if (NetPlay::IsNetPlayRunning())
+  {
     NetPlay::NetPlayClient::SendTimeBase();
+    NetPlay::NetPlayClient::UpdateRollback();
+  }
 }
 
 void OnFrameEnd()
 {
+  if (Common::PerformanceTrace::IsEnabled())
+  {
+    const u64 now = Common::PerformanceTrace::GetTimestamp();
+    if (s_last_frame_end_time != 0)
+    {
+      Common::PerformanceTrace::RecordStage(Common::PerformanceTrace::Stage::CPUEmulation,
+                                            s_last_frame_end_time, now);
+    }
+    s_last_frame_end_time = now;
+  }
+
+  PerformanceReport::OnFrameEnd();
+
 #ifdef USE_MEMORYWATCHER
   if (s_memory_watcher)
     s_memory_watcher->Step();
@@ -353,11 +383,21 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
 
   const bool fastmem_enabled = Config::Get(Config::MAIN_FASTMEM);
   if (fastmem_enabled)
+  {
     EMM::InstallExceptionHandler();  // Let's run under memory watch
+#ifndef __APPLE__
+    // The Mach exception handler only catches faults on the CPU thread, and macOS on ARM doesn't
+    // support write-protecting the memory arena.
+    Memory::SetWriteWatchEnabled(true);
+#endif
+  }
 
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher = std::make_unique<MemoryWatcher>();
 #endif
+#ifdef USE_AGENT_INTERFACE
+  AgentInterface::Init();
+#endif
 
   if (savestate_path)
   {
@@ -397,11 +437,17 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher.reset();
 #endif
+#ifdef USE_AGENT_INTERFACE
+  AgentInterface::Shutdown();
+#endif
 
   s_is_started = false;
 
   if (fastmem_enabled)
+  {
+    Memory::SetWriteWatchEnabled(false);
     EMM::UninstallExceptionHandler();
+  }
 
   if (GDBStub::IsActive())
   {
@@ -443,6 +489,37 @@ static void FifoPlayerThread(const std::optional<std::string>& savestate_path,
   }
 }
 
+// Reads what booting a disc needs: the apploader, the main DOL and the FST. This uses a volume of
+// its own so that it can run while the emulator initializes, and leaves the data in the OS's file
+// cache for when the boot reads it from the real volume.
+static void PrefetchDiscBootData(const std::string& path)
+{
+  const std::unique_ptr<DiscIO::VolumeDisc> volume = DiscIO::CreateDisc(path);
+  if (!volume)
+    return;
+
+  const DiscIO::Partition partition = volume->GetGamePartition();
+  std::vector<u8> buffer;
+  const auto read = [&](u64 offset, u64 size) {
+    buffer.resize(size);
+    volume->Read(offset, size, buffer.data(), partition);
+  };
+
+  if (const std::optional<u64> apploader_size = DiscIO::GetApploaderSize(*volume, partition))
+    read(DiscIO::APPLOADER_ADDRESS, *apploader_size);
+
+  const std::optional<u64> dol_offset = DiscIO::GetBootDOLOffset(*volume, partition);
+  const std::optional<u32> dol_size =
+      dol_offset ? DiscIO::GetBootDOLSize(*volume, partition, *dol_offset) : std::nullopt;
+  if (dol_size)
+    read(*dol_offset, *dol_size);
+
+  const std::optional<u64> fst_offset = DiscIO::GetFSTOffset(*volume, partition);
+  const std::optional<u64> fst_size = DiscIO::GetFSTSize(*volume, partition);
+  if (fst_offset && fst_size)
+    read(*fst_offset, *fst_size);
+}
+
 // Initialize and create emulation thread
 // Call browser: Init():s_emu_thread().
 // See the BootManager.cpp file description for a complete call schedule.
@@ -464,6 +541,45 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
 
   Common::SetCurrentThreadName("Emuthread - Starting");
 
+  // The trace is written once everything else has shut down.
+  s_last_frame_end_time = 0;
+  Common::PerformanceTrace::SetEnabled(Config::Get(Config::MAIN_DEBUG_PERFORMANCE_TRACE));
+  Common::ScopeGuard performance_trace_guard{[] {
+    if (!Common::PerformanceTrace::IsEnabled())
+      return;
+
+    Common::PerformanceTrace::SetEnabled(false);
+    Common::PerformanceTrace::ExportChromeTrace(File::GetUserPath(D_LOGS_IDX) +
+                                                "performance_trace.json");
+  }};
+
+  // Some of the initialization is independent of the rest, so it runs in the background until it
+  // is needed: reading the disc, syncing the SD card folder and bringing up the audio backend.
+  // Futures from std::async wait for their task when they are destroyed, also on early returns.
+  std::future<void> disc_prefetch;
+  if (const auto* disc = std::get_if<BootParameters::Disc>(&boot->parameters))
+    disc_prefetch = std::async(std::launch::async, PrefetchDiscBootData, disc->path);
+
+  std::future<bool> sd_folder_sync;
+  if (core_parameter.bWii && Config::Get(Config::MAIN_WII_SD_CARD) &&
+      Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC))
+  {
+    // The image is only opened once the game opens the SD card.
+    sd_folder_sync = std::async(std::launch::async, [wants_determinism = WantsDeterminism()] {
+      return Common::SyncSDFolderToSDImage(wants_determinism);
+    });
+  }
+  bool sync_sd_folder = false;
+  Common::ScopeGuard sd_folder_sync_guard{[&sd_folder_sync, &sync_sd_folder] {
+    if (sd_folder_sync.valid())
+      sync_sd_folder = sd_folder_sync.get();
+    if (sync_sd_folder && Config::Get(Config::MAIN_ALLOW_SD_WRITES))
+      Common::SyncSDImageToSDFolder();
+  }};
+
+  std::future<void> sound_stream_init =
+      std::async(std::launch::async, &AudioCommon::InitSoundStream);
+
   DeclareAsGPUThread();
 
   // For a time this acts as the CPU thread...
@@ -484,16 +600,6 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   const bool delete_savestate =
       boot_session_data.GetDeleteSavestate() == DeleteSavestateAfterBoot::Yes;
 
-  bool sync_sd_folder = core_parameter.bWii && Config::Get(Config::MAIN_WII_SD_CARD) &&
-                        Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC);
-  if (sync_sd_folder)
-    sync_sd_folder = Common::SyncSDFolderToSDImage(Core::WantsDeterminism());
-
-  Common::ScopeGuard sd_folder_sync_guard{[sync_sd_folder] {
-    if (sync_sd_folder && Config::Get(Config::MAIN_ALLOW_SD_WRITES))
-      Common::SyncSDImageToSDFolder();
-  }};
-
   // Load Wiimotes - only if we are booting in Wii mode
   if (core_parameter.bWii && !Config::Get(Config::MAIN_BLUETOOTH_PASSTHROUGH_ENABLED))
   {
@@ -505,7 +611,8 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   Movie::Init(*boot);
   Common::ScopeGuard movie_guard{&Movie::Shutdown};
 
-  AudioCommon::InitSoundStream();
+  // The audio interface sets the mixer's sample rates.
+  sound_stream_init.get();
   Common::ScopeGuard audio_guard{&AudioCommon::ShutdownSoundStream};
 
   HW::Init(NetPlay::IsNetPlayRunning() ? &(boot_session_data.GetNetplaySettings()->sram) : nullptr);
@@ -581,6 +688,11 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
   if (SConfig::GetInstance().bWii)
     savegame_redirect = DiscIO::Riivolution::ExtractSavegameRedirect(boot->riivolution_patches);
 
+  if (disc_prefetch.valid())
+    disc_prefetch.wait();
+  if (sd_folder_sync.valid())
+    sync_sd_folder = sd_folder_sync.get();
+
   if (!CBoot::BootUp(std::move(boot)))
     return;
 
@@ -870,6 +982,8 @@ void Callback_FramePresented(double actual_emulation_speed)
 // Called from VideoInterface::Update (CPU thread) at emulated field boundaries
 void Callback_NewField()
 {
+  Rewind::OnNewField();
+
   if (s_frame_step)
   {
     // To ensure that s_stop_frame_step is up to date, wait for the GPU thread queue to empty,
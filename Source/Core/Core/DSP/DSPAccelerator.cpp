@@ -160,6 +160,51 @@ u16 Accelerator::Read(const s16* coefs)
   return val;
 }
 
+void Accelerator::ReadSamples(const s16* coefs, s16* out, u32 count)
+{
+  u32 i = 0;
+  while (i < count)
+  {
+    // Number of reads that stay within the current frame and end before end_address - 1, where
+    // Read would need to handle looping, the end exception or a new predictor/scale.
+    u32 run = 0;
+    if (m_sample_format == 0x00 && !m_reads_stopped && m_end_address >= 2 &&
+        m_current_address < m_end_address - 1)
+    {
+      run = std::min({count - i, (m_current_address | 15) - m_current_address,
+                      m_end_address - 2 - m_current_address});
+    }
+
+    if (run != 0)
+    {
+      const s32 scale = 1 << (m_pred_scale & 0xF);
+      const u32 coef_idx = (m_pred_scale >> 4) & 0x7;
+      const s32 coef1 = coefs[coef_idx * 2 + 0];
+      const s32 coef2 = coefs[coef_idx * 2 + 1];
+
+      s32 yn1 = m_yn1;
+      s32 yn2 = m_yn2;
+      u32 address = m_current_address;
+      for (const u32 end = i + run; i < end; ++i, ++address)
+      {
+        const u8 byte = ReadMemory(address >> 1);
+        const s32 nibble = ((((address & 1) ? byte : byte >> 4) & 0xF) ^ 8) - 8;
+        const s32 val32 = scale * nibble + ((0x400 + coef1 * yn1 + coef2 * yn2) >> 11);
+        yn2 = yn1;
+        yn1 = std::clamp<s32>(val32, -0x7FFF, 0x7FFF);
+        out[i] = static_cast<s16>(yn1);
+      }
+
+      m_yn1 = static_cast<s16>(yn1);
+      m_yn2 = static_cast<s16>(yn2);
+      SetCurrentAddress(address);
+    }
+
+    if (i < count)
+      out[i++] = static_cast<s16>(Read(coefs));
+  }
+}
+
 void Accelerator::DoState(PointerWrap& p)
 {
   p.Do(m_start_address);
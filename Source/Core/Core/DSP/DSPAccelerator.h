@@ -15,6 +15,9 @@ public:
   virtual ~Accelerator() = default;
 
   u16 Read(const s16* coefs);
+  // Equivalent to calling Read count times, but decodes runs of ADPCM samples that can't hit a
+  // frame boundary or the end address without the per-sample checks.
+  void ReadSamples(const s16* coefs, s16* out, u32 count);
   // Zelda ucode reads ARAM through 0xffd3.
   u16 ReadD3();
   void WriteD3(u16 value);
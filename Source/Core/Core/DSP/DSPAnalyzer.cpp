@@ -169,5 +169,68 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
       }
     }
   }
+  // Besides the known signatures, look for any loop that does nothing but poll a mailbox:
+  //   LR/LRS $ACx.M, @CMBH/@DMBH
+  //   ANDF/ANDCF $ACx.M, #0x8000
+  //   JLZ/JLNZ <the load above>
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    if (!IsStartOfInstruction(addr) || IsIdleSkip(addr))
+      continue;
+
+    if (IsMailWaitLoop(dsp, addr))
+    {
+      INFO_LOG_FMT(DSPLLE, "Mail wait loop found at {:02x}", addr);
+      m_code_flags[addr] |= CODE_IDLE_SKIP;
+    }
+  }
+}
+
+bool Analyzer::IsMailWaitLoop(const SDSP& dsp, u16 addr) const
+{
+  u16 pc = addr;
+  const UDSPInstruction load = dsp.ReadIMEM(pc);
+
+  u16 reg;
+  u16 mailbox;
+  if ((load & 0xf800) == 0x2000)
+  {
+    // LRS $(0x18+D), @M
+    reg = 0x18 + ((load >> 8) & 0x7);
+    mailbox = 0xff00 | (load & 0xff);
+    pc += 1;
+  }
+  else if ((load & 0xffe0) == 0x00c0)
+  {
+    // LR $D, @M
+    reg = load & 0x1f;
+    mailbox = dsp.ReadIMEM(static_cast<u16>(pc + 1));
+    pc += 2;
+  }
+  else
+  {
+    return false;
+  }
+
+  if (mailbox != (0xff00 | DSP_CMBH) && mailbox != (0xff00 | DSP_DMBH))
+    return false;
+  if (reg != DSP_REG_ACM0 && reg != DSP_REG_ACM1)
+    return false;
+
+  // ANDF/ANDCF $ACx.M, #0x8000, on the accumulator that was just loaded
+  const UDSPInstruction test = dsp.ReadIMEM(pc);
+  const u16 test_reg = DSP_REG_ACM0 + ((test >> 8) & 1);
+  if (((test & 0xfeff) != 0x02a0 && (test & 0xfeff) != 0x02c0) || test_reg != reg)
+    return false;
+  if (dsp.ReadIMEM(static_cast<u16>(pc + 1)) != 0x8000)
+    return false;
+  pc += 2;
+
+  // JLZ/JLNZ back to the load
+  const UDSPInstruction jump = dsp.ReadIMEM(pc);
+  if (jump != 0x029c && jump != 0x029d)
+    return false;
+
+  return dsp.ReadIMEM(static_cast<u16>(pc + 1)) == addr;
 }
 }  // namespace DSP
@@ -110,6 +110,9 @@ private:
   // Finds locations within the range [start_addr, end_addr) that may contain idle skips.
   void FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr);
 
+  // Whether the instructions at the given address form a loop that only waits for a mailbox.
+  [[nodiscard]] bool IsMailWaitLoop(const SDSP& dsp, u16 addr) const;
+
   // Retrieves the flags set during analysis for code in memory.
   [[nodiscard]] u8 GetCodeFlags(u16 address) const { return m_code_flags[address]; }
 
@@ -0,0 +1,440 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/DSP/Jit/arm64/DSPEmitter.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+
+#include "Common/Assert.h"
+#include "Common/BitSet.h"
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
+
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPHost.h"
+#include "Core/DSP/DSPTables.h"
+#include "Core/DSP/Interpreter/DSPIntTables.h"
+#include "Core/DSP/Interpreter/DSPInterpreter.h"
+
+using namespace Arm64Gen;
+
+namespace DSP::JIT::Arm64
+{
+constexpr size_t COMPILED_CODE_SIZE = 2097152;
+constexpr size_t MAX_BLOCK_SIZE = 250;
+constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
+
+// A block never needs more than this much code space. When less than this is left after compiling
+// a block, the code space is cleared once the dispatcher has returned.
+constexpr size_t CODE_SPACE_RESERVE = 0x10000;
+
+// Registers which hold the same value for as long as the dispatcher is running.
+constexpr ARM64Reg DSP_STATE_REG = ARM64Reg::X19;
+constexpr ARM64Reg BLOCKS_REG = ARM64Reg::X20;
+constexpr ARM64Reg CYCLES_LEFT_REG = ARM64Reg::X21;
+
+// X19 ~ X30, as required by AAPCS64. The dispatcher doesn't touch any floating point registers.
+constexpr u32 ALL_CALLEE_SAVED = 0x7FF80000;
+
+DSPEmitter::DSPEmitter(DSPCore& dsp)
+    : m_blocks(MAX_BLOCKS), m_block_size(MAX_BLOCKS), m_dsp_core{dsp}
+{
+  AllocCodeSpace(COMPILED_CODE_SIZE);
+
+  const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
+  CompileDispatcher();
+  m_stub_entry_point = CompileStub();
+  FlushIcache();
+
+  // Clear all of the block references
+  std::fill(m_blocks.begin(), m_blocks.end(), m_stub_entry_point);
+}
+
+DSPEmitter::~DSPEmitter()
+{
+  FreeCodeSpace();
+}
+
+u16 DSPEmitter::RunCycles(u16 cycles)
+{
+  if (m_dsp_core.DSPState().external_interrupt_waiting.exchange(false, std::memory_order_acquire))
+  {
+    m_dsp_core.CheckExternalInterrupt();
+    m_dsp_core.CheckExceptions();
+  }
+
+  m_cycles_left = cycles;
+  reinterpret_cast<void (*)()>(const_cast<u8*>(m_enter_dispatcher))();
+
+  if (m_dsp_core.DSPState().reset_dspjit_codespace)
+    ClearIRAMandDSPJITCodespaceReset();
+
+  return m_cycles_left;
+}
+
+void DSPEmitter::DoState(PointerWrap& p)
+{
+  p.Do(m_cycles_left);
+}
+
+void DSPEmitter::ClearIRAM()
+{
+  for (size_t i = 0; i < DSP_IRAM_SIZE; i++)
+  {
+    m_blocks[i] = m_stub_entry_point;
+    m_block_size[i] = 0;
+  }
+  m_dsp_core.DSPState().reset_dspjit_codespace = true;
+}
+
+void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
+{
+  const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
+  ClearCodeSpace();
+  CompileDispatcher();
+  m_stub_entry_point = CompileStub();
+  FlushIcache();
+
+  std::fill(m_blocks.begin(), m_blocks.end(), m_stub_entry_point);
+  std::fill(m_block_size.begin(), m_block_size.end(), 0);
+  m_dsp_core.DSPState().reset_dspjit_codespace = false;
+}
+
+static void CheckExceptionsThunk(DSPCore& dsp)
+{
+  dsp.CheckExceptions();
+}
+
+// Must go out of block if exception is detected
+void DSPEmitter::CheckExceptions(u16 retval)
+{
+  LDRB(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPExceptionsOffset());
+  FixupBranch skip_check = CBZ(ARM64Reg::W0);
+
+  MOVI2R(ARM64Reg::W0, m_compile_pc);
+  STRH(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPPCOffset());
+
+  MOVP2R(ARM64Reg::X0, &m_dsp_core);
+  QuickCallFunction(ARM64Reg::X8, CheckExceptionsThunk);
+  MOVI2R(ARM64Reg::W0, retval);
+  B(m_return_dispatcher);
+
+  SetJumpTarget(skip_check);
+}
+
+static void FallbackThunk(Interpreter::Interpreter& interpreter, UDSPInstruction inst)
+{
+  (interpreter.*Interpreter::GetOp(inst))(inst);
+}
+
+static void FallbackExtendedThunk(Interpreter::Interpreter& interpreter, UDSPInstruction inst)
+{
+  // Same order as Interpreter::ExecuteInstruction: the extended part only records its register
+  // writes, which are applied once the main part has run.
+  (interpreter.*Interpreter::GetExtOp(inst))(inst);
+  (interpreter.*Interpreter::GetOp(inst))(inst);
+  interpreter.ApplyWriteBackLog();
+}
+
+void DSPEmitter::EmitInstruction(UDSPInstruction inst)
+{
+  const DSPOPCTemplate* const op_template = GetOpTemplate(inst);
+
+  if (op_template->reads_pc)
+  {
+    // Fallbacks to interpreter need this for fetching immediate values
+    MOVI2R(ARM64Reg::W0, static_cast<u16>(m_compile_pc + 1));
+    STRH(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPPCOffset());
+  }
+
+  ASSERT_MSG(DSPLLE, Interpreter::GetOp(inst) != nullptr, "No function for {:04x}", inst);
+
+  MOVP2R(ARM64Reg::X0, &m_dsp_core.GetInterpreter());
+  MOVI2R(ARM64Reg::W1, inst);
+  if (op_template->extended)
+    QuickCallFunction(ARM64Reg::X8, FallbackExtendedThunk);
+  else
+    QuickCallFunction(ARM64Reg::X8, FallbackThunk);
+}
+
+static void HandleLoopThunk(SDSP& state)
+{
+  // Handle looping hardware, see Interpreter::HandleLoop.
+  const u16 call_address = state.r.st[0];
+  const u16 loop_address = state.r.st[2];
+  u16& loop_counter = state.r.st[3];
+
+  if (loop_address == 0 || loop_counter == 0 || state.pc - 1 != loop_address)
+    return;
+
+  loop_counter--;
+  if (loop_counter > 0)
+  {
+    state.pc = call_address;
+  }
+  else
+  {
+    // end of loop
+    state.PopStack(StackRegister::Call);
+    state.PopStack(StackRegister::LoopAddress);
+    state.PopStack(StackRegister::LoopCounter);
+  }
+}
+
+void DSPEmitter::HandleLoop()
+{
+  MOV(ARM64Reg::X0, DSP_STATE_REG);
+  QuickCallFunction(ARM64Reg::X8, HandleLoopThunk);
+}
+
+void DSPEmitter::WriteBlockExit(u16 start_addr)
+{
+  const auto& analyzer = m_dsp_core.DSPState().GetAnalyzer();
+
+  if (!Host::OnThread() && analyzer.IsIdleSkip(start_addr))
+    MOVI2R(ARM64Reg::W0, DSP_IDLE_SKIP_CYCLES);
+  else
+    MOVI2R(ARM64Reg::W0, m_block_size[start_addr]);
+  B(m_return_dispatcher);
+}
+
+std::optional<u16> DSPEmitter::GetStaticBranchTarget(UDSPInstruction inst, u16 address) const
+{
+  // Jcc and CALLcc take their destination as an immediate.
+  if ((inst & 0xfff0) == 0x0290 || (inst & 0xfff0) == 0x02b0)
+    return m_dsp_core.DSPState().ReadIMEM(static_cast<u16>(address + 1));
+
+  return std::nullopt;
+}
+
+void DSPEmitter::WriteBlockLink(u16 start_addr, u16 dest)
+{
+  // Idle skip blocks have to give up the rest of the time slice, so they always exit.
+  if (m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(start_addr))
+    return;
+
+  // Jump straight to the destination block if there are enough cycles left to do so. This goes
+  // through the block table, so the destination doesn't need to have been compiled yet: the stub
+  // reports 0 cycles to the dispatcher, which only has to account for the destination itself.
+  const u16 block_cycles = m_block_size[start_addr];
+  LDRH(IndexType::Unsigned, ARM64Reg::W1, CYCLES_LEFT_REG, 0);
+  CMPI2R(ARM64Reg::W1, block_cycles, ARM64Reg::W2);
+  FixupBranch not_enough_cycles = B(CC_LS);
+
+  SUBI2R(ARM64Reg::W1, ARM64Reg::W1, block_cycles, ARM64Reg::W2);
+  STRH(IndexType::Unsigned, ARM64Reg::W1, CYCLES_LEFT_REG, 0);
+  MOVI2R(ARM64Reg::X0, dest);
+  LDR(ARM64Reg::X1, BLOCKS_REG, ArithOption(ARM64Reg::X0, true));
+  BR(ARM64Reg::X1);
+
+  SetJumpTarget(not_enough_cycles);
+}
+
+void DSPEmitter::Compile(u16 start_addr)
+{
+  const DSPCompiledCode entry_point = AlignCode16();
+
+  m_compile_pc = start_addr;
+  bool fixup_pc = false;
+  std::optional<u16> link_dest;
+  m_block_size[start_addr] = 0;
+
+  auto& analyzer = m_dsp_core.DSPState().GetAnalyzer();
+  while (m_compile_pc < start_addr + MAX_BLOCK_SIZE)
+  {
+    if (analyzer.IsCheckExceptions(m_compile_pc))
+      CheckExceptions(m_block_size[start_addr]);
+
+    const UDSPInstruction inst = m_dsp_core.DSPState().ReadIMEM(m_compile_pc);
+    const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+
+    EmitInstruction(inst);
+
+    m_block_size[start_addr]++;
+    m_compile_pc += opcode->size;
+
+    fixup_pc = true;
+
+    // Handle loop condition, only if current instruction was flagged as a loop destination
+    // by the analyzer.
+    if (analyzer.IsLoopEnd(static_cast<u16>(m_compile_pc - 1u)))
+    {
+      LDRH(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPRStOffset(2));
+      FixupBranch loop_address_exit = CBZ(ARM64Reg::W0);
+      LDRH(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPRStOffset(3));
+      FixupBranch loop_counter_exit = CBZ(ARM64Reg::W0);
+
+      if (!opcode->branch)
+      {
+        // branch insns update the g_dsp.pc
+        MOVI2R(ARM64Reg::W0, m_compile_pc);
+        STRH(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPPCOffset());
+      }
+
+      HandleLoop();
+      WriteBlockExit(start_addr);
+
+      SetJumpTarget(loop_address_exit);
+      SetJumpTarget(loop_counter_exit);
+    }
+
+    if (opcode->branch)
+    {
+      // don't update g_dsp.pc -- the branch insn already did
+      fixup_pc = false;
+      if (opcode->uncond_branch)
+      {
+        link_dest = GetStaticBranchTarget(inst, static_cast<u16>(m_compile_pc - opcode->size));
+        break;
+      }
+
+      // look at g_dsp.pc if we actually branched
+      LDRH(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPPCOffset());
+      CMPI2R(ARM64Reg::W0, m_compile_pc, ARM64Reg::W1);
+      FixupBranch no_branch = B(CC_EQ);
+      if (const auto dest =
+              GetStaticBranchTarget(inst, static_cast<u16>(m_compile_pc - opcode->size)))
+      {
+        WriteBlockLink(start_addr, *dest);
+      }
+      WriteBlockExit(start_addr);
+      SetJumpTarget(no_branch);
+    }
+
+    // End the block if we're before an idle skip address
+    if (analyzer.IsIdleSkip(m_compile_pc))
+      break;
+  }
+
+  if (fixup_pc)
+  {
+    MOVI2R(ARM64Reg::W0, m_compile_pc);
+    STRH(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPPCOffset());
+  }
+
+  if (m_block_size[start_addr] == 0)
+  {
+    // just a safeguard, should never happen anymore.
+    // if it does we might get stuck over in RunForCycles.
+    ERROR_LOG_FMT(DSPLLE, "Block at {:#06x} has zero size", start_addr);
+    m_block_size[start_addr] = 1;
+  }
+
+  if (link_dest)
+    WriteBlockLink(start_addr, *link_dest);
+  WriteBlockExit(start_addr);
+
+  FlushIcacheSection(const_cast<u8*>(entry_point), GetWritableCodePtr());
+  m_blocks[start_addr] = entry_point;
+}
+
+void DSPEmitter::CompileCurrent(DSPEmitter& emitter)
+{
+  const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
+
+  emitter.Compile(emitter.m_dsp_core.DSPState().pc);
+
+  // The code space can't be cleared from here since we were called from inside of it, so leave
+  // that to RunCycles once the dispatcher has returned.
+  if (emitter.GetSpaceLeft() < CODE_SPACE_RESERVE)
+    emitter.m_dsp_core.DSPState().reset_dspjit_codespace = true;
+}
+
+DSPEmitter::DSPCompiledCode DSPEmitter::CompileStub()
+{
+  const DSPCompiledCode entry_point = AlignCode16();
+  MOVP2R(ARM64Reg::X0, this);
+  QuickCallFunction(ARM64Reg::X8, CompileCurrent);
+  MOVI2R(ARM64Reg::W0, 0);  // Return 0 cycles executed
+  B(m_return_dispatcher);
+  return entry_point;
+}
+
+void DSPEmitter::CompileDispatcher()
+{
+  m_enter_dispatcher = AlignCode16();
+
+  const BitSet32 registers_used(ALL_CALLEE_SAVED);
+  ABI_PushRegisters(registers_used);
+
+  MOVP2R(DSP_STATE_REG, &m_dsp_core.DSPState());
+  MOVP2R(BLOCKS_REG, m_blocks.data());
+  MOVP2R(CYCLES_LEFT_REG, &m_cycles_left);
+
+  const u8* dispatcher_loop = GetCodePtr();
+
+  FixupBranch exception_exit;
+  if (Host::OnThread())
+  {
+    LDRB(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPExternalInterruptWaitingOffset());
+    exception_exit = CBNZ(ARM64Reg::W0);
+  }
+
+  // Check for DSP halt
+  LDRH(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPControlRegOffset());
+  TSTI2R(ARM64Reg::W0, CR_HALT, ARM64Reg::W1);
+  FixupBranch halt = B(CC_NEQ);
+
+  // Execute block. Cycles executed returned in W0.
+  LDRH(IndexType::Unsigned, ARM64Reg::W0, DSP_STATE_REG, SDSPPCOffset());
+  LDR(ARM64Reg::X1, BLOCKS_REG, ArithOption(ARM64Reg::X0, true));
+  BR(ARM64Reg::X1);
+
+  m_return_dispatcher = GetCodePtr();
+
+  // Decrement cyclesLeft
+  LDRH(IndexType::Unsigned, ARM64Reg::W1, CYCLES_LEFT_REG, 0);
+  SUBS(ARM64Reg::W1, ARM64Reg::W1, ARM64Reg::W0);
+  STRH(IndexType::Unsigned, ARM64Reg::W1, CYCLES_LEFT_REG, 0);
+  B(CC_GT, dispatcher_loop);
+
+  // DSP gave up the remaining cycles.
+  SetJumpTarget(halt);
+  if (Host::OnThread())
+    SetJumpTarget(exception_exit);
+
+  ABI_PopRegisters(registers_used);
+  RET();
+}
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+s32 DSPEmitter::SDSPPCOffset()
+{
+  return static_cast<s32>(offsetof(SDSP, pc));
+}
+
+s32 DSPEmitter::SDSPExceptionsOffset()
+{
+  return static_cast<s32>(offsetof(SDSP, exceptions));
+}
+
+s32 DSPEmitter::SDSPControlRegOffset()
+{
+  return static_cast<s32>(offsetof(SDSP, control_reg));
+}
+
+s32 DSPEmitter::SDSPExternalInterruptWaitingOffset()
+{
+  static_assert(decltype(SDSP::external_interrupt_waiting)::is_always_lock_free &&
+                sizeof(SDSP::external_interrupt_waiting) == sizeof(u8));
+
+  return static_cast<s32>(offsetof(SDSP, external_interrupt_waiting));
+}
+
+s32 DSPEmitter::SDSPRStOffset(size_t index)
+{
+  return static_cast<s32>(offsetof(SDSP, r.st) + sizeof(SDSP::r.st[0]) * index);
+}
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+}  // namespace DSP::JIT::Arm64
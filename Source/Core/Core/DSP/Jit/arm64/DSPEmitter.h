@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "Common/Arm64Emitter.h"
+#include "Common/CommonTypes.h"
+
+#include "Core/DSP/DSPCommon.h"
+#include "Core/DSP/Jit/DSPEmitterBase.h"
+
+class PointerWrap;
+
+namespace DSP::JIT::Arm64
+{
+// Block-based recompiler for ARM64 hosts.
+//
+// Blocks are split at the same places as on x64 (branches, loop ends, idle skip addresses and
+// exception checks found by the analyzer) and run from a native dispatcher loop. Instructions are
+// executed by calling straight into the interpreter's handlers, extended opcodes included, so that
+// the per-instruction fetch, decode and analyzer lookups of the interpreter loop are done once at
+// compile time instead of on every step.
+class DSPEmitter final : public JIT::DSPEmitter, public Arm64Gen::ARM64CodeBlock
+{
+public:
+  explicit DSPEmitter(DSPCore& dsp);
+  ~DSPEmitter() override;
+
+  u16 RunCycles(u16 cycles) override;
+  void DoState(PointerWrap& p) override;
+  void ClearIRAM() override;
+
+private:
+  using DSPCompiledCode = const u8*;
+
+  // The emitter emits calls to this function. It's present here
+  // within the class itself to allow access to member variables.
+  static void CompileCurrent(DSPEmitter& emitter);
+
+  void ClearIRAMandDSPJITCodespaceReset();
+
+  void CompileDispatcher();
+  DSPCompiledCode CompileStub();
+  void Compile(u16 start_addr);
+
+  void EmitInstruction(UDSPInstruction inst);
+  void CheckExceptions(u16 retval);
+  void HandleLoop();
+
+  // Leaves the block and returns to the dispatcher, reporting the block's cycle count.
+  void WriteBlockExit(u16 start_addr);
+
+  // Continues directly with the block at dest, without going through the dispatcher, as long as
+  // the current time slice has enough cycles left. Falls through otherwise.
+  void WriteBlockLink(u16 start_addr, u16 dest);
+
+  // Returns the destination of a branch instruction at the given address, if it is known at
+  // compile time.
+  std::optional<u16> GetStaticBranchTarget(UDSPInstruction inst, u16 address) const;
+
+  // SDSP memory offset helpers, relative to the register holding the SDSP pointer.
+  static s32 SDSPPCOffset();
+  static s32 SDSPExceptionsOffset();
+  static s32 SDSPControlRegOffset();
+  static s32 SDSPExternalInterruptWaitingOffset();
+  static s32 SDSPRStOffset(size_t index);
+
+  static constexpr size_t MAX_BLOCKS = 0x10000;
+
+  u16 m_compile_pc = 0;
+
+  std::vector<DSPCompiledCode> m_blocks;
+  std::vector<u16> m_block_size;
+
+  u16 m_cycles_left = 0;
+
+  const u8* m_enter_dispatcher = nullptr;
+  const u8* m_return_dispatcher = nullptr;
+  DSPCompiledCode m_stub_entry_point = nullptr;
+
+  DSPCore& m_dsp_core;
+};
+}  // namespace DSP::JIT::Arm64
@@ -11,6 +11,7 @@
 #include "Common/BitSet.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/JitRegister.h"
 #include "Common/Logging/Log.h"
 
 #include "Core/DSP/DSPAnalyzer.h"
@@ -390,6 +391,8 @@ void DSPEmitter::Compile(u16 start_addr)
     MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
   }
   JMP(m_return_dispatcher, true);
+
+  JitRegister::Register(entryPoint, GetCodePtr(), "DSP_JIT_{:04x}", start_addr);
 }
 
 void DSPEmitter::CompileCurrent(DSPEmitter& emitter)
@@ -468,6 +471,8 @@ void DSPEmitter::CompileDispatcher()
   // MOV(32, M(&cyclesLeft), Imm32(0));
   ABI_PopRegistersAndAdjustStack(registers_used, 8);
   RET();
+
+  JitRegister::Register(m_enter_dispatcher, GetCodePtr(), "DSP_JIT_Dispatcher");
 }
 
 #ifdef __GNUC__
@@ -130,7 +130,8 @@ void DolphinAnalytics::ReportGameStart()
   Send(builder);
 
   // Reset per-game state.
-  m_reported_quirks.fill(false);
+  for (std::atomic<bool>& reported : m_reported_quirks)
+    reported = false;
   InitializePerformanceSampling();
 }
 
@@ -172,10 +173,9 @@ void DolphinAnalytics::ReportGameQuirk(GameQuirk quirk)
 {
   u32 quirk_idx = static_cast<u32>(quirk);
 
-  // Only report once per run.
-  if (m_reported_quirks[quirk_idx])
+  // Only report once per run. This can be called from the DSP HLE voice workers.
+  if (m_reported_quirks[quirk_idx].exchange(true))
     return;
-  m_reported_quirks[quirk_idx] = true;
 
   Common::AnalyticsReportBuilder builder(m_per_game_builder);
   builder.AddData("type", "quirk");
@@ -200,11 +200,13 @@ void DolphinAnalytics::ReportPerformanceInfo(PerformanceSample&& sample)
     std::vector<u32> speed_times_1000(m_performance_samples.size());
     std::vector<u32> num_prims(m_performance_samples.size());
     std::vector<u32> num_draw_calls(m_performance_samples.size());
+    std::vector<u32> sync_gpu_distance(m_performance_samples.size());
     for (size_t i = 0; i < m_performance_samples.size(); ++i)
     {
       speed_times_1000[i] = static_cast<u32>(m_performance_samples[i].speed_ratio * 1000);
       num_prims[i] = m_performance_samples[i].num_prims;
       num_draw_calls[i] = m_performance_samples[i].num_draw_calls;
+      sync_gpu_distance[i] = m_performance_samples[i].sync_gpu_distance;
     }
 
     // The per game builder should already exist -- there is no way we can be reporting performance
@@ -214,6 +216,8 @@ void DolphinAnalytics::ReportPerformanceInfo(PerformanceSample&& sample)
     builder.AddData("speed", speed_times_1000);
     builder.AddData("prims", num_prims);
     builder.AddData("draw-calls", num_draw_calls);
+    if (Config::Get(Config::MAIN_SYNC_GPU))
+      builder.AddData("sync-gpu-distance", sync_gpu_distance);
 
     Send(builder);
 
@@ -365,6 +369,7 @@ void DolphinAnalytics::MakePerGameBuilder()
   builder.AddData("cfg-cpu-thread", Config::Get(Config::MAIN_CPU_THREAD));
   builder.AddData("cfg-fastmem", Config::Get(Config::MAIN_FASTMEM));
   builder.AddData("cfg-syncgpu", Config::Get(Config::MAIN_SYNC_GPU));
+  builder.AddData("cfg-syncgpu-adaptive", Config::Get(Config::MAIN_SYNC_GPU_ADAPTIVE));
   builder.AddData("cfg-audio-backend", Config::Get(Config::MAIN_AUDIO_BACKEND));
   builder.AddData("cfg-oc-enable", Config::Get(Config::MAIN_OVERCLOCK_ENABLE));
   builder.AddData("cfg-oc-factor", Config::Get(Config::MAIN_OVERCLOCK));
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -128,6 +129,7 @@ public:
     double speed_ratio;  // See SystemTimers::GetEstimatedEmulationPerformance().
     int num_prims;
     int num_draw_calls;
+    int sync_gpu_distance;  // See Fifo::GetSyncGPUStats().
   };
   // Reports performance information. This method performs its own throttling / aggregation --
   // calling it does not guarantee when a report will actually be sent.
@@ -175,7 +177,7 @@ private:
   std::vector<PerformanceSample> m_performance_samples;
 
   // What quirks have already been reported about the current game.
-  std::array<bool, static_cast<size_t>(GameQuirk::COUNT)> m_reported_quirks;
+  std::array<std::atomic<bool>, static_cast<size_t>(GameQuirk::COUNT)> m_reported_quirks;
 
   // Builder that contains all non variable data that should be sent with all
   // reports.
@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 
+#include <zstd.h>
+
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
@@ -17,13 +19,13 @@
 enum
 {
   FILE_ID = 0x0d01f1f0,
-  VERSION_NUMBER = 5,
-  MIN_LOADER_VERSION = 1,
-  // This value is only used if the DFF file was created with overridden RAM sizes.
-  // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
-  MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5,
+  VERSION_NUMBER = 6,
+  // Frames are compressed since version 6.
+  MIN_LOADER_VERSION = 6,
 };
 
+constexpr int ZSTD_COMPRESSION_LEVEL = 3;
+
 #pragma pack(push, 1)
 
 struct FileHeader
@@ -60,7 +62,11 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  // In compressed files, fifoDataOffset points to the compressed frame data, which is the FIFO
+  // data followed by the data of each memory update.
+  u32 compressedSize;
+  u32 uncompressedSize;
+  u8 reserved[24];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -68,6 +74,7 @@ struct FileMemoryUpdate
 {
   u32 fifoPosition;
   u32 address;
+  // Relative to the start of the uncompressed frame data in compressed files.
   u64 dataOffset;
   u32 dataSize;
   u8 type;
@@ -103,7 +110,31 @@ bool FifoDataFile::GetIsWii() const
 
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  m_Frames.push_back(std::make_shared<const FifoFrameInfo>(frameInfo));
+  m_loaded_frames.emplace_back();
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  if (m_Frames[frame])
+    return m_Frames[frame];
+
+  std::lock_guard lk(m_file_mutex);
+
+  if (std::shared_ptr<const FifoFrameInfo> loaded = m_loaded_frames[frame].lock())
+    return loaded;
+
+  std::shared_ptr<const FifoFrameInfo> loaded = ReadFrame(frame);
+  if (!loaded)
+  {
+    PanicAlertFmt("Failed to read frame {} of the DFF file.", frame);
+    loaded = std::make_shared<const FifoFrameInfo>();
+  }
+
+  m_loaded_frames[frame] = loaded;
+  m_recent_frames[m_next_recent_frame] = loaded;
+  m_next_recent_frame = (m_next_recent_frame + 1) % m_recent_frames.size();
+  return loaded;
 }
 
 bool FifoDataFile::Save(const std::string& filename)
@@ -138,11 +169,7 @@ bool FifoDataFile::Save(const std::string& filename)
   FileHeader header;
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
-    header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
-  else
-    header.min_loader_version = MIN_LOADER_VERSION;
+  header.min_loader_version = MIN_LOADER_VERSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -162,7 +189,7 @@ bool FifoDataFile::Save(const std::string& filename)
   header.frameListOffset = frameListOffset;
   header.frameCount = (u32)m_Frames.size();
 
-  header.flags = m_Flags;
+  header.flags = m_Flags | FLAG_COMPRESSED;
 
   header.mem1_size = Memory::GetRamSizeReal();
   header.mem2_size = Memory::GetExRamSizeReal();
@@ -171,24 +198,41 @@ bool FifoDataFile::Save(const std::string& filename)
   file.WriteBytes(&header, sizeof(FileHeader));
 
   // Write frames list
+  std::vector<u8> frameData;
+  std::vector<u8> compressedData;
   for (unsigned int i = 0; i < m_Frames.size(); ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
+    const std::shared_ptr<const FifoFrameInfo> frame = GetFrame(i);
+    const FifoFrameInfo& srcFrame = *frame;
+
+    frameData = srcFrame.fifoData;
+    for (const MemoryUpdate& update : srcFrame.memoryUpdates)
+      frameData.insert(frameData.end(), update.data.begin(), update.data.end());
+
+    compressedData.resize(ZSTD_compressBound(frameData.size()));
+    const size_t compressedSize = ZSTD_compress(compressedData.data(), compressedData.size(),
+                                                frameData.data(), frameData.size(),
+                                                ZSTD_COMPRESSION_LEVEL);
+    if (ZSTD_isError(compressedSize))
+      return false;
 
-    // Write FIFO data
+    // Write frame data
     file.Seek(0, File::SeekOrigin::End);
     u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+    file.WriteBytes(compressedData.data(), compressedSize);
 
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+    u64 memoryUpdatesOffset =
+        WriteMemoryUpdates(srcFrame.memoryUpdates, srcFrame.fifoData.size(), file);
 
-    FileFrameInfo dstFrame;
+    FileFrameInfo dstFrame{};
     dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
     dstFrame.fifoDataOffset = dataOffset;
     dstFrame.fifoStart = srcFrame.fifoStart;
     dstFrame.fifoEnd = srcFrame.fifoEnd;
     dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
     dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
+    dstFrame.compressedSize = static_cast<u32>(compressedSize);
+    dstFrame.uncompressedSize = static_cast<u32>(frameData.size());
 
     // Write frame info
     u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
@@ -315,33 +359,68 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
-  for (u32 i = 0; i < header.frameCount; ++i)
-  {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
-      return panic_failed_to_read();
+  // Frames are read when they are needed, so only check that the frame list is there.
+  if (header.frameListOffset + u64{header.frameCount} * sizeof(FileFrameInfo) > file.GetSize())
+    return panic_failed_to_read();
 
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
+  dataFile->m_Frames.resize(header.frameCount);
+  dataFile->m_loaded_frames.resize(header.frameCount);
+  dataFile->m_frame_list_offset = header.frameListOffset;
+  dataFile->m_file = std::make_unique<File::IOFile>(std::move(file));
 
-    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
+  return dataFile;
+}
 
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::ReadFrame(u32 frame) const
+{
+  File::IOFile& file = *m_file;
+
+  FileFrameInfo srcFrame;
+  file.Seek(m_frame_list_offset + u64{frame} * sizeof(FileFrameInfo), File::SeekOrigin::Begin);
+  if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
+    return nullptr;
 
-    if (!file.IsGood())
-      return panic_failed_to_read();
+  auto dstFrame = std::make_shared<FifoFrameInfo>();
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
+
+  if (GetFlag(FLAG_COMPRESSED))
+  {
+    std::vector<u8> compressedData(srcFrame.compressedSize);
+    std::vector<u8> frameData(srcFrame.uncompressedSize);
+    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
+    if (!file.ReadBytes(compressedData.data(), compressedData.size()) ||
+        ZSTD_decompress(frameData.data(), frameData.size(), compressedData.data(),
+                        compressedData.size()) != frameData.size() ||
+        srcFrame.fifoDataSize > frameData.size())
+    {
+      return nullptr;
+    }
+
+    dstFrame->fifoData.assign(frameData.begin(), frameData.begin() + srcFrame.fifoDataSize);
+    if (!ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
+                           dstFrame->memoryUpdates, file, &frameData))
+    {
+      return nullptr;
+    }
+  }
+  else
+  {
+    dstFrame->fifoData.resize(srcFrame.fifoDataSize);
+    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
+    file.ReadBytes(dstFrame->fifoData.data(), srcFrame.fifoDataSize);
 
-    dataFile->AddFrame(dstFrame);
+    if (!ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
+                           dstFrame->memoryUpdates, file, nullptr))
+    {
+      return nullptr;
+    }
   }
 
-  return dataFile;
+  if (!file.IsGood())
+    return nullptr;
+
+  return dstFrame;
 }
 
 void FifoDataFile::PadFile(size_t numBytes, File::IOFile& file)
@@ -363,39 +442,31 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
+u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, u64 dataOffset,
                                      File::IOFile& file)
 {
-  // Add space for memory update list
+  // The data itself is part of the compressed frame data, starting at dataOffset.
   u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
 
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
+  for (const MemoryUpdate& srcUpdate : memUpdates)
   {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
-
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
-
-    FileMemoryUpdate dstUpdate;
+    FileMemoryUpdate dstUpdate{};
     dstUpdate.address = srcUpdate.address;
     dstUpdate.dataOffset = dataOffset;
     dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
     dstUpdate.type = srcUpdate.type;
-
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
     file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
+
+    dataOffset += srcUpdate.data.size();
   }
 
   return updateListOffset;
 }
 
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
+bool FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file,
+                                     const std::vector<u8>* frameData)
 {
   memUpdates.resize(numUpdates);
 
@@ -404,15 +475,30 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
     file.Seek(updateOffset, File::SeekOrigin::Begin);
     FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
+    if (!file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate)))
+      return false;
 
     MemoryUpdate& dstUpdate = memUpdates[i];
     dstUpdate.address = srcUpdate.address;
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
     dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
 
-    file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
+    if (frameData)
+    {
+      if (srcUpdate.dataOffset + srcUpdate.dataSize > frameData->size())
+        return false;
+
+      const auto data = frameData->begin() + srcUpdate.dataOffset;
+      dstUpdate.data.assign(data, data + srcUpdate.dataSize);
+    }
+    else
+    {
+      dstUpdate.data.resize(srcUpdate.dataSize);
+      file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
+      if (!file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize))
+        return false;
+    }
   }
+
+  return true;
 }
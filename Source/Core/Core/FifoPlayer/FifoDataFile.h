@@ -5,6 +5,7 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -73,8 +74,11 @@ public:
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
+  // Frames of a loaded file are only read (and decompressed) from it when they're needed, and are
+  // kept in memory for as long as something holds on to them. Can be called from any thread.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
   u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Each frame is compressed separately, so that it can be loaded on its own.
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -82,7 +86,8 @@ public:
 private:
   enum
   {
-    FLAG_IS_WII = 1
+    FLAG_IS_WII = 1,
+    FLAG_COMPRESSED = 2,
   };
 
   void PadFile(size_t numBytes, File::IOFile& file);
@@ -90,9 +95,12 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, u64 dataOffset,
+                         File::IOFile& file);
+  static bool ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
+                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file,
+                                const std::vector<u8>* frameData);
+  std::shared_ptr<const FifoFrameInfo> ReadFrame(u32 frame) const;
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -105,5 +113,15 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  // Only set for frames added with AddFrame. The frames of a loaded file are read from m_file.
+  std::vector<std::shared_ptr<const FifoFrameInfo>> m_Frames;
+
+  mutable std::mutex m_file_mutex;
+  std::unique_ptr<File::IOFile> m_file;
+  u64 m_frame_list_offset = 0;
+  mutable std::vector<std::weak_ptr<const FifoFrameInfo>> m_loaded_frames;
+  // The most recently read frames are kept around, so that playback and the FIFO analyzer don't
+  // read a frame again when going back and forth.
+  mutable std::array<std::shared_ptr<const FifoFrameInfo>, 8> m_recent_frames;
+  mutable size_t m_next_recent_frame = 0;
 };
@@ -9,7 +9,10 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -25,6 +28,8 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/TMEM.h"
 #include "VideoCommon/VideoCommon.h"
 
 // We need to include TextureDecoder.h for the texMem array.
@@ -80,7 +85,8 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
   for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
+    const std::shared_ptr<const FifoFrameInfo> frame_data = file->GetFrame(frame_no);
+    const FifoFrameInfo& frame = *frame_data;
     AnalyzedFrameInfo& analyzed = frame_info[frame_no];
 
     u32 offset = 0;
@@ -227,6 +233,8 @@ public:
     CPU::EnableStepping(false);
 
     m_parent->m_CurrentFrame = m_parent->m_FrameRangeStart;
+    m_parent->m_benchmark_loop = 0;
+    m_parent->m_benchmark_frames.clear();
     m_parent->LoadMemory();
   }
 
@@ -274,8 +282,15 @@ CPU::State FifoPlayer::AdvanceFrame()
 {
   if (m_CurrentFrame > m_FrameRangeEnd)
   {
-    if (!m_Loop)
+    if (m_benchmark_loops != 0)
+    {
+      if (++m_benchmark_loop == m_benchmark_loops)
+        return CPU::State::PowerDown;
+    }
+    else if (!m_Loop)
+    {
       return CPU::State::PowerDown;
+    }
 
     // When looping, reload the contents of all the BP/CP/CF registers.
     // This ensures that each time the first frame is played back, the state of the
@@ -292,7 +307,23 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  if (m_benchmark_loops != 0)
+  {
+    const u64 start_us = Common::Timer::NowUs();
+    const int draw_calls = g_stats.num_draw_calls_total;
+    const int shaders = g_stats.num_vertex_shaders_created + g_stats.num_pixel_shaders_created;
+
+    WriteFrame(*m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+
+    m_benchmark_frames.push_back(
+        {m_benchmark_loop, m_CurrentFrame, Common::Timer::NowUs() - start_us,
+         g_stats.num_draw_calls_total - draw_calls,
+         g_stats.num_vertex_shaders_created + g_stats.num_pixel_shaders_created - shaders});
+  }
+  else
+  {
+    WriteFrame(*m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  }
 
   ++m_CurrentFrame;
   return CPU::State::Running;
@@ -323,6 +354,36 @@ void FifoPlayer::SetFileLoadedCallback(CallbackFunc callback)
   }
 }
 
+void FifoPlayer::SetBenchmarkLoops(u32 loops)
+{
+  m_benchmark_loops = loops;
+}
+
+bool FifoPlayer::WriteBenchmarkResults(const std::string& path) const
+{
+  std::string json = "{\"frames\":[\n";
+  u64 total_us = 0;
+  for (size_t i = 0; i < m_benchmark_frames.size(); ++i)
+  {
+    const BenchmarkFrame& frame = m_benchmark_frames[i];
+    json += fmt::format(R"({{"loop":{},"frame":{},"time_us":{},"draw_calls":{},)"
+                        R"("shaders_compiled":{}}}{})",
+                        frame.loop, frame.frame, frame.time_us, frame.draw_calls,
+                        frame.shaders_compiled, i + 1 < m_benchmark_frames.size() ? ",\n" : "");
+    total_us += frame.time_us;
+  }
+  json += fmt::format("\n],\"frame_count\":{},\"total_time_us\":{}}}\n",
+                      m_benchmark_frames.size(), total_us);
+
+  File::IOFile file(path, "wb");
+  if (!file.WriteString(json))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write FIFO benchmark results to {}", path);
+    return false;
+  }
+  return true;
+}
+
 bool FifoPlayer::IsRunningWithFakeVideoInterfaceUpdates() const
 {
   if (!m_File || m_File->GetFrameCount() == 0)
@@ -483,8 +544,8 @@ void FifoPlayer::WriteAllMemoryUpdates()
 
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
+    const std::shared_ptr<const FifoFrameInfo> frame = m_File->GetFrame(frameNum);
+    for (auto& update : frame->memoryUpdates)
     {
       WriteMemory(update);
     }
@@ -542,7 +603,8 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const std::shared_ptr<const FifoFrameInfo> frame_data = m_File->GetFrame(m_CurrentFrame);
+  const FifoFrameInfo& frame = *frame_data;
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
@@ -687,6 +749,7 @@ void FifoPlayer::LoadTextureMemory()
   static_assert(static_cast<size_t>(TMEM_SIZE) == static_cast<size_t>(FifoDataFile::TEX_MEM_SIZE),
                 "TMEM_SIZE matches the size of texture memory in FifoDataFile");
   std::memcpy(texMem, m_File->GetTexMem(), FifoDataFile::TEX_MEM_SIZE);
+  TMEM::Write(0, TMEM_SIZE);
 }
 
 void FifoPlayer::WriteCP(u32 address, u16 value)
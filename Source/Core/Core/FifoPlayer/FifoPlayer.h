@@ -130,6 +130,24 @@ public:
 
   bool IsRunningWithFakeVideoInterfaceUpdates() const;
 
+  struct BenchmarkFrame
+  {
+    u32 loop;
+    u32 frame;
+    // Host time spent playing back the frame. In single core mode this includes decoding and
+    // rendering it.
+    u64 time_us;
+    int draw_calls;
+    // Vertex and pixel shaders that weren't in the shader cache yet.
+    int shaders_compiled;
+  };
+
+  // Makes the next playback go through the frame range the given number of times, regardless of
+  // the loop setting, recording every frame before stopping emulation. 0 disables this again.
+  void SetBenchmarkLoops(u32 loops);
+  const std::vector<BenchmarkFrame>& GetBenchmarkFrames() const { return m_benchmark_frames; }
+  bool WriteBenchmarkResults(const std::string& path) const;
+
 private:
   class CPUCore;
   FifoPlayer();
@@ -187,6 +205,10 @@ private:
   u32 m_ElapsedCycles = 0;
   u32 m_FrameFifoSize = 0;
 
+  u32 m_benchmark_loops = 0;
+  u32 m_benchmark_loop = 0;
+  std::vector<BenchmarkFrame> m_benchmark_frames;
+
   CallbackFunc m_FileLoadedCb = nullptr;
   CallbackFunc m_FrameWrittenCb = nullptr;
   size_t m_config_changed_callback_id;
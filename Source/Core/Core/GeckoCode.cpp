@@ -56,13 +56,27 @@ enum class Installation
 {
   Uninstalled,
   Installed,
-  Failed
+  Failed,
+  // All codes are applied by RunCodeHandler itself instead of the code handler
+  Native
+};
+
+// A raw write of code type 00, 02 or 04, which writes count values of size bytes starting at
+// address. The base address is always the default of 0x80000000, since only the other code types
+// can change it.
+struct NativeWrite
+{
+  u32 address;
+  u32 value;
+  u32 count;
+  u32 size;
 };
 
 static Installation s_code_handler_installed = Installation::Uninstalled;
 // the currently active codes
 static std::vector<GeckoCode> s_active_codes;
 static std::vector<GeckoCode> s_synced_codes;
+static std::vector<NativeWrite> s_native_writes;
 static std::mutex s_active_codes_lock;
 
 void SetActiveCodes(const std::vector<GeckoCode>& gcodes)
@@ -212,6 +226,84 @@ static Installation InstallCodeHandlerLocked()
   return Installation::Installed;
 }
 
+// Requires s_active_codes_lock
+// Returns false if any code needs the code handler. Lists of codes that only write to RAM are
+// common, and running the code handler on the emulated CPU every frame costs a lot more than
+// applying their writes directly.
+static bool CompileNativeWritesLocked()
+{
+  s_native_writes.clear();
+  for (const GeckoCode& active_code : s_active_codes)
+  {
+    for (const GeckoCode::Code& code : active_code.codes)
+    {
+      const u32 address = 0x80000000 | (code.address & 0x01FFFFFF);
+      switch (code.address >> 25)
+      {
+      case 0x00:  // 00XXXXXX YYYY00ZZ: 8-bit write, repeated YYYY times
+        s_native_writes.push_back({address, code.data & 0xFF, (code.data >> 16) + 1, 1});
+        break;
+      case 0x01:  // 02XXXXXX YYYYZZZZ: 16-bit write, repeated YYYY times
+        s_native_writes.push_back({address, code.data & 0xFFFF, (code.data >> 16) + 1, 2});
+        break;
+      case 0x02:  // 04XXXXXX ZZZZZZZZ: 32-bit write
+        s_native_writes.push_back({address, code.data, 1, 4});
+        break;
+      default:
+        s_native_writes.clear();
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Requires s_active_codes_lock
+static void RunNativeWritesLocked()
+{
+  for (const NativeWrite& write : s_native_writes)
+  {
+    for (u32 i = 0; i < write.count; ++i)
+    {
+      const u32 address = write.address + i * write.size;
+
+      // Most codes keep writing the same value, so only invalidate the icache for writes which
+      // change memory, like the code handler's ICBI workaround would.
+      bool changed;
+      switch (write.size)
+      {
+      case 1:
+      {
+        const auto old = PowerPC::HostTryReadU8(address);
+        changed = !old || old->value != write.value;
+        if (changed)
+          PowerPC::HostTryWriteU8(write.value, address);
+        break;
+      }
+      case 2:
+      {
+        const auto old = PowerPC::HostTryReadU16(address);
+        changed = !old || old->value != write.value;
+        if (changed)
+          PowerPC::HostTryWriteU16(write.value, address);
+        break;
+      }
+      default:
+      {
+        const auto old = PowerPC::HostTryReadU32(address);
+        changed = !old || old->value != write.value;
+        if (changed)
+          PowerPC::HostTryWriteU32(write.value, address);
+        break;
+      }
+      }
+
+      if (changed)
+        PowerPC::ppcState.iCache.Invalidate(address);
+    }
+  }
+}
+
 // Gecko needs to participate in the savestate system because the handler is embedded within the
 // game directly. The PC may be inside the code handler in the save state and the codehandler.bin
 // on the disk may be different resulting in the PC pointing at a different instruction and then
@@ -222,12 +314,17 @@ void DoState(PointerWrap& p)
   std::lock_guard codes_lock(s_active_codes_lock);
   p.Do(s_code_handler_installed);
   // FIXME: The active codes list will disagree with the embedded GCT
+
+  // The writes depend on the codes that are active now, not the ones in the save state.
+  if (p.IsReadMode() && s_code_handler_installed == Installation::Native)
+    s_code_handler_installed = Installation::Uninstalled;
 }
 
 void Shutdown()
 {
   std::lock_guard codes_lock(s_active_codes_lock);
   s_active_codes.clear();
+  s_native_writes.clear();
   s_code_handler_installed = Installation::Uninstalled;
 }
 
@@ -245,6 +342,16 @@ void RunCodeHandler()
       // fixed within 1 frame of the last error.
       if (s_active_codes.empty() || s_code_handler_installed == Installation::Failed)
         return;
+
+      // The writes can't fail, so holding the lock is fine.
+      if (s_code_handler_installed == Installation::Uninstalled && CompileNativeWritesLocked())
+        s_code_handler_installed = Installation::Native;
+      if (s_code_handler_installed == Installation::Native)
+      {
+        RunNativeWritesLocked();
+        return;
+      }
+
       s_code_handler_installed = InstallCodeHandlerLocked();
 
       // A warning was already issued for the install failing
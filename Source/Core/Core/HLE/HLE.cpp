@@ -6,6 +6,9 @@
 #include <algorithm>
 #include <array>
 #include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
@@ -26,7 +29,7 @@ namespace HLE
 static std::map<u32, u32> s_hooked_addresses;
 
 // clang-format off
-constexpr std::array<Hook, 23> os_patches{{
+constexpr std::array<Hook, 27> os_patches{{
     // Placeholder, os_patches[0] is the "non-existent function" index
     {"FAKE_TO_SKIP_0",               HLE_Misc::UnimplementedFunction,       HookType::Replace, HookFlag::Generic},
 
@@ -58,7 +61,13 @@ constexpr std::array<Hook, 23> os_patches{{
 
     {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HookType::Start,   HookFlag::Fixed},
     {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HookType::Replace, HookFlag::Fixed},
-    {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Fixed} // apploader needs OSReport-like function
+    {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Fixed}, // apploader needs OSReport-like function
+
+    // Memory functions of the SDK's C library
+    {"memcpy",                       HLE_Misc::Memcpy,                      HookType::Replace, HookFlag::FastPath},
+    {"memmove",                      HLE_Misc::Memmove,                     HookType::Replace, HookFlag::FastPath},
+    {"memset",                       HLE_Misc::Memset,                      HookType::Replace, HookFlag::FastPath},
+    {"__fill_mem",                   HLE_Misc::FillMem,                     HookType::Replace, HookFlag::FastPath},
 }};
 // clang-format on
 
@@ -117,21 +126,35 @@ void PatchFunctions()
     }
   }
 
+  // Fixed hooks don't map to symbols
+  std::map<std::string_view, u32> patch_indices;
   for (u32 i = 1; i < os_patches.size(); ++i)
   {
-    // Fixed hooks don't map to symbols
-    if (os_patches[i].flags == HookFlag::Fixed)
-      continue;
+    if (os_patches[i].flags != HookFlag::Fixed)
+      patch_indices.emplace(os_patches[i].name, i);
+  }
 
-    for (const auto& symbol : g_symbolDB.GetSymbolsFromName(os_patches[i].name))
+  // Go through the symbols only once, since games can come with tens of thousands of them.
+  std::vector<std::pair<u32, const Common::Symbol*>> matches;
+  for (const auto& [address, symbol] : g_symbolDB.Symbols())
+  {
+    const auto it = patch_indices.find(symbol.function_name);
+    if (it != patch_indices.end())
+      matches.emplace_back(it->second, &symbol);
+  }
+
+  // Apply the patches in table order, so that later ones still win where symbols overlap.
+  std::stable_sort(matches.begin(), matches.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  for (const auto& [i, symbol] : matches)
+  {
+    for (u32 addr = symbol->address; addr < symbol->address + symbol->size; addr += 4)
     {
-      for (u32 addr = symbol->address; addr < symbol->address + symbol->size; addr += 4)
-      {
-        s_hooked_addresses[addr] = i;
-        PowerPC::ppcState.iCache.Invalidate(addr);
-      }
-      INFO_LOG_FMT(OSHLE, "Patching {} {:08x}", os_patches[i].name, symbol->address);
+      s_hooked_addresses[addr] = i;
+      PowerPC::ppcState.iCache.Invalidate(addr);
     }
+    INFO_LOG_FMT(OSHLE, "Patching {} {:08x}", os_patches[i].name, symbol->address);
   }
 }
 
@@ -189,6 +212,9 @@ HookFlag GetHookFlagsByIndex(u32 index)
 
 bool IsEnabled(HookFlag flag)
 {
+  if (flag == HLE::HookFlag::FastPath)
+    return Config::Get(Config::MAIN_FAST_MEMORY_HLE);
+
   return flag != HLE::HookFlag::Debug || Config::Get(Config::MAIN_ENABLE_DEBUGGING) ||
          PowerPC::GetMode() == PowerPC::CoreMode::Interpreter;
 }
@@ -20,9 +20,10 @@ enum class HookType
 
 enum class HookFlag
 {
-  Generic,  // Miscellaneous function
-  Debug,    // Debug output function
-  Fixed,    // An arbitrary hook mapped to a fixed address instead of a symbol
+  Generic,   // Miscellaneous function
+  Debug,     // Debug output function
+  Fixed,     // An arbitrary hook mapped to a fixed address instead of a symbol
+  FastPath,  // Native replacement of a library function, enabled per game
 };
 
 struct Hook
@@ -3,16 +3,145 @@
 
 #include "Core/HLE/HLE_Misc.h"
 
+#include <cstring>
+#include <vector>
+
 #include "Common/Common.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
 #include "Core/Host.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PowerPC.h"
 
 namespace HLE_Misc
 {
+namespace
+{
+// Returns the host pointer and physical address of a range of guest memory, if it is mapped to
+// RAM by the BATs as one contiguous block and isn't covered by a memory check. Anything else goes
+// through the MMU one byte at a time, like the guest's own loop would.
+u8* GetRAMRange(u32 address, u32 size, u32* physical_address)
+{
+  if (size == 0 || address + (size - 1) < address)
+    return nullptr;
+
+  const u32 last = address + (size - 1);
+  u32 start = address;
+  bool wi;
+  if (!PowerPC::IsOptimizableRAMAddress(start) ||
+      !PowerPC::TranslateBatAddess(PowerPC::dbat_table, &start, &wi))
+  {
+    return nullptr;
+  }
+
+  for (u32 page = (address >> PowerPC::BAT_INDEX_SHIFT) + 1;
+       page <= (last >> PowerPC::BAT_INDEX_SHIFT); ++page)
+  {
+    const u32 page_address = page << PowerPC::BAT_INDEX_SHIFT;
+    u32 translated = page_address;
+    if (!PowerPC::IsOptimizableRAMAddress(page_address) ||
+        !PowerPC::TranslateBatAddess(PowerPC::dbat_table, &translated, &wi) ||
+        translated != start + (page_address - address))
+    {
+      return nullptr;
+    }
+  }
+
+  // Both ends have to be in the same region of RAM.
+  const u32 end = start + (size - 1);
+  const u32 segment = start >> 28;
+  if (segment != end >> 28)
+    return nullptr;
+  const bool in_mem1 = Memory::m_pRAM && segment == 0x0 && end < Memory::GetRamSizeReal();
+  const bool in_mem2 = Memory::m_pEXRAM && segment == 0x1 &&
+                       (end & 0x0FFFFFFF) < Memory::GetExRamSizeReal();
+  if (!in_mem1 && !in_mem2)
+    return nullptr;
+
+  *physical_address = start;
+  return Memory::GetPointer(start);
+}
+
+std::vector<u8> ReadThroughMMU(u32 address, u32 size)
+{
+  std::vector<u8> data(size);
+  for (u32 i = 0; i < size; ++i)
+    data[i] = PowerPC::HostRead_U8(address + i);
+  return data;
+}
+
+void WriteThroughMMU(u32 address, const std::vector<u8>& data)
+{
+  for (u32 i = 0; i < static_cast<u32>(data.size()); ++i)
+    PowerPC::HostWrite_U8(data[i], address + i);
+}
+
+// In the validation mode, the result of a fast path is compared with what byte accesses through
+// the MMU see, which is how the guest's implementation accesses memory.
+void Validate(const char* function, u32 dst, const std::vector<u8>& expected)
+{
+  if (ReadThroughMMU(dst, static_cast<u32>(expected.size())) != expected)
+  {
+    ERROR_LOG_FMT(OSHLE, "{}: Fast path mismatch writing {:#x} bytes to {:08x} (LR {:08x})",
+                  function, expected.size(), dst, LR);
+  }
+}
+
+// Copies between possibly overlapping ranges.
+void Move(const char* function, u32 dst, u32 src, u32 size)
+{
+  if (size == 0)
+    return;
+
+  const bool validate = Config::Get(Config::MAIN_VALIDATE_FAST_MEMORY_HLE);
+  std::vector<u8> expected;
+  if (validate)
+    expected = ReadThroughMMU(src, size);
+
+  u32 physical_dst, physical_src;
+  u8* const dst_ptr = GetRAMRange(dst, size, &physical_dst);
+  const u8* const src_ptr = GetRAMRange(src, size, &physical_src);
+  if (dst_ptr && src_ptr)
+  {
+    Memory::PrepareForHostRead(physical_src, size);
+    Memory::PrepareForHostWrite(physical_dst, size);
+    std::memmove(dst_ptr, src_ptr, size);
+  }
+  else
+  {
+    WriteThroughMMU(dst, validate ? expected : ReadThroughMMU(src, size));
+  }
+
+  if (validate)
+    Validate(function, dst, expected);
+}
+
+void Fill(const char* function, u32 dst, u8 value, u32 size)
+{
+  if (size == 0)
+    return;
+
+  u32 physical_dst;
+  if (u8* const dst_ptr = GetRAMRange(dst, size, &physical_dst))
+  {
+    Memory::PrepareForHostWrite(physical_dst, size);
+    std::memset(dst_ptr, value, size);
+  }
+  else
+  {
+    WriteThroughMMU(dst, std::vector<u8>(size, value));
+  }
+
+  if (Config::Get(Config::MAIN_VALIDATE_FAST_MEMORY_HLE))
+    Validate(function, dst, std::vector<u8>(size, value));
+}
+}  // namespace
+
 // If you just want to kill a function, one of the three following are usually appropriate.
 // According to the PPC ABI, the return value is always in r3.
 void UnimplementedFunction()
@@ -67,4 +196,32 @@ void GeckoReturnTrampoline()
                    PowerPC::HostRead_U64(SP + 24 + (2 * i + 1) * sizeof(u64)));
   }
 }
+
+// void* memcpy(void* dst, const void* src, size_t n)
+void Memcpy()
+{
+  Move("memcpy", GPR(3), GPR(4), GPR(5));
+  NPC = LR;
+}
+
+// void* memmove(void* dst, const void* src, size_t n)
+void Memmove()
+{
+  Move("memmove", GPR(3), GPR(4), GPR(5));
+  NPC = LR;
+}
+
+// void* memset(void* dst, int value, size_t n)
+void Memset()
+{
+  Fill("memset", GPR(3), static_cast<u8>(GPR(4)), GPR(5));
+  NPC = LR;
+}
+
+// void __fill_mem(void* dst, int value, size_t n)
+void FillMem()
+{
+  Fill("__fill_mem", GPR(3), static_cast<u8>(GPR(4)), GPR(5));
+  NPC = LR;
+}
 }  // namespace HLE_Misc
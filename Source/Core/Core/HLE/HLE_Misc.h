@@ -9,4 +9,11 @@ void UnimplementedFunction();
 void HBReload();
 void GeckoCodeHandlerICacheFlush();
 void GeckoReturnTrampoline();
+
+// Native versions of the C library's memory functions, which copy whole ranges of RAM at once
+// when the guest addresses allow it.
+void Memcpy();
+void Memmove();
+void Memset();
+void FillMem();
 }  // namespace HLE_Misc
@@ -163,7 +163,7 @@ void DoState(PointerWrap& p)
   auto& state = Core::System::GetInstance().GetDSPState().GetData();
 
   if (!state.aram.wii_mode)
-    p.DoArray(state.aram.ptr, state.aram.size);
+    p.DoStableArray(state.aram.ptr, state.aram.size);
   p.Do(state.dsp_control);
   p.Do(state.audio_dma);
   p.Do(state.aram_dma);
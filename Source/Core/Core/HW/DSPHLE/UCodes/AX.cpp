@@ -9,12 +9,14 @@
 #include <iterator>
 
 #include "Common/ChunkFile.h"
+#include "Common/Config/Config.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -27,6 +29,30 @@
 
 namespace DSP::HLE
 {
+AXVoiceWorkerPool::AXVoiceWorkerPool(u32 thread_count) : m_done(0, thread_count)
+{
+  for (u32 i = 1; i < thread_count; ++i)
+  {
+    m_workers.push_back(std::make_unique<Common::WorkQueueThread<u32>>([this](u32 job) {
+      (*m_job)(job);
+      m_done.Post();
+    }));
+  }
+}
+
+void AXVoiceWorkerPool::Run(u32 job_count, const std::function<void(u32)>& job)
+{
+  m_job = &job;
+  for (u32 i = 1; i < job_count; ++i)
+    m_workers[i - 1]->EmplaceItem(i);
+
+  job(0);
+
+  for (u32 i = 1; i < job_count; ++i)
+    m_done.Wait();
+  m_job = nullptr;
+}
+
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc)
 {
   INFO_LOG_FMT(DSPHLE, "Instantiating AXUCode: crc={:08x}", crc);
@@ -37,6 +63,10 @@ void AXUCode::Initialize()
   m_mail_handler.PushMail(DSP_INIT, true);
 
   LoadResamplingCoefficients(false, 0);
+
+  const int voice_threads = std::clamp(Config::Get(Config::MAIN_DSP_HLE_VOICE_THREADS), 1, 8);
+  if (voice_threads > 1)
+    m_voice_workers = std::make_unique<AXVoiceWorkerPool>(static_cast<u32>(voice_threads));
 }
 
 bool AXUCode::LoadResamplingCoefficients(bool require_same_checksum, u32 desired_checksum)
@@ -404,16 +434,11 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPB pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
-
-    ReadPB(pb_addr, pb, m_crc);
+  const AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
 
+  const auto process_pb = [this](AXPB& pb, AXBuffers pb_buffers) {
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
 
@@ -421,14 +446,35 @@ void AXUCode::ProcessPBList(u32 pb_addr)
     {
       ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
 
-      ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
+      ProcessVoice(pb, pb_buffers, spms, ConvertMixerControl(pb.mixer_control),
                    m_coeffs_checksum ? m_coeffs.data() : nullptr);
 
       // Forward the buffers
-      for (auto& ptr : buffers.ptrs)
+      for (auto& ptr : pb_buffers.ptrs)
         ptr += spms;
     }
+  };
 
+  if (m_voice_workers)
+  {
+    // Voice processing doesn't touch next_pb, so only the updates can change it.
+    const auto get_next_pb = [this](AXPB pb) {
+      u16* updates = (u16*)HLEMemory_Get_Pointer(HILO_TO_32(pb.updates.data));
+      for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+        ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
+      return HILO_TO_32(pb.next_pb);
+    };
+
+    if (ProcessPBListOnWorkers(*m_voice_workers, pb_addr, m_crc, buffers, get_next_pb, process_pb))
+      return;
+  }
+
+  AXPB pb;
+
+  while (pb_addr)
+  {
+    ReadPB(pb_addr, pb, m_crc);
+    process_pb(pb, buffers);
     WritePB(pb_addr, pb, m_crc);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
@@ -12,11 +12,16 @@
 #pragma once
 
 #include <array>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
+#include "Common/Semaphore.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 #include "Core/HW/Memmap.h"
 
@@ -62,6 +67,25 @@ enum AXMixControl
   // clang-format on
 };
 
+// A small pool of threads that voices can be processed on. The thread calling Run always takes
+// the first job itself, so a pool with a thread count of N only starts N - 1 threads.
+class AXVoiceWorkerPool
+{
+public:
+  explicit AXVoiceWorkerPool(u32 thread_count);
+
+  u32 GetThreadCount() const { return static_cast<u32>(m_workers.size()) + 1; }
+
+  // Calls job(i) for every i in [0, job_count) and waits for all of them to finish.
+  // job_count must not exceed GetThreadCount().
+  void Run(u32 job_count, const std::function<void(u32)>& job);
+
+private:
+  Common::Semaphore m_done;
+  const std::function<void(u32)>* m_job = nullptr;
+  std::vector<std::unique_ptr<Common::WorkQueueThread<u32>>> m_workers;
+};
+
 class AXUCode /* not final: subclassed by AXWiiUCode */ : public UCodeInterface
 {
 public:
@@ -99,6 +123,9 @@ protected:
 
   u16 m_compressor_pos = 0;
 
+  // Only set when voices should be processed on several threads.
+  std::unique_ptr<AXVoiceWorkerPool> m_voice_workers;
+
   bool LoadResamplingCoefficients(bool require_same_checksum, u32 desired_checksum);
 
   // Copy a command list from memory to our temp buffer
@@ -12,8 +12,17 @@
 #endif
 
 #include <algorithm>
-#include <functional>
+#include <array>
+#include <cstring>
 #include <memory>
+#include <numeric>
+#include <vector>
+
+#ifdef _M_X86_64
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
 
 #include "Common/CommonTypes.h"
 #include "Core/DSP/DSPAccelerator.h"
@@ -145,8 +154,8 @@ void WritePB(u32 addr, const PB_TYPE& pb, u32 crc)
   }
 }
 
-// Simulated accelerator state.
-static PB_TYPE* acc_pb;
+// Simulated accelerator state. Each thread processing voices has its own.
+static thread_local PB_TYPE* acc_pb;
 
 class HLEAccelerator final : public Accelerator
 {
@@ -184,7 +193,8 @@ protected:
   void WriteMemory(u32 address, u8 value) override { WriteARAM(value, address); }
 };
 
-static std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
+static thread_local std::unique_ptr<Accelerator> s_accelerator =
+    std::make_unique<HLEAccelerator>();
 
 // Sets up the simulated accelerator.
 void AcceleratorSetup(PB_TYPE* pb)
@@ -227,7 +237,8 @@ u16 AcceleratorGetSample()
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
+template <typename InputCallback>
+u32 ResampleAudio(const InputCallback& input_callback, s16* output, u32 count, s16* last_samples,
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
   int read_samples_count = 0;
@@ -246,11 +257,9 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
     for (u32 i = 0; i < count; ++i)
     {
       curr_pos += ratio;
-      while (curr_pos >= 0x10000)
-      {
+      for (u32 j = curr_pos >> 16; j != 0; --j)
         temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
+      curr_pos &= 0xFFFF;
 
       u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
       const s16* c = &coeffs[curr_pos_frac];
@@ -289,11 +298,9 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
 
       // While our current position is >= 1.0, push new samples to the
       // circular buffer.
-      while (curr_pos >= 0x10000)
-      {
+      for (u32 j = curr_pos >> 16; j != 0; --j)
         temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
+      curr_pos &= 0xFFFF;
 
       // Get our current fractional position, used to know how much of
       // curr0 and how much of curr1 the output sample should be.
@@ -339,6 +346,22 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
   return curr_pos;
 }
 
+// Returns how many input samples ResampleAudio will consume to produce <count>
+// output samples with the given parameters.
+u32 GetResampleInputCount(u32 count, u32 curr_pos, u32 ratio, int srctype)
+{
+  if (srctype != SRCTYPE_LINEAR && srctype != SRCTYPE_POLYPHASE)
+    return count;
+
+  u32 input_count = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    curr_pos = (curr_pos & 0xFFFF) + ratio;
+    input_count += curr_pos >> 16;
+  }
+  return input_count;
+}
+
 // Read <count> input samples from ARAM, decoding and converting rate
 // if required.
 void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
@@ -347,9 +370,30 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+
+  const u32 ratio = HILO_TO_32(pb.src.ratio);
+  const u32 input_count = GetResampleInputCount(count, pb.src.cur_addr_frac, ratio, pb.src_type);
+
+  // The accelerator state only depends on how many samples have been read, so
+  // decode everything the resampler needs in one go. This keeps the decoder
+  // loop tight and lets the resampler work from a plain buffer. Very high
+  // ratios fall back to decoding on demand.
+  constexpr u32 MAX_INPUT_BLOCK = MAX_SAMPLES_PER_FRAME * 8;
+  u32 curr_pos;
+  if (input_count <= MAX_INPUT_BLOCK)
+  {
+    std::array<s16, MAX_INPUT_BLOCK> block;
+    s_accelerator->ReadSamples(acc_pb->adpcm.coefs, block.data(), input_count);
+
+    curr_pos = ResampleAudio([&block](u32 i) { return block[i]; }, samples, count,
+                             pb.src.last_samples, pb.src.cur_addr_frac, ratio, pb.src_type, coeffs);
+  }
+  else
+  {
+    curr_pos = ResampleAudio([](u32) { return static_cast<s16>(AcceleratorGetSample()); }, samples,
+                             count, pb.src.last_samples, pb.src.cur_addr_frac, ratio, pb.src_type,
+                             coeffs);
+  }
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -372,7 +416,81 @@ void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bo
   if (!ramp)
     volume_delta = 0;
 
-  for (u32 i = 0; i < count; ++i)
+  u32 i = 0;
+
+  // The vector paths below produce exactly the same results as the scalar
+  // loop: the product of a s16 sample and a u16 volume always fits in 32 bits,
+  // and each lane computes its own volume as volume + k * volume_delta.
+#if defined(_M_X86_64)
+  if (count >= 8)
+  {
+    const __m128i step = _mm_mullo_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7),
+                                         _mm_set1_epi16(static_cast<s16>(volume_delta)));
+    const __m128i step8 = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+    const __m128i min_sample = _mm_set1_epi16(-32767);
+    __m128i volumes = _mm_add_epi16(_mm_set1_epi16(static_cast<s16>(volume)), step);
+    __m128i last = _mm_setzero_si128();
+
+    for (; i + 8 <= count; i += 8)
+    {
+      const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+
+      // Signed * unsigned 16-bit multiply: the low halves match, the unsigned
+      // high halves need the volume subtracted where the sample is negative.
+      const __m128i lo = _mm_mullo_epi16(in, volumes);
+      const __m128i hi = _mm_sub_epi16(_mm_mulhi_epu16(in, volumes),
+                                       _mm_and_si128(_mm_srai_epi16(in, 15), volumes));
+      const __m128i prod_lo = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+      const __m128i prod_hi = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+      last = _mm_max_epi16(_mm_packs_epi32(prod_lo, prod_hi), min_sample);
+
+      __m128i* out_vec = reinterpret_cast<__m128i*>(out + i);
+      const __m128i out_lo = _mm_srai_epi32(_mm_unpacklo_epi16(last, last), 16);
+      const __m128i out_hi = _mm_srai_epi32(_mm_unpackhi_epi16(last, last), 16);
+      _mm_storeu_si128(out_vec, _mm_add_epi32(_mm_loadu_si128(out_vec), out_lo));
+      _mm_storeu_si128(out_vec + 1, _mm_add_epi32(_mm_loadu_si128(out_vec + 1), out_hi));
+
+      volumes = _mm_add_epi16(volumes, step8);
+    }
+
+    volume = static_cast<u16>(_mm_cvtsi128_si32(volumes));
+    *dpop = static_cast<s16>(_mm_extract_epi16(last, 7));
+  }
+#elif defined(_M_ARM_64)
+  if (count >= 8)
+  {
+    static constexpr u16 lane_index[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    const uint16x8_t step = vmulq_n_u16(vld1q_u16(lane_index), volume_delta);
+    const uint16x8_t step8 = vdupq_n_u16(static_cast<u16>(volume_delta * 8));
+    const int16x8_t min_sample = vdupq_n_s16(-32767);
+    uint16x8_t volumes = vaddq_u16(vdupq_n_u16(volume), step);
+    int16x8_t last = vdupq_n_s16(0);
+
+    for (; i + 8 <= count; i += 8)
+    {
+      const int16x8_t in = vld1q_s16(input + i);
+      const int32x4_t prod_lo =
+          vmulq_s32(vmovl_s16(vget_low_s16(in)),
+                    vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(volumes))));
+      const int32x4_t prod_hi =
+          vmulq_s32(vmovl_s16(vget_high_s16(in)),
+                    vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(volumes))));
+      last = vmaxq_s16(vcombine_s16(vqmovn_s32(vshrq_n_s32(prod_lo, 15)),
+                                    vqmovn_s32(vshrq_n_s32(prod_hi, 15))),
+                       min_sample);
+
+      vst1q_s32(out + i, vaddw_s16(vld1q_s32(out + i), vget_low_s16(last)));
+      vst1q_s32(out + i + 4, vaddw_s16(vld1q_s32(out + i + 4), vget_high_s16(last)));
+
+      volumes = vaddq_u16(volumes, step8);
+    }
+
+    volume = vgetq_lane_u16(volumes, 0);
+    *dpop = vgetq_lane_s16(last, 7);
+  }
+#endif
+
+  for (; i < count; ++i)
   {
     s64 sample = input[i];
     sample *= volume;
@@ -555,6 +673,101 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #endif
 }
 
+// Number of samples in each of the buffers of an AXBuffers.
+#ifdef AX_GC
+constexpr std::array<u32, 9> AX_BUFFER_SIZES = {160, 160, 160, 160, 160, 160, 160, 160, 160};
+#else
+constexpr std::array<u32, 20> AX_BUFFER_SIZES = {96, 96, 96, 96, 96, 96, 96, 96, 96, 96,
+                                                 96, 96, 18, 18, 18, 18, 18, 18, 18, 18};
+#endif
+
+// Processes the PBs of a list on the threads of a worker pool.
+//
+// All PBs are read on the calling thread first. <get_next_pb> must return the address of the next
+// PB as it will be once <process_pb> has run on a copy of the PB. Every worker then processes a
+// contiguous range of the list, mixing into its own set of buffers, and the calling thread adds
+// those to <buffers> and writes the PBs back in list order. Integer addition is associative, so
+// the output does not depend on how the list was split nor on thread timing.
+//
+// Returns false without modifying anything if the list is too short to be worth splitting, or if
+// PBs overlap in memory (in which case processing them out of order could change the result).
+template <typename GetNextPB, typename ProcessPB>
+bool ProcessPBListOnWorkers(AXVoiceWorkerPool& workers, u32 pb_addr, u32 crc,
+                            const AXBuffers& buffers, const GetNextPB& get_next_pb,
+                            const ProcessPB& process_pb)
+{
+  // Below this many voices per thread, handing out the work costs more than it saves.
+  constexpr size_t MIN_VOICES_PER_THREAD = 8;
+  // Guards against PB lists which loop back on themselves.
+  constexpr size_t MAX_VOICES = 0x1000;
+
+  std::vector<u32> addresses;
+  std::vector<PB_TYPE> pbs;
+  while (pb_addr)
+  {
+    if (pbs.size() == MAX_VOICES)
+      return false;
+
+    PB_TYPE& pb = pbs.emplace_back();
+    ReadPB(pb_addr, pb, crc);
+    addresses.push_back(pb_addr);
+    pb_addr = get_next_pb(pb);
+  }
+
+  const u32 job_count = static_cast<u32>(
+      std::min<size_t>(workers.GetThreadCount(), pbs.size() / MIN_VOICES_PER_THREAD));
+  if (job_count < 2)
+    return false;
+
+  std::vector<u32> sorted_addresses = addresses;
+  std::sort(sorted_addresses.begin(), sorted_addresses.end());
+  for (size_t i = 1; i < sorted_addresses.size(); ++i)
+  {
+    if (sorted_addresses[i] - sorted_addresses[i - 1] < sizeof(PB_TYPE))
+      return false;
+  }
+
+  // The first job mixes straight into the output buffers, the others into scratch buffers.
+  constexpr u32 total_buffer_size =
+      std::accumulate(AX_BUFFER_SIZES.begin(), AX_BUFFER_SIZES.end(), u32(0));
+  std::vector<int> scratch((job_count - 1) * total_buffer_size);
+
+  workers.Run(job_count, [&](u32 job) {
+    const size_t first = pbs.size() * job / job_count;
+    const size_t last = pbs.size() * (job + 1) / job_count;
+
+    AXBuffers job_buffers = buffers;
+    if (job != 0)
+    {
+      int* ptr = scratch.data() + (job - 1) * total_buffer_size;
+      for (size_t i = 0; i < AX_BUFFER_SIZES.size(); ++i)
+      {
+        job_buffers.ptrs[i] = ptr;
+        ptr += AX_BUFFER_SIZES[i];
+      }
+    }
+
+    for (size_t i = first; i < last; ++i)
+      process_pb(pbs[i], job_buffers);
+  });
+
+  const int* src = scratch.data();
+  for (u32 job = 1; job < job_count; ++job)
+  {
+    for (size_t i = 0; i < AX_BUFFER_SIZES.size(); ++i)
+    {
+      for (u32 j = 0; j < AX_BUFFER_SIZES[i]; ++j)
+        buffers.ptrs[i][j] += src[j];
+      src += AX_BUFFER_SIZES[i];
+    }
+  }
+
+  for (size_t i = 0; i < pbs.size(); ++i)
+    WritePB(addresses[i], pbs[i], crc);
+
+  return true;
+}
+
 }  // namespace
 }  // inline namespace AXGC/AXWii
 }  // namespace DSP::HLE
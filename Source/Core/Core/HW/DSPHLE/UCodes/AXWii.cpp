@@ -414,20 +414,15 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPBWii pb;
-
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
-                          m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
-                          m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
-                          m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
-
-    ReadPB(pb_addr, pb, m_crc);
-
+  const AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                              m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                              m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                              m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                              m_samples_wm3,       m_samples_aux3}};
+
+  const auto process_pb = [this](AXPBWii& pb, AXBuffers pb_buffers) {
     u16 num_updates[3];
     u16 updates[1024];
     u32 updates_addr;
@@ -436,21 +431,48 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
       for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
       {
         ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
-        ProcessVoice(pb, buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+        ProcessVoice(pb, pb_buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                      m_coeffs_checksum ? m_coeffs.data() : nullptr);
 
         // Forward the buffers
-        for (auto& ptr : buffers.ptrs)
+        for (auto& ptr : pb_buffers.ptrs)
           ptr += spms;
       }
       ReinjectUpdatesFields(pb, num_updates, updates_addr);
     }
     else
     {
-      ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+      ProcessVoice(pb, pb_buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                    m_coeffs_checksum ? m_coeffs.data() : nullptr);
     }
+  };
+
+  if (m_voice_workers)
+  {
+    // Voice processing doesn't touch next_pb, so only the updates can change it.
+    const auto get_next_pb = [this](AXPBWii pb) {
+      u16 num_updates[3];
+      u16 updates[1024];
+      u32 updates_addr;
+      if (ExtractUpdatesFields(pb, num_updates, updates, &updates_addr))
+      {
+        for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
+          ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
+        ReinjectUpdatesFields(pb, num_updates, updates_addr);
+      }
+      return HILO_TO_32(pb.next_pb);
+    };
+
+    if (ProcessPBListOnWorkers(*m_voice_workers, pb_addr, m_crc, buffers, get_next_pb, process_pb))
+      return;
+  }
 
+  AXPBWii pb;
+
+  while (pb_addr)
+  {
+    ReadPB(pb_addr, pb, m_crc);
+    process_pb(pb, buffers);
     WritePB(pb_addr, pb, m_crc);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
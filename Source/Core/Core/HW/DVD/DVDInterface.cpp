@@ -1390,16 +1390,18 @@ void SetDriveError(DriveError error)
 }
 
 void FinishExecutingCommand(ReplyType reply_type, DIInterruptType interrupt_type, s64 cycles_late,
-                            const std::vector<u8>& data)
+                            u32 read_length, const std::vector<u8>& data)
 {
   auto& state = Core::System::GetInstance().GetDVDInterfaceState().GetData();
 
-  // The data parameter contains the requested data iff this was called from DVDThread, and is
+  // The read_length parameter is the number of bytes successfully read iff this was called from
+  // DVDThread, and is 0 otherwise. The data parameter contains the requested data iff this was
+  // called from DVDThread and the data wasn't copied to emulated RAM directly from the disc, and is
   // empty otherwise. DVDThread is the only source of ReplyType::NoReply and ReplyType::DTK.
 
   u32 transfer_size = 0;
   if (reply_type == ReplyType::NoReply)
-    transfer_size = static_cast<u32>(data.size());
+    transfer_size = read_length;
   else if (reply_type == ReplyType::Interrupt || reply_type == ReplyType::IOS)
     transfer_size = state.DILENGTH;
 
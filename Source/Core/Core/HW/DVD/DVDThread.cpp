@@ -3,6 +3,8 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -21,10 +23,12 @@
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DVD/DVDInterface.h"
+#include "Core/HW/DVD/DiscAccessTrace.h"
 #include "Core/HW/DVD/FileMonitor.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
@@ -39,6 +43,10 @@ namespace DVDThread
 struct ReadRequest
 {
   bool copy_to_ram = false;
+  // Set by the DVD thread when FinishRead will copy the data to emulated RAM straight from the
+  // disc's direct view instead of from the result buffer. Never true in savestates. (It occupies
+  // what used to be padding, so that the savestate format doesn't change.)
+  bool read_directly = false;
   u32 output_address = 0;
   u64 dvd_offset = 0;
   u32 length = 0;
@@ -62,11 +70,37 @@ struct ReadRequest
 
 using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+// Data that the DVD thread read while it had nothing else to do,
+// in the hope that the emulated software would ask for it next
+struct ReadAheadBuffer
+{
+  u64 dvd_offset = 0;
+  DiscIO::Partition partition{};
+  std::vector<u8> data;
+
+  bool Contains(u64 offset, u64 length, const DiscIO::Partition& partition_) const
+  {
+    return partition == partition_ && offset >= dvd_offset &&
+           offset + length <= dvd_offset + data.size();
+  }
+};
+
+// The smallest amount of data to read ahead. Reading less would make the latency of each read
+// dominate on slow storage (network shares in particular), where read-ahead matters the most.
+constexpr u64 MIN_READ_AHEAD_SIZE = 0x40000;
+constexpr u64 MAX_READ_AHEAD_SIZE = 0x400000;
+
 static void StartDVDThread(DVDThreadState::Data& state);
 static void StopDVDThread(DVDThreadState::Data& state);
 
 static void DVDThread();
 static void WaitUntilIdle();
+static void ResolveDirectReads(DVDThreadState::Data& state);
+
+static bool ReadDisc(DVDThreadState::Data& state, u64 dvd_offset, u32 length, u8* buffer,
+                     const DiscIO::Partition& partition);
+static void ReadAhead(DVDThreadState::Data& state, u64 dvd_offset, u32 length,
+                      const DiscIO::Partition& partition);
 
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
@@ -91,6 +125,10 @@ struct DVDThreadState::Data
 
   std::unique_ptr<DiscIO::Volume> disc;
 
+  // Only used by the DVD thread, or by the CPU thread while the DVD thread is stopped
+  ReadAheadBuffer read_ahead;
+  DiscAccessTrace access_trace;
+
   FileMonitor::FileLogger file_logger;
 };
 
@@ -130,6 +168,8 @@ void Stop()
   auto& state = Core::System::GetInstance().GetDVDThreadState().GetData();
   StopDVDThread(state);
   state.disc.reset();
+  state.read_ahead.data.clear();
+  state.access_trace.Save();
 }
 
 static void StopDVDThread(DVDThreadState::Data& state)
@@ -154,15 +194,20 @@ void DoState(PointerWrap& p)
   // won't be touching anything while this function runs.
   WaitUntilIdle();
 
-  // Move all results from result_queue to result_map because
-  // PointerWrap::Do supports std::map but not Common::SPSCQueue.
+  // Results which refer to the direct view of the disc are turned into normal results,
+  // since the disc isn't savestated. This also moves all results from result_queue to result_map,
+  // because PointerWrap::Do supports std::map but not Common::SPSCQueue.
   // This won't affect the behavior of FinishRead.
-  ReadResult result;
-  while (state.result_queue.Pop(result))
-    state.result_map.emplace(result.first.id, std::move(result));
+  ResolveDirectReads(state);
 
   // Both queues are now empty, so we don't need to savestate them.
   p.Do(state.result_map);
+  if (p.IsReadMode())
+  {
+    // Older savestates have undefined padding where read_directly is
+    for (auto& [id, result] : state.result_map)
+      result.first.read_directly = false;
+  }
   p.Do(state.next_id);
 
   // state.disc isn't savestated (because it points to files on the
@@ -196,7 +241,13 @@ void SetDisc(std::unique_ptr<DiscIO::Volume> disc)
   auto& state = Core::System::GetInstance().GetDVDThreadState().GetData();
 
   WaitUntilIdle();
+  ResolveDirectReads(state);
   state.disc = std::move(disc);
+  state.read_ahead.data.clear();
+
+  state.access_trace.Save();
+  if (state.disc && Config::Get(Config::MAIN_DISC_ACCESS_TRACES))
+    state.access_trace.Load(*state.disc);
 }
 
 bool HasDisc()
@@ -285,6 +336,29 @@ void WaitUntilIdle()
   StartDVDThread(state);
 }
 
+static void ResolveDirectReads(DVDThreadState::Data& state)
+{
+  ReadResult result;
+  while (state.result_queue.Pop(result))
+    state.result_map.emplace(result.first.id, std::move(result));
+
+  for (auto& [id, map_result] : state.result_map)
+  {
+    ReadRequest& request = map_result.first;
+    std::vector<u8>& buffer = map_result.second;
+    if (!request.read_directly)
+      continue;
+
+    request.read_directly = false;
+    buffer.resize(request.length);
+    if (!state.disc || !state.disc->Read(request.dvd_offset, request.length, buffer.data(),
+                                         request.partition))
+    {
+      buffer.resize(0);
+    }
+  }
+}
+
 void StartRead(u64 dvd_offset, u32 length, const DiscIO::Partition& partition,
                DVDInterface::ReplyType reply_type, s64 ticks_until_completion)
 {
@@ -376,8 +450,19 @@ static void FinishRead(u64 id, s64 cycles_late)
                 (CoreTiming::GetTicks() - request.time_started_ticks) /
                     (SystemTimers::GetTicksPerSecond() / 1000000));
 
+  const u8* data = nullptr;
+  if (request.read_directly)
+  {
+    if (state.disc)
+      data = state.disc->GetDirectView(request.dvd_offset, request.length, request.partition);
+  }
+  else if (buffer.size() == request.length)
+  {
+    data = buffer.data();
+  }
+
   DVDInterface::DIInterruptType interrupt;
-  if (buffer.size() != request.length)
+  if (!data)
   {
     PanicAlertFmtT("The disc could not be read (at {0:#x} - {1:#x}).", request.dvd_offset,
                    request.dvd_offset + request.length);
@@ -388,13 +473,14 @@ static void FinishRead(u64 id, s64 cycles_late)
   else
   {
     if (request.copy_to_ram)
-      Memory::CopyToEmu(request.output_address, buffer.data(), request.length);
+      Memory::CopyToEmu(request.output_address, data, request.length);
 
     interrupt = DVDInterface::DIInterruptType::TCINT;
   }
 
   // Notify the emulated software that the command has been executed
-  DVDInterface::FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
+  DVDInterface::FinishExecutingCommand(request.reply_type, interrupt, cycles_late,
+                                       data ? request.length : 0, buffer);
 }
 
 static void DVDThread()
@@ -410,23 +496,90 @@ static void DVDThread()
     if (state.dvd_thread_exiting.IsSet())
       return;
 
+    std::optional<ReadRequest> last_request;
     ReadRequest request;
     while (state.request_queue.Pop(request))
     {
       state.file_logger.Log(*state.disc, request.partition, request.dvd_offset);
-
-      std::vector<u8> buffer(request.length);
-      if (!state.disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+      state.access_trace.Record(request.partition, request.dvd_offset, request.length,
+                                request.time_started_ticks);
+
+      // Data that is copied to emulated RAM and is in memory already (such as with a memory-mapped
+      // ISO) is copied straight from there by FinishRead, without going through a buffer.
+      std::vector<u8> buffer;
+      if (request.copy_to_ram &&
+          state.disc->GetDirectView(request.dvd_offset, request.length, request.partition))
+      {
+        request.read_directly = true;
+      }
+      else
+      {
+        buffer.resize(request.length);
+        if (!ReadDisc(state, request.dvd_offset, request.length, buffer.data(),
+                      request.partition))
+        {
+          buffer.resize(0);
+        }
+      }
 
       request.realtime_done_us = Common::Timer::NowUs();
 
+      last_request = request;
       state.result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
       state.result_queue_expanded.Set();
 
       if (state.dvd_thread_exiting.IsSet())
         return;
     }
+
+    // The request queue is empty, so use the idle time to read the data that the last request
+    // was followed by in an earlier session, or else the data that follows it on the disc.
+    // If a new request comes in meanwhile, request_queue_expanded stays set until the next
+    // iteration, so the new request only has to wait for this one read to finish.
+    if (last_request && state.disc)
+    {
+      const std::optional<DiscAccessTrace::Region> prediction =
+          state.access_trace.Predict(last_request->partition, last_request->dvd_offset);
+      if (prediction)
+        ReadAhead(state, prediction->offset, prediction->length, prediction->partition);
+      else
+        ReadAhead(state, last_request->dvd_offset + last_request->length, last_request->length,
+                  last_request->partition);
+    }
+  }
+}
+
+static bool ReadDisc(DVDThreadState::Data& state, u64 dvd_offset, u32 length, u8* buffer,
+                     const DiscIO::Partition& partition)
+{
+  if (state.read_ahead.Contains(dvd_offset, length, partition))
+  {
+    std::memcpy(buffer, state.read_ahead.data.data() + (dvd_offset - state.read_ahead.dvd_offset),
+                length);
+    return true;
   }
+
+  return state.disc->Read(dvd_offset, length, buffer, partition);
+}
+
+static void ReadAhead(DVDThreadState::Data& state, u64 dvd_offset, u32 length,
+                      const DiscIO::Partition& partition)
+{
+  // Nothing to do if the next read of the same size would already be served from the buffer
+  if (state.read_ahead.Contains(dvd_offset, length, partition))
+    return;
+
+  const u64 size = std::clamp<u64>(length, MIN_READ_AHEAD_SIZE, MAX_READ_AHEAD_SIZE);
+
+  state.read_ahead.data.resize(size);
+  if (!state.disc->Read(dvd_offset, size, state.read_ahead.data.data(), partition))
+  {
+    // Most likely the end of the disc or partition. This isn't an error, since it's only a guess.
+    state.read_ahead.data.clear();
+    return;
+  }
+
+  state.read_ahead.dvd_offset = dvd_offset;
+  state.read_ahead.partition = partition;
 }
 }  // namespace DVDThread
@@ -0,0 +1,142 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/DiscAccessTrace.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace
+{
+constexpr u32 TRACE_FILE_MAGIC = 0x43524454;  // TDRC
+constexpr u32 TRACE_FILE_VERSION = 1;
+
+#pragma pack(push, 1)
+struct TraceFileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 num_entries;
+};
+
+struct TraceFileEntry
+{
+  u64 partition;
+  u64 offset;
+  u32 length;
+  u64 ticks;
+};
+#pragma pack(pop)
+}  // namespace
+
+namespace DVDThread
+{
+std::string DiscAccessTrace::GetTracePath() const
+{
+  return fmt::format("{}{}_r{}_d{}.disctrace", File::GetUserPath(D_CACHE_IDX), m_game_id,
+                     m_revision, m_disc_number);
+}
+
+void DiscAccessTrace::Load(const DiscIO::Volume& disc)
+{
+  if (m_loaded)
+    Save();
+
+  m_game_id = disc.GetGameID();
+  m_revision = disc.GetRevision().value_or(0);
+  m_disc_number = disc.GetDiscNumber().value_or(0);
+  if (m_game_id.empty())
+    return;
+  m_loaded = true;
+
+  File::IOFile file(GetTracePath(), "rb");
+  TraceFileHeader header;
+  if (!file.ReadBytes(&header, sizeof(header)))
+    return;
+
+  if (header.magic != TRACE_FILE_MAGIC || header.version != TRACE_FILE_VERSION)
+  {
+    INFO_LOG_FMT(DVDINTERFACE, "Discarding outdated disc access trace for {}", m_game_id);
+    return;
+  }
+
+  std::vector<TraceFileEntry> file_entries(std::min<size_t>(header.num_entries, MAX_ENTRIES));
+  if (!file.ReadArray(file_entries.data(), file_entries.size()))
+    return;
+
+  std::optional<Region> previous;
+  for (const TraceFileEntry& file_entry : file_entries)
+  {
+    const Region region{DiscIO::Partition(file_entry.partition), file_entry.offset,
+                        file_entry.length};
+    if (previous)
+      m_successors.insert_or_assign({previous->partition.offset, previous->offset}, region);
+    previous = region;
+  }
+  m_loaded_entry_count = file_entries.size();
+
+  INFO_LOG_FMT(DVDINTERFACE, "Loaded {} reads from the disc access trace for {}",
+               m_loaded_entry_count, m_game_id);
+}
+
+void DiscAccessTrace::Save()
+{
+  if (!m_loaded)
+    return;
+
+  // A short session (such as booting a game only to check something) would otherwise replace
+  // the trace of a whole play session, so the longer of the two traces is kept.
+  if (m_recorded_entries.size() > m_loaded_entry_count)
+  {
+    File::IOFile file(GetTracePath(), "wb");
+    const TraceFileHeader header{TRACE_FILE_MAGIC, TRACE_FILE_VERSION,
+                                 static_cast<u32>(m_recorded_entries.size())};
+    bool success = file.WriteBytes(&header, sizeof(header));
+    for (const Entry& entry : m_recorded_entries)
+    {
+      const TraceFileEntry file_entry{entry.region.partition.offset, entry.region.offset,
+                                      entry.region.length, entry.ticks};
+      success &= file.WriteBytes(&file_entry, sizeof(file_entry));
+    }
+
+    if (!success)
+      WARN_LOG_FMT(DVDINTERFACE, "Failed to write disc access trace to {}", GetTracePath());
+  }
+
+  m_loaded = false;
+  m_loaded_entry_count = 0;
+  m_successors.clear();
+  m_recorded_entries.clear();
+}
+
+void DiscAccessTrace::Record(const DiscIO::Partition& partition, u64 offset, u32 length,
+                             u64 ticks)
+{
+  if (!m_loaded || m_recorded_entries.size() >= MAX_ENTRIES)
+    return;
+
+  if (m_recorded_entries.empty())
+    m_first_ticks = ticks;
+
+  m_recorded_entries.push_back({{partition, offset, length}, ticks - m_first_ticks});
+}
+
+std::optional<DiscAccessTrace::Region>
+DiscAccessTrace::Predict(const DiscIO::Partition& partition, u64 offset) const
+{
+  const auto it = m_successors.find({partition.offset, offset});
+  if (it == m_successors.end())
+    return std::nullopt;
+
+  return it->second;
+}
+}  // namespace DVDThread
@@ -0,0 +1,65 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Volume.h"
+
+namespace DVDThread
+{
+// Records the disc reads a title makes, so that the next time the same title runs, the DVD thread
+// can read the data a request was followed by last time before the game asks for it.
+class DiscAccessTrace
+{
+public:
+  struct Region
+  {
+    DiscIO::Partition partition;
+    u64 offset;
+    u32 length;
+  };
+
+  // Loads the trace of the given disc and starts recording a new one. Any trace which was being
+  // recorded is saved first.
+  void Load(const DiscIO::Volume& disc);
+  void Save();
+
+  bool IsLoaded() const { return m_loaded; }
+
+  void Record(const DiscIO::Partition& partition, u64 offset, u32 length, u64 ticks);
+
+  // Returns the read which followed a read at the given offset in the loaded trace
+  std::optional<Region> Predict(const DiscIO::Partition& partition, u64 offset) const;
+
+private:
+  struct Entry
+  {
+    Region region;
+    // Emulated time of the read, relative to the first read of the trace
+    u64 ticks;
+  };
+
+  // Keeps a long play session from using an unbounded amount of memory and disk space
+  static constexpr size_t MAX_ENTRIES = 0x100000;
+
+  std::string GetTracePath() const;
+
+  bool m_loaded = false;
+  std::string m_game_id;
+  u16 m_revision = 0;
+  u8 m_disc_number = 0;
+
+  size_t m_loaded_entry_count = 0;
+  std::map<std::pair<u64, u64>, Region> m_successors;
+
+  std::vector<Entry> m_recorded_entries;
+  u64 m_first_ticks = 0;
+};
+}  // namespace DVDThread
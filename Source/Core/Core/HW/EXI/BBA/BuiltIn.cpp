@@ -95,6 +95,9 @@ bool CEXIETHERNET::BuiltInBBAInterface::Activate()
   m_upnp_httpd.listen(Common::SSDP_PORT, sf::IpAddress(ip));
   m_upnp_httpd.setBlocking(false);
 
+  m_wakeup_socket.bind(sf::Socket::AnyPort, sf::IpAddress::LocalHost);
+  m_wakeup_socket.setBlocking(false);
+
   return RecvInit();
 }
 
@@ -106,6 +109,7 @@ void CEXIETHERNET::BuiltInBBAInterface::Deactivate()
   // Signal read thread to exit.
   m_read_enabled.Clear();
   m_read_thread_shutdown.Set();
+  WakeReadThread();
   m_active = false;
 
   // kill all active socket
@@ -124,6 +128,7 @@ void CEXIETHERNET::BuiltInBBAInterface::Deactivate()
   // Wait for read thread to exit.
   if (m_read_thread.joinable())
     m_read_thread.join();
+  m_wakeup_socket.unbind();
 }
 
 bool CEXIETHERNET::BuiltInBBAInterface::IsActivated()
@@ -662,20 +667,79 @@ bool CEXIETHERNET::BuiltInBBAInterface::SendFrame(const u8* frame, u32 size)
     return false;
   }
 
+  // The frame may have queued a reply or opened a socket.
+  WakeReadThread();
   m_eth_ref->SendComplete();
   return true;
 }
 
+void CEXIETHERNET::BuiltInBBAInterface::WakeReadThread()
+{
+  const u8 wakeup = 0;
+  m_wakeup_socket.send(&wakeup, sizeof(wakeup), sf::IpAddress::LocalHost,
+                       m_wakeup_socket.getLocalPort());
+}
+
+// Blocks until a socket has data, WakeReadThread is called or the TCP timers may have run out.
+// Returns whether a socket had data.
+bool CEXIETHERNET::BuiltInBBAInterface::WaitForNetworkActivity()
+{
+  sf::SocketSelector selector;
+  selector.add(m_wakeup_socket);
+  if (m_read_enabled.IsSet())
+  {
+    std::lock_guard<std::mutex> lock(m_mtx);
+    if (m_queue_read != m_queue_write)
+      return false;
+
+    for (auto& net_ref : network_ref)
+    {
+      if (net_ref.ip == 0)
+        continue;
+      if (net_ref.type == IPPROTO_TCP)
+        selector.add(net_ref.tcp_socket);
+      else
+        selector.add(net_ref.udp_socket);
+    }
+    selector.add(m_upnp_httpd);
+  }
+
+  // Resends and delayed TCP data are checked every 100 ms.
+  if (!selector.wait(sf::milliseconds(100)))
+    return false;
+  if (!selector.isReady(m_wakeup_socket))
+    return true;
+
+  std::array<u8, 16> buffer;
+  std::size_t received;
+  sf::IpAddress sender;
+  unsigned short port;
+  while (m_wakeup_socket.receive(buffer.data(), buffer.size(), received, sender, port) ==
+         sf::Socket::Done)
+  {
+  }
+  return false;
+}
+
 void CEXIETHERNET::BuiltInBBAInterface::ReadThreadHandler(CEXIETHERNET::BuiltInBBAInterface* self)
 {
+  // Set when data is waiting that WaitForNetworkActivity can't tell apart from new data, like a
+  // full receive buffer or TCP data held back for flow control. It's polled for every 1 ms then.
+  bool must_poll = false;
+  size_t datasize = 0;
   while (!self->m_read_thread_shutdown.IsSet())
   {
-    // make thread less cpu hungry
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    // Frames are passed on back to back, without waiting in between.
+    if (datasize == 0)
+    {
+      if (must_poll)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      must_poll = self->WaitForNetworkActivity();
+    }
+    datasize = 0;
 
     if (!self->m_read_enabled.IsSet())
       continue;
-    size_t datasize = 0;
 
     u8 wp = self->m_eth_ref->page_ptr(BBA_RWP);
     const u8 rp = self->m_eth_ref->page_ptr(BBA_RRP);
@@ -683,7 +747,10 @@ void CEXIETHERNET::BuiltInBBAInterface::ReadThreadHandler(CEXIETHERNET::BuiltInB
       wp += 16;
 
     if ((wp - rp) >= 8)
+    {
+      must_poll = true;
       continue;
+    }
 
     std::lock_guard<std::mutex> lock(self->m_mtx);
     // process queue file first
@@ -773,6 +840,7 @@ void CEXIETHERNET::BuiltInBBAInterface::RecvStart()
   InitUDPPort(26502);  // Kirby Air Ride
   InitUDPPort(26512);  // Mario Kart: Double Dash!! and 1080° Avalanche
   m_read_enabled.Set();
+  WakeReadThread();
 }
 
 void CEXIETHERNET::BuiltInBBAInterface::RecvStop()
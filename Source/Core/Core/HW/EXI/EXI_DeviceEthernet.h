@@ -457,7 +457,12 @@ private:
     std::thread m_read_thread;
     Common::Flag m_read_enabled;
     Common::Flag m_read_thread_shutdown;
+    // Receives a datagram from WakeReadThread whenever the read thread should stop waiting for
+    // the sockets, since there is no portable way to wake up a select() otherwise.
+    sf::UdpSocket m_wakeup_socket;
     static void ReadThreadHandler(BuiltInBBAInterface* self);
+    void WakeReadThread();
+    bool WaitForNetworkActivity();
 #endif
     void WriteToQueue(const std::vector<u8>& data);
     StackRef* GetAvailableSlot(u16 port);
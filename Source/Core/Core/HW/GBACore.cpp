@@ -480,8 +480,12 @@ void Core::SendJoybusCommand(u64 gc_ticks, int transfer_time, u8* buffer, u16 ke
   {
     std::lock_guard<std::mutex> lock(m_queue_mutex);
     m_command_queue.push(command);
-    m_idle = false;
-    m_command_cv.notify_one();
+    // A busy thread picks up new commands without being woken up.
+    if (m_idle)
+    {
+      m_idle = false;
+      m_command_cv.notify_one();
+    }
   }
   else
   {
@@ -508,28 +512,37 @@ void Core::Flush()
   if (!IsStarted() || !m_thread)
     return;
   std::unique_lock<std::mutex> lock(m_queue_mutex);
-  m_response_cv.wait(lock, [&] { return m_idle; });
+  m_idle_cv.wait(lock, [&] { return m_idle; });
 }
 
 void Core::ThreadLoop()
 {
   Common::SetCurrentThreadName(fmt::format("GBA{}", m_device_number + 1).c_str());
+  std::queue<Command> commands;
   std::unique_lock<std::mutex> queue_lock(m_queue_mutex);
   while (true)
   {
     m_command_cv.wait(queue_lock, [&] { return !m_command_queue.empty() || m_exit_loop; });
     if (m_exit_loop)
       break;
-    Command command{m_command_queue.front()};
-    m_command_queue.pop();
+
+    // Run everything that was queued in the meantime in one go, so that the CPU thread can keep
+    // queueing commands without contending for the lock after each of them.
+    std::swap(commands, m_command_queue);
     queue_lock.unlock();
 
-    RunCommand(command);
+    while (!commands.empty())
+    {
+      RunCommand(commands.front());
+      commands.pop();
+    }
 
     queue_lock.lock();
     if (m_command_queue.empty())
+    {
       m_idle = true;
-    m_response_cv.notify_one();
+      m_idle_cv.notify_all();
+    }
   }
 }
 
@@ -129,6 +129,7 @@ private:
   bool m_idle = false;
   std::mutex m_queue_mutex;
   std::condition_variable m_command_cv;
+  std::condition_variable m_idle_cv;
   std::queue<Command> m_command_queue;
 
   std::mutex m_response_mutex;
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <xxhash.h>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -592,8 +593,56 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
   return true;
 }
 
+void GCMemcardDirectory::WriteGCIFile(const std::string& filename, const std::vector<u8>& contents)
+{
+  // Games often write the same data again, for example when only the directory entry changed, so
+  // skip rewriting files whose contents are already on disk.
+  const u64 hash = XXH64(contents.data(), contents.size(), 0);
+  const auto it = m_written_hashes.find(filename);
+  if (it != m_written_hashes.end() && it->second == hash)
+  {
+    INFO_LOG_FMT(EXPANSIONINTERFACE, "Skipping write of unchanged save {}", filename);
+    return;
+  }
+
+  // Write to a temporary file first so that a crash in the middle of a write can't leave a
+  // truncated save behind.
+  const std::string temp_filename = File::GetTempFilenameForAtomicWrite(filename);
+  bool success;
+  {
+    File::IOFile gci(temp_filename, "wb");
+    if (!gci)
+    {
+      Core::DisplayMessage(fmt::format("Failed to open file at {} for writing", filename), 10000);
+      ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing", temp_filename);
+      return;
+    }
+    success = gci.WriteBytes(contents.data(), contents.size());
+  }
+
+  if (success && File::Rename(temp_filename, filename))
+  {
+    m_written_hashes[filename] = hash;
+    Core::DisplayMessage(fmt::format("Wrote save contents to {}", filename), 4000);
+  }
+  else
+  {
+    File::Delete(temp_filename);
+    m_written_hashes.erase(filename);
+    Core::DisplayMessage(fmt::format("Failed to write save contents to {}", filename), 10000);
+    ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", filename);
+  }
+}
+
 void GCMemcardDirectory::FlushToFile()
 {
+  struct PendingWrite
+  {
+    std::string filename;
+    std::vector<u8> contents;
+  };
+  std::vector<PendingWrite> pending_writes;
+
   std::unique_lock l(m_write_mutex);
   Memcard::DEntry invalid;
   for (Memcard::GCIFile& save : m_saves)
@@ -630,30 +679,16 @@ void GCMemcardDirectory::FlushToFile()
           }
           save.m_filename = default_save_name;
         }
-        File::IOFile gci(save.m_filename, "wb");
-        if (gci)
-        {
-          gci.WriteBytes(&save.m_gci_header, Memcard::DENTRY_SIZE);
-          for (const Memcard::GCMBlock& block : save.m_save_data)
-            gci.WriteBytes(block.m_block.data(), Memcard::BLOCK_SIZE);
 
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage(fmt::format("Wrote save contents to {}", save.m_filename), 4000);
-          }
-          else
-          {
-            Core::DisplayMessage(
-                fmt::format("Failed to write save contents to {}", save.m_filename), 10000);
-            ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to save data to {}", save.m_filename);
-          }
-        }
-        else
+        // Only copy the save here, so that the emulated card doesn't have to wait for the disk.
+        PendingWrite& write = pending_writes.emplace_back();
+        write.filename = save.m_filename;
+        write.contents.resize(Memcard::DENTRY_SIZE + save.m_save_data.size() * Memcard::BLOCK_SIZE);
+        std::memcpy(write.contents.data(), &save.m_gci_header, Memcard::DENTRY_SIZE);
+        for (size_t i = 0; i < save.m_save_data.size(); ++i)
         {
-          Core::DisplayMessage(
-              fmt::format("Failed to open file at {} for writing", save.m_filename), 10000);
-          ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to open file at {} for writing",
-                        save.m_filename);
+          std::memcpy(write.contents.data() + Memcard::DENTRY_SIZE + i * Memcard::BLOCK_SIZE,
+                      save.m_save_data[i].m_block.data(), Memcard::BLOCK_SIZE);
         }
       }
       else if (save.m_filename.length() != 0)
@@ -664,6 +699,7 @@ void GCMemcardDirectory::FlushToFile()
         if (File::Exists(deleted_name))
           File::Delete(deleted_name);
         File::Rename(old_name, deleted_name);
+        m_written_hashes.erase(old_name);
         save.m_filename.clear();
         save.m_save_data.clear();
         save.m_used_blocks.clear();
@@ -682,6 +718,11 @@ void GCMemcardDirectory::FlushToFile()
       save.m_save_data.clear();
     }
   }
+  l.unlock();
+
+  for (const PendingWrite& write : pending_writes)
+    WriteGCIFile(write.filename, write.contents);
+
 #if _WRITE_MC_HEADER
   u8 mc[BLOCK_SIZE * MC_FST_BLOCKS];
   Read(0, BLOCK_SIZE * MC_FST_BLOCKS, mc);
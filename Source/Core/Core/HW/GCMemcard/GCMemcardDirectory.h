@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -48,6 +49,8 @@ private:
   s32 DirectoryWrite(u32 dest_address, u32 length, const u8* src_address);
   inline void SyncSaves();
   bool SetUsedBlocks(int save_index);
+  // Must only be called from the flush thread.
+  void WriteGCIFile(const std::string& filename, const std::vector<u8>& contents);
 
   u32 m_game_id;
   s32 m_last_block;
@@ -65,4 +68,6 @@ private:
   std::mutex m_write_mutex;
   Common::Flag m_exiting;
   std::thread m_flush_thread;
+  // Hashes of the GCI files as they were last written. Only accessed while flushing.
+  std::map<std::string, u64> m_written_hashes;
 };
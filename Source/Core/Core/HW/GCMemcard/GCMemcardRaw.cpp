@@ -3,12 +3,15 @@
 
 #include "Core/HW/GCMemcard/GCMemcardRaw.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -79,6 +82,7 @@ MemoryCard::MemoryCard(const std::string& filename, ExpansionInterface::Slot car
   // Class members (including inherited ones) have now been initialized, so
   // it's safe to startup the flush thread (which reads them).
   m_flush_buffer = std::make_unique<u8[]>(m_memory_card_size);
+  m_dirty_blocks.resize((m_memory_card_size + Memcard::BLOCK_SIZE - 1) / Memcard::BLOCK_SIZE);
   m_flush_thread = std::thread(&MemoryCard::FlushThread, this);
 }
 
@@ -147,11 +151,48 @@ void MemoryCard::FlushThread()
       return;
     }
 
+    // Only the blocks that changed are written, unless the file doesn't hold a full card yet.
+    const bool write_everything = file.GetSize() != m_memory_card_size;
+    std::vector<std::pair<u32, u32>> ranges;
     {
       std::unique_lock l(m_flush_mutex);
-      memcpy(&m_flush_buffer[0], &m_memcard_data[0], m_memory_card_size);
+      if (write_everything)
+        std::fill(m_dirty_blocks.begin(), m_dirty_blocks.end(), true);
+
+      u32 block = 0;
+      while (block < m_dirty_blocks.size())
+      {
+        if (!m_dirty_blocks[block])
+        {
+          ++block;
+          continue;
+        }
+
+        const u32 first_block = block;
+        for (; block < m_dirty_blocks.size() && m_dirty_blocks[block]; ++block)
+          m_dirty_blocks[block] = false;
+
+        const u32 offset = first_block * Memcard::BLOCK_SIZE;
+        const u32 size = std::min(block * Memcard::BLOCK_SIZE, m_memory_card_size) - offset;
+        memcpy(&m_flush_buffer[offset], &m_memcard_data[offset], size);
+        ranges.emplace_back(offset, size);
+      }
+    }
+
+    for (const auto& [offset, size] : ranges)
+    {
+      if (!file.Seek(offset, File::SeekOrigin::Begin) ||
+          !file.WriteBytes(&m_flush_buffer[offset], size))
+      {
+        ERROR_LOG_FMT(EXPANSIONINTERFACE, "Failed to write memory card {} at {:#x}", m_filename,
+                      offset);
+
+        // Try again on the next flush.
+        std::unique_lock l(m_flush_mutex);
+        MarkBlocksDirty(offset, size);
+        MakeDirty();
+      }
     }
-    file.WriteBytes(&m_flush_buffer[0], m_memory_card_size);
 
     if (do_exit)
       return;
@@ -168,6 +209,18 @@ void MemoryCard::MakeDirty()
   m_dirty.Set();
 }
 
+void MemoryCard::MarkBlocksDirty(u32 address, u32 length)
+{
+  if (length == 0)
+    return;
+
+  const u32 first_block = address / Memcard::BLOCK_SIZE;
+  const u32 last_block = std::min<u32>((address + length - 1) / Memcard::BLOCK_SIZE,
+                                       static_cast<u32>(m_dirty_blocks.size() - 1));
+  for (u32 block = first_block; block <= last_block; ++block)
+    m_dirty_blocks[block] = true;
+}
+
 s32 MemoryCard::Read(u32 src_address, s32 length, u8* dest_address)
 {
   if (!IsAddressInBounds(src_address))
@@ -192,6 +245,7 @@ s32 MemoryCard::Write(u32 dest_address, s32 length, const u8* src_address)
   {
     std::unique_lock l(m_flush_mutex);
     memcpy(&m_memcard_data[dest_address], src_address, length);
+    MarkBlocksDirty(dest_address, length);
   }
   MakeDirty();
   return length;
@@ -208,6 +262,7 @@ void MemoryCard::ClearBlock(u32 address)
   {
     std::unique_lock l(m_flush_mutex);
     memset(&m_memcard_data[address], 0xFF, Memcard::BLOCK_SIZE);
+    MarkBlocksDirty(address, Memcard::BLOCK_SIZE);
   }
   MakeDirty();
 }
@@ -217,6 +272,7 @@ void MemoryCard::ClearAll()
   {
     std::unique_lock l(m_flush_mutex);
     memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+    MarkBlocksDirty(0, m_memory_card_size);
   }
   MakeDirty();
 }
@@ -226,4 +282,11 @@ void MemoryCard::DoState(PointerWrap& p)
   p.Do(m_card_slot);
   p.Do(m_memory_card_size);
   p.DoArray(&m_memcard_data[0], m_memory_card_size);
+
+  if (p.IsReadMode())
+  {
+    // The file no longer matches any of the loaded card, so write all of it with the next flush.
+    std::unique_lock l(m_flush_mutex);
+    MarkBlocksDirty(0, m_memory_card_size);
+  }
 }
@@ -7,6 +7,8 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
+
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Core/HW/GCMemcard/GCMemcard.h"
@@ -31,6 +33,8 @@ public:
 
 private:
   bool IsAddressInBounds(u32 address) const { return address <= (m_memory_card_size - 1); }
+  // Must be called with m_flush_mutex held.
+  void MarkBlocksDirty(u32 address, u32 length);
 
   std::string m_filename;
   std::unique_ptr<u8[]> m_memcard_data;
@@ -39,5 +43,7 @@ private:
   std::mutex m_flush_mutex;
   Common::Event m_flush_trigger;
   Common::Flag m_dirty;
+  // Blocks that have changed since they were last written to the file. Guarded by m_flush_mutex.
+  std::vector<bool> m_dirty_blocks;
   u32 m_memory_card_size;
 };
@@ -4,8 +4,12 @@
 #include "Core/HW/GCPad.h"
 
 #include <cstring>
+#include <optional>
 
 #include "Common/Common.h"
+#ifdef USE_AGENT_INTERFACE
+#include "Core/AgentInterface.h"
+#endif
 #include "Core/HW/GCPadEmu.h"
 #include "InputCommon/ControllerEmu/ControlGroup/ControlGroup.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
@@ -53,6 +57,11 @@ bool IsInitialized()
 
 GCPadStatus GetStatus(int pad_num)
 {
+#ifdef USE_AGENT_INTERFACE
+  if (const std::optional<GCPadStatus> status = AgentInterface::GetPadOverride(pad_num))
+    return *status;
+#endif
+
   return static_cast<GCPad*>(s_config.GetController(pad_num))->GetInput();
 }
 
@@ -14,6 +14,7 @@
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/CommandProcessor.h"
+#include "VideoCommon/Fifo.h"
 
 namespace GPFifo
 {
@@ -89,6 +90,7 @@ void UpdateGatherPipe()
   {
     // copy the GatherPipe
     memcpy(cur_mem, s_gather_pipe + processed, GATHER_PIPE_SIZE);
+    Fifo::PushGatherPipeBurst(ProcessorInterface::Fifo_CPUWritePointer, s_gather_pipe + processed);
     pipe_count -= GATHER_PIPE_SIZE;
 
     // increase the CPUWritePointer
@@ -3,6 +3,7 @@
 
 #include "Core/HW/MMIO.h"
 
+#include <cstdint>
 #include <functional>
 
 #include "Common/Assert.h"
@@ -220,15 +221,57 @@ struct LargerAccessSize<u16>
   typedef u32 value;
 };
 
+// Records what a read handler does if it is a Constant or a Direct handler, so that the size
+// conversions below can turn combinations of them into a single Constant or Direct handler,
+// which the JITs can inline.
+template <typename T>
+struct SimpleReadMethodVisitor : public ReadHandlingMethodVisitor<T>
+{
+  void VisitConstant(T value_) override
+  {
+    is_constant = true;
+    value = value_;
+  }
+  void VisitDirect(const T* addr_, u32 mask_) override
+  {
+    is_direct = true;
+    addr = addr_;
+    mask = mask_;
+  }
+  void VisitComplex(const std::function<T(u32)>* lambda) override {}
+
+  bool is_constant = false;
+  bool is_direct = false;
+  T value = 0;
+  const T* addr = nullptr;
+  u32 mask = 0;
+};
+
 template <typename T>
 ReadHandlingMethod<T>* ReadToSmaller(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
 {
   typedef typename SmallerAccessSize<T>::value ST;
+  constexpr u32 st_bits = 8 * sizeof(ST);
+  constexpr u32 st_mask = (1U << st_bits) - 1;
 
   ReadHandler<ST>* high_part = &mmio->GetHandlerForRead<ST>(high_part_addr);
   ReadHandler<ST>* low_part = &mmio->GetHandlerForRead<ST>(low_part_addr);
 
-  // TODO(delroth): optimize
+  SimpleReadMethodVisitor<ST> high, low;
+  high_part->Visit(high);
+  low_part->Visit(low);
+  if (high.is_constant && low.is_constant)
+    return Constant<T>(static_cast<T>((T(high.value) << st_bits) | low.value));
+
+  // Host memory is little endian, so if the low part is stored right before the high part, both
+  // can be read at once.
+  if (high.is_direct && low.is_direct && low.addr + 1 == high.addr &&
+      reinterpret_cast<uintptr_t>(low.addr) % alignof(T) == 0)
+  {
+    return DirectRead<T>(reinterpret_cast<const T*>(low.addr),
+                         ((high.mask & st_mask) << st_bits) | (low.mask & st_mask));
+  }
+
   return ComplexRead<T>([=](u32 addr) {
     return ((T)high_part->Read(high_part_addr) << (8 * sizeof(ST))) | low_part->Read(low_part_addr);
   });
@@ -256,7 +299,19 @@ ReadHandlingMethod<T>* ReadToLarger(Mapping* mmio, u32 larger_addr, u32 shift)
 
   ReadHandler<LT>* large = &mmio->GetHandlerForRead<LT>(larger_addr);
 
-  // TODO(delroth): optimize
+  SimpleReadMethodVisitor<LT> large_method;
+  large->Visit(large_method);
+  if (large_method.is_constant)
+    return Constant<T>(static_cast<T>(large_method.value >> shift));
+
+  // Host memory is little endian, so the part which is shifted down is at a byte offset of
+  // shift / 8.
+  if (large_method.is_direct && shift % (8 * sizeof(T)) == 0)
+  {
+    const auto* addr = reinterpret_cast<const u8*>(large_method.addr) + shift / 8;
+    return DirectRead<T>(reinterpret_cast<const T*>(addr), large_method.mask >> shift);
+  }
+
   return ComplexRead<T>(
       [large, shift](u32 addr) { return large->Read(addr & ~(sizeof(LT) - 1)) >> shift; });
 }
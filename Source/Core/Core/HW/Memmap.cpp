@@ -10,14 +10,19 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <tuple>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -174,6 +179,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 shm_position;
 };
 
 // Dolphin allocates memory to represent four regions:
@@ -223,6 +229,38 @@ static std::vector<LogicalMemoryView> logical_mapped_entries;
 static std::array<void*, PowerPC::BAT_PAGE_COUNT> s_physical_page_mappings;
 static std::array<void*, PowerPC::BAT_PAGE_COUNT> s_logical_page_mappings;
 
+// Write watches are tracked at a granularity which is a multiple of the host page size on every
+// platform we support, and which every memory region and logical mapping is aligned to.
+constexpr u32 WRITE_WATCH_PAGE_SIZE = 0x10000;
+
+struct WriteWatchPage
+{
+  // The value of s_write_watch_counter after the page was last written to while not watched.
+  u64 last_write;
+  bool watched;
+  // Whether the page is inaccessible in the fastmem views because of an access watch.
+  bool access_watched;
+};
+
+// Guards the write watch state and logical_mapped_entries, which the fault handler reads from
+// whichever thread caused the fault.
+static std::mutex s_write_watch_mutex;
+static std::atomic<bool> s_write_watch_enabled = false;
+static u64 s_write_watch_counter = 0;
+// Indexed by the shared memory position divided by WRITE_WATCH_PAGE_SIZE.
+static std::vector<WriteWatchPage> s_write_watch_pages;
+static AccessWatchHandler s_access_watch_handler = nullptr;
+
+static void ProtectView(const WriteWatchPage& page, u8* view, bool is_fastmem_view)
+{
+  if (is_fastmem_view && page.access_watched)
+    Common::ReadProtectMemory(view, WRITE_WATCH_PAGE_SIZE);
+  else if (page.watched || page.access_watched)
+    Common::WriteProtectMemory(view, WRITE_WATCH_PAGE_SIZE);
+  else
+    Common::UnWriteProtectMemory(view, WRITE_WATCH_PAGE_SIZE);
+}
+
 void Init()
 {
   const auto get_mem1_size = [] {
@@ -277,7 +315,10 @@ void Init()
     region.active = true;
     mem_size += region.size;
   }
-  g_arena.GrabSHMSegment(mem_size);
+  g_arena.GrabSHMSegment(mem_size, Config::Get(Config::MAIN_AGENT_INTERFACE));
+
+  s_write_watch_pages.assign(mem_size / WRITE_WATCH_PAGE_SIZE,
+                             {++s_write_watch_counter, false, false});
 
   s_physical_page_mappings.fill(nullptr);
 
@@ -315,6 +356,17 @@ void Init()
   m_IsInitialized = true;
 }
 
+size_t GetResidentSize()
+{
+  size_t size = 0;
+  for (const PhysicalMemoryRegion& region : s_physical_regions)
+  {
+    if (region.active && *region.out_pointer)
+      size += Common::MemResidentSize(*region.out_pointer, region.size);
+  }
+  return size;
+}
+
 bool InitFastmemArena()
 {
 #if _ARCH_32
@@ -357,6 +409,8 @@ bool InitFastmemArena()
 
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  std::lock_guard lk(s_write_watch_mutex);
+
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -401,7 +455,16 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                   intersection_start, mapped_size, logical_address);
               exit(0);
             }
-            logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+            logical_mapped_entries.push_back({mapped_pointer, mapped_size, position});
+
+            // New views aren't protected, so watched pages have to be protected again.
+            for (u32 offset = 0; offset < mapped_size; offset += WRITE_WATCH_PAGE_SIZE)
+            {
+              const WriteWatchPage& page =
+                  s_write_watch_pages[(position + offset) / WRITE_WATCH_PAGE_SIZE];
+              if (page.watched || page.access_watched)
+                ProtectView(page, static_cast<u8*>(mapped_pointer) + offset, true);
+            }
           }
 
           s_logical_page_mappings[i] =
@@ -450,14 +513,14 @@ void DoState(PointerWrap& p)
     return;
   }
 
-  p.DoArray(m_pRAM, current_ram_size);
-  p.DoArray(m_pL1Cache, current_l1_cache_size);
+  p.DoStableArray(m_pRAM, current_ram_size);
+  p.DoStableArray(m_pL1Cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
   if (current_have_fake_vmem)
-    p.DoArray(m_pFakeVMEM, current_fake_vmem_size);
+    p.DoStableArray(m_pFakeVMEM, current_fake_vmem_size);
   p.DoMarker("Memory FakeVMEM");
   if (current_have_exram)
-    p.DoArray(m_pEXRAM, current_exram_size);
+    p.DoStableArray(m_pEXRAM, current_exram_size);
   p.DoMarker("Memory EXRAM");
 }
 
@@ -479,11 +542,28 @@ void Shutdown()
   INFO_LOG_FMT(MEMMAP, "Memory system shut down.");
 }
 
+std::string GetSharedSegmentName()
+{
+  return g_arena.GetSHMSegmentName();
+}
+
+std::optional<u32> GetSharedSegmentOffset(u32 physical_address)
+{
+  for (const PhysicalMemoryRegion& region : s_physical_regions)
+  {
+    if (region.active && region.physical_address == physical_address)
+      return region.shm_position;
+  }
+  return std::nullopt;
+}
+
 void ShutdownFastmemArena()
 {
   if (!is_fastmem_arena_initialized)
     return;
 
+  std::lock_guard lk(s_write_watch_mutex);
+
   for (const PhysicalMemoryRegion& region : s_physical_regions)
   {
     if (!region.active)
@@ -507,6 +587,380 @@ void ShutdownFastmemArena()
   is_fastmem_arena_initialized = false;
 }
 
+// Calls f with every host address which the given shared memory position is mapped at, and
+// whether that address is in the fastmem arena.
+template <typename F>
+static void ForEachView(u32 shm_position, F f)
+{
+  for (const PhysicalMemoryRegion& region : s_physical_regions)
+  {
+    if (!region.active || shm_position < region.shm_position ||
+        shm_position - region.shm_position >= region.size)
+    {
+      continue;
+    }
+
+    const u32 offset = shm_position - region.shm_position;
+    f(*region.out_pointer + offset, false);
+    if (is_fastmem_arena_initialized)
+      f(physical_base + region.physical_address + offset, true);
+  }
+
+  for (const LogicalMemoryView& entry : logical_mapped_entries)
+  {
+    if (shm_position >= entry.shm_position &&
+        shm_position - entry.shm_position < entry.mapped_size)
+    {
+      f(static_cast<u8*>(entry.mapped_pointer) + shm_position - entry.shm_position, true);
+    }
+  }
+}
+
+// Updates the protection of every view of a page to match its watches.
+static void ProtectPage(u32 index)
+{
+  const WriteWatchPage& page = s_write_watch_pages[index];
+  ForEachView(index * WRITE_WATCH_PAGE_SIZE, [&page](u8* view, bool is_fastmem_view) {
+    ProtectView(page, view, is_fastmem_view);
+  });
+}
+
+// Returns the shared memory position of a host address in any view of emulated memory.
+static std::optional<u32> GetShmPosition(uintptr_t address, bool* is_fastmem_view)
+{
+  const auto check_view = [address](const void* view, u32 size) {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(view);
+    return view && address >= start && address - start < size;
+  };
+
+  for (const PhysicalMemoryRegion& region : s_physical_regions)
+  {
+    if (!region.active)
+      continue;
+
+    *is_fastmem_view = false;
+    if (check_view(*region.out_pointer, region.size))
+      return region.shm_position + u32(address - reinterpret_cast<uintptr_t>(*region.out_pointer));
+
+    *is_fastmem_view = true;
+    if (is_fastmem_arena_initialized)
+    {
+      const u8* base = physical_base + region.physical_address;
+      if (check_view(base, region.size))
+        return region.shm_position + u32(address - reinterpret_cast<uintptr_t>(base));
+    }
+  }
+
+  *is_fastmem_view = true;
+  for (const LogicalMemoryView& entry : logical_mapped_entries)
+  {
+    if (check_view(entry.mapped_pointer, entry.mapped_size))
+      return entry.shm_position + u32(address - reinterpret_cast<uintptr_t>(entry.mapped_pointer));
+  }
+
+  return std::nullopt;
+}
+
+// Returns the range of write watch pages covering a range in a physical region's view.
+static std::optional<std::pair<u32, u32>> GetWriteWatchPages(const u8* ptr, size_t size)
+{
+  for (const PhysicalMemoryRegion& region : s_physical_regions)
+  {
+    if (!region.active || ptr < *region.out_pointer || size > region.size ||
+        u32(ptr - *region.out_pointer) > region.size - size)
+    {
+      continue;
+    }
+
+    const u32 start = region.shm_position + u32(ptr - *region.out_pointer);
+    return std::make_pair(start / WRITE_WATCH_PAGE_SIZE,
+                          (start + u32(size) - 1) / WRITE_WATCH_PAGE_SIZE + 1);
+  }
+
+  return std::nullopt;
+}
+
+static void UnwatchPage(u32 index)
+{
+  WriteWatchPage& page = s_write_watch_pages[index];
+  if (!page.watched)
+    return;
+
+  page.watched = false;
+  page.last_write = ++s_write_watch_counter;
+  ProtectPage(index);
+}
+
+void SetWriteWatchEnabled(bool enabled)
+{
+  std::lock_guard lk(s_write_watch_mutex);
+
+  if (!enabled)
+  {
+    for (u32 i = 0; i < s_write_watch_pages.size(); ++i)
+    {
+      WriteWatchPage& page = s_write_watch_pages[i];
+      if (page.access_watched)
+      {
+        page.access_watched = false;
+        ProtectPage(i);
+      }
+      UnwatchPage(i);
+    }
+  }
+
+  s_write_watch_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool IsWriteWatchEnabled()
+{
+  return s_write_watch_enabled.load(std::memory_order_relaxed);
+}
+
+u64 WatchWrites(const u8* ptr, size_t size)
+{
+  if (!IsWriteWatchEnabled() || size == 0)
+    return 0;
+
+  std::lock_guard lk(s_write_watch_mutex);
+
+  const auto pages = GetWriteWatchPages(ptr, size);
+  if (!pages)
+    return 0;
+
+  for (u32 i = pages->first; i < pages->second; ++i)
+  {
+    WriteWatchPage& page = s_write_watch_pages[i];
+    if (page.watched)
+      continue;
+
+    page.watched = true;
+    ProtectPage(i);
+  }
+
+  return s_write_watch_counter;
+}
+
+bool WasWrittenSince(const u8* ptr, size_t size, u64 token)
+{
+  if (token == 0 || !IsWriteWatchEnabled())
+    return true;
+
+  std::lock_guard lk(s_write_watch_mutex);
+
+  const auto pages = GetWriteWatchPages(ptr, size);
+  if (!pages)
+    return true;
+
+  for (u32 i = pages->first; i < pages->second; ++i)
+  {
+    if (s_write_watch_pages[i].last_write > token)
+      return true;
+  }
+
+  return false;
+}
+
+void PrepareForHostWrite(u32 address, size_t size)
+{
+  if (!IsWriteWatchEnabled() || size == 0)
+    return;
+
+  const u8* ptr = GetPointerForRange(address, size);
+  if (!ptr)
+    return;
+
+  AccessWatchHandler access_watch_handler = nullptr;
+  {
+    std::lock_guard lk(s_write_watch_mutex);
+
+    const auto pages = GetWriteWatchPages(ptr, size);
+    if (!pages)
+      return;
+
+    for (u32 i = pages->first; i < pages->second; ++i)
+    {
+      WriteWatchPage& page = s_write_watch_pages[i];
+      const bool was_access_watched = page.access_watched;
+      if (was_access_watched)
+      {
+        page.access_watched = false;
+        access_watch_handler = s_access_watch_handler;
+      }
+
+      if (page.watched)
+        UnwatchPage(i);
+      else if (was_access_watched)
+        ProtectPage(i);
+    }
+  }
+
+  if (access_watch_handler)
+    access_watch_handler(address, static_cast<u32>(size));
+}
+
+void PrepareForHostRead(u32 address, size_t size)
+{
+  if (!IsAccessWatchEnabled() || size == 0)
+    return;
+
+  const u8* ptr = GetPointerForRange(address, size);
+  if (!ptr)
+    return;
+
+  AccessWatchHandler access_watch_handler = nullptr;
+  {
+    std::lock_guard lk(s_write_watch_mutex);
+
+    const auto pages = GetWriteWatchPages(ptr, size);
+    if (!pages)
+      return;
+
+    for (u32 i = pages->first; i < pages->second; ++i)
+    {
+      WriteWatchPage& page = s_write_watch_pages[i];
+      if (!page.access_watched)
+        continue;
+
+      // Reads don't end write watches.
+      page.access_watched = false;
+      access_watch_handler = s_access_watch_handler;
+      ProtectPage(i);
+    }
+  }
+
+  if (access_watch_handler)
+    access_watch_handler(address, static_cast<u32>(size));
+}
+
+bool IsAccessWatchEnabled()
+{
+  return IsWriteWatchEnabled() && is_fastmem_arena_initialized;
+}
+
+void SetAccessWatchHandler(AccessWatchHandler handler)
+{
+  std::lock_guard lk(s_write_watch_mutex);
+  s_access_watch_handler = handler;
+}
+
+bool WatchAccesses(const u8* ptr, size_t size)
+{
+  if (!IsAccessWatchEnabled() || size == 0)
+    return false;
+
+  std::lock_guard lk(s_write_watch_mutex);
+
+  const auto pages = GetWriteWatchPages(ptr, size);
+  if (!pages)
+    return false;
+
+  for (u32 i = pages->first; i < pages->second; ++i)
+  {
+    WriteWatchPage& page = s_write_watch_pages[i];
+    if (page.access_watched)
+      continue;
+
+    page.access_watched = true;
+    ProtectPage(i);
+  }
+
+  return true;
+}
+
+void WriteAccessWatchedMemory(u8* ptr, size_t size, const std::function<void()>& write)
+{
+  if (!IsWriteWatchEnabled() || size == 0)
+  {
+    write();
+    return;
+  }
+
+  // Holding the lock makes other threads which fault on the range wait until the write is done.
+  std::lock_guard lk(s_write_watch_mutex);
+
+  const auto pages = GetWriteWatchPages(ptr, size);
+  if (!pages)
+  {
+    write();
+    return;
+  }
+
+  for (u32 i = pages->first; i < pages->second; ++i)
+  {
+    WriteWatchPage& page = s_write_watch_pages[i];
+    if (page.watched)
+    {
+      page.watched = false;
+      page.last_write = ++s_write_watch_counter;
+    }
+    ForEachView(i * WRITE_WATCH_PAGE_SIZE, [](u8* view, bool is_fastmem_view) {
+      if (!is_fastmem_view)
+        Common::UnWriteProtectMemory(view, WRITE_WATCH_PAGE_SIZE);
+    });
+  }
+
+  write();
+
+  for (u32 i = pages->first; i < pages->second; ++i)
+    ProtectPage(i);
+}
+
+// Returns the physical address of a shared memory position.
+static u32 GetPhysicalAddress(u32 shm_position)
+{
+  for (const PhysicalMemoryRegion& region : s_physical_regions)
+  {
+    if (region.active && shm_position >= region.shm_position &&
+        shm_position - region.shm_position < region.size)
+    {
+      return region.physical_address + shm_position - region.shm_position;
+    }
+  }
+
+  return 0;
+}
+
+bool HandleWriteWatchFault(uintptr_t fault_address)
+{
+  if (!IsWriteWatchEnabled())
+    return false;
+
+  AccessWatchHandler access_watch_handler = nullptr;
+  u32 page_address = 0;
+  {
+    std::lock_guard lk(s_write_watch_mutex);
+
+    bool is_fastmem_view;
+    const std::optional<u32> shm_position = GetShmPosition(fault_address, &is_fastmem_view);
+    if (!shm_position)
+      return false;
+
+    // Views of emulated memory can only fault because of a watch. If the page isn't watched
+    // anymore, another thread just handled a fault for it, so the access can simply be retried.
+    const u32 index = *shm_position / WRITE_WATCH_PAGE_SIZE;
+    WriteWatchPage& page = s_write_watch_pages[index];
+    if (page.access_watched)
+    {
+      page.access_watched = false;
+      access_watch_handler = s_access_watch_handler;
+      page_address = GetPhysicalAddress(index * WRITE_WATCH_PAGE_SIZE);
+    }
+
+    // Faults in the fastmem views may have been caused by reads, which don't end write watches.
+    if (!is_fastmem_view && page.watched)
+      UnwatchPage(index);
+    else
+      ProtectPage(index);
+  }
+
+  // The handler may write to the page, which can fault again, so the lock must not be held.
+  if (access_watch_handler)
+    access_watch_handler(page_address, WRITE_WATCH_PAGE_SIZE);
+
+  return true;
+}
+
 void Clear()
 {
   if (m_pRAM)
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "Common/CommonTypes.h"
@@ -48,6 +51,9 @@ u32 GetL1CacheMask();
 u32 GetExRamSizeReal();
 u32 GetExRamSize();
 u32 GetExRamMask();
+// The physical memory backing the emulated memory. MEM2 is only allocated for Wii titles, and the
+// fake VMEM only for GameCube titles without MMU emulation.
+size_t GetResidentSize();
 
 constexpr u32 MEM1_BASE_ADDR = 0x80000000U;
 constexpr u32 MEM2_BASE_ADDR = 0x90000000U;
@@ -69,8 +75,52 @@ void DoState(PointerWrap& p);
 
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+// Returns the name under which other processes can open the shared memory segment backing emulated
+// memory, or an empty string if it can't be opened from other processes.
+std::string GetSharedSegmentName();
+// Returns the offset within that segment of the region starting at the given physical address
+// (0x00000000 for MEM1, 0x10000000 for MEM2), or std::nullopt if there is no such region.
+std::optional<u32> GetSharedSegmentOffset(u32 physical_address);
+
 void Clear();
 
+// Write watches let the video backend find out whether emulated RAM has been written to, without
+// having to compare its contents. Watched pages are write-protected, and a write to one of them
+// unprotects it and marks it as written. This requires the fastmem fault handler to be installed,
+// which the CPU thread enables and disables watching around.
+void SetWriteWatchEnabled(bool enabled);
+bool IsWriteWatchEnabled();
+// Starts watching the given range of MEM1 or MEM2, which must have been returned by GetPointer.
+// Returns a token to pass to WasWrittenSince, or 0 if the range can't be watched.
+u64 WatchWrites(const u8* ptr, size_t size);
+// Returns true if any part of the range may have been written to after the WatchWrites call which
+// returned the token.
+bool WasWrittenSince(const u8* ptr, size_t size, u64 token);
+// Writes by the host OS (e.g. read() or recv() directly into emulated RAM) fail instead of
+// faulting when they hit a watched page, so such writes must be announced beforehand.
+void PrepareForHostWrite(u32 address, size_t size);
+// Reads by the host see the contents of access watched pages as they are, so the access watch
+// handler has to run for the range before it is read like the emulated CPU would.
+void PrepareForHostRead(u32 address, size_t size);
+// Access watches let the video backend postpone writing to emulated RAM until the emulated CPU
+// accesses it. Watched pages are made inaccessible in the fastmem views, so that any access by JIT
+// fastmem code is caught, and read-only in the other views, so that writes by emulated hardware
+// are caught. Reads through GetPointer or the slow memory paths still see the memory as it is.
+bool IsAccessWatchEnabled();
+// Called on the thread which accessed a watched page with the physical address range that was
+// accessed. The access is retried once the handler returns. Whole pages stop being watched, so
+// the handler has to watch any other part of them again that still needs to be.
+using AccessWatchHandler = void (*)(u32 address, u32 size);
+void SetAccessWatchHandler(AccessWatchHandler handler);
+// Starts watching accesses to the given range of MEM1 or MEM2, which must have been returned by
+// GetPointer. Returns false if the range can't be watched.
+bool WatchAccesses(const u8* ptr, size_t size);
+// Calls write, which may then write to the given range of MEM1 or MEM2 without ending any access
+// watches. Write watches of the range end as usual.
+void WriteAccessWatchedMemory(u8* ptr, size_t size, const std::function<void()>& write);
+// Called by the fault handler. Returns true if the fault was caused by a write or access watch.
+bool HandleWriteWatchFault(uintptr_t fault_address);
+
 // Routines to access physically addressed memory, designed for use by
 // emulated hardware outside the CPU. Use "Device_" prefix.
 std::string GetString(u32 em_address, size_t size = 0);
@@ -99,8 +149,7 @@ void CopyFromEmuSwapped(T* data, u32 address, size_t size)
   if (src == nullptr)
     return;
 
-  for (size_t i = 0; i < size / sizeof(T); i++)
-    data[i] = Common::FromBigEndian(src[i]);
+  Common::FromBigEndianArray(data, src, size / sizeof(T));
 }
 
 template <typename T>
@@ -111,7 +160,6 @@ void CopyToEmuSwapped(u32 address, const T* data, size_t size)
   if (dest == nullptr)
     return;
 
-  for (size_t i = 0; i < size / sizeof(T); i++)
-    dest[i] = Common::FromBigEndian(data[i]);
+  Common::FromBigEndianArray(dest, data, size / sizeof(T));
 }
 }  // namespace Memory
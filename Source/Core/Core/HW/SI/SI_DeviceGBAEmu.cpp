@@ -58,15 +58,11 @@ int CSIDevice_GBAEmu::RunBuffer(u8* buffer, int request_length)
     m_timestamp_sent = CoreTiming::GetTicks();
     m_core->SendJoybusCommand(m_timestamp_sent, TransferInterval(), buffer, m_keys);
 
+    // The other GBAs don't see this transfer, so they keep running on their own sync events
+    // instead of being synced along with it, which never lets them fall behind by more than
+    // GetSyncInterval().
     RemoveEvent(m_device_number);
     ScheduleEvent(m_device_number, TransferInterval() + GetSyncInterval());
-    for (int i = 0; i < MAX_SI_CHANNELS; ++i)
-    {
-      if (i == m_device_number || SerialInterface::GetDeviceType(i) != GetDeviceType())
-        continue;
-      RemoveEvent(i);
-      ScheduleEvent(i, 0, static_cast<u64>(TransferInterval()));
-    }
 
     m_next_action = NextAction::WaitTransferTime;
     [[fallthrough]];
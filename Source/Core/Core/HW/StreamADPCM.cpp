@@ -12,35 +12,35 @@
 
 namespace StreamADPCM
 {
-static s16 ADPDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
-{
-  s32 hist = 0;
-  switch (q >> 4)
-  {
-  case 0:
-    hist = 0;
-    break;
-  case 1:
-    hist = (hist1 * 0x3c);
-    break;
-  case 2:
-    hist = (hist1 * 0x73) - (hist2 * 0x34);
-    break;
-  case 3:
-    hist = (hist1 * 0x62) - (hist2 * 0x37);
-    break;
-  }
-  hist = std::clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
+// Predictor coefficients for hist1 and hist2, selected by the top nibble of the header byte.
+constexpr s32 FILTER_COEFS[4][2] = {{0, 0}, {0x3c, 0}, {0x73, -0x34}, {0x62, -0x37}};
 
-  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
+// Decodes the samples of one channel. The filter and shift are fixed for the whole block, so
+// they are picked once here instead of per sample.
+static void DecodeChannel(s16* pcm, const u8* adpcm, u32 nibble_shift, u8 header, s32& hist1,
+                          s32& hist2)
+{
+  // Filter numbers above 3 predict nothing, like filter 0.
+  const u32 filter = header >> 4;
+  const s32 coef1 = filter < 4 ? FILTER_COEFS[filter][0] : 0;
+  const s32 coef2 = filter < 4 ? FILTER_COEFS[filter][1] : 0;
+  const u32 shift = header & 0xf;
 
-  hist2 = hist1;
-  hist1 = cur;
+  s32 h1 = hist1;
+  s32 h2 = hist2;
+  for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
+  {
+    const s32 bits = adpcm[i] >> nibble_shift;
+    const s32 hist = std::clamp((h1 * coef1 + h2 * coef2 + 0x20) >> 6, -0x200000, 0x1fffff);
+    const s32 cur = ((static_cast<s16>(bits << 12) >> shift) << 6) + hist;
 
-  cur >>= 6;
-  cur = std::clamp(cur, -0x8000, 0x7fff);
+    h2 = h1;
+    h1 = cur;
 
-  return (s16)cur;
+    pcm[i * 2] = static_cast<s16>(std::clamp(cur >> 6, -0x8000, 0x7fff));
+  }
+  hist1 = h1;
+  hist2 = h2;
 }
 
 void ADPCMDecoder::ResetFilter()
@@ -61,12 +61,8 @@ void ADPCMDecoder::DoState(PointerWrap& p)
 
 void ADPCMDecoder::DecodeBlock(s16* pcm, const u8* adpcm)
 {
-  for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
-  {
-    pcm[i * 2] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] & 0xf, adpcm[0],
-                                 m_histl1, m_histl2);
-    pcm[i * 2 + 1] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> 4, adpcm[1],
-                                     m_histr1, m_histr2);
-  }
+  const u8* data = adpcm + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK);
+  DecodeChannel(pcm, data, 0, adpcm[0], m_histl1, m_histl2);
+  DecodeChannel(pcm + 1, data, 4, adpcm[1], m_histr1, m_histr2);
 }
 }  // namespace StreamADPCM
@@ -51,7 +51,7 @@ IPC_HLE_PERIOD: For the Wii Remote this is the call schedule:
 #include "AudioCommon/Mixer.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
-#include "Common/Thread.h"
+#include "Common/PerformanceTrace.h"
 #include "Common/Timer.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -99,6 +99,25 @@ std::mutex s_emu_to_real_time_mutex;
 // at initialization (or ever), since only the "derivative" of that value really matters.
 u64 s_time_spent_sleeping;
 
+// Only used by the CPU thread.
+Common::PreciseSleeper s_sleeper;
+
+// The real time deadline of the last throttle event, and the emulated time it was scheduled for.
+// Used to predict when upcoming fields are due in low latency mode.
+u64 s_throttle_deadline;
+u64 s_throttle_ticks;
+double s_throttle_ticks_per_us;
+bool s_throttle_active;
+
+// Low latency mode: how long the CPU thread was busy emulating recent fields.
+u64 s_last_field_time;
+u64 s_last_field_sleep;
+u64 s_field_busy_estimate;
+
+// How long before the next field is due the emulation of the field should finish at the latest,
+// to absorb scheduling jitter.
+constexpr u64 FRAME_PACING_MARGIN_US = 2000;
+
 // DSP/CPU timeslicing.
 void DSPCallback(u64 userdata, s64 cyclesLate)
 {
@@ -200,12 +219,19 @@ void ThrottleCallback(u64 deadline, s64 cyclesLate)
                     std::abs(diff) - max_fallback);
       deadline = time - max_fallback;
     }
-    else if (diff > 1000)
+    else if (diff > 0)
     {
-      Common::SleepCurrentThread(diff / 1000);
+      Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::CPUThrottle);
+      s_sleeper.SleepUntil(deadline);
       s_time_spent_sleeping += Common::Timer::NowUs() - time;
     }
   }
+
+  s_throttle_deadline = deadline;
+  s_throttle_ticks = CoreTiming::GetTicks() - cyclesLate;
+  s_throttle_ticks_per_us = next_event / 1000.0;
+  s_throttle_active = frame_limiter;
+
   // reschedule 1ms (possibly scaled by emulation_speed) into future on ppc
   // add 1ms to the deadline
   CoreTiming::ScheduleEvent(next_event - cyclesLate, et_Throttle, deadline + 1000);
@@ -281,6 +307,55 @@ double GetEstimatedEmulationPerformance()
 
 // split from Init to break a circular dependency between VideoInterface::Init and
 // SystemTimers::Init
+void PaceFrameStart()
+{
+  const u64 time = Common::Timer::NowUs();
+  const u64 busy = (time - s_last_field_time) - (s_time_spent_sleeping - s_last_field_sleep);
+
+  // Follow increases in the emulation time immediately and decreases slowly, so that the occasional
+  // heavy field doesn't miss its deadline right after a run of light ones.
+  if (busy > s_field_busy_estimate)
+    s_field_busy_estimate = busy;
+  else
+    s_field_busy_estimate = (s_field_busy_estimate * 7 + busy) / 8;
+
+  if (s_throttle_active && s_throttle_ticks_per_us > 0.0)
+  {
+    // When the field after this one is due in real time.
+    const s64 ticks_ahead = CoreTiming::GetTicks() + VideoInterface::GetTicksPerField() -
+                            static_cast<s64>(s_throttle_ticks);
+    const s64 next_field_deadline =
+        static_cast<s64>(s_throttle_deadline) +
+        static_cast<s64>(ticks_ahead / s_throttle_ticks_per_us);
+
+    // Start emulating the field as late as possible while still finishing it in time, so that it
+    // reads the most recent input. The throttle catches up on the delay without sleeping.
+    const s64 start_time = next_field_deadline -
+                           static_cast<s64>(s_field_busy_estimate + s_field_busy_estimate / 4 +
+                                            FRAME_PACING_MARGIN_US);
+    const s64 delay = start_time - static_cast<s64>(time);
+    if (delay > 0)
+    {
+      Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::CPUThrottle);
+      s_sleeper.SleepUntil(static_cast<u64>(start_time));
+      s_time_spent_sleeping += Common::Timer::NowUs() - time;
+    }
+  }
+
+  s_last_field_time = Common::Timer::NowUs();
+  s_last_field_sleep = s_time_spent_sleeping;
+}
+
+const Common::PreciseSleeper::Stats& GetThrottleSleepStats()
+{
+  return s_sleeper.GetStats();
+}
+
+void ResetThrottleSleepStats()
+{
+  s_sleeper.ResetStats();
+}
+
 void PreInit()
 {
   ChangePPCClock(SConfig::GetInstance().bWii ? Mode::Wii : Mode::GC);
@@ -343,6 +418,12 @@ void Init()
     CoreTiming::ScheduleEvent(s_ipc_hle_period, et_IPC_HLE);
 
   s_emu_to_real_time_ring_buffer.fill(0);
+
+  s_throttle_ticks_per_us = 0.0;
+  s_throttle_active = false;
+  s_last_field_time = Common::Timer::NowUs();
+  s_last_field_sleep = s_time_spent_sleeping;
+  s_field_busy_estimate = 0;
 }
 
 void Shutdown()
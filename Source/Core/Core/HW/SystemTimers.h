@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Common/CommonTypes.h"
+#include "Common/Timer.h"
 
 namespace SystemTimers
 {
@@ -70,6 +71,15 @@ s64 GetLocalTimeRTCOffset();
 // - 2.0: the emulator is running at 200% speed (or 100% speed but sleeping half of the time).
 double GetEstimatedEmulationPerformance();
 
+// Called at the end of every field in low latency mode. Delays the emulation of the next field by
+// the time it is expected to be idle for, so that its input is polled closer to when it is shown.
+// Only does anything while the frame limiter is active.
+void PaceFrameStart();
+
+// How precisely the frame limiter's sleeps woke up. Only for the CPU thread.
+const Common::PreciseSleeper::Stats& GetThrottleSleepStats();
+void ResetThrottleSleepStats();
+
 }  // namespace SystemTimers
 
 inline namespace SystemTimersLiterals
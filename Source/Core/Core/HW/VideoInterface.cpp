@@ -68,6 +68,7 @@ struct VideoInterfaceState::Data
 
   u64 ticks_last_line_start;      // number of ticks when the current full scanline started
   u32 half_line_count;            // number of halflines that have occurred for this full frame
+  u16 vertical_beam_position;     // 1 + half_line_count / 2, read directly by the MMIO handler
   u32 half_line_of_next_si_poll;  // halfline when next SI poll results should be available
 
   // below indexes are 0-based
@@ -175,6 +176,7 @@ void Preset(bool _bNTSC)
 
   state.ticks_last_line_start = 0;
   state.half_line_count = 0;
+  state.vertical_beam_position = 1;
   state.half_line_of_next_si_poll = NUM_HALF_LINES_FOR_SI_POLL;  // first sampling starts at vsync
 
   UpdateParameters();
@@ -304,10 +306,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
 
   // MMIOs with unimplemented writes that trigger warnings.
   mmio->Register(
-      base | VI_VERTICAL_BEAM_POSITION, MMIO::ComplexRead<u16>([](u32) {
-        auto& state = Core::System::GetInstance().GetVideoInterfaceState().GetData();
-        return 1 + (state.half_line_count) / 2;
-      }),
+      base | VI_VERTICAL_BEAM_POSITION, MMIO::DirectRead<u16>(&state.vertical_beam_position),
       MMIO::ComplexWrite<u16>([](u32, u16 val) {
         WARN_LOG_FMT(
             VIDEOINTERFACE,
@@ -872,6 +871,9 @@ static void EndField(FieldType field, u64 ticks)
 
   Core::VideoThrottle();
   Core::OnFrameEnd();
+
+  if (Config::Get(Config::GFX_LOW_LATENCY_MODE))
+    SystemTimers::PaceFrameStart();
 }
 
 // Purpose: Send VI interrupt when triggered
@@ -943,6 +945,7 @@ void Update(u64 ticks)
   {
     state.half_line_count = 0;
   }
+  state.vertical_beam_position = static_cast<u16>(1 + state.half_line_count / 2);
 
   if (!(state.half_line_count & 1))
   {
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <mbedtls/md5.h>
@@ -32,6 +33,7 @@
 #include "Common/NandPaths.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/CommonTitles.h"
 #include "Core/HW/WiiSaveStructs.h"
 #include "Core/IOS/ES/ES.h"
@@ -486,30 +488,57 @@ StoragePointer MakeDataBinStorage(IOS::HLE::IOSC* iosc, const std::string& path,
   return StoragePointer{new DataBinStorage{iosc, path, mode}};
 }
 
-CopyResult Copy(Storage* source, Storage* dest)
+// Saves are encrypted or decrypted on this many threads when several are copied.
+constexpr size_t NUM_WORKER_THREADS = 4;
+
+namespace
+{
+// A save which has been read completely, so that it can still be written once its source is gone,
+// or on another thread.
+struct SaveData
+{
+  Header header;
+  BkHeader bk_header;
+  std::vector<Storage::SaveFile> files;
+};
+}  // namespace
+
+static std::optional<SaveData> ReadSave(Storage* source)
 {
   // first make sure we can read all the data from the source
-  const auto header = source->ReadHeader();
+  auto header = source->ReadHeader();
   if (!header)
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to read header");
-    return CopyResult::CorruptedSource;
+    return {};
   }
 
-  const auto bk_header = source->ReadBkHeader();
+  auto bk_header = source->ReadBkHeader();
   if (!bk_header)
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to read bk header");
-    return CopyResult::CorruptedSource;
+    return {};
   }
 
-  const auto files = source->ReadFiles();
+  auto files = source->ReadFiles();
   if (!files)
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to read files");
-    return CopyResult::CorruptedSource;
+    return {};
+  }
+
+  // The contents of the files are read lazily from the source.
+  for (Storage::SaveFile& file : *files)
+  {
+    if (file.type == Storage::SaveFile::Type::File)
+      static_cast<void>(*file.data);
   }
 
+  return SaveData{std::move(*header), std::move(*bk_header), std::move(*files)};
+}
+
+static CopyResult WriteSave(const SaveData& save, Storage* dest)
+{
   // once we have confirmed we can read the source, erase corresponding save in the destination
   if (dest->SaveExists())
   {
@@ -521,19 +550,19 @@ CopyResult Copy(Storage* source, Storage* dest)
   }
 
   // and then write it to the destination
-  if (!dest->WriteHeader(*header))
+  if (!dest->WriteHeader(save.header))
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to write header");
     return CopyResult::Error;
   }
 
-  if (!dest->WriteBkHeader(*bk_header))
+  if (!dest->WriteBkHeader(save.bk_header))
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to write bk header");
     return CopyResult::Error;
   }
 
-  if (!dest->WriteFiles(*files))
+  if (!dest->WriteFiles(save.files))
   {
     ERROR_LOG_FMT(CORE, "WiiSave::Copy: Failed to write files");
     return CopyResult::Error;
@@ -542,6 +571,14 @@ CopyResult Copy(Storage* source, Storage* dest)
   return CopyResult::Success;
 }
 
+CopyResult Copy(Storage* source, Storage* dest)
+{
+  const std::optional<SaveData> save = ReadSave(source);
+  if (!save)
+    return CopyResult::CorruptedSource;
+  return WriteSave(*save, dest);
+}
+
 CopyResult Import(const std::string& data_bin_path, std::function<bool()> can_overwrite)
 {
   IOS::HLE::Kernel ios;
@@ -566,30 +603,110 @@ CopyResult Import(const std::string& data_bin_path, std::function<bool()> can_ov
   return Copy(data_bin.get(), nand.get());
 }
 
-static CopyResult Export(u64 tid, std::string_view export_path, IOS::HLE::Kernel* ios)
+static std::string GetDataBinPath(std::string_view export_path, u64 tid)
 {
-  const std::string path = fmt::format("{}/private/wii/title/{}{}{}{}/data.bin", export_path,
-                                       static_cast<char>(tid >> 24), static_cast<char>(tid >> 16),
-                                       static_cast<char>(tid >> 8), static_cast<char>(tid));
-  return Copy(MakeNandStorage(ios->GetFS().get(), tid).get(),
-              MakeDataBinStorage(&ios->GetIOSC(), path, "w+b").get());
+  return fmt::format("{}/private/wii/title/{}{}{}{}/data.bin", export_path,
+                     static_cast<char>(tid >> 24), static_cast<char>(tid >> 16),
+                     static_cast<char>(tid >> 8), static_cast<char>(tid));
 }
 
 CopyResult Export(u64 tid, std::string_view export_path)
 {
   IOS::HLE::Kernel ios;
-  return Export(tid, export_path, &ios);
+  return Copy(MakeNandStorage(ios.GetFS().get(), tid).get(),
+              MakeDataBinStorage(&ios.GetIOSC(), GetDataBinPath(export_path, tid), "w+b").get());
 }
 
 size_t ExportAll(std::string_view export_path)
 {
   IOS::HLE::Kernel ios;
-  size_t exported_save_count = 0;
+  std::atomic<size_t> exported_save_count = 0;
+
+  // The saves are read from the NAND on this thread, and encrypted, signed and written on the
+  // worker threads, which each have their own IOSC.
+  File::CreateFullPath(fmt::format("{}/private/wii/title/", export_path));
+  std::array<IOS::HLE::IOSC, NUM_WORKER_THREADS> worker_iosc;
+  std::array<Common::WorkQueueThread<SaveData>, NUM_WORKER_THREADS> workers;
+  for (size_t i = 0; i < workers.size(); ++i)
+  {
+    workers[i].Reset([&, i](SaveData save) {
+      const auto data_bin = MakeDataBinStorage(
+          &worker_iosc[i], GetDataBinPath(export_path, save.header.tid), "w+b");
+      if (WriteSave(save, data_bin.get()) == CopyResult::Success)
+        ++exported_save_count;
+    });
+  }
+
+  size_t next_worker = 0;
   for (const u64 title : ios.GetES()->GetInstalledTitles())
   {
-    if (Export(title, export_path, &ios) == CopyResult::Success)
-      ++exported_save_count;
+    std::optional<SaveData> save = ReadSave(MakeNandStorage(ios.GetFS().get(), title).get());
+    if (!save)
+      continue;
+
+    workers[next_worker].EmplaceItem(std::move(*save));
+    next_worker = (next_worker + 1) % workers.size();
   }
+
+  for (auto& worker : workers)
+    worker.Shutdown();
   return exported_save_count;
 }
+
+size_t ImportAll(std::string_view import_path, bool overwrite)
+{
+  IOS::HLE::Kernel ios;
+  std::atomic<size_t> imported_save_count = 0;
+
+  // The data.bin files are read and decrypted on the reader threads, which each have their own
+  // IOSC, while the NAND is only accessed by the writer thread.
+  Common::WorkQueueThread<SaveData> writer([&](SaveData save) {
+    if (!WiiUtils::EnsureTMDIsImported(*ios.GetFS(), *ios.GetES(), save.header.tid))
+    {
+      ERROR_LOG_FMT(CORE, "WiiSave::ImportAll: Failed to find or import TMD for title {:16x}",
+                    save.header.tid);
+      return;
+    }
+
+    const auto nand = MakeNandStorage(ios.GetFS().get(), save.header.tid);
+    if (nand->SaveExists() && !overwrite)
+      return;
+    if (WriteSave(save, nand.get()) == CopyResult::Success)
+      ++imported_save_count;
+  });
+
+  std::array<IOS::HLE::IOSC, NUM_WORKER_THREADS> reader_iosc;
+  std::array<Common::WorkQueueThread<std::string>, NUM_WORKER_THREADS> readers;
+  for (size_t i = 0; i < readers.size(); ++i)
+  {
+    readers[i].Reset([&, i](std::string path) {
+      std::optional<SaveData> save =
+          ReadSave(MakeDataBinStorage(&reader_iosc[i], path, "rb").get());
+      if (!save)
+      {
+        ERROR_LOG_FMT(CORE, "WiiSave::ImportAll: Failed to read {}", path);
+        return;
+      }
+      writer.EmplaceItem(std::move(*save));
+    });
+  }
+
+  size_t next_reader = 0;
+  const File::FSTEntry titles =
+      File::ScanDirectoryTree(fmt::format("{}/private/wii/title", import_path), false);
+  for (const File::FSTEntry& title : titles.children)
+  {
+    std::string path = title.physicalName + "/data.bin";
+    if (!title.isDirectory || !File::Exists(path))
+      continue;
+
+    readers[next_reader].EmplaceItem(std::move(path));
+    next_reader = (next_reader + 1) % readers.size();
+  }
+
+  for (auto& reader : readers)
+    reader.Shutdown();
+  writer.Shutdown();
+  return imported_save_count;
+}
 }  // namespace WiiSave
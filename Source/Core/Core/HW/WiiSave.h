@@ -49,4 +49,7 @@ CopyResult Import(const std::string& data_bin_path, std::function<bool()> can_ov
 CopyResult Export(u64 tid, std::string_view export_path);
 /// Export all saves that are in the NAND. Returns the number of exported saves.
 size_t ExportAll(std::string_view export_path);
+/// Import all saves from a directory that ExportAll exported to. Existing saves are only
+/// replaced if overwrite is set. Returns the number of imported saves.
+size_t ImportAll(std::string_view import_path, bool overwrite);
 }  // namespace WiiSave
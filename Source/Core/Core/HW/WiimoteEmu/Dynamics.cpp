@@ -54,6 +54,19 @@ double CalculateStopDistance(double velocity, double max_accel)
   return velocity * velocity / (2 * std::copysign(max_accel, velocity));
 }
 
+// An input that isn't being used leaves its state at rest at zero, where stepping it changes
+// nothing, so the calculations below can be skipped.
+bool IsAtRest(const WiimoteEmu::PositionalState& state)
+{
+  return state.position == Common::Vec3{} && state.velocity == Common::Vec3{} &&
+         state.acceleration == Common::Vec3{};
+}
+
+bool IsAtRest(const WiimoteEmu::RotationalState& state)
+{
+  return state.angle == Common::Vec3{} && state.angular_velocity == Common::Vec3{};
+}
+
 }  // namespace
 
 namespace WiimoteEmu
@@ -84,6 +97,9 @@ void EmulateShake(PositionalState* state, ControllerEmu::Shake* const shake_grou
                   float time_elapsed)
 {
   auto target_position = shake_group->GetState() * float(shake_group->GetIntensity() / 2);
+  if (target_position == Common::Vec3{} && IsAtRest(*state))
+    return;
+
   for (std::size_t i = 0; i != target_position.data.size(); ++i)
   {
     if (state->velocity.data[i] * std::copysign(1.f, target_position.data[i]) < 0 ||
@@ -117,6 +133,8 @@ void EmulateTilt(RotationalState* state, ControllerEmu::Tilt* const tilt_group,
   const ControlState pitch = target.y * MathUtil::PI;
 
   const auto target_angle = Common::Vec3(pitch, -roll, 0);
+  if (target_angle == Common::Vec3{} && IsAtRest(*state))
+    return;
 
   // For each axis, wrap around current angle if target is farther than 180 degrees.
   for (std::size_t i = 0; i != target_angle.data.size(); ++i)
@@ -134,6 +152,12 @@ void EmulateTilt(RotationalState* state, ControllerEmu::Tilt* const tilt_group,
 void EmulateSwing(MotionState* state, ControllerEmu::Force* swing_group, float time_elapsed)
 {
   const auto input_state = swing_group->GetState();
+  if (input_state == Common::Vec3{} && IsAtRest(static_cast<const PositionalState&>(*state)) &&
+      IsAtRest(static_cast<const RotationalState&>(*state)))
+  {
+    return;
+  }
+
   const float max_distance = swing_group->GetMaxDistance();
   const float max_angle = swing_group->GetTwistAngle();
 
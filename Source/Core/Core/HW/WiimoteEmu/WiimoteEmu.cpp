@@ -464,10 +464,20 @@ void Wiimote::BuildDesiredWiimoteState(DesiredWiimoteState* target_state)
       ConvertAccelData(GetTotalAcceleration(), ACCEL_ZERO_G << 2, ACCEL_ONE_G << 2);
 
   // Calculate IR camera state.
-  target_state->camera_points = CameraLogic::GetCameraPoints(
-      GetTotalTransformation(),
+  // The projection is reused while the Wiimote is held still.
+  const Common::Matrix44 camera_transform = GetTotalTransformation();
+  const Common::Vec2 field_of_view =
       Common::Vec2(m_fov_x_setting.GetValue(), m_fov_y_setting.GetValue()) / 360 *
-          float(MathUtil::TAU));
+      float(MathUtil::TAU);
+  if (!m_camera_points_valid || camera_transform.data != m_camera_transform.data ||
+      field_of_view != m_camera_field_of_view)
+  {
+    m_camera_points = CameraLogic::GetCameraPoints(camera_transform, field_of_view);
+    m_camera_transform = camera_transform;
+    m_camera_field_of_view = field_of_view;
+    m_camera_points_valid = true;
+  }
+  target_state->camera_points = m_camera_points;
 
   // Calculate MotionPlus state.
   if (m_motion_plus_setting.GetValue())
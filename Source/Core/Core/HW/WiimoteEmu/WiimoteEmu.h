@@ -303,6 +303,12 @@ private:
   MotionPlus m_motion_plus;
   CameraLogic m_camera_logic;
 
+  // The last result of CameraLogic::GetCameraPoints and its inputs.
+  Common::Matrix44 m_camera_transform{};
+  Common::Vec2 m_camera_field_of_view{};
+  std::array<CameraPoint, CameraLogic::NUM_POINTS> m_camera_points{};
+  bool m_camera_points_valid = false;
+
   I2CBus m_i2c_bus;
 
   ExtensionPort m_extension_port{&m_i2c_bus};
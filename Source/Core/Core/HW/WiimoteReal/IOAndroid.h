@@ -24,6 +24,7 @@ protected:
   void DisconnectInternal() override;
   bool IsConnected() const override;
   void IOWakeup() override{};
+  bool IOCanWakeup() const override { return false; }
   int IORead(u8* buf) override;
   int IOWrite(u8 const* buf, size_t len) override;
 
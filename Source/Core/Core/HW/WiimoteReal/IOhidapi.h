@@ -22,6 +22,7 @@ protected:
   void DisconnectInternal() override;
   bool IsConnected() const override;
   void IOWakeup() override {}
+  bool IOCanWakeup() const override { return false; }
   int IORead(u8* buf) override;
   int IOWrite(const u8* buf, size_t len) override;
 
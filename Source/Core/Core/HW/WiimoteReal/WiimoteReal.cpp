@@ -4,7 +4,9 @@
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstdlib>
+#include <map>
 #include <mutex>
 #include <queue>
 #include <unordered_set>
@@ -77,6 +79,94 @@ static std::vector<WiimotePoolEntry> s_wiimote_pool;
 
 static WiimoteScanner s_wiimote_scanner;
 
+// Speaker data is written at most this many reports behind the CPU thread, so that pacing it never
+// makes the audio lag behind.
+constexpr u32 MAX_PACED_SPEAKER_DATA_REPORTS = 4;
+// Longer gaps between speaker data reports mean that the game has started a new sound.
+constexpr auto SPEAKER_DATA_STREAM_GAP = std::chrono::milliseconds{100};
+
+// Wakes up the Wii Remote threads when their next speaker data report is due. This is shared by
+// all Wii Remotes, which only need a wakeup now and then.
+class SpeakerDataTimer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  void AddWiimote()
+  {
+    std::lock_guard lk(m_mutex);
+    if (m_num_wiimotes++ != 0)
+      return;
+
+    m_running = true;
+    m_thread = std::thread(&SpeakerDataTimer::ThreadFunc, this);
+  }
+
+  // Must be called once the Wii Remote's thread has stopped.
+  void RemoveWiimote(Wiimote* wiimote)
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_wakeups.erase(wiimote);
+      if (--m_num_wiimotes != 0)
+        return;
+
+      m_running = false;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+  }
+
+  void WakeAt(Wiimote* wiimote, Clock::time_point time)
+  {
+    {
+      std::lock_guard lk(m_mutex);
+      m_wakeups[wiimote] = time;
+    }
+    m_cv.notify_one();
+  }
+
+private:
+  void ThreadFunc()
+  {
+    Common::SetCurrentThreadName("Wiimote Speaker Timer");
+
+    std::unique_lock lk(m_mutex);
+    while (m_running)
+    {
+      const auto now = Clock::now();
+      auto next = Clock::time_point::max();
+      for (auto it = m_wakeups.begin(); it != m_wakeups.end();)
+      {
+        if (it->second <= now)
+        {
+          it->first->IOWakeup();
+          it = m_wakeups.erase(it);
+        }
+        else
+        {
+          next = std::min(next, it->second);
+          ++it;
+        }
+      }
+
+      if (next == Clock::time_point::max())
+        m_cv.wait(lk);
+      else
+        m_cv.wait_until(lk, next);
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::map<Wiimote*, Clock::time_point> m_wakeups;
+  std::thread m_thread;
+  int m_num_wiimotes = 0;
+  bool m_running = false;
+};
+
+static SpeakerDataTimer s_speaker_data_timer;
+
 // Attempt to fill a real wiimote slot from the pool or by stealing from ControllerInterface.
 static void TryToFillWiimoteSlot(u32 index)
 {
@@ -195,6 +285,24 @@ void Wiimote::WriteReport(Report rpt)
       m_speaker_mute = (rpt[2] & 0x4) != 0;
       break;
 
+    case OutputReportID::SpeakerData:
+    {
+      const auto now = std::chrono::steady_clock::now();
+      const auto interval = now - m_last_speaker_data_time;
+      m_last_speaker_data_time = now;
+      if (interval >= SPEAKER_DATA_STREAM_GAP)
+        break;
+
+      // A moving average smooths out the bursts.
+      const s64 interval_us =
+          std::chrono::duration_cast<std::chrono::microseconds>(interval).count();
+      const s64 average_us = m_speaker_data_interval_us.load(std::memory_order_relaxed);
+      m_speaker_data_interval_us.store(
+          average_us == 0 ? interval_us : (average_us * 7 + interval_us) / 8,
+          std::memory_order_relaxed);
+      break;
+    }
+
     default:
       break;
     }
@@ -323,6 +431,28 @@ void Wiimote::Read()
   }
 }
 
+// Returns false if rpt is speaker data which should be written later. The thread is woken up once
+// it is due.
+bool Wiimote::IsWriteDue(const Report& rpt)
+{
+  if (rpt.size() < 2 || rpt[1] != u8(OutputReportID::SpeakerData) || !IOCanWakeup())
+    return true;
+
+  const s64 interval_us = m_speaker_data_interval_us.load(std::memory_order_relaxed);
+  const auto now = std::chrono::steady_clock::now();
+  if (interval_us != 0 && now < m_next_speaker_data_write &&
+      m_write_reports.Size() <= MAX_PACED_SPEAKER_DATA_REPORTS)
+  {
+    s_speaker_data_timer.WakeAt(this, m_next_speaker_data_write);
+    return false;
+  }
+
+  // Slightly faster than the average, so that the queue doesn't build up over time.
+  const auto interval = std::chrono::microseconds{interval_us * 15 / 16};
+  m_next_speaker_data_write = std::max(m_next_speaker_data_write, now - interval) + interval;
+  return true;
+}
+
 bool Wiimote::Write()
 {
   // nothing written, but this is not an error
@@ -330,6 +460,8 @@ bool Wiimote::Write()
     return true;
 
   Report const& rpt = m_write_reports.Front();
+  if (!IsWriteDue(rpt))
+    return true;
 
   if (m_balance_board_dump_port > 0 && m_index == WIIMOTE_BALANCE_BOARD)
   {
@@ -787,6 +919,7 @@ bool Wiimote::Connect(int index)
 
 void Wiimote::StartThread()
 {
+  s_speaker_data_timer.AddWiimote();
   m_wiimote_thread = std::thread(&Wiimote::ThreadFunc, this);
 }
 
@@ -796,6 +929,7 @@ void Wiimote::StopThread()
     return;
   IOWakeup();
   m_wiimote_thread.join();
+  s_speaker_data_timer.RemoveWiimote(this);
 }
 
 void Wiimote::ThreadFunc()
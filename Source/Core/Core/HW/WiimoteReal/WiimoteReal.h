@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -106,8 +107,11 @@ protected:
   u8 m_bt_device_index = 0;
 
 private:
+  friend class SpeakerDataTimer;
+
   void Read();
   bool Write();
+  bool IsWriteDue(const Report& rpt);
 
   void StartThread();
   void StopThread();
@@ -129,6 +133,8 @@ private:
   virtual int IORead(u8* buf) = 0;
   virtual int IOWrite(u8 const* buf, size_t len) = 0;
   virtual void IOWakeup() = 0;
+  // Whether IOWakeup interrupts a pending IORead. Speaker data is only paced if it does.
+  virtual bool IOCanWakeup() const { return true; }
 
   void ThreadFunc();
 
@@ -143,6 +149,13 @@ private:
   // And we track the rumble state to drop unnecessary rumble reports.
   bool m_rumble_state = false;
 
+  // The CPU thread queues speaker data in bursts, which overflow the Wii Remote's small speaker
+  // buffer. The average interval at which it is queued is used to write it out evenly instead.
+  std::chrono::steady_clock::time_point m_last_speaker_data_time;
+  std::atomic<s64> m_speaker_data_interval_us = 0;
+  // Only touched by the Wii Remote thread.
+  std::chrono::steady_clock::time_point m_next_speaker_data_write;
+
   std::thread m_wiimote_thread;
   // Whether to keep running the thread.
   Common::Flag m_run_thread;
@@ -369,6 +369,9 @@ private:
   void FinishInit();
 
   std::string GetContentPath(u64 title_id, const ES::Content& content, Ticks ticks = {}) const;
+  // Remembers that the content file at a path is known to match its hash.
+  void CacheVerifiedContentHash(u64 title_id, const ES::Content& content,
+                                const std::string& path) const;
 
   s32 WriteSystemFile(const std::string& path, const std::vector<u8>& data, Ticks ticks = {});
   s32 WriteLaunchFile(const ES::TMDReader& tmd, Ticks ticks = {});
@@ -14,6 +14,7 @@
 #include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/Crypto/SHA1.h"
 #include "Common/Logging/Log.h"
 #include "Common/NandPaths.h"
@@ -22,6 +23,7 @@
 #include "Core/IOS/ES/Formats.h"
 #include "Core/IOS/FS/FileSystemProxy.h"
 #include "Core/IOS/Uids.h"
+#include "Core/WiiRoot.h"
 
 namespace IOS::HLE
 {
@@ -165,6 +167,77 @@ std::vector<u64> ESDevice::GetTitlesWithTickets() const
   return title_ids;
 }
 
+// Content hashes that were verified are cached by title, content ID, size and modification time,
+// so that checking installed contents again (e.g. before installing a WAD) doesn't have to read
+// and hash them every time.
+constexpr size_t MAX_CACHED_CONTENT_HASHES = 1024;
+
+static std::string GetContentHashCachePath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "es_content_hashes.txt";
+}
+
+// Each line of the cache is the hash, followed by a space and the key.
+static std::string GetContentHashCacheLine(u64 title_id, const ES::Content& content,
+                                           const std::string& path)
+{
+  // There is no modification time for files that only exist in memory.
+  if (Core::GetNandOverlay())
+    return "";
+
+  const File::FileInfo info(Common::RootUserPath(Common::FROM_SESSION_ROOT) + path);
+  const s64 modified = info.GetModificationTime();
+  if (!info.IsFile() || info.GetSize() != content.size || modified == 0)
+    return "";
+
+  return fmt::format("{:02x} {:016x} {:08x} {} {}", fmt::join(content.sha1, ""), title_id,
+                     content.id, content.size, modified);
+}
+
+static std::vector<std::string> ReadContentHashCache()
+{
+  std::string contents;
+  if (!File::ReadFileToString(GetContentHashCachePath(), contents))
+    return {};
+
+  std::vector<std::string> lines = SplitString(contents, '\n');
+  std::erase_if(lines, [](const std::string& line) { return line.empty(); });
+  return lines;
+}
+
+static void AddToContentHashCache(const std::vector<std::string>& new_lines)
+{
+  if (new_lines.empty())
+    return;
+
+  const auto get_key = [](std::string_view line) { return line.substr(line.find(' ') + 1); };
+  std::unordered_set<std::string_view> new_keys;
+  for (const std::string& line : new_lines)
+    new_keys.insert(get_key(line));
+
+  std::vector<std::string> lines = ReadContentHashCache();
+  std::erase_if(lines, [&](const std::string& line) { return new_keys.contains(get_key(line)); });
+  lines.insert(lines.end(), new_lines.begin(), new_lines.end());
+
+  const size_t first = lines.size() > MAX_CACHED_CONTENT_HASHES ?
+                           lines.size() - MAX_CACHED_CONTENT_HASHES :
+                           0;
+  std::string contents;
+  for (size_t i = first; i < lines.size(); ++i)
+    contents += lines[i] + '\n';
+
+  if (!File::WriteStringToFile(GetContentHashCachePath(), contents))
+    WARN_LOG_FMT(IOS_ES, "Failed to write the content hash cache");
+}
+
+void ESDevice::CacheVerifiedContentHash(u64 title_id, const ES::Content& content,
+                                        const std::string& path) const
+{
+  const std::string line = GetContentHashCacheLine(title_id, content, path);
+  if (!line.empty())
+    AddToContentHashCache({line});
+}
+
 std::vector<ES::Content>
 ESDevice::GetStoredContentsFromTMD(const ES::TMDReader& tmd,
                                    CheckContentHashes check_content_hashes) const
@@ -176,8 +249,16 @@ ESDevice::GetStoredContentsFromTMD(const ES::TMDReader& tmd,
 
   std::vector<ES::Content> stored_contents;
 
+  std::unordered_set<std::string> cached_hashes;
+  std::vector<std::string> verified_hashes;
+  if (check_content_hashes == CheckContentHashes::Yes)
+  {
+    const std::vector<std::string> cache = ReadContentHashCache();
+    cached_hashes.insert(cache.begin(), cache.end());
+  }
+
   std::copy_if(contents.begin(), contents.end(), std::back_inserter(stored_contents),
-               [this, &tmd, check_content_hashes](const ES::Content& content) {
+               [&](const ES::Content& content) {
                  const auto fs = m_ios.GetFS();
 
                  const std::string path = GetContentPath(tmd.GetTitleId(), content);
@@ -193,13 +274,24 @@ ESDevice::GetStoredContentsFromTMD(const ES::TMDReader& tmd,
                  if (check_content_hashes == CheckContentHashes::No)
                    return true;
 
+                 const std::string cache_line =
+                     GetContentHashCacheLine(tmd.GetTitleId(), content, path);
+                 if (!cache_line.empty() && cached_hashes.contains(cache_line))
+                   return true;
+
                  // Otherwise, check whether the installed content SHA1 matches the expected hash.
                  std::vector<u8> content_data(file->GetStatus()->size);
                  if (!file->Read(content_data.data(), content_data.size()))
                    return false;
-                 return Common::SHA1::CalculateDigest(content_data) == content.sha1;
+                 if (Common::SHA1::CalculateDigest(content_data) != content.sha1)
+                   return false;
+
+                 if (!cache_line.empty())
+                   verified_hashes.push_back(cache_line);
+                 return true;
                });
 
+  AddToContentHashCache(verified_hashes);
   return stored_contents;
 }
 
@@ -115,6 +115,7 @@ IPCReply ESDevice::ReadContent(u32 uid, const IOCtlVRequest& request)
 
     INFO_LOG_FMT(IOS_ES, "ReadContent(uid={:#x}, cfd={}, size={}, addr={:08x})", uid, cfd, size,
                  addr);
+    Memory::PrepareForHostWrite(addr, size);
     return ReadContent(cfd, Memory::GetPointer(addr), size, uid, ticks);
   });
 }
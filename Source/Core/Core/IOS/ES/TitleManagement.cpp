@@ -420,6 +420,10 @@ ReturnCode ESDevice::ImportContentEnd(Context& context, u32 content_fd)
     return FS::ConvertResult(rename_result);
   }
 
+  // The hash was checked above, so there is no need to check it again when the title is used.
+  CacheVerifiedContentHash(context.title_import_export.tmd.GetTitleId(), content_info,
+                           content_path);
+
   context.title_import_export.content = {};
   return IPC_SUCCESS;
 }
@@ -7,6 +7,8 @@
 #include "Common/FileUtil.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/FS/HostBackend/FS.h"
+#include "Core/IOS/FS/OverlayBackend/FS.h"
+#include "Core/WiiRoot.h"
 
 namespace IOS::HLE::FS
 {
@@ -33,6 +35,15 @@ std::unique_ptr<FileSystem> MakeFileSystem(Location location,
 {
   const std::string nand_root =
       File::GetUserPath(location == Location::Session ? D_SESSION_WIIROOT_IDX : D_WIIROOT_IDX);
+  if (location == Location::Session)
+  {
+    if (std::shared_ptr<NandOverlay> overlay = Core::GetNandOverlay())
+    {
+      return std::make_unique<OverlayFileSystem>(
+          std::move(overlay), std::make_unique<HostFileSystem>(nand_root, nand_redirects),
+          std::move(nand_redirects));
+    }
+  }
   return std::make_unique<HostFileSystem>(nand_root, std::move(nand_redirects));
 }
 
@@ -312,6 +312,7 @@ bool FSDevice::HasCacheForFile(u64 fd, u32 offset) const
 std::optional<IPCReply> FSDevice::Read(const ReadWriteRequest& request)
 {
   return MakeIPCReply([&](Ticks t) {
+    Memory::PrepareForHostWrite(request.buffer, request.size);
     return Read(request.fd, Memory::GetPointer(request.buffer), request.size, request.buffer, t);
   });
 }
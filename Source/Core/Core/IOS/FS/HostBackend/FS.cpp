@@ -124,7 +124,10 @@ HostFileSystem::HostFileSystem(const std::string& root_path,
   LoadFst();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  FlushFst();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
@@ -179,6 +182,8 @@ void HostFileSystem::LoadFst()
 
 void HostFileSystem::SaveFst()
 {
+  m_fst_dirty = false;
+
   std::vector<SerializedFstEntry> to_write;
   auto collect_entries = [&to_write](const auto& collect, const FstEntry& entry) -> void {
     SerializedFstEntry& serialized = to_write.emplace_back();
@@ -205,6 +210,68 @@ void HostFileSystem::SaveFst()
     PanicAlertFmt("IOS_FS: Failed to rename temporary FST file");
 }
 
+void HostFileSystem::FlushFst()
+{
+  if (m_fst_dirty)
+    SaveFst();
+}
+
+HostFileSystem::HostFileInfo HostFileSystem::GetHostFileInfo(const std::string& host_path)
+{
+  const auto [it, inserted] = m_host_file_info.try_emplace(host_path);
+  if (inserted)
+  {
+    const File::FileInfo info{host_path};
+    it->second = {info.Exists(), info.IsFile(), info.GetSize()};
+  }
+  return it->second;
+}
+
+const std::vector<std::string>&
+HostFileSystem::GetHostDirectoryListing(const std::string& host_path)
+{
+  // The root directory's path ends with a slash, unlike the paths of the other directories.
+  std::string key = host_path;
+  while (key.size() > 1 && key.back() == '/')
+    key.pop_back();
+
+  const auto [it, inserted] = m_host_directories.try_emplace(std::move(key));
+  if (inserted)
+  {
+    const File::FSTEntry host_entry = File::ScanDirectoryTree(host_path, false);
+    it->second.reserve(host_entry.children.size());
+    for (const File::FSTEntry& child : host_entry.children)
+    {
+      // Decode escaped invalid file system characters so that games (such as
+      // Harry Potter and the Half-Blood Prince) can find what they expect.
+      it->second.push_back(Common::UnescapeFileName(child.virtualName));
+    }
+  }
+  return it->second;
+}
+
+void HostFileSystem::InvalidateHostPath(const std::string& host_path)
+{
+  const auto is_affected = [&host_path](const std::string& path) {
+    return StringBeginsWith(path, host_path) &&
+           (path.size() == host_path.size() || path[host_path.size()] == '/');
+  };
+
+  std::erase_if(m_host_file_info, [&](const auto& pair) { return is_affected(pair.first); });
+  std::erase_if(m_host_directories, [&](const auto& pair) { return is_affected(pair.first); });
+  m_host_directories.erase(host_path.substr(0, host_path.rfind('/')));
+
+  // Files have to be closed before they can be deleted or renamed on some hosts.
+  std::erase_if(m_pooled_files, [&](const auto& pooled) { return is_affected(pooled.first); });
+}
+
+void HostFileSystem::ClearHostCaches()
+{
+  m_host_file_info.clear();
+  m_host_directories.clear();
+  m_pooled_files.clear();
+}
+
 HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string& path)
 {
   if (path == "/")
@@ -214,8 +281,8 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
     return nullptr;
 
   auto host_file = BuildFilename(path);
-  const File::FileInfo host_file_info{host_file.host_path};
-  if (!host_file_info.Exists())
+  const HostFileInfo host_file_info = GetHostFileInfo(host_file.host_path);
+  if (!host_file_info.exists)
     return nullptr;
 
   FstEntry* entry = host_file.is_redirect ? &m_redirect_fst : &m_root_entry;
@@ -242,7 +309,7 @@ HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string&
     }
   }
 
-  entry->data.is_file = host_file_info.IsFile();
+  entry->data.is_file = host_file_info.is_file;
   if (entry->data.is_file && !entry->children.empty())
   {
     WARN_LOG_FMT(IOS_FS, "{} is a file but also has children; clearing children", path);
@@ -257,6 +324,8 @@ void HostFileSystem::DoState(PointerWrap& p)
   // Temporarily close the file, to prevent any issues with the savestating of /tmp
   for (Handle& handle : m_handles)
     handle.host_file.reset();
+  ClearHostCaches();
+  FlushFst();
 
   // handle /tmp
   std::string Path = BuildFilename("/tmp").host_path;
@@ -354,7 +423,10 @@ void HostFileSystem::DoState(PointerWrap& p)
     p.Do(handle.wii_path);
     p.Do(handle.file_offset);
     if (handle.opened)
-      handle.host_file = OpenHostFile(BuildFilename(handle.wii_path).host_path);
+    {
+      handle.host_path = BuildFilename(handle.wii_path).host_path;
+      handle.host_file = OpenHostFile(handle.host_path);
+    }
   }
 }
 
@@ -365,12 +437,13 @@ ResultCode HostFileSystem::Format(Uid uid)
   if (m_root_path.empty())
     return ResultCode::AccessDenied;
   const std::string root = BuildFilename("/").host_path;
+  // Reset and close all handles.
+  m_handles = {};
+  ClearHostCaches();
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   ResetFst();
   SaveFst();
-  // Reset and close all handles.
-  m_handles = {};
   return ResultCode::Success;
 }
 
@@ -393,9 +466,10 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   if (!parent->CheckPermission(uid, gid, Mode::Write))
     return ResultCode::AccessDenied;
 
-  if (File::Exists(host_path))
+  if (GetHostFileInfo(host_path).exists)
     return ResultCode::AlreadyExists;
 
+  InvalidateHostPath(host_path);
   const bool ok = is_file ? File::CreateEmptyFile(host_path) : File::CreateDir(host_path);
   if (!ok)
   {
@@ -411,7 +485,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.uid = uid;
   child->data.gid = gid;
   child->data.attribute = attr;
-  SaveFst();
+  m_fst_dirty = true;
   return ResultCode::Success;
 }
 
@@ -456,21 +530,24 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (!parent->CheckPermission(uid, gid, Mode::Write))
     return ResultCode::AccessDenied;
 
-  if (!File::Exists(host_path))
+  const HostFileInfo host_file_info = GetHostFileInfo(host_path);
+  if (!host_file_info.exists)
     return ResultCode::NotFound;
 
-  if (File::IsFile(host_path) && !IsFileOpened(path))
+  if (host_file_info.is_file ? IsFileOpened(path) : IsDirectoryInUse(path))
+    return ResultCode::InUse;
+
+  InvalidateHostPath(host_path);
+  if (host_file_info.is_file)
     File::Delete(host_path);
-  else if (File::IsDirectory(host_path) && !IsDirectoryInUse(path))
-    File::DeleteDirRecursively(host_path);
   else
-    return ResultCode::InUse;
+    File::DeleteDirRecursively(host_path);
 
   const auto it = std::find_if(parent->children.begin(), parent->children.end(),
                                GetNamePredicate(split_path.file_name));
   if (it != parent->children.end())
     parent->children.erase(it);
-  SaveFst();
+  m_fst_dirty = true;
 
   return ResultCode::Success;
 }
@@ -515,18 +592,24 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   const std::string& host_new_path = host_new_info.host_path;
 
   // If there is already something of the same type at the new path, delete it.
-  if (File::Exists(host_new_path))
+  const HostFileInfo host_new_file_info = GetHostFileInfo(host_new_path);
+  if (host_new_file_info.exists)
   {
-    const bool old_is_file = File::IsFile(host_old_path);
-    const bool new_is_file = File::IsFile(host_new_path);
-    if (old_is_file && new_is_file)
+    const bool old_is_file = GetHostFileInfo(host_old_path).is_file;
+    const bool new_is_file = host_new_file_info.is_file;
+    if (old_is_file != new_is_file)
+      return ResultCode::Invalid;
+
+    InvalidateHostPath(host_new_path);
+    if (new_is_file)
       File::Delete(host_new_path);
-    else if (!old_is_file && !new_is_file)
-      File::DeleteDirRecursively(host_new_path);
     else
-      return ResultCode::Invalid;
+      File::DeleteDirRecursively(host_new_path);
   }
 
+  InvalidateHostPath(host_old_path);
+  InvalidateHostPath(host_new_path);
+
   if (!File::Rename(host_old_path, host_new_path))
   {
     if (host_old_info.is_redirect || host_new_info.is_redirect)
@@ -566,7 +649,7 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
     old_parent->children.erase(it);
   }
 
-  SaveFst();
+  m_fst_dirty = true;
 
   return ResultCode::Success;
 }
@@ -587,14 +670,7 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid uid, Gid gid,
   if (entry->data.is_file)
     return ResultCode::Invalid;
 
-  const std::string host_path = BuildFilename(path).host_path;
-  File::FSTEntry host_entry = File::ScanDirectoryTree(host_path, false);
-  for (File::FSTEntry& child : host_entry.children)
-  {
-    // Decode escaped invalid file system characters so that games (such as
-    // Harry Potter and the Half-Blood Prince) can find what they expect.
-    child.virtualName = Common::UnescapeFileName(child.virtualName);
-  }
+  std::vector<std::string> output = GetHostDirectoryListing(BuildFilename(path).host_path);
 
   // Sort files according to their order in the FST tree (issue 10234).
   // The result should look like this:
@@ -612,21 +688,18 @@ Result<std::vector<std::string>> HostFileSystem::ReadDirectory(Uid uid, Gid gid,
 
   // Now sort in reverse order because Nintendo traverses a linked list
   // in which new elements are inserted at the front.
-  std::sort(host_entry.children.begin(), host_entry.children.end(),
-            [&get_key](const File::FSTEntry& one, const File::FSTEntry& two) {
-              const int key1 = get_key(one.virtualName);
-              const int key2 = get_key(two.virtualName);
+  std::sort(output.begin(), output.end(),
+            [&get_key](const std::string& one, const std::string& two) {
+              const int key1 = get_key(one);
+              const int key2 = get_key(two);
               if (key1 != key2)
                 return key1 > key2;
 
               // For files that are not in the FST, sort lexicographically to ensure that
               // results are consistent no matter what the underlying filesystem is.
-              return one.virtualName > two.virtualName;
+              return one > two;
             });
 
-  std::vector<std::string> output;
-  for (const File::FSTEntry& child : host_entry.children)
-    output.emplace_back(child.virtualName);
   return output;
 }
 
@@ -655,7 +728,7 @@ Result<Metadata> HostFileSystem::GetMetadata(Uid uid, Gid gid, const std::string
     return ResultCode::NotFound;
 
   Metadata metadata = entry->data;
-  metadata.size = File::GetSize(BuildFilename(path).host_path);
+  metadata.size = GetHostFileInfo(BuildFilename(path).host_path).size;
   return metadata;
 }
 
@@ -674,7 +747,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   if (caller_uid != 0 && uid != entry->data.uid)
     return ResultCode::AccessDenied;
 
-  const bool is_empty = File::GetSize(BuildFilename(path).host_path) == 0;
+  const bool is_empty = GetHostFileInfo(BuildFilename(path).host_path).size == 0;
   if (entry->data.uid != uid && entry->data.is_file && !is_empty)
     return ResultCode::FileNotEmpty;
 
@@ -685,7 +758,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
     entry->data.uid = uid;
     entry->data.attribute = attr;
     entry->data.modes = modes;
-    SaveFst();
+    m_fst_dirty = true;
   }
 
   return ResultCode::Success;
@@ -735,5 +808,6 @@ Result<DirectoryStats> HostFileSystem::GetDirectoryStats(const std::string& wii_
 void HostFileSystem::SetNandRedirects(std::vector<NandRedirect> nand_redirects)
 {
   m_nand_redirects = std::move(nand_redirects);
+  ClearHostCaches();
 }
 }  // namespace IOS::HLE::FS
@@ -4,9 +4,12 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -78,6 +81,7 @@ private:
     bool opened = false;
     Mode mode = Mode::None;
     std::string wii_path;
+    std::string host_path;
     std::shared_ptr<File::IOFile> host_file;
     u32 file_offset = 0;
   };
@@ -93,6 +97,22 @@ private:
   HostFilename BuildFilename(const std::string& wii_path) const;
   std::shared_ptr<File::IOFile> OpenHostFile(const std::string& host_path);
 
+  struct HostFileInfo
+  {
+    bool exists = false;
+    bool is_file = false;
+    u64 size = 0;
+  };
+  /// Host file information and directory listings are cached, as games access the NAND a lot and
+  /// the host file system can be slow (e.g. on network drives). The caches assume that nothing
+  /// but this class modifies the NAND while it is in use.
+  HostFileInfo GetHostFileInfo(const std::string& host_path);
+  const std::vector<std::string>& GetHostDirectoryListing(const std::string& host_path);
+  /// Must be called before modifying a host path. Forgets cached information about the path,
+  /// everything inside of it and its parent directory's listing, and closes pooled files in it.
+  void InvalidateHostPath(const std::string& host_path);
+  void ClearHostCaches();
+
   ResultCode CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
                                    FileAttribute attribute, Modes modes, bool is_file);
   bool IsFileOpened(const std::string& path) const;
@@ -102,6 +122,8 @@ private:
   void ResetFst();
   void LoadFst();
   void SaveFst();
+  /// Saves the FST if it was changed since it was last saved.
+  void FlushFst();
   /// Get the FST entry for a file (or directory).
   /// Automatically creates fallback entries for parents if they do not exist.
   /// Returns nullptr if the path is invalid or the file does not exist.
@@ -120,6 +142,16 @@ private:
   std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
 
+  /// Changes to the FST are written back to the host when a file is closed instead of after
+  /// every operation, since games tend to make several changes in a row.
+  bool m_fst_dirty = false;
+
+  std::unordered_map<std::string, HostFileInfo> m_host_file_info;
+  std::unordered_map<std::string, std::vector<std::string>> m_host_directories;
+  /// Recently used host files, most recent first, which are kept open after the emulated
+  /// software closes them so that reopening them doesn't have to go to the host.
+  std::deque<std::pair<std::string, std::shared_ptr<File::IOFile>>> m_pooled_files;
+
   FstEntry m_redirect_fst{};
   std::vector<NandRedirect> m_nand_redirects;
 };
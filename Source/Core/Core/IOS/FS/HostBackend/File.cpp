@@ -13,6 +13,8 @@
 
 namespace IOS::HLE::FS
 {
+constexpr size_t MAX_POOLED_FILES = 16;
+
 // This isn't theadsafe, but it's only called from the CPU thread.
 std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
 {
@@ -32,12 +34,22 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   //    - Wii System Menu (Can't access the system settings, gets stuck on blank screen)
   //    - The Beatles: Rock Band (saving doesn't work)
 
+  // Keep the file open for a while after it's closed, as games tend to open the same few files
+  // over and over again.
+  const auto pool = [this, &host_path](std::shared_ptr<File::IOFile> file) {
+    std::erase_if(m_pooled_files, [&](const auto& pooled) { return pooled.first == host_path; });
+    m_pooled_files.emplace_front(host_path, file);
+    if (m_pooled_files.size() > MAX_POOLED_FILES)
+      m_pooled_files.pop_back();
+    return file;
+  };
+
   // Check if the file has already been opened.
   auto search = m_open_files.find(host_path);
   if (search != m_open_files.end())
   {
     // Lock a shared pointer to use.
-    return search->second.lock();
+    return pool(search->second.lock());
   }
 
   // All files are opened read/write. Actual access rights will be controlled per handle by the
@@ -71,7 +83,7 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
   // Store a weak pointer to our newly opened file in the cache.
   m_open_files[host_path] = std::weak_ptr<File::IOFile>(file_ptr);
 
-  return file_ptr;
+  return pool(std::move(file_ptr));
 }
 
 Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
@@ -81,7 +93,7 @@ Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, M
     return ResultCode::NoFreeHandle;
 
   const std::string host_path = BuildFilename(path).host_path;
-  if (!File::IsFile(host_path))
+  if (!GetHostFileInfo(host_path).is_file)
   {
     *handle = Handle{};
     return ResultCode::NotFound;
@@ -95,6 +107,7 @@ Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, M
   }
 
   handle->wii_path = path;
+  handle->host_path = host_path;
   handle->mode = mode;
   handle->file_offset = 0;
   return FileHandle{this, ConvertHandleToFd(handle)};
@@ -106,9 +119,16 @@ ResultCode HostFileSystem::Close(Fd fd)
   if (!handle)
     return ResultCode::Invalid;
 
+  // The file may be kept open in the pool, so make sure that what was written reaches the host.
+  if ((u8(handle->mode) & u8(Mode::Write)) != 0 && handle->host_file)
+    handle->host_file->Flush();
+
   // Let go of our pointer to the file, it will automatically close if we are the last handle
   // accessing it.
   *handle = Handle{};
+
+  // Games are usually done making changes to the file system when they close a file.
+  FlushFst();
   return ResultCode::Success;
 }
 
@@ -154,6 +174,11 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
     return ResultCode::AccessDenied;
 
   handle->file_offset += count;
+
+  const auto info = m_host_file_info.find(handle->host_path);
+  if (info != m_host_file_info.end())
+    info->second.size = std::max<u64>(info->second.size, handle->file_offset);
+
   return count;
 }
 
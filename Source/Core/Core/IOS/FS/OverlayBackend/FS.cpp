@@ -0,0 +1,929 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/IOS/FS/OverlayBackend/FS.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+#include "Common/ChunkFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace IOS::HLE::FS
+{
+using Node = NandOverlay::Node;
+
+static std::string JoinPath(const std::string& parent, const std::string& name)
+{
+  return parent == "/" ? "/" + name : parent + '/' + name;
+}
+
+static bool CheckPermission(const Metadata& metadata, Uid caller_uid, Gid caller_gid,
+                            Mode requested_mode)
+{
+  if (caller_uid == 0)
+    return true;
+  Mode file_mode = metadata.modes.other;
+  if (metadata.uid == caller_uid)
+    file_mode = metadata.modes.owner;
+  else if (metadata.gid == caller_gid)
+    file_mode = metadata.modes.group;
+  return (u8(requested_mode) & u8(file_mode)) == u8(requested_mode);
+}
+
+static auto FindChild(std::vector<Node>& children, const std::string& name)
+{
+  return std::find_if(children.begin(), children.end(),
+                      [&name](const Node& child) { return child.name == name; });
+}
+
+static void DoNode(PointerWrap& p, Node& node)
+{
+  p.Do(node.name);
+  p.Do(node.type);
+  p.Do(node.metadata);
+
+  bool has_data = node.data != nullptr;
+  p.Do(has_data);
+  if (p.IsReadMode())
+    node.data = has_data ? std::make_shared<std::vector<u8>>() : nullptr;
+  if (has_data)
+    p.Do(*node.data);
+
+  u32 num_children = static_cast<u32>(node.children.size());
+  p.Do(num_children);
+  if (p.IsReadMode())
+    node.children.resize(num_children);
+  for (Node& child : node.children)
+    DoNode(p, child);
+}
+
+void NandOverlay::DoState(PointerWrap& p)
+{
+  DoNode(p, root);
+}
+
+static bool CommitNode(FileSystem* target, const Node& node, const std::string& path);
+
+static bool CommitChildren(FileSystem* target, const Node& node, const std::string& path)
+{
+  bool success = true;
+  for (const Node& child : node.children)
+  {
+    const std::string child_path = JoinPath(path, child.name);
+    if (!CommitNode(target, child, child_path))
+    {
+      ERROR_LOG_FMT(IOS_FS, "Failed to write {} back from the NAND overlay", child_path);
+      success = false;
+    }
+  }
+  return success;
+}
+
+static bool CommitMetadata(FileSystem* target, const Node& node, const std::string& path)
+{
+  if (!node.metadata)
+    return true;
+  const Metadata& metadata = *node.metadata;
+  return target->SetMetadata(0, path, metadata.uid, metadata.gid, metadata.attribute,
+                             metadata.modes) == ResultCode::Success;
+}
+
+static bool CommitNode(FileSystem* target, const Node& node, const std::string& path)
+{
+  switch (node.type)
+  {
+  case Node::Type::Base:
+    if (!CommitMetadata(target, node, path))
+      return false;
+    break;
+  case Node::Type::Deleted:
+  {
+    const ResultCode result = target->Delete(0, 0, path);
+    return result == ResultCode::Success || result == ResultCode::NotFound;
+  }
+  case Node::Type::File:
+  case Node::Type::Directory:
+  {
+    const ResultCode delete_result = target->Delete(0, 0, path);
+    if (delete_result != ResultCode::Success && delete_result != ResultCode::NotFound)
+      return false;
+
+    const Metadata& metadata = *node.metadata;
+    const bool is_file = node.type == Node::Type::File;
+    const ResultCode create_result =
+        is_file ? target->CreateFile(0, 0, path, metadata.attribute, metadata.modes) :
+                  target->CreateDirectory(0, 0, path, metadata.attribute, metadata.modes);
+    // The owner can only be changed while the file is still empty.
+    if (create_result != ResultCode::Success || !CommitMetadata(target, node, path))
+      return false;
+
+    if (is_file)
+    {
+      const Result<FileHandle> file = target->OpenFile(0, 0, path, Mode::Write);
+      if (!file || !file->Write(node.data->data(), node.data->size()))
+        return false;
+    }
+    break;
+  }
+  }
+
+  return CommitChildren(target, node, path);
+}
+
+bool NandOverlay::Commit(FileSystem* target) const
+{
+  // The root directory can't be replaced, only emptied.
+  if (root.type == Node::Type::Directory && target->Format(0) != ResultCode::Success)
+    return false;
+  return CommitMetadata(target, root, "/") && CommitChildren(target, root, "/");
+}
+
+OverlayFileSystem::OverlayFileSystem(std::shared_ptr<NandOverlay> overlay,
+                                     std::unique_ptr<FileSystem> base,
+                                     std::vector<NandRedirect> nand_redirects)
+    : m_overlay{std::move(overlay)}, m_base{std::move(base)},
+      m_nand_redirects(std::move(nand_redirects))
+{
+}
+
+OverlayFileSystem::~OverlayFileSystem()
+{
+  for (Handle& handle : m_handles)
+    CloseHandle(&handle);
+}
+
+bool OverlayFileSystem::IsRedirected(const std::string& path) const
+{
+  return std::any_of(m_nand_redirects.begin(), m_nand_redirects.end(),
+                     [&path](const NandRedirect& redirect) {
+                       return StringBeginsWith(path, redirect.source_path) &&
+                              (path.size() == redirect.source_path.size() ||
+                               path[redirect.source_path.size()] == '/');
+                     });
+}
+
+OverlayFileSystem::Lookup OverlayFileSystem::Find(const std::string& path)
+{
+  Node* node = &m_overlay->root;
+  if (path != "/")
+  {
+    for (const std::string& component : SplitString(path.substr(1), '/'))
+    {
+      const auto it = FindChild(node->children, component);
+      if (it == node->children.end())
+      {
+        // Nothing below this point was changed, so the rest of the path is up to the base NAND.
+        if (node->type != Node::Type::Base || !m_base->GetMetadata(0, 0, path))
+          return {};
+        return {Lookup::Source::Base, nullptr};
+      }
+
+      node = &*it;
+      if (node->type == Node::Type::Deleted)
+        return {};
+    }
+  }
+
+  return {node->type == Node::Type::Base ? Lookup::Source::Base : Lookup::Source::Overlay, node};
+}
+
+Node* OverlayFileSystem::GetOrCreateNode(const std::string& path)
+{
+  Node* node = &m_overlay->root;
+  if (path == "/")
+    return node;
+
+  for (const std::string& component : SplitString(path.substr(1), '/'))
+  {
+    const auto it = FindChild(node->children, component);
+    if (it != node->children.end())
+    {
+      node = &*it;
+      continue;
+    }
+
+    node = &node->children.emplace_back();
+    node->name = component;
+  }
+  return node;
+}
+
+Result<Metadata> OverlayFileSystem::GetEntryMetadata(const std::string& path)
+{
+  if (IsRedirected(path))
+    return m_base->GetMetadata(0, 0, path);
+
+  const Lookup lookup = Find(path);
+  if (lookup.source == Lookup::Source::None)
+    return ResultCode::NotFound;
+
+  if (lookup.source == Lookup::Source::Overlay)
+  {
+    Metadata metadata = *lookup.node->metadata;
+    metadata.size = lookup.node->data ? static_cast<u32>(lookup.node->data->size()) : 0;
+    return metadata;
+  }
+
+  Result<Metadata> metadata = m_base->GetMetadata(0, 0, path);
+  if (metadata && lookup.node && lookup.node->metadata)
+  {
+    const Metadata& changed = *lookup.node->metadata;
+    metadata->uid = changed.uid;
+    metadata->gid = changed.gid;
+    metadata->attribute = changed.attribute;
+    metadata->modes = changed.modes;
+  }
+  return metadata;
+}
+
+Result<Node> OverlayFileSystem::Materialize(const std::string& path)
+{
+  if (!IsRedirected(path))
+  {
+    const Lookup lookup = Find(path);
+    if (lookup.source == Lookup::Source::None)
+      return ResultCode::NotFound;
+    if (lookup.source == Lookup::Source::Overlay)
+      return *lookup.node;
+  }
+
+  const Result<Metadata> metadata = GetEntryMetadata(path);
+  if (!metadata)
+    return metadata.Error();
+
+  Node node;
+  node.name = SplitPathAndBasename(path).file_name;
+  node.metadata = *metadata;
+
+  if (metadata->is_file)
+  {
+    node.type = Node::Type::File;
+    node.data = std::make_shared<std::vector<u8>>(metadata->size);
+
+    const Result<FileHandle> file = m_base->OpenFile(0, 0, path, Mode::Read);
+    if (!file)
+      return file.Error();
+    const Result<size_t> result = file->Read(node.data->data(), node.data->size());
+    if (!result)
+      return result.Error();
+  }
+  else
+  {
+    node.type = Node::Type::Directory;
+
+    const Result<std::vector<std::string>> children = ReadDirectory(0, 0, path);
+    if (!children)
+      return children.Error();
+
+    // Directory listings start with the newest entry.
+    for (auto it = children->rbegin(); it != children->rend(); ++it)
+    {
+      Result<Node> child = Materialize(JoinPath(path, *it));
+      if (!child)
+        return child.Error();
+      node.children.push_back(std::move(*child));
+    }
+  }
+
+  return node;
+}
+
+Result<Node*> OverlayFileSystem::CopyUp(const std::string& path)
+{
+  Result<Node> node = Materialize(path);
+  if (!node)
+    return node.Error();
+  if (node->type != Node::Type::File)
+    return ResultCode::NotFound;
+
+  Node* target = GetOrCreateNode(path);
+  *target = std::move(*node);
+
+  // Handles that were reading the base file have to see writes from now on.
+  for (Handle& handle : m_handles)
+  {
+    if (!handle.opened || !handle.base_fd || handle.wii_path != path)
+      continue;
+
+    const Result<FileStatus> status = m_base->GetFileStatus(*handle.base_fd);
+    m_base->Close(*handle.base_fd);
+    handle.base_fd.reset();
+    handle.data = target->data;
+    handle.file_offset = status ? status->offset : 0;
+  }
+
+  return target;
+}
+
+ResultCode OverlayFileSystem::AddEntry(const std::string& path, Node node)
+{
+  if (IsRedirected(path))
+  {
+    const ResultCode result = m_base->Delete(0, 0, path);
+    if (result != ResultCode::Success && result != ResultCode::NotFound)
+      return result;
+    return CommitNode(m_base.get(), node, path) ? ResultCode::Success : ResultCode::UnknownError;
+  }
+
+  const auto split_path = SplitPathAndBasename(path);
+  node.name = split_path.file_name;
+
+  // Whatever was there before is gone, so newer entries are always at the end.
+  Node* parent = GetOrCreateNode(split_path.parent);
+  std::erase_if(parent->children, [&node](const Node& child) { return child.name == node.name; });
+  parent->children.push_back(std::move(node));
+  return ResultCode::Success;
+}
+
+ResultCode OverlayFileSystem::RemoveEntry(const std::string& path)
+{
+  if (IsRedirected(path))
+    return m_base->Delete(0, 0, path);
+
+  const auto split_path = SplitPathAndBasename(path);
+  const bool parent_in_base = Find(split_path.parent).source == Lookup::Source::Base;
+
+  Node* parent = GetOrCreateNode(split_path.parent);
+  std::erase_if(parent->children,
+                [&split_path](const Node& child) { return child.name == split_path.file_name; });
+
+  // The base NAND's entry has to stay hidden.
+  if (parent_in_base)
+  {
+    Node& deleted = parent->children.emplace_back();
+    deleted.name = split_path.file_name;
+    deleted.type = Node::Type::Deleted;
+  }
+
+  return ResultCode::Success;
+}
+
+void OverlayFileSystem::DoState(PointerWrap& p)
+{
+  // The base NAND doesn't change, so only the overlay has to be saved.
+  p.DoMarker("NandOverlay");
+  m_overlay->DoState(p);
+
+  for (Handle& handle : m_handles)
+  {
+    if (!p.IsReadMode() && handle.base_fd)
+    {
+      const Result<FileStatus> status = m_base->GetFileStatus(*handle.base_fd);
+      handle.file_offset = status ? status->offset : 0;
+    }
+
+    bool opened = handle.opened;
+    Mode mode = handle.mode;
+    std::string wii_path = handle.wii_path;
+    u32 file_offset = handle.file_offset;
+    p.Do(opened);
+    p.Do(mode);
+    p.Do(wii_path);
+    p.Do(file_offset);
+
+    if (!p.IsReadMode())
+      continue;
+
+    CloseHandle(&handle);
+    if (!opened)
+      continue;
+
+    handle.opened = true;
+    handle.mode = mode;
+    handle.wii_path = wii_path;
+    if (OpenHandle(&handle) != ResultCode::Success)
+    {
+      ERROR_LOG_FMT(IOS_FS, "Failed to reopen {} after loading a state", wii_path);
+      CloseHandle(&handle);
+      continue;
+    }
+
+    if (handle.base_fd)
+      m_base->SeekFile(*handle.base_fd, file_offset, SeekMode::Set);
+    else
+      handle.file_offset = file_offset;
+  }
+}
+
+ResultCode OverlayFileSystem::Format(Uid uid)
+{
+  if (uid != 0)
+    return ResultCode::AccessDenied;
+
+  for (Handle& handle : m_handles)
+    CloseHandle(&handle);
+
+  // Mode 0x16 (Directory | Owner_None | Group_Read | Other_Read) in the FS sysmodule
+  Metadata metadata{};
+  metadata.modes = {Mode::None, Mode::Read, Mode::Read};
+
+  m_overlay->root = {};
+  m_overlay->root.name = "/";
+  m_overlay->root.type = Node::Type::Directory;
+  m_overlay->root.metadata = metadata;
+  return ResultCode::Success;
+}
+
+ResultCode OverlayFileSystem::OpenHandle(Handle* handle)
+{
+  const std::string& path = handle->wii_path;
+
+  if (!IsRedirected(path))
+  {
+    const Lookup lookup = Find(path);
+    if (lookup.source == Lookup::Source::None ||
+        (lookup.source == Lookup::Source::Overlay && !lookup.node->data))
+    {
+      return ResultCode::NotFound;
+    }
+
+    if (lookup.source == Lookup::Source::Overlay)
+    {
+      handle->data = lookup.node->data;
+      return ResultCode::Success;
+    }
+
+    if ((u8(handle->mode) & u8(Mode::Write)) != 0)
+    {
+      const Result<Node*> node = CopyUp(path);
+      if (!node)
+        return node.Error();
+      handle->data = (*node)->data;
+      return ResultCode::Success;
+    }
+  }
+
+  Result<FileHandle> file = m_base->OpenFile(0, 0, path, handle->mode);
+  if (!file)
+    return file.Error();
+  handle->base_fd = file->Release();
+  return ResultCode::Success;
+}
+
+void OverlayFileSystem::CloseHandle(Handle* handle)
+{
+  if (handle->base_fd)
+    m_base->Close(*handle->base_fd);
+  *handle = Handle{};
+}
+
+Result<FileHandle> OverlayFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
+{
+  Handle* handle = AssignFreeHandle();
+  if (!handle)
+    return ResultCode::NoFreeHandle;
+
+  handle->wii_path = path;
+  handle->mode = mode;
+  const ResultCode result = OpenHandle(handle);
+  if (result != ResultCode::Success)
+  {
+    CloseHandle(handle);
+    return result;
+  }
+
+  return FileHandle{this, ConvertHandleToFd(handle)};
+}
+
+ResultCode OverlayFileSystem::Close(Fd fd)
+{
+  Handle* handle = GetHandleFromFd(fd);
+  if (!handle)
+    return ResultCode::Invalid;
+
+  CloseHandle(handle);
+  return ResultCode::Success;
+}
+
+Result<u32> OverlayFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
+{
+  Handle* handle = GetHandleFromFd(fd);
+  if (!handle)
+    return ResultCode::Invalid;
+
+  if ((u8(handle->mode) & u8(Mode::Read)) == 0)
+    return ResultCode::AccessDenied;
+
+  if (handle->base_fd)
+    return m_base->ReadBytesFromFile(*handle->base_fd, ptr, count);
+
+  // IOS has this check in the read request handler.
+  const u32 file_size = static_cast<u32>(handle->data->size());
+  count = std::min(count, file_size - handle->file_offset);
+
+  std::memcpy(ptr, handle->data->data() + handle->file_offset, count);
+  handle->file_offset += count;
+  return count;
+}
+
+Result<u32> OverlayFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
+{
+  Handle* handle = GetHandleFromFd(fd);
+  if (!handle)
+    return ResultCode::Invalid;
+
+  if ((u8(handle->mode) & u8(Mode::Write)) == 0)
+    return ResultCode::AccessDenied;
+
+  if (handle->base_fd)
+    return m_base->WriteBytesToFile(*handle->base_fd, ptr, count);
+
+  const size_t end = size_t(handle->file_offset) + count;
+  if (end > handle->data->size())
+    handle->data->resize(end);
+
+  std::memcpy(handle->data->data() + handle->file_offset, ptr, count);
+  handle->file_offset += count;
+  return count;
+}
+
+Result<u32> OverlayFileSystem::SeekFile(Fd fd, u32 offset, SeekMode mode)
+{
+  Handle* handle = GetHandleFromFd(fd);
+  if (!handle)
+    return ResultCode::Invalid;
+
+  if (handle->base_fd)
+    return m_base->SeekFile(*handle->base_fd, offset, mode);
+
+  const u32 file_size = static_cast<u32>(handle->data->size());
+  u32 new_position = 0;
+  switch (mode)
+  {
+  case SeekMode::Set:
+    new_position = offset;
+    break;
+  case SeekMode::Current:
+    new_position = handle->file_offset + offset;
+    break;
+  case SeekMode::End:
+    new_position = file_size + offset;
+    break;
+  default:
+    return ResultCode::Invalid;
+  }
+
+  // This differs from POSIX behaviour which allows seeking past the end of the file.
+  if (file_size < new_position)
+    return ResultCode::Invalid;
+
+  handle->file_offset = new_position;
+  return handle->file_offset;
+}
+
+Result<FileStatus> OverlayFileSystem::GetFileStatus(Fd fd)
+{
+  const Handle* handle = GetHandleFromFd(fd);
+  if (!handle)
+    return ResultCode::Invalid;
+
+  if (handle->base_fd)
+    return m_base->GetFileStatus(*handle->base_fd);
+
+  FileStatus status;
+  status.size = static_cast<u32>(handle->data->size());
+  status.offset = handle->file_offset;
+  return status;
+}
+
+ResultCode OverlayFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
+                                                    FileAttribute attr, Modes modes, bool is_file)
+{
+  if (IsRedirected(path))
+  {
+    return is_file ? m_base->CreateFile(uid, gid, path, attr, modes) :
+                     m_base->CreateDirectory(uid, gid, path, attr, modes);
+  }
+
+  if (!IsValidNonRootPath(path) || !std::all_of(path.begin(), path.end(), IsPrintableCharacter))
+    return ResultCode::Invalid;
+
+  if (!is_file && std::count(path.begin(), path.end(), '/') > int(MaxPathDepth))
+    return ResultCode::TooManyPathComponents;
+
+  const Result<Metadata> parent = GetEntryMetadata(SplitPathAndBasename(path).parent);
+  if (!parent || parent->is_file)
+    return ResultCode::NotFound;
+
+  if (!CheckPermission(*parent, uid, gid, Mode::Write))
+    return ResultCode::AccessDenied;
+
+  if (Find(path).source != Lookup::Source::None)
+    return ResultCode::AlreadyExists;
+
+  Node node;
+  node.type = is_file ? Node::Type::File : Node::Type::Directory;
+  node.metadata = Metadata{};
+  node.metadata->uid = uid;
+  node.metadata->gid = gid;
+  node.metadata->attribute = attr;
+  node.metadata->modes = modes;
+  node.metadata->is_file = is_file;
+  if (is_file)
+    node.data = std::make_shared<std::vector<u8>>();
+  return AddEntry(path, std::move(node));
+}
+
+ResultCode OverlayFileSystem::CreateFile(Uid uid, Gid gid, const std::string& path,
+                                         FileAttribute attr, Modes modes)
+{
+  return CreateFileOrDirectory(uid, gid, path, attr, modes, true);
+}
+
+ResultCode OverlayFileSystem::CreateDirectory(Uid uid, Gid gid, const std::string& path,
+                                              FileAttribute attr, Modes modes)
+{
+  return CreateFileOrDirectory(uid, gid, path, attr, modes, false);
+}
+
+bool OverlayFileSystem::IsFileOpened(const std::string& path) const
+{
+  return std::any_of(m_handles.begin(), m_handles.end(), [&path](const Handle& handle) {
+    return handle.opened && handle.wii_path == path;
+  });
+}
+
+bool OverlayFileSystem::IsDirectoryInUse(const std::string& path) const
+{
+  return std::any_of(m_handles.begin(), m_handles.end(), [&path](const Handle& handle) {
+    return handle.opened && StringBeginsWith(handle.wii_path, path);
+  });
+}
+
+ResultCode OverlayFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
+{
+  if (!IsValidNonRootPath(path))
+    return ResultCode::Invalid;
+
+  if (IsRedirected(path))
+    return m_base->Delete(uid, gid, path);
+
+  const Result<Metadata> parent = GetEntryMetadata(SplitPathAndBasename(path).parent);
+  if (!parent)
+    return ResultCode::NotFound;
+
+  if (!CheckPermission(*parent, uid, gid, Mode::Write))
+    return ResultCode::AccessDenied;
+
+  const Result<Metadata> metadata = GetEntryMetadata(path);
+  if (!metadata)
+    return ResultCode::NotFound;
+
+  if (metadata->is_file ? IsFileOpened(path) : IsDirectoryInUse(path))
+    return ResultCode::InUse;
+
+  return RemoveEntry(path);
+}
+
+ResultCode OverlayFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
+                                     const std::string& new_path)
+{
+  if (!IsValidNonRootPath(old_path) || !IsValidNonRootPath(new_path))
+    return ResultCode::Invalid;
+
+  if (IsRedirected(old_path) && IsRedirected(new_path))
+    return m_base->Rename(uid, gid, old_path, new_path);
+
+  const auto split_old_path = SplitPathAndBasename(old_path);
+  const auto split_new_path = SplitPathAndBasename(new_path);
+
+  const Result<Metadata> old_parent = GetEntryMetadata(split_old_path.parent);
+  const Result<Metadata> new_parent = GetEntryMetadata(split_new_path.parent);
+  if (!old_parent || !new_parent)
+    return ResultCode::NotFound;
+
+  if (!CheckPermission(*old_parent, uid, gid, Mode::Write) ||
+      !CheckPermission(*new_parent, uid, gid, Mode::Write))
+  {
+    return ResultCode::AccessDenied;
+  }
+
+  const Result<Metadata> metadata = GetEntryMetadata(old_path);
+  if (!metadata)
+    return ResultCode::NotFound;
+
+  // For files, the file name is not allowed to change.
+  if (metadata->is_file && split_old_path.file_name != split_new_path.file_name)
+    return ResultCode::Invalid;
+
+  if ((!metadata->is_file && IsDirectoryInUse(old_path)) ||
+      (metadata->is_file && IsFileOpened(old_path)))
+  {
+    return ResultCode::InUse;
+  }
+
+  if (old_path == new_path)
+    return ResultCode::Success;
+  if (StringBeginsWith(new_path, old_path + '/'))
+    return ResultCode::Invalid;
+
+  // If there is already something of the same type at the new path, it is replaced.
+  const Result<Metadata> new_metadata = GetEntryMetadata(new_path);
+  if (new_metadata && new_metadata->is_file != metadata->is_file)
+    return ResultCode::Invalid;
+
+  // Entries from the base NAND can't be moved in it, so they are copied into the overlay.
+  Result<Node> node = Materialize(old_path);
+  if (!node)
+    return node.Error();
+
+  const ResultCode remove_result = RemoveEntry(old_path);
+  if (remove_result != ResultCode::Success)
+    return remove_result;
+
+  return AddEntry(new_path, std::move(*node));
+}
+
+Result<std::vector<std::string>> OverlayFileSystem::ReadDirectory(Uid uid, Gid gid,
+                                                                  const std::string& path)
+{
+  if (!IsValidPath(path))
+    return ResultCode::Invalid;
+
+  if (IsRedirected(path))
+    return m_base->ReadDirectory(uid, gid, path);
+
+  const Result<Metadata> metadata = GetEntryMetadata(path);
+  if (!metadata)
+    return ResultCode::NotFound;
+
+  if (!CheckPermission(*metadata, uid, gid, Mode::Read))
+    return ResultCode::AccessDenied;
+
+  if (metadata->is_file)
+    return ResultCode::Invalid;
+
+  const Lookup lookup = Find(path);
+
+  std::vector<std::string> output;
+  if (lookup.source == Lookup::Source::Base)
+  {
+    Result<std::vector<std::string>> base_output = m_base->ReadDirectory(0, 0, path);
+    if (!base_output)
+      return base_output.Error();
+    output = std::move(*base_output);
+  }
+
+  if (!lookup.node)
+    return output;
+
+  // Drop the entries that were deleted or replaced in the overlay...
+  std::vector<Node>& children = lookup.node->children;
+  std::erase_if(output, [&children](const std::string& name) {
+    const auto it = FindChild(children, name);
+    return it != children.end() && it->type != Node::Type::Base;
+  });
+
+  // ...and put the ones from the overlay first, since those are the newest. Like in the host
+  // backend, the newest entry comes first.
+  std::vector<std::string> overlay_output;
+  for (auto it = children.rbegin(); it != children.rend(); ++it)
+  {
+    if (it->type == Node::Type::File || it->type == Node::Type::Directory)
+      overlay_output.push_back(it->name);
+  }
+  output.insert(output.begin(), overlay_output.begin(), overlay_output.end());
+
+  return output;
+}
+
+Result<Metadata> OverlayFileSystem::GetMetadata(Uid uid, Gid gid, const std::string& path)
+{
+  if (path == "/")
+    return GetEntryMetadata(path);
+
+  if (!IsValidNonRootPath(path))
+    return ResultCode::Invalid;
+
+  if (IsRedirected(path))
+    return m_base->GetMetadata(uid, gid, path);
+
+  const Result<Metadata> parent = GetEntryMetadata(SplitPathAndBasename(path).parent);
+  if (!parent)
+    return ResultCode::NotFound;
+  if (!CheckPermission(*parent, uid, gid, Mode::Read))
+    return ResultCode::AccessDenied;
+
+  return GetEntryMetadata(path);
+}
+
+ResultCode OverlayFileSystem::SetMetadata(Uid caller_uid, const std::string& path, Uid uid,
+                                          Gid gid, FileAttribute attr, Modes modes)
+{
+  if (!IsValidPath(path))
+    return ResultCode::Invalid;
+
+  if (IsRedirected(path))
+    return m_base->SetMetadata(caller_uid, path, uid, gid, attr, modes);
+
+  const Result<Metadata> metadata = GetEntryMetadata(path);
+  if (!metadata)
+    return ResultCode::NotFound;
+
+  if (caller_uid != 0 && caller_uid != metadata->uid)
+    return ResultCode::AccessDenied;
+  if (caller_uid != 0 && uid != metadata->uid)
+    return ResultCode::AccessDenied;
+
+  if (metadata->uid != uid && metadata->is_file && metadata->size != 0)
+    return ResultCode::FileNotEmpty;
+
+  if (metadata->gid != gid || metadata->uid != uid || metadata->attribute != attr ||
+      metadata->modes != modes)
+  {
+    Node* node = GetOrCreateNode(path);
+    node->metadata = *metadata;
+    node->metadata->uid = uid;
+    node->metadata->gid = gid;
+    node->metadata->attribute = attr;
+    node->metadata->modes = modes;
+  }
+
+  return ResultCode::Success;
+}
+
+Result<NandStats> OverlayFileSystem::GetNandStats()
+{
+  return m_base->GetNandStats();
+}
+
+Result<DirectoryStats> OverlayFileSystem::GetDirectoryStats(const std::string& path)
+{
+  if (!IsValidPath(path))
+    return ResultCode::Invalid;
+
+  if (IsRedirected(path))
+    return m_base->GetDirectoryStats(path);
+
+  DirectoryStats stats{};
+  const Result<Metadata> metadata = GetEntryMetadata(path);
+  if (!metadata || metadata->is_file)
+  {
+    WARN_LOG_FMT(IOS_FS, "fsBlock failed, cannot find directory: {}", path);
+    return stats;
+  }
+
+  // Add one for the directory itself.
+  u32 used_inodes = 1;
+  u64 total_size = 0;
+  const std::function<void(const std::string&)> add_children = [&](const std::string& dir) {
+    const Result<std::vector<std::string>> children = ReadDirectory(0, 0, dir);
+    if (!children)
+      return;
+
+    for (const std::string& name : *children)
+    {
+      const std::string child_path = JoinPath(dir, name);
+      const Result<Metadata> child = GetEntryMetadata(child_path);
+      if (!child)
+        continue;
+
+      ++used_inodes;
+      if (child->is_file)
+        total_size += child->size;
+      else
+        add_children(child_path);
+    }
+  };
+  add_children(path);
+
+  stats.used_inodes = used_inodes;
+  // One block is 16 KiB.
+  stats.used_clusters = static_cast<u32>(total_size / (16 * 1024));
+  return stats;
+}
+
+void OverlayFileSystem::SetNandRedirects(std::vector<NandRedirect> nand_redirects)
+{
+  m_nand_redirects = nand_redirects;
+  m_base->SetNandRedirects(std::move(nand_redirects));
+}
+
+OverlayFileSystem::Handle* OverlayFileSystem::AssignFreeHandle()
+{
+  const auto it = std::find_if(m_handles.begin(), m_handles.end(),
+                               [](const Handle& handle) { return !handle.opened; });
+  if (it == m_handles.end())
+    return nullptr;
+
+  *it = Handle{};
+  it->opened = true;
+  return &*it;
+}
+
+OverlayFileSystem::Handle* OverlayFileSystem::GetHandleFromFd(Fd fd)
+{
+  if (fd >= m_handles.size() || !m_handles[fd].opened)
+    return nullptr;
+  return &m_handles[fd];
+}
+
+Fd OverlayFileSystem::ConvertHandleToFd(const Handle* handle) const
+{
+  return handle - m_handles.data();
+}
+}  // namespace IOS::HLE::FS
@@ -0,0 +1,160 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/IOS/FS/FileSystem.h"
+
+namespace IOS::HLE::FS
+{
+/// Changes made to a NAND through an OverlayFileSystem, kept in memory.
+///
+/// IOS (and with it the file system) is restarted every time a title reloads it, so this is
+/// owned by the emulation session and shared by every OverlayFileSystem created during it.
+class NandOverlay
+{
+public:
+  struct Node
+  {
+    enum class Type : u8
+    {
+      /// The entry from the base NAND. Children are changes to its children.
+      Base,
+      /// A file created or modified in the overlay.
+      File,
+      /// A directory created in the overlay, which hides the base NAND's contents at this path.
+      /// Children are its whole contents.
+      Directory,
+      /// The base NAND's entry at this path was deleted.
+      Deleted,
+    };
+
+    std::string name;
+    Type type = Type::Base;
+    /// Always set for files and directories. Overrides the base NAND's metadata otherwise.
+    std::optional<Metadata> metadata;
+    /// Only valid for files. Shared with the handles that have the file open.
+    std::shared_ptr<std::vector<u8>> data;
+    /// Newly created entries are added at the end.
+    std::vector<Node> children;
+  };
+
+  void DoState(PointerWrap& p);
+
+  /// Writes the changes to another file system, usually the base NAND itself or a copy of it.
+  /// Returns false if any of them couldn't be applied.
+  bool Commit(FileSystem* target) const;
+
+  Node root;
+};
+
+/// Backend that reads from a base NAND and keeps every change in memory instead, so that
+/// several sessions can start from the same NAND without copying or modifying it.
+///
+/// Files are copied into memory the first time they are opened for writing. Paths that are
+/// redirected to the host are not part of the overlay and are passed through to the base.
+class OverlayFileSystem final : public FileSystem
+{
+public:
+  OverlayFileSystem(std::shared_ptr<NandOverlay> overlay, std::unique_ptr<FileSystem> base,
+                    std::vector<NandRedirect> nand_redirects = {});
+  ~OverlayFileSystem();
+
+  void DoState(PointerWrap& p) override;
+
+  ResultCode Format(Uid uid) override;
+
+  Result<FileHandle> OpenFile(Uid uid, Gid gid, const std::string& path, Mode mode) override;
+  ResultCode Close(Fd fd) override;
+  Result<u32> ReadBytesFromFile(Fd fd, u8* ptr, u32 size) override;
+  Result<u32> WriteBytesToFile(Fd fd, const u8* ptr, u32 size) override;
+  Result<u32> SeekFile(Fd fd, u32 offset, SeekMode mode) override;
+  Result<FileStatus> GetFileStatus(Fd fd) override;
+
+  ResultCode CreateFile(Uid caller_uid, Gid caller_gid, const std::string& path,
+                        FileAttribute attribute, Modes modes) override;
+
+  ResultCode CreateDirectory(Uid caller_uid, Gid caller_gid, const std::string& path,
+                             FileAttribute attribute, Modes modes) override;
+
+  ResultCode Delete(Uid caller_uid, Gid caller_gid, const std::string& path) override;
+  ResultCode Rename(Uid caller_uid, Gid caller_gid, const std::string& old_path,
+                    const std::string& new_path) override;
+
+  Result<std::vector<std::string>> ReadDirectory(Uid caller_uid, Gid caller_gid,
+                                                 const std::string& path) override;
+
+  Result<Metadata> GetMetadata(Uid caller_uid, Gid caller_gid, const std::string& path) override;
+  ResultCode SetMetadata(Uid caller_uid, const std::string& path, Uid uid, Gid gid,
+                         FileAttribute attribute, Modes modes) override;
+
+  Result<NandStats> GetNandStats() override;
+  Result<DirectoryStats> GetDirectoryStats(const std::string& path) override;
+
+  void SetNandRedirects(std::vector<NandRedirect> nand_redirects) override;
+
+private:
+  using Node = NandOverlay::Node;
+
+  struct Handle
+  {
+    bool opened = false;
+    Mode mode = Mode::None;
+    std::string wii_path;
+    /// Set for files in the overlay.
+    std::shared_ptr<std::vector<u8>> data;
+    /// Set for files that are opened through the base file system instead: redirected files and
+    /// files that are only read from.
+    std::optional<Fd> base_fd;
+    u32 file_offset = 0;
+  };
+  Handle* AssignFreeHandle();
+  Handle* GetHandleFromFd(Fd fd);
+  Fd ConvertHandleToFd(const Handle* handle) const;
+  ResultCode OpenHandle(Handle* handle);
+  void CloseHandle(Handle* handle);
+
+  struct Lookup
+  {
+    enum class Source
+    {
+      None,
+      Base,
+      Overlay,
+    };
+    Source source = Source::None;
+    /// The node for the path, if there is one. Can be set for Base entries with changes.
+    Node* node = nullptr;
+  };
+  Lookup Find(const std::string& path);
+  /// Returns the node for an existing path, creating Base nodes along the way if needed.
+  Node* GetOrCreateNode(const std::string& path);
+  /// Returns the metadata of a path without checking any permissions.
+  Result<Metadata> GetEntryMetadata(const std::string& path);
+  /// Returns a copy of an entry and everything in it that doesn't depend on the base NAND.
+  Result<Node> Materialize(const std::string& path);
+  /// Copies a base file into the overlay so that it can be written to.
+  Result<Node*> CopyUp(const std::string& path);
+  /// Puts an entry at a path whose parent exists, replacing anything that is already there.
+  ResultCode AddEntry(const std::string& path, Node node);
+  ResultCode RemoveEntry(const std::string& path);
+
+  bool IsRedirected(const std::string& path) const;
+  ResultCode CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
+                                   FileAttribute attribute, Modes modes, bool is_file);
+  bool IsFileOpened(const std::string& path) const;
+  bool IsDirectoryInUse(const std::string& path) const;
+
+  std::shared_ptr<NandOverlay> m_overlay;
+  std::unique_ptr<FileSystem> m_base;
+  std::vector<NandRedirect> m_nand_redirects;
+  std::array<Handle, 16> m_handles{};
+};
+}  // namespace IOS::HLE::FS
@@ -5,7 +5,10 @@
 
 #include <array>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 #include <mbedtls/md.h>
@@ -15,6 +18,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -79,18 +83,95 @@ int SSLRecv(void* ctx, unsigned char* buf, size_t len)
 
   return ret;
 }
+
+void RunHandshakeStep(int id)
+{
+  WII_SSL& ssl = NetSSLDevice::_SSL[id];
+  {
+    std::lock_guard lk(ssl.handshake_mutex);
+    // The context may have been shut down while the step was queued.
+    if (ssl.handshake_state != WII_SSL::HandshakeState::Running)
+      return;
+
+    ssl.handshake_result = mbedtls_ssl_handshake(&ssl.ctx);
+    ssl.handshake_state = WII_SSL::HandshakeState::Done;
+  }
+  WiiSockMan::GetInstance().WakeUp();
+}
+
+struct SessionDeleter
+{
+  void operator()(mbedtls_ssl_session* session) const
+  {
+    mbedtls_ssl_session_free(session);
+    delete session;
+  }
+};
+
+struct CachedSession
+{
+  int authmode;
+  std::unique_ptr<mbedtls_ssl_session, SessionDeleter> session;
+};
+
+// Enough for the handful of servers a title talks to.
+constexpr size_t MAX_CACHED_SESSIONS = 16;
 }  // namespace
 
+static Common::WorkQueueThread<int> s_handshake_worker;
+
+// Sessions of completed handshakes by hostname, so that reconnecting to the same server can
+// resume the session instead of going through a full handshake. Only used on the CPU thread.
+static std::map<std::string, CachedSession> s_session_cache;
+
+static void CacheSession(const WII_SSL& ssl)
+{
+  CachedSession cached{static_cast<int>(ssl.config.authmode),
+                       std::unique_ptr<mbedtls_ssl_session, SessionDeleter>(
+                           new mbedtls_ssl_session)};
+  mbedtls_ssl_session_init(cached.session.get());
+  if (mbedtls_ssl_get_session(&ssl.ctx, cached.session.get()) != 0)
+    return;
+
+  if (s_session_cache.size() >= MAX_CACHED_SESSIONS && !s_session_cache.count(ssl.hostname))
+    s_session_cache.erase(s_session_cache.begin());
+  s_session_cache.insert_or_assign(ssl.hostname, std::move(cached));
+}
+
+static void ResumeCachedSession(WII_SSL* ssl)
+{
+  const auto it = s_session_cache.find(ssl->hostname);
+  // Sessions from handshakes that skipped certificate verification must not be used to skip it.
+  if (it == s_session_cache.end() ||
+      it->second.authmode != static_cast<int>(ssl->config.authmode))
+  {
+    return;
+  }
+
+  if (mbedtls_ssl_set_session(&ssl->ctx, it->second.session.get()) == 0)
+    INFO_LOG_FMT(IOS_SSL, "Resuming SSL session for {}", ssl->hostname);
+}
+
+static void WaitForHandshake(WII_SSL* ssl)
+{
+  std::lock_guard lk(ssl->handshake_mutex);
+  ssl->handshake_state = WII_SSL::HandshakeState::Idle;
+}
+
 NetSSLDevice::NetSSLDevice(Kernel& ios, const std::string& device_name) : Device(ios, device_name)
 {
   for (WII_SSL& ssl : _SSL)
   {
     ssl.active = false;
+    ssl.handshake_state = WII_SSL::HandshakeState::Idle;
   }
+  s_handshake_worker.Reset(RunHandshakeStep);
 }
 
 NetSSLDevice::~NetSSLDevice()
 {
+  s_handshake_worker.Cancel();
+
   // Cleanup sessions
   for (WII_SSL& ssl : _SSL)
   {
@@ -126,6 +207,26 @@ int NetSSLDevice::GetSSLFreeID() const
   return 0;
 }
 
+std::optional<int> NetSSLDevice::RunHandshake(int id)
+{
+  WII_SSL& ssl = _SSL[id];
+  switch (ssl.handshake_state)
+  {
+  case WII_SSL::HandshakeState::Idle:
+    ssl.handshake_state = WII_SSL::HandshakeState::Running;
+    s_handshake_worker.EmplaceItem(id);
+    return std::nullopt;
+  case WII_SSL::HandshakeState::Running:
+    return std::nullopt;
+  case WII_SSL::HandshakeState::Done:
+  default:
+    ssl.handshake_state = WII_SSL::HandshakeState::Idle;
+    if (ssl.handshake_result == 0)
+      CacheSession(ssl);
+    return ssl.handshake_result;
+  }
+}
+
 std::optional<IPCReply> NetSSLDevice::IOCtl(const IOCtlRequest& request)
 {
   request.Log(GetDeviceName(), Common::Log::LogType::IOS_SSL, Common::Log::LogLevel::LINFO);
@@ -260,7 +361,6 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
       mbedtls_ssl_conf_max_version(&ssl->config, MBEDTLS_SSL_MAJOR_VERSION_3,
                                    MBEDTLS_SSL_MINOR_VERSION_2);
       mbedtls_ssl_conf_cert_profile(&ssl->config, &mbedtls_x509_crt_profile_wii);
-      mbedtls_ssl_set_session(&ssl->ctx, &ssl->session);
 
       if (Config::Get(Config::MAIN_NETWORK_SSL_VERIFY_CERTIFICATES) && verifyOption)
         mbedtls_ssl_conf_authmode(&ssl->config, MBEDTLS_SSL_VERIFY_REQUIRED);
@@ -294,6 +394,7 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
     if (IsSSLIDValid(sslID))
     {
       WII_SSL* ssl = &_SSL[sslID];
+      WaitForHandshake(ssl);
 
       mbedtls_ssl_close_notify(&ssl->ctx);
 
@@ -485,6 +586,7 @@ std::optional<IPCReply> NetSSLDevice::IOCtlV(const IOCtlVRequest& request)
     {
       WII_SSL* ssl = &_SSL[sslID];
       mbedtls_ssl_setup(&ssl->ctx, &ssl->config);
+      ResumeCachedSession(ssl);
       ssl->sockfd = Memory::Read_U32(BufferOut2);
       WiiSockMan& sm = WiiSockMan::GetInstance();
       ssl->hostfd = sm.GetHostSocket(ssl->sockfd);
@@ -13,6 +13,9 @@
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl.h>
 #include <mbedtls/x509_crt.h>
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include <string>
 
 // clang-format on
@@ -77,6 +80,17 @@ struct WII_SSL
   int hostfd = -1;
   std::string hostname;
   bool active = false;
+
+  enum class HandshakeState
+  {
+    Idle,
+    Running,
+    Done,
+  };
+  // Handshake steps run on a worker thread, which holds handshake_mutex while it uses ctx.
+  std::atomic<HandshakeState> handshake_state = HandshakeState::Idle;
+  std::mutex handshake_mutex;
+  int handshake_result = 0;
 };
 
 class NetSSLDevice : public Device
@@ -91,6 +105,10 @@ public:
 
   int GetSSLFreeID() const;
 
+  // Starts a handshake step for the given SSL context on the worker thread if none is running.
+  // Returns the result of mbedtls_ssl_handshake once the step has finished.
+  static std::optional<int> RunHandshake(int id);
+
   static WII_SSL _SSL[NET_SSL_MAXINSTANCES];
 
 private:
@@ -21,6 +21,7 @@
 #include "Common/IOFile.h"
 #include "Common/Network.h"
 #include "Common/ScopeGuard.h"
+#include "Common/Thread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/IOS/Device.h"
@@ -244,11 +245,13 @@ s32 WiiSocket::FCntl(u32 cmd, u32 arg)
 
 void WiiSocket::Update(bool read, bool write, bool except)
 {
+  wait_events = 0;
   auto it = pending_sockops.begin();
   while (it != pending_sockops.end())
   {
     s32 ReturnValue = 0;
     bool forceNonBlock = false;
+    bool waiting_for_worker = false;
     IPCCommandType ct = it->request.command;
     if (!it->is_ssl && ct == IPC_CMD_IOCTL)
     {
@@ -376,7 +379,13 @@ void WiiSocket::Update(bool read, bool write, bool except)
       if (it->is_ssl)
       {
         int sslID = Memory::Read_U32(BufferOut) - 1;
-        if (IsSSLIDValid(sslID))
+        if (IsSSLIDValid(sslID) && it->ssl_type != IOCTLV_NET_SSL_DOHANDSHAKE &&
+            NetSSLDevice::_SSL[sslID].handshake_state == WII_SSL::HandshakeState::Running)
+        {
+          // The context is in use by the handshake worker.
+          waiting_for_worker = true;
+        }
+        else if (IsSSLIDValid(sslID))
         {
           switch (it->ssl_type)
           {
@@ -400,8 +409,17 @@ void WiiSocket::Update(bool read, bool write, bool except)
               break;
             }
 
+            // Handshakes involve slow public key operations, so they run on a worker thread and
+            // the request stays pending until the current step is done.
+            const std::optional<int> handshake_ret = NetSSLDevice::RunHandshake(sslID);
+            if (!handshake_ret)
+            {
+              waiting_for_worker = true;
+              break;
+            }
+
             mbedtls_ssl_context* ctx = &NetSSLDevice::_SSL[sslID].ctx;
-            const int ret = mbedtls_ssl_handshake(ctx);
+            const int ret = *handshake_ret;
             if (ret != 0)
             {
               char error_buffer[256] = "";
@@ -646,6 +664,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
           socklen_t addrlen = sizeof(sockaddr_in);
           auto* from = BufferOutSize2 ? reinterpret_cast<sockaddr*>(&local_name) : nullptr;
           socklen_t* fromlen = BufferOutSize2 ? &addrlen : nullptr;
+          Memory::PrepareForHostWrite(BufferOut, BufferOutSize);
           const int ret = recvfrom(fd, data, data_len, flags, from, fromlen);
           ReturnValue =
               WiiSockMan::GetNetErrorCode(ret, BufferOutSize2 ? "SO_RECVFROM" : "SO_RECV", true);
@@ -679,10 +698,11 @@ void WiiSocket::Update(bool read, bool write, bool except)
       continue;
     }
 
-    if (nonBlock || forceNonBlock ||
-        (!it->is_ssl && ReturnValue != -SO_EAGAIN && ReturnValue != -SO_EINPROGRESS &&
-         ReturnValue != -SO_EALREADY) ||
-        (it->is_ssl && ReturnValue != SSL_ERR_WAGAIN && ReturnValue != SSL_ERR_RAGAIN))
+    if (!waiting_for_worker &&
+        (nonBlock || forceNonBlock ||
+         (!it->is_ssl && ReturnValue != -SO_EAGAIN && ReturnValue != -SO_EINPROGRESS &&
+          ReturnValue != -SO_EALREADY) ||
+         (it->is_ssl && ReturnValue != SSL_ERR_WAGAIN && ReturnValue != SSL_ERR_RAGAIN)))
     {
       DEBUG_LOG_FMT(
           IOS_NET, "IOCTL(V) Sock: {:08x} ioctl/v: {} returned: {} nonBlock: {} forceNonBlock: {}",
@@ -693,6 +713,16 @@ void WiiSocket::Update(bool read, bool write, bool except)
       GetIOS()->EnqueueIPCReply(it->request, ReturnValue);
       it = pending_sockops.erase(it);
     }
+    else if (!waiting_for_worker)
+    {
+      // Handshakes on sockets that are still connecting are waiting for the connection.
+      const bool wants_write =
+          it->is_ssl ? ReturnValue == SSL_ERR_WAGAIN ||
+                           connecting_state == ConnectingState::Connecting :
+                       it->net_type == IOCTL_SO_CONNECT || it->net_type == IOCTLV_SO_SENDTO;
+      wait_events |= wants_write ? POLLOUT : POLLIN;
+      ++it;
+    }
     else
     {
       ++it;
@@ -934,11 +964,38 @@ s32 WiiSockMan::DeleteSocket(s32 wii_fd)
   {
     ReturnValue = socket_entry->second.CloseFd();
     WiiSockets.erase(socket_entry);
+    needs_update = true;
   }
   return ReturnValue;
 }
 
+WiiSockMan::~WiiSockMan()
+{
+  StopReactor();
+}
+
+void WiiSockMan::Clean()
+{
+  WiiSockets.clear();
+  needs_update = true;
+  StopReactor();
+}
+
 void WiiSockMan::Update()
+{
+  // Most of the time nothing is ready, so avoid going through every socket on every IPC tick.
+  if (!needs_update && !reactor_ready.exchange(false) &&
+      (!next_deadline || std::chrono::steady_clock::now() < *next_deadline))
+  {
+    return;
+  }
+
+  needs_update = false;
+  UpdateSockets();
+  ArmReactor();
+}
+
+void WiiSockMan::UpdateSockets()
 {
   s32 nfds = 0;
   fd_set read_fds, write_fds, except_fds;
@@ -989,6 +1046,173 @@ void WiiSockMan::Update()
   UpdatePollCommands();
 }
 
+void WiiSockMan::ArmReactor()
+{
+  const auto now = std::chrono::steady_clock::now();
+  next_deadline.reset();
+  const auto add_deadline = [this](std::chrono::steady_clock::time_point deadline) {
+    if (!next_deadline || deadline < *next_deadline)
+      next_deadline = deadline;
+  };
+
+  std::unordered_map<s32, short> watched;
+  for (const auto& [wii_fd, sock] : WiiSockets)
+  {
+    if (!sock.IsValid() || sock.pending_sockops.empty())
+      continue;
+    watched[sock.fd] |= sock.wait_events;
+    if (sock.timeout)
+      add_deadline(*sock.timeout);
+  }
+  for (const PollCommand& pcmd : pending_polls)
+  {
+    for (const pollfd_t& pfd : pcmd.wii_fds)
+    {
+      const bool is_open = std::any_of(WiiSockets.begin(), WiiSockets.end(), [&](const auto& pair) {
+        return pair.second.IsValid() && pair.second.fd == pfd.fd;
+      });
+      if (is_open)
+        watched[pfd.fd] |= pfd.events;
+    }
+    if (pcmd.timeout > 0)
+      add_deadline(now + std::chrono::milliseconds(pcmd.timeout));
+  }
+
+  if (!watched.empty() && !reactor_thread.joinable() && !StartReactor())
+  {
+    // Without the reactor, fall back to checking everything on every update.
+    needs_update = true;
+    return;
+  }
+  if (!reactor_thread.joinable())
+    return;
+
+  {
+    std::lock_guard lk(reactor_mutex);
+    reactor_fds.resize(1);
+    for (const auto& [fd, events] : watched)
+    {
+      pollfd_t pfd{};
+      pfd.fd = fd;
+      pfd.events = events;
+      reactor_fds.push_back(pfd);
+    }
+    // Readiness reported in the meantime isn't cleared, as WakeUp may have been called from
+    // another thread since this update started.
+    ++reactor_generation;
+  }
+  reactor_cv.notify_one();
+  WakeReactor();
+}
+
+bool WiiSockMan::StartReactor()
+{
+  const s32 fd = static_cast<s32>(socket(AF_INET, SOCK_DGRAM, 0));
+  if (fd < 0)
+  {
+    ERROR_LOG_FMT(IOS_NET, "Failed to create the socket reactor wakeup socket");
+    return false;
+  }
+
+  // A UDP socket connected to itself becomes readable when anything is sent to it, which works
+  // with poll on every platform.
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addr_len = sizeof(addr);
+#ifdef _WIN32
+  u_long non_block = 1;
+  const bool non_block_ok = ioctlsocket(fd, FIONBIO, &non_block) == 0;
+#else
+  const bool non_block_ok = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+  if (!non_block_ok || bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0 ||
+      connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+  {
+    ERROR_LOG_FMT(IOS_NET, "Failed to set up the socket reactor wakeup socket");
+    closesocket(fd);
+    return false;
+  }
+
+  reactor_wakeup_fd = fd;
+  {
+    std::lock_guard lk(reactor_mutex);
+    reactor_fds.assign(1, pollfd_t{});
+    reactor_fds[0].fd = fd;
+    reactor_fds[0].events = POLLIN;
+    reactor_running = true;
+  }
+  reactor_thread = std::thread(&WiiSockMan::ReactorThread, this);
+  return true;
+}
+
+void WiiSockMan::StopReactor()
+{
+  if (!reactor_thread.joinable())
+    return;
+
+  {
+    std::lock_guard lk(reactor_mutex);
+    reactor_running = false;
+  }
+  reactor_cv.notify_one();
+  WakeReactor();
+  reactor_thread.join();
+
+  closesocket(reactor_wakeup_fd);
+  reactor_wakeup_fd = -1;
+  reactor_ready = false;
+  next_deadline.reset();
+}
+
+void WiiSockMan::WakeReactor()
+{
+  const char byte = 0;
+  send(reactor_wakeup_fd, &byte, 1, 0);
+}
+
+void WiiSockMan::ReactorThread()
+{
+  Common::SetCurrentThreadName("IOS Socket Reactor");
+
+  std::unique_lock lk(reactor_mutex);
+  u64 reported_generation = 0;
+  while (true)
+  {
+    // Once readiness has been reported, wait for the sockets to be handled before polling again.
+    reactor_cv.wait(lk, [&] {
+      return !reactor_running ||
+             (reactor_fds.size() > 1 && reactor_generation != reported_generation);
+    });
+    if (!reactor_running)
+      break;
+
+    const u64 generation = reactor_generation;
+    std::vector<pollfd_t> fds = reactor_fds;
+    lk.unlock();
+
+    const int ret = poll(fds.data(), static_cast<unsigned long>(fds.size()), -1);
+    if (fds[0].revents & POLLIN)
+    {
+      char buffer[16];
+      while (recv(reactor_wakeup_fd, buffer, sizeof(buffer), 0) > 0)
+      {
+      }
+    }
+    const bool ready = ret < 0 || std::any_of(fds.begin() + 1, fds.end(),
+                                              [](const pollfd_t& pfd) { return pfd.revents != 0; });
+
+    lk.lock();
+    // The sockets may have changed while waiting, in which case the result is outdated.
+    if (ready && generation == reactor_generation)
+    {
+      reported_generation = generation;
+      reactor_ready = true;
+    }
+  }
+}
+
 void WiiSockMan::UpdatePollCommands()
 {
   static constexpr int error_event = (POLLHUP | POLLERR);
@@ -1142,6 +1366,7 @@ void WiiSockMan::DoState(PointerWrap& p)
 
   if (saving)
     return;
+  needs_update = true;
   for (auto& pcmd : pending_polls)
   {
     for (auto& wfd : pcmd.wii_fds)
@@ -1152,6 +1377,7 @@ void WiiSockMan::DoState(PointerWrap& p)
 void WiiSockMan::AddPollCommand(const PollCommand& cmd)
 {
   pending_polls.push_back(cmd);
+  needs_update = true;
 }
 
 void WiiSockMan::UpdateWantDeterminism(bool want)
@@ -42,14 +42,19 @@ typedef struct pollfd pollfd_t;
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <list>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -230,6 +235,8 @@ private:
   bool nonBlock = false;
   ConnectingState connecting_state = ConnectingState::None;
   std::list<sockop> pending_sockops;
+  // What the pending operations are waiting for, as native poll events.
+  short wait_events = 0;
 
   std::optional<Timeout> timeout;
 };
@@ -276,7 +283,7 @@ public:
   s32 DeleteSocket(s32 wii_fd);
   s32 GetLastNetError() const { return errno_last; }
   void SetLastNetError(s32 error) { errno_last = error; }
-  void Clean() { WiiSockets.clear(); }
+  void Clean();
   template <typename T>
   void DoSock(s32 sock, const Request& request, T type)
   {
@@ -290,24 +297,54 @@ public:
     else
     {
       socket_entry->second.DoSock(request, type);
+      needs_update = true;
     }
   }
 
   void UpdateWantDeterminism(bool want);
 
+  // Makes the next update go through the pending operations. Can be called from any thread, e.g.
+  // once work for one of them has finished on another thread.
+  void WakeUp() { reactor_ready = true; }
+
 private:
   WiiSockMan() = default;
+  ~WiiSockMan();
   WiiSockMan(const WiiSockMan&) = delete;
   WiiSockMan& operator=(const WiiSockMan&) = delete;
   WiiSockMan(WiiSockMan&&) = delete;
   WiiSockMan& operator=(WiiSockMan&&) = delete;
 
+  void UpdateSockets();
   void UpdatePollCommands();
 
+  // Pending operations and polls are only retried when one of their sockets is ready, as reported
+  // by a thread that waits for the sockets, or when one of their timeouts has expired.
+  void ArmReactor();
+  bool StartReactor();
+  void StopReactor();
+  void WakeReactor();
+  void ReactorThread();
+
   std::unordered_map<s32, WiiSocket> WiiSockets;
   s32 errno_last = 0;
   std::vector<PollCommand> pending_polls;
   std::chrono::time_point<std::chrono::high_resolution_clock> last_time =
       std::chrono::high_resolution_clock::now();
+
+  // Set when operations or polls were added, which have to be tried at least once.
+  bool needs_update = false;
+  std::optional<std::chrono::steady_clock::time_point> next_deadline;
+
+  std::thread reactor_thread;
+  s32 reactor_wakeup_fd = -1;
+  std::atomic<bool> reactor_ready = false;
+  // Guards everything below.
+  std::mutex reactor_mutex;
+  std::condition_variable reactor_cv;
+  bool reactor_running = false;
+  // The first entry is the wakeup socket.
+  std::vector<pollfd_t> reactor_fds;
+  u64 reactor_generation = 0;
 };
 }  // namespace IOS::HLE
@@ -180,6 +180,9 @@ std::optional<IPCReply> BluetoothEmuDevice::IOCtlV(const IOCtlVRequest& request)
       m_acl_endpoint = std::make_unique<USB::V0BulkMessage>(m_ios, request);
       DEBUG_LOG_FMT(IOS_WIIMOTE, "ACL_DATA_IN: {:#010x}", request.address);
       send_reply = false;
+      // Don't wait for the next update if reports are already queued, so that reports from
+      // several Wii Remotes are delivered as fast as the stack takes them.
+      SendQueuedPackets();
       break;
     }
     default:
@@ -196,6 +199,7 @@ std::optional<IPCReply> BluetoothEmuDevice::IOCtlV(const IOCtlVRequest& request)
       m_hci_endpoint = std::make_unique<USB::V0IntrMessage>(m_ios, request);
       DEBUG_LOG_FMT(IOS_WIIMOTE, "HCI_EVENT: {:#010x}", request.address);
       send_reply = false;
+      SendQueuedPackets();
     }
     else
     {
@@ -310,7 +314,7 @@ void BluetoothEmuDevice::AddEventToQueue(const SQueuedEvent& event)
   }
 }
 
-void BluetoothEmuDevice::Update()
+void BluetoothEmuDevice::SendQueuedPackets()
 {
   // check HCI queue
   if (!m_event_queue.empty() && m_hci_endpoint)
@@ -334,6 +338,11 @@ void BluetoothEmuDevice::Update()
     m_acl_pool.WriteToEndpoint(*m_acl_endpoint);
     m_acl_endpoint.reset();
   }
+}
+
+void BluetoothEmuDevice::Update()
+{
+  SendQueuedPackets();
 
   for (auto& wiimote : m_wiimotes)
     wiimote->Update();
@@ -778,6 +787,16 @@ bool BluetoothEmuDevice::SendEventRoleChange(bdaddr_t bd, bool master)
 
 bool BluetoothEmuDevice::SendEventNumberOfCompletedPackets()
 {
+  // Keep counting until the previous event has been delivered instead of queueing one event per
+  // update, which would delay everything queued after them.
+  const bool already_queued =
+      std::any_of(m_event_queue.begin(), m_event_queue.end(), [](const SQueuedEvent& event) {
+        return reinterpret_cast<const hci_event_hdr_t*>(event.buffer)->event ==
+               HCI_EVENT_NUM_COMPL_PKTS;
+      });
+  if (already_queued)
+    return true;
+
   SQueuedEvent event((u32)(sizeof(hci_event_hdr_t) + sizeof(hci_num_compl_pkts_ep) +
                            (sizeof(hci_num_compl_pkts_info) * m_wiimotes.size())),
                      0);
@@ -111,6 +111,8 @@ private:
 
   // Events
   void AddEventToQueue(const SQueuedEvent& event);
+  // Fills the HCI and ACL buffers given by the stack with queued events and packets.
+  void SendQueuedPackets();
   bool SendEventCommandStatus(u16 opcode);
   void SendEventCommandComplete(u16 opcode, const void* data, u32 data_size);
   bool SendEventInquiryResponse();
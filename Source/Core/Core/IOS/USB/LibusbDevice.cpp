@@ -18,6 +18,7 @@
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
@@ -49,6 +50,9 @@ LibusbDevice::LibusbDevice(Kernel& ios, libusb_device* device,
 
 LibusbDevice::~LibusbDevice()
 {
+  for (auto& [endpoint, read_ahead] : m_read_ahead_endpoints)
+    read_ahead.Shutdown();
+
   if (m_handle != nullptr)
   {
     ReleaseAllInterfacesForCurrentConfig();
@@ -170,13 +174,23 @@ int LibusbDevice::CancelTransfer(const u8 endpoint)
 {
   INFO_LOG_FMT(IOS_USB, "[{:04x}:{:04x} {}] Cancelling transfers (endpoint {:#x})", m_vid, m_pid,
                m_active_interface, endpoint);
+  const auto read_ahead = m_read_ahead_endpoints.find(endpoint);
+  if (read_ahead != m_read_ahead_endpoints.end())
+    read_ahead->second.CancelTransfers();
+
   const auto iterator = m_transfer_endpoints.find(endpoint);
   if (iterator == m_transfer_endpoints.cend())
-    return IPC_ENOENT;
+    return read_ahead != m_read_ahead_endpoints.end() ? IPC_SUCCESS : IPC_ENOENT;
   iterator->second.CancelTransfers();
   return IPC_SUCCESS;
 }
 
+void LibusbDevice::CancelReadAhead()
+{
+  for (auto& [endpoint, read_ahead] : m_read_ahead_endpoints)
+    read_ahead.CancelTransfers();
+}
+
 int LibusbDevice::ChangeInterface(const u8 interface)
 {
   INFO_LOG_FMT(IOS_USB, "[{:04x}:{:04x} {}] Changing interface to {}", m_vid, m_pid,
@@ -192,6 +206,7 @@ int LibusbDevice::SetAltSetting(const u8 alt_setting)
 
   INFO_LOG_FMT(IOS_USB, "[{:04x}:{:04x} {}] Setting alt setting {}", m_vid, m_pid,
                m_active_interface, alt_setting);
+  CancelReadAhead();
   return libusb_set_interface_alt_setting(m_handle, m_active_interface, alt_setting);
 }
 
@@ -232,6 +247,7 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<CtrlMessage> cmd)
   {
     INFO_LOG_FMT(IOS_USB, "[{:04x}:{:04x} {}] REQUEST_SET_CONFIGURATION index={:04x} value={:04x}",
                  m_vid, m_pid, m_active_interface, cmd->index, cmd->value);
+    CancelReadAhead();
     ReleaseAllInterfacesForCurrentConfig();
     const int ret = libusb_set_configuration(m_handle, cmd->value);
     if (ret == LIBUSB_SUCCESS)
@@ -280,6 +296,15 @@ int LibusbDevice::SubmitTransfer(std::unique_ptr<IntrMessage> cmd)
   DEBUG_LOG_FMT(IOS_USB, "[{:04x}:{:04x} {}] Interrupt: length={:04x} endpoint={:02x}", m_vid,
                 m_pid, m_active_interface, cmd->length, cmd->endpoint);
 
+  const int read_ahead = Config::Get(Config::MAIN_USB_PASSTHROUGH_READ_AHEAD);
+  if (read_ahead > 0 && (cmd->endpoint & LIBUSB_ENDPOINT_IN) != 0)
+  {
+    const u8 endpoint = cmd->endpoint;
+    auto& read_ahead_endpoint =
+        m_read_ahead_endpoints.try_emplace(endpoint, *this, endpoint).first->second;
+    return read_ahead_endpoint.Submit(std::move(cmd), static_cast<u32>(read_ahead));
+  }
+
   libusb_transfer* transfer = libusb_alloc_transfer(0);
   libusb_fill_interrupt_transfer(transfer, m_handle, cmd->endpoint,
                                  cmd->MakeBuffer(cmd->length).release(), cmd->length,
@@ -355,6 +380,19 @@ static const std::map<u8, const char*> s_transfer_types = {
     {LIBUSB_TRANSFER_TYPE_INTERRUPT, "Interrupt"},
 };
 
+static s32 GetFailedTransferReturnValue(int status)
+{
+  switch (status)
+  {
+  case LIBUSB_TRANSFER_STALL:
+    return -7004;
+  case LIBUSB_TRANSFER_NO_DEVICE:
+    return IPC_ENOENT;
+  default:
+    return -5;
+  }
+}
+
 void LibusbDevice::TransferEndpoint::AddTransfer(std::unique_ptr<TransferCommand> command,
                                                  libusb_transfer* transfer)
 {
@@ -391,10 +429,9 @@ void LibusbDevice::TransferEndpoint::HandleTransfer(libusb_transfer* transfer,
                   device->m_vid, device->m_pid, device->m_active_interface,
                   s_transfer_types.at(transfer->type), transfer->endpoint,
                   libusb_error_name(transfer->status));
-    return_value = transfer->status == LIBUSB_TRANSFER_STALL ? -7004 : -5;
-    break;
+    [[fallthrough]];
   case LIBUSB_TRANSFER_NO_DEVICE:
-    return_value = IPC_ENOENT;
+    return_value = GetFailedTransferReturnValue(transfer->status);
     break;
   }
   cmd.OnTransferComplete(return_value);
@@ -411,6 +448,156 @@ void LibusbDevice::TransferEndpoint::CancelTransfers()
     libusb_cancel_transfer(pending_transfer.first);
 }
 
+int LibusbDevice::ReadAheadEndpoint::Submit(std::unique_ptr<IntrMessage> command, u32 depth)
+{
+  std::lock_guard lk(m_mutex);
+  m_depth = depth;
+  m_length = std::max(m_length, command->length);
+
+  if (!m_completed.empty())
+  {
+    Complete(std::move(command), m_completed.front());
+    m_completed.pop_front();
+    // The request has been answered already, so a failure here is only for the next ones.
+    SubmitTransfers();
+    return LIBUSB_SUCCESS;
+  }
+
+  m_waiting_commands.push_back(std::move(command));
+  const int ret = SubmitTransfers();
+  if (ret < LIBUSB_SUCCESS)
+  {
+    const size_t in_flight =
+        std::count_if(m_in_flight.begin(), m_in_flight.end(),
+                      [this](const auto& entry) { return entry.second == m_generation; });
+    // Let the caller reply if there is no transfer left for this request.
+    if (m_waiting_commands.size() > in_flight)
+    {
+      m_waiting_commands.pop_back();
+      return ret;
+    }
+  }
+  return LIBUSB_SUCCESS;
+}
+
+int LibusbDevice::ReadAheadEndpoint::SubmitTransfers()
+{
+  size_t in_flight = std::count_if(m_in_flight.begin(), m_in_flight.end(), [this](const auto& e) {
+    return e.second == m_generation;
+  });
+  // Every waiting request needs a transfer, and at most m_depth transfers worth of data should be
+  // waiting for requests.
+  const size_t buffered = m_completed.size() + in_flight;
+  const size_t wanted =
+      std::max(m_waiting_commands.size(), in_flight + (m_depth > buffered ? m_depth - buffered : 0));
+
+  for (; in_flight < wanted; ++in_flight)
+  {
+    libusb_transfer* transfer = libusb_alloc_transfer(0);
+    libusb_fill_interrupt_transfer(transfer, m_device.m_handle, m_endpoint, new u8[m_length],
+                                   m_length, TransferCallback, this, 0);
+    transfer->flags |= LIBUSB_TRANSFER_FREE_TRANSFER;
+    const int ret = libusb_submit_transfer(transfer);
+    if (ret < LIBUSB_SUCCESS)
+    {
+      ERROR_LOG_FMT(IOS_USB, "[{:04x}:{:04x}] Failed to submit read-ahead transfer: {}",
+                    m_device.m_vid, m_device.m_pid, LibusbUtils::ErrorWrap(ret));
+      delete[] transfer->buffer;
+      libusb_free_transfer(transfer);
+      return ret;
+    }
+    m_in_flight.emplace(transfer, m_generation);
+  }
+  return LIBUSB_SUCCESS;
+}
+
+void LibusbDevice::ReadAheadEndpoint::TransferCallback(libusb_transfer* transfer)
+{
+  auto* endpoint = static_cast<ReadAheadEndpoint*>(transfer->user_data);
+  const std::unique_ptr<u8[]> buffer(transfer->buffer);
+
+  std::lock_guard lk(endpoint->m_mutex);
+  const auto iterator = endpoint->m_in_flight.find(transfer);
+  if (iterator == endpoint->m_in_flight.end())
+    return;
+  const bool is_current = iterator->second == endpoint->m_generation;
+  endpoint->m_in_flight.erase(iterator);
+  endpoint->m_cv.notify_all();
+  if (!is_current)
+    return;
+
+  CompletedTransfer completed;
+  if (transfer->status == LIBUSB_TRANSFER_COMPLETED)
+  {
+    completed.return_value = transfer->actual_length;
+    completed.data.assign(buffer.get(), buffer.get() + transfer->actual_length);
+  }
+  else
+  {
+    ERROR_LOG_FMT(IOS_USB, "[{:04x}:{:04x}] Read-ahead transfer (endpoint {:#04x}) failed: {}",
+                  endpoint->m_device.m_vid, endpoint->m_device.m_pid, endpoint->m_endpoint,
+                  libusb_error_name(transfer->status));
+    completed.return_value = GetFailedTransferReturnValue(transfer->status);
+  }
+
+  if (!endpoint->m_waiting_commands.empty())
+  {
+    std::unique_ptr<IntrMessage> command = std::move(endpoint->m_waiting_commands.front());
+    endpoint->m_waiting_commands.pop_front();
+    endpoint->Complete(std::move(command), completed);
+  }
+  else
+  {
+    endpoint->m_completed.push_back(std::move(completed));
+  }
+
+  // Don't keep resubmitting to an endpoint that fails. The next request will try again.
+  if (transfer->status == LIBUSB_TRANSFER_COMPLETED)
+    endpoint->SubmitTransfers();
+}
+
+void LibusbDevice::ReadAheadEndpoint::Complete(std::unique_ptr<IntrMessage> command,
+                                               const CompletedTransfer& completed)
+{
+  if (completed.return_value < 0)
+  {
+    command->OnTransferComplete(completed.return_value);
+    return;
+  }
+
+  if (completed.data.size() > command->length)
+  {
+    WARN_LOG_FMT(IOS_USB, "[{:04x}:{:04x}] Truncating read-ahead data for a smaller request",
+                 m_device.m_vid, m_device.m_pid);
+  }
+  const u32 size = std::min(static_cast<u32>(completed.data.size()), command->length);
+  command->FillBuffer(completed.data.data(), size);
+  command->OnTransferComplete(static_cast<s32>(size));
+}
+
+void LibusbDevice::ReadAheadEndpoint::CancelTransfers()
+{
+  std::lock_guard lk(m_mutex);
+  ++m_generation;
+  m_completed.clear();
+  for (const auto& command : m_waiting_commands)
+    command->OnTransferComplete(GetFailedTransferReturnValue(LIBUSB_TRANSFER_CANCELLED));
+  m_waiting_commands.clear();
+  for (const auto& [transfer, generation] : m_in_flight)
+    libusb_cancel_transfer(transfer);
+}
+
+void LibusbDevice::ReadAheadEndpoint::Shutdown()
+{
+  std::unique_lock lk(m_mutex);
+  ++m_generation;
+  m_completed.clear();
+  m_waiting_commands.clear();
+  for (const auto& [transfer, generation] : m_in_flight)
+    libusb_cancel_transfer(transfer);
+  m_cv.wait(lk, [this] { return m_in_flight.empty(); });
+}
+
 int LibusbDevice::GetNumberOfAltSettings(const u8 interface_number)
 {
   return m_config_descriptors[0]->interface[interface_number].num_altsetting;
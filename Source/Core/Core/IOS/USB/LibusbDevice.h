@@ -4,7 +4,9 @@
 #pragma once
 
 #if defined(__LIBUSB__)
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
@@ -72,6 +74,45 @@ private:
   static void CtrlTransferCallback(libusb_transfer* transfer);
   static void TransferCallback(libusb_transfer* transfer);
 
+  // Keeps several interrupt IN transfers in flight so that data is usually already there when
+  // the emulated software asks for it, instead of only starting a transfer at that point.
+  // Completed transfers are handed to requests in order and are only dropped on cancellation.
+  class ReadAheadEndpoint final
+  {
+  public:
+    ReadAheadEndpoint(LibusbDevice& device, u8 endpoint) : m_device(device), m_endpoint(endpoint)
+    {
+    }
+    int Submit(std::unique_ptr<IntrMessage> command, u32 depth);
+    void CancelTransfers();
+    // Cancels everything and waits for the cancelled transfers to come back.
+    void Shutdown();
+
+  private:
+    struct CompletedTransfer
+    {
+      s32 return_value;
+      std::vector<u8> data;
+    };
+    static void TransferCallback(libusb_transfer* transfer);
+    void Complete(std::unique_ptr<IntrMessage> command, const CompletedTransfer& completed);
+    int SubmitTransfers();
+
+    LibusbDevice& m_device;
+    u8 m_endpoint;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    u32 m_depth = 0;
+    u32 m_length = 0;
+    // Bumped on cancellation, so that transfers from before it are ignored when they come back.
+    u64 m_generation = 0;
+    std::map<libusb_transfer*, u64> m_in_flight;
+    std::deque<std::unique_ptr<IntrMessage>> m_waiting_commands;
+    std::deque<CompletedTransfer> m_completed;
+  };
+  std::map<u8, ReadAheadEndpoint> m_read_ahead_endpoints;
+  void CancelReadAhead();
+
   int ClaimAllInterfaces(u8 config_num) const;
   int ReleaseAllInterfaces(u8 config_num) const;
   int ReleaseAllInterfacesForCurrentConfig() const;
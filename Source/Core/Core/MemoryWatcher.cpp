@@ -3,19 +3,25 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
-#include <iostream>
+#include <iterator>
 #include <sstream>
 #include <unistd.h>
 
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
 
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
+  m_binary_output = Config::Get(Config::MAIN_MEMORY_WATCHER_BINARY_OUTPUT);
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
   if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
@@ -43,19 +49,25 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return !m_values.empty();
+  return !m_watches.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  if (std::any_of(m_watches.begin(), m_watches.end(),
+                  [&line](const WatchedAddress& watch) { return watch.line == line; }))
+  {
+    return;
+  }
+
+  WatchedAddress& watch = m_watches.emplace_back();
+  watch.line = line;
 
   std::istringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,10 +79,10 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+u32 MemoryWatcher::ChasePointer(const WatchedAddress& watch)
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
   {
     value = PowerPC::HostRead_U32(value + offset);
     if (!PowerPC::HostIsRAMAddress(value))
@@ -79,26 +91,34 @@ u32 MemoryWatcher::ChasePointer(const std::string& line)
   return value;
 }
 
-std::string MemoryWatcher::ComposeMessages()
+void MemoryWatcher::ComposeMessages()
 {
-  std::ostringstream message_stream;
-  message_stream << std::hex;
+  m_message.clear();
 
-  for (auto& entry : m_values)
+  for (u32 i = 0; i < m_watches.size(); ++i)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    WatchedAddress& watch = m_watches[i];
 
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
+    const u32 new_value = ChasePointer(watch);
+    if (new_value == watch.value)
+      continue;
+
+    // Update the value
+    watch.value = new_value;
+    if (m_binary_output)
+    {
+      const u32 record[] = {i, new_value};
+      const u8* record_bytes = reinterpret_cast<const u8*>(record);
+      m_message.insert(m_message.end(), record_bytes, record_bytes + sizeof(record));
+    }
+    else
     {
-      // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      fmt::format_to(std::back_inserter(m_message), "{}\n{:x}\n", watch.line, new_value);
     }
   }
 
-  return message_stream.str();
+  if (!m_binary_output)
+    m_message.push_back('\0');
 }
 
 void MemoryWatcher::Step()
@@ -106,7 +126,10 @@ void MemoryWatcher::Step()
   if (!m_running)
     return;
 
-  std::string message = ComposeMessages();
-  sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
+  ComposeMessages();
+  if (m_message.empty())
+    return;
+
+  sendto(m_fd, m_message.data(), m_message.size(), 0, reinterpret_cast<sockaddr*>(&m_addr),
          sizeof(m_addr));
 }
@@ -5,7 +5,6 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -19,6 +18,10 @@
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// With MemoryWatcherBinaryOutput enabled, each datagram instead holds one pair of native endian
+// u32s per changed value: the index of the line in the input file (counting each distinct line
+// once), followed by the new value. Nothing is sent for frames in which no value changed.
 class MemoryWatcher final
 {
 public:
@@ -27,20 +30,29 @@ public:
   void Step();
 
 private:
+  struct WatchedAddress
+  {
+    // Address as stored in the file
+    std::string line;
+    // List of offsets to follow
+    std::vector<u32> offsets;
+    u32 value = 0;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
-  std::string ComposeMessages();
+  static u32 ChasePointer(const WatchedAddress& watch);
+  void ComposeMessages();
 
   bool m_running = false;
+  bool m_binary_output = false;
 
   int m_fd;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  std::vector<WatchedAddress> m_watches;
+  // Reused between steps to avoid reallocating it every frame.
+  std::vector<u8> m_message;
 };
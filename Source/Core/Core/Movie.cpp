@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cstring>
 #include <iomanip>
@@ -19,6 +20,8 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <xxhash.h>
+#include <zstd.h>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -124,6 +127,46 @@ static std::string s_InputDisplay[8];
 
 static std::string s_current_file_name;
 
+// Keyframes are snapshots of the emulated state taken every few hundred frames while a movie is
+// recorded or played back, so that playback can jump close to any frame instead of replaying the
+// movie from the start. Every KEYFRAMES_PER_FULL-th one is stored in full, and the ones in between
+// as deltas against the last full one. They are saved next to the movie, and each one remembers a
+// hash of the input that led up to it, so keyframes don't get used after the movie changed.
+constexpr u32 KEYFRAMES_PER_FULL = 10;
+constexpr int KEYFRAME_COMPRESSION_LEVEL = 3;
+constexpr std::array<u8, 4> KEYFRAMES_MAGIC = {'D', 'T', 'K', 0x1A};
+constexpr u32 KEYFRAMES_VERSION = 1;
+
+namespace
+{
+struct Keyframe
+{
+  u64 frame;
+  // The frame of the full keyframe that this one is a delta against, or frame if it's full.
+  u64 base_frame;
+  u64 input_byte;
+  u64 input_hash;
+  std::vector<u8> compressed;
+};
+}  // namespace
+
+// Guards the keyframe state below, which is used from both the host thread and the CPU thread.
+static std::mutex s_keyframes_mutex;
+// Sorted by frame.
+static std::vector<Keyframe> s_keyframes;
+static std::string s_keyframes_path;
+static bool s_keyframes_changed = false;
+// Uncompressed copy of the full keyframe that new deltas are made against.
+static State::Snapshot s_keyframe_base;
+static std::optional<u64> s_keyframe_base_frame;
+static u32 s_deltas_since_full_keyframe = 0;
+
+static std::atomic<bool> s_keyframe_capture_pending{false};
+
+// CPU thread only.
+static std::optional<u64> s_seek_target;
+static float s_seek_saved_emulation_speed = 1.0f;
+
 static void GetSettings();
 static bool IsMovieHeader(const std::array<u8, 4>& magic)
 {
@@ -217,6 +260,314 @@ std::string GetRerecords()
   return "Rerecords: N/A";
 }
 
+// Must be called with s_keyframes_mutex held.
+static void ClearKeyframesLocked()
+{
+  s_keyframes.clear();
+  s_keyframes_changed = false;
+  s_keyframe_base = {};
+  s_keyframe_base_frame.reset();
+  s_deltas_since_full_keyframe = 0;
+}
+
+static u64 HashInput(u64 size)
+{
+  return XXH64(s_temp_input.data(), static_cast<size_t>(size), 0);
+}
+
+static bool DecompressKeyframe(const Keyframe& keyframe, std::vector<u8>& delta)
+{
+  const unsigned long long size =
+      ZSTD_getFrameContentSize(keyframe.compressed.data(), keyframe.compressed.size());
+  if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN)
+    return false;
+
+  delta.resize(size);
+  return ZSTD_decompress(delta.data(), delta.size(), keyframe.compressed.data(),
+                         keyframe.compressed.size()) == size;
+}
+
+// Must be called with s_keyframes_mutex held.
+static bool DecodeKeyframe(const Keyframe& keyframe, State::Snapshot& snapshot)
+{
+  std::vector<u8> delta;
+  if (keyframe.base_frame == keyframe.frame)
+    return DecompressKeyframe(keyframe, delta) && State::DecodeSnapshotDelta({}, delta, snapshot);
+
+  const auto base = std::find_if(s_keyframes.begin(), s_keyframes.end(), [&](const Keyframe& k) {
+    return k.frame == keyframe.base_frame && k.base_frame == k.frame;
+  });
+  if (base == s_keyframes.end())
+    return false;
+
+  State::Snapshot base_snapshot;
+  return DecodeKeyframe(*base, base_snapshot) && DecompressKeyframe(keyframe, delta) &&
+         State::DecodeSnapshotDelta(base_snapshot, delta, snapshot);
+}
+
+static bool WriteKeyframes(const std::string& path)
+{
+  std::lock_guard lk(s_keyframes_mutex);
+
+  File::IOFile file(path, "wb");
+  const u32 count = static_cast<u32>(s_keyframes.size());
+  bool success = file.WriteArray(&KEYFRAMES_MAGIC, 1) && file.WriteArray(&KEYFRAMES_VERSION, 1) &&
+                 file.WriteArray(&count, 1);
+  for (const Keyframe& keyframe : s_keyframes)
+  {
+    const u64 size = keyframe.compressed.size();
+    success = success && file.WriteArray(&keyframe.frame, 1) &&
+              file.WriteArray(&keyframe.base_frame, 1) &&
+              file.WriteArray(&keyframe.input_byte, 1) &&
+              file.WriteArray(&keyframe.input_hash, 1) && file.WriteArray(&size, 1) &&
+              file.WriteBytes(keyframe.compressed.data(), keyframe.compressed.size());
+  }
+
+  if (success)
+    s_keyframes_changed = false;
+  else
+    ERROR_LOG_FMT(CORE, "Failed to write movie keyframes to {}", path);
+
+  return success;
+}
+
+static void ReadKeyframes(const std::string& path)
+{
+  std::lock_guard lk(s_keyframes_mutex);
+  ClearKeyframesLocked();
+
+  File::IOFile file(path, "rb");
+  if (!file.IsOpen())
+    return;
+
+  std::array<u8, 4> magic;
+  u32 version, count;
+  if (!file.ReadArray(&magic, 1) || magic != KEYFRAMES_MAGIC || !file.ReadArray(&version, 1) ||
+      version != KEYFRAMES_VERSION || !file.ReadArray(&count, 1))
+  {
+    WARN_LOG_FMT(CORE, "Ignoring invalid movie keyframes in {}", path);
+    return;
+  }
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    Keyframe keyframe;
+    u64 size;
+    if (!file.ReadArray(&keyframe.frame, 1) || !file.ReadArray(&keyframe.base_frame, 1) ||
+        !file.ReadArray(&keyframe.input_byte, 1) || !file.ReadArray(&keyframe.input_hash, 1) ||
+        !file.ReadArray(&size, 1) || size > file.GetSize())
+    {
+      break;
+    }
+
+    keyframe.compressed.resize(size);
+    if (!file.ReadBytes(keyframe.compressed.data(), keyframe.compressed.size()))
+      break;
+
+    if (!s_keyframes.empty() && keyframe.frame <= s_keyframes.back().frame)
+      break;
+    s_keyframes.push_back(std::move(keyframe));
+  }
+
+  INFO_LOG_FMT(CORE, "Loaded {} movie keyframes from {}", s_keyframes.size(), path);
+}
+
+// NOTE: Host Thread
+static void CaptureKeyframe(u64 interval)
+{
+  State::Snapshot snapshot;
+  u64 frame = 0, input_byte = 0, input_hash = 0;
+  bool capture = false;
+
+  Core::RunOnCPUThread(
+      [&] {
+        if (!IsMovieActive())
+          return;
+
+        frame = s_currentFrame;
+        input_byte = s_currentByte;
+        input_hash = HashInput(input_byte);
+
+        {
+          std::lock_guard lk(s_keyframes_mutex);
+          if (IsRecordingInput())
+          {
+            // Everything after this point in the movie is being recorded over.
+            const auto it =
+                std::find_if(s_keyframes.begin(), s_keyframes.end(),
+                             [&](const Keyframe& keyframe) { return keyframe.frame >= frame; });
+            if (it != s_keyframes.end())
+            {
+              s_keyframes.erase(it, s_keyframes.end());
+              s_keyframes_changed = true;
+            }
+          }
+          else if (std::any_of(s_keyframes.begin(), s_keyframes.end(),
+                               [&](const Keyframe& keyframe) {
+                                 return keyframe.frame + interval > frame &&
+                                        frame + interval > keyframe.frame;
+                               }))
+          {
+            // There's one close enough to this point of the movie already.
+            return;
+          }
+        }
+
+        State::SaveSnapshot(snapshot);
+        capture = true;
+      },
+      true);
+
+  if (!capture)
+    return;
+
+  std::lock_guard lk(s_keyframes_mutex);
+
+  const bool full =
+      !s_keyframe_base_frame || s_deltas_since_full_keyframe + 1 >= KEYFRAMES_PER_FULL ||
+      std::none_of(s_keyframes.begin(), s_keyframes.end(), [](const Keyframe& keyframe) {
+        return keyframe.frame == *s_keyframe_base_frame;
+      });
+
+  Keyframe keyframe{frame, frame, input_byte, input_hash, {}};
+  std::vector<u8> delta;
+  if (full)
+  {
+    delta = State::EncodeSnapshotDelta({}, snapshot);
+    std::swap(s_keyframe_base, snapshot);
+    s_keyframe_base_frame = frame;
+    s_deltas_since_full_keyframe = 0;
+  }
+  else
+  {
+    delta = State::EncodeSnapshotDelta(s_keyframe_base, snapshot);
+    keyframe.base_frame = *s_keyframe_base_frame;
+    ++s_deltas_since_full_keyframe;
+  }
+
+  keyframe.compressed.resize(ZSTD_compressBound(delta.size()));
+  const size_t size = ZSTD_compress(keyframe.compressed.data(), keyframe.compressed.size(),
+                                    delta.data(), delta.size(), KEYFRAME_COMPRESSION_LEVEL);
+  if (ZSTD_isError(size))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress movie keyframe: {}", ZSTD_getErrorName(size));
+    s_keyframe_base_frame.reset();
+    return;
+  }
+  keyframe.compressed.resize(size);
+  keyframe.compressed.shrink_to_fit();
+
+  const auto it = std::upper_bound(
+      s_keyframes.begin(), s_keyframes.end(), frame,
+      [](u64 value, const Keyframe& other) { return value < other.frame; });
+  s_keyframes.insert(it, std::move(keyframe));
+  s_keyframes_changed = true;
+}
+
+static void SaveChangedKeyframes()
+{
+  std::string path;
+  {
+    std::lock_guard lk(s_keyframes_mutex);
+    if (!s_keyframes_changed || s_keyframes_path.empty())
+      return;
+    path = s_keyframes_path;
+  }
+
+  WriteKeyframes(path);
+}
+
+// NOTE: CPU Thread
+static void EndSeek()
+{
+  if (!s_seek_target)
+    return;
+
+  s_seek_target.reset();
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, s_seek_saved_emulation_speed);
+}
+
+// NOTE: Host Thread
+bool SeekToFrame(u64 frame)
+{
+  if (!IsPlayingInput())
+  {
+    Core::DisplayMessage("Seeking is only possible while playing back a movie", 2000);
+    return false;
+  }
+
+  if (NetPlay::IsNetPlayRunning())
+  {
+    Core::DisplayMessage("Seeking is disabled in Netplay to prevent desyncs", 2000);
+    return false;
+  }
+
+  bool success = false;
+  bool fast_forward = false;
+  Core::RunOnCPUThread(
+      [&] {
+        if (frame > s_totalFrames)
+        {
+          Core::DisplayMessage(
+              fmt::format("Frame {} is after the end of the movie ({})", frame, s_totalFrames),
+              2000);
+          return;
+        }
+
+        {
+          std::lock_guard lk(s_keyframes_mutex);
+
+          // The newest keyframe before the target that still matches the movie.
+          const auto keyframe =
+              std::find_if(s_keyframes.rbegin(), s_keyframes.rend(), [&](const Keyframe& k) {
+                return k.frame <= frame && k.input_byte <= s_temp_input.size() &&
+                       HashInput(k.input_byte) == k.input_hash;
+              });
+
+          // Playing on from the current frame is faster if it's closer to the target.
+          if (keyframe != s_keyframes.rend() &&
+              (frame < s_currentFrame || keyframe->frame > s_currentFrame))
+          {
+            State::Snapshot snapshot;
+            if (!DecodeKeyframe(*keyframe, snapshot))
+            {
+              Core::DisplayMessage("Failed to decode movie keyframe", 2000);
+              return;
+            }
+            State::LoadSnapshot(snapshot);
+          }
+          else if (frame < s_currentFrame)
+          {
+            Core::DisplayMessage(fmt::format("No keyframe before frame {}", frame), 2000);
+            return;
+          }
+        }
+
+        if (s_currentFrame < frame)
+        {
+          if (!s_seek_target)
+            s_seek_saved_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
+          s_seek_target = frame;
+          Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+          fast_forward = true;
+        }
+
+        success = true;
+      },
+      true);
+
+  if (fast_forward && Core::GetState() == Core::State::Paused)
+    Core::SetState(Core::State::Running);
+
+  return success;
+}
+
+// NOTE: Host Thread
+void SaveKeyframes(const std::string& movie_path)
+{
+  WriteKeyframes(movie_path + ".keyframes");
+}
+
 void FrameUpdate()
 {
   s_currentFrame++;
@@ -230,6 +581,25 @@ void FrameUpdate()
   }
 
   s_bPolled = false;
+
+  if (s_seek_target && s_currentFrame >= *s_seek_target)
+  {
+    EndSeek();
+    CPU::Break();
+    Core::DisplayMessage(fmt::format("Reached frame {}", s_currentFrame), 2000);
+  }
+
+  const int keyframe_interval = Config::Get(Config::MAIN_MOVIE_KEYFRAME_INTERVAL);
+  if (keyframe_interval > 0 && IsMovieActive() && s_currentFrame % keyframe_interval == 0 &&
+      !s_keyframe_capture_pending.exchange(true))
+  {
+    // Savestates have to be taken while the CPU thread is paused between slices, so do it from
+    // the host thread like a regular savestate.
+    Core::QueueHostJob([keyframe_interval] {
+      CaptureKeyframe(keyframe_interval);
+      s_keyframe_capture_pending = false;
+    });
+  }
 }
 
 static void CheckMD5();
@@ -595,6 +965,12 @@ bool BeginRecordingInput(const ControllerTypeArray& controllers,
     s_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
     s_temp_input.clear();
 
+    {
+      std::lock_guard lk(s_keyframes_mutex);
+      ClearKeyframesLocked();
+      s_keyframes_path.clear();
+    }
+
     s_currentByte = 0;
 
     if (Core::IsRunning())
@@ -977,6 +1353,13 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
   s_currentByte = 0;
   recording_file.Close();
 
+  // Keyframes that are captured during playback get added to the ones from earlier playbacks.
+  ReadKeyframes(movie_path + ".keyframes");
+  {
+    std::lock_guard lk(s_keyframes_mutex);
+    s_keyframes_path = movie_path + ".keyframes";
+  }
+
   // Load savestate (and skip to frame data)
   if (tmpHeader.bFromSaveState && savestate_path)
   {
@@ -1327,6 +1710,10 @@ bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
 // NOTE: Host / EmuThread / CPU Thread
 void EndPlayInput(bool cont)
 {
+  EndSeek();
+  if (s_playMode == PlayMode::Playing)
+    Core::QueueHostJob(SaveChangedKeyframes);
+
   if (cont)
   {
     // If !IsMovieActive(), changing s_playMode requires calling UpdateWantDeterminism
@@ -1551,6 +1938,15 @@ static void GetMD5()
 // NOTE: EmuThread
 void Shutdown()
 {
+  EndSeek();
+  SaveChangedKeyframes();
+
+  {
+    std::lock_guard lk(s_keyframes_mutex);
+    ClearKeyframesLocked();
+    s_keyframes_path.clear();
+  }
+
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
   s_temp_input.clear();
 }
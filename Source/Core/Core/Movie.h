@@ -189,6 +189,11 @@ bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
                  const WiimoteEmu::EncryptionKey& key);
 void EndPlayInput(bool cont);
 void SaveRecording(const std::string& filename);
+// Saves the keyframes taken so far next to a movie, for seeking when it is played back.
+void SaveKeyframes(const std::string& movie_path);
+// Jumps to a frame of the movie being played back, by loading the closest keyframe before it
+// and then playing the movie at full speed until the frame is reached, where emulation pauses.
+bool SeekToFrame(u64 frame);
 void DoState(PointerWrap& p);
 void Shutdown();
 void CheckPadStatus(const GCPadStatus* PadStatus, int controllerID);
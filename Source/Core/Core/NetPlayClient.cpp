@@ -4,12 +4,15 @@
 #include "Core/NetPlayClient.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <sstream>
 #include <thread>
@@ -41,6 +44,7 @@
 #include "Core/Config/SessionSettings.h"
 #include "Core/Config/WiimoteSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
@@ -83,6 +87,16 @@ using namespace WiimoteCommon;
 static std::mutex crit_netplay_client;
 static NetPlayClient* netplay_client = nullptr;
 static bool s_si_poll_batching = false;
+static std::atomic<bool> s_rollback_snapshot_pending = false;
+static std::atomic<bool> s_rollback_pending = false;
+
+// How many of the most recent inputs of each local pad every unreliable pad data packet repeats, so
+// that a lost packet is covered by the next ones without waiting for a retransmission.
+constexpr u32 PAD_DATA_REDUNDANCY = 8;
+
+// How many inputs of each local pad are kept to answer resend requests, for when more packets than
+// PAD_DATA_REDUNDANCY are lost in a row.
+constexpr size_t PAD_DATA_HISTORY_SIZE = 600;
 
 // called from ---GUI--- thread
 NetPlayClient::~NetPlayClient()
@@ -382,6 +396,15 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnPadHostData(packet);
     break;
 
+  case MessageID::PadDataRedundant:
+  case MessageID::PadDataResend:
+    OnPadDataRedundant(packet);
+    break;
+
+  case MessageID::PadDataResendRequest:
+    OnPadDataResendRequest(packet);
+    break;
+
   case MessageID::WiimoteData:
     OnWiimoteData(packet);
     break;
@@ -435,6 +458,14 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnDesyncDetected(packet);
     break;
 
+  case MessageID::StateHashDetails:
+    OnStateHashDetails(packet);
+    break;
+
+  case MessageID::DesyncRegion:
+    OnDesyncRegion(packet);
+    break;
+
   case MessageID::SyncSaveData:
     OnSyncSaveData(packet);
     break;
@@ -696,6 +727,84 @@ void NetPlayClient::OnPadHostData(sf::Packet& packet)
   }
 }
 
+void NetPlayClient::OnPadDataRedundant(sf::Packet& packet)
+{
+  while (!packet.endOfPacket())
+  {
+    PadIndex map;
+    u32 first_index;
+    u8 count;
+    packet >> map >> first_index >> count;
+
+    // Trusting server for good map value (>=0 && <4)
+    u32& next_index = m_pad_receive_next_index.at(map);
+    if (first_index > next_index)
+    {
+      // More packets were lost in a row than the redundancy covers. Ask the owner of the pad for
+      // the missing inputs, which come back on the reliable channel.
+      for (u8 i = 0; i < count; ++i)
+        ReadPadStatus(map, packet);
+
+      if (m_pad_resend_requested[map] != next_index)
+      {
+        m_pad_resend_requested[map] = next_index;
+
+        sf::Packet request;
+        request << MessageID::PadDataResendRequest;
+        request << map << next_index;
+        Send(request);
+      }
+      continue;
+    }
+
+    for (u8 i = 0; i < count; ++i)
+    {
+      const GCPadStatus pad = ReadPadStatus(map, packet);
+
+      // Skip inputs that were already received in an earlier packet.
+      if (first_index + i != next_index)
+        continue;
+
+      // add to pad buffer
+      m_pad_buffer.at(map).Push(pad);
+      ++next_index;
+      m_gc_pad_event.Set();
+    }
+  }
+}
+
+void NetPlayClient::OnPadDataResendRequest(sf::Packet& packet)
+{
+  PadIndex map;
+  u32 index;
+  packet >> map >> index;
+
+  sf::Packet response;
+  response << MessageID::PadDataResend;
+  {
+    std::lock_guard lk(m_crit.pad_send_history);
+
+    const PadSendHistory& history = m_pad_send_history.at(map);
+    const u32 first_kept_index = history.next_index - static_cast<u32>(history.inputs.size());
+    if (index < first_kept_index || index >= history.next_index)
+    {
+      ERROR_LOG_FMT(NETPLAY, "Can't resend input {} of pad {}, only {} to {} are kept", index, map,
+                    first_kept_index, history.next_index);
+      return;
+    }
+
+    while (index < history.next_index)
+    {
+      const u8 count = static_cast<u8>(std::min<u32>(history.next_index - index, 0xFF));
+      response << map << index << count;
+      for (u8 i = 0; i < count; ++i, ++index)
+        AddPadStatusToPacket(map, history.inputs[index - first_kept_index], response);
+    }
+  }
+
+  Send(response);
+}
+
 void NetPlayClient::OnWiimoteData(sf::Packet& packet)
 {
   while (!packet.endOfPacket())
@@ -899,8 +1008,10 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.sync_codes;
 
     packet >> m_net_settings.golf_mode;
+    packet >> m_net_settings.rollback;
     packet >> m_net_settings.use_fma;
     packet >> m_net_settings.hide_remote_gbas;
+    packet >> m_net_settings.state_hashing;
 
     for (size_t i = 0; i < sizeof(m_net_settings.sram); ++i)
       packet >> m_net_settings.sram[i];
@@ -972,6 +1083,46 @@ void NetPlayClient::OnDesyncDetected(sf::Packet& packet)
   m_dialog->OnDesync(frame, player);
 }
 
+void NetPlayClient::OnStateHashDetails(sf::Packet& packet)
+{
+  u32 frame;
+  packet >> frame;
+
+  const std::optional<StateHashDetails> details = m_state_hasher.GetDetails(frame);
+  if (!details)
+  {
+    WARN_LOG_FMT(NETPLAY, "State hash details for frame {} are no longer available", frame);
+    return;
+  }
+
+  sf::Packet response;
+  response << MessageID::StateHashDetails;
+  response << frame;
+  response << sf::Uint64{details->gprs};
+  response << sf::Uint64{details->fprs};
+  response << sf::Uint64{details->other_registers};
+  response << static_cast<u32>(details->pages.size());
+  for (const auto& [address, hash] : details->pages)
+  {
+    response << address;
+    response << sf::Uint64{hash};
+  }
+
+  Send(response);
+}
+
+void NetPlayClient::OnDesyncRegion(sf::Packet& packet)
+{
+  u32 frame;
+  std::string region;
+  packet >> frame;
+  packet >> region;
+
+  INFO_LOG_FMT(NETPLAY, "Desync at frame {} is in {}", frame, region);
+
+  m_dialog->OnDesyncRegion(frame, region);
+}
+
 void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
 {
   SyncSaveDataID sub_id;
@@ -986,39 +1137,124 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
     OnSyncSaveDataNotify(packet);
     break;
 
+  case SyncSaveDataID::Delta:
+    OnSyncSaveDataDelta(packet);
+    break;
+
+  default:
+    PanicAlertFmtT("Unknown SYNC_SAVE_DATA message received with id: {0}", static_cast<u8>(sub_id));
+    break;
+  }
+}
+
+static std::string GetSaveDataCachePath(const std::string& key)
+{
+  return File::GetUserPath(D_CACHE_IDX) + "NetPlaySaveData" DIR_SEP + key;
+}
+
+void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
+{
+  packet >> m_sync_save_data_count;
+  m_sync_save_data_success_count = 0;
+
+  if (m_sync_save_data_count == 0)
+  {
+    SyncSaveDataResponse(true);
+    return;
+  }
+
+  m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
+
+  // Tell the server what we still have from the last sync, so that it only sends what changed.
+  sf::Packet response;
+  response << MessageID::SyncSaveData;
+  response << SyncSaveDataID::ChunkHashes;
+  response << m_sync_save_data_count;
+  for (u8 i = 0; i < m_sync_save_data_count; ++i)
+  {
+    std::string key;
+    packet >> key;
+
+    std::string cached;
+    std::vector<SaveDataChunkHash> hashes;
+    if (Common::IsFileNameSafe(key) && File::ReadFileToString(GetSaveDataCachePath(key), cached))
+      hashes = HashSaveDataChunks({reinterpret_cast<const u8*>(cached.data()), cached.size()});
+
+    response << key << static_cast<u32>(hashes.size());
+    for (const SaveDataChunkHash& hash : hashes)
+    {
+      for (u8 byte : hash)
+        response << byte;
+    }
+  }
+
+  Send(response);
+}
+
+void NetPlayClient::OnSyncSaveDataDelta(sf::Packet& packet)
+{
+  std::string key;
+  packet >> key;
+
+  if (!Common::IsFileNameSafe(key))
+  {
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  const std::string cache_path = GetSaveDataCachePath(key);
+  std::string cached;
+  if (!File::ReadFileToString(cache_path, cached))
+    cached.clear();
+
+  const std::optional<std::vector<u8>> data =
+      ReadSaveDataDelta(packet, {reinterpret_cast<const u8*>(cached.data()), cached.size()});
+  if (!data)
+  {
+    PanicAlertFmtT("Failed to apply synchronized save data.");
+    SyncSaveDataResponse(false);
+    return;
+  }
+
+  // The cache only makes the next sync faster, so failing to write it isn't fatal.
+  if (!File::CreateFullPath(cache_path) ||
+      !File::WriteStringToFile(cache_path,
+                               {reinterpret_cast<const char*>(data->data()), data->size()}))
+  {
+    WARN_LOG_FMT(NETPLAY, "Failed to write save data cache {}", cache_path);
+  }
+
+  sf::Packet save_packet;
+  save_packet.append(data->data(), data->size());
+
+  SyncSaveDataID sub_id;
+  save_packet >> sub_id;
+
+  switch (sub_id)
+  {
   case SyncSaveDataID::RawData:
-    OnSyncSaveDataRaw(packet);
+    OnSyncSaveDataRaw(save_packet);
     break;
 
   case SyncSaveDataID::GCIData:
-    OnSyncSaveDataGCI(packet);
+    OnSyncSaveDataGCI(save_packet);
     break;
 
   case SyncSaveDataID::WiiData:
-    OnSyncSaveDataWii(packet);
+    OnSyncSaveDataWii(save_packet);
     break;
 
   case SyncSaveDataID::GBAData:
-    OnSyncSaveDataGBA(packet);
+    OnSyncSaveDataGBA(save_packet);
     break;
 
   default:
     PanicAlertFmtT("Unknown SYNC_SAVE_DATA message received with id: {0}", static_cast<u8>(sub_id));
+    SyncSaveDataResponse(false);
     break;
   }
 }
 
-void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
-{
-  packet >> m_sync_save_data_count;
-  m_sync_save_data_success_count = 0;
-
-  if (m_sync_save_data_count == 0)
-    SyncSaveDataResponse(true);
-  else
-    m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
-}
-
 void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
 {
   bool is_slot_a;
@@ -1465,7 +1701,7 @@ void NetPlayClient::OnGameDigestAbort()
 
 void NetPlayClient::Send(const sf::Packet& packet, const u8 channel_id)
 {
-  ENetUtil::SendPacket(m_server, packet, channel_id);
+  ENetUtil::SendPacket(m_server, packet, channel_id, channel_id != PAD_DATA_CHANNEL);
 }
 
 void NetPlayClient::DisplayPlayersPing()
@@ -1617,6 +1853,12 @@ void NetPlayClient::AddPadStateToPacket(const int in_game_pad, const GCPadStatus
                                         sf::Packet& packet)
 {
   packet << static_cast<PadIndex>(in_game_pad);
+  AddPadStatusToPacket(in_game_pad, pad, packet);
+}
+
+void NetPlayClient::AddPadStatusToPacket(const int in_game_pad, const GCPadStatus& pad,
+                                         sf::Packet& packet)
+{
   packet << pad.button;
   if (!m_gba_config[in_game_pad].enabled)
   {
@@ -1625,6 +1867,42 @@ void NetPlayClient::AddPadStateToPacket(const int in_game_pad, const GCPadStatus
   }
 }
 
+GCPadStatus NetPlayClient::ReadPadStatus(const int in_game_pad, sf::Packet& packet) const
+{
+  GCPadStatus pad;
+  packet >> pad.button;
+  if (!m_gba_config.at(in_game_pad).enabled)
+  {
+    packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
+        pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+  }
+  return pad;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendRedundantPadData()
+{
+  sf::Packet packet;
+  packet << MessageID::PadDataRedundant;
+  {
+    std::lock_guard lk(m_crit.pad_send_history);
+
+    for (size_t i = 0; i < m_pad_send_history.size(); ++i)
+    {
+      const PadSendHistory& history = m_pad_send_history[i];
+      const u32 count = std::min(static_cast<u32>(history.inputs.size()), PAD_DATA_REDUNDANCY);
+      if (count == 0)
+        continue;
+
+      packet << static_cast<PadIndex>(i) << history.next_index - count << static_cast<u8>(count);
+      for (size_t j = history.inputs.size() - count; j < history.inputs.size(); ++j)
+        AddPadStatusToPacket(static_cast<int>(i), history.inputs[j], packet);
+    }
+  }
+
+  SendAsync(std::move(packet), PAD_DATA_CHANNEL);
+}
+
 // called from ---CPU--- thread
 void NetPlayClient::AddWiimoteStateToPacket(int in_game_pad,
                                             const WiimoteEmu::SerializedWiimoteState& state,
@@ -1668,9 +1946,26 @@ bool NetPlayClient::StartGame(const std::string& path)
   }
 
   m_timebase_frame = 0;
+  m_state_hasher.Reset();
   m_current_golfer = 1;
   m_wait_on_input = false;
 
+  m_rollback.reset();
+  if (m_net_settings.rollback && !m_host_input_authority)
+  {
+    // Only GameCube controller inputs can be predicted and rolled back.
+    if (std::any_of(m_wiimote_map.begin(), m_wiimote_map.end(),
+                    [](PlayerId pid) { return pid > 0; }))
+    {
+      m_dialog->AppendChat(Common::GetStringT("Rollback does not support Wii Remotes, "
+                                              "falling back to fixed delay."));
+    }
+    else
+    {
+      m_rollback = std::make_unique<Rollback>();
+    }
+  }
+
   m_is_running.Set();
   NetPlay_Enable(this);
 
@@ -1850,6 +2145,12 @@ void NetPlayClient::ClearBuffers()
     while (m_wiimote_buffer[i].Size())
       m_wiimote_buffer[i].Pop();
   }
+
+  m_pad_receive_next_index.fill(0);
+  m_pad_resend_requested.fill(std::nullopt);
+
+  std::lock_guard lk(m_crit.pad_send_history);
+  m_pad_send_history.fill({});
 }
 
 // called from ---NETPLAY--- thread
@@ -1955,7 +2256,11 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_wait_on_input_event.Wait();
   }
 
-  if (IsFirstInGamePad(pad_nb) && batching)
+  // While resimulating after a rollback, the local inputs for these polls were already taken and
+  // sent to the other players.
+  const bool resimulating = m_rollback && m_rollback->IsResimulating();
+
+  if (IsFirstInGamePad(pad_nb) && batching && !resimulating)
   {
     sf::Packet packet;
     packet << MessageID::PadData;
@@ -1968,13 +2273,18 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     }
 
     if (send_packet)
-      SendAsync(std::move(packet));
+    {
+      if (m_host_input_authority)
+        SendAsync(std::move(packet));
+      else
+        SendRedundantPadData();
+    }
 
     if (m_host_input_authority)
       SendPadHostPoll(-1);
   }
 
-  if (!batching)
+  if (!batching && !resimulating)
   {
     const int local_pad = InGamePadToLocalPad(pad_nb);
     if (local_pad < 4)
@@ -1982,7 +2292,12 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
       sf::Packet packet;
       packet << MessageID::PadData;
       if (PollLocalPad(local_pad, packet))
-        SendAsync(std::move(packet));
+      {
+        if (m_host_input_authority)
+          SendAsync(std::move(packet));
+        else
+          SendRedundantPadData();
+      }
     }
 
     if (m_host_input_authority)
@@ -2016,6 +2331,10 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     }
   }
 
+  // Predicted inputs may still be rolled back, so they can't be recorded to movies.
+  if (m_rollback)
+    return GetRollbackPad(pad_nb, pad_status);
+
   // Now, we either use the data pushed earlier, or wait for the
   // other clients to send it to us
   while (m_pad_buffer[pad_nb].Size() == 0)
@@ -2043,6 +2362,61 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
   return true;
 }
 
+// called from ---CPU--- thread
+bool NetPlayClient::GetRollbackPad(const int pad_nb, GCPadStatus* pad_status)
+{
+  while (true)
+  {
+    GCPadStatus confirmed;
+    for (int i = 0; i < 4; ++i)
+    {
+      while (m_pad_buffer[i].Pop(confirmed))
+        m_rollback->AddConfirmedInput(i, confirmed);
+    }
+
+    if (const std::optional<GCPadStatus> input = m_rollback->GetNextInput(pad_nb))
+    {
+      *pad_status = *input;
+      break;
+    }
+
+    if (!m_is_running.IsSet())
+      return false;
+
+    m_gc_pad_event.Wait();
+  }
+
+  if (m_rollback->NeedsRollback())
+    QueueRollbackJob(true);
+
+  return true;
+}
+
+// Snapshots can only be taken or loaded between CPU slices, which needs the CPU thread to be
+// paused from another thread.
+void NetPlayClient::QueueRollbackJob(bool roll_back)
+{
+  std::atomic<bool>& pending = roll_back ? s_rollback_pending : s_rollback_snapshot_pending;
+  if (pending.exchange(true))
+    return;
+
+  Core::QueueHostJob([roll_back, &pending] {
+    Core::RunOnCPUThread(
+        [roll_back] {
+          std::lock_guard lk(crit_netplay_client);
+          if (!netplay_client || !netplay_client->m_rollback)
+            return;
+
+          if (roll_back)
+            netplay_client->m_rollback->RollBack();
+          else
+            netplay_client->m_rollback->SaveSnapshot();
+        },
+        true);
+    pending = false;
+  });
+}
+
 u64 NetPlayClient::GetInitialRTCValue() const
 {
   return m_initial_rtc;
@@ -2131,8 +2505,14 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
       // add to buffer
       m_pad_buffer[ingame_pad].Push(pad_status);
 
-      // add to packet
-      AddPadStateToPacket(ingame_pad, pad_status, packet);
+      // add to send history, which SendRedundantPadData sends from
+      std::lock_guard lk(m_crit.pad_send_history);
+      PadSendHistory& history = m_pad_send_history[ingame_pad];
+      history.inputs.push_back(pad_status);
+      ++history.next_index;
+      if (history.inputs.size() > PAD_DATA_HISTORY_SIZE)
+        history.inputs.pop_front();
+
       data_added = true;
     }
   }
@@ -2246,6 +2626,7 @@ bool NetPlayClient::StopGame()
   InvokeStop();
 
   NetPlay_Disable();
+  m_rollback.reset();
 
   // stop game
   m_dialog->StopGame();
@@ -2436,6 +2817,11 @@ void NetPlayClient::SendTimeBase()
 {
   std::lock_guard lk(crit_netplay_client);
 
+  // With rollback, frames may be emulated more than once, and with different inputs at first, so
+  // comparing time bases doesn't tell anything about desyncs.
+  if (netplay_client->m_rollback)
+    return;
+
   if (netplay_client->m_timebase_frame % 60 == 0)
   {
     const sf::Uint64 timebase = SystemTimers::GetFakeTimeBase();
@@ -2448,9 +2834,32 @@ void NetPlayClient::SendTimeBase()
     netplay_client->SendAsync(std::move(packet));
   }
 
+  if (netplay_client->m_net_settings.state_hashing)
+  {
+    const StateHash hash =
+        netplay_client->m_state_hasher.HashFrame(netplay_client->m_timebase_frame);
+
+    sf::Packet packet;
+    packet << MessageID::StateHash;
+    packet << netplay_client->m_timebase_frame;
+    packet << sf::Uint64{hash.registers};
+    packet << sf::Uint64{hash.memory};
+
+    netplay_client->SendAsync(std::move(packet));
+  }
+
   netplay_client->m_timebase_frame++;
 }
 
+// called from ---CPU--- thread
+void NetPlayClient::UpdateRollback()
+{
+  std::lock_guard lk(crit_netplay_client);
+
+  if (netplay_client && netplay_client->m_rollback)
+    QueueRollbackJob(false);
+}
+
 bool NetPlayClient::DoAllPlayersHaveGame()
 {
   std::lock_guard lkp(m_crit.players);
@@ -2460,27 +2869,57 @@ bool NetPlayClient::DoAllPlayersHaveGame()
   });
 }
 
+// Reading is what takes time for compressed formats, so several readers decompress the blocks ahead
+// of the hashing, which has to happen in order. The digest is still the SHA-1 of the whole disc.
 static std::string SHA1Sum(const std::string& file_path, std::function<bool(int)> report_progress)
 {
-  std::vector<u8> data(8 * 1024 * 1024);
-  u64 read_offset = 0;
+  constexpr u64 BLOCK_SIZE = 8 * 1024 * 1024;
+  const size_t reader_count = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 5) - 1;
+
+  // Blob readers can't be used from several threads at once, so each reader gets its own.
+  std::vector<std::unique_ptr<DiscIO::BlobReader>> readers(reader_count);
+  for (std::unique_ptr<DiscIO::BlobReader>& reader : readers)
+  {
+    reader = DiscIO::CreateBlobReader(file_path);
+    if (!reader)
+      return "";
+  }
 
-  std::unique_ptr<DiscIO::BlobReader> file(DiscIO::CreateBlobReader(file_path));
-  u64 game_size = file->GetDataSize();
+  const u64 game_size = readers[0]->GetDataSize();
+  const u64 block_count = (game_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+  // Block i is read into slot i % reader_count, by reader i % reader_count. A slot is only reused
+  // once the block in it has been hashed.
+  std::vector<std::vector<u8>> buffers(reader_count, std::vector<u8>(BLOCK_SIZE));
+  std::vector<std::future<bool>> reads(reader_count);
+  const auto start_read = [&](u64 block) {
+    const size_t slot = block % reader_count;
+    const u64 offset = block * BLOCK_SIZE;
+    const size_t size = static_cast<size_t>(std::min(BLOCK_SIZE, game_size - offset));
+    reads[slot] = std::async(std::launch::async, [&readers, &buffers, slot, offset, size] {
+      return readers[slot]->Read(offset, size, buffers[slot].data());
+    });
+  };
+
+  for (u64 block = 0; block < std::min<u64>(block_count, reader_count); ++block)
+    start_read(block);
 
   auto ctx = Common::SHA1::CreateContext();
 
-  while (read_offset < game_size)
+  for (u64 block = 0; block < block_count; ++block)
   {
-    size_t read_size = std::min(static_cast<u64>(data.size()), game_size - read_offset);
-    if (!file->Read(read_offset, read_size, data.data()))
+    const size_t slot = block % reader_count;
+    if (!reads[slot].get())
       return "";
 
-    ctx->Update(data.data(), read_size);
-    read_offset += read_size;
+    const u64 read_end = std::min((block + 1) * BLOCK_SIZE, game_size);
+    ctx->Update(buffers[slot].data(), static_cast<size_t>(read_end - block * BLOCK_SIZE));
+
+    if (block + reader_count < block_count)
+      start_read(block + reader_count);
 
     int progress =
-        static_cast<int>(static_cast<float>(read_offset) / static_cast<float>(game_size) * 100);
+        static_cast<int>(static_cast<float>(read_end) / static_cast<float>(game_size) * 100);
     if (!report_progress(progress))
       return "";
   }
@@ -2489,6 +2928,75 @@ static std::string SHA1Sum(const std::string& file_path, std::function<bool(int)
   return fmt::format("{:02x}", fmt::join(ctx->Finish(), ""));
 }
 
+// Digests are cached by path, size and modification time, so that checking the same game again
+// is instant.
+constexpr size_t MAX_CACHED_GAME_DIGESTS = 256;
+
+static std::string GetGameDigestCachePath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "netplay_digests.txt";
+}
+
+static std::string GetGameDigestCacheKey(const std::string& file_path)
+{
+  const File::FileInfo info(file_path);
+  const s64 modified = info.GetModificationTime();
+  if (!info.IsFile() || modified == 0)
+    return "";
+
+  return fmt::format("{} {} {}", info.GetSize(), modified, file_path);
+}
+
+static std::vector<std::string> ReadGameDigestCache()
+{
+  std::string contents;
+  if (!File::ReadFileToString(GetGameDigestCachePath(), contents))
+    return {};
+
+  std::vector<std::string> lines = SplitString(contents, '\n');
+  std::erase_if(lines, [](const std::string& line) { return line.empty(); });
+  return lines;
+}
+
+// Each line of the cache is the digest, followed by a space and the key.
+static std::string LookUpCachedGameDigest(const std::string& key)
+{
+  if (key.empty())
+    return "";
+
+  for (const std::string& line : ReadGameDigestCache())
+  {
+    const size_t space = line.find(' ');
+    if (space != std::string::npos && std::string_view(line).substr(space + 1) == key)
+      return line.substr(0, space);
+  }
+
+  return "";
+}
+
+static void CacheGameDigest(const std::string& key, const std::string& digest)
+{
+  if (key.empty())
+    return;
+
+  std::vector<std::string> lines = ReadGameDigestCache();
+  std::erase_if(lines, [&key](const std::string& line) {
+    const size_t space = line.find(' ');
+    return space == std::string::npos || std::string_view(line).substr(space + 1) == key;
+  });
+  lines.push_back(fmt::format("{} {}", digest, key));
+
+  const size_t first = lines.size() > MAX_CACHED_GAME_DIGESTS ?
+                           lines.size() - MAX_CACHED_GAME_DIGESTS :
+                           0;
+  std::string contents;
+  for (size_t i = first; i < lines.size(); ++i)
+    contents += lines[i] + '\n';
+
+  if (!File::WriteStringToFile(GetGameDigestCachePath(), contents))
+    WARN_LOG_FMT(NETPLAY, "Failed to write the game digest cache");
+}
+
 void NetPlayClient::ComputeGameDigest(const SyncIdentifier& sync_identifier)
 {
   if (m_should_compute_game_digest)
@@ -2515,14 +3023,22 @@ void NetPlayClient::ComputeGameDigest(const SyncIdentifier& sync_identifier)
   if (m_game_digest_thread.joinable())
     m_game_digest_thread.join();
   m_game_digest_thread = std::thread([this, file]() {
-    std::string sum = SHA1Sum(file, [&](int progress) {
-      sf::Packet packet;
-      packet << MessageID::GameDigestProgress;
-      packet << progress;
-      SendAsync(std::move(packet));
+    const std::string cache_key = GetGameDigestCacheKey(file);
+    std::string sum = LookUpCachedGameDigest(cache_key);
+    if (sum.empty())
+    {
+      sum = SHA1Sum(file, [&](int progress) {
+        sf::Packet packet;
+        packet << MessageID::GameDigestProgress;
+        packet << progress;
+        SendAsync(std::move(packet));
 
-      return m_should_compute_game_digest;
-    });
+        return m_should_compute_game_digest;
+      });
+
+      if (!sum.empty())
+        CacheGameDigest(cache_key, sum);
+    }
 
     sf::Packet packet;
     packet << MessageID::GameDigestResult;
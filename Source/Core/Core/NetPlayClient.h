@@ -6,9 +6,11 @@
 #include <SFML/Network/Packet.hpp>
 #include <array>
 #include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <thread>
@@ -21,6 +23,8 @@
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayRollback.h"
+#include "Core/NetPlayStateHash.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 
@@ -66,6 +70,7 @@ public:
   virtual void OnPadBufferChanged(u32 buffer) = 0;
   virtual void OnHostInputAuthorityChanged(bool enabled) = 0;
   virtual void OnDesync(u32 frame, const std::string& player) = 0;
+  virtual void OnDesyncRegion(u32 frame, const std::string& region) = 0;
   virtual void OnConnectionLost() = 0;
   virtual void OnConnectionError(const std::string& message) = 0;
   virtual void OnTraversalError(TraversalClient::FailureReason error) = 0;
@@ -164,6 +169,7 @@ public:
   const PlayerId& GetLocalPlayerId() const;
 
   static void SendTimeBase();
+  static void UpdateRollback();
   bool DoAllPlayersHaveGame();
 
   const PadMappingArray& GetPadMapping() const;
@@ -192,6 +198,7 @@ protected:
     // lock order
     std::recursive_mutex players;
     std::recursive_mutex async_queue_write;
+    std::mutex pad_send_history;
   } m_crit;
 
   Common::SPSCQueue<AsyncQueueEntry, false> m_async_queue;
@@ -202,6 +209,19 @@ protected:
   std::array<GCPadStatus, 4> m_last_pad_status{};
   std::array<bool, 4> m_first_pad_status_received{};
 
+  // Inputs of local pads that were already sent, kept around to be repeated in later packets and
+  // to answer resend requests.
+  struct PadSendHistory
+  {
+    std::deque<GCPadStatus> inputs;
+    u32 next_index = 0;
+  };
+  std::array<PadSendHistory, 4> m_pad_send_history;
+
+  // Index of the next input expected from each remote pad.
+  std::array<u32, 4> m_pad_receive_next_index{};
+  std::array<std::optional<u32>, 4> m_pad_resend_requested{};
+
   std::chrono::time_point<std::chrono::steady_clock> m_buffer_under_target_last;
 
   NetPlayUI* m_dialog = nullptr;
@@ -237,6 +257,9 @@ protected:
 
   bool m_is_recording = false;
 
+  // Only set while a game is running in rollback mode.
+  std::unique_ptr<Rollback> m_rollback;
+
 private:
   enum class ConnectionState
   {
@@ -255,6 +278,8 @@ private:
   void SyncCodeResponse(bool success);
 
   bool PollLocalPad(int local_pad, sf::Packet& packet);
+  bool GetRollbackPad(int pad_nb, GCPadStatus* pad_status);
+  static void QueueRollbackJob(bool roll_back);
   void SendPadHostPoll(PadIndex pad_num);
 
   bool AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state,
@@ -262,6 +287,9 @@ private:
 
   void UpdateDevices();
   void AddPadStateToPacket(int in_game_pad, const GCPadStatus& np, sf::Packet& packet);
+  void AddPadStatusToPacket(int in_game_pad, const GCPadStatus& np, sf::Packet& packet);
+  GCPadStatus ReadPadStatus(int in_game_pad, sf::Packet& packet) const;
+  void SendRedundantPadData();
   void AddWiimoteStateToPacket(int in_game_pad, const WiimoteEmu::SerializedWiimoteState& np,
                                sf::Packet& packet);
   void Send(const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
@@ -285,6 +313,8 @@ private:
   void OnGBAConfig(sf::Packet& packet);
   void OnPadData(sf::Packet& packet);
   void OnPadHostData(sf::Packet& packet);
+  void OnPadDataRedundant(sf::Packet& packet);
+  void OnPadDataResendRequest(sf::Packet& packet);
   void OnWiimoteData(sf::Packet& packet);
   void OnPadBuffer(sf::Packet& packet);
   void OnHostInputAuthority(sf::Packet& packet);
@@ -298,8 +328,11 @@ private:
   void OnPing(sf::Packet& packet);
   void OnPlayerPingData(sf::Packet& packet);
   void OnDesyncDetected(sf::Packet& packet);
+  void OnStateHashDetails(sf::Packet& packet);
+  void OnDesyncRegion(sf::Packet& packet);
   void OnSyncSaveData(sf::Packet& packet);
   void OnSyncSaveDataNotify(sf::Packet& packet);
+  void OnSyncSaveDataDelta(sf::Packet& packet);
   void OnSyncSaveDataRaw(sf::Packet& packet);
   void OnSyncSaveDataGCI(sf::Packet& packet);
   void OnSyncSaveDataWii(sf::Packet& packet);
@@ -344,6 +377,7 @@ private:
 
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
+  StateHasher m_state_hasher;
 
   std::unique_ptr<IOS::HLE::FS::FileSystem> m_wii_sync_fs;
   std::vector<u64> m_wii_sync_titles;
@@ -4,6 +4,11 @@
 #include "Core/NetPlayCommon.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <future>
+#include <map>
+#include <thread>
 
 #include <fmt/format.h>
 #include <lzo/lzo1x.h>
@@ -18,6 +23,83 @@ namespace NetPlay
 constexpr u32 LZO_IN_LEN = 1024 * 64;
 constexpr u32 LZO_OUT_LEN = LZO_IN_LEN + (LZO_IN_LEN / 16) + 64 + 3;
 
+// Save data chunks are cut where the top bits of a rolling hash over the last 64 bytes are zero,
+// which happens every 8 KiB on average, within these bounds.
+constexpr size_t SAVE_DATA_MIN_CHUNK_SIZE = 2 * 1024;
+constexpr size_t SAVE_DATA_MAX_CHUNK_SIZE = 64 * 1024;
+constexpr u64 SAVE_DATA_CHUNK_MASK = ((u64{1} << 13) - 1) << 51;
+
+// Random values for the rolling hash, which must be the same for everyone.
+static constexpr std::array<u64, 256> GenerateGearTable()
+{
+  std::array<u64, 256> table{};
+  u64 state = 0x4e6574506c617953;
+  for (u64& value : table)
+  {
+    // splitmix64
+    state += 0x9e3779b97f4a7c15;
+    u64 z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    value = z ^ (z >> 31);
+  }
+  return table;
+}
+constexpr std::array<u64, 256> GEAR_TABLE = GenerateGearTable();
+
+// Compresses data in independent LZO blocks of LZO_IN_LEN bytes, spread over all cores, and writes
+// them to the packet in order.
+static bool CompressIntoPacket(std::span<const u8> data, sf::Packet& packet)
+{
+  const size_t block_count = (data.size() + LZO_IN_LEN - 1) / LZO_IN_LEN;
+  std::vector<std::vector<u8>> blocks(block_count);
+  std::atomic<bool> success = true;
+
+  const size_t threads = std::min<size_t>(
+      block_count, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
+  std::vector<std::future<void>> futures(threads);
+  for (size_t t = 0; t < threads; ++t)
+  {
+    futures[t] = std::async(std::launch::async, [&, t] {
+      std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
+      for (size_t i = t * block_count / threads; i < (t + 1) * block_count / threads; ++i)
+      {
+        const std::span<const u8> in = data.subspan(i * LZO_IN_LEN).first(
+            std::min<size_t>(LZO_IN_LEN, data.size() - i * LZO_IN_LEN));
+        lzo_uint out_len = 0;
+        blocks[i].resize(LZO_OUT_LEN);
+        if (lzo1x_1_compress(in.data(), static_cast<lzo_uint>(in.size()), blocks[i].data(),
+                             &out_len, wrkmem.data()) != LZO_E_OK)
+        {
+          success = false;
+          return;
+        }
+        blocks[i].resize(out_len);
+      }
+    });
+  }
+  for (std::future<void>& future : futures)
+    future.get();
+
+  if (!success)
+  {
+    PanicAlertFmtT("Internal LZO Error - compression failed");
+    return false;
+  }
+
+  for (const std::vector<u8>& block : blocks)
+  {
+    // The size of the data to write is 'out_len'
+    packet << static_cast<u32>(block.size());
+    packet.append(block.data(), block.size());
+  }
+
+  // Mark end of data
+  packet << static_cast<u32>(0);
+
+  return true;
+}
+
 bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
 {
   File::IOFile file(file_path, "rb");
@@ -33,58 +115,14 @@ bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
   if (size == 0)
     return true;
 
-  std::vector<u8> in_buffer(LZO_IN_LEN);
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
-
-  lzo_uint i = 0;
-  while (true)
+  std::vector<u8> in_buffer(size);
+  if (!file.ReadBytes(in_buffer.data(), in_buffer.size()))
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // EOF
-
-    if (!file.ReadBytes(in_buffer.data(), cur_len))
-    {
-      PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
-      return false;
-    }
-
-    if (lzo1x_1_compress(in_buffer.data(), cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
-
-    if (cur_len != LZO_IN_LEN)
-      break;
-
-    i += cur_len;
+    PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
+    return false;
   }
 
-  // Mark end of data
-  packet << static_cast<u32>(0);
-
-  return true;
+  return CompressIntoPacket(in_buffer, packet);
 }
 
 static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::Packet& packet)
@@ -124,51 +162,7 @@ bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& pack
   if (size == 0)
     return true;
 
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
-
-  lzo_uint i = 0;
-  while (true)
-  {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // end of buffer
-
-    if (lzo1x_1_compress(&in_buffer[i], cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
-
-    if (cur_len != LZO_IN_LEN)
-      break;
-
-    i += cur_len;
-  }
-
-  // Mark end of data
-  packet << static_cast<u32>(0);
-
-  return true;
+  return CompressIntoPacket(in_buffer, packet);
 }
 
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
@@ -297,4 +291,119 @@ std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
 
   return out_buffer;
 }
+
+std::vector<std::span<const u8>> SplitSaveDataIntoChunks(std::span<const u8> data)
+{
+  std::vector<std::span<const u8>> chunks;
+
+  size_t chunk_start = 0;
+  u64 hash = 0;
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    hash = (hash << 1) + GEAR_TABLE[data[i]];
+
+    const size_t chunk_size = i + 1 - chunk_start;
+    if ((chunk_size >= SAVE_DATA_MIN_CHUNK_SIZE && (hash & SAVE_DATA_CHUNK_MASK) == 0) ||
+        chunk_size >= SAVE_DATA_MAX_CHUNK_SIZE)
+    {
+      chunks.push_back(data.subspan(chunk_start, chunk_size));
+      chunk_start = i + 1;
+      hash = 0;
+    }
+  }
+
+  if (chunk_start < data.size())
+    chunks.push_back(data.subspan(chunk_start));
+
+  return chunks;
+}
+
+std::vector<SaveDataChunkHash> HashSaveDataChunks(std::span<const u8> data)
+{
+  std::vector<SaveDataChunkHash> hashes;
+  for (const std::span<const u8> chunk : SplitSaveDataIntoChunks(data))
+    hashes.push_back(Common::SHA1::CalculateDigest(chunk.data(), chunk.size()));
+  return hashes;
+}
+
+void WriteSaveDataDelta(std::span<const u8> data, const std::set<SaveDataChunkHash>& known_chunks,
+                        sf::Packet& packet)
+{
+  const std::vector<std::span<const u8>> chunks = SplitSaveDataIntoChunks(data);
+
+  packet << sf::Uint64{data.size()};
+  for (u8 byte : Common::SHA1::CalculateDigest(data.data(), data.size()))
+    packet << byte;
+
+  packet << static_cast<u32>(chunks.size());
+  for (const std::span<const u8> chunk : chunks)
+  {
+    const SaveDataChunkHash hash = Common::SHA1::CalculateDigest(chunk.data(), chunk.size());
+    const bool known = known_chunks.contains(hash);
+    packet << known;
+    if (known)
+    {
+      for (u8 byte : hash)
+        packet << byte;
+    }
+    else
+    {
+      packet << static_cast<u32>(chunk.size());
+      packet.append(chunk.data(), chunk.size());
+    }
+  }
+}
+
+std::optional<std::vector<u8>> ReadSaveDataDelta(sf::Packet& packet, std::span<const u8> base)
+{
+  std::map<SaveDataChunkHash, std::span<const u8>> base_chunks;
+  for (const std::span<const u8> chunk : SplitSaveDataIntoChunks(base))
+    base_chunks.emplace(Common::SHA1::CalculateDigest(chunk.data(), chunk.size()), chunk);
+
+  const u64 size = Common::PacketReadU64(packet);
+  SaveDataChunkHash expected_hash;
+  for (u8& byte : expected_hash)
+    packet >> byte;
+
+  std::vector<u8> data;
+  data.reserve(size);
+
+  u32 chunk_count;
+  packet >> chunk_count;
+  for (u32 i = 0; i < chunk_count && packet; ++i)
+  {
+    bool known;
+    packet >> known;
+    if (known)
+    {
+      SaveDataChunkHash hash;
+      for (u8& byte : hash)
+        packet >> byte;
+
+      const auto it = base_chunks.find(hash);
+      if (it == base_chunks.end())
+        return std::nullopt;
+      data.insert(data.end(), it->second.begin(), it->second.end());
+    }
+    else
+    {
+      u32 chunk_size;
+      packet >> chunk_size;
+      for (u32 j = 0; j < chunk_size && packet; ++j)
+      {
+        u8 byte;
+        packet >> byte;
+        data.push_back(byte);
+      }
+    }
+  }
+
+  if (!packet || data.size() != size ||
+      Common::SHA1::CalculateDigest(data.data(), data.size()) != expected_hash)
+  {
+    return std::nullopt;
+  }
+
+  return data;
+}
 }  // namespace NetPlay
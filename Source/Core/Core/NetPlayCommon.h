@@ -8,10 +8,13 @@
 #include <array>
 #include <chrono>
 #include <optional>
+#include <set>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 
 namespace NetPlay
 {
@@ -26,4 +29,15 @@ bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& pack
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path);
 bool DecompressPacketIntoFolder(sf::Packet& packet, const std::string& folder_path);
 std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet);
+
+// Synced save data is sent as a delta against what the client received for the same save the last
+// time. Both sides split the data into chunks at content-defined boundaries, so that chunks after
+// a change still line up even if the change shifted the data around. The client sends the hashes
+// of the chunks it has, and only the chunks it doesn't have are sent.
+using SaveDataChunkHash = Common::SHA1::Digest;
+std::vector<std::span<const u8>> SplitSaveDataIntoChunks(std::span<const u8> data);
+std::vector<SaveDataChunkHash> HashSaveDataChunks(std::span<const u8> data);
+void WriteSaveDataDelta(std::span<const u8> data, const std::set<SaveDataChunkHash>& known_chunks,
+                        sf::Packet& packet);
+std::optional<std::vector<u8>> ReadSaveDataDelta(sf::Packet& packet, std::span<const u8> base);
 }  // namespace NetPlay
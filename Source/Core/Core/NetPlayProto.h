@@ -99,9 +99,11 @@ struct NetSettings
   bool savedata_sync_all_wii = false;
 
   bool strict_settings_sync = false;
+  bool state_hashing = false;
   bool sync_codes = false;
   std::string save_data_region;
   bool golf_mode = false;
+  bool rollback = false;
   bool use_fma = false;
   bool hide_remote_gbas = false;
 
@@ -147,6 +149,9 @@ enum class MessageID : u8
   PadBuffer = 0x62,
   PadHostData = 0x63,
   GBAConfig = 0x64,
+  PadDataRedundant = 0x65,
+  PadDataResendRequest = 0x66,
+  PadDataResend = 0x67,
 
   WiimoteData = 0x70,
   WiimoteMapping = 0x71,
@@ -168,6 +173,9 @@ enum class MessageID : u8
 
   TimeBase = 0xB0,
   DesyncDetected = 0xB1,
+  StateHash = 0xB2,
+  StateHashDetails = 0xB3,
+  DesyncRegion = 0xB4,
 
   ComputeGameDigest = 0xC0,
   GameDigestProgress = 0xC1,
@@ -203,7 +211,9 @@ enum class SyncSaveDataID : u8
   RawData = 3,
   GCIData = 4,
   WiiData = 5,
-  GBAData = 6
+  GBAData = 6,
+  ChunkHashes = 7,
+  Delta = 8
 };
 
 enum class SyncCodeID : u8
@@ -224,6 +234,8 @@ enum : u8
 {
   DEFAULT_CHANNEL,
   CHUNKED_DATA_CHANNEL,
+  // Unreliable, only used for MessageID::PadDataRedundant.
+  PAD_DATA_CHANNEL,
   CHANNEL_COUNT
 };
 
@@ -0,0 +1,197 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayRollback.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "Common/Config/Config.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+
+#include "VideoCommon/OnScreenDisplay.h"
+
+namespace NetPlay
+{
+// How many inputs per pad can be predicted before waiting for the other players.
+constexpr u64 MAX_PREDICTED_INPUTS = 8;
+
+// Snapshots are taken once per frame, so this needs to cover at least as many frames as can pass
+// while MAX_PREDICTED_INPUTS inputs are outstanding.
+constexpr size_t MAX_SNAPSHOTS = 12;
+
+static bool IsSameInput(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return a.button == b.button && a.stickX == b.stickX && a.stickY == b.stickY &&
+         a.substickX == b.substickX && a.substickY == b.substickY &&
+         a.triggerLeft == b.triggerLeft && a.triggerRight == b.triggerRight &&
+         a.analogA == b.analogA && a.analogB == b.analogB && a.isConnected == b.isConnected;
+}
+
+void Rollback::AddConfirmedInput(int pad_nb, const GCPadStatus& status)
+{
+  PadHistory& pad = m_pads[pad_nb];
+  const InputIndex index = pad.confirmed_count++;
+  pad.last_confirmed = status;
+
+  if (index < pad.first_index + pad.inputs.size())
+  {
+    Input& input = pad.inputs[index - pad.first_index];
+
+    // Predictions that haven't been used since the last rollback will be redone anyway.
+    if (index < m_poll_counts[pad_nb] && !IsSameInput(input.status, status))
+      pad.misprediction = std::min(pad.misprediction.value_or(index), index);
+
+    input = {status, true};
+  }
+  else
+  {
+    pad.inputs.push_back({status, true});
+  }
+}
+
+std::optional<GCPadStatus> Rollback::GetNextInput(int pad_nb)
+{
+  PadHistory& pad = m_pads[pad_nb];
+  const InputIndex index = m_poll_counts[pad_nb];
+
+  if (index >= pad.confirmed_count &&
+      (pad.confirmed_count == 0 || index - pad.confirmed_count >= MAX_PREDICTED_INPUTS))
+  {
+    return std::nullopt;
+  }
+
+  if (index == pad.first_index + pad.inputs.size())
+    pad.inputs.push_back({pad.last_confirmed, false});
+
+  Input& input = pad.inputs[index - pad.first_index];
+  if (!input.confirmed)
+    input.status = pad.last_confirmed;
+
+  ++m_poll_counts[pad_nb];
+
+  if (m_resimulation_target)
+  {
+    bool caught_up = true;
+    for (size_t i = 0; i < m_poll_counts.size(); ++i)
+      caught_up &= m_poll_counts[i] >= (*m_resimulation_target)[i];
+    if (caught_up)
+      EndResimulation();
+  }
+
+  return input.status;
+}
+
+bool Rollback::NeedsRollback() const
+{
+  return std::any_of(m_pads.begin(), m_pads.end(),
+                     [](const PadHistory& pad) { return pad.misprediction.has_value(); });
+}
+
+void Rollback::SaveSnapshot()
+{
+  // Nothing was polled since the last one, so it would be identical.
+  if (!m_snapshots.empty() && m_snapshots.back().poll_counts == m_poll_counts)
+    return;
+
+  SavedSnapshot saved;
+  if (m_snapshots.size() >= MAX_SNAPSHOTS)
+  {
+    saved.snapshot = std::move(m_snapshots.front().snapshot);
+    m_snapshots.pop_front();
+  }
+  else if (!m_free_snapshots.empty())
+  {
+    saved.snapshot = std::move(m_free_snapshots.back());
+    m_free_snapshots.pop_back();
+  }
+  else
+  {
+    saved.snapshot = std::make_unique<State::Snapshot>();
+  }
+
+  State::SaveSnapshot(*saved.snapshot);
+  saved.poll_counts = m_poll_counts;
+  m_snapshots.push_back(std::move(saved));
+
+  PruneInputs();
+}
+
+void Rollback::RollBack()
+{
+  // Find the newest snapshot that was taken before any of the mispredicted inputs were used.
+  const auto it = std::find_if(m_snapshots.rbegin(), m_snapshots.rend(), [this](const auto& saved) {
+    for (size_t i = 0; i < m_pads.size(); ++i)
+    {
+      if (m_pads[i].misprediction && saved.poll_counts[i] > *m_pads[i].misprediction)
+        return false;
+    }
+    return true;
+  });
+
+  for (PadHistory& pad : m_pads)
+    pad.misprediction.reset();
+
+  if (it == m_snapshots.rend())
+  {
+    ERROR_LOG_FMT(NETPLAY, "Misprediction is older than every rollback snapshot");
+    OSD::AddMessage("Rollback failed, a desync is likely", OSD::Duration::NORMAL,
+                    OSD::Color::RED);
+    return;
+  }
+
+  State::LoadSnapshot(*it->snapshot);
+
+  if (!m_resimulation_target)
+  {
+    m_resimulation_target = m_poll_counts;
+    BeginResimulation();
+  }
+  m_poll_counts = it->poll_counts;
+
+  // Snapshots taken after this one are from the mispredicted timeline.
+  const size_t valid_count = m_snapshots.rend() - it;
+  while (m_snapshots.size() > valid_count)
+  {
+    m_free_snapshots.push_back(std::move(m_snapshots.back().snapshot));
+    m_snapshots.pop_back();
+  }
+}
+
+void Rollback::PruneInputs()
+{
+  // Inputs from before the oldest snapshot can't be rolled back to anymore.
+  for (size_t i = 0; i < m_pads.size(); ++i)
+  {
+    PadHistory& pad = m_pads[i];
+    const InputIndex keep_from = std::min(m_snapshots.front().poll_counts[i], pad.confirmed_count);
+    while (pad.first_index < keep_from && !pad.inputs.empty())
+    {
+      pad.inputs.pop_front();
+      ++pad.first_index;
+    }
+  }
+}
+
+void Rollback::BeginResimulation()
+{
+  m_saved_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
+  m_saved_audio_muted = Config::Get(Config::MAIN_AUDIO_MUTED);
+  m_saved_skip_presentation = Config::Get(Config::GFX_HACK_SKIP_PRESENTATION);
+
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_AUDIO_MUTED, true);
+  Config::SetCurrent(Config::GFX_HACK_SKIP_PRESENTATION, true);
+}
+
+void Rollback::EndResimulation()
+{
+  m_resimulation_target.reset();
+
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, m_saved_emulation_speed);
+  Config::SetCurrent(Config::MAIN_AUDIO_MUTED, m_saved_audio_muted);
+  Config::SetCurrent(Config::GFX_HACK_SKIP_PRESENTATION, m_saved_skip_presentation);
+}
+}  // namespace NetPlay
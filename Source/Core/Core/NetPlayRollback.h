@@ -0,0 +1,92 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/State.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// Rollback for GameCube controller inputs.
+//
+// Instead of waiting for inputs from other players, the next one is predicted to be the same as the
+// last one that was received, and emulation carries on. Snapshots of the emulated state are taken
+// every frame. When a prediction turns out to be wrong, the newest snapshot from before that input
+// is loaded, and the frames since then are emulated again as fast as possible, without presenting
+// video or playing audio.
+//
+// Inputs are numbered per pad in the order the game polls them, which is the same for everyone
+// since emulation is deterministic, so snapshots don't have to line up with polls or frames.
+//
+// Must only be used from the CPU thread. SaveSnapshot and RollBack must additionally be called
+// between CPU slices, like any other savestate.
+class Rollback
+{
+public:
+  // Adds the next confirmed input for a pad, either a local one or one received from another
+  // player.
+  void AddConfirmedInput(int pad_nb, const GCPadStatus& status);
+
+  // Returns the input for the next poll of a pad, predicting it if needed. Returns std::nullopt if
+  // nothing has been received for the pad yet or if too many inputs would have to be predicted,
+  // in which case the caller has to wait for more inputs to be confirmed.
+  std::optional<GCPadStatus> GetNextInput(int pad_nb);
+
+  bool IsResimulating() const { return m_resimulation_target.has_value(); }
+  bool NeedsRollback() const;
+
+  void SaveSnapshot();
+  void RollBack();
+
+private:
+  using InputIndex = u64;
+  using InputCounts = std::array<InputIndex, 4>;
+
+  struct Input
+  {
+    GCPadStatus status;
+    bool confirmed;
+  };
+
+  struct PadHistory
+  {
+    // inputs[i] is the input with index first_index + i.
+    std::deque<Input> inputs;
+    InputIndex first_index = 0;
+    InputIndex confirmed_count = 0;
+    GCPadStatus last_confirmed;
+    // The first input that was used in the current timeline and then confirmed as something else.
+    std::optional<InputIndex> misprediction;
+  };
+
+  struct SavedSnapshot
+  {
+    std::unique_ptr<State::Snapshot> snapshot;
+    InputCounts poll_counts;
+  };
+
+  void PruneInputs();
+  void BeginResimulation();
+  void EndResimulation();
+
+  std::array<PadHistory, 4> m_pads;
+  InputCounts m_poll_counts{};
+
+  std::deque<SavedSnapshot> m_snapshots;
+  std::vector<std::unique_ptr<State::Snapshot>> m_free_snapshots;
+
+  // The poll counts from before the last rollback, which is how far resimulating has to go.
+  std::optional<InputCounts> m_resimulation_target;
+  float m_saved_emulation_speed = 1.0f;
+  bool m_saved_audio_muted = false;
+  bool m_saved_skip_presentation = false;
+};
+}  // namespace NetPlay
@@ -7,9 +7,11 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdio>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -615,6 +617,87 @@ void NetPlayServer::UpdateWiimoteMapping()
   SendToClients(spac);
 }
 
+template <typename T>
+static bool AreAllEqual(const std::vector<std::pair<PlayerId, T>>& values)
+{
+  return std::all_of(values.begin(), values.end(), [&](const std::pair<PlayerId, T>& pair) {
+    return pair.second == values[0].second;
+  });
+}
+
+// Returns the player whose value is the only one that differs, or 0 if there's no such player.
+template <typename T>
+static PlayerId FindOutlier(const std::vector<std::pair<PlayerId, T>>& values)
+{
+  for (const auto& pair : values)
+  {
+    if (std::all_of(values.begin(), values.end(), [&](const std::pair<PlayerId, T>& other) {
+          return other.first == pair.first || other.second != pair.second;
+        }))
+    {
+      return pair.first;
+    }
+  }
+
+  return 0;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::OnDesync(PlayerId pid_to_blame, u32 frame)
+{
+  sf::Packet spac;
+  spac << MessageID::DesyncDetected;
+  spac << static_cast<int>(pid_to_blame);
+  spac << frame;
+  SendToClients(spac);
+
+  m_desync_detected = true;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::ReportDesyncRegion()
+{
+  const auto differs = [this](auto get) {
+    return !std::all_of(m_state_hash_details.begin(), m_state_hash_details.end(),
+                        [&](const auto& pair) {
+                          return get(pair.second) == get(m_state_hash_details[0].second);
+                        });
+  };
+
+  std::vector<std::string> regions;
+  if (differs([](const StateHashDetails& d) { return d.gprs; }))
+    regions.emplace_back("general purpose registers");
+  if (differs([](const StateHashDetails& d) { return d.fprs; }))
+    regions.emplace_back("floating point registers");
+  if (differs([](const StateHashDetails& d) { return d.other_registers; }))
+    regions.emplace_back("other CPU registers");
+
+  // The memory hashes matched on the previous frame, so any page that differs now is one of the
+  // pages that were rehashed on this frame.
+  const std::vector<std::pair<u32, u64>>& pages = m_state_hash_details[0].second.pages;
+  if (differs([](const StateHashDetails& d) { return d.pages.size(); }))
+  {
+    regions.emplace_back("memory");
+  }
+  else
+  {
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+      if (differs([i](const StateHashDetails& d) { return d.pages[i]; }))
+        regions.emplace_back(fmt::format("memory page {:08x}", pages[i].first));
+    }
+  }
+
+  if (regions.empty())
+    regions.emplace_back("an unknown part of the emulated state");
+
+  sf::Packet spac;
+  spac << MessageID::DesyncRegion;
+  spac << *m_state_hash_details_frame;
+  spac << JoinStrings(regions, ", ");
+  SendToClients(spac);
+}
+
 // called from ---GUI--- thread and ---NETPLAY--- thread
 void NetPlayServer::AdjustPadBufferSize(unsigned int size)
 {
@@ -791,6 +874,61 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case MessageID::PadDataRedundant:
+  case MessageID::PadDataResend:
+  {
+    // if this is pad data from the last game still being received, ignore it
+    if (player.current_game != m_current_game)
+      break;
+
+    while (!packet.endOfPacket())
+    {
+      PadIndex map;
+      u32 first_index;
+      u8 count;
+      packet >> map >> first_index >> count;
+
+      // If the data is not from the correct player,
+      // then disconnect them.
+      if (m_pad_map.at(map) != player.pid)
+      {
+        return 1;
+      }
+
+      for (u8 i = 0; i < count; ++i)
+      {
+        GCPadStatus pad;
+        packet >> pad.button;
+        if (!m_gba_config.at(map).enabled)
+        {
+          packet >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >> pad.substickX >>
+              pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
+        }
+      }
+    }
+
+    // Resends answer a request for inputs that got lost, so they have to be reliable.
+    SendToClients(packet, player.pid,
+                  mid == MessageID::PadDataRedundant ? PAD_DATA_CHANNEL : DEFAULT_CHANNEL);
+  }
+  break;
+
+  case MessageID::PadDataResendRequest:
+  {
+    if (player.current_game != m_current_game)
+      break;
+
+    PadIndex map;
+    u32 index;
+    packet >> map >> index;
+
+    // Forward the request to whoever owns the pad.
+    const auto owner = m_players.find(m_pad_map.at(map));
+    if (owner != m_players.end())
+      Send(owner->second.socket, packet);
+  }
+  break;
+
   case MessageID::PadHostData:
   {
     // Kick player if they're not the golfer.
@@ -1007,32 +1145,77 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     {
       // we have all records for this frame
 
-      if (!std::all_of(timebases.begin(), timebases.end(), [&](std::pair<PlayerId, u64> pair) {
-            return pair.second == timebases[0].second;
-          }))
+      if (!AreAllEqual(timebases))
+        OnDesync(FindOutlier(timebases), frame);
+      m_timebase_by_frame.erase(frame);
+    }
+  }
+  break;
+
+  case MessageID::StateHash:
+  {
+    u32 frame;
+    packet >> frame;
+    StateHash hash;
+    hash.registers = Common::PacketReadU64(packet);
+    hash.memory = Common::PacketReadU64(packet);
+
+    if (m_desync_detected)
+      break;
+
+    std::vector<std::pair<PlayerId, StateHash>>& hashes = m_state_hash_by_frame[frame];
+    hashes.emplace_back(player.pid, hash);
+    if (hashes.size() >= m_players.size())
+    {
+      if (!AreAllEqual(hashes))
       {
-        int pid_to_blame = 0;
-        for (auto pair : timebases)
-        {
-          if (std::all_of(timebases.begin(), timebases.end(), [&](std::pair<PlayerId, u64> other) {
-                return other.first == pair.first || other.second != pair.second;
-              }))
-          {
-            // we are the only outlier
-            pid_to_blame = pair.first;
-            break;
-          }
-        }
+        OnDesync(FindOutlier(hashes), frame);
+
+        // Ask everyone what went into their hash to find out what differs.
+        m_state_hash_details_frame = frame;
+        m_state_hash_details.clear();
 
         sf::Packet spac;
-        spac << MessageID::DesyncDetected;
-        spac << pid_to_blame;
+        spac << MessageID::StateHashDetails;
         spac << frame;
         SendToClients(spac);
-
-        m_desync_detected = true;
       }
-      m_timebase_by_frame.erase(frame);
+      m_state_hash_by_frame.erase(frame);
+    }
+  }
+  break;
+
+  case MessageID::StateHashDetails:
+  {
+    u32 frame;
+    packet >> frame;
+    if (frame != m_state_hash_details_frame)
+      break;
+
+    StateHashDetails details;
+    details.gprs = Common::PacketReadU64(packet);
+    details.fprs = Common::PacketReadU64(packet);
+    details.other_registers = Common::PacketReadU64(packet);
+    u32 page_count;
+    packet >> page_count;
+    if (!packet || page_count > 0x10000)
+      break;
+
+    details.pages.resize(page_count);
+    for (auto& [address, hash] : details.pages)
+    {
+      packet >> address;
+      hash = Common::PacketReadU64(packet);
+    }
+    if (!packet)
+      break;
+
+    m_state_hash_details.emplace_back(player.pid, std::move(details));
+    if (m_state_hash_details.size() >= m_players.size())
+    {
+      ReportDesyncRegion();
+      m_state_hash_details_frame.reset();
+      m_state_hash_details.clear();
     }
   }
   break;
@@ -1095,6 +1278,11 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
         {
           m_dialog->AppendChat(Common::GetStringT("All players' saves synchronized."));
 
+          {
+            std::lock_guard lk(m_crit.save_data);
+            m_pending_save_data.clear();
+          }
+
           // Saves are synced, check if codes are as well and attempt to start the game
           m_saves_synced = true;
           CheckSyncAndStartGame();
@@ -1103,8 +1291,54 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
     break;
 
+    case SyncSaveDataID::ChunkHashes:
+    {
+      u8 save_count;
+      packet >> save_count;
+
+      std::map<std::string, std::set<SaveDataChunkHash>> known_chunks;
+      for (u8 i = 0; i < save_count; ++i)
+      {
+        std::string key;
+        u32 hash_count;
+        packet >> key >> hash_count;
+
+        std::set<SaveDataChunkHash>& hashes = known_chunks[key];
+        for (u32 j = 0; j < hash_count && packet; ++j)
+        {
+          SaveDataChunkHash hash;
+          for (u8& byte : hash)
+            packet >> byte;
+          hashes.insert(hash);
+        }
+      }
+
+      std::lock_guard lk(m_crit.save_data);
+      if (!m_start_pending)
+        break;
+
+      for (const PendingSaveData& save : m_pending_save_data)
+      {
+        sf::Packet pac;
+        pac << MessageID::SyncSaveData;
+        pac << SyncSaveDataID::Delta;
+        pac << save.key;
+        WriteSaveDataDelta({static_cast<const u8*>(save.packet.getData()),
+                            save.packet.getDataSize()},
+                           known_chunks[save.key], pac);
+
+        SendChunked(std::move(pac), player.pid, save.title);
+      }
+    }
+    break;
+
     case SyncSaveDataID::Failure:
     {
+      {
+        std::lock_guard lk(m_crit.save_data);
+        m_pending_save_data.clear();
+      }
+
       m_dialog->AppendChat(Common::FmtFormatT("{0} failed to synchronize.", player.name));
       m_dialog->OnGameStartAborted();
       ChunkedDataAbort();
@@ -1355,8 +1589,10 @@ bool NetPlayServer::SetupNetSettings()
       settings.savedata_load && Config::Get(Config::NETPLAY_SAVEDATA_SYNC_ALL_WII);
 
   settings.strict_settings_sync = Config::Get(Config::NETPLAY_STRICT_SETTINGS_SYNC);
+  settings.state_hashing = Config::Get(Config::NETPLAY_STATE_HASHING);
   settings.sync_codes = Config::Get(Config::NETPLAY_SYNC_CODES);
   settings.golf_mode = Config::Get(Config::NETPLAY_NETWORK_MODE) == "golf";
+  settings.rollback = Config::Get(Config::NETPLAY_NETWORK_MODE) == "rollback";
   settings.use_fma = DoAllPlayersHaveHardwareFMA();
   settings.hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
 
@@ -1426,7 +1662,10 @@ bool NetPlayServer::RequestStartGame()
 bool NetPlayServer::StartGame()
 {
   m_timebase_by_frame.clear();
+  m_state_hash_by_frame.clear();
   m_desync_detected = false;
+  m_state_hash_details_frame.reset();
+  m_state_hash_details.clear();
   std::lock_guard lkg(m_crit.game);
   // only used as an identifier, not time value, so truncation is fine
   m_current_game = static_cast<u32>(Common::Timer::NowMs());
@@ -1526,8 +1765,10 @@ bool NetPlayServer::StartGame()
   spac << m_settings.sync_codes;
 
   spac << m_settings.golf_mode;
+  spac << m_settings.rollback;
   spac << m_settings.use_fma;
   spac << m_settings.hide_remote_gbas;
+  spac << m_settings.state_hashing;
 
   for (size_t i = 0; i < sizeof(m_settings.sram); ++i)
     spac << m_settings.sram[i];
@@ -1558,18 +1799,6 @@ bool NetPlayServer::SyncSaveData()
 
   m_save_data_synced_players = 0;
 
-  u8 save_count = 0;
-
-  for (ExpansionInterface::Slot slot : ExpansionInterface::MEMCARD_SLOTS)
-  {
-    if (m_settings.exi_device[slot] == ExpansionInterface::EXIDeviceType::MemoryCard ||
-        Config::Get(Config::GetInfoForEXIDevice(slot)) ==
-            ExpansionInterface::EXIDeviceType::MemoryCardFolder)
-    {
-      save_count++;
-    }
-  }
-
   const auto game = m_dialog->FindGameFile(m_selected_game_identifier);
   if (game == nullptr)
   {
@@ -1583,7 +1812,6 @@ bool NetPlayServer::SyncSaveData()
                                    game->GetPlatform() == DiscIO::Platform::ELFOrDOL))
   {
     wii_save = true;
-    save_count++;
   }
 
   std::optional<DiscIO::Riivolution::SavegameRedirect> redirected_save;
@@ -1597,24 +1825,7 @@ bool NetPlayServer::SyncSaveData()
     }
   }
 
-  for (const auto& config : m_gba_config)
-  {
-    if (config.enabled && config.has_rom)
-      save_count++;
-  }
-
-  {
-    sf::Packet pac;
-    pac << MessageID::SyncSaveData;
-    pac << SyncSaveDataID::Notify;
-    pac << save_count;
-
-    // send this on the chunked data channel to ensure it's sequenced properly
-    SendAsyncToClients(std::move(pac), 0, CHUNKED_DATA_CHANNEL);
-  }
-
-  if (save_count == 0)
-    return true;
+  std::vector<PendingSaveData> save_data;
 
   const auto game_region = game->GetRegion();
   const std::string region = Config::GetDirectoryForRegion(Config::ToGameCubeRegion(game_region));
@@ -1633,7 +1844,6 @@ bool NetPlayServer::SyncSaveData()
       const std::string path = Config::GetMemcardPath(slot, game_region, card_size_mbits);
 
       sf::Packet pac;
-      pac << MessageID::SyncSaveData;
       pac << SyncSaveDataID::RawData;
       pac << is_slot_a << region << size_override;
 
@@ -1648,8 +1858,9 @@ bool NetPlayServer::SyncSaveData()
         pac << sf::Uint64{0};
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      save_data.push_back({fmt::format("Raw{}", is_slot_a ? 'A' : 'B'),
+                       fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'),
+                       std::move(pac)});
     }
     else if (Config::Get(Config::GetInfoForEXIDevice(slot)) ==
              ExpansionInterface::EXIDeviceType::MemoryCardFolder)
@@ -1658,7 +1869,6 @@ bool NetPlayServer::SyncSaveData()
                                fmt::format("Card {}", is_slot_a ? 'A' : 'B');
 
       sf::Packet pac;
-      pac << MessageID::SyncSaveData;
       pac << SyncSaveDataID::GCIData;
       pac << is_slot_a;
 
@@ -1681,8 +1891,9 @@ bool NetPlayServer::SyncSaveData()
         pac << static_cast<u8>(0);
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'));
+      save_data.push_back({fmt::format("GCI{}", is_slot_a ? 'A' : 'B'),
+                       fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'),
+                       std::move(pac)});
     }
   }
 
@@ -1710,7 +1921,6 @@ bool NetPlayServer::SyncSaveData()
     std::vector<u64> titles;
 
     sf::Packet pac;
-    pac << MessageID::SyncSaveData;
     pac << SyncSaveDataID::WiiData;
 
     // Shove the Mii data into the start the packet
@@ -1805,7 +2015,7 @@ bool NetPlayServer::SyncSaveData()
     m_dialog->SetHostWiiSyncData(std::move(titles),
                                  redirected_save ? redirected_save->m_target_path : "");
 
-    SendChunkedToClients(std::move(pac), 1, "Wii Save Synchronization");
+    save_data.push_back({"Wii", "Wii Save Synchronization", std::move(pac)});
   }
 
   for (size_t i = 0; i < m_gba_config.size(); ++i)
@@ -1813,7 +2023,6 @@ bool NetPlayServer::SyncSaveData()
     if (m_gba_config[i].enabled && m_gba_config[i].has_rom)
     {
       sf::Packet pac;
-      pac << MessageID::SyncSaveData;
       pac << SyncSaveDataID::GBAData;
       pac << static_cast<u8>(i);
 
@@ -1833,11 +2042,26 @@ bool NetPlayServer::SyncSaveData()
         pac << sf::Uint64{0};
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GBA{} Save File Synchronization", i + 1));
+      save_data.push_back({fmt::format("GBA{}", i + 1),
+                       fmt::format("GBA{} Save File Synchronization", i + 1), std::move(pac)});
     }
   }
 
+  sf::Packet pac;
+  pac << MessageID::SyncSaveData;
+  pac << SyncSaveDataID::Notify;
+  pac << static_cast<u8>(save_data.size());
+  for (const PendingSaveData& save : save_data)
+    pac << save.key;
+
+  {
+    std::lock_guard lk(m_crit.save_data);
+    m_pending_save_data = std::move(save_data);
+  }
+
+  // send this on the chunked data channel to ensure it's sequenced properly
+  SendAsyncToClients(std::move(pac), 0, CHUNKED_DATA_CHANNEL);
+
   return true;
 }
 
@@ -2008,7 +2232,7 @@ void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_
 
 void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 channel_id)
 {
-  ENetUtil::SendPacket(socket, packet, channel_id);
+  ENetUtil::SendPacket(socket, packet, channel_id, channel_id != PAD_DATA_CHANNEL);
 }
 
 void NetPlayServer::KickPlayer(PlayerId player)
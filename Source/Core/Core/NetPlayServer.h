@@ -21,6 +21,7 @@
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
 #include "Core/NetPlayProto.h"
+#include "Core/NetPlayStateHash.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 #include "UICommon/NetPlayIndex.h"
@@ -119,6 +120,14 @@ private:
     std::string title;
   };
 
+  struct PendingSaveData
+  {
+    // Identifies the save across syncs, so that clients can diff against what they got last time.
+    std::string key;
+    std::string title;
+    sf::Packet packet;
+  };
+
   bool SetupNetSettings();
   bool SyncSaveData();
   bool SyncCodes();
@@ -144,6 +153,8 @@ private:
   void UpdatePadMapping();
   void UpdateGBAConfig();
   void UpdateWiimoteMapping();
+  void OnDesync(PlayerId pid_to_blame, u32 frame);
+  void ReportDesyncRegion();
   std::vector<std::pair<std::string, std::string>> GetInterfaceListInternal() const;
   void ChunkedDataThreadFunc();
   void ChunkedDataSend(sf::Packet&& packet, PlayerId pid, const TargetMode target_mode);
@@ -171,6 +182,9 @@ private:
   GBAConfigArray m_gba_config;
   PadMappingArray m_wiimote_map;
   unsigned int m_save_data_synced_players = 0;
+  // Saves of the sync in progress, waiting to be sent to each client once it has told us which
+  // chunks it already has.
+  std::vector<PendingSaveData> m_pending_save_data;
   unsigned int m_codes_synced_players = 0;
   bool m_saves_synced = true;
   bool m_codes_synced = true;
@@ -182,7 +196,11 @@ private:
   std::map<PlayerId, Client> m_players;
 
   std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
+  std::unordered_map<u32, std::vector<std::pair<PlayerId, StateHash>>> m_state_hash_by_frame;
   bool m_desync_detected = false;
+  // The frame of the detected desync while waiting for everyone's state hash details.
+  std::optional<u32> m_state_hash_details_frame;
+  std::vector<std::pair<PlayerId, StateHashDetails>> m_state_hash_details;
 
   struct
   {
@@ -191,6 +209,7 @@ private:
     std::recursive_mutex players;
     std::recursive_mutex async_queue_write;
     std::recursive_mutex chunked_data_queue_write;
+    std::recursive_mutex save_data;
   } m_crit;
 
   Common::SPSCQueue<AsyncQueueEntry, false> m_async_queue;
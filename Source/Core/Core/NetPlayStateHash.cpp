@@ -0,0 +1,121 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayStateHash.h"
+
+#include <xxhash.h>
+
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace NetPlay
+{
+// Matches the granularity of the write watches on emulated memory.
+constexpr u32 PAGE_SIZE = 0x10000;
+
+// 1 MiB per frame, which covers MEM1 in less than half a second.
+constexpr u32 PAGES_PER_FRAME = 16;
+
+constexpr u32 MEM2_ADDRESS = 0x10000000;
+
+static u64 HashRegisters(StateHashDetails* details)
+{
+  const PowerPC::PowerPCState& ppc_state = PowerPC::ppcState;
+
+  details->gprs = XXH64(ppc_state.gpr, sizeof(ppc_state.gpr), 0);
+  details->fprs = XXH64(ppc_state.ps, sizeof(ppc_state.ps), 0);
+
+  XXH64_state_t* state = XXH64_createState();
+  XXH64_reset(state, 0);
+  XXH64_update(state, &ppc_state.pc, sizeof(ppc_state.pc));
+  XXH64_update(state, ppc_state.cr.fields, sizeof(ppc_state.cr.fields));
+  XXH64_update(state, &ppc_state.msr.Hex, sizeof(ppc_state.msr.Hex));
+  XXH64_update(state, &ppc_state.fpscr.Hex, sizeof(ppc_state.fpscr.Hex));
+  XXH64_update(state, &ppc_state.xer_ca, sizeof(ppc_state.xer_ca));
+  XXH64_update(state, &ppc_state.xer_so_ov, sizeof(ppc_state.xer_so_ov));
+  details->other_registers = XXH64_digest(state);
+  XXH64_freeState(state);
+
+  const u64 hashes[] = {details->gprs, details->fprs, details->other_registers};
+  return XXH64(hashes, sizeof(hashes), 0);
+}
+
+void StateHasher::Reset()
+{
+  std::lock_guard lk(m_mutex);
+
+  m_pages.clear();
+  m_next_page = 0;
+  m_memory_hash = 0;
+  m_recent_frames = {};
+}
+
+StateHash StateHasher::HashFrame(u32 frame)
+{
+  std::lock_guard lk(m_mutex);
+
+  const u32 mem1_pages = Memory::GetRamSize() / PAGE_SIZE;
+  const u32 mem2_pages = Memory::m_pEXRAM ? Memory::GetExRamSize() / PAGE_SIZE : 0;
+  if (m_pages.size() != mem1_pages + mem2_pages)
+  {
+    m_pages.assign(mem1_pages + mem2_pages, {});
+    m_next_page = 0;
+    m_memory_hash = 0;
+  }
+
+  FrameDetails& recent = m_recent_frames[frame % m_recent_frames.size()];
+  recent.frame = frame;
+  recent.valid = true;
+  recent.details.pages.clear();
+
+  StateHash hash;
+  hash.registers = HashRegisters(&recent.details);
+
+  for (u32 i = 0; i < PAGES_PER_FRAME && !m_pages.empty(); ++i)
+  {
+    const u32 index = m_next_page;
+    m_next_page = (m_next_page + 1) % m_pages.size();
+
+    const u8* ptr;
+    u32 address;
+    if (index < mem1_pages)
+    {
+      address = index * PAGE_SIZE;
+      ptr = Memory::m_pRAM + address;
+    }
+    else
+    {
+      address = MEM2_ADDRESS + (index - mem1_pages) * PAGE_SIZE;
+      ptr = Memory::m_pEXRAM + (address - MEM2_ADDRESS);
+    }
+
+    Page& page = m_pages[index];
+    if (page.watch_token == 0 || Memory::WasWrittenSince(ptr, PAGE_SIZE, page.watch_token))
+    {
+      // Start watching before hashing so that writes in between aren't missed.
+      page.watch_token = Memory::WatchWrites(ptr, PAGE_SIZE);
+
+      // Seeding with the address makes identical pages at different addresses hash differently.
+      const u64 page_hash = XXH64(ptr, PAGE_SIZE, address);
+      m_memory_hash ^= page.hash ^ page_hash;
+      page.hash = page_hash;
+    }
+
+    recent.details.pages.emplace_back(address, page.hash);
+  }
+
+  hash.memory = m_memory_hash;
+  return hash;
+}
+
+std::optional<StateHashDetails> StateHasher::GetDetails(u32 frame) const
+{
+  std::lock_guard lk(m_mutex);
+
+  const FrameDetails& recent = m_recent_frames[frame % m_recent_frames.size()];
+  if (!recent.valid || recent.frame != frame)
+    return std::nullopt;
+
+  return recent.details;
+}
+}  // namespace NetPlay
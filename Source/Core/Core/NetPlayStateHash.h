@@ -0,0 +1,74 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace NetPlay
+{
+struct StateHash
+{
+  u64 registers = 0;
+  u64 memory = 0;
+
+  bool operator==(const StateHash&) const = default;
+};
+
+// What went into a StateHash, for finding out which part of the state differs after a desync.
+struct StateHashDetails
+{
+  u64 gprs = 0;
+  u64 fprs = 0;
+  u64 other_registers = 0;
+  // The physical addresses of the memory pages that were rehashed for the frame, with their
+  // hashes. MEM2 pages are at 0x10000000 and up.
+  std::vector<std::pair<u32, u64>> pages;
+};
+
+// Hashes the emulated CPU registers and RAM once per frame so that players can compare their
+// states and notice desyncs as soon as they happen.
+//
+// Hashing all of RAM every frame would be too slow, so a small window of pages is rehashed every
+// frame, moving through MEM1 and then MEM2. The memory hash combines the latest hash of every page,
+// which is the same for everyone as long as the pages were the same when they were last rehashed.
+// Pages that haven't been written to since they were last hashed are skipped, using the write
+// watches on emulated memory where those are available.
+class StateHasher
+{
+public:
+  void Reset();
+
+  // Must be called from the CPU thread.
+  StateHash HashFrame(u32 frame);
+
+  // Returns std::nullopt if the frame is too old.
+  std::optional<StateHashDetails> GetDetails(u32 frame) const;
+
+private:
+  struct Page
+  {
+    u64 hash = 0;
+    u64 watch_token = 0;
+  };
+
+  struct FrameDetails
+  {
+    u32 frame = 0;
+    bool valid = false;
+    StateHashDetails details;
+  };
+
+  mutable std::mutex m_mutex;
+  std::vector<Page> m_pages;
+  u32 m_next_page = 0;
+  u64 m_memory_hash = 0;
+  std::array<FrameDetails, 256> m_recent_frames;
+};
+}  // namespace NetPlay
@@ -91,6 +91,7 @@ PCAPSSLCaptureLogger::~PCAPSSLCaptureLogger() = default;
 
 void PCAPSSLCaptureLogger::OnNewSocket(s32 socket)
 {
+  std::lock_guard lk(m_mutex);
   m_read_sequence_number[socket] = 0;
   m_write_sequence_number[socket] = 0;
 }
@@ -123,6 +124,7 @@ void PCAPSSLCaptureLogger::LogBBA(const void* data, std::size_t length)
 {
   if (!Config::Get(Config::MAIN_NETWORK_DUMP_BBA))
     return;
+  std::lock_guard lk(m_mutex);
   m_file->AddPacket(static_cast<const u8*>(data), length);
 }
 
@@ -172,6 +174,7 @@ void PCAPSSLCaptureLogger::LogIPv4(LogType log_type, const u8* data, u16 length,
     return;
   }
 
+  std::lock_guard lk(m_mutex);
   std::vector<u8> packet;
   auto insert = [&](const auto* new_data, std::size_t size) {
     const u8* begin = reinterpret_cast<const u8*>(new_data);
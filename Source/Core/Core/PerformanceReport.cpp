@@ -0,0 +1,200 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PerformanceReport.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
+#include "Common/PerformanceTrace.h"
+#include "Common/Timer.h"
+#include "Common/Version.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/HW/SystemTimers.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "VideoCommon/Statistics.h"
+
+namespace PerformanceReport
+{
+namespace
+{
+using Common::PerformanceTrace::Stage;
+
+// Physical memory used by the largest allocations, taken when measuring ends.
+struct MemoryBreakdown
+{
+  size_t emulated_memory = 0;
+  size_t jit_code = 0;
+  size_t jit_block_bitset = 0;
+};
+
+struct Snapshot
+{
+  u64 host_time_us = 0;
+  u64 ticks = 0;
+  int shaders_compiled = 0;
+  std::array<u64, static_cast<size_t>(Stage::Count)> stage_totals_ns{};
+};
+
+Snapshot TakeSnapshot()
+{
+  Snapshot snapshot;
+  snapshot.host_time_us = Common::Timer::NowUs();
+  snapshot.ticks = CoreTiming::GetTicks();
+  snapshot.shaders_compiled =
+      g_stats.num_vertex_shaders_created + g_stats.num_pixel_shaders_created;
+  for (size_t i = 0; i < snapshot.stage_totals_ns.size(); ++i)
+    snapshot.stage_totals_ns[i] = Common::PerformanceTrace::GetStageTotal(static_cast<Stage>(i));
+  return snapshot;
+}
+
+// Only accessed by the CPU thread while s_active is set.
+std::atomic<bool> s_active = false;
+u32 s_num_frames = 0;
+std::function<void()> s_finished;
+bool s_started = false;
+bool s_enabled_trace = false;
+Snapshot s_start;
+Snapshot s_end;
+std::vector<u64> s_frame_times_us;
+std::string s_game_id;
+MemoryBreakdown s_memory;
+Common::PreciseSleeper::Stats s_sleep_stats;
+
+u64 GetPercentile(const std::vector<u64>& sorted, u32 percentile)
+{
+  if (sorted.empty())
+    return 0;
+  return sorted[(sorted.size() - 1) * percentile / 100];
+}
+}  // namespace
+
+void Start(u32 num_frames, std::function<void()> finished)
+{
+  s_num_frames = num_frames;
+  s_finished = std::move(finished);
+  s_started = false;
+  s_frame_times_us.clear();
+  s_frame_times_us.reserve(num_frames);
+  s_memory = {};
+  s_sleep_stats = {};
+  s_active.store(true, std::memory_order_relaxed);
+}
+
+void OnFrameEnd()
+{
+  if (!s_active.load(std::memory_order_relaxed))
+    return;
+
+  if (!s_started)
+  {
+    // The JIT compile time and the time spent in the other stages are only recorded while
+    // tracing.
+    s_enabled_trace = !Common::PerformanceTrace::IsEnabled();
+    if (s_enabled_trace)
+      Common::PerformanceTrace::SetEnabled(true);
+
+    s_start = TakeSnapshot();
+    s_end = s_start;
+    s_game_id = SConfig::GetInstance().GetGameID();
+    SystemTimers::ResetThrottleSleepStats();
+    s_started = true;
+    return;
+  }
+
+  const Snapshot end = TakeSnapshot();
+  s_frame_times_us.push_back(end.host_time_us - s_end.host_time_us);
+  s_end = end;
+
+  if (s_frame_times_us.size() < s_num_frames)
+    return;
+
+  s_memory.emulated_memory = Memory::GetResidentSize();
+  s_memory.jit_code = JitInterface::GetResidentCodeSize();
+  s_memory.jit_block_bitset = JitInterface::GetResidentBlockBitSetSize();
+  s_sleep_stats = SystemTimers::GetThrottleSleepStats();
+
+  s_active.store(false, std::memory_order_relaxed);
+  if (s_enabled_trace)
+    Common::PerformanceTrace::SetEnabled(false);
+  if (s_finished)
+    s_finished();
+}
+
+bool WriteReport(const std::string& path)
+{
+  // Emulation has either stopped by now or finished measuring, so the CPU thread can't be
+  // measuring anymore.
+  s_active.store(false, std::memory_order_relaxed);
+
+  std::vector<u64> sorted = s_frame_times_us;
+  std::sort(sorted.begin(), sorted.end());
+
+  const u64 host_time_us = s_end.host_time_us - s_start.host_time_us;
+  const u64 emulated_time_us =
+      (s_end.ticks - s_start.ticks) * 1000000 / SystemTimers::GetTicksPerSecond();
+  const double speed =
+      host_time_us != 0 ? static_cast<double>(emulated_time_us) / host_time_us : 0.0;
+
+  const auto get_stage_total_us = [](Stage stage) {
+    const size_t index = static_cast<size_t>(stage);
+    return (s_end.stage_totals_ns[index] - s_start.stage_totals_ns[index]) / 1000;
+  };
+  std::string stages;
+  for (size_t i = 0; i < static_cast<size_t>(Stage::Count); ++i)
+  {
+    const Stage stage = static_cast<Stage>(i);
+    stages += fmt::format(R"({}"{}":{})", i != 0 ? "," : "",
+                          Common::PerformanceTrace::GetStageName(stage), get_stage_total_us(stage));
+  }
+
+  std::string frames;
+  for (size_t i = 0; i < s_frame_times_us.size(); ++i)
+    frames += fmt::format("{}{}", i != 0 ? "," : "", s_frame_times_us[i]);
+
+  const std::string json = fmt::format(
+      "{{\"version\":\"{}\",\"game_id\":\"{}\",\"cpu_core\":{},\"dual_core\":{},"
+      "\"video_backend\":\"{}\",\n"
+      "\"frames_requested\":{},\"frames\":{},\"host_time_us\":{},\"emulated_time_us\":{},"
+      "\"emulation_speed\":{:.4f},\n"
+      "\"frame_time_us\":{{\"mean\":{},\"p50\":{},\"p90\":{},\"p99\":{},\"max\":{}}},\n"
+      "\"jit_compile_us\":{},\"shaders_compiled\":{},\"peak_memory_bytes\":{},\n"
+      "\"memory_bytes\":{{\"emulated_memory\":{},\"jit_code\":{},\"jit_block_bitset\":{}}},\n"
+      "\"throttle_sleeps\":{{\"count\":{},\"mean_late_us\":{},\"max_late_us\":{},"
+      "\"spin_us\":{}}},\n"
+      "\"stages_us\":{{{}}},\n"
+      "\"frame_times_us\":[{}]}}\n",
+      Common::GetScmRevStr(), s_game_id, static_cast<int>(Config::Get(Config::MAIN_CPU_CORE)),
+      Config::Get(Config::MAIN_CPU_THREAD), Config::Get(Config::MAIN_GFX_BACKEND),
+      s_num_frames, s_frame_times_us.size(), host_time_us, emulated_time_us, speed,
+      sorted.empty() ? 0 : std::accumulate(sorted.begin(), sorted.end(), u64{0}) / sorted.size(),
+      GetPercentile(sorted, 50), GetPercentile(sorted, 90), GetPercentile(sorted, 99),
+      sorted.empty() ? 0 : sorted.back(),
+      get_stage_total_us(Stage::JITCompile), s_end.shaders_compiled - s_start.shaders_compiled,
+      Common::MemPeakProcessUsage(), s_memory.emulated_memory, s_memory.jit_code,
+      s_memory.jit_block_bitset, s_sleep_stats.sleeps,
+      s_sleep_stats.sleeps != 0 ? s_sleep_stats.total_lateness_us / s_sleep_stats.sleeps : 0,
+      s_sleep_stats.max_lateness_us, s_sleep_stats.total_spin_us, stages, frames);
+
+  File::IOFile file(path, "wb");
+  if (!file.WriteString(json))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to write the performance report to {}", path);
+    return false;
+  }
+  return s_frame_times_us.size() == s_num_frames;
+}
+}  // namespace PerformanceReport
@@ -0,0 +1,26 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Measures a fixed number of emulated frames for automated performance regression runs, such as
+// DolphinNoGUI's --perf_report. Measuring starts at the end of the first frame, so that booting
+// isn't included, and the results are written as JSON.
+namespace PerformanceReport
+{
+// Must be called before emulation starts, or on the CPU thread. finished is called on the CPU
+// thread once num_frames frames have been measured.
+void Start(u32 num_frames, std::function<void()> finished);
+
+// Called by the CPU thread at the end of every emulated frame.
+void OnFrameEnd();
+
+// Returns false if the file couldn't be written or if not all frames were measured, in which case
+// the file still describes the frames that were.
+bool WriteReport(const std::string& path);
+}  // namespace PerformanceReport
@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -11,6 +12,7 @@
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/Jit64Common/Jit64Constants.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -18,6 +20,10 @@ struct CachedInterpreter::Instruction
 {
   using CommonCallback = void (*)(UGeckoInstruction);
   using ConditionalCallback = bool (*)(u32);
+  // Takes operands which were decoded when the block was compiled (an immediate and up to three
+  // small values such as register indices), so that frequently executed instructions don't have
+  // to decode their UGeckoInstruction all over again every time they run.
+  using DecodedCallback = void (*)(u32, u32, u32, u32);
 
   Instruction() {}
   Instruction(const CommonCallback c, UGeckoInstruction i)
@@ -30,20 +36,31 @@ struct CachedInterpreter::Instruction
   {
   }
 
-  enum class Type
+  Instruction(const DecodedCallback c, u32 imm, u32 d, u32 a, u32 b = 0)
+      : decoded_callback(c), data(imm), operand_d(static_cast<u8>(d)),
+        operand_a(static_cast<u8>(a)), operand_b(static_cast<u8>(b)), type(Type::Decoded)
+  {
+  }
+
+  enum class Type : u8
   {
     Abort,
     Common,
     Conditional,
+    Decoded,
   };
 
   union
   {
     const CommonCallback common_callback;
     const ConditionalCallback conditional_callback;
+    const DecodedCallback decoded_callback;
   };
 
   u32 data = 0;
+  u8 operand_d = 0;
+  u8 operand_a = 0;
+  u8 operand_b = 0;
   Type type = Type::Abort;
 };
 
@@ -99,6 +116,10 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::Decoded:
+      code->decoded_callback(code->data, code->operand_d, code->operand_a, code->operand_b);
+      break;
+
     default:
       ERROR_LOG_FMT(POWERPC, "Unknown CachedInterpreter Instruction: {}",
                     static_cast<int>(code->type));
@@ -212,6 +233,75 @@ static bool CheckIdle(u32 idle_pc)
   return false;
 }
 
+static void LoadImmediate(u32 imm, u32 d, u32, u32)
+{
+  rGPR[d] = imm;
+}
+
+static void AddImmediate(u32 imm, u32 d, u32 a, u32)
+{
+  rGPR[d] = rGPR[a] + imm;
+}
+
+static void OrImmediate(u32 imm, u32 a, u32 s, u32)
+{
+  rGPR[a] = rGPR[s] | imm;
+}
+
+static void RotateLeftAndMask(u32 mask, u32 a, u32 s, u32 sh)
+{
+  rGPR[a] = Common::RotateLeft(rGPR[s], sh) & mask;
+}
+
+static void LoadWord(u32 offset, u32 d, u32 a, u32)
+{
+  const u32 temp = PowerPC::Read_U32(a ? rGPR[a] + offset : offset);
+  if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+    rGPR[d] = temp;
+}
+
+static void StoreWord(u32 offset, u32 s, u32 a, u32)
+{
+  PowerPC::Write_U32(rGPR[s], a ? rGPR[a] + offset : offset);
+}
+
+bool CachedInterpreter::EmitDecodedInstruction(UGeckoInstruction inst)
+{
+  switch (inst.OPCD)
+  {
+  case 14:  // addi
+  case 15:  // addis
+  {
+    const u32 imm = inst.OPCD == 14 ? u32(inst.SIMM_16) : u32(inst.SIMM_16 << 16);
+    if (inst.RA)
+      m_code.push_back({AddImmediate, imm, inst.RD, inst.RA});
+    else
+      m_code.push_back({LoadImmediate, imm, inst.RD, 0});
+    return true;
+  }
+  case 24:  // ori
+    m_code.push_back({OrImmediate, u32{inst.UIMM}, inst.RA, inst.RS});
+    return true;
+  case 25:  // oris
+    m_code.push_back({OrImmediate, u32{inst.UIMM} << 16, inst.RA, inst.RS});
+    return true;
+  case 21:  // rlwinmx
+    if (inst.Rc)
+      return false;
+    m_code.push_back(
+        {RotateLeftAndMask, MakeRotationMask(inst.MB, inst.ME), inst.RA, inst.RS, inst.SH});
+    return true;
+  case 32:  // lwz
+    m_code.push_back({LoadWord, u32(inst.SIMM_16), inst.RD, inst.RA});
+    return true;
+  case 36:  // stw
+    m_code.push_back({StoreWord, u32(inst.SIMM_16), inst.RS, inst.RA});
+    return true;
+  default:
+    return false;
+  }
+}
+
 bool CachedInterpreter::HandleFunctionHooking(u32 address)
 {
   return HLE::ReplaceFunctionIfPossible(address, [&](u32 hook_index, HLE::HookType type) {
@@ -263,7 +353,7 @@ void CachedInterpreter::Jit(u32 address)
   {
     PPCAnalyst::CodeOp& op = m_code_buffer[i];
 
-    js.downcountAmount += op.opinfo->numCycles;
+    js.downcountAmount += op.num_cycles;
     if (op.opinfo->flags & FL_LOADSTORE)
       ++js.numLoadStoreInst;
     if (op.opinfo->flags & FL_USE_FPU)
@@ -294,7 +384,8 @@ void CachedInterpreter::Jit(u32 address)
         js.firstFPInstructionFound = true;
       }
 
-      m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
+      if (!EmitDecodedInstruction(op.inst))
+        m_code.emplace_back(PPCTables::GetInterpreterOp(op.inst), op.inst);
       if (memcheck)
         m_code.emplace_back(CheckDSI, js.downcountAmount);
       if (check_program_exception)
@@ -37,6 +37,8 @@ private:
   u8* GetCodePtr();
   void ExecuteOneBlock();
 
+  // Emits a pre-decoded form of inst if there is one. Returns false otherwise.
+  bool EmitDecodedInstruction(UGeckoInstruction inst);
   bool HandleFunctionHooking(u32 address);
 
   BlockCache m_block_cache{*this};
@@ -16,6 +16,8 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Runs instructions up to and including the next branch, and returns the cycles they took.
+  int SingleStepBlock();
 
   void Run() override;
   void ClearCache() override;
@@ -3,6 +3,8 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <cstddef>
+#include <cstring>
 #include <map>
 #include <sstream>
 #include <string>
@@ -21,6 +23,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/PerformanceCounter.h"
+#include "Common/PerformanceTrace.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/x64ABI.h"
@@ -340,10 +343,13 @@ void Jit64::Init()
   fpr.SetEmitter(this);
 
   const size_t routines_size = asm_routines.CODE_SIZE;
-  const size_t trampolines_size = jo.memcheck ? TRAMPOLINE_CODE_SIZE_MMU : TRAMPOLINE_CODE_SIZE;
-  const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
+  const size_t trampolines_size =
+      GetCodeSpaceSize(jo.memcheck ? TRAMPOLINE_CODE_SIZE_MMU : TRAMPOLINE_CODE_SIZE);
+  const size_t farcode_size = GetCodeSpaceSize(jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE);
   const size_t constpool_size = m_const_pool.CONST_POOL_SIZE;
-  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
+  AllocCodeSpace(GetCodeSpaceSize(CODE_SIZE) + routines_size + trampolines_size + farcode_size +
+                     constpool_size,
+                 m_enable_large_pages);
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
   AddChildCodeSpace(&m_far_code, farcode_size);
@@ -378,6 +384,7 @@ void Jit64::Init()
 
 void Jit64::ClearCache()
 {
+  PowerPC::ppcState.ClearReturnStack();
   blocks.Clear();
   blocks.ClearRangesToFree();
   trampolines.ClearCodeSpace();
@@ -569,8 +576,48 @@ void Jit64::FakeBLCall(u32 after)
   SetJumpTarget(skip_exit);
 }
 
+static OpArg ReturnStackEntryField(size_t field_offset)
+{
+  // The byte offset of the entry is in RSCRATCH2.
+  const auto* state = reinterpret_cast<const u8*>(&PowerPC::ppcState);
+  const auto* stack = reinterpret_cast<const u8*>(PowerPC::ppcState.return_stack.data());
+  return MComplex(RPPCSTATE, RSCRATCH2, SCALE_1,
+                  static_cast<s32>(stack - state - 0x80 + field_offset));
+}
+
+bool Jit64::IsReturnStackEnabled() const
+{
+  // Linking would skip the breakpoint check of the dispatcher.
+  return !m_enable_blr_optimization && jo.enableBlocklink && !m_enable_debugging;
+}
+
+u8* Jit64::PushReturnStack(u32 after)
+{
+  using Entry = PowerPC::PowerPCState::ReturnStackEntry;
+
+  MOV(32, R(RSCRATCH2), PPCSTATE(return_stack_offset));
+  ADD(32, R(RSCRATCH2), Imm8(sizeof(Entry)));
+  AND(32, R(RSCRATCH2), Imm32(PowerPC::PowerPCState::RETURN_STACK_OFFSET_MASK));
+  MOV(32, PPCSTATE(return_stack_offset), R(RSCRATCH2));
+  MOV(32, ReturnStackEntryField(offsetof(Entry, pc)), Imm32(after));
+  MOV(32, ReturnStackEntryField(offsetof(Entry, msr_bits)), Imm32(js.curBlock->msrBits));
+  // The displacement gets patched by WriteReturnStackTarget.
+  LEA(64, RSCRATCH, M(GetCodePtr()));
+  u8* lea_end = GetWritableCodePtr();
+  MOV(64, ReturnStackEntryField(offsetof(Entry, code)), R(RSCRATCH));
+  return lea_end;
+}
+
+void Jit64::WriteReturnStackTarget(u8* lea_end, u32 after)
+{
+  const s32 disp = static_cast<s32>(GetCodePtr() - lea_end);
+  std::memcpy(lea_end - sizeof(disp), &disp, sizeof(disp));
+  JustWriteExit(after, false, 0);
+}
+
 void Jit64::WriteExit(u32 destination, bool bl, u32 after)
 {
+  const bool push_return_stack = bl && IsReturnStackEnabled();
   if (!m_enable_blr_optimization)
     bl = false;
 
@@ -582,9 +629,16 @@ void Jit64::WriteExit(u32 destination, bool bl, u32 after)
     PUSH(RSCRATCH2);
   }
 
+  u8* return_stack_lea = nullptr;
+  if (push_return_stack)
+    return_stack_lea = PushReturnStack(after);
+
   SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
 
   JustWriteExit(destination, bl, after);
+
+  if (push_return_stack)
+    WriteReturnStackTarget(return_stack_lea, after);
 }
 
 void Jit64::JustWriteExit(u32 destination, bool bl, u32 after)
@@ -656,11 +710,109 @@ void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
   }
 }
 
+static void LinkIndirectExit(JitBlockCache* blocks, JitBlock* block, u32 link_index)
+{
+  blocks->LinkIndirectExit(*block, link_index);
+}
+
+void Jit64::WriteIndirectExitDestInRSCRATCH(bool bl, u32 after)
+{
+  // Linking would skip the breakpoint check of the dispatcher.
+  if (!jo.enableBlocklink || m_enable_debugging)
+  {
+    WriteExitDestInRSCRATCH(bl, after);
+    return;
+  }
+
+  const bool push_return_stack = bl && IsReturnStackEnabled();
+  if (!m_enable_blr_optimization)
+    bl = false;
+  MOV(32, PPCSTATE(pc), R(RSCRATCH));
+  bool disturbed = Cleanup();
+
+  if (bl)
+  {
+    MOV(32, R(RSCRATCH2), Imm32(after));
+    PUSH(RSCRATCH2);
+  }
+
+  u8* return_stack_lea = nullptr;
+  if (push_return_stack)
+  {
+    return_stack_lea = PushReturnStack(after);
+    disturbed = true;
+  }
+  if (disturbed)
+    MOV(32, R(RSCRATCH), PPCSTATE(pc));
+
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+
+  JitBlock* b = js.curBlock;
+  JitBlock::LinkData linkData;
+  linkData.exitAddress = JitBaseBlockCache::UNLINKED_INDIRECT_EXIT;
+  linkData.linkStatus = false;
+  linkData.call = bl;
+  linkData.indirect = true;
+
+  // Perform downcount flag check, like JustWriteExit
+  FixupBranch after_call;
+  if (bl)
+  {
+    FixupBranch do_timing = J_CC(CC_LE, true);
+    SwitchToFarCode();
+    SetJumpTarget(do_timing);
+    CALL(asm_routines.do_timing);
+    after_call = J(true);
+    SwitchToNearCode();
+  }
+  else
+  {
+    J_CC(CC_LE, asm_routines.do_timing);
+  }
+
+  // The immediate gets patched to the target the exit is linked to.
+  CMP(32, R(RSCRATCH), Imm32(JitBaseBlockCache::UNLINKED_INDIRECT_EXIT));
+  const u8* jne_start = GetCodePtr();
+  FixupBranch miss = J_CC(CC_NE, true);
+  ASSERT(static_cast<u32>(GetCodePtr() - jne_start) == JitBlockCache::INDIRECT_EXIT_JNE_SIZE);
+
+  linkData.exitPtrs = GetWritableCodePtr();
+  if (bl)
+    CALL(asm_routines.dispatcher_no_check);
+  else
+    JMP(asm_routines.dispatcher_no_check, true);
+
+  SwitchToFarCode();
+  SetJumpTarget(miss);
+  // The return address for the BLR optimization is on the stack.
+  const size_t rsp_alignment = bl ? 8 : 0;
+  ABI_PushRegistersAndAdjustStack({}, rsp_alignment);
+  ABI_CallFunctionPPC(LinkIndirectExit, &blocks, b, static_cast<u32>(b->linkData.size()));
+  ABI_PopRegistersAndAdjustStack({}, rsp_alignment);
+  JMP(linkData.exitPtrs, true);
+  SwitchToNearCode();
+
+  b->linkData.push_back(linkData);
+
+  if (bl)
+  {
+    SetJumpTarget(after_call);
+    POP(RSCRATCH);
+    JustWriteExit(after, false, 0);
+  }
+
+  if (push_return_stack)
+    WriteReturnStackTarget(return_stack_lea, after);
+}
+
 void Jit64::WriteBLRExit()
 {
   if (!m_enable_blr_optimization)
   {
-    WriteExitDestInRSCRATCH();
+    if (IsReturnStackEnabled())
+      WriteReturnStackBLRExit();
+    else
+      WriteIndirectExitDestInRSCRATCH();
     return;
   }
   MOV(32, PPCSTATE(pc), R(RSCRATCH));
@@ -674,6 +826,34 @@ void Jit64::WriteBLRExit()
   RET();
 }
 
+void Jit64::WriteReturnStackBLRExit()
+{
+  using Entry = PowerPC::PowerPCState::ReturnStackEntry;
+
+  MOV(32, PPCSTATE(pc), R(RSCRATCH));
+  if (Cleanup())
+    MOV(32, R(RSCRATCH), PPCSTATE(pc));
+  MOV(32, R(RSCRATCH2), PPCSTATE(return_stack_offset));
+  CMP(32, R(RSCRATCH), ReturnStackEntryField(offsetof(Entry, pc)));
+  FixupBranch pc_miss = J_CC(CC_NE);
+  CMP(32, ReturnStackEntryField(offsetof(Entry, msr_bits)), Imm32(js.curBlock->msrBits));
+  FixupBranch msr_miss = J_CC(CC_NE);
+
+  // Continue right after the bl which pushed the entry. The code there checks the downcount.
+  MOV(64, R(RSCRATCH), ReturnStackEntryField(offsetof(Entry, code)));
+  SUB(32, R(RSCRATCH2), Imm8(sizeof(Entry)));
+  AND(32, R(RSCRATCH2), Imm32(PowerPC::PowerPCState::RETURN_STACK_OFFSET_MASK));
+  MOV(32, PPCSTATE(return_stack_offset), R(RSCRATCH2));
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  JMPptr(R(RSCRATCH));
+
+  // The stack is left alone on a miss, as the blr may just not have been paired with a bl.
+  SetJumpTarget(pc_miss);
+  SetJumpTarget(msr_miss);
+  SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+  JMP(asm_routines.dispatcher, true);
+}
+
 void Jit64::WriteRfiExitDestInRSCRATCH()
 {
   MOV(32, PPCSTATE(pc), R(RSCRATCH));
@@ -758,6 +938,11 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
+  if (InterpretColdBlock(em_address))
+    return;
+
+  Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::JITCompile);
+  PrecompileCachedBlocks(em_address);
   Jit(em_address, true);
 }
 
@@ -812,11 +997,15 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CONSTANT_PROPAGATION);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_DEAD_CR_ELIMINATION);
       }
       Trace();
     }
   }
 
+  SetupBlockTier(em_address);
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
@@ -860,11 +1049,22 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+
+    blocks.EraseUnfinalizedBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
+    // Evict the older half of all blocks and retry, which repeats until the cache is empty. The
+    // retry also transfers the memory of the evicted blocks to the free ranges.
+    if (blocks.EvictOldBlocks())
+    {
+      WARN_LOG_FMT(POWERPC, "evicting old blocks from code caches");
+      Jit(em_address, true);
+      return;
+    }
+
     // Clear the entire JIT cache and retry.
     WARN_LOG_FMT(POWERPC, "flushing code caches, please report if this happens a lot");
     ClearCache();
@@ -935,6 +1135,24 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     ADD(64, MDisp(ABI_PARAM1, offset), Imm8(1));
     ABI_CallFunction(QueryPerformanceCounter);
   }
+
+  if (js.emitTierUpCounter)
+  {
+    b->tier_up_counter = TIER_UP_THRESHOLD;
+    MOV(64, R(RSCRATCH), ImmPtr(&b->tier_up_counter));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    FixupBranch tier_up = J_CC(CC_Z, true);
+
+    SwitchToFarCode();
+    SetJumpTarget(tier_up);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                      static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, true);
+    SwitchToNearCode();
+  }
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -1000,7 +1218,7 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     js.instructionNumber = i;
     js.instructionsLeft = (code_block.m_num_instructions - 1) - i;
     const GekkoOPInfo* opinfo = op.opinfo;
-    js.downcountAmount += opinfo->numCycles;
+    js.downcountAmount += op.num_cycles;
     js.fastmemLoadStore = nullptr;
     js.fixupExceptionHandler = false;
 
@@ -1131,7 +1349,11 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         fpr.PreloadRegisters(op.fregsIn & op.fprInXmm & ~op.fprDiscardable);
       }
 
-      CompileInstruction(op);
+      // The analyzer has already computed the result if all inputs are known.
+      if (op.gprOutputIsConstant && !bJITOff && !bJITIntegerOff)
+        gpr.SetImmediate32(*op.regsOut.begin(), op.gprOutputConstant);
+      else
+        CompileInstruction(op);
 
       js.fpr_is_store_safe = op.fprIsStoreSafeAfterInst;
 
@@ -1255,6 +1477,8 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CONSTANT_PROPAGATION);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_DEAD_CR_ELIMINATION);
 }
 
 void Jit64::IntializeSpeculativeConstants()
@@ -70,6 +70,7 @@ public:
   void IntializeSpeculativeConstants();
 
   JitBlockCache* GetBlockCache() override { return &blocks; }
+  size_t GetResidentCodeSize() const override { return GetResidentSize(); }
   void Trace();
 
   void ClearCache() override;
@@ -86,13 +87,24 @@ public:
   void WriteExit(u32 destination, bool bl = false, u32 after = 0);
   void JustWriteExit(u32 destination, bool bl, u32 after);
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
+  // Like WriteExitDestInRSCRATCH, but links the exit to the target it last jumped to.
+  void WriteIndirectExitDestInRSCRATCH(bool bl = false, u32 after = 0);
   void WriteBLRExit();
+  // Checks the blr target against the return stack pushed by bl exits, which is used instead of
+  // the host stack if the BLR optimization is disabled.
+  void WriteReturnStackBLRExit();
   void WriteExceptionExit();
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
   void WriteIdleExit(u32 destination);
   bool Cleanup();
 
+  bool IsReturnStackEnabled() const;
+  // Pushes an entry for the bl exit being written. Returns the pointer which has to be passed to
+  // WriteReturnStackTarget after the exit.
+  u8* PushReturnStack(u32 after);
+  void WriteReturnStackTarget(u8* lea_end, u32 after);
+
   void GenerateConstantOverflow(bool overflow);
   void GenerateConstantOverflow(s64 val);
   void GenerateOverflow(Gen::CCFlags cond = Gen::CCFlags::CC_NO);
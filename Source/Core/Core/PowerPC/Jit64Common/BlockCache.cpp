@@ -3,9 +3,12 @@
 
 #include "Core/PowerPC/Jit64Common/BlockCache.h"
 
+#include <cstring>
+
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/PowerPC.h"
 
 JitBlockCache::JitBlockCache(JitBase& jit) : JitBaseBlockCache{jit}
 {
@@ -19,6 +22,11 @@ void JitBlockCache::WriteLinkBlock(const JitBlock::LinkData& source, const JitBl
 
   u8* location = source.exitPtrs;
   const u8* address = dest ? dest->checkedEntry : dispatcher;
+  if (source.indirect)
+  {
+    const u32 expected_pc = dest ? source.exitAddress : UNLINKED_INDIRECT_EXIT;
+    std::memcpy(location - INDIRECT_EXIT_JNE_SIZE - sizeof(u32), &expected_pc, sizeof(u32));
+  }
   if (source.call)
   {
     Gen::XEmitter emit(location, location + 5);
@@ -52,6 +60,14 @@ void JitBlockCache::WriteDestroyBlock(const JitBlock& block)
   emit2.INT3();
 }
 
+void JitBlockCache::WriteDisableIndirectExit(const JitBlock::LinkData& source)
+{
+  // Fall through from the JNE to the exit, which is now a jump to the dispatcher.
+  u8* location = source.exitPtrs - INDIRECT_EXIT_JNE_SIZE;
+  Gen::XEmitter emit(location, source.exitPtrs);
+  emit.NOP(INDIRECT_EXIT_JNE_SIZE);
+}
+
 void JitBlockCache::Init()
 {
   JitBaseBlockCache::Init();
@@ -62,6 +78,13 @@ void JitBlockCache::DestroyBlock(JitBlock& block)
 {
   JitBaseBlockCache::DestroyBlock(block);
 
+  // Return stack entries may continue in the code of this block.
+  for (auto& entry : PowerPC::ppcState.return_stack)
+  {
+    if (entry.code >= block.near_begin && entry.code < block.near_end)
+      entry = {};
+  }
+
   if (block.near_begin != block.near_end)
     m_ranges_to_free_on_next_codegen_near.emplace_back(block.near_begin, block.near_end);
   if (block.far_begin != block.far_end)
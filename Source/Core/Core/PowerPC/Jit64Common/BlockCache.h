@@ -12,6 +12,11 @@ class JitBase;
 class JitBlockCache : public JitBaseBlockCache
 {
 public:
+  // An indirect exit ends in a CMP of the target PC against the address it's linked to (as the
+  // last 4 bytes of the instruction), followed by a JNE of this size to the code which calls
+  // LinkIndirectExit, followed by the linked JMP or CALL at LinkData::exitPtrs.
+  static constexpr u32 INDIRECT_EXIT_JNE_SIZE = 6;
+
   explicit JitBlockCache(JitBase& jit);
 
   void Init() override;
@@ -26,6 +31,7 @@ public:
 private:
   void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) override;
   void WriteDestroyBlock(const JitBlock& block) override;
+  void WriteDisableIndirectExit(const JitBlock::LinkData& source) override;
 
   std::vector<std::pair<u8*, u8*>> m_ranges_to_free_on_next_codegen_near;
   std::vector<std::pair<u8*, u8*>> m_ranges_to_free_on_next_codegen_far;
@@ -11,6 +11,7 @@
 #include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/PerformanceCounter.h"
+#include "Common/PerformanceTrace.h"
 #include "Common/StringUtil.h"
 
 #include "Core/ConfigManager.h"
@@ -48,8 +49,8 @@ JitArm64::~JitArm64() = default;
 
 void JitArm64::Init()
 {
-  const size_t child_code_size = m_mmu_enabled ? FARCODE_SIZE_MMU : FARCODE_SIZE;
-  AllocCodeSpace(CODE_SIZE + child_code_size);
+  const size_t child_code_size = GetCodeSpaceSize(m_mmu_enabled ? FARCODE_SIZE_MMU : FARCODE_SIZE);
+  AllocCodeSpace(GetCodeSpaceSize(CODE_SIZE) + child_code_size, m_enable_large_pages);
   AddChildCodeSpace(&m_far_code, child_code_size);
 
   jo.fastmem_arena = m_fastmem_enabled && Memory::InitFastmemArena();
@@ -66,6 +67,8 @@ void JitArm64::Init()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CONSTANT_PROPAGATION);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_DEAD_CR_ELIMINATION);
 
   m_enable_blr_optimization = jo.enableBlocklink && m_fastmem_enabled && !m_enable_debugging;
   m_cleanup_after_stackfault = false;
@@ -613,6 +616,11 @@ void JitArm64::SingleStep()
 
 void JitArm64::Jit(u32 em_address)
 {
+  if (InterpretColdBlock(em_address))
+    return;
+
+  Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::JITCompile);
+  PrecompileCachedBlocks(em_address);
   Jit(em_address, true);
 }
 
@@ -660,6 +668,8 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     block_size = 1;
   }
 
+  SetupBlockTier(em_address);
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
@@ -703,11 +713,22 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+
+    blocks.EraseUnfinalizedBlock(*b);
   }
 
   if (clear_cache_and_retry_on_failure)
   {
     // Code generation failed due to not enough free space in either the near or far code regions.
+    // Evict the older half of all blocks and retry, which repeats until the cache is empty. The
+    // retry also transfers the memory of the evicted blocks to the free ranges.
+    if (blocks.EvictOldBlocks())
+    {
+      WARN_LOG_FMT(POWERPC, "evicting old blocks from code caches");
+      Jit(em_address, true);
+      return;
+    }
+
     // Clear the entire JIT cache and retry.
     WARN_LOG_FMT(POWERPC, "flushing code caches, please report if this happens a lot");
     ClearCache();
@@ -748,7 +769,7 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 {
   js.isLastInstruction = false;
   js.firstFPInstructionFound = false;
-  js.assumeNoPairedQuantize = false;
+  js.constantGqrValid = BitSet8();
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
@@ -780,27 +801,63 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     BeginTimeProfile(b);
   }
 
-  if (code_block.m_gqr_used.Count() == 1 &&
+  if (js.emitTierUpCounter)
+  {
+    b->tier_up_counter = TIER_UP_THRESHOLD;
+    MOVP2R(ARM64Reg::X0, &b->tier_up_counter);
+    LDR(IndexType::Unsigned, ARM64Reg::W1, ARM64Reg::X0, 0);
+    SUB(ARM64Reg::W1, ARM64Reg::W1, 1);
+    STR(IndexType::Unsigned, ARM64Reg::W1, ARM64Reg::X0, 0);
+    FixupBranch no_tier_up = CBNZ(ARM64Reg::W1);
+    FixupBranch tier_up = B();
+
+    SwitchToFarCode();
+    SetJumpTarget(tier_up);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    MOVI2R(ARM64Reg::W0, static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    MOVP2R(ARM64Reg::X1, &JitInterface::CompileExceptionCheck);
+    BLR(ARM64Reg::X1);
+    B(dispatcher_no_check);
+    SwitchToNearCode();
+    SetJumpTarget(no_tier_up);
+  }
+
+  // Assume that GQR values don't change often at runtime. If there are GQRs used but not set in
+  // this block, they are treated as constant so that paired loads and stores can be inlined.
+  const BitSet8 gqr_static = code_block.m_gqr_used & ~code_block.m_gqr_modified;
+  if (gqr_static &&
       js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
   {
-    int gqr = *code_block.m_gqr_used.begin();
-    if (!code_block.m_gqr_modified[gqr] && !GQR(gqr))
+    FixupBranch fail[8];
+    for (int gqr : gqr_static)
     {
+      const u32 value = GQR(gqr);
+      js.constantGqr[gqr] = value;
       LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + gqr));
-      FixupBranch no_fail = CBZ(ARM64Reg::W0);
-      FixupBranch fail = B();
-      SwitchToFarCode();
-      SetJumpTarget(fail);
-      MOVI2R(DISPATCHER_PC, js.blockStart);
-      STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
-      MOVI2R(ARM64Reg::W0, static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
-      MOVP2R(ARM64Reg::X1, &JitInterface::CompileExceptionCheck);
-      BLR(ARM64Reg::X1);
-      B(dispatcher_no_check);
-      SwitchToNearCode();
-      SetJumpTarget(no_fail);
-      js.assumeNoPairedQuantize = true;
+      if (value == 0)
+      {
+        fail[gqr] = CBNZ(ARM64Reg::W0);
+      }
+      else
+      {
+        CMPI2R(ARM64Reg::W0, value, ARM64Reg::W1);
+        fail[gqr] = B(CC_NEQ);
+      }
     }
+
+    SwitchToFarCode();
+    for (int gqr : gqr_static)
+      SetJumpTarget(fail[gqr]);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    MOVI2R(ARM64Reg::W0, static_cast<u32>(JitInterface::ExceptionType::PairedQuantize));
+    MOVP2R(ARM64Reg::X1, &JitInterface::CompileExceptionCheck);
+    BLR(ARM64Reg::X1);
+    B(dispatcher_no_check);
+    SwitchToNearCode();
+
+    js.constantGqrValid = gqr_static;
   }
 
   gpr.Start(js.gpa);
@@ -817,7 +874,7 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
     js.instructionNumber = i;
     js.instructionsLeft = (code_block.m_num_instructions - 1) - i;
     const GekkoOPInfo* opinfo = op.opinfo;
-    js.downcountAmount += opinfo->numCycles;
+    js.downcountAmount += op.num_cycles;
     js.isLastInstruction = i == (code_block.m_num_instructions - 1);
 
     if (!m_enable_debugging)
@@ -958,7 +1015,11 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         FlushCarry();
       }
 
-      CompileInstruction(op);
+      // The analyzer has already computed the result if all inputs are known.
+      if (op.gprOutputIsConstant && !bJITOff && !bJITIntegerOff)
+        gpr.SetImmediate(*op.regsOut.begin(), op.gprOutputConstant);
+      else
+        CompileInstruction(op);
 
       js.fpr_is_store_safe = op.fprIsStoreSafeAfterInst;
 
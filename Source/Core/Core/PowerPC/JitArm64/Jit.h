@@ -12,6 +12,7 @@
 #include "Common/Arm64Emitter.h"
 
 #include "Core/PowerPC/CPUCoreBase.h"
+#include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/JitArm64/JitArm64Cache.h"
 #include "Core/PowerPC/JitArm64/JitArm64_RegCache.h"
 #include "Core/PowerPC/JitArmCommon/BackPatch.h"
@@ -29,6 +30,7 @@ public:
   void Shutdown() override;
 
   JitBaseBlockCache* GetBlockCache() override { return &blocks; }
+  size_t GetResidentCodeSize() const override { return GetResidentSize(); }
   bool IsInCodeSpace(const u8* ptr) const { return IsInSpace(ptr); }
   bool HandleFault(uintptr_t access_address, SContext* ctx) override;
   void DoBacktrace(uintptr_t access_address, SContext* ctx);
@@ -270,6 +272,9 @@ protected:
                                          Arm64Gen::ARM64Reg tmp, const void* bat_table);
   Arm64Gen::FixupBranch CheckIfSafeAddress(Arm64Gen::ARM64Reg addr, Arm64Gen::ARM64Reg tmp1,
                                            Arm64Gen::ARM64Reg tmp2);
+  // Paired load/store (de)quantization for a GQR which is known at compile time
+  void GenerateInlineDequantize(Arm64Gen::ARM64Reg VS, EQuantizeType type, u32 scale);
+  void GenerateInlineQuantize(EQuantizeType type, u32 scale);
 
   bool DoJit(u32 em_address, JitBlock* b, u32 nextPC);
 
@@ -17,14 +17,99 @@
 
 using namespace Arm64Gen;
 
+static bool IsValidQuantizeType(EQuantizeType type)
+{
+  return type == QUANTIZE_FLOAT || type >= QUANTIZE_U8;
+}
+
+static u32 GetQuantizeSizeFlag(EQuantizeType type)
+{
+  switch (type)
+  {
+  case QUANTIZE_U8:
+  case QUANTIZE_S8:
+    return BackPatchInfo::FLAG_SIZE_8;
+  case QUANTIZE_U16:
+  case QUANTIZE_S16:
+    return BackPatchInfo::FLAG_SIZE_16;
+  default:
+    return BackPatchInfo::FLAG_SIZE_32;
+  }
+}
+
+// Same as the asm routines, but specialized for a scale known at compile time. Uses W30 and Q0.
+void JitArm64::GenerateInlineDequantize(ARM64Reg VS, EQuantizeType type, u32 scale)
+{
+  const ARM64Reg VD = EncodeRegToDouble(VS);
+  const bool is_signed = type == QUANTIZE_S8 || type == QUANTIZE_S16;
+
+  if (type == QUANTIZE_U8 || type == QUANTIZE_S8)
+  {
+    if (is_signed)
+      m_float_emit.SXTL(8, VD, VD);
+    else
+      m_float_emit.UXTL(8, VD, VD);
+  }
+  if (is_signed)
+    m_float_emit.SXTL(16, VD, VD);
+  else
+    m_float_emit.UXTL(16, VD, VD);
+
+  // Scales from 1 to 31 divide by a power of two, which a fixed-point conversion does for free.
+  // The loaded integers have at most 16 bits, so this rounds the same as a separate multiply.
+  if (scale != 0 && scale < 32)
+  {
+    if (is_signed)
+      m_float_emit.SCVTF(32, VD, VD, scale);
+    else
+      m_float_emit.UCVTF(32, VD, VD, scale);
+    return;
+  }
+
+  if (is_signed)
+    m_float_emit.SCVTF(32, VD, VD);
+  else
+    m_float_emit.UCVTF(32, VD, VD);
+
+  if (scale != 0)
+  {
+    m_float_emit.MOVI2F(ARM64Reg::S0, m_dequantizeTableS[scale * 2], ARM64Reg::W30);
+    m_float_emit.FMUL(32, VD, VD, ARM64Reg::D0, 0);
+  }
+}
+
+// Quantizes the singles in D0 in place, for a scale known at compile time. Uses W0 and Q1.
+void JitArm64::GenerateInlineQuantize(EQuantizeType type, u32 scale)
+{
+  const bool is_signed = type == QUANTIZE_S8 || type == QUANTIZE_S16;
+
+  if (scale != 0)
+  {
+    m_float_emit.MOVI2F(ARM64Reg::S1, m_quantizeTableS[scale * 2], ARM64Reg::W0);
+    m_float_emit.FMUL(32, ARM64Reg::D0, ARM64Reg::D0, ARM64Reg::D1, 0);
+  }
+
+  if (is_signed)
+  {
+    m_float_emit.FCVTZS(32, ARM64Reg::D0, ARM64Reg::D0);
+    m_float_emit.SQXTN(16, ARM64Reg::D0, ARM64Reg::D0);
+    if (type == QUANTIZE_S8)
+      m_float_emit.SQXTN(8, ARM64Reg::D0, ARM64Reg::D0);
+  }
+  else
+  {
+    m_float_emit.FCVTZU(32, ARM64Reg::D0, ARM64Reg::D0);
+    m_float_emit.UQXTN(16, ARM64Reg::D0, ARM64Reg::D0);
+    if (type == QUANTIZE_U8)
+      m_float_emit.UQXTN(8, ARM64Reg::D0, ARM64Reg::D0);
+  }
+}
+
 void JitArm64::psq_lXX(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
 
-  // If we have a fastmem arena, the asm routines assume address translation is on.
-  FALLBACK_IF(!js.assumeNoPairedQuantize && jo.fastmem_arena && !MSR.DR);
-
   // X30 is LR
   // X0 is the address
   // X1 contains the scale
@@ -37,9 +122,17 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
   const int i = indexed ? inst.Ix : inst.I;
   const int w = indexed ? inst.Wx : inst.W;
 
+  const u32 gqr = js.constantGqrValid[i] ? js.constantGqr[i] >> 16 : 0;
+  const EQuantizeType type = static_cast<EQuantizeType>(gqr & 0x7);
+  const u32 scale = (gqr >> 8) & 0x3F;
+  const bool inline_quantize = js.constantGqrValid[i] && IsValidQuantizeType(type);
+
+  // If we have a fastmem arena, the asm routines assume address translation is on.
+  FALLBACK_IF(!inline_quantize && jo.fastmem_arena && !MSR.DR);
+
   gpr.Lock(ARM64Reg::W0, ARM64Reg::W30);
   fpr.Lock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!inline_quantize)
   {
     gpr.Lock(ARM64Reg::W1, ARM64Reg::W2, ARM64Reg::W3);
     fpr.Lock(ARM64Reg::Q1);
@@ -78,7 +171,7 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (inline_quantize)
   {
     BitSet32 gprs_in_use = gpr.GetCallerSavedUsed();
     BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
@@ -92,12 +185,15 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
     if (!jo.memcheck)
       fprs_in_use[DecodeReg(VS)] = 0;
 
-    u32 flags = BackPatchInfo::FLAG_LOAD | BackPatchInfo::FLAG_FLOAT | BackPatchInfo::FLAG_SIZE_32;
+    u32 flags = BackPatchInfo::FLAG_LOAD | BackPatchInfo::FLAG_FLOAT | GetQuantizeSizeFlag(type);
     if (!w)
       flags |= BackPatchInfo::FLAG_PAIR;
 
     EmitBackpatchRoutine(flags, MemAccessMode::Auto, VS, EncodeRegTo64(addr_reg), gprs_in_use,
                          fprs_in_use);
+
+    if (type != QUANTIZE_FLOAT)
+      GenerateInlineDequantize(VS, type, scale);
   }
   else
   {
@@ -131,7 +227,7 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
 
   gpr.Unlock(ARM64Reg::W0, ARM64Reg::W30);
   fpr.Unlock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!inline_quantize)
   {
     gpr.Unlock(ARM64Reg::W1, ARM64Reg::W2, ARM64Reg::W3);
     fpr.Unlock(ARM64Reg::Q1);
@@ -147,9 +243,6 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
 
-  // If we have a fastmem arena, the asm routines assume address translation is on.
-  FALLBACK_IF(!js.assumeNoPairedQuantize && jo.fastmem_arena && !MSR.DR);
-
   // X30 is LR
   // X0 contains the scale
   // X1 is the address
@@ -161,15 +254,25 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   const int i = indexed ? inst.Ix : inst.I;
   const int w = indexed ? inst.Wx : inst.W;
 
+  const u32 gqr = js.constantGqrValid[i] ? js.constantGqr[i] & 0xFFFF : 0;
+  const EQuantizeType type = static_cast<EQuantizeType>(gqr & 0x7);
+  const u32 scale = (gqr >> 8) & 0x3F;
+  const bool inline_quantize = js.constantGqrValid[i] && IsValidQuantizeType(type);
+  // Floats are stored straight from the register cache, everything else is quantized into Q0.
+  const bool inline_float = inline_quantize && type == QUANTIZE_FLOAT;
+
+  // If we have a fastmem arena, the asm routines assume address translation is on.
+  FALLBACK_IF(!inline_quantize && jo.fastmem_arena && !MSR.DR);
+
   fpr.Lock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!inline_float)
     fpr.Lock(ARM64Reg::Q1);
 
   const bool have_single = fpr.IsSingle(inst.RS);
 
   ARM64Reg VS = fpr.R(inst.RS, have_single ? RegType::Single : RegType::Register);
 
-  if (js.assumeNoPairedQuantize)
+  if (inline_float)
   {
     if (!have_single)
     {
@@ -199,9 +302,9 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   }
 
   gpr.Lock(ARM64Reg::W0, ARM64Reg::W1, ARM64Reg::W30);
-  if (!js.assumeNoPairedQuantize || !jo.fastmem_arena)
+  if (!inline_quantize || !jo.fastmem_arena)
     gpr.Lock(ARM64Reg::W2);
-  if (!js.assumeNoPairedQuantize && !jo.fastmem_arena)
+  if (!inline_quantize && !jo.fastmem_arena)
     gpr.Lock(ARM64Reg::W3);
 
   constexpr ARM64Reg scale_reg = ARM64Reg::W0;
@@ -232,11 +335,19 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (inline_quantize)
   {
     BitSet32 gprs_in_use = gpr.GetCallerSavedUsed();
     BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
 
+    if (!inline_float)
+    {
+      GenerateInlineQuantize(type, scale);
+      VS = ARM64Reg::Q0;
+      fprs_in_use[DecodeReg(ARM64Reg::Q0)] = false;
+      fprs_in_use[DecodeReg(ARM64Reg::Q1)] = false;
+    }
+
     // Wipe the registers we are using as temporaries
     gprs_in_use[DecodeReg(ARM64Reg::W0)] = false;
     if (!update || early_update)
@@ -244,7 +355,7 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     if (!jo.fastmem_arena)
       gprs_in_use[DecodeReg(ARM64Reg::W2)] = false;
 
-    u32 flags = BackPatchInfo::FLAG_STORE | BackPatchInfo::FLAG_FLOAT | BackPatchInfo::FLAG_SIZE_32;
+    u32 flags = BackPatchInfo::FLAG_STORE | BackPatchInfo::FLAG_FLOAT | GetQuantizeSizeFlag(type);
     if (!w)
       flags |= BackPatchInfo::FLAG_PAIR;
 
@@ -270,15 +381,15 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize && !have_single)
+  if (inline_float && !have_single)
     fpr.Unlock(VS);
 
   gpr.Unlock(ARM64Reg::W0, ARM64Reg::W1, ARM64Reg::W30);
   fpr.Unlock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize || !jo.fastmem_arena)
+  if (!inline_quantize || !jo.fastmem_arena)
     gpr.Unlock(ARM64Reg::W2);
-  if (!js.assumeNoPairedQuantize && !jo.fastmem_arena)
+  if (!inline_quantize && !jo.fastmem_arena)
     gpr.Unlock(ARM64Reg::W3);
-  if (!js.assumeNoPairedQuantize)
+  if (!inline_float)
     fpr.Unlock(ARM64Reg::Q1);
 }
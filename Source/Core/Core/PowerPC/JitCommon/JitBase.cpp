@@ -3,11 +3,15 @@
 
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/HW/CPU.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -58,11 +62,19 @@ void JitBase::RefreshConfig()
   m_fastmem_enabled = Config::Get(Config::MAIN_FASTMEM);
   m_mmu_enabled = Core::System::GetInstance().IsMMUMode();
   m_pause_on_panic_enabled = Core::System::GetInstance().IsPauseOnPanicMode();
+  m_persistent_cache_enabled = Config::Get(Config::MAIN_JIT_PERSISTENT_CACHE);
 
   analyzer.SetDebuggingEnabled(m_enable_debugging);
-  analyzer.SetBranchFollowingEnabled(Config::Get(Config::MAIN_JIT_FOLLOW_BRANCH));
+  m_enable_branch_following = Config::Get(Config::MAIN_JIT_FOLLOW_BRANCH);
+  m_enable_tiered_compilation = Config::Get(Config::MAIN_JIT_TIERED_COMPILATION);
+  m_enable_interpreter_fallback = Config::Get(Config::MAIN_JIT_INTERPRETER_FALLBACK);
+  m_enable_large_pages = Config::Get(Config::MAIN_JIT_LARGE_PAGES);
+  m_low_memory_mode = Config::Get(Config::MAIN_LOW_MEMORY_MODE);
+
+  analyzer.SetBranchFollowingEnabled(m_enable_branch_following);
   analyzer.SetFloatExceptionsEnabled(m_enable_float_exceptions);
   analyzer.SetDivByZeroExceptionsEnabled(m_enable_div_by_zero_exceptions);
+  analyzer.SetPreciseCycleCountingEnabled(Config::Get(Config::MAIN_PRECISE_CYCLE_COUNTING));
 }
 
 bool JitBase::CanMergeNextInstructions(int count) const
@@ -98,3 +110,58 @@ bool JitBase::ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op
   else
     return false;
 }
+
+void JitBase::SetupBlockTier(u32 em_address)
+{
+  // Without branch following, both tiers would compile the exact same code.
+  js.emitTierUpCounter = m_enable_tiered_compilation && m_enable_branch_following &&
+                         !m_enable_debugging &&
+                         js.hotBlockAddresses.find(em_address) == js.hotBlockAddresses.end();
+
+  analyzer.SetBranchFollowingEnabled(m_enable_branch_following && !js.emitTierUpCounter);
+}
+
+bool JitBase::InterpretColdBlock(u32 em_address)
+{
+  if (!m_enable_interpreter_fallback || m_enable_debugging || m_precompiling_cached_blocks)
+    return false;
+
+  if (!js.interpretedBlockAddresses.insert(em_address).second)
+    return false;
+
+  PowerPC::ppcState.downcount -= Interpreter::getInstance()->SingleStepBlock();
+  return true;
+}
+
+void JitBase::PrecompileCachedBlocks(u32 em_address)
+{
+  if (!m_persistent_cache_enabled || m_precompiling_cached_blocks || m_enable_debugging ||
+      SConfig::GetInstance().bJITNoBlockCache)
+  {
+    return;
+  }
+
+  JitBaseBlockCache* block_cache = GetBlockCache();
+  JitPersistentCache& persistent_cache = block_cache->GetPersistentCache();
+  persistent_cache.Load(analyzer.GetOptions());
+
+  const u32 msr_bits = MSR.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  const std::vector<u32> addresses = persistent_cache.TakePendingBlocks(em_address, msr_bits);
+  if (addresses.empty())
+    return;
+
+  m_precompiling_cached_blocks = true;
+  for (u32 address : addresses)
+  {
+    // The caller is about to compile em_address anyway.
+    if (address == em_address || block_cache->GetBlockFromStartAddress(address, MSR.Hex))
+      continue;
+
+    // Jit() would raise an ISI for a block which can't be translated.
+    if (!PowerPC::JitCache_TranslateAddress(address).valid)
+      continue;
+
+    Jit(address);
+  }
+  m_precompiling_cached_blocks = false;
+}
@@ -82,7 +82,6 @@ protected:
     bool fixupExceptionHandler;
     Gen::FixupBranch exceptionHandler;
 
-    bool assumeNoPairedQuantize;
     BitSet8 constantGqrValid;
     std::array<u32, 8> constantGqr;
     bool firstFPInstructionFound;
@@ -90,6 +89,8 @@ protected:
     int skipInstructions;
     CarryFlag carryFlag;
 
+    bool emitTierUpCounter;
+
     bool generatingTrampoline = false;
     u8* trampolineExceptionHandler;
 
@@ -107,6 +108,8 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    std::unordered_set<u32> hotBlockAddresses;
+    std::unordered_set<u32> interpretedBlockAddresses;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -136,15 +139,47 @@ protected:
   bool m_fastmem_enabled = false;
   bool m_mmu_enabled = false;
   bool m_pause_on_panic_enabled = false;
+  bool m_enable_branch_following = false;
+  bool m_enable_tiered_compilation = false;
+  bool m_enable_interpreter_fallback = false;
+  bool m_enable_large_pages = false;
+  bool m_low_memory_mode = false;
+  bool m_persistent_cache_enabled = false;
+  bool m_precompiling_cached_blocks = false;
 
   void RefreshConfig();
 
   bool CanMergeNextInstructions(int count) const;
 
+  // Code spaces are a quarter of their usual size in low memory mode. Blocks which don't fit
+  // anymore evict the oldest ones instead of clearing the whole cache, so most games still run
+  // without constant recompilation.
+  size_t GetCodeSpaceSize(size_t size) const { return m_low_memory_mode ? size / 4 : size; }
+
   void UpdateMemoryAndExceptionOptions();
 
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
 
+  // Blocks which aren't known to be hot are first compiled without branch following, which keeps
+  // compiling cold code cheap. Those blocks count their runs in JitBlock::tier_up_counter and call
+  // CompileExceptionCheck(ExceptionType::HotBlock) once it runs out, which adds them to
+  // js.hotBlockAddresses and invalidates them so that they get recompiled with all optimizations.
+  static constexpr u32 TIER_UP_THRESHOLD = 1000;
+
+  // Configures the analyzer for the tier em_address is compiled in, and sets
+  // js.emitTierUpCounter. Must be called before analyzing the block.
+  void SetupBlockTier(u32 em_address);
+
+  // The first Dispatch() miss of an address runs its block in the interpreter instead of compiling
+  // it, so code which only ever runs once (initialization code, code of streamed overlays)
+  // never stalls the CPU thread on compilation. The block gets compiled on its second miss.
+  // Returns whether the block at em_address was interpreted.
+  bool InterpretColdBlock(u32 em_address);
+
+  // Compiles the blocks which the persistent cache knows about around em_address, if their guest
+  // code is unchanged. Must be called before em_address itself is compiled.
+  void PrecompileCachedBlocks(u32 em_address);
+
 public:
   JitBase();
   ~JitBase() override;
@@ -153,6 +188,8 @@ public:
 
   static const u8* Dispatch(JitBase& jit);
   virtual JitBaseBlockCache* GetBlockCache() = 0;
+  // The physical memory backing the generated code, for performance reports.
+  virtual size_t GetResidentCodeSize() const { return 0; }
 
   virtual void Jit(u32 em_address) = 0;
 
@@ -7,9 +7,10 @@
 #include <array>
 #include <cstring>
 #include <functional>
-#include <map>
+#include <memory>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
@@ -28,8 +29,9 @@ using namespace Gen;
 
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
-  return physical_addresses.lower_bound(address) !=
-         physical_addresses.lower_bound(address + length);
+  const auto begin = physical_addresses.begin();
+  const auto end = physical_addresses.end();
+  return std::lower_bound(begin, end, address) != std::lower_bound(begin, end, address + length);
 }
 
 JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
@@ -47,6 +49,7 @@ void JitBaseBlockCache::Init()
 
 void JitBaseBlockCache::Shutdown()
 {
+  m_persistent_cache.Save();
   JitRegister::Shutdown();
 }
 
@@ -60,13 +63,19 @@ void JitBaseBlockCache::Clear()
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
+  m_jit.js.hotBlockAddresses.clear();
+  m_jit.js.interpretedBlockAddresses.clear();
   for (auto& e : block_map)
   {
-    DestroyBlock(e.second);
+    for (JitBlock* block : e.second)
+      DestroyBlock(*block);
   }
   block_map.clear();
   links_to.clear();
-  block_range_map.clear();
+  for (auto& table : block_range_tables)
+    table.reset();
+  m_free_blocks.clear();
+  m_block_slabs.clear();
 
   valid_block.ClearAll();
 
@@ -87,21 +96,143 @@ JitBlock** JitBaseBlockCache::GetFastBlockMap()
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
 {
   for (const auto& e : block_map)
-    f(e.second);
+  {
+    for (const JitBlock* block : e.second)
+      f(*block);
+  }
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   const u32 physical_address = PowerPC::JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physical_address, JitBlock())->second;
+  if (m_free_blocks.empty())
+  {
+    auto& slab = m_block_slabs.emplace_back(std::make_unique<JitBlock[]>(BLOCK_SLAB_SIZE));
+    for (size_t i = BLOCK_SLAB_SIZE; i > 0; --i)
+      m_free_blocks.push_back(&slab[i - 1]);
+  }
+
+  JitBlock& b = *m_free_blocks.back();
+  m_free_blocks.pop_back();
+  b = JitBlock();
+  block_map[physical_address].push_back(&b);
   b.effectiveAddress = em_address;
   b.physicalAddress = physical_address;
   b.msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
   b.linkData.clear();
   b.fast_block_map_index = 0;
+  b.allocation_number = m_next_allocation_number++;
   return &b;
 }
 
+void JitBaseBlockCache::EraseUnfinalizedBlock(JitBlock& block)
+{
+  FreeBlock(block);
+}
+
+void JitBaseBlockCache::FreeBlock(JitBlock& block)
+{
+  const auto it = block_map.find(block.physicalAddress);
+  if (it == block_map.end())
+    return;
+
+  std::vector<JitBlock*>& blocks = it->second;
+  const auto block_it = std::find(blocks.begin(), blocks.end(), &block);
+  if (block_it == blocks.end())
+    return;
+
+  *block_it = blocks.back();
+  blocks.pop_back();
+  if (blocks.empty())
+    block_map.erase(it);
+
+  m_free_blocks.push_back(&block);
+}
+
+bool JitBaseBlockCache::EvictOldBlocks()
+{
+  std::vector<JitBlock*> blocks;
+  for (const auto& e : block_map)
+    blocks.insert(blocks.end(), e.second.begin(), e.second.end());
+
+  if (blocks.size() < 2)
+    return false;
+
+  std::vector<u64> allocation_numbers;
+  allocation_numbers.reserve(blocks.size());
+  for (const JitBlock* block : blocks)
+    allocation_numbers.push_back(block->allocation_number);
+
+  const auto middle = allocation_numbers.begin() + allocation_numbers.size() / 2;
+  std::nth_element(allocation_numbers.begin(), middle, allocation_numbers.end());
+  const u64 oldest_kept = *middle;
+
+  for (JitBlock* block : blocks)
+  {
+    if (block->allocation_number < oldest_kept)
+    {
+      RemoveBlockRanges(*block);
+      DestroyBlock(*block);
+      FreeBlock(*block);
+    }
+  }
+
+  return true;
+}
+
+std::vector<JitBlock*>& JitBaseBlockCache::GetBlockRange(u32 physical_address)
+{
+  auto& table = block_range_tables[physical_address >> BLOCK_RANGE_TABLE_SHIFT];
+  if (!table)
+    table = std::make_unique<BlockRangeTable>();
+
+  const u32 index = (physical_address >> BLOCK_RANGE_SHIFT) & (table->ranges.size() - 1);
+  return table->ranges[index];
+}
+
+void JitBaseBlockCache::AddBlockRanges(JitBlock& block)
+{
+  // physical_addresses is sorted, so each macro block only shows up in one run.
+  u32 last_range = 0;
+  bool first = true;
+  for (u32 addr : block.physical_addresses)
+  {
+    const u32 range = addr >> BLOCK_RANGE_SHIFT;
+    if (!first && range == last_range)
+      continue;
+    first = false;
+    last_range = range;
+
+    GetBlockRange(addr).push_back(&block);
+    ++block_range_tables[addr >> BLOCK_RANGE_TABLE_SHIFT]->num_entries;
+  }
+}
+
+void JitBaseBlockCache::RemoveBlockRanges(JitBlock& block)
+{
+  u32 last_range = 0;
+  bool first = true;
+  for (u32 addr : block.physical_addresses)
+  {
+    const u32 range = addr >> BLOCK_RANGE_SHIFT;
+    if (!first && range == last_range)
+      continue;
+    first = false;
+    last_range = range;
+
+    BlockRangeTable* table = block_range_tables[addr >> BLOCK_RANGE_TABLE_SHIFT].get();
+    if (!table)
+      continue;
+    std::vector<JitBlock*>& blocks = table->ranges[range & (table->ranges.size() - 1)];
+    const auto it = std::find(blocks.begin(), blocks.end(), &block);
+    if (it == blocks.end())
+      continue;
+    *it = blocks.back();
+    blocks.pop_back();
+    --table->num_entries;
+  }
+}
+
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
                                       const std::set<u32>& physical_addresses)
 {
@@ -109,25 +240,25 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   fast_block_map[index] = &block;
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
+  block.physical_addresses.assign(physical_addresses.begin(), physical_addresses.end());
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
   for (u32 addr : physical_addresses)
-  {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
-  }
+  AddBlockRanges(block);
 
   if (block_link)
   {
     for (const auto& e : block.linkData)
     {
-      links_to[e.exitAddress].insert(&block);
+      if (e.exitAddress != UNLINKED_INDIRECT_EXIT)
+        AddLinkTo(block, e.exitAddress);
     }
 
     LinkBlock(block);
   }
 
+  m_persistent_cache.RecordBlock(block);
+
   Common::Symbol* symbol = nullptr;
   if (JitRegister::IsEnabled() &&
       (symbol = g_symbolDB.GetSymbolFromAddr(block.effectiveAddress)) != nullptr)
@@ -155,12 +286,14 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  const auto iter = block_map.find(translated_addr);
+  if (iter == block_map.end())
+    return nullptr;
+
+  for (JitBlock* b : iter->second)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.msrBits == (msr & JIT_CACHE_MSR_MASK))
-      return &b;
+    if (b->effectiveAddress == addr && b->msrBits == (msr & JIT_CACHE_MSR_MASK))
+      return b;
   }
 
   return nullptr;
@@ -257,6 +390,7 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
         m_jit.js.fifoWriteAddresses.erase(i);
         m_jit.js.pairedQuantizeAddresses.erase(i);
         m_jit.js.noSpeculativeConstantsAddresses.erase(i);
+        m_jit.js.hotBlockAddresses.erase(i);
       }
     }
   }
@@ -264,62 +398,62 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  if (length == 0)
+    return;
+
+  // Iterate over all macro blocks which overlap the given range, skipping tables without code.
+  constexpr u32 RANGES_PER_TABLE_SHIFT = BLOCK_RANGE_TABLE_SHIFT - BLOCK_RANGE_SHIFT;
+  const u32 first_range = address >> BLOCK_RANGE_SHIFT;
+  const u32 last_range = static_cast<u32>((u64{address} + length - 1) >> BLOCK_RANGE_SHIFT);
+  for (u32 table_index = first_range >> RANGES_PER_TABLE_SHIFT;
+       table_index <= last_range >> RANGES_PER_TABLE_SHIFT; ++table_index)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    BlockRangeTable* table = block_range_tables[table_index].get();
+    if (!table)
+      continue;
+
+    const u32 table_first_range = table_index << RANGES_PER_TABLE_SHIFT;
+    const u32 table_last_range = table_first_range + (table->ranges.size() - 1);
+    const u32 begin = std::max(first_range, table_first_range) - table_first_range;
+    const u32 end = std::min(last_range, table_last_range) - table_first_range;
+    for (u32 i = begin; i <= end && table->num_entries != 0; ++i)
     {
-      JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
+      // Iterate over all blocks in the macro block. Removing a block swaps the last block of the
+      // macro block into its slot, which is then checked next.
+      std::vector<JitBlock*>& blocks = table->ranges[i];
+      size_t j = 0;
+      while (j < blocks.size())
       {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
+        JitBlock* block = blocks[j];
+        if (block->OverlapsPhysicalRange(address, length))
         {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
+          // Also remove the block from the other macro blocks it occupies, and then the block.
+          RemoveBlockRanges(*block);
+          DestroyBlock(*block);
+          FreeBlock(*block);
+        }
+        else
+        {
+          ++j;
         }
-        iter = start->second.erase(iter);
-      }
-      else
-      {
-        iter++;
       }
     }
-
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
   }
 }
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
-  return valid_block.m_valid_block.get();
+  return valid_block.m_valid_block;
 }
 
 void JitBaseBlockCache::WriteDestroyBlock(const JitBlock& block)
 {
 }
 
+void JitBaseBlockCache::WriteDisableIndirectExit(const JitBlock::LinkData& source)
+{
+}
+
 // Block linker
 // Make sure to have as many blocks as possible compiled before calling this
 // It's O(N), so it's fast :)
@@ -384,6 +518,59 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
   }
 }
 
+void JitBaseBlockCache::RemoveLinkTo(JitBlock& block, u32 exit_address)
+{
+  const bool still_linked = std::any_of(
+      block.linkData.begin(), block.linkData.end(),
+      [exit_address](const JitBlock::LinkData& e) { return e.exitAddress == exit_address; });
+  if (still_linked)
+    return;
+
+  const auto it = links_to.find(exit_address);
+  if (it == links_to.end())
+    return;
+  std::erase(it->second, &block);
+  if (it->second.empty())
+    links_to.erase(it);
+}
+
+void JitBaseBlockCache::AddLinkTo(JitBlock& block, u32 exit_address)
+{
+  std::vector<JitBlock*>& blocks = links_to[exit_address];
+  if (std::find(blocks.begin(), blocks.end(), &block) == blocks.end())
+    blocks.push_back(&block);
+}
+
+void JitBaseBlockCache::LinkIndirectExit(JitBlock& block, size_t link_index)
+{
+  JitBlock::LinkData& e = block.linkData[link_index];
+  const u32 address = PowerPC::ppcState.pc;
+
+  // The exit is waiting for its target to be compiled, which the dispatcher is about to do.
+  if (e.exitAddress == address)
+    return;
+
+  const u32 old_address = e.exitAddress;
+  const bool give_up = e.indirect_relinks == MAX_INDIRECT_EXIT_RELINKS;
+  e.exitAddress = give_up ? UNLINKED_INDIRECT_EXIT : address;
+  e.linkStatus = false;
+  RemoveLinkTo(block, old_address);
+
+  if (give_up)
+  {
+    WriteLinkBlock(e, nullptr);
+    WriteDisableIndirectExit(e);
+    return;
+  }
+
+  ++e.indirect_relinks;
+  AddLinkTo(block, address);
+
+  JitBlock* destination_block = GetBlockFromStartAddress(address, block.msrBits);
+  WriteLinkBlock(e, destination_block);
+  e.linkStatus = destination_block != nullptr;
+}
+
 void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 {
   if (fast_block_map[block.fast_block_map_index] == &block)
@@ -397,7 +584,7 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
     auto it = links_to.find(e.exitAddress);
     if (it == links_to.end())
       continue;
-    it->second.erase(&block);
+    std::erase(it->second, &block);
     if (it->second.empty())
       links_to.erase(it);
   }
@@ -16,6 +16,8 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/MemoryUtil.h"
+#include "Core/PowerPC/JitCommon/JitPersistentCache.h"
 
 class JitBase;
 
@@ -75,11 +77,15 @@ struct JitBlock : public JitBlockData
     u32 exitAddress;
     bool linkStatus;  // is it already linked?
     bool call;
+    // Indirect exits (bcctr and friends) compare the exit address against the target they are
+    // linked to, which is the last target they jumped to. See LinkIndirectExit.
+    bool indirect = false;
+    u8 indirect_relinks = 0;
   };
   std::vector<LinkData> linkData;
 
-  // This set stores all physical addresses of all occupied instructions.
-  std::set<u32> physical_addresses;
+  // The sorted physical addresses of all occupied instructions.
+  std::vector<u32> physical_addresses;
 
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
@@ -90,6 +96,13 @@ struct JitBlock : public JitBlockData
     u64 ticStart;
     u64 ticStop;
   } profile_data = {};
+
+  // Increases with every allocated block, so lower values belong to older blocks.
+  u64 allocation_number = 0;
+
+  // Remaining runs of a block compiled in the cheap tier before it gets recompiled with all
+  // optimizations. Only used if the block was compiled with a tier-up counter.
+  u32 tier_up_counter = 0;
 };
 
 typedef void (*CompiledCode)();
@@ -109,19 +122,27 @@ public:
     // The number of elements in the allocated array. Each u32 contains 32 bits.
     VALID_BLOCK_ALLOC_ELEMENTS = VALID_BLOCK_MASK_SIZE / 32
   };
-  // Directly accessed by Jit64.
-  std::unique_ptr<u32[]> m_valid_block;
+  static constexpr size_t VALID_BLOCK_ALLOC_SIZE = sizeof(u32) * VALID_BLOCK_ALLOC_ELEMENTS;
+  // Directly accessed by Jit64. Pages are only backed by memory once a bit in them is set, which
+  // keeps the 16 MiB bitset down to the few pages that cover code.
+  u32* m_valid_block;
 
   ValidBlockBitSet()
+      : m_valid_block(static_cast<u32*>(Common::AllocateMemoryPages(VALID_BLOCK_ALLOC_SIZE)))
   {
-    m_valid_block.reset(new u32[VALID_BLOCK_ALLOC_ELEMENTS]);
-    ClearAll();
   }
+  ~ValidBlockBitSet() { Common::FreeMemoryPages(m_valid_block, VALID_BLOCK_ALLOC_SIZE); }
+  ValidBlockBitSet(const ValidBlockBitSet&) = delete;
+  ValidBlockBitSet& operator=(const ValidBlockBitSet&) = delete;
 
   void Set(u32 bit) { m_valid_block[bit / 32] |= 1u << (bit % 32); }
   void Clear(u32 bit) { m_valid_block[bit / 32] &= ~(1u << (bit % 32)); }
-  void ClearAll() { memset(m_valid_block.get(), 0, sizeof(u32) * VALID_BLOCK_ALLOC_ELEMENTS); }
+  void ClearAll() { Common::DiscardMemoryPages(m_valid_block, VALID_BLOCK_ALLOC_SIZE); }
   bool Test(u32 bit) const { return (m_valid_block[bit / 32] & (1u << (bit % 32))) != 0; }
+  size_t GetResidentSize() const
+  {
+    return Common::MemResidentSize(m_valid_block, VALID_BLOCK_ALLOC_SIZE);
+  }
 };
 
 class JitBaseBlockCache
@@ -134,6 +155,12 @@ public:
   static constexpr u32 FAST_BLOCK_MAP_ELEMENTS = 0x10000;
   static constexpr u32 FAST_BLOCK_MAP_MASK = FAST_BLOCK_MAP_ELEMENTS - 1;
 
+  // Exit address of indirect exits which aren't linked to any target yet. PCs are always
+  // aligned, so this never matches.
+  static constexpr u32 UNLINKED_INDIRECT_EXIT = 0xFFFFFFFF;
+  // How often an indirect exit is linked to a new target before it is left to the dispatcher.
+  static constexpr u32 MAX_INDIRECT_EXIT_RELINKS = 4;
+
   explicit JitBaseBlockCache(JitBase& jit);
   virtual ~JitBaseBlockCache();
 
@@ -148,6 +175,18 @@ public:
 
   JitBlock* AllocateBlock(u32 em_address);
   void FinalizeBlock(JitBlock& block, bool block_link, const std::set<u32>& physical_addresses);
+  // Frees a block which was allocated but couldn't be finalized, e.g. because code generation ran
+  // out of space.
+  void EraseUnfinalizedBlock(JitBlock& block);
+
+  // Destroys the older half of all blocks, which makes room in the code space at a fraction of
+  // the cost of a full Clear(). Returns false if there was nothing to evict.
+  bool EvictOldBlocks();
+
+  // Called from the code of an indirect exit when PC doesn't match the target the exit is linked
+  // to. Links the exit to the block at PC instead, or gives up on linking it if its target keeps
+  // changing.
+  void LinkIndirectExit(JitBlock& block, size_t link_index);
 
   // Look for the block in the slow but accurate way.
   // This function shall be used if FastLookupIndexForAddress() failed.
@@ -165,6 +204,9 @@ public:
   void ErasePhysicalRange(u32 address, u32 length);
 
   u32* GetBlockBitSet() const;
+  size_t GetResidentBlockBitSetSize() const { return valid_block.GetResidentSize(); }
+
+  JitPersistentCache& GetPersistentCache() { return m_persistent_cache; }
 
 protected:
   virtual void DestroyBlock(JitBlock& block);
@@ -174,12 +216,21 @@ protected:
 private:
   virtual void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) = 0;
   virtual void WriteDestroyBlock(const JitBlock& block);
+  // Makes an indirect exit always go to the dispatcher, without calling LinkIndirectExit again.
+  virtual void WriteDisableIndirectExit(const JitBlock::LinkData& source);
 
   void LinkBlockExits(JitBlock& block);
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
+  void RemoveLinkTo(JitBlock& block, u32 exit_address);
+  void AddLinkTo(JitBlock& block, u32 exit_address);
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
 
+  void FreeBlock(JitBlock& block);
+  std::vector<JitBlock*>& GetBlockRange(u32 physical_address);
+  void AddBlockRanges(JitBlock& block);
+  void RemoveBlockRanges(JitBlock& block);
+
   JitBlock* MoveBlockIntoFastCache(u32 em_address, u32 msr);
 
   // Fast but risky block lookup based on fast_block_map.
@@ -187,17 +238,31 @@ private:
 
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
-  std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
+  std::unordered_map<u32, std::vector<JitBlock*>> links_to;  // destination_PC -> blocks
 
   // Map indexed by the physical address of the entry point.
   // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  std::unordered_map<u32, std::vector<JitBlock*>> block_map;  // start_addr -> blocks
 
-  // Range of overlapping code indexed by a masked physical address.
+  // Blocks are allocated in slabs, so that they never move and don't need an allocation each.
+  static constexpr size_t BLOCK_SLAB_SIZE = 1024;
+  std::vector<std::unique_ptr<JitBlock[]>> m_block_slabs;
+  std::vector<JitBlock*> m_free_blocks;
+
+  // Range of overlapping code indexed by physical address.
   // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
-  static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  // in macro blocks of each 0x100 bytes, and the macro blocks are grouped in tables
+  // of 1 MiB, which are only allocated for memory that contains code. This way an
+  // invalidation only looks at the macro blocks it covers.
+  static constexpr u32 BLOCK_RANGE_SHIFT = 8;
+  static constexpr u32 BLOCK_RANGE_TABLE_SHIFT = 20;
+  struct BlockRangeTable
+  {
+    std::array<std::vector<JitBlock*>, 1 << (BLOCK_RANGE_TABLE_SHIFT - BLOCK_RANGE_SHIFT)> ranges;
+    u32 num_entries = 0;
+  };
+  std::array<std::unique_ptr<BlockRangeTable>, 1 << (32 - BLOCK_RANGE_TABLE_SHIFT)>
+      block_range_tables;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
@@ -206,4 +271,9 @@ private:
   // This array is indexed with the masked PC and likely holds the correct block id.
   // This is used as a fast cache of block_map used in the assembly dispatcher.
   std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map{};  // start_addr & mask -> number
+
+  u64 m_next_allocation_number = 0;
+
+  // Block entry points of previous sessions, used to warm up the cache.
+  JitPersistentCache m_persistent_cache;
 };
@@ -0,0 +1,230 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitPersistentCache.h"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Common/Version.h"
+#include "Core/ConfigManager.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/MMU.h"
+
+namespace
+{
+constexpr u32 CACHE_FILE_MAGIC = 0x4C42504A;  // JPBL
+constexpr u32 CACHE_FILE_VERSION = 1;
+
+#pragma pack(push, 1)
+struct CacheFileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 build_hash;
+  u32 analyzer_options;
+  u32 num_entries;
+};
+
+struct CacheFileEntry
+{
+  u32 effective_address;
+  u32 msr_bits;
+  u64 code_hash;
+  u32 num_runs;
+};
+#pragma pack(pop)
+
+std::optional<std::vector<u32>> ReadGuestCode(const std::vector<std::pair<u32, u32>>& runs)
+{
+  std::vector<u32> code;
+  for (const auto& [address, count] : runs)
+  {
+    for (u32 i = 0; i < count; ++i)
+    {
+      const auto read_result = PowerPC::HostTryReadInstruction(
+          address + i * 4, PowerPC::RequestedAddressSpace::Physical);
+      if (!read_result)
+        return std::nullopt;
+      code.push_back(Common::swap32(read_result->value));
+    }
+  }
+  return code;
+}
+
+u64 HashCode(const std::vector<u32>& code)
+{
+  const u8* data = reinterpret_cast<const u8*>(code.data());
+  const size_t size = code.size() * sizeof(u32);
+  return (static_cast<u64>(Common::ComputeCRC32(data, size)) << 32) |
+         Common::HashAdler32(data, size);
+}
+
+std::vector<std::pair<u32, u32>> GetPhysicalRuns(const std::vector<u32>& physical_addresses)
+{
+  std::vector<std::pair<u32, u32>> runs;
+  for (u32 address : physical_addresses)
+  {
+    if (!runs.empty() && runs.back().first + runs.back().second * 4 == address)
+      ++runs.back().second;
+    else
+      runs.emplace_back(address, 1);
+  }
+  return runs;
+}
+
+u32 GetBuildHash()
+{
+  return Common::ComputeCRC32(Common::GetScmRevGitStr());
+}
+}  // namespace
+
+bool JitPersistentCache::IsGuestCodeUnchanged(const Entry& entry)
+{
+  const auto code = ReadGuestCode(entry.physical_runs);
+  return code && HashCode(*code) == entry.code_hash;
+}
+
+std::string JitPersistentCache::GetCachePath() const
+{
+  return fmt::format("{}{}_r{}.jitcache", File::GetUserPath(D_CACHE_IDX), m_game_id, m_revision);
+}
+
+void JitPersistentCache::Load(u32 analyzer_options)
+{
+  const SConfig& config = SConfig::GetInstance();
+  if (m_loaded && m_game_id == config.GetGameID() && m_revision == config.GetRevision() &&
+      m_analyzer_options == analyzer_options)
+  {
+    return;
+  }
+
+  // The running title or the JIT configuration changed, so start a new cache file.
+  if (m_loaded)
+    Save();
+
+  m_game_id = config.GetGameID();
+  m_revision = config.GetRevision();
+  m_analyzer_options = analyzer_options;
+  if (m_game_id.empty())
+    return;
+  m_loaded = true;
+
+  File::IOFile file(GetCachePath(), "rb");
+  CacheFileHeader header;
+  if (!file.ReadBytes(&header, sizeof(header)))
+    return;
+
+  if (header.magic != CACHE_FILE_MAGIC || header.version != CACHE_FILE_VERSION ||
+      header.build_hash != GetBuildHash() || header.analyzer_options != analyzer_options)
+  {
+    INFO_LOG_FMT(DYNA_REC, "Discarding outdated JIT block cache for {}", m_game_id);
+    return;
+  }
+
+  size_t num_loaded = 0;
+  for (u32 i = 0; i < header.num_entries; ++i)
+  {
+    CacheFileEntry file_entry;
+    if (!file.ReadBytes(&file_entry, sizeof(file_entry)))
+      break;
+
+    Entry entry{file_entry.effective_address, file_entry.msr_bits, file_entry.code_hash, {}};
+    entry.physical_runs.resize(file_entry.num_runs);
+    if (!file.ReadArray(entry.physical_runs.data(), entry.physical_runs.size()))
+      break;
+
+    m_pending[entry.effective_address >> REGION_SHIFT].push_back(std::move(entry));
+    ++num_loaded;
+  }
+
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} entries from the JIT block cache for {}", num_loaded,
+               m_game_id);
+}
+
+void JitPersistentCache::Save()
+{
+  if (!m_loaded)
+    return;
+
+  // Entries which were never needed this session are still kept, as the code they belong to may
+  // simply not have been reached (e.g. a different level or game mode).
+  for (auto& region : m_pending)
+  {
+    for (Entry& entry : region.second)
+      m_recorded.try_emplace(MakeKey(entry.effective_address, entry.msr_bits), std::move(entry));
+  }
+
+  File::IOFile file(GetCachePath(), "wb");
+  const CacheFileHeader header{CACHE_FILE_MAGIC, CACHE_FILE_VERSION, GetBuildHash(),
+                               m_analyzer_options, static_cast<u32>(m_recorded.size())};
+  bool success = file.WriteBytes(&header, sizeof(header));
+  for (const auto& [key, entry] : m_recorded)
+  {
+    const CacheFileEntry file_entry{entry.effective_address, entry.msr_bits, entry.code_hash,
+                                    static_cast<u32>(entry.physical_runs.size())};
+    success &= file.WriteBytes(&file_entry, sizeof(file_entry));
+    success &= file.WriteArray(entry.physical_runs.data(), entry.physical_runs.size());
+  }
+
+  if (!success)
+    WARN_LOG_FMT(DYNA_REC, "Failed to write JIT block cache to {}", GetCachePath());
+
+  m_loaded = false;
+  m_recorded.clear();
+  m_pending.clear();
+}
+
+void JitPersistentCache::RecordBlock(const JitBlock& block)
+{
+  if (!m_loaded)
+    return;
+
+  Entry entry{block.effectiveAddress, block.msrBits, 0, GetPhysicalRuns(block.physical_addresses)};
+  const auto code = ReadGuestCode(entry.physical_runs);
+  if (!code)
+    return;
+  entry.code_hash = HashCode(*code);
+
+  m_recorded.insert_or_assign(MakeKey(entry.effective_address, entry.msr_bits), std::move(entry));
+}
+
+std::vector<u32> JitPersistentCache::TakePendingBlocks(u32 em_address, u32 msr_bits)
+{
+  std::vector<u32> result;
+
+  const auto region = m_pending.find(em_address >> REGION_SHIFT);
+  if (region == m_pending.end())
+    return result;
+
+  // Entries whose guest code doesn't match (yet) are kept around; the region may be an overlay
+  // which hasn't been loaded, or which currently holds different code.
+  std::vector<Entry>& entries = region->second;
+  for (auto it = entries.begin(); it != entries.end();)
+  {
+    if (it->msr_bits == msr_bits && IsGuestCodeUnchanged(*it))
+    {
+      result.push_back(it->effective_address);
+      it = entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  if (entries.empty())
+    m_pending.erase(region);
+
+  return result;
+}
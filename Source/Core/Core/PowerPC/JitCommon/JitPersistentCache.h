@@ -0,0 +1,70 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+struct JitBlock;
+
+// Remembers which blocks a game compiled in previous sessions, so that they can be compiled
+// eagerly the next time the same guest code is seen instead of one Dispatch() miss at a time.
+//
+// Host code itself is not stored: it embeds absolute pointers to the asm routines, PowerPC
+// state, far code, constant pools and trampolines, which all move between sessions. Only the
+// block entry points are stored, together with a hash of the guest instructions they covered,
+// and the blocks are recompiled from (verified) guest memory when they are needed.
+class JitPersistentCache
+{
+public:
+  // Loads the cache of the running game if it hasn't been loaded yet. analyzer_options is part
+  // of the cache key, since it changes which instructions end up in a block.
+  void Load(u32 analyzer_options);
+  // Writes out every block recorded during this session (and every loaded entry which was never
+  // seen) and forgets all state.
+  void Save();
+
+  bool IsLoaded() const { return m_loaded; }
+
+  void RecordBlock(const JitBlock& block);
+
+  // Returns the entry points of cached blocks close to em_address which were compiled with the
+  // given MSR bits and whose guest code is unchanged. Returned entries are forgotten.
+  std::vector<u32> TakePendingBlocks(u32 em_address, u32 msr_bits);
+
+private:
+  struct Entry
+  {
+    u32 effective_address;
+    u32 msr_bits;
+    u64 code_hash;
+    // Runs of consecutive instructions as (physical address, instruction count) pairs.
+    std::vector<std::pair<u32, u32>> physical_runs;
+  };
+
+  // Blocks are looked up in 64 KiB regions, so that everything near a missed block is compiled
+  // at once without every miss having to walk the whole list.
+  static constexpr u32 REGION_SHIFT = 16;
+
+  static u64 MakeKey(u32 effective_address, u32 msr_bits)
+  {
+    return (static_cast<u64>(msr_bits) << 32) | effective_address;
+  }
+  static bool IsGuestCodeUnchanged(const Entry& entry);
+
+  std::string GetCachePath() const;
+
+  bool m_loaded = false;
+  std::string m_game_id;
+  u16 m_revision = 0;
+  u32 m_analyzer_options = 0;
+
+  std::unordered_map<u64, Entry> m_recorded;
+  std::map<u32, std::vector<Entry>> m_pending;
+};
@@ -22,6 +22,7 @@
 #include "Common/MsgHandler.h"
 
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -146,6 +147,16 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
   });
 }
 
+size_t GetResidentCodeSize()
+{
+  return g_jit ? g_jit->GetResidentCodeSize() : 0;
+}
+
+size_t GetResidentBlockBitSetSize()
+{
+  return g_jit ? g_jit->GetBlockCache()->GetResidentBlockBitSetSize() : 0;
+}
+
 int GetHostCode(u32* address, const u8** code, u32* code_size)
 {
   if (!g_jit)
@@ -187,6 +198,10 @@ int GetHostCode(u32* address, const u8** code, u32* code_size)
 
 bool HandleFault(uintptr_t access_address, SContext* ctx)
 {
+  // Writes to pages watched by the video backend can come from any thread, not just JIT code
+  if (Memory::HandleWriteWatchFault(access_address))
+    return true;
+
   // Prevent nullptr dereference on a crash with no JIT present
   if (!g_jit)
   {
@@ -263,6 +278,9 @@ void CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::HotBlock:
+    exception_addresses = &g_jit->js.hotBlockAddresses;
+    break;
   }
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
@@ -28,7 +28,8 @@ enum class ExceptionType
 {
   FIFOWrite,
   PairedQuantize,
-  SpeculativeConstants
+  SpeculativeConstants,
+  HotBlock
 };
 
 void DoState(PointerWrap& p);
@@ -47,6 +48,9 @@ void SetProfilingState(ProfilingState state);
 void WriteProfileResults(const std::string& filename);
 void GetProfileResults(Profiler::ProfileStats* prof_stats);
 int GetHostCode(u32* address, const u8** code, u32* code_size);
+// The physical memory used by the generated code and by the block bitset, in bytes.
+size_t GetResidentCodeSize();
+size_t GetResidentBlockBitSetSize();
 
 // Memory Utilities
 bool HandleFault(uintptr_t access_address, SContext* ctx);
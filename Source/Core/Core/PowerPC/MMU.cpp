@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/MMU.h"
 
+#include <array>
 #include <cstddef>
 #include <cstring>
 #include <string>
@@ -82,12 +83,12 @@ enum class XCheckTLBFlag
   OpcodeNoException
 };
 
-static bool IsOpcodeFlag(XCheckTLBFlag flag)
+static constexpr bool IsOpcodeFlag(XCheckTLBFlag flag)
 {
   return flag == XCheckTLBFlag::Opcode || flag == XCheckTLBFlag::OpcodeNoException;
 }
 
-static bool IsNoExceptionFlag(XCheckTLBFlag flag)
+static constexpr bool IsNoExceptionFlag(XCheckTLBFlag flag)
 {
   return flag == XCheckTLBFlag::NoException || flag == XCheckTLBFlag::OpcodeNoException;
 }
@@ -115,6 +116,113 @@ struct TranslateAddressResult
 template <const XCheckTLBFlag flag>
 static TranslateAddressResult TranslateAddress(u32 address);
 
+// Direct-mapped cache from effective pages to the host memory backing them, which lets RAM
+// accesses through the page table skip the BAT, TLB and memory region checks. Every entry mirrors
+// a valid way of the emulated data TLB and is dropped as soon as that way is replaced or
+// invalidated, so the guest visible TLB behavior is unchanged.
+struct HostPageCacheEntry
+{
+  static constexpr u32 INVALID_TAG = 0xffffffff;
+
+  u32 tag = INVALID_TAG;
+  u32 way = 0;
+  // Stores can only use the entry if the PTE already has its changed bit set, and if the page is
+  // neither write-through nor cache-inhibited.
+  bool writable = false;
+  u8* host_page = nullptr;
+};
+
+constexpr u32 HOST_PAGE_CACHE_SIZE = 1024;
+static std::array<HostPageCacheEntry, HOST_PAGE_CACHE_SIZE> s_host_page_cache;
+static u64 s_host_page_cache_hits = 0;
+static u64 s_host_page_cache_misses = 0;
+
+static HostPageCacheEntry& GetHostPageCacheEntry(u32 tag)
+{
+  return s_host_page_cache[tag % HOST_PAGE_CACHE_SIZE];
+}
+
+static void InvalidateHostPageCacheEntry(u32 tag)
+{
+  HostPageCacheEntry& entry = GetHostPageCacheEntry(tag);
+  if (entry.tag == tag)
+    entry.tag = HostPageCacheEntry::INVALID_TAG;
+}
+
+static void ClearHostPageCache()
+{
+  s_host_page_cache.fill({});
+}
+
+// Returns a host pointer for a data access to em_address if its page is cached, updating the
+// emulated TLB the same way a TLB hit would.
+template <XCheckTLBFlag flag, bool is_store>
+static u8* LookupHostPageCache(u32 em_address)
+{
+  static_assert(!IsOpcodeFlag(flag));
+
+  const u32 tag = em_address >> HW_PAGE_INDEX_SHIFT;
+  const HostPageCacheEntry& entry = GetHostPageCacheEntry(tag);
+  if (entry.tag != tag || (is_store && !entry.writable))
+    return nullptr;
+
+  if (!IsNoExceptionFlag(flag))
+    ppcState.tlb[0][tag & HW_PAGE_INDEX_MASK].recent = entry.way;
+
+  ++s_host_page_cache_hits;
+  return entry.host_page + (em_address & HW_PAGE_MASK);
+}
+
+// Called after em_address was translated to physical_address through the page table.
+template <XCheckTLBFlag flag>
+static void UpdateHostPageCache(u32 em_address, u32 physical_address)
+{
+  static_assert(!IsOpcodeFlag(flag));
+
+  ++s_host_page_cache_misses;
+
+  // Only pages which made it into the TLB can be cached (NoException lookups don't add them).
+  const u32 tag = em_address >> HW_PAGE_INDEX_SHIFT;
+  const TLBEntry& tlbe = ppcState.tlb[0][tag & HW_PAGE_INDEX_MASK];
+  u32 way;
+  if (tlbe.tag[0] == tag)
+    way = 0;
+  else if (tlbe.tag[1] == tag)
+    way = 1;
+  else
+    return;
+
+  const u32 physical_page = physical_address & ~static_cast<u32>(HW_PAGE_MASK);
+  u8* host_page;
+  if (Memory::m_pRAM && (physical_page & 0xF8000000) == 0x00000000)
+    host_page = &Memory::m_pRAM[physical_page & Memory::GetRamMask()];
+  else if (Memory::m_pEXRAM && (physical_page >> 28) == 0x1 &&
+           (physical_page & 0x0FFFFFFF) < Memory::GetExRamSizeReal())
+    host_page = &Memory::m_pEXRAM[physical_page & 0x0FFFFFFF];
+  else
+    return;
+
+  const UPTE_Hi pte2(tlbe.pte[way]);
+  HostPageCacheEntry& entry = GetHostPageCacheEntry(tag);
+  entry.tag = tag;
+  entry.way = way;
+  entry.writable = pte2.C != 0 && (pte2.WIMG & 0b1100) == 0;
+  entry.host_page = host_page;
+}
+
+void LogHostPageCacheStats()
+{
+  const u64 total = s_host_page_cache_hits + s_host_page_cache_misses;
+  if (total != 0)
+  {
+    INFO_LOG_FMT(POWERPC, "Host page cache: {} hits, {} misses ({:.2f}% hit rate)",
+                 s_host_page_cache_hits, s_host_page_cache_misses,
+                 100.0 * s_host_page_cache_hits / total);
+  }
+  s_host_page_cache_hits = 0;
+  s_host_page_cache_misses = 0;
+}
+
 // Nasty but necessary. Super Mario Galaxy pointer relies on this stuff.
 static u32 EFB_Read(const u32 addr)
 {
@@ -189,6 +297,16 @@ static T ReadFromHardware(u32 em_address)
 
   if (!never_translate && MSR.DR)
   {
+    if constexpr (!IsOpcodeFlag(flag))
+    {
+      if (const u8* host_ptr = LookupHostPageCache<flag, false>(em_address))
+      {
+        T value;
+        std::memcpy(&value, host_ptr, sizeof(T));
+        return bswap(value);
+      }
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -196,6 +314,11 @@ static T ReadFromHardware(u32 em_address)
         GenerateDSIException(em_address, false);
       return 0;
     }
+    if constexpr (!IsOpcodeFlag(flag))
+    {
+      if (translated_addr.result == TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED)
+        UpdateHostPageCache<flag>(em_address, translated_addr.address);
+    }
     em_address = translated_addr.address;
   }
 
@@ -276,6 +399,13 @@ static void WriteToHardware(u32 em_address, const u32 data, const u32 size)
 
   if (!never_translate && MSR.DR)
   {
+    if (u8* host_ptr = LookupHostPageCache<flag, true>(em_address))
+    {
+      const u32 swapped_data = Common::swap32(Common::RotateRight(data, size * 8));
+      std::memcpy(host_ptr, &swapped_data, size);
+      return;
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -283,6 +413,8 @@ static void WriteToHardware(u32 em_address, const u32 data, const u32 size)
         GenerateDSIException(em_address, true);
       return;
     }
+    if (translated_addr.result == TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED)
+      UpdateHostPageCache<flag>(em_address, translated_addr.address);
     em_address = translated_addr.address;
     wi = translated_addr.wi;
   }
@@ -878,51 +1010,55 @@ std::optional<ReadResult<std::string>> HostTryReadString(u32 address, size_t siz
 
 bool IsOptimizableRAMAddress(const u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
-    return false;
-
   if (!MSR.DR)
     return false;
 
   // TODO: This API needs to take an access size
   //
   // We store whether an access can be optimized to an unchecked access
-  // in dbat_table.
+  // in dbat_table. Pages that overlap a memcheck are never marked as such, and changing the
+  // memchecks updates dbat_table, which clears the JIT cache.
   u32 bat_result = dbat_table[address >> BAT_INDEX_SHIFT];
   return (bat_result & BAT_PHYSICAL_BIT) != 0;
 }
 
 template <XCheckTLBFlag flag>
-static bool IsRAMAddress(u32 address, bool translate)
+static u8* GetRAMPointer(u32 address, bool translate)
 {
   if (translate)
   {
     auto translate_address = TranslateAddress<flag>(address);
     if (!translate_address.Success())
-      return false;
+      return nullptr;
     address = translate_address.address;
   }
 
   u32 segment = address >> 28;
   if (Memory::m_pRAM && segment == 0x0 && (address & 0x0FFFFFFF) < Memory::GetRamSizeReal())
   {
-    return true;
+    return &Memory::m_pRAM[address & 0x0FFFFFFF];
   }
   else if (Memory::m_pEXRAM && segment == 0x1 &&
            (address & 0x0FFFFFFF) < Memory::GetExRamSizeReal())
   {
-    return true;
+    return &Memory::m_pEXRAM[address & 0x0FFFFFFF];
   }
   else if (Memory::m_pFakeVMEM && ((address & 0xFE000000) == 0x7E000000))
   {
-    return true;
+    return &Memory::m_pFakeVMEM[address & Memory::GetFakeVMemMask()];
   }
   else if (Memory::m_pL1Cache && segment == 0xE &&
            (address < (0xE0000000 + Memory::GetL1CacheSize())))
   {
-    return true;
+    return &Memory::m_pL1Cache[address & 0x0FFFFFFF];
   }
-  return false;
+  return nullptr;
+}
+
+template <XCheckTLBFlag flag>
+static bool IsRAMAddress(u32 address, bool translate)
+{
+  return GetRAMPointer<flag>(address, translate) != nullptr;
 }
 
 bool HostIsRAMAddress(u32 address, RequestedAddressSpace space)
@@ -943,6 +1079,33 @@ bool HostIsRAMAddress(u32 address, RequestedAddressSpace space)
   return false;
 }
 
+std::optional<ReadResult<const u8*>> HostTryGetRAMPointer(u32 address, RequestedAddressSpace space)
+{
+  bool translate;
+  switch (space)
+  {
+  case RequestedAddressSpace::Effective:
+    translate = MSR.DR;
+    break;
+  case RequestedAddressSpace::Physical:
+    translate = false;
+    break;
+  case RequestedAddressSpace::Virtual:
+    if (!MSR.DR)
+      return std::nullopt;
+    translate = true;
+    break;
+  default:
+    ASSERT(0);
+    return std::nullopt;
+  }
+
+  const u8* pointer = GetRAMPointer<XCheckTLBFlag::NoException>(address, translate);
+  if (!pointer)
+    return std::nullopt;
+  return ReadResult<const u8*>(translate, pointer);
+}
+
 bool HostIsInstructionRAMAddress(u32 address, RequestedAddressSpace space)
 {
   // Instructions are always 32bit aligned.
@@ -1067,7 +1230,8 @@ void ClearCacheLine(u32 address)
 
 u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
 {
-  if (PowerPC::memchecks.HasAny())
+  // Changing the memchecks clears the JIT cache, so only watched addresses need to be excluded.
+  if (PowerPC::memchecks.GetMemCheck(address, access_size >> 3) != nullptr)
     return 0;
 
   if (!MSR.DR)
@@ -1090,7 +1254,8 @@ u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
 
 bool IsOptimizableGatherPipeWrite(u32 address)
 {
-  if (PowerPC::memchecks.HasAny())
+  // Gather pipe writes are at most 8 bytes long.
+  if (PowerPC::memchecks.GetMemCheck(address, 8) != nullptr)
     return false;
 
   if (!MSR.DR)
@@ -1278,6 +1443,8 @@ static void UpdateTLBEntry(const XCheckTLBFlag flag, UPTE_Hi pte2, const u32 add
   const u32 tag = address >> HW_PAGE_INDEX_SHIFT;
   TLBEntry& tlbe = ppcState.tlb[IsOpcodeFlag(flag)][tag & HW_PAGE_INDEX_MASK];
   const u32 index = tlbe.recent == 0 && tlbe.tag[0] != TLBEntry::INVALID_TAG;
+  if (!IsOpcodeFlag(flag) && tlbe.tag[index] != TLBEntry::INVALID_TAG)
+    InvalidateHostPageCacheEntry(tlbe.tag[index]);
   tlbe.recent = index;
   tlbe.paddr[index] = pte2.RPN << HW_PAGE_INDEX_SHIFT;
   tlbe.pte[index] = pte2.Hex;
@@ -1288,6 +1455,12 @@ void InvalidateTLBEntry(u32 address)
 {
   const u32 entry_index = (address >> HW_PAGE_INDEX_SHIFT) & HW_PAGE_INDEX_MASK;
 
+  for (u32 tag : ppcState.tlb[0][entry_index].tag)
+  {
+    if (tag != TLBEntry::INVALID_TAG)
+      InvalidateHostPageCacheEntry(tag);
+  }
+
   ppcState.tlb[0][entry_index].Invalidate();
   ppcState.tlb[1][entry_index].Invalidate();
 }
@@ -1514,6 +1687,10 @@ static void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
 
 void DBATUpdated()
 {
+  // Cached pages must not be covered by a BAT, as BATs take priority over the page table. This is
+  // also how the cache gets dropped when the TLB is reset or loaded from a savestate.
+  ClearHostPageCache();
+
   dbat_table = {};
   UpdateBATs(dbat_table, SPR_DBAT0U);
   bool extended_bats = SConfig::GetInstance().bWii && HID4.SBE;
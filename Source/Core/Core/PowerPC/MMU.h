@@ -120,6 +120,12 @@ HostTryWriteF64(double var, const u32 address,
 // address space.
 bool HostIsRAMAddress(u32 address, RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+// Returns a host pointer to the RAM that the given address resolves to in the given address space,
+// without raising any exceptions. The pointer is only valid up to the end of the address's page.
+// Meant for host code that reads a lot of memory, which only needs to translate once per page.
+std::optional<ReadResult<const u8*>>
+HostTryGetRAMPointer(u32 address, RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
 // Same as HostIsRAMAddress, but uses IBAT instead of DBAT.
 bool HostIsInstructionRAMAddress(u32 address,
                                  RequestedAddressSpace space = RequestedAddressSpace::Effective);
@@ -171,6 +177,8 @@ void SDRUpdated();
 void InvalidateTLBEntry(u32 address);
 void DBATUpdated();
 void IBATUpdated();
+// Logs and resets the hit rate of the host page cache in front of the data TLB.
+void LogHostPageCacheStats();
 
 // Result changes based on the BAT registers and MSR.DR.  Returns whether
 // it's safe to optimize a read or write to this address to an unguarded
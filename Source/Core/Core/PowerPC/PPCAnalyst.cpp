@@ -4,7 +4,10 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <map>
+#include <optional>
 #include <queue>
 #include <string>
 #include <vector>
@@ -12,6 +15,7 @@
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
@@ -451,6 +455,131 @@ static bool isCror(const CodeOp& a)
   return a.inst.OPCD == 19 && a.inst.SUBOP10 == 449;
 }
 
+static bool IsIntegerCompare(const CodeOp& op)
+{
+  // cmpli, cmpi, cmp, cmpl
+  return op.inst.OPCD == 10 || op.inst.OPCD == 11 ||
+         (op.inst.OPCD == 31 && (op.inst.SUBOP10 == 0 || op.inst.SUBOP10 == 32));
+}
+
+static BitSet8 GetCRFieldsRead(const CodeOp& op)
+{
+  // Anything which can leave the block has to see the whole CR.
+  if (op.canEndBlock || op.canCauseException)
+    return BitSet8(0xFF);
+
+  // Branches, CR logical instructions, mcrf, mfcr and isel.
+  if (op.inst.OPCD == 16 || op.inst.OPCD == 19 ||
+      (op.inst.OPCD == 31 && (op.inst.SUBOP10 == 19 || op.inst.SUBOP5 == 15)))
+  {
+    return BitSet8(0xFF);
+  }
+
+  return BitSet8(0);
+}
+
+static BitSet8 GetCRFieldsOverwritten(const CodeOp& op)
+{
+  // mtcrf only writes the fields selected by its mask, which can't be treated as overwriting.
+  if (op.inst.OPCD == 31 && op.inst.SUBOP10 == 144)
+    return BitSet8(0);
+
+  BitSet8 result;
+  if (op.opinfo->flags & FL_SET_CRn)
+    result[op.inst.CRFD] = true;
+  if (op.outputCR0)
+    result[0] = true;
+  if (op.outputCR1)
+    result[1] = true;
+  return result;
+}
+
+static std::optional<u32> EvaluateConstantOp(const CodeOp& op, BitSet32 gpr_is_constant,
+                                             const std::array<u32, 32>& gpr_values)
+{
+  // Only instructions which do nothing but write a single GPR can be folded.
+  if (op.regsOut.Count() != 1 || (op.regsIn & gpr_is_constant) != op.regsIn ||
+      op.opinfo->type != OpType::Integer || op.outputCR0 || op.outputCR1 || op.outputCA ||
+      op.canEndBlock || op.canCauseException)
+  {
+    return std::nullopt;
+  }
+
+  const UGeckoInstruction inst = op.inst;
+  const u32 a = inst.RA ? gpr_values[inst.RA] : 0;
+  const u32 b = gpr_values[inst.RB];
+  const u32 s = gpr_values[inst.RS];
+
+  switch (inst.OPCD)
+  {
+  case 7:  // mulli
+    return a * static_cast<u32>(inst.SIMM_16);
+  case 14:  // addi
+    return a + static_cast<u32>(inst.SIMM_16);
+  case 15:  // addis
+    return a + (static_cast<u32>(inst.SIMM_16) << 16);
+  case 20:  // rlwimi
+  {
+    const u32 mask = MakeRotationMask(inst.MB, inst.ME);
+    return (Common::RotateLeft(s, inst.SH) & mask) | (a & ~mask);
+  }
+  case 21:  // rlwinm
+    return Common::RotateLeft(s, inst.SH) & MakeRotationMask(inst.MB, inst.ME);
+  case 23:  // rlwnm
+    return Common::RotateLeft(s, b & 0x1F) & MakeRotationMask(inst.MB, inst.ME);
+  case 24:  // ori
+    return s | inst.UIMM;
+  case 25:  // oris
+    return s | (inst.UIMM << 16);
+  case 26:  // xori
+    return s ^ inst.UIMM;
+  case 27:  // xoris
+    return s ^ (inst.UIMM << 16);
+  case 31:
+    switch (inst.SUBOP10)
+    {
+    case 24:  // slw
+      return (b & 0x20) ? 0 : s << (b & 0x1F);
+    case 26:  // cntlzw
+      return static_cast<u32>(std::countl_zero(s));
+    case 28:  // and
+      return s & b;
+    case 40:  // subf
+      return b - a;
+    case 60:  // andc
+      return s & ~b;
+    case 104:  // neg
+      return 0 - a;
+    case 124:  // nor
+      return ~(s | b);
+    case 235:  // mullw
+      return a * b;
+    case 266:  // add
+      return a + b;
+    case 284:  // eqv
+      return ~(s ^ b);
+    case 316:  // xor
+      return s ^ b;
+    case 412:  // orc
+      return s | ~b;
+    case 444:  // or
+      return s | b;
+    case 476:  // nand
+      return ~(s & b);
+    case 536:  // srw
+      return (b & 0x20) ? 0 : s >> (b & 0x1F);
+    case 922:  // extsh
+      return static_cast<u32>(static_cast<s32>(static_cast<s16>(s)));
+    case 954:  // extsb
+      return static_cast<u32>(static_cast<s32>(static_cast<s8>(s)));
+    default:
+      return std::nullopt;
+    }
+  default:
+    return std::nullopt;
+  }
+}
+
 void PPCAnalyzer::ReorderInstructionsCore(u32 instructions, CodeOp* code, bool reverse,
                                           ReorderType type) const
 {
@@ -680,55 +809,115 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code, const Gekk
 
 bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const
 {
-  // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
-  //   * It does not write to memory.
-  //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
-  //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
-  std::bitset<32> write_disallowed_regs;
-  std::bitset<32> written_regs;
-  for (size_t i = 0; i <= instructions; ++i)
+  // A loop is a busy wait loop if an iteration can't change any state that the next iteration
+  // depends on, so that only something outside of the CPU (e.g. hardware updating an MMIO
+  // register, or an interrupt handler) can make it exit:
+  //   * It branches back to an earlier instruction of the block. Everything in between is the
+  //     loop body, including calls inlined by branch following. Branches out of the loop are
+  //     fine, but it can't use CTR.
+  //   * It does not write to memory, and only contains integer, load, CR logical and branch
+  //     instructions.
+  //   * Every GPR, FPR, CR bit and the carry flag it reads is either written by the loop before
+  //     being read, or not written by the loop at all.
+  const u32 loop_start = code[instructions].branchTo;
+  size_t first = instructions + 1;
+  for (size_t i = instructions + 1; i-- > 0;)
   {
-    if (code[i].opinfo->type == OpType::Branch)
+    if (code[i].address == loop_start)
     {
-      if (code[i].branchUsesCtr)
-        return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
-        return true;
+      first = i;
+      break;
     }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
+  }
+  if (first > instructions)
+    return false;
+
+  BitSet32 gpr_read, gpr_written, fpr_read, fpr_written, cr_read, cr_written;
+  bool ca_read = false, ca_written = false;
+  for (size_t i = first; i <= instructions; ++i)
+  {
+    const CodeOp& op = code[i];
+    BitSet32 cr_in, cr_out;
+
+    switch (op.opinfo->type)
     {
+    case OpType::Branch:
+      if (op.branchUsesCtr)
+        return false;
+      if ((op.inst.OPCD == 16 || op.inst.OPCD == 19) &&
+          (op.inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      {
+        cr_in[op.inst.BI] = true;
+      }
+      break;
+    case OpType::CR:
+      cr_in[op.inst.CRBA] = true;
+      cr_in[op.inst.CRBB] = true;
+      cr_out[op.inst.CRBD] = true;
+      break;
+    case OpType::Integer:
+    case OpType::Load:
+    case OpType::LoadFP:
+    case OpType::LoadPS:
+      // Overflow ops modify XER[SO], which compares read.
+      if ((op.opinfo->flags & FL_SET_OE) && op.inst.OE)
+        return false;
+      for (int field : GetCRFieldsOverwritten(op))
+        cr_out |= BitSet32(0xF << (field * 4));
+      break;
+    default:
       // In the future, some subsets of other instruction types might get
       // supported. Right now, only try loops that have this very
       // restricted instruction set.
       return false;
     }
-    else
+
+    gpr_read |= op.regsIn & ~gpr_written;
+    fpr_read |= op.fregsIn & ~fpr_written;
+    cr_read |= cr_in & ~cr_written;
+    ca_read |= op.wantsCA && !ca_written;
+
+    if (op.regsOut & gpr_read || op.GetFregsOut() & fpr_read || cr_out & cr_read ||
+        (op.outputCA && ca_read))
     {
-      for (int reg : code[i].regsIn)
-      {
-        if (reg == -1)
-          continue;
-        if (written_regs[reg])
-          continue;
-        write_disallowed_regs[reg] = true;
-      }
-      for (int reg : code[i].regsOut)
-      {
-        if (reg == -1)
-          continue;
-        if (write_disallowed_regs[reg])
-          return false;
-        written_regs[reg] = true;
-      }
+      return false;
     }
+
+    gpr_written |= op.regsOut;
+    fpr_written |= op.GetFregsOut();
+    cr_written |= cr_out;
+    ca_written |= op.outputCA;
   }
-  return false;
+  return true;
+}
+
+void PPCAnalyzer::AssignPreciseCycles(CodeBlock* block, CodeOp* code)
+{
+  // Instructions issue in order. Each one keeps the next from issuing for its throughput, and
+  // can't issue before the results it reads are ready. Each instruction is charged for how far it
+  // moves the issue cycle.
+  std::array<int, 32> gpr_ready{};
+  std::array<int, 32> fpr_ready{};
+  int cycle = 0;
+  for (u32 i = 0; i < block->m_num_instructions; i++)
+  {
+    CodeOp& op = code[i];
+    const PPCTables::CycleCost cost = PPCTables::GetCycleCost(op.opinfo);
+
+    int issue = cycle;
+    for (int reg : op.regsIn)
+      issue = std::max(issue, gpr_ready[reg]);
+    for (int reg : op.fregsIn)
+      issue = std::max(issue, fpr_ready[reg]);
+    for (int reg : op.regsOut)
+      gpr_ready[reg] = issue + cost.latency;
+    if (op.fregOut >= 0)
+      fpr_ready[op.fregOut] = issue + cost.latency;
+
+    op.num_cycles = issue + cost.throughput - cycle;
+    cycle = issue + cost.throughput;
+  }
+  block->m_stats->numCycles = cycle;
 }
 
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
@@ -783,6 +972,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     code[i].address = address;
     code[i].inst = inst;
     code[i].skip = false;
+    code[i].num_cycles = opinfo->numCycles;
     block->m_stats->numCycles += opinfo->numCycles;
     block->m_physical_addresses.insert(result.physical_address);
 
@@ -881,7 +1071,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     }
 
     code[i].branchIsIdleLoop =
-        code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
+        code[i].branchTo != UINT32_MAX && !code[i].skip && IsBusyWaitLoop(block, code, i);
 
     if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
     {
@@ -922,10 +1112,18 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   // wants flags, to be safe.
   bool wantsCR0 = true, wantsCR1 = true, wantsFPRF = true, wantsCA = true;
   BitSet32 fprInUse, gprInUse, gprDiscardable, fprDiscardable, fprInXmm;
+  BitSet8 crInUse(0xFF);
+  const bool eliminate_dead_cr = HasOption(OPTION_DEAD_CR_ELIMINATION) && !m_is_debugging_enabled;
   for (int i = block->m_num_instructions - 1; i >= 0; i--)
   {
     CodeOp& op = code[i];
 
+    // A compare has no effect other than setting its CR field, so if nothing reads the field
+    // before it's overwritten, the compare can be dropped.
+    if (eliminate_dead_cr && !op.skip && IsIntegerCompare(op) && !crInUse[op.inst.CRFD])
+      op.skip = true;
+    crInUse = (crInUse & ~GetCRFieldsOverwritten(op)) | GetCRFieldsRead(op);
+
     const bool opWantsCR0 = op.wantsCR0;
     const bool opWantsCR1 = op.wantsCR1;
     const bool opWantsFPRF = op.wantsFPRF;
@@ -968,6 +1166,10 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   // Forward scan, for flags that need the other direction for calculation.
   BitSet32 fprIsSingle, fprIsDuplicated, fprIsStoreSafe, gprDefined, gprBlockInputs;
   BitSet8 gqrUsed, gqrModified;
+  BitSet32 gprIsConstant;
+  std::array<u32, 32> gprConstants{};
+  const bool propagate_constants =
+      HasOption(OPTION_CONSTANT_PROPAGATION) && !m_is_debugging_enabled;
   for (u32 i = 0; i < block->m_num_instructions; i++)
   {
     CodeOp& op = code[i];
@@ -975,6 +1177,20 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     gprBlockInputs |= op.regsIn & ~gprDefined;
     gprDefined |= op.regsOut;
 
+    if (propagate_constants && !op.skip)
+    {
+      const std::optional<u32> value = EvaluateConstantOp(op, gprIsConstant, gprConstants);
+      gprIsConstant &= ~op.regsOut;
+      if (value)
+      {
+        const int reg = *op.regsOut.begin();
+        op.gprOutputIsConstant = true;
+        op.gprOutputConstant = *value;
+        gprIsConstant[reg] = true;
+        gprConstants[reg] = *value;
+      }
+    }
+
     op.fprIsSingle = fprIsSingle;
     op.fprIsDuplicated = fprIsDuplicated;
     op.fprIsStoreSafeBeforeInst = fprIsStoreSafe;
@@ -1063,6 +1279,10 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
   block->m_gqr_used = gqrUsed;
   block->m_gqr_modified = gqrModified;
   block->m_gpr_inputs = gprBlockInputs;
+
+  if (m_enable_precise_cycle_counting)
+    AssignPreciseCycles(block, code);
+
   return address;
 }
 
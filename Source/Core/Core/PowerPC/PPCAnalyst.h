@@ -47,6 +47,11 @@ struct CodeOp  // 16B
   bool canCauseException = false;
   bool skipLRStack = false;
   bool skip = false;  // followed BL-s for example
+  // how many cycles the instruction adds to the downcount
+  int num_cycles = 0;
+  // whether the value this instruction writes to its only GPR output is known at compile time
+  bool gprOutputIsConstant = false;
+  u32 gprOutputConstant = 0;
   // which registers are still needed after this instruction in this block
   BitSet32 fprInUse;
   BitSet32 gprInUse;
@@ -209,16 +214,25 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Track GPR values which are known at compile time through the block and mark integer
+    // instructions whose result only depends on them, so the JIT can fold them away.
+    OPTION_CONSTANT_PROPAGATION = (1 << 7),
+
+    // Skip integer compares whose CR field is overwritten before anything can read it.
+    OPTION_DEAD_CR_ELIMINATION = (1 << 8),
   };
 
   // Option setting/getting
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
+  u32 GetOptions() const { return m_options; }
   void SetDebuggingEnabled(bool enabled) { m_is_debugging_enabled = enabled; }
   void SetBranchFollowingEnabled(bool enabled) { m_enable_branch_following = enabled; }
   void SetFloatExceptionsEnabled(bool enabled) { m_enable_float_exceptions = enabled; }
   void SetDivByZeroExceptionsEnabled(bool enabled) { m_enable_div_by_zero_exceptions = enabled; }
+  void SetPreciseCycleCountingEnabled(bool enabled) { m_enable_precise_cycle_counting = enabled; }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size) const;
 
 private:
@@ -236,6 +250,7 @@ private:
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo,
                            u32 index) const;
   bool IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const;
+  static void AssignPreciseCycles(CodeBlock* block, CodeOp* code);
 
   // Options
   u32 m_options = 0;
@@ -244,6 +259,7 @@ private:
   bool m_enable_branch_following = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
+  bool m_enable_precise_cycle_counting = false;
 };
 
 void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db);
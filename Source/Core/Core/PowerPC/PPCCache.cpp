@@ -4,8 +4,14 @@
 #include "Core/PowerPC/PPCCache.h"
 
 #include <array>
+#include <bit>
+
+#if defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
 
 #include "Common/ChunkFile.h"
+#include "Common/Intrinsics.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/DolphinAnalytics.h"
@@ -85,6 +91,35 @@ constexpr std::array<u32, 128> s_way_from_plru = [] {
 
   return data;
 }();
+
+// Returns the valid way of the set which holds tag, or ICACHE_WAYS if there is none.
+u32 FindWay(const std::array<u32, ICACHE_WAYS>& set_tags, u32 set_valid, u32 tag)
+{
+  static_assert(ICACHE_WAYS == 8);
+#if defined(_M_X86_64)
+  const __m128i needle = _mm_set1_epi32(static_cast<s32>(tag));
+  const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set_tags.data()));
+  const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set_tags.data() + 4));
+  const u32 matches =
+      static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(low, needle)))) |
+      static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(high, needle)))) << 4;
+#elif defined(_M_ARM_64)
+  static constexpr u32 low_bits[] = {1, 2, 4, 8};
+  static constexpr u32 high_bits[] = {16, 32, 64, 128};
+  const uint32x4_t needle = vdupq_n_u32(tag);
+  const uint32x4_t low = vceqq_u32(vld1q_u32(set_tags.data()), needle);
+  const uint32x4_t high = vceqq_u32(vld1q_u32(set_tags.data() + 4), needle);
+  const u32 matches = vaddvq_u32(vandq_u32(low, vld1q_u32(low_bits))) |
+                      vaddvq_u32(vandq_u32(high, vld1q_u32(high_bits)));
+#else
+  u32 matches = 0;
+  for (u32 way = 0; way < ICACHE_WAYS; way++)
+    matches |= u32{set_tags[way] == tag} << way;
+#endif
+
+  const u32 valid_matches = matches & set_valid;
+  return valid_matches != 0 ? static_cast<u32>(std::countr_zero(valid_matches)) : ICACHE_WAYS;
+}
 }  // Anonymous namespace
 
 InstructionCache::~InstructionCache()
@@ -97,9 +132,6 @@ void InstructionCache::Reset()
 {
   valid.fill(0);
   plru.fill(0);
-  lookup_table.fill(0xFF);
-  lookup_table_ex.fill(0xFF);
-  lookup_table_vmem.fill(0xFF);
   JitInterface::ClearSafe();
 }
 
@@ -121,18 +153,6 @@ void InstructionCache::Invalidate(u32 addr)
 
   // Invalidates the whole set
   const u32 set = (addr >> 5) & 0x7f;
-  for (size_t i = 0; i < 8; i++)
-  {
-    if (valid[set] & (1U << i))
-    {
-      if (tags[set][i] & (ICACHE_VMEM_BIT >> 12))
-        lookup_table_vmem[((tags[set][i] << 7) | set) & 0xfffff] = 0xff;
-      else if (tags[set][i] & (ICACHE_EXRAM_BIT >> 12))
-        lookup_table_ex[((tags[set][i] << 7) | set) & 0x1fffff] = 0xff;
-      else
-        lookup_table[((tags[set][i] << 7) | set) & 0xfffff] = 0xff;
-    }
-  }
   valid[set] = 0;
   JitInterface::InvalidateICacheLine(addr);
 }
@@ -141,24 +161,11 @@ u32 InstructionCache::ReadInstruction(u32 addr)
 {
   if (!HID0.ICE || m_disable_icache)  // instruction cache is disabled
     return Memory::Read_U32(addr);
-  u32 set = (addr >> 5) & 0x7f;
-  u32 tag = addr >> 12;
-
-  u32 t;
-  if (addr & ICACHE_VMEM_BIT)
-  {
-    t = lookup_table_vmem[(addr >> 5) & 0xfffff];
-  }
-  else if (addr & ICACHE_EXRAM_BIT)
-  {
-    t = lookup_table_ex[(addr >> 5) & 0x1fffff];
-  }
-  else
-  {
-    t = lookup_table[(addr >> 5) & 0xfffff];
-  }
+  const u32 set = (addr >> 5) & 0x7f;
+  const u32 tag = addr >> 12;
 
-  if (t == 0xff)  // load to the cache
+  u32 t = FindWay(tags[set], valid[set], tag);
+  if (t == ICACHE_WAYS)  // load to the cache
   {
     if (HID0.ILOCK)  // instruction cache is locked
       return Memory::Read_U32(addr);
@@ -169,22 +176,6 @@ u32 InstructionCache::ReadInstruction(u32 addr)
       t = s_way_from_plru[plru[set]];
     // load
     Memory::CopyFromEmu(reinterpret_cast<u8*>(data[set][t].data()), (addr & ~0x1f), 32);
-    if (valid[set] & (1 << t))
-    {
-      if (tags[set][t] & (ICACHE_VMEM_BIT >> 12))
-        lookup_table_vmem[((tags[set][t] << 7) | set) & 0xfffff] = 0xff;
-      else if (tags[set][t] & (ICACHE_EXRAM_BIT >> 12))
-        lookup_table_ex[((tags[set][t] << 7) | set) & 0x1fffff] = 0xff;
-      else
-        lookup_table[((tags[set][t] << 7) | set) & 0xfffff] = 0xff;
-    }
-
-    if (addr & ICACHE_VMEM_BIT)
-      lookup_table_vmem[(addr >> 5) & 0xfffff] = t;
-    else if (addr & ICACHE_EXRAM_BIT)
-      lookup_table_ex[(addr >> 5) & 0x1fffff] = t;
-    else
-      lookup_table[(addr >> 5) & 0xfffff] = t;
     tags[set][t] = tag;
     valid[set] |= (1 << t);
   }
@@ -204,53 +195,10 @@ u32 InstructionCache::ReadInstruction(u32 addr)
 
 void InstructionCache::DoState(PointerWrap& p)
 {
-  if (p.IsReadMode())
-  {
-    // Clear valid parts of the lookup tables (this is done instead of using fill(0xff) to avoid
-    // loading the entire 4MB of tables into cache)
-    for (u32 set = 0; set < ICACHE_SETS; set++)
-    {
-      for (u32 way = 0; way < ICACHE_WAYS; way++)
-      {
-        if ((valid[set] & (1 << way)) != 0)
-        {
-          const u32 addr = (tags[set][way] << 12) | (set << 5);
-          if (addr & ICACHE_VMEM_BIT)
-            lookup_table_vmem[(addr >> 5) & 0xfffff] = 0xff;
-          else if (addr & ICACHE_EXRAM_BIT)
-            lookup_table_ex[(addr >> 5) & 0x1fffff] = 0xff;
-          else
-            lookup_table[(addr >> 5) & 0xfffff] = 0xff;
-        }
-      }
-    }
-  }
-
   p.DoArray(data);
   p.DoArray(tags);
   p.DoArray(plru);
   p.DoArray(valid);
-
-  if (p.IsReadMode())
-  {
-    // Recompute lookup tables
-    for (u32 set = 0; set < ICACHE_SETS; set++)
-    {
-      for (u32 way = 0; way < ICACHE_WAYS; way++)
-      {
-        if ((valid[set] & (1 << way)) != 0)
-        {
-          const u32 addr = (tags[set][way] << 12) | (set << 5);
-          if (addr & ICACHE_VMEM_BIT)
-            lookup_table_vmem[(addr >> 5) & 0xfffff] = way;
-          else if (addr & ICACHE_EXRAM_BIT)
-            lookup_table_ex[(addr >> 5) & 0x1fffff] = way;
-          else
-            lookup_table[(addr >> 5) & 0xfffff] = way;
-        }
-      }
-    }
-  }
 }
 
 void InstructionCache::RefreshConfig()
@@ -107,6 +107,32 @@ bool UsesFPU(UGeckoInstruction inst)
   return (info->flags & FL_USE_FPU) != 0;
 }
 
+CycleCost GetCycleCost(const GekkoOPInfo* info)
+{
+  // How much longer than numCycles the result of each type of instruction takes to be ready.
+  // Loads hit the L1 with a latency of two cycles, psq_l additionally has to dequantize, and the
+  // FPU has a three stage pipeline.
+  int extra_latency = 0;
+  switch (info->type)
+  {
+  case OpType::SPR:
+  case OpType::Load:
+  case OpType::LoadFP:
+    extra_latency = 1;
+    break;
+  case OpType::LoadPS:
+  case OpType::SingleFP:
+  case OpType::DoubleFP:
+  case OpType::PS:
+    extra_latency = 2;
+    break;
+  default:
+    break;
+  }
+
+  return {info->numCycles, info->numCycles + extra_latency};
+}
+
 #define OPLOG
 #define OP_TO_LOG "mtfsb0x"
 
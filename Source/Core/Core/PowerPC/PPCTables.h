@@ -115,11 +115,21 @@ extern size_t m_numInstructions;
 
 namespace PPCTables
 {
+struct CycleCost
+{
+  // Cycles until the next instruction can issue.
+  int throughput;
+  // Cycles until the result can be used by another instruction.
+  int latency;
+};
+
 GekkoOPInfo* GetOpInfo(UGeckoInstruction inst);
 Interpreter::Instruction GetInterpreterOp(UGeckoInstruction inst);
 
 bool IsValidInstruction(UGeckoInstruction inst);
 bool UsesFPU(UGeckoInstruction inst);
+// Cost model of the Gekko's execution units, used for precise cycle counting.
+CycleCost GetCycleCost(const GekkoOPInfo* info);
 
 void CountInstruction(UGeckoInstruction inst);
 void PrintInstructionRunCounts();
@@ -183,6 +183,7 @@ static void ResetRegisters()
 
   ppcState.reserve = false;
   ppcState.reserve_address = 0;
+  ppcState.ClearReturnStack();
 
   for (auto& v : ppcState.cr.fields)
   {
@@ -295,6 +296,7 @@ void ScheduleInvalidateCacheThreadSafe(u32 address)
 
 void Shutdown()
 {
+  LogHostPageCacheStats();
   InjectExternalCPUCore(nullptr);
   JitInterface::Shutdown();
   s_interpreter->Shutdown();
@@ -177,12 +177,33 @@ struct PowerPCState
   bool reserve;
   u32 reserve_address;
 
+  // Return addresses pushed by bl and checked by blr when Jit64 can't use the host stack for the
+  // BLR optimization, together with the host code which continues after the bl. Only the JIT uses
+  // this, so it isn't part of savestates.
+  struct ReturnStackEntry
+  {
+    u32 pc = 0xFFFFFFFF;
+    u32 msr_bits = 0;
+    const u8* code = nullptr;
+  };
+  static constexpr u32 RETURN_STACK_SIZE = 16;
+  static constexpr u32 RETURN_STACK_OFFSET_MASK = RETURN_STACK_SIZE * sizeof(ReturnStackEntry) - 1;
+  std::array<ReturnStackEntry, RETURN_STACK_SIZE> return_stack{};
+  // Byte offset of the top entry in return_stack.
+  u32 return_stack_offset = 0;
+
   void UpdateCR1()
   {
     cr.SetField(1, (fpscr.FX << 3) | (fpscr.FEX << 2) | (fpscr.VX << 1) | fpscr.OX);
   }
 
   void SetSR(u32 index, u32 value);
+
+  void ClearReturnStack()
+  {
+    return_stack.fill({});
+    return_stack_offset = 0;
+  }
 };
 
 #if _M_X86_64
@@ -0,0 +1,130 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/SamplingProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/HW/CPU.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+
+namespace SamplingProfiler
+{
+static std::thread s_thread;
+static Common::Event s_stop_event;
+static std::atomic<bool> s_running = false;
+
+static std::mutex s_samples_mutex;
+// Number of samples for each combination of PC (low 32 bits) and LR (high 32 bits).
+static std::unordered_map<u64, u64> s_samples;
+
+static void ThreadFunc(std::chrono::microseconds interval)
+{
+  Common::SetCurrentThreadName("Sampling Profiler");
+
+  while (!s_stop_event.WaitFor(interval))
+  {
+    if (CPU::GetState() != CPU::State::Running)
+      continue;
+
+    // The CPU thread writes these without synchronization. A sample that is slightly out of date
+    // doesn't matter, but each read has to be a whole value.
+    const u32 pc = std::atomic_ref(PowerPC::ppcState.pc).load(std::memory_order_relaxed);
+    const u32 lr = std::atomic_ref(LR).load(std::memory_order_relaxed);
+
+    std::lock_guard lk(s_samples_mutex);
+    ++s_samples[(u64{lr} << 32) | pc];
+  }
+}
+
+void Start(std::chrono::microseconds interval)
+{
+  Stop();
+
+  {
+    std::lock_guard lk(s_samples_mutex);
+    s_samples.clear();
+  }
+
+  s_stop_event.Reset();
+  s_thread = std::thread(ThreadFunc, interval);
+  s_running = true;
+}
+
+void Stop()
+{
+  if (!s_running)
+    return;
+
+  s_stop_event.Set();
+  s_thread.join();
+  s_running = false;
+}
+
+bool IsRunning()
+{
+  return s_running;
+}
+
+static std::string GetFunctionName(u32 address)
+{
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  if (!symbol)
+    return fmt::format("{:08x}", address);
+
+  // Semicolons separate the frames in the folded format.
+  std::string name = symbol->function_name.empty() ? symbol->name : symbol->function_name;
+  std::replace(name.begin(), name.end(), ';', ':');
+  return name;
+}
+
+bool WriteFoldedStacks(const std::string& filename)
+{
+  std::map<std::string, u64> stacks;
+
+  // The symbol map is only safe to use on the CPU thread.
+  Core::RunAsCPUThread([&stacks] {
+    std::lock_guard lk(s_samples_mutex);
+    for (const auto& [key, count] : s_samples)
+    {
+      const std::string function = GetFunctionName(static_cast<u32>(key));
+      const std::string caller = GetFunctionName(static_cast<u32>(key >> 32));
+      if (caller == function)
+        stacks[function] += count;
+      else
+        stacks[caller + ';' + function] += count;
+    }
+  });
+
+  File::IOFile f(filename, "w");
+  if (!f)
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open {}", filename);
+    return false;
+  }
+
+  for (const auto& [stack, count] : stacks)
+  {
+    if (!f.WriteString(fmt::format("{} {}\n", stack, count)))
+      return false;
+  }
+
+  return true;
+}
+}  // namespace SamplingProfiler
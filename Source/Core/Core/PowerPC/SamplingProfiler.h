@@ -0,0 +1,27 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+// Statistical profiler for guest code. A separate thread periodically records the guest PC and LR
+// while the emulated CPU is running, so unlike block profiling, it needs no changes to the code
+// the JIT generates and costs the CPU thread nothing.
+//
+// With the JIT, the recorded PC is the start of the block that is running, since the PC is only
+// written when a block exits.
+namespace SamplingProfiler
+{
+void Start(std::chrono::microseconds interval = std::chrono::milliseconds(1));
+// Stops sampling. The samples are kept until the next Start.
+void Stop();
+bool IsRunning();
+
+// Writes the samples, aggregated by function using the symbol map, in the folded stack format
+// used by flamegraph.pl and most other flame graph tools: one "caller;function count" per line.
+// The caller is the function that LR points into, so it can be inaccurate for functions that
+// call others and return through a saved LR.
+bool WriteFoldedStacks(const std::string& filename);
+}  // namespace SamplingProfiler
@@ -0,0 +1,321 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Rewind.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <zstd.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Logging/Log.h"
+#include "Common/WorkQueueThread.h"
+
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/NetPlayProto.h"
+#include "Core/State.h"
+
+#include "VideoCommon/OnScreenDisplay.h"
+
+namespace Rewind
+{
+// Every KEYFRAME_INTERVAL-th snapshot is stored in full. The ones in between are stored as deltas
+// against the last full one, which keeps them small without making rewinding too slow.
+constexpr u32 KEYFRAME_INTERVAL = 30;
+
+// Snapshots that have been taken but not compressed yet are full size, so only allow a couple of
+// them at a time. Captures are skipped if compression can't keep up.
+constexpr u32 MAX_QUEUED_SNAPSHOTS = 2;
+
+constexpr int COMPRESSION_LEVEL = 1;
+
+namespace
+{
+struct Entry
+{
+  bool keyframe;
+  std::vector<u8> compressed;
+};
+
+struct QueuedSnapshot
+{
+  std::unique_ptr<State::Snapshot> snapshot;
+  u64 generation;
+};
+}  // namespace
+
+static std::atomic<bool> s_enabled{false};
+static std::atomic<u32> s_interval{30};
+static std::atomic<size_t> s_memory_budget{0};
+static std::optional<size_t> s_config_changed_callback_id;
+
+static std::atomic<u32> s_fields_since_snapshot{0};
+static std::atomic<bool> s_capture_pending{false};
+static std::atomic<u32> s_queued_snapshots{0};
+
+// Guards everything below.
+static std::mutex s_mutex;
+static std::deque<Entry> s_entries;
+static size_t s_total_size = 0;
+static u32 s_deltas_since_keyframe = 0;
+// Uncompressed copy of the newest keyframe in s_entries.
+static State::Snapshot s_keyframe;
+// Bumped whenever the stored snapshots stop matching the emulated timeline, so that snapshots
+// that were still queued at that point get dropped.
+static u64 s_generation = 0;
+static std::vector<std::unique_ptr<State::Snapshot>> s_free_snapshots;
+
+static Common::WorkQueueThread<QueuedSnapshot> s_worker;
+
+static void RefreshConfig()
+{
+  s_enabled.store(Config::Get(Config::MAIN_REWIND_ENABLE), std::memory_order_relaxed);
+  s_interval.store(static_cast<u32>(std::max(Config::Get(Config::MAIN_REWIND_INTERVAL), 1)),
+                   std::memory_order_relaxed);
+  const size_t memory_mb =
+      static_cast<size_t>(std::max(Config::Get(Config::MAIN_REWIND_MEMORY_MB), 1));
+  s_memory_budget.store(memory_mb << 20, std::memory_order_relaxed);
+}
+
+static std::vector<u8> Compress(const std::vector<u8>& data)
+{
+  std::vector<u8> compressed(ZSTD_compressBound(data.size()));
+  const size_t size = ZSTD_compress(compressed.data(), compressed.size(), data.data(),
+                                    data.size(), COMPRESSION_LEVEL);
+  if (ZSTD_isError(size))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress rewind snapshot: {}", ZSTD_getErrorName(size));
+    return {};
+  }
+
+  compressed.resize(size);
+  compressed.shrink_to_fit();
+  return compressed;
+}
+
+static bool Decompress(const std::vector<u8>& compressed, std::vector<u8>& data)
+{
+  const unsigned long long size = ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+  if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN)
+    return false;
+
+  data.resize(size);
+  return ZSTD_decompress(data.data(), data.size(), compressed.data(), compressed.size()) == size;
+}
+
+// Must be called with s_mutex held.
+static bool DecodeEntry(const Entry& entry, State::Snapshot& snapshot)
+{
+  std::vector<u8> delta;
+  if (!Decompress(entry.compressed, delta))
+    return false;
+
+  return State::DecodeSnapshotDelta(entry.keyframe ? State::Snapshot{} : s_keyframe, delta,
+                                    snapshot);
+}
+
+static void ClearLocked()
+{
+  s_entries.clear();
+  s_total_size = 0;
+  s_deltas_since_keyframe = 0;
+  s_keyframe = {};
+  ++s_generation;
+}
+
+static void ProcessSnapshot(QueuedSnapshot queued)
+{
+  s_queued_snapshots.fetch_sub(1, std::memory_order_relaxed);
+
+  std::lock_guard lk(s_mutex);
+
+  if (queued.generation == s_generation)
+  {
+    const bool keyframe =
+        s_entries.empty() || s_deltas_since_keyframe + 1 >= KEYFRAME_INTERVAL;
+
+    std::vector<u8> delta;
+    if (keyframe)
+    {
+      delta = State::EncodeSnapshotDelta({}, *queued.snapshot);
+      std::swap(s_keyframe, *queued.snapshot);
+      s_deltas_since_keyframe = 0;
+    }
+    else
+    {
+      delta = State::EncodeSnapshotDelta(s_keyframe, *queued.snapshot);
+      ++s_deltas_since_keyframe;
+    }
+
+    Entry entry{keyframe, Compress(delta)};
+    if (!entry.compressed.empty())
+    {
+      s_total_size += entry.compressed.size();
+      s_entries.push_back(std::move(entry));
+    }
+    else
+    {
+      // Deltas after a lost keyframe would be decoded against the wrong base.
+      ClearLocked();
+    }
+
+    // Deltas can't be decoded without the keyframe before them, so drop whole groups.
+    const size_t budget = s_memory_budget.load(std::memory_order_relaxed);
+    while (s_total_size > budget && s_entries.size() > 1)
+    {
+      do
+      {
+        s_total_size -= s_entries.front().compressed.size();
+        s_entries.pop_front();
+      } while (!s_entries.empty() && !s_entries.front().keyframe);
+    }
+    if (s_entries.empty())
+      ClearLocked();
+  }
+
+  if (s_free_snapshots.size() < MAX_QUEUED_SNAPSHOTS)
+    s_free_snapshots.push_back(std::move(queued.snapshot));
+}
+
+static void CaptureSnapshot()
+{
+  QueuedSnapshot queued;
+  {
+    std::lock_guard lk(s_mutex);
+    queued.generation = s_generation;
+    if (!s_free_snapshots.empty())
+    {
+      queued.snapshot = std::move(s_free_snapshots.back());
+      s_free_snapshots.pop_back();
+    }
+  }
+  if (!queued.snapshot)
+    queued.snapshot = std::make_unique<State::Snapshot>();
+
+  State::SaveSnapshot(*queued.snapshot);
+
+  s_queued_snapshots.fetch_add(1, std::memory_order_relaxed);
+  s_worker.EmplaceItem(std::move(queued));
+}
+
+void Init()
+{
+  s_config_changed_callback_id = Config::AddConfigChangedCallback(RefreshConfig);
+  RefreshConfig();
+
+  s_fields_since_snapshot = 0;
+  s_capture_pending = false;
+  s_queued_snapshots = 0;
+  s_worker.Reset(ProcessSnapshot);
+}
+
+void Shutdown()
+{
+  s_worker.Cancel();
+  Clear();
+
+  std::lock_guard lk(s_mutex);
+  s_free_snapshots.clear();
+
+  if (s_config_changed_callback_id)
+  {
+    Config::RemoveConfigChangedCallback(*s_config_changed_callback_id);
+    s_config_changed_callback_id.reset();
+  }
+}
+
+void OnNewField()
+{
+  if (!s_enabled.load(std::memory_order_relaxed))
+    return;
+
+  if (s_fields_since_snapshot.fetch_add(1, std::memory_order_relaxed) + 1 <
+      s_interval.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  if (s_queued_snapshots.load(std::memory_order_relaxed) >= MAX_QUEUED_SNAPSHOTS ||
+      s_capture_pending.exchange(true))
+  {
+    return;
+  }
+
+  s_fields_since_snapshot = 0;
+
+  // Savestates have to be taken while the CPU thread is paused between slices, so do it from the
+  // host thread like a regular savestate.
+  Core::QueueHostJob([] {
+    CaptureSnapshot();
+    s_capture_pending = false;
+  });
+}
+
+void StepBack()
+{
+  if (NetPlay::IsNetPlayRunning())
+  {
+    OSD::AddMessage("Rewinding is disabled in Netplay to prevent desyncs");
+    return;
+  }
+
+  State::Snapshot snapshot;
+  {
+    std::lock_guard lk(s_mutex);
+    if (s_entries.empty())
+    {
+      OSD::AddMessage("Nothing to rewind to");
+      return;
+    }
+
+    Entry entry = std::move(s_entries.back());
+    s_entries.pop_back();
+    s_total_size -= entry.compressed.size();
+
+    const bool success = DecodeEntry(entry, snapshot);
+
+    if (!entry.keyframe)
+    {
+      --s_deltas_since_keyframe;
+    }
+    else
+    {
+      // The deltas before this keyframe were taken against the previous one.
+      const auto it = std::find_if(s_entries.rbegin(), s_entries.rend(),
+                                   [](const Entry& e) { return e.keyframe; });
+      if (it == s_entries.rend() || !DecodeEntry(*it, s_keyframe))
+        ClearLocked();
+      else
+        s_deltas_since_keyframe = static_cast<u32>(it - s_entries.rbegin());
+    }
+
+    // Anything captured after this point in time doesn't belong in the ring anymore.
+    ++s_generation;
+
+    if (!success)
+    {
+      ClearLocked();
+      OSD::AddMessage("Failed to decode rewind snapshot", OSD::Duration::NORMAL, OSD::Color::RED);
+      return;
+    }
+  }
+
+  s_fields_since_snapshot = 0;
+  State::LoadSnapshot(snapshot);
+}
+
+void Clear()
+{
+  std::lock_guard lk(s_mutex);
+  ClearLocked();
+}
+}  // namespace Rewind
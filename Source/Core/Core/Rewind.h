@@ -0,0 +1,26 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Rewinding through recent gameplay, built on in-memory savestates.
+//
+// While enabled, a snapshot of the emulated state is taken every few fields. Snapshots are stored
+// compressed, as deltas against the most recent full one, in a ring that drops the oldest ones
+// once it goes over its memory budget.
+
+#pragma once
+
+namespace Rewind
+{
+void Init();
+void Shutdown();
+
+// Called from the CPU thread at every emulated field boundary.
+void OnNewField();
+
+// Loads the most recent snapshot and drops it, so that calling this repeatedly keeps going
+// further back. Must be called from the host thread.
+void StepBack();
+
+// Drops all snapshots.
+void Clear();
+}  // namespace Rewind
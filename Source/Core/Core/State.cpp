@@ -3,8 +3,12 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -16,18 +20,22 @@
 #include <fmt/format.h>
 
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 #include "Common/Version.h"
 #include "Common/WorkQueueThread.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -46,22 +54,31 @@
 
 namespace State
 {
-#if defined(__LZO_STRICT_16BIT)
-static const u32 IN_LEN = 8 * 1024u;
-#elif defined(LZO_ARCH_I086) && !defined(LZO_HAVE_MM_HUGE_ARRAY)
-static const u32 IN_LEN = 60 * 1024u;
-#else
-static const u32 IN_LEN = 128 * 1024u;
-#endif
+constexpr u16 FILE_VERSION_LEGACY = 0;
+constexpr u16 FILE_VERSION_CHUNKED = 1;
 
-static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
+// Follows StateHeader in FILE_VERSION_CHUNKED states. It is followed in turn by the compressed
+// size of every chunk (as u32) and then the chunks themselves. Chunks are compressed separately so
+// that they can be compressed and decompressed in parallel.
+struct ChunkedStateHeader
+{
+  CompressionType compression;
+  u32 chunk_size;
+  u64 uncompressed_size;
+  u32 chunk_count;
+  u32 reserved;
+};
+static_assert(sizeof(ChunkedStateHeader) == 24);
 
-static unsigned char __LZO_MMODEL out[OUT_LEN];
+constexpr u32 CHUNK_SIZE = 1024 * 1024;
+constexpr int ZSTD_COMPRESSION_LEVEL = 3;
 
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
+constexpr u32 LEGACY_LZO_CHUNK_SIZE = 128 * 1024;
 
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+static constexpr size_t GetLZOCompressBound(size_t size)
+{
+  return size + (size / 16) + 64 + 3;
+}
 
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
@@ -71,9 +88,12 @@ static std::mutex s_undo_load_buffer_mutex;
 
 static std::mutex s_load_or_save_in_progress_mutex;
 
-struct CompressAndDumpState_args
+struct DumpState_args
 {
-  std::vector<u8> buffer_vector;
+  // One entry per chunk, or the whole state as a single entry if it isn't compressed.
+  std::vector<std::vector<u8>> chunks;
+  size_t uncompressed_size;
+  CompressionType compression;
   std::string filename;
   std::shared_ptr<Common::Event> state_write_done_event;
 };
@@ -82,8 +102,8 @@ struct CompressAndDumpState_args
 // threads.
 static std::mutex s_save_thread_mutex;
 
-// Queue for compressing and writing savestates to disk.
-static Common::WorkQueueThread<CompressAndDumpState_args> s_save_thread;
+// Queue for writing savestates to disk.
+static Common::WorkQueueThread<DumpState_args> s_save_thread;
 
 // Keeps track of savestate writes that are currently happening, so we don't load a state while
 // another one is still saving. This is particularly important so if you save to a slot and then
@@ -94,7 +114,7 @@ static size_t s_state_writes_in_queue;
 static std::condition_variable s_state_write_queue_is_empty;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 154;  // Last changed in PR 11177
+constexpr u32 STATE_VERSION = 155;  // Last changed in PR 11177
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -126,6 +146,160 @@ void EnableCompression(bool compression)
   s_use_compression = compression;
 }
 
+// Splits [0, count) into one range per hardware thread and calls func on each of them in parallel.
+static void ParallelForRanges(size_t count, const std::function<void(size_t, size_t)>& func)
+{
+  const size_t threads =
+      std::min<size_t>(count, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
+
+  std::vector<std::future<void>> futures(threads);
+  for (size_t i = 0; i < threads; ++i)
+  {
+    futures[i] =
+        std::async(std::launch::async, func, i * count / threads, (i + 1) * count / threads);
+  }
+
+  for (std::future<void>& future : futures)
+    future.get();
+}
+
+static bool CompressChunk(CompressionType compression, const u8* data, size_t size,
+                          std::vector<u8>& out, std::vector<lzo_align_t>& lzo_wrkmem)
+{
+  switch (compression)
+  {
+  case CompressionType::LZO:
+  {
+    if (lzo_wrkmem.empty())
+      lzo_wrkmem.resize((LZO1X_1_MEM_COMPRESS + sizeof(lzo_align_t) - 1) / sizeof(lzo_align_t));
+
+    out.resize(GetLZOCompressBound(size));
+    lzo_uint out_len = 0;
+    if (lzo1x_1_compress(data, size, out.data(), &out_len, lzo_wrkmem.data()) != LZO_E_OK)
+      return false;
+
+    out.resize(out_len);
+    return true;
+  }
+  case CompressionType::Zstd:
+  {
+    out.resize(ZSTD_compressBound(size));
+    const size_t out_len =
+        ZSTD_compress(out.data(), out.size(), data, size, ZSTD_COMPRESSION_LEVEL);
+    if (ZSTD_isError(out_len))
+      return false;
+
+    out.resize(out_len);
+    return true;
+  }
+  default:
+    return false;
+  }
+}
+
+static bool DecompressChunk(CompressionType compression, const u8* data, size_t size, u8* out,
+                            size_t out_size)
+{
+  switch (compression)
+  {
+  case CompressionType::None:
+    if (size != out_size)
+      return false;
+    std::memcpy(out, data, size);
+    return true;
+  case CompressionType::LZO:
+  {
+    lzo_uint out_len = out_size;
+    return lzo1x_decompress_safe(data, size, out, &out_len, nullptr) == LZO_E_OK &&
+           out_len == out_size;
+  }
+  case CompressionType::Zstd:
+    return ZSTD_decompress(out, out_size, data, size) == out_size;
+  default:
+    return false;
+  }
+}
+
+// A serialized state whose stable arrays (see PointerWrap::EnableGathering) are still in place
+// instead of in the buffer.
+struct GatheredState
+{
+  std::unique_ptr<u8[]> buffer;
+  size_t size = 0;
+  std::vector<PointerWrap::GatheredSpan> spans;
+};
+
+// Returns the first span that ends after offset.
+static auto FindGatheredSpan(const GatheredState& state, size_t offset)
+{
+  return std::upper_bound(state.spans.begin(), state.spans.end(), offset,
+                          [](size_t value, const PointerWrap::GatheredSpan& span) {
+                            return value < span.offset + span.size;
+                          });
+}
+
+// Returns a pointer to [begin, end) of the state if it is contiguous in memory, or nullptr if it
+// is split between the buffer and spans.
+static const u8* GetGatheredData(const GatheredState& state, size_t begin, size_t end)
+{
+  const auto it = FindGatheredSpan(state, begin);
+  if (it == state.spans.end() || it->offset >= end)
+    return state.buffer.get() + begin;
+  if (it->offset <= begin && it->offset + it->size >= end)
+    return it->data + (begin - it->offset);
+  return nullptr;
+}
+
+static void CopyGatheredData(const GatheredState& state, size_t begin, size_t end, u8* out)
+{
+  for (auto it = FindGatheredSpan(state, begin); begin < end; ++it)
+  {
+    const size_t span_begin = it == state.spans.end() ? end : std::clamp(it->offset, begin, end);
+    std::memcpy(out, state.buffer.get() + begin, span_begin - begin);
+    out += span_begin - begin;
+    begin = span_begin;
+    if (begin == end)
+      break;
+
+    const size_t span_end = std::min(it->offset + it->size, end);
+    std::memcpy(out, it->data + (begin - it->offset), span_end - begin);
+    out += span_end - begin;
+    begin = span_end;
+  }
+}
+
+// Chunks that lie entirely within one span or entirely within the buffer are compressed from where
+// they are. Only the few that straddle a boundary get copied, and only into a chunk-sized buffer.
+static bool CompressGatheredState(const GatheredState& state, CompressionType compression,
+                                  std::vector<std::vector<u8>>& chunks)
+{
+  chunks.resize((state.size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+  std::atomic<bool> success = true;
+  ParallelForRanges(chunks.size(), [&](size_t start, size_t end) {
+    std::vector<lzo_align_t> lzo_wrkmem;
+    std::vector<u8> scratch;
+    for (size_t i = start; i < end; ++i)
+    {
+      const size_t chunk_begin = i * CHUNK_SIZE;
+      const size_t chunk_end = std::min<size_t>(chunk_begin + CHUNK_SIZE, state.size);
+
+      const u8* data = GetGatheredData(state, chunk_begin, chunk_end);
+      if (!data)
+      {
+        scratch.resize(chunk_end - chunk_begin);
+        CopyGatheredData(state, chunk_begin, chunk_end, scratch.data());
+        data = scratch.data();
+      }
+
+      if (!CompressChunk(compression, data, chunk_end - chunk_begin, chunks[i], lzo_wrkmem))
+        success = false;
+    }
+  });
+
+  return success;
+}
+
 // Returns true if state version matches current Dolphin state version, false otherwise.
 static bool DoStateVersion(PointerWrap& p, std::string* version_created_by)
 {
@@ -166,8 +340,14 @@ static bool DoStateVersion(PointerWrap& p, std::string* version_created_by)
   return true;
 }
 
-static void DoState(PointerWrap& p)
+// begin_section is called at the start of each top-level section after the first one.
+static void DoState(PointerWrap& p, const std::function<void()>& begin_section = {})
 {
+  const auto section = [&] {
+    if (begin_section)
+      begin_section();
+  };
+
   std::string version_created_by;
   if (!DoStateVersion(p, &version_created_by))
   {
@@ -209,32 +389,50 @@ static void DoState(PointerWrap& p)
     p.SetMeasureMode();
     return;
   }
+  section();
 
   // Movie must be done before the video backend, because the window is redrawn in the video backend
   // state load, and the frame number must be up-to-date.
   Movie::DoState(p);
   p.DoMarker("Movie");
+  section();
 
   // Begin with video backend, so that it gets a chance to clear its caches and writeback modified
   // things to RAM
   g_video_backend->DoState(p);
   p.DoMarker("video_backend");
+  section();
 
   PowerPC::DoState(p);
   p.DoMarker("PowerPC");
+  section();
   // CoreTiming needs to be restored before restoring Hardware because
   // the controller code might need to schedule an event if the controller has changed.
   CoreTiming::DoState(p);
   p.DoMarker("CoreTiming");
+  section();
   HW::DoState(p);
   p.DoMarker("HW");
+  section();
   if (SConfig::GetInstance().bWii)
     Wiimote::DoState(p);
   p.DoMarker("Wiimote");
+  section();
   Gecko::DoState(p);
   p.DoMarker("Gecko");
 }
 
+static void LoadFromBufferUnchecked(std::vector<u8>& buffer)
+{
+  Core::RunOnCPUThread(
+      [&] {
+        u8* ptr = buffer.data();
+        PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+        DoState(p);
+      },
+      true);
+}
+
 void LoadFromBuffer(std::vector<u8>& buffer)
 {
   if (NetPlay::IsNetPlayRunning())
@@ -243,31 +441,179 @@ void LoadFromBuffer(std::vector<u8>& buffer)
     return;
   }
 
+  LoadFromBufferUnchecked(buffer);
+}
+
+static void SaveToBuffer(std::vector<u8>& buffer, std::vector<u32>* section_offsets)
+{
   Core::RunOnCPUThread(
       [&] {
-        u8* ptr = buffer.data();
-        PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-        DoState(p);
+        // Serialize straight into the buffer's existing storage. When a buffer is reused for
+        // repeated saves it is usually big enough already, and the state only needs to be
+        // serialized once. Otherwise, PointerWrap switches to measuring when it runs out of room,
+        // and we go again with the measured size.
+        buffer.resize(buffer.capacity());
+        while (true)
+        {
+          u8* ptr = buffer.data();
+          if (section_offsets)
+            section_offsets->assign(1, 0);
+
+          PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+          DoState(p, [&] {
+            if (section_offsets)
+              section_offsets->push_back(static_cast<u32>(ptr - buffer.data()));
+          });
+
+          const size_t buffer_size = static_cast<size_t>(ptr - buffer.data());
+          buffer.resize(buffer_size);
+          if (!p.IsMeasureMode())
+            break;
+        }
       },
       true);
 }
 
 void SaveToBuffer(std::vector<u8>& buffer)
 {
-  Core::RunOnCPUThread(
-      [&] {
-        u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  SaveToBuffer(buffer, nullptr);
+}
 
-        DoState(p_measure);
-        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-        buffer.resize(buffer_size);
+void SaveSnapshot(Snapshot& snapshot)
+{
+  SaveToBuffer(snapshot.data, &snapshot.section_offsets);
+}
 
-        ptr = buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(p);
-      },
-      true);
+void LoadSnapshot(Snapshot& snapshot)
+{
+  LoadFromBufferUnchecked(snapshot.data);
+}
+
+constexpr u32 SNAPSHOT_DELTA_PAGE_SIZE = 4096;
+
+static std::pair<u32, u32> GetSnapshotSection(const Snapshot& snapshot, size_t index)
+{
+  if (index >= snapshot.section_offsets.size())
+    return {0, 0};
+
+  const u32 begin = snapshot.section_offsets[index];
+  const u32 end = index + 1 < snapshot.section_offsets.size() ?
+                      snapshot.section_offsets[index + 1] :
+                      static_cast<u32>(snapshot.data.size());
+  return {begin, end};
+}
+
+template <typename T>
+static void AppendToDelta(std::vector<u8>& delta, const T& value)
+{
+  const size_t offset = delta.size();
+  delta.resize(offset + sizeof(T));
+  std::memcpy(delta.data() + offset, &value, sizeof(T));
+}
+
+std::vector<u8> EncodeSnapshotDelta(const Snapshot& base, const Snapshot& snapshot)
+{
+  std::vector<u8> delta;
+  AppendToDelta(delta, static_cast<u32>(base.data.size()));
+  AppendToDelta(delta, static_cast<u32>(base.section_offsets.size()));
+  AppendToDelta(delta, static_cast<u32>(snapshot.data.size()));
+  AppendToDelta(delta, static_cast<u32>(snapshot.section_offsets.size()));
+  for (const u32 offset : snapshot.section_offsets)
+    AppendToDelta(delta, offset);
+
+  for (size_t i = 0; i < snapshot.section_offsets.size(); ++i)
+  {
+    const auto [begin, end] = GetSnapshotSection(snapshot, i);
+    const auto [base_begin, base_end] = GetSnapshotSection(base, i);
+    const u32 size = end - begin;
+    const u32 base_size = base_end - base_begin;
+
+    const size_t count_offset = delta.size();
+    u32 changed_pages = 0;
+    AppendToDelta(delta, changed_pages);
+
+    for (u32 page_offset = 0; page_offset < size; page_offset += SNAPSHOT_DELTA_PAGE_SIZE)
+    {
+      const u32 length = std::min(SNAPSHOT_DELTA_PAGE_SIZE, size - page_offset);
+      const u8* page = snapshot.data.data() + begin + page_offset;
+      if (page_offset + length <= base_size &&
+          std::memcmp(page, base.data.data() + base_begin + page_offset, length) == 0)
+      {
+        continue;
+      }
+
+      AppendToDelta(delta, page_offset / SNAPSHOT_DELTA_PAGE_SIZE);
+      delta.insert(delta.end(), page, page + length);
+      ++changed_pages;
+    }
+
+    std::memcpy(delta.data() + count_offset, &changed_pages, sizeof(changed_pages));
+  }
+
+  return delta;
+}
+
+bool DecodeSnapshotDelta(const Snapshot& base, const std::vector<u8>& delta, Snapshot& snapshot)
+{
+  size_t position = 0;
+  const auto read = [&](u32* value) {
+    if (delta.size() - position < sizeof(u32))
+      return false;
+    std::memcpy(value, delta.data() + position, sizeof(u32));
+    position += sizeof(u32);
+    return true;
+  };
+
+  u32 base_size, base_section_count, size, section_count;
+  if (!read(&base_size) || !read(&base_section_count) || !read(&size) || !read(&section_count))
+    return false;
+  if (base_size != base.data.size() || base_section_count != base.section_offsets.size())
+    return false;
+
+  snapshot.data.resize(size);
+  snapshot.section_offsets.resize(section_count);
+  for (u32& offset : snapshot.section_offsets)
+  {
+    if (!read(&offset) || offset > size)
+      return false;
+  }
+  if (!std::is_sorted(snapshot.section_offsets.begin(), snapshot.section_offsets.end()))
+    return false;
+
+  for (size_t i = 0; i < snapshot.section_offsets.size(); ++i)
+  {
+    const auto [begin, end] = GetSnapshotSection(snapshot, i);
+    const auto [base_begin, base_end] = GetSnapshotSection(base, i);
+    const u32 section_size = end - begin;
+
+    std::memcpy(snapshot.data.data() + begin, base.data.data() + base_begin,
+                std::min(section_size, base_end - base_begin));
+
+    u32 changed_pages;
+    if (!read(&changed_pages))
+      return false;
+
+    for (u32 j = 0; j < changed_pages; ++j)
+    {
+      u32 page_index;
+      if (!read(&page_index))
+        return false;
+
+      const u64 page_offset = static_cast<u64>(page_index) * SNAPSHOT_DELTA_PAGE_SIZE;
+      if (page_offset >= section_size)
+        return false;
+
+      const u32 length =
+          std::min<u32>(SNAPSHOT_DELTA_PAGE_SIZE, section_size - static_cast<u32>(page_offset));
+      if (delta.size() - position < length)
+        return false;
+
+      std::memcpy(snapshot.data.data() + begin + page_offset, delta.data() + position, length);
+      position += length;
+    }
+  }
+
+  return position == delta.size();
 }
 
 // return state number not in map
@@ -346,10 +692,9 @@ static std::map<double, int> GetSavedStates()
   return m;
 }
 
-static void CompressAndDumpState(CompressAndDumpState_args& save_args)
+static void DumpState(DumpState_args& save_args)
 {
-  const u8* const buffer_data = save_args.buffer_vector.data();
-  const size_t buffer_size = save_args.buffer_vector.size();
+  const size_t buffer_size = save_args.uncompressed_size;
   const std::string& filename = save_args.filename;
 
   // Find free temporary filename.
@@ -363,6 +708,21 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
     ++temp_counter;
   } while (File::Exists(temp_filename));
 
+  ChunkedStateHeader chunked_header{};
+  chunked_header.compression = save_args.compression;
+  chunked_header.chunk_size = CHUNK_SIZE;
+  chunked_header.uncompressed_size = buffer_size;
+  chunked_header.chunk_count = static_cast<u32>((buffer_size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+  std::vector<u32> chunk_sizes(chunked_header.chunk_count);
+  for (size_t i = 0; i < chunk_sizes.size(); ++i)
+  {
+    chunk_sizes[i] =
+        chunked_header.compression == CompressionType::None ?
+            static_cast<u32>(std::min<size_t>(CHUNK_SIZE, buffer_size - i * CHUNK_SIZE)) :
+            static_cast<u32>(save_args.chunks[i].size());
+  }
+
   File::IOFile f(temp_filename, "wb");
   if (!f)
   {
@@ -373,45 +733,17 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
   // Setting up the header
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.gameID, std::size(header.gameID));
-  header.size = s_use_compression ? (u32)buffer_size : 0;
+  header.file_version = FILE_VERSION_CHUNKED;
+  // Left at 0 so that versions which only know the legacy format read the state as uncompressed
+  // and then reject it because of its version, instead of failing to decompress it.
+  header.size = 0;
   header.time = GetSystemTimeAsDouble();
 
   f.WriteArray(&header, 1);
-
-  if (header.size != 0)  // non-zero header size means the state is compressed
-  {
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertFmtT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
-    }
-  }
-  else  // uncompressed
-  {
-    f.WriteBytes(buffer_data, buffer_size);
-  }
+  f.WriteArray(&chunked_header, 1);
+  f.WriteArray(chunk_sizes.data(), chunk_sizes.size());
+  for (const std::vector<u8>& chunk : save_args.chunks)
+    f.WriteBytes(chunk.data(), chunk.size());
 
   const std::string last_state_filename = File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav";
   const std::string last_state_dtmname = last_state_filename + ".dtm";
@@ -474,22 +806,51 @@ void SaveAs(const std::string& filename, bool wait)
         DoState(p_measure);
         const size_t buffer_size = reinterpret_cast<size_t>(ptr);
 
+        DumpState_args save_args;
+        save_args.uncompressed_size = buffer_size;
+        save_args.compression = s_use_compression ? Config::Get(Config::MAIN_STATE_COMPRESSION) :
+                                                    CompressionType::None;
+        save_args.filename = filename;
+
         // Then actually do the write.
-        std::vector<u8> current_buffer;
-        current_buffer.resize(buffer_size);
-        ptr = current_buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-        DoState(p);
+        bool success;
+        if (save_args.compression == CompressionType::None)
+        {
+          std::vector<u8> current_buffer(buffer_size);
+          ptr = current_buffer.data();
+          PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+          DoState(p);
+          success = p.IsWriteMode();
+          save_args.chunks.push_back(std::move(current_buffer));
+        }
+        else
+        {
+          // Emulated RAM and the like are compressed straight from where they live rather than
+          // being copied into the buffer first. This has to be done before the CPU thread resumes.
+          // Parts of the buffer that are left for gathered spans are never touched, so they don't
+          // take up memory either.
+          GatheredState state;
+          state.buffer.reset(new u8[buffer_size]);
+          state.size = buffer_size;
+          ptr = state.buffer.get();
+          PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+          p.EnableGathering(&state.spans);
+          DoState(p);
+          success = p.IsWriteMode();
+
+          if (success && !CompressGatheredState(state, save_args.compression, save_args.chunks))
+          {
+            ERROR_LOG_FMT(CORE, "Failed to compress savestate");
+            success = false;
+          }
+        }
 
-        if (p.IsWriteMode())
+        if (success)
         {
           Core::DisplayMessage("Saving State...", 1000);
 
           std::shared_ptr<Common::Event> sync_event;
 
-          CompressAndDumpState_args save_args;
-          save_args.buffer_vector = std::move(current_buffer);
-          save_args.filename = filename;
           if (wait)
           {
             sync_event = std::make_shared<Common::Event>();
@@ -548,6 +909,64 @@ u64 GetUnixTimeOfSlot(int slot)
   return static_cast<u64>(header.time * MS_PER_SEC) + (DOUBLE_TIME_OFFSET * MS_PER_SEC);
 }
 
+static bool ReadChunkedStateData(File::IOFile& f, std::vector<u8>& buffer)
+{
+  ChunkedStateHeader chunked_header;
+  if (!f.ReadArray(&chunked_header, 1) || chunked_header.chunk_size == 0 ||
+      chunked_header.chunk_count != (chunked_header.uncompressed_size + chunked_header.chunk_size -
+                                     1) / chunked_header.chunk_size)
+  {
+    return false;
+  }
+
+  std::vector<u32> chunk_sizes(chunked_header.chunk_count);
+  if (!f.ReadArray(chunk_sizes.data(), chunk_sizes.size()))
+    return false;
+
+  std::vector<u64> chunk_offsets(chunk_sizes.size());
+  u64 compressed_size = 0;
+  for (size_t i = 0; i < chunk_sizes.size(); ++i)
+  {
+    chunk_offsets[i] = compressed_size;
+    compressed_size += chunk_sizes[i];
+  }
+  if (compressed_size != f.GetSize() - f.Tell())
+    return false;
+
+  if (chunked_header.compression == CompressionType::None)
+  {
+    if (compressed_size != chunked_header.uncompressed_size)
+      return false;
+
+    buffer.resize(compressed_size);
+    return f.ReadBytes(buffer.data(), buffer.size());
+  }
+
+  Core::DisplayMessage("Decompressing State...", 500);
+
+  std::vector<u8> compressed(compressed_size);
+  if (!f.ReadBytes(compressed.data(), compressed.size()))
+    return false;
+
+  buffer.resize(chunked_header.uncompressed_size);
+  std::atomic<bool> success = true;
+  ParallelForRanges(chunk_sizes.size(), [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i)
+    {
+      const u64 offset = i * u64{chunked_header.chunk_size};
+      const size_t size = static_cast<size_t>(
+          std::min<u64>(chunked_header.chunk_size, buffer.size() - offset));
+      if (!DecompressChunk(chunked_header.compression, compressed.data() + chunk_offsets[i],
+                           chunk_sizes[i], buffer.data() + offset, size))
+      {
+        success = false;
+      }
+    }
+  });
+
+  return success;
+}
+
 static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
 {
   File::IOFile f;
@@ -585,29 +1004,40 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
   std::vector<u8> buffer;
 
-  if (header.size != 0)  // non-zero size means the state is compressed
+  if (header.file_version == FILE_VERSION_CHUNKED)
+  {
+    if (!ReadChunkedStateData(f, buffer))
+    {
+      Core::DisplayMessage("Failed to decompress state", 2000);
+      return;
+    }
+  }
+  else if (header.file_version != FILE_VERSION_LEGACY)
+  {
+    Core::DisplayMessage("State was saved in an unsupported format", 2000);
+    return;
+  }
+  else if (header.size != 0)  // non-zero size means the state is compressed
   {
     Core::DisplayMessage("Decompressing State...", 500);
 
     buffer.resize(header.size);
+    std::vector<u8> compressed(GetLZOCompressBound(LEGACY_LZO_CHUNK_SIZE));
 
     lzo_uint i = 0;
     while (true)
     {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
+      lzo_uint32 cur_len = 0;                // number of bytes to read
+      lzo_uint new_len = buffer.size() - i;  // number of bytes to write
 
       if (!f.ReadArray(&cur_len, 1))
         break;
 
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
-      if (res != LZO_E_OK)
+      if (cur_len > compressed.size() || !f.ReadBytes(compressed.data(), cur_len) ||
+          lzo1x_decompress_safe(compressed.data(), cur_len, buffer.data() + i, &new_len,
+                                nullptr) != LZO_E_OK)
       {
-        // This doesn't seem to happen anymore.
-        PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
-                       "Try loading the state again",
-                       res, i, new_len);
+        Core::DisplayMessage("Failed to decompress state", 2000);
         return;
       }
 
@@ -713,8 +1143,8 @@ void Init()
   if (lzo_init() != LZO_E_OK)
     PanicAlertFmtT("Internal LZO Error - lzo_init() failed");
 
-  s_save_thread.Reset([](CompressAndDumpState_args args) {
-    CompressAndDumpState(args);
+  s_save_thread.Reset([](DumpState_args args) {
+    DumpState(args);
 
     {
       std::lock_guard lk(s_state_writes_in_queue_mutex);
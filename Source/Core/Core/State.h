@@ -17,10 +17,19 @@ namespace State
 // number of states
 static const u32 NUM_STATES = 10;
 
+enum class CompressionType : u32
+{
+  None = 0,
+  LZO = 1,
+  Zstd = 2,
+};
+
 struct StateHeader
 {
   char gameID[6];
-  u16 reserved1;
+  // 0 for states written before compression became selectable. Those are either uncompressed or,
+  // if size is non-zero, LZO-compressed in 128 KiB chunks.
+  u16 file_version;
   u32 size;
   u32 reserved2;
   double time;
@@ -59,6 +68,29 @@ void LoadAs(const std::string& filename);
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 
+// An in-memory savestate that also knows where its top-level sections start, so that it can be
+// stored as a delta against another snapshot. Meant for frequent snapshots (rewind, automated
+// testing), where most of the state, in particular emulated RAM, is the same from one to the next.
+struct Snapshot
+{
+  std::vector<u8> data;
+  std::vector<u32> section_offsets;
+};
+
+// Reusing the same Snapshot for repeated saves avoids reallocating and, as long as the state
+// didn't grow, serializes it in a single pass.
+void SaveSnapshot(Snapshot& snapshot);
+// Unlike the other ways of loading a state, this is allowed during NetPlay. It is up to the caller
+// to make sure that doesn't cause a desync.
+void LoadSnapshot(Snapshot& snapshot);
+
+// Encodes snapshot as the pages that differ from base. Sections are compared separately, so a
+// section that changed size doesn't make every following page differ.
+std::vector<u8> EncodeSnapshotDelta(const Snapshot& base, const Snapshot& snapshot);
+// Rebuilds a snapshot from the base it was encoded against. Returns false if the delta is invalid
+// or doesn't belong to base.
+bool DecodeSnapshotDelta(const Snapshot& base, const std::vector<u8>& delta, Snapshot& snapshot);
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
@@ -0,0 +1,159 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/TimingWheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <iterator>
+
+#include "Common/Assert.h"
+
+namespace CoreTiming
+{
+void TimingWheel::Push(const Event& ev)
+{
+  ++m_size;
+
+  // If nothing is in the window, move it to the event instead of putting the event on the heap.
+  if (m_near_size == 0 && ev.time >= m_window_start + WINDOW_CYCLES)
+    MoveWindowTo(ev.time & ~(BUCKET_CYCLES - 1));
+
+  if (ev.time < m_window_start + WINDOW_CYCLES)
+  {
+    PushNear(ev);
+  }
+  else
+  {
+    m_far_events.push_back(ev);
+    std::push_heap(m_far_events.begin(), m_far_events.end(), std::greater<Event>());
+  }
+}
+
+const Event& TimingWheel::Front()
+{
+  ASSERT(!Empty());
+  if (m_buckets[GetBucketIndex(m_window_start)].empty())
+    MoveWindow();
+
+  return m_buckets[GetBucketIndex(m_window_start)][FindFrontIndex()];
+}
+
+Event TimingWheel::PopFront()
+{
+  ASSERT(!Empty());
+  if (m_buckets[GetBucketIndex(m_window_start)].empty())
+    MoveWindow();
+
+  const u32 index = GetBucketIndex(m_window_start);
+  std::vector<Event>& bucket = m_buckets[index];
+  const auto it = bucket.begin() + FindFrontIndex();
+  Event ev = *it;
+  *it = bucket.back();
+  bucket.pop_back();
+  if (bucket.empty())
+    SetBucketUsed(index, false);
+
+  --m_near_size;
+  --m_size;
+  return ev;
+}
+
+std::vector<Event> TimingWheel::GetAll() const
+{
+  std::vector<Event> events;
+  events.reserve(m_size);
+  for (const std::vector<Event>& bucket : m_buckets)
+    events.insert(events.end(), bucket.begin(), bucket.end());
+  events.insert(events.end(), m_far_events.begin(), m_far_events.end());
+  return events;
+}
+
+void TimingWheel::Clear()
+{
+  for (std::vector<Event>& bucket : m_buckets)
+    bucket.clear();
+  m_used_buckets = {};
+  m_near_size = 0;
+  m_far_events.clear();
+  m_window_start = 0;
+  m_size = 0;
+}
+
+void TimingWheel::PushNear(const Event& ev)
+{
+  // Events before the window go into the cursor bucket.
+  const u32 index = GetBucketIndex(std::max(ev.time, m_window_start));
+  m_buckets[index].push_back(ev);
+  SetBucketUsed(index, true);
+  ++m_near_size;
+}
+
+void TimingWheel::MakeFarEventsHeap()
+{
+  std::make_heap(m_far_events.begin(), m_far_events.end(), std::greater<Event>());
+}
+
+void TimingWheel::SetBucketUsed(u32 index, bool used)
+{
+  const u64 bit = u64{1} << (index % 64);
+  if (used)
+    m_used_buckets[index / 64] |= bit;
+  else
+    m_used_buckets[index / 64] &= ~bit;
+}
+
+void TimingWheel::MoveWindow()
+{
+  if (m_near_size == 0)
+  {
+    MoveWindowTo(m_far_events.front().time & ~(BUCKET_CYCLES - 1));
+    return;
+  }
+
+  const u32 cursor = GetBucketIndex(m_window_start);
+  const u32 distance = (FindNextUsedBucket(cursor) - cursor) % NUM_BUCKETS;
+  MoveWindowTo(m_window_start + distance * BUCKET_CYCLES);
+}
+
+void TimingWheel::MoveWindowTo(s64 window_start)
+{
+  // The buckets between the old and the new cursor must be empty at this point, so that every
+  // event in the window stays in the right bucket.
+  m_window_start = window_start;
+
+  const s64 window_end = m_window_start + WINDOW_CYCLES;
+  while (!m_far_events.empty() && m_far_events.front().time < window_end)
+  {
+    std::pop_heap(m_far_events.begin(), m_far_events.end(), std::greater<Event>());
+    PushNear(m_far_events.back());
+    m_far_events.pop_back();
+  }
+}
+
+u32 TimingWheel::FindNextUsedBucket(u32 index) const
+{
+  // Look at the rest of the word the index is in, then at all other words, then at the start of
+  // the first word again.
+  u32 word = index / 64;
+  u64 bits = m_used_buckets[word] & (~u64{0} << (index % 64));
+  for (size_t i = 0; i <= m_used_buckets.size(); ++i)
+  {
+    if (bits != 0)
+      return word * 64 + std::countr_zero(bits);
+
+    word = (word + 1) % m_used_buckets.size();
+    bits = m_used_buckets[word];
+  }
+
+  ASSERT_MSG(POWERPC, false, "No used bucket in the timing wheel");
+  return index;
+}
+
+size_t TimingWheel::FindFrontIndex() const
+{
+  const std::vector<Event>& bucket = m_buckets[GetBucketIndex(m_window_start)];
+  return std::distance(bucket.begin(), std::min_element(bucket.begin(), bucket.end()));
+}
+}  // namespace CoreTiming
@@ -0,0 +1,119 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace CoreTiming
+{
+struct EventType;
+
+struct Event
+{
+  s64 time;
+  u64 fifo_order;
+  u64 userdata;
+  EventType* type;
+};
+
+// Sort by time, unless the times are the same, in which case sort by the order added to the queue
+inline bool operator>(const Event& left, const Event& right)
+{
+  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
+}
+inline bool operator<(const Event& left, const Event& right)
+{
+  return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
+}
+
+// Priority queue of events, ordered like a min-heap of Events.
+//
+// Events in the near future are put into buckets of BUCKET_CYCLES cycles each, which covers a
+// window of NUM_BUCKETS * BUCKET_CYCLES cycles, and which is O(1) to insert into. Events further
+// out go into a binary heap, and are moved into their bucket once the window reaches them.
+//
+// The bucket at the start of the window (the cursor) additionally holds every event scheduled
+// before the window, so the earliest event is always in the cursor bucket unless the whole
+// window is empty.
+class TimingWheel
+{
+public:
+  static constexpr u32 BUCKET_SHIFT = 12;
+  static constexpr s64 BUCKET_CYCLES = s64{1} << BUCKET_SHIFT;
+  static constexpr u32 NUM_BUCKETS = 4096;
+  static constexpr s64 WINDOW_CYCLES = BUCKET_CYCLES * NUM_BUCKETS;
+
+  bool Empty() const { return m_size == 0; }
+  size_t Size() const { return m_size; }
+
+  void Push(const Event& ev);
+
+  // Must not be called on an empty wheel.
+  const Event& Front();
+  Event PopFront();
+
+  // Removes every event for which pred returns true.
+  template <typename Pred>
+  void RemoveIf(Pred pred)
+  {
+    for (size_t word = 0; word < m_used_buckets.size(); ++word)
+    {
+      for (u64 bits = m_used_buckets[word]; bits != 0; bits &= bits - 1)
+      {
+        const u32 index = static_cast<u32>(word * 64 + std::countr_zero(bits));
+        std::vector<Event>& bucket = m_buckets[index];
+        const size_t removed = std::erase_if(bucket, pred);
+        m_near_size -= removed;
+        m_size -= removed;
+        if (bucket.empty())
+          SetBucketUsed(index, false);
+      }
+    }
+    RemoveFarEventsIf(pred);
+  }
+
+  // Returns every event, in no particular order.
+  std::vector<Event> GetAll() const;
+  void Clear();
+
+private:
+  template <typename Pred>
+  void RemoveFarEventsIf(Pred pred)
+  {
+    const size_t removed = std::erase_if(m_far_events, pred);
+    if (removed != 0)
+    {
+      m_size -= removed;
+      MakeFarEventsHeap();
+    }
+  }
+
+  static u32 GetBucketIndex(s64 time)
+  {
+    return static_cast<u32>(static_cast<u64>(time) >> BUCKET_SHIFT) % NUM_BUCKETS;
+  }
+
+  void PushNear(const Event& ev);
+  void MakeFarEventsHeap();
+  void SetBucketUsed(u32 index, bool used);
+  // Moves the window so that it starts with the earliest event.
+  void MoveWindow();
+  void MoveWindowTo(s64 window_start);
+  u32 FindNextUsedBucket(u32 index) const;
+  size_t FindFrontIndex() const;
+
+  std::array<std::vector<Event>, NUM_BUCKETS> m_buckets;
+  std::array<u64, NUM_BUCKETS / 64> m_used_buckets{};
+  size_t m_near_size = 0;
+  std::vector<Event> m_far_events;
+  s64 m_window_start = 0;
+  size_t m_size = 0;
+};
+}  // namespace CoreTiming
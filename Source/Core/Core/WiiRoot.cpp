@@ -10,6 +10,7 @@
 #include <fmt/format.h>
 
 #include "Common/CommonPaths.h"
+#include "Common/Config/Config.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
@@ -18,11 +19,14 @@
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/CommonTitles.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Config/SessionSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/WiiSave.h"
 #include "Core/IOS/ES/ES.h"
 #include "Core/IOS/FS/FileSystem.h"
+#include "Core/IOS/FS/HostBackend/FS.h"
+#include "Core/IOS/FS/OverlayBackend/FS.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/Uids.h"
 #include "Core/Movie.h"
@@ -37,6 +41,7 @@ static std::string s_temp_wii_root;
 static std::string s_temp_redirect_root;
 static bool s_wii_root_initialized = false;
 static std::vector<IOS::HLE::FS::NandRedirect> s_nand_redirects;
+static std::shared_ptr<FS::NandOverlay> s_nand_overlay;
 
 // When Temp NAND + Redirects are both active, we need to keep track of where each redirect path
 // should be copied back to after a successful session finish.
@@ -52,6 +57,11 @@ const std::vector<IOS::HLE::FS::NandRedirect>& GetActiveNandRedirects()
   return s_nand_redirects;
 }
 
+std::shared_ptr<IOS::HLE::FS::NandOverlay> GetNandOverlay()
+{
+  return s_nand_overlay;
+}
+
 static bool CopyBackupFile(const std::string& path_from, const std::string& path_to)
 {
   if (!File::Exists(path_from))
@@ -228,14 +238,46 @@ void InitializeWiiRoot(bool use_temporary)
   else
   {
     File::SetUserPath(D_SESSION_WIIROOT_IDX, File::GetUserPath(D_WIIROOT_IDX));
+
+    if (Config::Get(Config::MAIN_NAND_OVERLAY))
+    {
+      WARN_LOG_FMT(IOS_FS, "Keeping changes to the NAND at {} in memory",
+                   File::GetUserPath(D_WIIROOT_IDX));
+      s_nand_overlay = std::make_shared<FS::NandOverlay>();
+    }
   }
 
   s_nand_redirects.clear();
   s_wii_root_initialized = true;
 }
 
+static void PersistNandOverlay()
+{
+  std::string path = Config::Get(Config::MAIN_NAND_OVERLAY_PERSIST_PATH);
+  if (path.empty())
+    return;
+  if (path.back() != '/')
+    path += '/';
+
+  // Start from a copy of the NAND the changes were made to, unless they go back to that NAND.
+  if (!File::Exists(path))
+    File::CopyDir(File::GetUserPath(D_WIIROOT_IDX), path);
+
+  FS::HostFileSystem target{path};
+  if (s_nand_overlay->Commit(&target))
+    NOTICE_LOG_FMT(IOS_FS, "Wrote the changes to the NAND to {}", path);
+  else
+    ERROR_LOG_FMT(IOS_FS, "Failed to write some of the changes to the NAND to {}", path);
+}
+
 void ShutdownWiiRoot()
 {
+  if (s_nand_overlay)
+  {
+    PersistNandOverlay();
+    s_nand_overlay.reset();
+  }
+
   if (WiiRootIsTemporary())
   {
     File::DeleteDirRecursively(s_temp_wii_root);
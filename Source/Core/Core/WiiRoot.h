@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -12,6 +13,7 @@ class BootSessionData;
 
 namespace IOS::HLE::FS
 {
+class NandOverlay;
 struct NandRedirect;
 }
 
@@ -39,4 +41,7 @@ void InitializeWiiFileSystemContents(
 void CleanUpWiiFileSystemContents(const BootSessionData& boot_session_data);
 
 const std::vector<IOS::HLE::FS::NandRedirect>& GetActiveNandRedirects();
+
+// Changes made to the NAND during the session when they are kept in memory, or nullptr.
+std::shared_ptr<IOS::HLE::FS::NandOverlay> GetNandOverlay();
 }  // namespace Core
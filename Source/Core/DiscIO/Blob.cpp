@@ -13,6 +13,7 @@
 #include "Common/CDUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "DiscIO/CISOBlob.h"
@@ -20,6 +21,7 @@
 #include "DiscIO/DirectoryBlob.h"
 #include "DiscIO/DriveBlob.h"
 #include "DiscIO/FileBlob.h"
+#include "DiscIO/HttpBlob.h"
 #include "DiscIO/NFSBlob.h"
 #include "DiscIO/TGCBlob.h"
 #include "DiscIO/WIABlob.h"
@@ -143,6 +145,21 @@ bool SectorReader::Read(u64 offset, u64 size, u8* out_ptr)
   {
     block = offset / m_block_size;
 
+    // Large reads of whole blocks that aren't cached are passed on in one piece, so that
+    // ReadMultipleAlignedBlocks can batch them (for instance by decompressing them in parallel)
+    const u64 whole_blocks = remain / m_block_size;
+    if (position_in_block == 0 && whole_blocks > 1 && !FindCacheLine(block))
+    {
+      if (!ReadMultipleAlignedBlocks(block, whole_blocks, out_ptr))
+        return false;
+
+      const u64 was_read = whole_blocks * m_block_size;
+      offset += was_read;
+      out_ptr += was_read;
+      remain -= was_read;
+      continue;
+    }
+
     const Cache* cache = GetCacheLine(block);
     if (!cache)
       return false;
@@ -213,11 +230,41 @@ u32 SectorReader::ReadChunk(u8* buffer, u64 chunk_num)
   return 0;
 }
 
+static std::unique_ptr<BlobReader> CreateHttpBlobReader(const std::string& url)
+{
+  std::unique_ptr<HttpReader> reader = HttpReader::Create(url);
+  if (!reader)
+    return nullptr;
+
+  // The other formats are read through File::IOFile, so only plain disc images are supported
+  u32 magic;
+  if (!reader->Read(0, sizeof(magic), reinterpret_cast<u8*>(&magic)))
+    return nullptr;
+
+  switch (magic)
+  {
+  case CISO_MAGIC:
+  case GCZ_MAGIC:
+  case TGC_MAGIC:
+  case WBFS_MAGIC:
+  case WIA_MAGIC:
+  case RVZ_MAGIC:
+  case NFS_MAGIC:
+    ERROR_LOG_FMT(DISCIO, "Only plain disc images can be read over HTTP: {}", url);
+    return nullptr;
+  default:
+    return reader;
+  }
+}
+
 std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
 {
   if (Common::IsCDROMDevice(filename))
     return DriveReader::Create(filename);
 
+  if (IsHttpUrl(filename))
+    return CreateHttpBlobReader(filename);
+
   File::IOFile file(filename, "rb");
   u32 magic;
   if (!file.ReadArray(&magic, 1))
@@ -251,7 +298,7 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
     if (auto directory_blob = DirectoryBlobReader::Create(filename))
       return std::move(directory_blob);
 
-    return PlainFileReader::Create(std::move(file));
+    return PlainFileReader::Create(std::move(file), filename);
   }
 }
 
@@ -95,6 +95,11 @@ public:
     return false;
   }
 
+  // Returns a pointer to the data if the whole range already is in memory (e.g. in a memory-mapped
+  // file), or nullptr otherwise. The pointer stays valid for as long as the reader exists.
+  // Unlike Read, this is thread-safe.
+  virtual const u8* GetDirectView(u64 offset, u64 size) const { return nullptr; }
+
 protected:
   BlobReader() {}
 };
@@ -200,6 +205,7 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback);
+                       int chunk_size, const std::vector<u8>& zstd_dictionary,
+                       CompressCB callback);
 
 }  // namespace DiscIO
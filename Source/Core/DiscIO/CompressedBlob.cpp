@@ -6,8 +6,10 @@
 #include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <future>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -113,8 +115,96 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
     return false;
   }
 
+  z_stream z = {};
+  inflateInit(&z);
+  const bool success =
+      DecompressBlock(block_num, m_zlib_buffer.data(), comp_block_size, uncompressed, out_ptr, &z);
+  inflateEnd(&z);
+  return success;
+}
+
+bool CompressedBlobReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  if (num_blocks < 2 || block_num + num_blocks > m_header.num_blocks)
+    return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+
+  // The blocks are stored one after another, so their compressed data can be read all at once
+  constexpr u64 UNCOMPRESSED_FLAG = 1ULL << 63;
+  const u64 last_block = block_num + num_blocks - 1;
+  const u64 start = m_block_pointers[block_num] & ~UNCOMPRESSED_FLAG;
+  const u64 end = last_block + 1 < m_header.num_blocks ?
+                      m_block_pointers[last_block + 1] & ~UNCOMPRESSED_FLAG :
+                      m_header.compressed_data_size;
+  if (end < start || end - start > num_blocks * m_header.block_size)
+    return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+
+  m_multiple_blocks_buffer.resize(end - start);
+  m_file.Seek(start + m_data_offset, File::SeekOrigin::Begin);
+  if (!m_file.ReadBytes(m_multiple_blocks_buffer.data(), m_multiple_blocks_buffer.size()))
+  {
+    ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
+                  m_file_name);
+    m_file.ClearError();
+    return false;
+  }
+
+  const auto decompress_blocks = [this, block_num, start, end, out_ptr](u64 first, u64 last) {
+    z_stream z = {};
+    inflateInit(&z);
+
+    bool success = true;
+    for (u64 i = first; i < last && success; ++i)
+    {
+      const u64 pointer = m_block_pointers[block_num + i];
+      const u64 block_start = pointer & ~UNCOMPRESSED_FLAG;
+      const u64 block_end = block_num + i + 1 < m_header.num_blocks ?
+                                m_block_pointers[block_num + i + 1] & ~UNCOMPRESSED_FLAG :
+                                m_header.compressed_data_size;
+      if (block_start < start || block_end < block_start || block_end > end)
+      {
+        ERROR_LOG_FMT(DISCIO, "Invalid size of block {}", block_num + i);
+        success = false;
+        break;
+      }
+
+      const bool uncompressed = (pointer & UNCOMPRESSED_FLAG) != 0;
+      if (uncompressed && block_end - block_start != m_header.block_size)
+        ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
+
+      success = DecompressBlock(block_num + i,
+                                m_multiple_blocks_buffer.data() + (block_start - start),
+                                static_cast<u32>(block_end - block_start), uncompressed,
+                                out_ptr + i * m_header.block_size, &z);
+    }
+
+    inflateEnd(&z);
+    return success;
+  };
+
+  const unsigned int threads = static_cast<unsigned int>(std::min<u64>(
+      {num_blocks, MAX_DECOMPRESSION_THREADS,
+       std::max<unsigned int>(1, std::thread::hardware_concurrency())}));
+
+  // The calling thread decompresses the first share itself
+  std::vector<std::future<bool>> futures(threads - 1);
+  for (size_t i = 1; i < threads; ++i)
+  {
+    futures[i - 1] = std::async(std::launch::async, decompress_blocks, i * num_blocks / threads,
+                                (i + 1) * num_blocks / threads);
+  }
+
+  bool success = decompress_blocks(0, num_blocks / threads);
+  for (std::future<bool>& future : futures)
+    success &= future.get();
+
+  return success;
+}
+
+bool CompressedBlobReader::DecompressBlock(u64 block_num, const u8* in, u32 comp_block_size,
+                                           bool uncompressed, u8* out_ptr, z_stream* z) const
+{
   // First, check hash.
-  const u32 block_hash = Common::HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  const u32 block_hash = Common::HashAdler32(in, comp_block_size);
   if (block_hash != m_hashes[block_num])
   {
     ERROR_LOG_FMT(DISCIO,
@@ -125,29 +215,27 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 
   if (uncompressed)
   {
-    std::copy(m_zlib_buffer.begin(), m_zlib_buffer.begin() + comp_block_size, out_ptr);
+    std::copy(in, in + comp_block_size, out_ptr);
   }
   else
   {
-    z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
-    z.avail_in = comp_block_size;
-    if (z.avail_in > m_header.block_size)
+    inflateReset(z);
+    z->next_in = const_cast<u8*>(in);
+    z->avail_in = comp_block_size;
+    if (z->avail_in > m_header.block_size)
     {
       ERROR_LOG_FMT(DISCIO, "Compressed block size is larger than uncompressed block size");
     }
-    z.next_out = out_ptr;
-    z.avail_out = m_header.block_size;
-    inflateInit(&z);
-    int status = inflate(&z, Z_FULL_FLUSH);
-    u32 uncomp_size = m_header.block_size - z.avail_out;
+    z->next_out = out_ptr;
+    z->avail_out = m_header.block_size;
+    int status = inflate(z, Z_FULL_FLUSH);
+    u32 uncomp_size = m_header.block_size - z->avail_out;
     if (status != Z_STREAM_END)
     {
       // this seem to fire wrongly from time to time
       // to be sure, don't use compressed isos :P
       ERROR_LOG_FMT(DISCIO, "Failure reading block {} - out of data and not at end.", block_num);
     }
-    inflateEnd(&z);
     if (uncomp_size != m_header.block_size)
     {
       ERROR_LOG_FMT(DISCIO, "Wrong block size");
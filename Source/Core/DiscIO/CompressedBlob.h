@@ -16,6 +16,8 @@
 #include <string>
 #include <vector>
 
+#include <zlib.h>
+
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
@@ -62,10 +64,18 @@ public:
 
   u64 GetBlockCompressedSize(u64 block_num) const;
   bool GetBlock(u64 block_num, u8* out_ptr) override;
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
 
 private:
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  // The z_stream must have been initialized with inflateInit. It is reset before use.
+  bool DecompressBlock(u64 block_num, const u8* in, u32 comp_block_size, bool uncompressed,
+                       u8* out_ptr, z_stream* z) const;
+
+  // The largest number of threads a single read is split across
+  static constexpr unsigned int MAX_DECOMPRESSION_THREADS = 4;
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -73,6 +83,7 @@ private:
   File::IOFile m_file;
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
+  std::vector<u8> m_multiple_blocks_buffer;
   std::string m_file_name;
 };
 
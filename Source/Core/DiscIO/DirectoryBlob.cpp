@@ -58,6 +58,26 @@ constexpr u8 ENTRY_SIZE = 0x0c;
 constexpr u8 FILE_ENTRY = 0;
 constexpr u8 DIRECTORY_ENTRY = 1;
 
+File::IOFile* ContentFileCache::Open(const std::string& path)
+{
+  const auto it = std::find_if(m_files.begin(), m_files.end(),
+                               [&path](const auto& file) { return file.first == path; });
+  if (it != m_files.end())
+  {
+    m_files.splice(m_files.begin(), m_files, it);
+    return &m_files.front().second;
+  }
+
+  File::IOFile file(path, "rb");
+  if (!file.IsOpen())
+    return nullptr;
+
+  if (m_files.size() >= MAX_OPEN_FILES)
+    m_files.pop_back();
+  m_files.emplace_front(path, std::move(file));
+  return &m_files.front().second;
+}
+
 DiscContent::DiscContent(u64 offset, u64 size, ContentSource source)
     : m_offset(offset), m_size(size), m_content_source(std::move(source))
 {
@@ -82,7 +102,8 @@ u64 DiscContent::GetSize() const
   return m_size;
 }
 
-bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
+bool DiscContent::Read(u64* offset, u64* length, u8** buffer,
+                       ContentFileCache* file_cache) const
 {
   if (m_size == 0)
     return true;
@@ -97,9 +118,8 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
     if (std::holds_alternative<ContentFile>(m_content_source))
     {
       const auto& content = std::get<ContentFile>(m_content_source);
-      File::IOFile file(content.m_filename, "rb");
-      if (!file.Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
-          !file.ReadBytes(*buffer, bytes_to_read))
+      File::IOFile* file = file_cache->Open(content.m_filename);
+      if (!file || !file->ReadBytesAt(*buffer, bytes_to_read, content.m_offset + offset_in_content))
       {
         return false;
       }
@@ -187,7 +207,7 @@ bool DiscContentContainer::Read(u64 offset, u64 length, u8* buffer) const
     if (length == 0)
       return true;
 
-    if (!it->Read(&offset, &length, &buffer))
+    if (!it->Read(&offset, &length, &buffer, &m_file_cache))
       return false;
 
     ++it;
@@ -1188,16 +1208,22 @@ void DirectoryBlobPartition::WriteDirectory(std::vector<FSTBuilderNode>* parent_
 {
   std::vector<FSTBuilderNode>& sorted_entries = *parent_entries;
 
-  // Sort for determinism
-  std::sort(sorted_entries.begin(), sorted_entries.end(),
-            [](const FSTBuilderNode& one, const FSTBuilderNode& two) {
-              std::string one_upper = one.m_filename;
-              std::string two_upper = two.m_filename;
-              Common::ToUpper(&one_upper);
-              Common::ToUpper(&two_upper);
-              return one_upper == two_upper ? one.m_filename < two.m_filename :
-                                              one_upper < two_upper;
-            });
+  // Sort for determinism. The upper case names are only computed once per entry rather than once
+  // per comparison, which matters for folders with thousands of files.
+  std::vector<std::pair<std::string, FSTBuilderNode>> keyed_entries;
+  keyed_entries.reserve(sorted_entries.size());
+  for (FSTBuilderNode& entry : sorted_entries)
+  {
+    std::string upper = entry.m_filename;
+    Common::ToUpper(&upper);
+    keyed_entries.emplace_back(std::move(upper), std::move(entry));
+  }
+  std::sort(keyed_entries.begin(), keyed_entries.end(), [](const auto& one, const auto& two) {
+    return one.first == two.first ? one.second.m_filename < two.second.m_filename :
+                                    one.first < two.first;
+  });
+  for (size_t i = 0; i < keyed_entries.size(); ++i)
+    sorted_entries[i] = std::move(keyed_entries[i].second);
 
   for (FSTBuilderNode& entry : sorted_entries)
   {
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -16,6 +17,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/WiiEncryptionCache.h"
@@ -23,7 +25,6 @@
 namespace File
 {
 struct FSTEntry;
-class IOFile;
 }  // namespace File
 
 namespace DiscIO
@@ -136,6 +137,21 @@ struct FSTBuilderNode
   }
 };
 
+// Keeps the most recently read host files open, so that reading a file in many small pieces (or
+// reading many files in turn) doesn't open a file for every read.
+class ContentFileCache
+{
+public:
+  // Returns nullptr if the file can't be opened.
+  File::IOFile* Open(const std::string& path);
+
+private:
+  static constexpr size_t MAX_OPEN_FILES = 16;
+
+  // The most recently used file is at the front.
+  std::list<std::pair<std::string, File::IOFile>> m_files;
+};
+
 class DiscContent
 {
 public:
@@ -147,7 +163,7 @@ public:
   u64 GetOffset() const;
   u64 GetEndOffset() const;
   u64 GetSize() const;
-  bool Read(u64* offset, u64* length, u8** buffer) const;
+  bool Read(u64* offset, u64* length, u8** buffer, ContentFileCache* file_cache) const;
 
   bool operator==(const DiscContent& other) const { return GetEndOffset() == other.GetEndOffset(); }
   bool operator!=(const DiscContent& other) const { return !(*this == other); }
@@ -183,6 +199,7 @@ public:
 
 private:
   std::set<DiscContent> m_contents;
+  mutable ContentFileCache m_file_cache;
 };
 
 class DirectoryBlobPartition
@@ -4,14 +4,19 @@
 #include "DiscIO/DiscExtractor.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <functional>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/Filesystem.h"
@@ -132,6 +137,109 @@ void ExportDirectory(const Volume& volume, const Partition& partition, const Fil
   }
 }
 
+namespace
+{
+struct FileToExport
+{
+  u64 offset;
+  u64 size;
+  std::string path;
+  std::string export_path;
+};
+}  // namespace
+
+static void CollectFilesToExport(const FileInfo& directory, const std::string& filesystem_path,
+                                 const std::string& export_folder,
+                                 std::vector<FileToExport>* files)
+{
+  std::string export_root = export_folder + '/';
+  if (directory.IsDirectory() && !directory.IsRoot())
+    export_root += directory.GetName() + '/';
+
+  File::CreateFullPath(export_root);
+
+  for (const FileInfo& file_info : directory)
+  {
+    const std::string name = file_info.GetName() + (file_info.IsDirectory() ? "/" : "");
+    const std::string path = filesystem_path + name;
+    const std::string export_path = export_root + name;
+
+    if (file_info.IsDirectory())
+      CollectFilesToExport(file_info, path, export_root, files);
+    else if (File::Exists(export_path))
+      NOTICE_LOG_FMT(DISCIO, "{} already exists", export_path);
+    else
+      files->push_back({file_info.GetOffset(), file_info.GetSize(), path, export_path});
+  }
+}
+
+bool ExportDirectoryInDiscOrder(
+    const Volume& volume, const Partition& partition, const FileInfo& directory,
+    const std::string& filesystem_path, const std::string& export_folder,
+    const std::function<bool(const std::string& path)>& update_progress)
+{
+  // Larger files are read and written in parts on this thread, like ExportFile does.
+  constexpr u64 MAX_QUEUED_FILE_SIZE = 0x08000000;
+  constexpr u64 MAX_QUEUED_BYTES = 0x10000000;
+
+  std::vector<FileToExport> files;
+  CollectFilesToExport(directory, filesystem_path, export_folder, &files);
+  std::sort(files.begin(), files.end(),
+            [](const FileToExport& a, const FileToExport& b) { return a.offset < b.offset; });
+
+  std::atomic<bool> success = true;
+  std::atomic<u64> queued_bytes = 0;
+  std::array<Common::WorkQueueThread<std::pair<std::string, std::vector<u8>>>, 4> writers;
+  for (auto& writer : writers)
+  {
+    writer.Reset([&](std::pair<std::string, std::vector<u8>> file) {
+      File::IOFile f(file.first, "wb");
+      if (!f || (!file.second.empty() && !f.WriteBytes(file.second.data(), file.second.size())))
+      {
+        ERROR_LOG_FMT(DISCIO, "Could not export {}", file.first);
+        success = false;
+      }
+      queued_bytes -= file.second.size();
+    });
+  }
+
+  size_t next_writer = 0;
+  for (const FileToExport& file : files)
+  {
+    // The files which have already been read are still written.
+    if (update_progress(file.path))
+      return false;
+
+    DEBUG_LOG_FMT(DISCIO, "{}", file.export_path);
+
+    if (file.size > MAX_QUEUED_FILE_SIZE || queued_bytes + file.size > MAX_QUEUED_BYTES)
+    {
+      if (!ExportData(volume, partition, file.offset, file.size, file.export_path))
+      {
+        ERROR_LOG_FMT(DISCIO, "Could not export {}", file.export_path);
+        success = false;
+      }
+      continue;
+    }
+
+    std::vector<u8> data(file.size);
+    if (!volume.Read(file.offset, file.size, data.data(), partition))
+    {
+      ERROR_LOG_FMT(DISCIO, "Could not export {}", file.export_path);
+      success = false;
+      continue;
+    }
+
+    queued_bytes += file.size;
+    writers[next_writer].EmplaceItem(file.export_path, std::move(data));
+    next_writer = (next_writer + 1) % writers.size();
+  }
+
+  for (auto& writer : writers)
+    writer.Shutdown();
+  return success;
+}
+
 bool ExportWiiUnencryptedHeader(const Volume& volume, const std::string& export_filename)
 {
   if (volume.GetVolumeType() != Platform::WiiDisc)
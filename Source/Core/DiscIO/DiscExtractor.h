@@ -34,6 +34,14 @@ void ExportDirectory(const Volume& volume, const Partition& partition, const Fil
                      bool recursive, const std::string& filesystem_path,
                      const std::string& export_folder,
                      const std::function<bool(const std::string& path)>& update_progress);
+// Like a recursive ExportDirectory, but the files are read in the order in which they are stored on
+// the disc, so that every block only has to be decrypted and decompressed once, and they are
+// written on worker threads. update_progress is called once for each file.
+// Returns false if a file couldn't be exported, or if the extraction got cancelled.
+bool ExportDirectoryInDiscOrder(
+    const Volume& volume, const Partition& partition, const FileInfo& directory,
+    const std::string& filesystem_path, const std::string& export_folder,
+    const std::function<bool(const std::string& path)>& update_progress);
 
 // To export everything listed below, you can use ExportSystemData
 
@@ -4,6 +4,7 @@
 #include "DiscIO/FileBlob.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -15,22 +16,48 @@
 
 namespace DiscIO
 {
-PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
+PlainFileReader::PlainFileReader(File::IOFile file, const std::string& path)
+    : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
+
+  if (!m_mapped_file.Open(path) || m_mapped_file.GetSize() != static_cast<u64>(m_size))
+    m_mapped_file.Close();
 }
 
-std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
+std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file,
+                                                         const std::string& path)
 {
   if (file)
-    return std::unique_ptr<PlainFileReader>(new PlainFileReader(std::move(file)));
+    return std::unique_ptr<PlainFileReader>(new PlainFileReader(std::move(file), path));
 
   return nullptr;
 }
 
+const u8* PlainFileReader::GetDirectView(u64 offset, u64 size) const
+{
+  if (!m_mapped_file.IsOpen() || offset > m_mapped_file.GetSize() ||
+      size > m_mapped_file.GetSize() - offset)
+  {
+    return nullptr;
+  }
+
+  return m_mapped_file.GetData() + offset;
+}
+
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
-  if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out_ptr, nbytes))
+  if (m_mapped_file.IsOpen())
+  {
+    const u8* data = GetDirectView(offset, nbytes);
+    if (!data)
+      return false;
+
+    std::memcpy(out_ptr, data, nbytes);
+    return true;
+  }
+
+  if (m_file.ReadBytesAt(out_ptr, nbytes, offset))
   {
     return true;
   }
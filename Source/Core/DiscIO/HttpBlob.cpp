@@ -0,0 +1,82 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/HttpBlob.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Common/CommonTypes.h"
+#include "Common/HttpRequest.h"
+#include "Common/Logging/Log.h"
+
+namespace DiscIO
+{
+bool IsHttpUrl(std::string_view path)
+{
+  return path.starts_with("http://") || path.starts_with("https://");
+}
+
+HttpReader::HttpReader(const std::string& url, u64 size)
+    : m_http(std::chrono::seconds{30}), m_url(url), m_size(size)
+{
+  SetSectorSize(SECTOR_SIZE);
+  SetChunkSize(CHUNK_BLOCKS);
+}
+
+std::unique_ptr<HttpReader> HttpReader::Create(const std::string& url)
+{
+  Common::HttpRequest http(std::chrono::seconds{30});
+  if (!http.IsValid())
+    return nullptr;
+
+  const std::optional<u64> size = http.GetContentLength(url);
+  if (!size || *size == 0)
+  {
+    ERROR_LOG_FMT(DISCIO, "Could not get the size of {}", url);
+    return nullptr;
+  }
+
+  auto reader = std::unique_ptr<HttpReader>(new HttpReader(url, *size));
+  if (!reader->m_http.IsValid())
+    return nullptr;
+  return reader;
+}
+
+bool HttpReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  return ReadMultipleAlignedBlocks(block_num, 1, out_ptr);
+}
+
+bool HttpReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  const u64 offset = block_num * SECTOR_SIZE;
+  if (offset >= m_size)
+    return false;
+
+  // The last block of an image whose size isn't a multiple of the sector size is padded
+  const u64 size = std::min(num_blocks * SECTOR_SIZE, m_size - offset);
+  std::memset(out_ptr + size, 0, num_blocks * SECTOR_SIZE - size);
+
+  for (int attempt = 1; attempt <= MAX_ATTEMPTS; ++attempt)
+  {
+    const Common::HttpRequest::Response response = m_http.GetRange(m_url, offset, size);
+    if (response)
+    {
+      std::memcpy(out_ptr, response->data(), size);
+      return true;
+    }
+
+    WARN_LOG_FMT(DISCIO, "Reading {:#x} bytes at {:#x} from {} failed (attempt {} of {})", size,
+                 offset, m_url, attempt, MAX_ATTEMPTS);
+  }
+
+  return false;
+}
+
+}  // namespace DiscIO
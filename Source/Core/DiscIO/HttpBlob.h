@@ -0,0 +1,53 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "Common/CommonTypes.h"
+#include "Common/HttpRequest.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+bool IsHttpUrl(std::string_view path);
+
+// Reads a plain disc image from a web server using HTTP range requests, so that images in object
+// storage can be converted or verified without downloading them first.
+class HttpReader : public SectorReader
+{
+public:
+  static std::unique_ptr<HttpReader> Create(const std::string& url);
+
+  BlobType GetBlobType() const override { return BlobType::PLAIN; }
+
+  u64 GetRawSize() const override { return m_size; }
+  u64 GetDataSize() const override { return m_size; }
+  DataSizeType GetDataSizeType() const override { return DataSizeType::Accurate; }
+
+  u64 GetBlockSize() const override { return 0; }
+  bool HasFastRandomAccessInBlock() const override { return false; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+private:
+  HttpReader(const std::string& url, u64 size);
+  bool GetBlock(u64 block_num, u8* out_ptr) override;
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
+
+  // Every request has a round trip of latency, so small reads (such as the ones for disc headers
+  // and file system tables) are rounded up to a whole chunk, which is then cached.
+  static constexpr int SECTOR_SIZE = 0x8000;
+  static constexpr int CHUNK_BLOCKS = 16;
+  // Object storage occasionally drops or throttles requests
+  static constexpr int MAX_ATTEMPTS = 3;
+
+  Common::HttpRequest m_http;
+  std::string m_url;
+  u64 m_size;
+};
+
+}  // namespace DiscIO
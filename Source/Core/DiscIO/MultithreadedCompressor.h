@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <memory>
@@ -14,6 +15,7 @@
 #include "Common/Assert.h"
 #include "Common/Event.h"
 #include "Common/Result.h"
+#include "Common/Semaphore.h"
 
 namespace DiscIO
 {
@@ -29,6 +31,21 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = Common::Result<ConversionResultCode, T>;
 
+inline unsigned int GetCompressionThreadCount()
+{
+  return std::max<unsigned int>(1, std::thread::hardware_concurrency());
+}
+
+// Shared by all MultithreadedCompressor instances, so that when several conversions run at the
+// same time, no more chunks are compressed at once than there are CPU threads. A conversion that
+// is waiting for I/O leaves its share of the CPU to the others.
+inline Common::Semaphore& GetCompressionSlots()
+{
+  static Common::Semaphore slots(static_cast<int>(GetCompressionThreadCount()),
+                                 static_cast<int>(GetCompressionThreadCount()));
+  return slots;
+}
+
 // This class starts a number of compression threads and one output thread.
 // The set_up_compress_thread_state function is called at the start of each compression thread.
 // When CompressAndWrite is called, the compress function will be called on one of the
@@ -48,7 +65,7 @@ public:
       std::function<ConversionResultCode(OutputParameters)> output)
       : m_set_up_compress_thread_state(std::move(set_up_compress_thread_state)),
         m_compress(std::move(compress)), m_output(std::move(output)),
-        m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency()))
+        m_threads(GetCompressionThreadCount())
   {
     m_compress_threads = std::make_unique<CompressThread[]>(m_threads);
 
@@ -156,8 +173,10 @@ private:
       state->compress_done_event.Reset();
       state->compress_ready_event.Set();
 
+      GetCompressionSlots().Wait();
       ConversionResult<OutputParameters> result =
           m_compress(&compress_thread_state, std::move(parameters));
+      GetCompressionSlots().Post();
 
       if (result)
       {
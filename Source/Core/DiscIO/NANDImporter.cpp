@@ -35,7 +35,18 @@ void NANDImporter::ImportNANDBin(const std::string& path_to_bin,
     return;
 
   ExportKeys();
+
+  for (auto& thread : m_file_threads)
+  {
+    thread.Reset([this](std::pair<NANDFSTEntry, std::string> file) {
+      ExtractFile(file.first, file.second);
+    });
+  }
   ProcessEntry(0, "");
+  // Waits for the remaining files to be written.
+  for (auto& thread : m_file_threads)
+    thread.Shutdown();
+
   ExtractCertificates();
 }
 
@@ -144,9 +155,9 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
     Type type = static_cast<Type>(entry.mode & 3);
     if (type == Type::File)
     {
-      std::vector<u8> data = GetEntryData(entry);
-      File::IOFile file(m_nand_root + path, "wb");
-      file.WriteBytes(data.data(), data.size());
+      // The parent directory has already been created.
+      m_file_threads[m_next_file_thread].EmplaceItem(entry, path);
+      m_next_file_thread = (m_next_file_thread + 1) % m_file_threads.size();
     }
     else if (type == Type::Directory)
     {
@@ -162,6 +173,13 @@ void NANDImporter::ProcessEntry(u16 entry_number, const std::string& parent_path
   }
 }
 
+void NANDImporter::ExtractFile(const NANDFSTEntry& entry, const std::string& path)
+{
+  std::vector<u8> data = GetEntryData(entry);
+  File::IOFile file(m_nand_root + path, "wb");
+  file.WriteBytes(data.data(), data.size());
+}
+
 std::vector<u8> NANDImporter::GetEntryData(const NANDFSTEntry& entry)
 {
   constexpr size_t NAND_FAT_BLOCK_SIZE = 0x4000;
@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -14,6 +15,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/AES.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 
 namespace DiscIO
 {
@@ -69,6 +71,7 @@ private:
   std::string GetPath(const NANDFSTEntry& entry, const std::string& parent_path);
   std::string FormatDebugString(const NANDFSTEntry& entry);
   void ProcessEntry(u16 entry_number, const std::string& parent_path);
+  void ExtractFile(const NANDFSTEntry& entry, const std::string& path);
   std::vector<u8> GetEntryData(const NANDFSTEntry& entry);
   void ExportKeys();
 
@@ -78,6 +81,10 @@ private:
   std::unique_ptr<Common::AES::Context> m_aes_ctx;
   std::unique_ptr<NANDSuperblock> m_superblock;
   std::function<void()> m_update_callback;
+
+  // Files are decrypted and written on these while the file system is walked.
+  std::array<Common::WorkQueueThread<std::pair<NANDFSTEntry, std::string>>, 4> m_file_threads;
+  size_t m_next_file_thread = 0;
 };
 }  // namespace DiscIO
 
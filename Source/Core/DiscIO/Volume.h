@@ -48,6 +48,13 @@ public:
   Volume() {}
   virtual ~Volume() {}
   virtual bool Read(u64 offset, u64 length, u8* buffer, const Partition& partition) const = 0;
+  // Returns a pointer to the data which Read would return if no conversion (such as decryption)
+  // is needed and the blob reader has it in memory, or nullptr otherwise. Unlike Read, this is
+  // thread-safe. The pointer stays valid for as long as the volume exists.
+  virtual const u8* GetDirectView(u64 offset, u64 length, const Partition& partition) const
+  {
+    return nullptr;
+  }
   template <typename T>
   std::optional<T> ReadSwapped(u64 offset, const Partition& partition) const
   {
@@ -10,6 +10,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 #include <mbedtls/md5.h>
@@ -356,7 +357,8 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
   return {Status::Unknown, Common::GetStringT("Unknown disc")};
 }
 
-constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
+// Large enough that starting the hashing tasks for each chunk takes a negligible amount of time
+constexpr u64 DEFAULT_READ_SIZE = 0x100000;
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -1239,36 +1241,10 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
-
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
-        }
-      }
-    });
+    m_group_future =
+        std::async(std::launch::async, [this, read_failed, group_index = m_group_index] {
+          VerifyGroup(m_groups[group_index], read_failed);
+        });
 
     m_group_index++;
   }
@@ -1276,6 +1252,89 @@ void VolumeVerifier::Process()
   m_progress += byte_increment;
 }
 
+void VolumeVerifier::VerifyGroup(const GroupToVerify& group, bool read_failed)
+{
+  const size_t num_blocks = group.block_index_end - group.block_index_start;
+  if (num_blocks == 0)
+    return;
+
+  // Verifying the first block evaluates the lazily loaded partition data (key, H3 table),
+  // which must not happen on several threads at once, so do it before splitting up the work.
+  std::vector<BlockVerificationResult> results(1);
+  results[0] = VerifyBlocks(group, group.block_index_start, group.block_index_start + 1,
+                            read_failed);
+
+  // Decrypting and hashing a group is slower than reading it from most storage,
+  // so share the remaining blocks between several threads to keep up with the reads
+  const size_t remaining_blocks = num_blocks - 1;
+  const unsigned int threads = static_cast<unsigned int>(std::min<u64>(
+      {remaining_blocks, MAX_BLOCK_VERIFICATION_THREADS,
+       std::max<unsigned int>(1, std::thread::hardware_concurrency())}));
+
+  if (threads > 0)
+  {
+    // The calling thread verifies the first share itself
+    const size_t first_block = group.block_index_start + 1;
+    std::vector<std::future<BlockVerificationResult>> futures(threads - 1);
+    for (size_t i = 1; i < threads; ++i)
+    {
+      futures[i - 1] = std::async(std::launch::async, &VolumeVerifier::VerifyBlocks, this,
+                                  std::cref(group), first_block + i * remaining_blocks / threads,
+                                  first_block + (i + 1) * remaining_blocks / threads, read_failed);
+    }
+
+    results.push_back(
+        VerifyBlocks(group, first_block, first_block + remaining_blocks / threads, read_failed));
+    for (std::future<BlockVerificationResult>& future : futures)
+      results.push_back(future.get());
+  }
+
+  for (const BlockVerificationResult& result : results)
+  {
+    m_biggest_verified_offset = std::max(m_biggest_verified_offset, result.biggest_verified_offset);
+    if (result.block_errors != 0)
+      m_block_errors[group.partition] += result.block_errors;
+    if (result.unused_block_errors != 0)
+      m_unused_block_errors[group.partition] += result.unused_block_errors;
+  }
+}
+
+VolumeVerifier::BlockVerificationResult
+VolumeVerifier::VerifyBlocks(const GroupToVerify& group, size_t block_index_start,
+                             size_t block_index_end, bool read_failed) const
+{
+  BlockVerificationResult result;
+
+  u64 offset_in_group = (block_index_start - group.block_index_start) * VolumeWii::BLOCK_TOTAL_SIZE;
+  for (size_t block_index = block_index_start; block_index < block_index_end;
+       ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
+  {
+    const u64 block_offset = group.offset + offset_in_group;
+
+    if (!read_failed && m_volume.CheckBlockIntegrity(
+                            block_index, m_data.data() + offset_in_group, group.partition))
+    {
+      result.biggest_verified_offset =
+          std::max(result.biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+    }
+    else
+    {
+      if (m_scrubber.CanBlockBeScrubbed(block_offset))
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+        result.unused_block_errors++;
+      }
+      else
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+        result.block_errors++;
+      }
+    }
+  }
+
+  return result;
+}
+
 u64 VolumeVerifier::GetBytesProcessed() const
 {
   return m_progress;
@@ -144,6 +144,15 @@ private:
     size_t block_index_end;
   };
 
+  struct BlockVerificationResult
+  {
+    u64 biggest_verified_offset = 0;
+    size_t block_errors = 0;
+    size_t unused_block_errors = 0;
+  };
+
+  static constexpr unsigned int MAX_BLOCK_VERIFICATION_THREADS = 4;
+
   std::vector<Partition> CheckPartitions();
   bool CheckPartition(const Partition& partition);  // Returns false if partition should be ignored
   std::string GetPartitionName(std::optional<u32> type) const;
@@ -158,6 +167,9 @@ private:
   void SetUpHashing();
   void WaitForAsyncOperations() const;
   bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  void VerifyGroup(const GroupToVerify& group, bool read_failed);
+  BlockVerificationResult VerifyBlocks(const GroupToVerify& group, size_t block_index_start,
+                                       size_t block_index_end, bool read_failed) const;
 
   void AddProblem(Severity severity, std::string text);
 
@@ -240,6 +240,15 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
   return true;
 }
 
+const u8* VolumeWii::GetDirectView(u64 offset, u64 length, const Partition& partition) const
+{
+  // Reads from partitions need decryption or at least hash stripping
+  if (partition != PARTITION_NONE)
+    return nullptr;
+
+  return m_reader->GetDirectView(offset, length);
+}
+
 bool VolumeWii::HasWiiHashes() const
 {
   return m_has_hashes;
@@ -468,14 +477,10 @@ bool VolumeWii::CheckBlockIntegrity(u64 block_index, const u8* encrypted_data,
     cluster_data = encrypted_data + BLOCK_HEADER_SIZE;
   }
 
-  for (u32 hash_index = 0; hash_index < 31; ++hash_index)
-  {
-    if (Common::SHA1::CalculateDigest(&cluster_data[hash_index * 0x400], 0x400) !=
-        hashes.h0[hash_index])
-    {
-      return false;
-    }
-  }
+  std::array<Common::SHA1::Digest, 31> h0;
+  Common::SHA1::CalculateDigests(cluster_data, 0x400, h0.size(), h0.data());
+  if (h0 != hashes.h0)
+    return false;
 
   if (Common::SHA1::CalculateDigest(hashes.h0) != hashes.h1[block_index % 8])
     return false;
@@ -526,8 +531,7 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
       if (success)
       {
         // H0 hashes
-        for (size_t j = 0; j < 31; ++j)
-          out[i].h0[j] = Common::SHA1::CalculateDigest(in[i].data() + j * 0x400, 0x400);
+        Common::SHA1::CalculateDigests(in[i].data(), 0x400, out[i].h0.size(), out[i].h0.data());
 
         // H0 padding
         out[i].padding_0 = {};
@@ -5,8 +5,11 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
+#include <future>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -158,6 +161,13 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
     return false;
   }
 
+  if (RVZ && m_compression_type == WIARVZCompressionType::Zstd &&
+      header_2_size >= sizeof(WIAHeader2) + sizeof(RVZDictionaryHeader))
+  {
+    if (!LoadZstdDictionary(header_2, path))
+      return false;
+  }
+
   const size_t number_of_partition_entries = Common::swap32(m_header_2.number_of_partition_entries);
   const size_t partition_entry_size = Common::swap32(m_header_2.partition_entry_size);
   std::vector<u8> partition_entries(partition_entry_size * number_of_partition_entries);
@@ -236,6 +246,36 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
   return true;
 }
 
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::LoadZstdDictionary(const std::vector<u8>& header_2,
+                                               const std::string& path)
+{
+  RVZDictionaryHeader dictionary_header;
+  std::memcpy(&dictionary_header, header_2.data() + sizeof(WIAHeader2), sizeof(dictionary_header));
+
+  const u32 dictionary_size = Common::swap32(dictionary_header.dictionary_size);
+  if (dictionary_size == 0)
+    return true;
+
+  std::vector<u8> dictionary(dictionary_size);
+  if (!m_file.Seek(Common::swap64(dictionary_header.dictionary_offset), File::SeekOrigin::Begin))
+    return false;
+  if (!m_file.ReadBytes(dictionary.data(), dictionary.size()))
+    return false;
+
+  if (dictionary_header.dictionary_hash != Common::SHA1::CalculateDigest(dictionary))
+    return false;
+
+  m_zstd_dictionary.reset(ZSTD_createDDict(dictionary.data(), dictionary.size()));
+  if (!m_zstd_dictionary)
+  {
+    ERROR_LOG_FMT(DISCIO, "Invalid Zstandard dictionary in {}", path);
+    return false;
+  }
+
+  return true;
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::HasDataOverlap() const
 {
@@ -508,19 +548,11 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
     const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
-
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
 
-      group_data_size &= 0x7FFFFFFF;
-
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
-    }
+    u32 group_data_size;
+    WIARVZCompressionType compression_type;
+    u32 rvz_packed_size;
+    GetGroupCompression(group, &group_data_size, &compression_type, &rvz_packed_size);
 
     if (group_data_size == 0)
     {
@@ -536,7 +568,7 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
 
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        RemoveCachedChunk(group_offset_in_file);
         return false;
       }
 
@@ -551,6 +583,29 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
       }
     }
 
+    // If this read reached the end of the group, the next group is likely to be read soon
+    const u64 next_group_offset_in_data = group_offset_in_data + chunk_size;
+    if (offset_in_group + bytes_to_read == chunk_size && i + 1 < number_of_groups &&
+        total_group_index + 1 < m_group_entries.size() && next_group_offset_in_data < data_size)
+    {
+      const GroupEntry& next_group = m_group_entries[total_group_index + 1];
+
+      u32 next_group_data_size;
+      WIARVZCompressionType next_compression_type;
+      u32 next_rvz_packed_size;
+      GetGroupCompression(next_group, &next_group_data_size, &next_compression_type,
+                          &next_rvz_packed_size);
+
+      if (next_group_data_size != 0)
+      {
+        StartReadAhead(static_cast<u64>(Common::swap32(next_group.data_offset)) << 2,
+                       next_group_data_size,
+                       std::min(chunk_size, data_size - next_group_offset_in_data),
+                       next_compression_type, exception_lists, next_rvz_packed_size,
+                       next_group_offset_in_data);
+      }
+    }
+
     *offset += bytes_to_read;
     *size -= bytes_to_read;
     *out_ptr += bytes_to_read;
@@ -559,6 +614,26 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::GetGroupCompression(const GroupEntry& group, u32* group_data_size,
+                                                WIARVZCompressionType* compression_type,
+                                                u32* rvz_packed_size) const
+{
+  *group_data_size = Common::swap32(group.data_size);
+  *compression_type = m_compression_type;
+  *rvz_packed_size = 0;
+
+  if constexpr (RVZ)
+  {
+    if ((*group_data_size & 0x80000000) == 0)
+      *compression_type = WIARVZCompressionType::None;
+
+    *group_data_size &= 0x7FFFFFFF;
+
+    *rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -566,9 +641,36 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  for (auto it = m_cached_chunks.begin(); it != m_cached_chunks.end(); ++it)
+  {
+    if (it->offset_in_file == offset_in_file)
+    {
+      m_cached_chunks.splice(m_cached_chunks.begin(), m_cached_chunks, it);
+      return m_cached_chunks.front().chunk;
+    }
+  }
 
+  if (m_read_ahead.valid() && m_read_ahead_offset == offset_in_file)
+  {
+    CollectReadAhead(true);
+    if (!m_cached_chunks.empty() && m_cached_chunks.front().offset_in_file == offset_in_file)
+      return m_cached_chunks.front().chunk;
+
+    // The read-ahead failed. Try again on this thread so that the error gets reported normally.
+  }
+
+  return AddCachedChunk(offset_in_file,
+                        CreateChunk(offset_in_file, compressed_size, decompressed_size,
+                                    compression_type, exception_lists, rvz_packed_size,
+                                    data_offset));
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
+                                   WIARVZCompressionType compression_type, u32 exception_lists,
+                                   u32 rvz_packed_size, u64 data_offset)
+{
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -591,17 +693,87 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                                       m_header_2.compressor_data_size);
     break;
   case WIARVZCompressionType::Zstd:
-    decompressor = std::make_unique<ZstdDecompressor>();
+    decompressor = std::make_unique<ZstdDecompressor>(m_zstd_dictionary.get());
     break;
   }
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(&m_file, &m_file_mutex, offset_in_file, compressed_size, decompressed_size,
+               exception_lists, compressed_exception_lists, rvz_packed_size, data_offset,
+               std::move(decompressor));
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk& WIARVZFileReader<RVZ>::AddCachedChunk(u64 offset_in_file,
+                                                                             Chunk chunk)
+{
+  m_cached_chunks_memory_usage += chunk.GetMemoryUsage();
+  m_cached_chunks.push_front(CachedChunk{offset_in_file, std::move(chunk)});
+
+  while (m_cached_chunks_memory_usage > CHUNK_CACHE_BUDGET && m_cached_chunks.size() > 1)
+  {
+    m_cached_chunks_memory_usage -= m_cached_chunks.back().chunk.GetMemoryUsage();
+    m_cached_chunks.pop_back();
+  }
+
+  return m_cached_chunks.front().chunk;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::RemoveCachedChunk(u64 offset_in_file)
+{
+  for (auto it = m_cached_chunks.begin(); it != m_cached_chunks.end(); ++it)
+  {
+    if (it->offset_in_file == offset_in_file)
+    {
+      m_cached_chunks_memory_usage -= it->chunk.GetMemoryUsage();
+      m_cached_chunks.erase(it);
+      return;
+    }
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::CollectReadAhead(bool wait)
+{
+  if (!m_read_ahead.valid())
+    return;
+
+  if (!wait && m_read_ahead.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    return;
+
+  std::optional<Chunk> chunk = m_read_ahead.get();
+  if (chunk)
+    AddCachedChunk(m_read_ahead_offset, std::move(*chunk));
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::StartReadAhead(u64 offset_in_file, u64 compressed_size,
+                                           u64 decompressed_size,
+                                           WIARVZCompressionType compression_type,
+                                           u32 exception_lists, u32 rvz_packed_size,
+                                           u64 data_offset)
+{
+  // Only one chunk is read ahead at a time. If the previous one is still being decompressed,
+  // reading is going faster than decompression and there is nothing to gain from another thread.
+  CollectReadAhead(false);
+  if (m_read_ahead.valid())
+    return;
+
+  for (const CachedChunk& cached_chunk : m_cached_chunks)
+  {
+    if (cached_chunk.offset_in_file == offset_in_file)
+      return;
+  }
+
+  m_read_ahead_offset = offset_in_file;
+  m_read_ahead = std::async(
+      std::launch::async,
+      [chunk = CreateChunk(offset_in_file, compressed_size, decompressed_size, compression_type,
+                           exception_lists, rvz_packed_size, data_offset)]() mutable {
+        return chunk.DecompressAll() ? std::optional<Chunk>(std::move(chunk)) : std::nullopt;
+      });
 }
 
 template <bool RVZ>
@@ -619,14 +791,13 @@ std::string WIARVZFileReader<RVZ>::VersionToString(u32 version)
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::Chunk::Chunk() = default;
-
-template <bool RVZ>
-WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, std::mutex* file_mutex,
+                                    u64 offset_in_file, u64 compressed_size,
                                     u64 decompressed_size, u32 exception_lists,
                                     bool compressed_exception_lists, u32 rvz_packed_size,
                                     u64 data_offset, std::unique_ptr<Decompressor> decompressor)
-    : m_decompressor(std::move(decompressor)), m_file(file), m_offset_in_file(offset_in_file),
+    : m_decompressor(std::move(decompressor)), m_file(file), m_file_mutex(file_mutex),
+      m_offset_in_file(offset_in_file),
       m_exception_lists(exception_lists), m_compressed_exception_lists(compressed_exception_lists),
       m_rvz_packed_size(rvz_packed_size), m_data_offset(data_offset)
 {
@@ -645,16 +816,29 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 {
-  if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
-  {
+  if (!DecompressUpTo(offset + size))
     return false;
-  }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  return DecompressUpTo(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUpTo(u64 end)
+{
+  if (!m_decompressor || !m_file || end > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
+    return false;
+
+  while (end > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -667,7 +851,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -685,10 +869,13 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
       return false;
     }
 
-    if (!m_file->Seek(m_offset_in_file, File::SeekOrigin::Begin))
-      return false;
-    if (!m_file->ReadBytes(m_in.data.data() + m_in.bytes_written, bytes_to_read))
-      return false;
+    {
+      std::lock_guard lk(*m_file_mutex);
+      if (!m_file->Seek(m_offset_in_file, File::SeekOrigin::Begin))
+        return false;
+      if (!m_file->ReadBytes(m_in.data.data() + m_in.bytes_written, bytes_to_read))
+        return false;
+    }
 
     m_offset_in_file += bytes_to_read;
     m_in.bytes_written += bytes_to_read;
@@ -747,7 +934,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1055,7 +1241,8 @@ std::optional<std::vector<u8>> WIARVZFileReader<RVZ>::Compress(Compressor* compr
 template <bool RVZ>
 void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                                             WIARVZCompressionType compression_type,
-                                            int compression_level, WIAHeader2* header_2)
+                                            int compression_level,
+                                            const ZSTD_CDict* zstd_dictionary, WIAHeader2* header_2)
 {
   switch (compression_type)
   {
@@ -1086,7 +1273,7 @@ void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compres
     break;
   }
   case WIARVZCompressionType::Zstd:
-    *compressor = std::make_unique<ZstdCompressor>(compression_level);
+    *compressor = std::make_unique<ZstdCompressor>(compression_level, zstd_dictionary);
     break;
   }
 }
@@ -1729,10 +1916,23 @@ template <bool RVZ>
 ConversionResultCode
 WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                File::IOFile* outfile, WIARVZCompressionType compression_type,
-                               int compression_level, int chunk_size, CompressCB callback)
+                               int compression_level, int chunk_size,
+                               const std::vector<u8>& zstd_dictionary, CompressCB callback)
 {
   ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
   ASSERT(chunk_size > 0);
+  ASSERT(zstd_dictionary.empty() || (RVZ && compression_type == WIARVZCompressionType::Zstd));
+
+  ZstdCompressionDictionary zstd_cdict;
+  if (!zstd_dictionary.empty())
+  {
+    zstd_cdict.reset(
+        ZSTD_createCDict(zstd_dictionary.data(), zstd_dictionary.size(), compression_level));
+    if (!zstd_cdict)
+      return ConversionResultCode::InternalError;
+  }
+  const size_t header_2_size =
+      sizeof(WIAHeader2) + (zstd_dictionary.empty() ? 0 : sizeof(RVZDictionaryHeader));
 
   const u64 iso_size = infile->GetDataSize();
   const u64 chunks_per_wii_group = std::max<u64>(1, VolumeWii::GROUP_TOTAL_SIZE / chunk_size);
@@ -1774,8 +1974,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   // fit on that space, we will need to write them at the end of the file instead.
   const u64 headers_size_upper_bound = [&] {
     // 0x100 is added to account for compression overhead (in particular for Purge).
-    u64 upper_bound = sizeof(WIAHeader1) + sizeof(WIAHeader2) + partition_entries_size +
-                      raw_data_entries_size + 0x100;
+    u64 upper_bound = sizeof(WIAHeader1) + header_2_size + zstd_dictionary.size() +
+                      partition_entries_size + raw_data_entries_size + 0x100;
 
     // RVZ's added data in GroupEntry usually compresses well, so we'll assume the compression ratio
     // for RVZ GroupEntries is 9 / 16 or better. This constant is somehwat arbitrarily chosen, but
@@ -1804,7 +2004,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   std::mutex reusable_groups_mutex;
 
   const auto set_up_compress_thread_state = [&](CompressThreadState* state) {
-    SetUpCompressor(&state->compressor, compression_type, compression_level, nullptr);
+    SetUpCompressor(&state->compressor, compression_type, compression_level, zstd_cdict.get(),
+                    nullptr);
     return ConversionResultCode::Success;
   };
 
@@ -1933,7 +2134,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
     return status;
 
   std::unique_ptr<Compressor> compressor;
-  SetUpCompressor(&compressor, compression_type, compression_level, &header_2);
+  SetUpCompressor(&compressor, compression_type, compression_level, zstd_cdict.get(), &header_2);
 
   const std::optional<std::vector<u8>> compressed_raw_data_entries = Compress(
       compressor.get(), reinterpret_cast<u8*>(raw_data_entries.data()), raw_data_entries_size);
@@ -1945,10 +2146,25 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   if (!compressed_group_entries)
     return ConversionResultCode::InternalError;
 
-  bytes_written = sizeof(WIAHeader1) + sizeof(WIAHeader2);
-  if (!outfile->Seek(sizeof(WIAHeader1) + sizeof(WIAHeader2), File::SeekOrigin::Begin))
+  bytes_written = sizeof(WIAHeader1) + header_2_size;
+  if (!outfile->Seek(sizeof(WIAHeader1) + header_2_size, File::SeekOrigin::Begin))
     return ConversionResultCode::WriteFailed;
 
+  RVZDictionaryHeader dictionary_header{};
+  if (!zstd_dictionary.empty())
+  {
+    u64 dictionary_offset;
+    if (!WriteHeader(outfile, zstd_dictionary.data(), zstd_dictionary.size(),
+                     headers_size_upper_bound, &bytes_written, &dictionary_offset))
+    {
+      return ConversionResultCode::WriteFailed;
+    }
+
+    dictionary_header.dictionary_offset = Common::swap64(dictionary_offset);
+    dictionary_header.dictionary_size = Common::swap32(static_cast<u32>(zstd_dictionary.size()));
+    dictionary_header.dictionary_hash = Common::SHA1::CalculateDigest(zstd_dictionary);
+  }
+
   u64 partition_entries_offset;
   if (!WriteHeader(outfile, reinterpret_cast<u8*>(partition_entries.data()), partition_entries_size,
                    headers_size_upper_bound, &bytes_written, &partition_entries_offset))
@@ -2001,13 +2217,21 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   header_2.group_entries_offset = Common::swap64(group_entries_offset);
   header_2.group_entries_size = Common::swap32(static_cast<u32>(compressed_group_entries->size()));
 
+  std::vector<u8> header_2_data;
+  header_2_data.reserve(header_2_size);
+  PushBack(&header_2_data, header_2);
+  if (!zstd_dictionary.empty())
+    PushBack(&header_2_data, dictionary_header);
+
+  u32 version_compatible = RVZ ? RVZ_VERSION_WRITE_COMPATIBLE : WIA_VERSION_WRITE_COMPATIBLE;
+  if (!zstd_dictionary.empty())
+    version_compatible = RVZ_VERSION_WRITE_COMPATIBLE_DICTIONARY;
+
   header_1.magic = RVZ ? RVZ_MAGIC : WIA_MAGIC;
   header_1.version = Common::swap32(RVZ ? RVZ_VERSION : WIA_VERSION);
-  header_1.version_compatible =
-      Common::swap32(RVZ ? RVZ_VERSION_WRITE_COMPATIBLE : WIA_VERSION_WRITE_COMPATIBLE);
-  header_1.header_2_size = Common::swap32(sizeof(WIAHeader2));
-  header_1.header_2_hash =
-      Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_2), sizeof(header_2));
+  header_1.version_compatible = Common::swap32(version_compatible);
+  header_1.header_2_size = Common::swap32(static_cast<u32>(header_2_data.size()));
+  header_1.header_2_hash = Common::SHA1::CalculateDigest(header_2_data);
   header_1.iso_file_size = Common::swap64(infile->GetDataSize());
   header_1.wia_file_size = Common::swap64(outfile->GetSize());
   header_1.header_1_hash = Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_1),
@@ -2018,7 +2242,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   if (!outfile->WriteArray(&header_1, 1))
     return ConversionResultCode::WriteFailed;
-  if (!outfile->WriteArray(&header_2, 1))
+  if (!outfile->WriteBytes(header_2_data.data(), header_2_data.size()))
     return ConversionResultCode::WriteFailed;
 
   return ConversionResultCode::Success;
@@ -2027,7 +2251,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback)
+                       int chunk_size, const std::vector<u8>& zstd_dictionary,
+                       CompressCB callback)
 {
   File::IOFile outfile(outfile_path, "wb");
   if (!outfile)
@@ -2045,7 +2270,7 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
   const auto convert = rvz ? RVZFileReader::Convert : WIAFileReader::Convert;
   const ConversionResultCode result =
       convert(infile, infile_volume.get(), &outfile, compression_type, compression_level,
-              chunk_size, callback);
+              chunk_size, zstd_dictionary, callback);
 
   if (result == ConversionResultCode::ReadFailed)
     PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
@@ -4,12 +4,16 @@
 #pragma once
 
 #include <array>
+#include <future>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
@@ -68,7 +72,8 @@ public:
 
   static ConversionResultCode Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
-                                      int compression_level, int chunk_size, CompressCB callback);
+                                      int compression_level, int chunk_size,
+                                      const std::vector<u8>& zstd_dictionary, CompressCB callback);
 
 private:
   using WiiKey = std::array<u8, 16>;
@@ -116,6 +121,15 @@ private:
   };
   static_assert(sizeof(WIAHeader2) == 0xdc, "Wrong size for WIA header 2");
 
+  // Appended to WIAHeader2 in RVZ files that use a Zstandard dictionary
+  struct RVZDictionaryHeader
+  {
+    u64 dictionary_offset;
+    u32 dictionary_size;
+    Common::SHA1::Digest dictionary_hash;
+  };
+  static_assert(sizeof(RVZDictionaryHeader) == 0x20, "Wrong size for RVZ dictionary header");
+
   struct PartitionDataEntry
   {
     u32 first_sector;
@@ -186,13 +200,17 @@ private:
   class Chunk
   {
   public:
-    Chunk();
-    Chunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
-          u32 exception_lists, bool compressed_exception_lists, u32 rvz_packed_size,
-          u64 data_offset, std::unique_ptr<Decompressor> decompressor);
+    Chunk(File::IOFile* file, std::mutex* file_mutex, u64 offset_in_file, u64 compressed_size,
+          u64 decompressed_size, u32 exception_lists, bool compressed_exception_lists,
+          u32 rvz_packed_size, u64 data_offset, std::unique_ptr<Decompressor> decompressor);
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Decompresses the whole chunk without copying any data out of it
+    bool DecompressAll();
+
+    size_t GetMemoryUsage() const { return m_in.data.size() + m_out.data.size(); }
+
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
                            u64 exception_list_index, u16 additional_offset) const;
@@ -204,6 +222,7 @@ private:
     }
 
   private:
+    bool DecompressUpTo(u64 end);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -216,6 +235,7 @@ private:
 
     std::unique_ptr<Decompressor> m_decompressor = nullptr;
     File::IOFile* m_file = nullptr;
+    std::mutex* m_file_mutex = nullptr;
     u64 m_offset_in_file = 0;
 
     size_t m_out_bytes_allocated_for_exceptions = 0;
@@ -229,6 +249,7 @@ private:
 
   explicit WIARVZFileReader(File::IOFile file, const std::string& path);
   bool Initialize(const std::string& path);
+  bool LoadZstdDictionary(const std::vector<u8>& header_2, const std::string& path);
   bool HasDataOverlap() const;
 
   const PartitionEntry* GetPartition(u64 partition_data_offset, u32* partition_first_sector) const;
@@ -239,6 +260,17 @@ private:
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk CreateChunk(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
+                    WIARVZCompressionType compression_type, u32 exception_lists,
+                    u32 rvz_packed_size, u64 data_offset);
+  Chunk& AddCachedChunk(u64 offset_in_file, Chunk chunk);
+  void RemoveCachedChunk(u64 offset_in_file);
+  void CollectReadAhead(bool wait);
+  void StartReadAhead(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
+                      WIARVZCompressionType compression_type, u32 exception_lists,
+                      u32 rvz_packed_size, u64 data_offset);
+  void GetGroupCompression(const GroupEntry& group, u32* group_data_size,
+                           WIARVZCompressionType* compression_type, u32* rvz_packed_size) const;
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -342,7 +374,7 @@ private:
 
   static void SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                               WIARVZCompressionType compression_type, int compression_level,
-                              WIAHeader2* header_2);
+                              const ZSTD_CDict* zstd_dictionary, WIAHeader2* header_2);
   static bool TryReuse(std::map<ReuseID, GroupEntry>* reusable_groups,
                        std::mutex* reusable_groups_mutex, OutputParametersEntry* entry);
   static ConversionResult<OutputParameters>
@@ -364,9 +396,28 @@ private:
   bool m_valid;
   WIARVZCompressionType m_compression_type;
 
+  struct CachedChunk
+  {
+    u64 offset_in_file;
+    Chunk chunk;
+  };
+
+  // Declared before the chunk cache, since the decompressors of cached chunks refer to it
+  ZstdDecompressionDictionary m_zstd_dictionary;
+
   File::IOFile m_file;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+  std::mutex m_file_mutex;
+
+  // Most recently used first. Kept within CHUNK_CACHE_BUDGET bytes, except that the most recently
+  // used chunk is always kept, so that references returned by ReadCompressedData stay valid.
+  std::list<CachedChunk> m_cached_chunks;
+  size_t m_cached_chunks_memory_usage = 0;
+
+  // Declared after m_file and m_file_mutex so that a pending read-ahead finishes before they are
+  // destroyed (the destructor of a future returned by std::async blocks)
+  u64 m_read_ahead_offset = 0;
+  std::future<std::optional<Chunk>> m_read_ahead;
+
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
@@ -389,8 +440,14 @@ private:
   static constexpr u32 WIA_VERSION_WRITE_COMPATIBLE = 0x01000000;
   static constexpr u32 WIA_VERSION_READ_COMPATIBLE = 0x00080000;
 
-  static constexpr u32 RVZ_VERSION = 0x01000000;
+  // Enough to keep a few streams (e.g. streamed audio and level data) of the largest common chunk
+  // sizes decompressed at the same time
+  static constexpr size_t CHUNK_CACHE_BUDGET = 32 * 1024 * 1024;
+
+  static constexpr u32 RVZ_VERSION = 0x01010000;
   static constexpr u32 RVZ_VERSION_WRITE_COMPATIBLE = 0x00030000;
+  // Older versions can't decompress data that was compressed using a dictionary
+  static constexpr u32 RVZ_VERSION_WRITE_COMPATIBLE_DICTIONARY = 0x01010000;
   static constexpr u32 RVZ_VERSION_READ_COMPATIBLE = 0x00030000;
 };
 
@@ -24,6 +24,16 @@ struct DecompressionBuffer
   size_t bytes_written = 0;
 };
 
+// Zstandard dictionaries are digested once and can then be used by several (de)compressors,
+// including ones running on different threads
+struct ZstdDictionaryDeleter
+{
+  void operator()(ZSTD_CDict* dictionary) const { ZSTD_freeCDict(dictionary); }
+  void operator()(ZSTD_DDict* dictionary) const { ZSTD_freeDDict(dictionary); }
+};
+using ZstdCompressionDictionary = std::unique_ptr<ZSTD_CDict, ZstdDictionaryDeleter>;
+using ZstdDecompressionDictionary = std::unique_ptr<ZSTD_DDict, ZstdDictionaryDeleter>;
+
 struct PurgeSegment
 {
   u32 offset;
@@ -105,7 +115,8 @@ private:
 class ZstdDecompressor final : public Decompressor
 {
 public:
-  ZstdDecompressor();
+  // dictionary may be nullptr. If it isn't, it must outlive the decompressor.
+  explicit ZstdDecompressor(const ZSTD_DDict* dictionary);
   ~ZstdDecompressor();
 
   bool Decompress(const DecompressionBuffer& in, DecompressionBuffer* out,
@@ -228,7 +239,9 @@ private:
 class ZstdCompressor final : public Compressor
 {
 public:
-  ZstdCompressor(int compression_level);
+  // dictionary may be nullptr. If it isn't, it must outlive the compressor, and the compression
+  // level it was created with is used instead of compression_level.
+  ZstdCompressor(int compression_level, const ZSTD_CDict* dictionary);
   ~ZstdCompressor();
 
   bool Start(std::optional<u64> size) override;
@@ -4,11 +4,16 @@
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <iostream>
+#include <mutex>
 #include <signal.h>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifndef _WIN32
@@ -17,13 +22,21 @@
 #include <Windows.h>
 #endif
 
+#include "Common/Config/Config.h"
+#include "Common/Event.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/Host.h"
+#include "Core/Movie.h"
+#include "Core/PerformanceReport.h"
+#include "Core/State.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -37,6 +50,12 @@
 #include "VideoCommon/VideoBackendBase.h"
 
 static std::unique_ptr<Platform> s_platform;
+// Reading from stdin can't be interrupted, so on shutdown the main thread leaves the
+// --snapshot_server thread behind if it's waiting for a request, and otherwise joins it.
+static std::mutex s_snapshot_server_mutex;
+static bool s_snapshot_server_reading = false;
+static bool s_snapshot_server_stopping = false;
+static Common::Event s_snapshot_server_frames_done;
 
 static void signal_handler(int)
 {
@@ -176,6 +195,86 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+static bool IsSnapshotServerStopping()
+{
+  std::lock_guard lk(s_snapshot_server_mutex);
+  return s_snapshot_server_stopping;
+}
+
+// Waits for the frames that PerformanceReport was told to measure. Returns false if the server
+// should stop first.
+static bool WaitForSnapshotServerFrames()
+{
+  while (!s_snapshot_server_frames_done.WaitFor(std::chrono::milliseconds(100)))
+  {
+    if (IsSnapshotServerStopping())
+      return false;
+  }
+  return true;
+}
+
+// Runs on its own thread for --snapshot_server, while the main thread runs the platform's main
+// loop as usual. The warm-up frames are measured like --perf_report frames.
+static void RunSnapshotServer()
+{
+  if (!WaitForSnapshotServerFrames())
+    return;
+
+  State::Snapshot snapshot;
+  State::SaveSnapshot(snapshot);
+  std::cout << "ready" << std::endl;
+
+  std::string line;
+  while (true)
+  {
+    {
+      std::lock_guard lk(s_snapshot_server_mutex);
+      if (s_snapshot_server_stopping)
+        return;
+      s_snapshot_server_reading = true;
+    }
+
+    const bool has_request = static_cast<bool>(std::getline(std::cin, line));
+
+    {
+      std::lock_guard lk(s_snapshot_server_mutex);
+      if (s_snapshot_server_stopping)
+        return;
+      s_snapshot_server_reading = false;
+    }
+
+    if (!has_request)
+      break;
+
+    std::istringstream request(line);
+    u32 num_frames = 0;
+    std::string report_path;
+    if (!(request >> num_frames >> report_path) || num_frames == 0)
+    {
+      std::cout << "error Expected <frames> <report file>" << std::endl;
+      continue;
+    }
+
+    // Measuring has to start on the CPU thread, right after the snapshot is restored.
+    Core::RunOnCPUThread(
+        [&] {
+          State::LoadSnapshot(snapshot);
+          s_snapshot_server_frames_done.Reset();
+          PerformanceReport::Start(num_frames, [] { s_snapshot_server_frames_done.Set(); });
+        },
+        true);
+    if (!WaitForSnapshotServerFrames())
+      return;
+
+    if (PerformanceReport::WriteReport(report_path))
+      std::cout << "done " << report_path << std::endl;
+    else
+      std::cout << "error Could not write " << report_path << std::endl;
+  }
+
+  s_platform->Stop();
+}
+
 #ifdef _WIN32
 #define main app_main
 #endif
@@ -201,6 +300,36 @@ int main(int argc, char* argv[])
             "win32"
 #endif
       });
+  parser->add_option("--turbo")
+      .action("store_true")
+      .help("Run as fast as possible without presenting frames");
+  parser->add_option("--fifo_benchmark")
+      .action("store")
+      .metavar("<loops>")
+      .help("Play a FIFO log the given number of times in single core mode, then write the time, "
+            "draw calls and shader compilations of every frame as JSON");
+  parser->add_option("--fifo_benchmark_output")
+      .action("store")
+      .metavar("<file>")
+      .set_default("fifo_benchmark.json")
+      .help("Where to write the --fifo_benchmark results [default: %default]");
+  parser->add_option("--perf_report")
+      .action("store")
+      .metavar("<file>")
+      .help("Run as fast as possible for --perf_frames frames, then write the emulation speed, "
+            "frame times, JIT and shader compilations and peak memory usage as JSON");
+  parser->add_option("--perf_frames")
+      .action("store")
+      .metavar("<frames>")
+      .set_default("3600")
+      .help("How many frames (VI fields) --perf_report measures [default: %default]");
+  parser->add_option("--snapshot_server")
+      .action("store")
+      .metavar("<frames>")
+      .help("Run the given number of frames, then keep a snapshot of the emulated state. Every "
+            "'<frames> <report file>' line read from stdin restores the snapshot and writes a "
+            "--perf_report of that many frames, without booting again. Lines starting with "
+            "'ready', 'done' or 'error' are written to stdout in response");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -247,6 +376,55 @@ int main(int argc, char* argv[])
     return 0;
   }
 
+  u32 fifo_benchmark_loops = 0;
+  if (options.is_set("fifo_benchmark") &&
+      (!TryParse(static_cast<const char*>(options.get("fifo_benchmark")), &fifo_benchmark_loops) ||
+       fifo_benchmark_loops == 0))
+  {
+    fprintf(stderr, "Invalid number of FIFO benchmark loops\n");
+    return 1;
+  }
+
+  u32 perf_report_frames = 0;
+  if (options.is_set("perf_report") &&
+      (!TryParse(static_cast<const char*>(options.get("perf_frames")), &perf_report_frames) ||
+       perf_report_frames == 0))
+  {
+    fprintf(stderr, "Invalid number of performance report frames\n");
+    return 1;
+  }
+
+  u32 snapshot_server_frames = 0;
+  if (options.is_set("snapshot_server") &&
+      (!TryParse(static_cast<const char*>(options.get("snapshot_server")),
+                 &snapshot_server_frames) ||
+       snapshot_server_frames == 0 || perf_report_frames != 0))
+  {
+    fprintf(stderr, "Invalid number of snapshot server frames, or --perf_report was also set\n");
+    return 1;
+  }
+
+  if (options.is_set("movie"))
+  {
+    if (!game_specified)
+    {
+      fprintf(stderr, "A movie cannot be played without specifying a game to launch.\n");
+      return 1;
+    }
+
+    std::optional<std::string> movie_save_state_path;
+    if (!Movie::PlayInput(static_cast<const char*>(options.get("movie")), &movie_save_state_path))
+    {
+      fprintf(stderr, "Could not play the specified movie\n");
+      return 1;
+    }
+    if (movie_save_state_path)
+    {
+      boot->boot_session_data.SetSavestateData(std::move(movie_save_state_path),
+                                               DeleteSavestateAfterBoot::No);
+    }
+  }
+
   std::string user_directory;
   if (options.is_set("user"))
     user_directory = static_cast<const char*>(options.get("user"));
@@ -264,6 +442,34 @@ int main(int argc, char* argv[])
   UICommon::Init();
   UICommon::InitControllers(wsi);
 
+  if (options.get("turbo"))
+  {
+    // Games can still read back EFB copies and bounding boxes, so those keep being emulated.
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    Config::SetCurrent(Config::GFX_HACK_SKIP_PRESENTATION, true);
+  }
+
+  if (fifo_benchmark_loops != 0)
+  {
+    // Keeps decoding and rendering each frame within the time measured for it.
+    Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+    FifoPlayer::GetInstance().SetBenchmarkLoops(fifo_benchmark_loops);
+  }
+
+  if (perf_report_frames != 0)
+  {
+    // Frames are presented as usual so that the report includes the video backend's work.
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    PerformanceReport::Start(perf_report_frames, [] { s_platform->Stop(); });
+  }
+
+  if (snapshot_server_frames != 0)
+  {
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+    PerformanceReport::Start(snapshot_server_frames,
+                             [] { s_snapshot_server_frames_done.Set(); });
+  }
+
   Common::ScopeGuard ui_common_guard([] {
     UICommon::ShutdownControllers();
     UICommon::Shutdown();
@@ -305,12 +511,46 @@ int main(int argc, char* argv[])
   Discord::UpdateDiscordPresence();
 #endif
 
+  std::thread snapshot_server_thread;
+  if (snapshot_server_frames != 0)
+    snapshot_server_thread = std::thread(RunSnapshotServer);
+
   s_platform->MainLoop();
+
+  // The server thread must be done with the core before it is stopped.
+  if (snapshot_server_thread.joinable())
+  {
+    std::unique_lock lk(s_snapshot_server_mutex);
+    s_snapshot_server_stopping = true;
+    const bool reading = s_snapshot_server_reading;
+    lk.unlock();
+
+    if (reading)
+      snapshot_server_thread.detach();
+    else
+      snapshot_server_thread.join();
+  }
+
   Core::Stop();
 
   Core::Shutdown();
   s_platform.reset();
 
+  if (fifo_benchmark_loops != 0 &&
+      !FifoPlayer::GetInstance().WriteBenchmarkResults(
+          static_cast<const char*>(options.get("fifo_benchmark_output"))))
+  {
+    fprintf(stderr, "Could not write the FIFO benchmark results\n");
+    return 1;
+  }
+
+  if (perf_report_frames != 0 &&
+      !PerformanceReport::WriteReport(static_cast<const char*>(options.get("perf_report"))))
+  {
+    fprintf(stderr, "Could not write a complete performance report\n");
+    return 1;
+  }
+
   return 0;
 }
 
@@ -268,8 +268,8 @@ void AdvancedWidget::AddDescriptions()
                  "unsure, leave this unchecked.</dolphin_emphasis>");
 #endif
   static const char TR_PNG_COMPRESSION_LEVEL_DESCRIPTION[] =
-      QT_TR_NOOP("Specifies the zlib compression level to use when saving PNG images (both for "
-                 "screenshots and framedumping).<br><br>"
+      QT_TR_NOOP("Specifies the zlib compression level to use when saving PNG images (for "
+                 "screenshots, framedumping and texture dumping).<br><br>"
                  "Since PNG uses lossless compression, this does not affect the image quality; "
                  "instead, it is a trade-off between file size and compression time.<br><br>"
                  "A value of 0 uses no compression at all.  A value of 1 uses very little "
@@ -3,7 +3,9 @@
 
 #include "DolphinQt/MenuBar.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <climits>
 #include <future>
 
 #include <QAction>
@@ -41,6 +43,7 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/PowerPC/SignatureDB/SignatureDB.h"
 #include "Core/State.h"
 #include "Core/TitleDatabase.h"
@@ -123,6 +126,7 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
 
   // Movie
   m_recording_read_only->setEnabled(running);
+  m_recording_seek->setEnabled(running && Movie::IsPlayingInput());
   if (!running)
   {
     m_recording_stop->setEnabled(false);
@@ -747,6 +751,16 @@ void MenuBar::AddMovieMenu()
   m_recording_read_only->setChecked(Movie::IsReadOnly());
   connect(m_recording_read_only, &QAction::toggled, [](bool value) { Movie::SetReadOnly(value); });
 
+  m_recording_seek = movie_menu->addAction(tr("&Jump to Frame..."), this, [this] {
+    bool ok;
+    const int frame = QInputDialog::getInt(
+        this, tr("Jump to Frame"), tr("Frame:"), static_cast<int>(Movie::GetCurrentFrame()), 0,
+        static_cast<int>(std::min<u64>(Movie::GetTotalFrames(), INT_MAX)), 1, &ok);
+    if (ok)
+      Movie::SeekToFrame(static_cast<u64>(frame));
+  });
+  m_recording_seek->setEnabled(false);
+
   movie_menu->addAction(tr("TAS Input"), this, [this] { emit ShowTASInput(); });
 
   movie_menu->addSeparator();
@@ -850,6 +864,10 @@ void MenuBar::AddJITMenu()
       m_jit->addAction(tr("Log JIT Instruction Coverage"), this, &MenuBar::LogInstructions);
   m_jit_search_instruction =
       m_jit->addAction(tr("Search for an Instruction"), this, &MenuBar::SearchInstruction);
+  m_jit_sampling_profiler = m_jit->addAction(tr("Sample Guest Code"));
+  m_jit_sampling_profiler->setCheckable(true);
+  m_jit_sampling_profiler->setChecked(SamplingProfiler::IsRunning());
+  connect(m_jit_sampling_profiler, &QAction::toggled, this, &MenuBar::ToggleSamplingProfiler);
 
   m_jit->addSeparator();
 
@@ -1163,6 +1181,7 @@ void MenuBar::OnRecordingStatusChanged(bool recording)
   m_recording_start->setEnabled(!recording && (m_game_selected || Core::IsRunning()));
   m_recording_stop->setEnabled(recording);
   m_recording_export->setEnabled(recording);
+  m_recording_seek->setEnabled(recording && Movie::IsPlayingInput());
 }
 
 void MenuBar::OnReadOnlyModeChanged(bool read_only)
@@ -1648,6 +1667,21 @@ void MenuBar::LogInstructions()
   PPCTables::LogCompiledInstructions();
 }
 
+void MenuBar::ToggleSamplingProfiler(bool enabled)
+{
+  if (enabled)
+  {
+    SamplingProfiler::Start();
+    return;
+  }
+
+  SamplingProfiler::Stop();
+
+  const std::string path = File::GetUserPath(D_LOGS_IDX) + "guest_profile.folded";
+  if (SamplingProfiler::WriteFoldedStacks(path))
+    NOTICE_LOG_FMT(POWERPC, "Wrote guest code samples to {}", path);
+}
+
 void MenuBar::SearchInstruction()
 {
   bool good;
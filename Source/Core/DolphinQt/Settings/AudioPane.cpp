@@ -142,19 +142,31 @@ void AudioPane::CreateWidgets()
   m_stretching_buffer_slider = new QSlider(Qt::Horizontal);
   m_stretching_buffer_indicator = new QLabel();
   m_stretching_buffer_label = new QLabel(tr("Buffer Size:"));
+  m_stretching_quality_label = new QLabel(tr("Quality:"));
+  m_stretching_quality_combo = new QComboBox();
   stretching_box->setLayout(stretching_layout);
 
   m_stretching_buffer_slider->setMinimum(5);
   m_stretching_buffer_slider->setMaximum(300);
 
+  m_stretching_quality_combo->addItem(tr("Fast"),
+                                      static_cast<int>(AudioCommon::StretchQuality::Fast));
+  m_stretching_quality_combo->addItem(tr("Normal"),
+                                      static_cast<int>(AudioCommon::StretchQuality::Normal));
+
   m_stretching_enable->setToolTip(tr("Enables stretching of the audio to match emulation speed."));
   m_stretching_buffer_slider->setToolTip(tr("Size of stretch buffer in milliseconds. "
                                             "Values too low may cause audio crackling."));
+  m_stretching_quality_combo->setToolTip(
+      tr("Fast uses a simpler search when stretching, which costs less CPU time when emulation "
+         "slows down, at some cost in sound quality."));
 
   stretching_layout->addWidget(m_stretching_enable, 0, 0, 1, -1);
   stretching_layout->addWidget(m_stretching_buffer_label, 1, 0);
   stretching_layout->addWidget(m_stretching_buffer_slider, 1, 1);
   stretching_layout->addWidget(m_stretching_buffer_indicator, 1, 2);
+  stretching_layout->addWidget(m_stretching_quality_label, 2, 0);
+  stretching_layout->addWidget(m_stretching_quality_combo, 2, 1, 1, -1);
 
   dsp_box->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 
@@ -185,6 +197,8 @@ void AudioPane::ConnectWidgets()
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_stretching_enable, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
+  connect(m_stretching_quality_combo, qOverload<int>(&QComboBox::currentIndexChanged), this,
+          &AudioPane::SaveSettings);
   connect(m_dsp_hle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_lle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_interpreter, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
@@ -249,6 +263,8 @@ void AudioPane::LoadSettings()
   m_stretching_buffer_slider->setValue(Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY));
   m_stretching_buffer_slider->setEnabled(m_stretching_enable->isChecked());
   m_stretching_buffer_indicator->setText(tr("%1 ms").arg(m_stretching_buffer_slider->value()));
+  m_stretching_quality_combo->setCurrentIndex(m_stretching_quality_combo->findData(
+      static_cast<int>(Config::Get(Config::MAIN_AUDIO_STRETCH_QUALITY))));
 
 #ifdef _WIN32
   if (Config::Get(Config::MAIN_WASAPI_DEVICE) == "default")
@@ -318,6 +334,14 @@ void AudioPane::SaveSettings()
   m_stretching_buffer_indicator->setEnabled(m_stretching_enable->isChecked());
   m_stretching_buffer_indicator->setText(
       tr("%1 ms").arg(Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY)));
+  Config::SetBaseOrCurrent(
+      Config::MAIN_AUDIO_STRETCH_QUALITY,
+      static_cast<AudioCommon::StretchQuality>(m_stretching_quality_combo->currentData().toInt()));
+  // The stretcher picks up its quality setting when emulation starts.
+  const bool stretch_quality_editable =
+      m_stretching_enable->isChecked() && Core::GetState() == Core::State::Uninitialized;
+  m_stretching_quality_label->setEnabled(stretch_quality_editable);
+  m_stretching_quality_combo->setEnabled(stretch_quality_editable);
 
 #ifdef _WIN32
   std::string device = "default";
@@ -393,6 +417,8 @@ void AudioPane::OnEmulationStateChanged(bool running)
     m_latency_label->setEnabled(!running);
     m_latency_spin->setEnabled(!running);
   }
+  m_stretching_quality_label->setEnabled(!running && m_stretching_enable->isChecked());
+  m_stretching_quality_combo->setEnabled(!running && m_stretching_enable->isChecked());
 
 #ifdef _WIN32
   m_wasapi_device_combo->setEnabled(!running);
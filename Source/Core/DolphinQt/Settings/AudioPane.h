@@ -76,4 +76,6 @@ private:
   QLabel* m_stretching_buffer_label;
   QSlider* m_stretching_buffer_slider;
   QLabel* m_stretching_buffer_indicator;
+  QLabel* m_stretching_quality_label;
+  QComboBox* m_stretching_quality_combo;
 };
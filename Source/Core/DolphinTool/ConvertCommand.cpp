@@ -3,15 +3,24 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <OptionParser.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/ScrubbedBlob.h"
@@ -37,13 +46,14 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   parser.add_option("-i", "--input")
       .type("string")
       .action("store")
-      .help("Path to disc image FILE.")
+      .help("Path to disc image FILE, or to a directory of disc images to convert all of them.")
       .metavar("FILE");
 
   parser.add_option("-o", "--output")
       .type("string")
       .action("store")
-      .help("Path to the destination FILE.")
+      .help("Path to the destination FILE, or the destination directory when converting several "
+            "disc images.")
       .metavar("FILE");
 
   parser.add_option("-f", "--format")
@@ -75,6 +85,27 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
       .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
             "zstd: 5");
 
+  parser.add_option("-d", "--zstd_dictionary")
+      .type("string")
+      .action("store")
+      .help("Zstandard dictionary FILE to compress RVZ chunks with, for instance one created with "
+            "'zstd --train'. Improves the compression ratio of small block sizes. The output can "
+            "only be read by Dolphin versions that support RVZ 1.01.")
+      .metavar("FILE");
+
+  parser.add_option("-m", "--manifest")
+      .type("string")
+      .action("store")
+      .help("Path to a FILE listing disc images to convert, one path per line. Converts all of "
+            "them into the directory set with --output.")
+      .metavar("FILE");
+
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Number of disc images to convert at the same time when --input is a directory or "
+            "--manifest is used. Compression threads are shared between them. Default is 2.");
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -88,13 +119,19 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
 
   // Validate options
 
-  // --input
+  // --input, --manifest
   const std::string input_file_path = static_cast<const char*>(options.get("input"));
-  if (input_file_path.empty())
+  const std::string manifest_path = static_cast<const char*>(options.get("manifest"));
+  if (input_file_path.empty() && manifest_path.empty())
   {
     std::cerr << "Error: No input set" << std::endl;
     return 1;
   }
+  if (!input_file_path.empty() && !manifest_path.empty())
+  {
+    std::cerr << "Error: --input and --manifest can't be used together" << std::endl;
+    return 1;
+  }
 
   // --output
   const std::string output_file_path = static_cast<const char*>(options.get("output"));
@@ -112,126 +149,54 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
     std::cerr << "Error: No output format set" << std::endl;
     return 1;
   }
-  const DiscIO::BlobType format = format_o.value();
 
-  // Open the blob reader
-  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
-  if (!blob_reader)
-  {
-    std::cerr << "Error: The input file could not be opened." << std::endl;
-    return 1;
-  }
+  ConversionOptions conversion_options;
+  conversion_options.format = format_o.value();
+  const DiscIO::BlobType format = conversion_options.format;
 
   // --scrub
-  const bool scrub = static_cast<bool>(options.get("scrub"));
-
-  // Open the volume
-  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
-  if (!volume)
-  {
-    if (scrub)
-    {
-      std::cerr << "Error: Scrubbing is only supported for GC/Wii disc images." << std::endl;
-      return 1;
-    }
-
-    std::cerr << "Warning: The input file is not a GC/Wii disc image. Continuing anyway."
-              << std::endl;
-  }
-
-  if (scrub)
-  {
-    if (volume->IsDatelDisc())
-    {
-      std::cerr << "Error: Scrubbing a Datel disc is not supported." << std::endl;
-      return 1;
-    }
-
-    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
-
-    if (!blob_reader)
-    {
-      std::cerr << "Error: Unable to process disc image. Try again without --scrub." << std::endl;
-      return 1;
-    }
-  }
-
-  if (scrub && format == DiscIO::BlobType::RVZ)
-  {
-    std::cerr << "Warning: Scrubbing an RVZ container does not offer significant space advantages. "
-                 "Continuing anyway."
-              << std::endl;
-  }
-
-  if (scrub && format == DiscIO::BlobType::PLAIN)
-  {
-    std::cerr << "Warning: Scrubbing does not save space when converting to ISO unless using "
-                 "external compression. Continuing anyway."
-              << std::endl;
-  }
-
-  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
-      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
-  {
-    std::cerr << "Warning: Converting Wii disc images to GCZ without scrubbing may not offer space "
-                 "advantages over ISO. Continuing anyway."
-              << std::endl;
-  }
-
-  if (volume && volume->IsNKit())
-  {
-    std::cerr << "Warning: Converting an NKit file, output will still be NKit! Continuing anyway."
-              << std::endl;
-  }
+  conversion_options.scrub = static_cast<bool>(options.get("scrub"));
 
   // --block_size
-  std::optional<int> block_size_o;
   if (options.is_set("block_size"))
-    block_size_o = static_cast<int>(options.get("block_size"));
+    conversion_options.block_size = static_cast<int>(options.get("block_size"));
 
   if (format == DiscIO::BlobType::GCZ || format == DiscIO::BlobType::WIA ||
       format == DiscIO::BlobType::RVZ)
   {
-    if (!block_size_o.has_value())
+    if (!conversion_options.block_size.has_value())
     {
       std::cerr << "Error: Block size must be set for GCZ/RVZ/WIA" << std::endl;
       return 1;
     }
 
-    if (!DiscIO::IsDiscImageBlockSizeValid(block_size_o.value(), format))
+    if (!DiscIO::IsDiscImageBlockSizeValid(conversion_options.block_size.value(), format))
     {
       std::cerr << "Error: Block size is not valid for this format" << std::endl;
       return 1;
     }
 
-    if (block_size_o.value() < DiscIO::PREFERRED_MIN_BLOCK_SIZE ||
-        block_size_o.value() > DiscIO::PREFERRED_MAX_BLOCK_SIZE)
+    if (conversion_options.block_size.value() < DiscIO::PREFERRED_MIN_BLOCK_SIZE ||
+        conversion_options.block_size.value() > DiscIO::PREFERRED_MAX_BLOCK_SIZE)
     {
       std::cerr << "Warning: Block size is not ideal for performance. Continuing anyway."
                 << std::endl;
     }
-
-    if (format == DiscIO::BlobType::GCZ && volume &&
-        !DiscIO::IsGCZBlockSizeLegacyCompatible(block_size_o.value(), volume->GetDataSize()))
-    {
-      std::cerr << "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, "
-                   "the file size must be an integer multiple of the block size "
-                   "and must not be an integer multiple of the block size multiplied by 32. "
-                   "Continuing anyway."
-                << std::endl;
-    }
   }
 
   // --compress, --compress_level
-  std::optional<DiscIO::WIARVZCompressionType> compression_o =
+  conversion_options.compression =
       ParseCompressionTypeString(static_cast<const char*>(options.get("compression")));
 
-  std::optional<int> compression_level_o;
   if (options.is_set("compression_level"))
-    compression_level_o = static_cast<int>(options.get("compression_level"));
+    conversion_options.compression_level = static_cast<int>(options.get("compression_level"));
 
   if (format == DiscIO::BlobType::WIA || format == DiscIO::BlobType::RVZ)
   {
+    const std::optional<DiscIO::WIARVZCompressionType>& compression_o =
+        conversion_options.compression;
+    std::optional<int>& compression_level_o = conversion_options.compression_level;
+
     if (!compression_o.has_value())
     {
       std::cerr << "Error: Compression format must be set for WIA or RVZ" << std::endl;
@@ -270,6 +235,233 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
     }
   }
 
+  // --zstd_dictionary
+  if (options.is_set("zstd_dictionary"))
+  {
+    if (format != DiscIO::BlobType::RVZ ||
+        conversion_options.compression.value() != DiscIO::WIARVZCompressionType::Zstd)
+    {
+      std::cerr << "Error: A Zstandard dictionary can only be used for RVZ with zstd compression"
+                << std::endl;
+      return 1;
+    }
+
+    std::vector<u8>& zstd_dictionary = conversion_options.zstd_dictionary;
+    const std::string dictionary_path = static_cast<const char*>(options.get("zstd_dictionary"));
+    File::IOFile dictionary_file(dictionary_path, "rb");
+    zstd_dictionary.resize(dictionary_file.GetSize());
+    if (!dictionary_file || zstd_dictionary.empty() ||
+        !dictionary_file.ReadBytes(zstd_dictionary.data(), zstd_dictionary.size()))
+    {
+      std::cerr << "Error: The Zstandard dictionary could not be read" << std::endl;
+      return 1;
+    }
+  }
+
+  // --jobs
+  int jobs = 2;
+  if (options.is_set("jobs"))
+    jobs = static_cast<int>(options.get("jobs"));
+  if (jobs < 1)
+  {
+    std::cerr << "Error: The number of jobs must be at least 1" << std::endl;
+    return 1;
+  }
+
+  // Perform the conversion
+
+  if (manifest_path.empty() && !File::IsDirectory(input_file_path))
+    return ConvertFile(input_file_path, output_file_path, conversion_options, "") ? 0 : 1;
+
+  std::vector<std::string> input_file_paths;
+  if (!manifest_path.empty())
+  {
+    std::ifstream manifest;
+    File::OpenFStream(manifest, manifest_path, std::ios_base::in);
+    if (!manifest)
+    {
+      std::cerr << "Error: The manifest could not be read" << std::endl;
+      return 1;
+    }
+
+    std::string line;
+    while (std::getline(manifest, line))
+    {
+      const std::string_view path = StripWhitespace(line);
+      if (!path.empty())
+        input_file_paths.emplace_back(path);
+    }
+  }
+  else
+  {
+    input_file_paths = Common::DoFileSearch(
+        {input_file_path}, {".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".wia", ".rvz"});
+  }
+
+  if (!File::IsDirectory(output_file_path) && !File::CreateFullPath(output_file_path + '/'))
+  {
+    std::cerr << "Error: The output directory could not be created" << std::endl;
+    return 1;
+  }
+
+  const bool success = ConvertFiles(input_file_paths, output_file_path, conversion_options,
+                                    static_cast<size_t>(jobs));
+  return success ? 0 : 1;
+}
+
+bool ConvertCommand::ConvertFiles(const std::vector<std::string>& input_file_paths,
+                                  const std::string& output_directory,
+                                  const ConversionOptions& options, size_t jobs)
+{
+  const std::string extension = GetFormatExtension(options.format);
+
+  // Each job converts whole files. The compression threads of all jobs share the CPU (see
+  // DiscIO::MultithreadedCompressor), so while one job is reading or writing, the others can use
+  // the CPU time it leaves unused.
+  std::atomic<size_t> next_index = 0;
+  std::atomic<size_t> failures = 0;
+  std::mutex output_mutex;
+
+  const auto job = [&] {
+    while (true)
+    {
+      const size_t index = next_index++;
+      if (index >= input_file_paths.size())
+        return;
+
+      const std::string& input_file_path = input_file_paths[index];
+      std::string name;
+      SplitPath(input_file_path, nullptr, &name, nullptr);
+      const std::string output_file_path = output_directory + '/' + name + extension;
+
+      bool success = false;
+      if (output_file_path == input_file_path)
+      {
+        std::cerr << input_file_path << ": Error: The output file would replace the input file"
+                  << std::endl;
+      }
+      else
+      {
+        success = ConvertFile(input_file_path, output_file_path, options, input_file_path + ": ");
+      }
+      if (!success)
+        ++failures;
+
+      std::lock_guard lk(output_mutex);
+      std::cout << '[' << index + 1 << '/' << input_file_paths.size() << "] "
+                << (success ? "Converted " : "Failed to convert ") << input_file_path << std::endl;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(jobs, input_file_paths.size()); ++i)
+    threads.emplace_back(job);
+  job();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  if (failures != 0)
+  {
+    std::cerr << "Error: " << failures << " of " << input_file_paths.size()
+              << " conversions failed" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool ConvertCommand::ConvertFile(const std::string& input_file_path,
+                                 const std::string& output_file_path,
+                                 const ConversionOptions& options, const std::string& log_prefix)
+{
+  const DiscIO::BlobType format = options.format;
+  const bool scrub = options.scrub;
+
+  // Open the blob reader
+  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
+  if (!blob_reader)
+  {
+    std::cerr << log_prefix << "Error: The input file could not be opened." << std::endl;
+    return false;
+  }
+
+  // Open the volume
+  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
+  if (!volume)
+  {
+    if (scrub)
+    {
+      std::cerr << log_prefix << "Error: Scrubbing is only supported for GC/Wii disc images."
+                << std::endl;
+      return false;
+    }
+
+    std::cerr << log_prefix
+              << "Warning: The input file is not a GC/Wii disc image. Continuing anyway."
+              << std::endl;
+  }
+
+  if (scrub)
+  {
+    if (volume->IsDatelDisc())
+    {
+      std::cerr << log_prefix << "Error: Scrubbing a Datel disc is not supported." << std::endl;
+      return false;
+    }
+
+    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
+
+    if (!blob_reader)
+    {
+      std::cerr << log_prefix << "Error: Unable to process disc image. Try again without --scrub."
+                << std::endl;
+      return false;
+    }
+  }
+
+  if (scrub && format == DiscIO::BlobType::RVZ)
+  {
+    std::cerr << log_prefix
+              << "Warning: Scrubbing an RVZ container does not offer significant space advantages. "
+                 "Continuing anyway."
+              << std::endl;
+  }
+
+  if (scrub && format == DiscIO::BlobType::PLAIN)
+  {
+    std::cerr << log_prefix
+              << "Warning: Scrubbing does not save space when converting to ISO unless using "
+                 "external compression. Continuing anyway."
+              << std::endl;
+  }
+
+  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
+      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  {
+    std::cerr << log_prefix
+              << "Warning: Converting Wii disc images to GCZ without scrubbing may not offer space "
+                 "advantages over ISO. Continuing anyway."
+              << std::endl;
+  }
+
+  if (volume && volume->IsNKit())
+  {
+    std::cerr << log_prefix
+              << "Warning: Converting an NKit file, output will still be NKit! Continuing anyway."
+              << std::endl;
+  }
+
+  if (format == DiscIO::BlobType::GCZ && volume &&
+      !DiscIO::IsGCZBlockSizeLegacyCompatible(options.block_size.value(), volume->GetDataSize()))
+  {
+    std::cerr << log_prefix
+              << "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, "
+                 "the file size must be an integer multiple of the block size "
+                 "and must not be an integer multiple of the block size multiplied by 32. "
+                 "Continuing anyway."
+              << std::endl;
+  }
+
   // Perform the conversion
   const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
 
@@ -295,7 +487,7 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
         sub_type = 1;
     }
     success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
+                                   options.block_size.value(), NOOP_STATUS_CALLBACK);
     break;
   }
 
@@ -303,8 +495,10 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   case DiscIO::BlobType::RVZ:
   {
     success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
-                                        format == DiscIO::BlobType::RVZ, compression_o.value(),
-                                        compression_level_o.value(), block_size_o.value(),
+                                        format == DiscIO::BlobType::RVZ,
+                                        options.compression.value(),
+                                        options.compression_level.value(),
+                                        options.block_size.value(), options.zstd_dictionary,
                                         NOOP_STATUS_CALLBACK);
     break;
   }
@@ -318,11 +512,26 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
 
   if (!success)
   {
-    std::cerr << "Error: Conversion failed" << std::endl;
-    return 1;
+    std::cerr << log_prefix << "Error: Conversion failed" << std::endl;
+    return false;
   }
 
-  return 0;
+  return true;
+}
+
+std::string ConvertCommand::GetFormatExtension(DiscIO::BlobType format)
+{
+  switch (format)
+  {
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  default:
+    return ".iso";
+  }
 }
 
 std::optional<DiscIO::WIARVZCompressionType>
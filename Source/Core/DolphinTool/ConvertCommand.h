@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/WIABlob.h"
 #include "DolphinTool/Command.h"
@@ -19,6 +20,22 @@ public:
   int Main(const std::vector<std::string>& args) override;
 
 private:
+  struct ConversionOptions
+  {
+    DiscIO::BlobType format = DiscIO::BlobType::PLAIN;
+    bool scrub = false;
+    std::optional<int> block_size;
+    std::optional<DiscIO::WIARVZCompressionType> compression;
+    std::optional<int> compression_level;
+    std::vector<u8> zstd_dictionary;
+  };
+
+  bool ConvertFiles(const std::vector<std::string>& input_file_paths,
+                    const std::string& output_directory, const ConversionOptions& options,
+                    size_t jobs);
+  bool ConvertFile(const std::string& input_file_path, const std::string& output_file_path,
+                   const ConversionOptions& options, const std::string& log_prefix);
+  std::string GetFormatExtension(DiscIO::BlobType format);
   std::optional<DiscIO::WIARVZCompressionType>
   ParseCompressionTypeString(const std::string& compression_str);
   std::optional<DiscIO::BlobType> ParseFormatString(const std::string& format_str);
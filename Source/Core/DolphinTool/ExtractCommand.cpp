@@ -0,0 +1,119 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ExtractCommand.h"
+
+#include <iostream>
+#include <memory>
+#include <optional>
+
+#include <OptionParser.h>
+
+#include "DiscIO/DiscExtractor.h"
+#include "DiscIO/DiscUtils.h"
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/Volume.h"
+
+namespace DolphinTool
+{
+// Extracts a partition the same way as "Extract Entire Disc..." in the filesystem tab of the game
+// properties does.
+static bool ExtractPartition(const DiscIO::Volume& volume, const DiscIO::Partition& partition,
+                             const std::string& output_path, bool quiet)
+{
+  const DiscIO::FileSystem* file_system = volume.GetFileSystem(partition);
+  if (!file_system)
+  {
+    std::cerr << "Error: Unable to read the file system of " << output_path << std::endl;
+    return false;
+  }
+
+  const bool files_success = DiscIO::ExportDirectoryInDiscOrder(
+      volume, partition, file_system->GetRoot(), "", output_path + "/files",
+      [quiet](const std::string& path) {
+        if (!quiet)
+          std::cout << path << std::endl;
+        return false;
+      });
+  const bool system_data_success = DiscIO::ExportSystemData(volume, partition, output_path);
+  return files_success && system_data_success;
+}
+
+int ExtractCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: extract [options]...");
+
+  parser->add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to disc image FILE.")
+      .metavar("FILE");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the DIRECTORY to extract to. Wii discs get a subdirectory for every "
+            "partition.")
+      .metavar("DIRECTORY");
+
+  parser->add_option("-q", "--quiet")
+      .action("store_true")
+      .help("Optional. Don't print the paths of the extracted files.");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  // Validate options
+  const std::string input_file_path = static_cast<const char*>(options.get("input"));
+  if (input_file_path.empty())
+  {
+    std::cerr << "Error: No input set" << std::endl;
+    return 1;
+  }
+
+  const std::string output_path = static_cast<const char*>(options.get("output"));
+  if (output_path.empty())
+  {
+    std::cerr << "Error: No output set" << std::endl;
+    return 1;
+  }
+
+  const bool quiet = options.is_set_by_user("quiet");
+
+  const std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateVolume(input_file_path);
+  if (!volume)
+  {
+    std::cerr << "Error: Unable to open disc image" << std::endl;
+    return 1;
+  }
+
+  bool success = true;
+  if (volume->GetPartitions().empty())
+  {
+    success = ExtractPartition(*volume, DiscIO::PARTITION_NONE, output_path, quiet);
+  }
+  else
+  {
+    for (const DiscIO::Partition& partition : volume->GetPartitions())
+    {
+      const std::optional<u32> partition_type = volume->GetPartitionType(partition);
+      if (!partition_type)
+        continue;
+
+      const std::string partition_name = DiscIO::NameForPartitionType(*partition_type, true);
+      if (!ExtractPartition(*volume, partition, output_path + '/' + partition_name, quiet))
+        success = false;
+    }
+  }
+
+  if (!success)
+  {
+    std::cerr << "Error: Not everything could be extracted" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+}  // namespace DolphinTool
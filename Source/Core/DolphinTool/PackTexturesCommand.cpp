@@ -0,0 +1,71 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/PackTexturesCommand.h"
+
+#include <iostream>
+#include <memory>
+
+#include <OptionParser.h>
+
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace DolphinTool
+{
+int PackTexturesCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: packtextures [options]...");
+
+  parser->add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the custom texture DIRECTORY to pack.")
+      .metavar("DIRECTORY");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the texture pack FILE to write. Should end in .dtp.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  // Validate options
+  const std::string input_path = static_cast<const char*>(options.get("input"));
+  if (input_path.empty())
+  {
+    std::cerr << "Error: No input set" << std::endl;
+    return 1;
+  }
+  if (!File::IsDirectory(input_path))
+  {
+    std::cerr << "Error: Input is not a directory" << std::endl;
+    return 1;
+  }
+
+  const std::string output_path = static_cast<const char*>(options.get("output"));
+  if (output_path.empty())
+  {
+    std::cerr << "Error: No output set" << std::endl;
+    return 1;
+  }
+
+  // Keep compressed DDS textures as they are. Whether the backend in use supports them is checked
+  // again when the pack is loaded.
+  g_ActiveConfig.backend_info.bSupportsST3CTextures = true;
+  g_ActiveConfig.backend_info.bSupportsBPTCTextures = true;
+
+  if (!HiresTexture::BuildPack(input_path, output_path))
+  {
+    std::cerr << "Error: Failed to write texture pack" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+}  // namespace DolphinTool
@@ -10,13 +10,15 @@
 #include "Common/Version.h"
 #include "DolphinTool/Command.h"
 #include "DolphinTool/ConvertCommand.h"
+#include "DolphinTool/ExtractCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/PackTexturesCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static int PrintUsage(int code)
 {
   std::cerr << "usage: dolphin-tool COMMAND -h" << std::endl << std::endl;
-  std::cerr << "commands supported: [convert, verify, header]" << std::endl;
+  std::cerr << "commands supported: [convert, verify, header, packtextures, extract]" << std::endl;
 
   return code;
 }
@@ -45,6 +47,10 @@ int main(int argc, char* argv[])
     command = std::make_unique<DolphinTool::VerifyCommand>();
   else if (command_str == "header")
     command = std::make_unique<DolphinTool::HeaderCommand>();
+  else if (command_str == "packtextures")
+    command = std::make_unique<DolphinTool::PackTexturesCommand>();
+  else if (command_str == "extract")
+    command = std::make_unique<DolphinTool::ExtractCommand>();
   else
     return PrintUsage(1);
 
@@ -44,9 +44,13 @@ public:
 
   bool IsSuppressed(Device::Input* input) const
   {
+    // This is checked for every control on every read, and nothing is suppressed most of the time.
+    if (m_suppressions.empty())
+      return false;
+
     // Input is suppressed if it exists in the map at all.
-    return m_suppressions.lower_bound({input, nullptr}) !=
-           m_suppressions.lower_bound({input + 1, nullptr});
+    const auto it = m_suppressions.lower_bound({input, nullptr});
+    return it != m_suppressions.end() && it->first.first == input;
   }
 
   bool IsSuppressedIgnoringModifiers(Device::Input* input, const Modifiers& ignore_modifiers) const;
@@ -885,6 +889,15 @@ private:
       }
 
       expr = std::make_unique<BinaryExpression>(tok.type, std::move(expr), std::move(rhs.expr));
+
+      // Operations on two literals always have the same result, so only compute it once.
+      // Assignments are kept as they are, since assigning to a literal is allowed and does nothing.
+      const auto* const binary = static_cast<const BinaryExpression*>(expr.get());
+      if (tok.type != TOK_ASSIGN && dynamic_cast<const LiteralReal*>(binary->lhs.get()) &&
+          dynamic_cast<const LiteralReal*>(binary->rhs.get()))
+      {
+        expr = std::make_unique<LiteralReal>(binary->GetValue());
+      }
     }
 
     return ParseResult::MakeSuccessfulResult(std::move(expr));
@@ -387,6 +387,13 @@ void ControllerInterface::UpdateInput()
   if (m_devices_mutex.try_lock())
   {
     std::lock_guard lk(m_devices_mutex, std::adopt_lock);
+
+    // Backends whose state is shared by all of their devices are updated once per pass, rather
+    // than once per device.
+#ifdef CIFACE_USE_SDL
+    ciface::SDL::UpdateInput();
+#endif
+
     for (const auto& d : m_devices)
     {
       // Theoretically we could avoid updating input on devices that don't have any references to
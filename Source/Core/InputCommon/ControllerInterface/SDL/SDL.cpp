@@ -271,6 +271,12 @@ void PopulateDevices()
 #endif
 }
 
+void UpdateInput()
+{
+  if (SDL_WasInit(SDL_INIT_JOYSTICK))
+    SDL_JoystickUpdate();
+}
+
 Joystick::Joystick(SDL_Joystick* const joystick, const int sdl_index)
     : m_joystick(joystick), m_name(StripWhitespace(GetJoystickName(sdl_index)))
 {
@@ -617,12 +623,6 @@ void Joystick::Motor::SetState(ControlState state)
 }
 #endif
 
-void Joystick::UpdateInput()
-{
-  // TODO: Don't call this for every Joystick, only once per ControllerInterface::UpdateInput()
-  SDL_JoystickUpdate();
-}
-
 std::string Joystick::GetName() const
 {
   return m_name;
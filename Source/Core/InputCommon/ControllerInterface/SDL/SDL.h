@@ -28,6 +28,8 @@ namespace ciface::SDL
 void Init();
 void DeInit();
 void PopulateDevices();
+// Updates the state of all SDL joysticks at once. Called before the devices are updated.
+void UpdateInput();
 
 class Joystick : public Core::Device
 {
@@ -182,8 +184,6 @@ private:
 #endif
 
 public:
-  void UpdateInput() override;
-
   Joystick(SDL_Joystick* const joystick, const int sdl_index);
   ~Joystick();
 
@@ -13,6 +13,8 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstring>
 #include <mutex>
 #include <optional>
 
@@ -97,11 +99,17 @@ constexpr size_t CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE = 37;
 constexpr size_t CONTROLER_OUTPUT_INIT_PAYLOAD_SIZE = 1;
 constexpr size_t CONTROLER_OUTPUT_RUMBLE_PAYLOAD_SIZE = 5;
 
-static std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE> s_controller_payload;
-static std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE> s_controller_payload_swap;
+struct ControllerPayload
+{
+  std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE> data;
+  int size;
+};
 
-// Only access with s_mutex held!
-static int s_controller_payload_size = {0};
+// The latest payload is published by the read thread through a seqlock, so that polling it never
+// has to wait for the read thread and always returns the most recent complete payload.
+constexpr size_t CONTROLLER_PAYLOAD_WORDS = (sizeof(ControllerPayload) + 7) / 8;
+static std::atomic<u32> s_controller_payload_sequence{0};
+static std::array<std::atomic<u64>, CONTROLLER_PAYLOAD_WORDS> s_controller_payload_words{};
 
 static std::array<u8, CONTROLER_OUTPUT_RUMBLE_PAYLOAD_SIZE> s_controller_write_payload;
 static std::atomic<int> s_controller_write_payload_size{0};
@@ -112,7 +120,6 @@ static std::thread s_write_adapter_thread;
 static Common::Flag s_write_adapter_thread_running;
 static Common::Event s_write_happened;
 
-static std::mutex s_read_mutex;
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
 static std::mutex s_init_mutex;
 #elif GCADAPTER_USE_ANDROID_IMPLEMENTATION
@@ -149,6 +156,38 @@ static std::array<SerialInterface::SIDevices, SerialInterface::MAX_SI_CHANNELS>
     s_config_si_device_type{};
 static std::array<bool, SerialInterface::MAX_SI_CHANNELS> s_config_rumble_enabled{};
 
+// Must only be called from the read thread.
+static void PublishControllerPayload(const ControllerPayload& payload)
+{
+  std::array<u64, CONTROLLER_PAYLOAD_WORDS> words{};
+  std::memcpy(words.data(), &payload, sizeof(payload));
+
+  const u32 sequence = s_controller_payload_sequence.load(std::memory_order_relaxed);
+  s_controller_payload_sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < words.size(); ++i)
+    s_controller_payload_words[i].store(words[i], std::memory_order_relaxed);
+  s_controller_payload_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+static ControllerPayload GetControllerPayload()
+{
+  std::array<u64, CONTROLLER_PAYLOAD_WORDS> words;
+  u32 sequence;
+  do
+  {
+    sequence = s_controller_payload_sequence.load(std::memory_order_acquire);
+    for (size_t i = 0; i < words.size(); ++i)
+      words[i] = s_controller_payload_words[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((sequence & 1) != 0 ||
+           sequence != s_controller_payload_sequence.load(std::memory_order_relaxed));
+
+  ControllerPayload payload;
+  std::memcpy(&payload, words.data(), sizeof(payload));
+  return payload;
+}
+
 static void Read()
 {
   Common::SetCurrentThreadName("GCAdapter Read Thread");
@@ -187,27 +226,26 @@ static void Read()
 
   while (s_read_adapter_thread_running.IsSet())
   {
+    ControllerPayload payload{};
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
-    int payload_size = 0;
     const int error =
-        libusb_interrupt_transfer(s_handle, s_endpoint_in, s_controller_payload_swap.data(),
-                                  CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE, &payload_size, 16);
+        libusb_interrupt_transfer(s_handle, s_endpoint_in, payload.data.data(),
+                                  CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE, &payload.size, 16);
     if (error != LIBUSB_SUCCESS)
     {
       ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_interrupt_transfer failed: {}",
                     LibusbUtils::ErrorWrap(error));
     }
+    // A timeout only means that there is nothing new, so keep the previous payload around instead
+    // of dropping the controller state until the next one.
+    if (error != LIBUSB_ERROR_TIMEOUT || payload.size != 0)
+      PublishControllerPayload(payload);
 #elif GCADAPTER_USE_ANDROID_IMPLEMENTATION
-    const int payload_size = env->CallStaticIntMethod(s_adapter_class, input_func);
+    payload.size = env->CallStaticIntMethod(s_adapter_class, input_func);
     jbyte* const java_data = env->GetByteArrayElements(*java_controller_payload, nullptr);
-    std::copy(java_data, java_data + CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE,
-              s_controller_payload_swap.begin());
+    std::copy(java_data, java_data + CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE, payload.data.begin());
+    PublishControllerPayload(payload);
 #endif
-    {
-      std::lock_guard<std::mutex> lk(s_read_mutex);
-      std::swap(s_controller_payload_swap, s_controller_payload);
-      s_controller_payload_size = payload_size;
-    }
 #if GCADAPTER_USE_ANDROID_IMPLEMENTATION
     env->ReleaseByteArrayElements(*java_controller_payload, java_data, 0);
 
@@ -713,14 +751,10 @@ GCPadStatus Input(int chan)
     return {};
 #endif
 
-  int payload_size = 0;
-  std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE> controller_payload_copy{};
-
-  {
-    std::lock_guard<std::mutex> lk(s_read_mutex);
-    controller_payload_copy = s_controller_payload;
-    payload_size = s_controller_payload_size;
-  }
+  const ControllerPayload payload = GetControllerPayload();
+  const int payload_size = payload.size;
+  const std::array<u8, CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE>& controller_payload_copy =
+      payload.data;
 
   GCPadStatus pad = {};
   if (payload_size != CONTROLER_INPUT_PAYLOAD_EXPECTED_SIZE
@@ -10,6 +10,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -19,6 +20,7 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Thread.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -132,20 +134,53 @@ bool GameFileCache::Update(
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
-  {
-    if (processing_halted)
-      break;
-
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+  // Creating a GameFile means opening the volume and reading its metadata and banner, which is
+  // mostly spent waiting for the disk and decompressing, so several files are created at once.
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  std::atomic<size_t> next_path = 0;
+  std::mutex add_mutex;
+
+  const auto add_games = [&] {
+    while (!processing_halted)
     {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+      const size_t index = next_path.fetch_add(1, std::memory_order_relaxed);
+      if (index >= new_paths.size())
+        break;
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+      auto file = std::make_shared<GameFile>(new_paths[index]);
+      if (file->IsValid())
+      {
+        std::lock_guard lk(add_mutex);
+
+        if (game_added_to_cache)
+          game_added_to_cache(file);
+
+        cache_changed = true;
+        m_cached_files.push_back(std::move(file));
+      }
+    }
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), new_paths.size());
+  if (thread_count > 1)
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t i = 1; i < thread_count; ++i)
+    {
+      threads.emplace_back([&] {
+        Common::SetCurrentThreadName("GameFileCache Worker");
+        add_games();
+      });
     }
+    add_games();
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+  else
+  {
+    add_games();
   }
 
   return cache_changed;
@@ -114,8 +114,8 @@ void PerfQuery::FlushOne()
   // NOTE: Reported pixel metrics should be referenced to native resolution
   // TODO: Dropping the lower 2 bits from this count should be closer to actual
   // hardware behavior when drawing triangles.
-  const u64 native_res_result = result * EFB_WIDTH / g_renderer->GetTargetWidth() * EFB_HEIGHT /
-                                g_renderer->GetTargetHeight();
+  const u64 native_res_result = result * EFB_WIDTH / g_renderer->EFBToScaledX(EFB_WIDTH) *
+                                EFB_HEIGHT / g_renderer->EFBToScaledY(EFB_HEIGHT);
   m_results[entry.query_type].fetch_add(static_cast<u32>(native_res_result),
                                         std::memory_order_relaxed);
 
@@ -143,8 +143,8 @@ void PerfQuery::WeakFlush()
     if (hr == S_OK)
     {
       // NOTE: Reported pixel metrics should be referenced to native resolution
-      const u64 native_res_result = result * EFB_WIDTH / g_renderer->GetTargetWidth() * EFB_HEIGHT /
-                                    g_renderer->GetTargetHeight();
+      const u64 native_res_result = result * EFB_WIDTH / g_renderer->EFBToScaledX(EFB_WIDTH) *
+                                    EFB_HEIGHT / g_renderer->EFBToScaledY(EFB_HEIGHT);
       m_results[entry.query_type].store(static_cast<u32>(native_res_result),
                                         std::memory_order_relaxed);
 
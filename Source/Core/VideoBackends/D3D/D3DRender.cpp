@@ -26,6 +26,7 @@
 #include "VideoBackends/D3D/DXPipeline.h"
 #include "VideoBackends/D3D/DXShader.h"
 #include "VideoBackends/D3D/DXTexture.h"
+#include "VideoBackends/D3DCommon/D3DCommon.h"
 
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/FramebufferManager.h"
@@ -280,6 +281,20 @@ void Renderer::WaitForGPUIdle()
   D3D::context->Flush();
 }
 
+std::optional<Renderer::VideoMemoryInfo> Renderer::GetVideoMemoryInfo() const
+{
+  ComPtr<IDXGIDevice> dxgi_device;
+  ComPtr<IDXGIAdapter> adapter;
+  if (FAILED(D3D::device.As(&dxgi_device)) || FAILED(dxgi_device->GetAdapter(&adapter)))
+    return std::nullopt;
+
+  VideoMemoryInfo info;
+  if (!D3DCommon::QueryVideoMemoryInfo(adapter.Get(), &info.usage, &info.budget))
+    return std::nullopt;
+
+  return info;
+}
+
 void Renderer::SetFullscreen(bool enable_fullscreen)
 {
   if (m_swap_chain)
@@ -66,6 +66,7 @@ public:
 
   void Flush() override;
   void WaitForGPUIdle() override;
+  std::optional<VideoMemoryInfo> GetVideoMemoryInfo() const override;
 
   void OnConfigChanged(u32 bits) override;
 
@@ -75,8 +75,8 @@ void StateManager::Apply()
 
     if (m_current.vertexConstants != m_pending.vertexConstants)
     {
-      D3D::context->VSSetConstantBuffers(0, 1, &m_pending.vertexConstants);
-      D3D::context->VSSetConstantBuffers(1, 1, &m_pending.vertexConstants);
+      ID3D11Buffer* const buffers[] = {m_pending.vertexConstants, m_pending.vertexConstants};
+      D3D::context->VSSetConstantBuffers(0, 2, buffers);
       m_current.vertexConstants = m_pending.vertexConstants;
     }
 
@@ -140,17 +140,19 @@ void StateManager::Apply()
     }
   }
 
-  if (m_dirtyFlags & DirtyFlag_BlendState)
+  // The dirty flags stay set when a state is changed and then changed back before a draw.
+  if ((m_dirtyFlags & DirtyFlag_BlendState) && m_current.blendState != m_pending.blendState)
   {
     D3D::context->OMSetBlendState(m_pending.blendState, nullptr, 0xFFFFFFFF);
     m_current.blendState = m_pending.blendState;
   }
-  if (m_dirtyFlags & DirtyFlag_DepthState)
+  if ((m_dirtyFlags & DirtyFlag_DepthState) && m_current.depthState != m_pending.depthState)
   {
     D3D::context->OMSetDepthStencilState(m_pending.depthState, 0);
     m_current.depthState = m_pending.depthState;
   }
-  if (m_dirtyFlags & DirtyFlag_RasterizerState)
+  if ((m_dirtyFlags & DirtyFlag_RasterizerState) &&
+      m_current.rasterizerState != m_pending.rasterizerState)
   {
     D3D::context->RSSetState(m_pending.rasterizerState);
     m_current.rasterizerState = m_pending.rasterizerState;
@@ -176,28 +178,40 @@ void StateManager::ApplyTextures()
        (DirtyFlag_Sampler0 | DirtyFlag_Sampler1 | DirtyFlag_Sampler2 | DirtyFlag_Sampler3 |
         DirtyFlag_Sampler4 | DirtyFlag_Sampler5 | DirtyFlag_Sampler6 | DirtyFlag_Sampler7)) >>
       samplerMaskShift;
+  // Bind each run of changed slots with a single call, as games tend to change several textures
+  // between draws.
   while (dirtyTextures)
   {
-    const int index = Common::LeastSignificantSetBit(dirtyTextures);
-    if (m_current.textures[index] != m_pending.textures[index])
+    const u32 start = Common::LeastSignificantSetBit(dirtyTextures);
+    u32 end = start;
+    for (; end < static_cast<u32>(m_current.textures.size()); end++)
     {
-      D3D::context->PSSetShaderResources(index, 1, &m_pending.textures[index]);
-      m_current.textures[index] = m_pending.textures[index];
+      if (m_current.textures[end] == m_pending.textures[end])
+        break;
+
+      m_current.textures[end] = m_pending.textures[end];
     }
 
-    dirtyTextures &= ~(1 << index);
+    if (end != start)
+      D3D::context->PSSetShaderResources(start, end - start, &m_pending.textures[start]);
+    dirtyTextures &= ~((2u << std::max(start, end - 1)) - 1);
   }
 
   while (dirtySamplers)
   {
-    const int index = Common::LeastSignificantSetBit(dirtySamplers);
-    if (m_current.samplers[index] != m_pending.samplers[index])
+    const u32 start = Common::LeastSignificantSetBit(dirtySamplers);
+    u32 end = start;
+    for (; end < static_cast<u32>(m_current.samplers.size()); end++)
     {
-      D3D::context->PSSetSamplers(index, 1, &m_pending.samplers[index]);
-      m_current.samplers[index] = m_pending.samplers[index];
+      if (m_current.samplers[end] == m_pending.samplers[end])
+        break;
+
+      m_current.samplers[end] = m_pending.samplers[end];
     }
 
-    dirtySamplers &= ~(1 << index);
+    if (end != start)
+      D3D::context->PSSetSamplers(start, end - start, &m_pending.samplers[start]);
+    dirtySamplers &= ~((2u << std::max(start, end - 1)) - 1);
   }
 }
 
@@ -29,31 +29,58 @@ bool D3D12BoundingBox::Initialize()
 std::vector<BBoxType> D3D12BoundingBox::Read(u32 index, u32 length)
 {
   // Copy from GPU->CPU buffer, and wait for the GPU to finish the copy.
+  CopyToReadbackBuffer(m_readback_buffer.Get());
+  Renderer::GetInstance()->ExecuteCommandList(true);
+
+  // Read back to cached values.
+  std::vector<BBoxType> values(length);
+  ReadBuffer(m_readback_buffer.Get(), index, length, values.data());
+  return values;
+}
+
+bool D3D12BoundingBox::QueueRead(u32 slot)
+{
+  // Submit the copy so that the GPU gets to it, but don't wait for it.
+  CopyToReadbackBuffer(m_queued_readback_buffers[slot].Get());
+  m_queued_readback_fences[slot] = g_dx_context->GetCurrentFenceValue();
+  Renderer::GetInstance()->ExecuteCommandList(false);
+  return true;
+}
+
+bool D3D12BoundingBox::GetQueuedRead(u32 slot, std::array<BBoxType, NUM_BBOX_VALUES>* values)
+{
+  if (!g_dx_context->IsFenceComplete(m_queued_readback_fences[slot]))
+    return false;
+
+  return ReadBuffer(m_queued_readback_buffers[slot].Get(), 0, NUM_BBOX_VALUES, values->data());
+}
+
+void D3D12BoundingBox::CopyToReadbackBuffer(ID3D12Resource* buffer)
+{
   ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
                   D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
-  g_dx_context->GetCommandList()->CopyBufferRegion(m_readback_buffer.Get(), 0, m_gpu_buffer.Get(),
-                                                   0, BUFFER_SIZE);
+  g_dx_context->GetCommandList()->CopyBufferRegion(buffer, 0, m_gpu_buffer.Get(), 0, BUFFER_SIZE);
   ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
                   D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
-  Renderer::GetInstance()->ExecuteCommandList(true);
+}
 
-  // Read back to cached values.
-  std::vector<BBoxType> values(length);
+bool D3D12BoundingBox::ReadBuffer(ID3D12Resource* buffer, u32 index, u32 length,
+                                  BBoxType* values)
+{
   static constexpr D3D12_RANGE read_range = {0, BUFFER_SIZE};
   void* mapped_pointer;
-  HRESULT hr = m_readback_buffer->Map(0, &read_range, &mapped_pointer);
+  HRESULT hr = buffer->Map(0, &read_range, &mapped_pointer);
   ASSERT_MSG(VIDEO, SUCCEEDED(hr), "Map bounding box CPU buffer failed: {}", DX12HRWrap(hr));
   if (FAILED(hr))
-    return values;
+    return false;
 
   // Copy out the values we want
-  std::memcpy(values.data(), reinterpret_cast<const u8*>(mapped_pointer) + sizeof(BBoxType) * index,
+  std::memcpy(values, reinterpret_cast<const u8*>(mapped_pointer) + sizeof(BBoxType) * index,
               sizeof(BBoxType) * length);
 
   static constexpr D3D12_RANGE write_range = {0, 0};
-  m_readback_buffer->Unmap(0, &write_range);
-
-  return values;
+  buffer->Unmap(0, &write_range);
+  return true;
 }
 
 void D3D12BoundingBox::Write(u32 index, const std::vector<BBoxType>& values)
@@ -120,6 +147,17 @@ bool D3D12BoundingBox::CreateBuffers()
   if (FAILED(hr))
     return false;
 
+  for (ComPtr<ID3D12Resource>& buffer : m_queued_readback_buffers)
+  {
+    hr = g_dx_context->GetDevice()->CreateCommittedResource(
+        &cpu_heap_properties, D3D12_HEAP_FLAG_NONE, &buffer_desc, D3D12_RESOURCE_STATE_COPY_DEST,
+        nullptr, IID_PPV_ARGS(&buffer));
+    ASSERT_MSG(VIDEO, SUCCEEDED(hr), "Creating bounding box CPU buffer failed: {}",
+               DX12HRWrap(hr));
+    if (FAILED(hr))
+      return false;
+  }
+
   if (!m_upload_buffer.AllocateBuffer(STREAM_BUFFER_SIZE))
     return false;
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include "VideoBackends/D3D12/Common.h"
 #include "VideoBackends/D3D12/D3D12StreamBuffer.h"
@@ -22,6 +23,8 @@ public:
 protected:
   std::vector<BBoxType> Read(u32 index, u32 length) override;
   void Write(u32 index, const std::vector<BBoxType>& values) override;
+  bool QueueRead(u32 slot) override;
+  bool GetQueuedRead(u32 slot, std::array<BBoxType, NUM_BBOX_VALUES>* values) override;
 
 private:
   static constexpr u32 BUFFER_SIZE = sizeof(BBoxType) * NUM_BBOX_VALUES;
@@ -29,10 +32,15 @@ private:
   static constexpr u32 STREAM_BUFFER_SIZE = BUFFER_SIZE * MAX_UPDATES_PER_FRAME;
 
   bool CreateBuffers();
+  void CopyToReadbackBuffer(ID3D12Resource* buffer);
+  bool ReadBuffer(ID3D12Resource* buffer, u32 index, u32 length, BBoxType* values);
 
   // Three buffers: GPU for read/write, CPU for reading back, and CPU for staging changes.
   ComPtr<ID3D12Resource> m_gpu_buffer;
   ComPtr<ID3D12Resource> m_readback_buffer;
+  // Additional CPU buffers for reading back asynchronously.
+  std::array<ComPtr<ID3D12Resource>, NUM_READBACK_SLOTS> m_queued_readback_buffers;
+  std::array<u64, NUM_READBACK_SLOTS> m_queued_readback_fences = {};
   StreamBuffer m_upload_buffer;
   DescriptorHandle m_gpu_descriptor{};
 };
@@ -117,6 +117,15 @@ void Renderer::WaitForGPUIdle()
   ExecuteCommandList(true);
 }
 
+std::optional<Renderer::VideoMemoryInfo> Renderer::GetVideoMemoryInfo() const
+{
+  VideoMemoryInfo info;
+  if (!D3DCommon::QueryVideoMemoryInfo(g_dx_context->GetAdapter(), &info.usage, &info.budget))
+    return std::nullopt;
+
+  return info;
+}
+
 void Renderer::ClearScreen(const MathUtil::Rectangle<int>& rc, bool color_enable, bool alpha_enable,
                            bool z_enable, u32 color, u32 z)
 {
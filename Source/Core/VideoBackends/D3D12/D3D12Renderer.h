@@ -51,6 +51,7 @@ public:
 
   void Flush() override;
   void WaitForGPUIdle() override;
+  std::optional<VideoMemoryInfo> GetVideoMemoryInfo() const override;
 
   void ClearScreen(const MathUtil::Rectangle<int>& rc, bool color_enable, bool alpha_enable,
                    bool z_enable, u32 color, u32 z) override;
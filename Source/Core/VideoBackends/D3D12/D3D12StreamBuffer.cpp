@@ -9,8 +9,10 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
 
 #include "VideoBackends/D3D12/DX12Context.h"
+#include "VideoCommon/Statistics.h"
 
 namespace DX12
 {
@@ -238,7 +240,10 @@ bool StreamBuffer::WaitForClearSpace(u32 num_bytes)
     return false;
 
   // Wait until this fence is signaled. This will fire the callback, updating the GPU position.
+  const u64 wait_start_us = Common::Timer::NowUs();
   g_dx_context->WaitForFence(iter->first);
+  INCSTAT(g_stats.this_frame.num_stream_buffer_waits);
+  ADDSTAT(g_stats.this_frame.stream_buffer_wait_us, Common::Timer::NowUs() - wait_start_us);
   m_tracked_fences.erase(m_tracked_fences.begin(),
                          m_current_offset == iter->second ? m_tracked_fences.end() : ++iter);
   m_current_offset = new_offset;
@@ -90,6 +90,7 @@ void VertexManager::ResetBuffer(u32 vertex_stride)
   {
     // Flush any pending commands first, so that we can wait on the fences
     WARN_LOG_FMT(VIDEO, "Executing command list while waiting for space in vertex/index buffer");
+    INCSTAT(g_stats.this_frame.num_stream_buffer_forced_submits);
     Renderer::GetInstance()->ExecuteCommandList(false);
 
     // Attempt to allocate again, this may cause a fence wait
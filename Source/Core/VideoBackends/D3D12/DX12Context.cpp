@@ -11,6 +11,8 @@
 
 #include "Common/Assert.h"
 #include "Common/DynamicLibrary.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 
 #include "VideoBackends/D3D12/Common.h"
@@ -177,6 +179,11 @@ bool DXContext::CreateDevice(u32 adapter_index, bool enable_debug_layer)
   if (FAILED(hr))
     return false;
 
+  // Without an adapter, the device was created on the default one.
+  if (!adapter)
+    m_dxgi_factory->EnumAdapters(0, &adapter);
+  m_adapter = std::move(adapter);
+
   if (enable_debug_layer)
   {
     ComPtr<ID3D12InfoQueue> info_queue;
@@ -530,6 +537,90 @@ void DXContext::RecreateGXRootSignature()
     PanicAlertFmt("Failed to re-create GX root signature.");
 }
 
+void DXContext::OpenPipelineLibrary(const std::string& path)
+{
+  ComPtr<ID3D12Device1> device1;
+  if (FAILED(m_device.As(&device1)))
+  {
+    WARN_LOG_FMT(VIDEO, "ID3D12Device1 is not available, not using a pipeline library.");
+    return;
+  }
+
+  m_pipeline_library_path = path;
+  m_pipeline_library_dirty = false;
+  m_pipeline_library_data.clear();
+  File::IOFile file(path, "rb");
+  if (file)
+  {
+    m_pipeline_library_data.resize(file.GetSize());
+    if (!file.ReadBytes(m_pipeline_library_data.data(), m_pipeline_library_data.size()))
+      m_pipeline_library_data.clear();
+  }
+
+  if (!m_pipeline_library_data.empty())
+  {
+    const HRESULT hr =
+        device1->CreatePipelineLibrary(m_pipeline_library_data.data(),
+                                       m_pipeline_library_data.size(),
+                                       IID_PPV_ARGS(&m_pipeline_library));
+    if (SUCCEEDED(hr))
+    {
+      INFO_LOG_FMT(VIDEO, "Loaded pipeline library from {}", path);
+      return;
+    }
+
+    // Expected after a driver update, the pipelines are compiled and stored again.
+    WARN_LOG_FMT(VIDEO, "Discarding pipeline library {}: {}", path, DX12HRWrap(hr));
+    m_pipeline_library_data.clear();
+    m_pipeline_library_dirty = true;
+  }
+
+  const HRESULT hr = device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pipeline_library));
+  if (FAILED(hr))
+  {
+    WARN_LOG_FMT(VIDEO, "CreatePipelineLibrary() failed: {}", DX12HRWrap(hr));
+    m_pipeline_library.Reset();
+  }
+}
+
+void DXContext::StorePipeline(const wchar_t* name, ID3D12PipelineState* pipeline)
+{
+  std::lock_guard guard(m_pipeline_library_mutex);
+  const HRESULT hr = m_pipeline_library->StorePipeline(name, pipeline);
+  if (FAILED(hr))
+  {
+    // A pipeline with the same name but a different description is already stored.
+    DEBUG_LOG_FMT(VIDEO, "StorePipeline() failed: {}", DX12HRWrap(hr));
+    return;
+  }
+
+  m_pipeline_library_dirty = true;
+}
+
+void DXContext::SavePipelineLibrary()
+{
+  std::lock_guard guard(m_pipeline_library_mutex);
+  if (!m_pipeline_library || !m_pipeline_library_dirty)
+    return;
+
+  std::vector<u8> data(m_pipeline_library->GetSerializedSize());
+  const HRESULT hr = m_pipeline_library->Serialize(data.data(), data.size());
+  if (FAILED(hr))
+  {
+    ERROR_LOG_FMT(VIDEO, "Serializing the pipeline library failed: {}", DX12HRWrap(hr));
+    return;
+  }
+
+  File::IOFile file(m_pipeline_library_path, "wb");
+  if (!file.WriteBytes(data.data(), data.size()))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write the pipeline library to {}", m_pipeline_library_path);
+    return;
+  }
+
+  m_pipeline_library_dirty = false;
+}
+
 void DXContext::DestroyPendingResources(CommandListResources& cmdlist)
 {
   for (const auto& dd : cmdlist.pending_descriptors)
@@ -541,6 +632,19 @@ void DXContext::DestroyPendingResources(CommandListResources& cmdlist)
   cmdlist.pending_resources.clear();
 }
 
+bool DXContext::IsFenceComplete(u64 fence)
+{
+  if (m_completed_fence_value >= fence)
+    return true;
+
+  if (m_fence->GetCompletedValue() < fence)
+    return false;
+
+  // Already complete, so this only releases resources.
+  WaitForFence(fence);
+  return true;
+}
+
 void DXContext::WaitForFence(u64 fence)
 {
   if (m_completed_fence_value >= fence)
@@ -5,6 +5,9 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/HRWrap.h"
@@ -58,6 +61,7 @@ public:
   static void Destroy();
 
   IDXGIFactory* GetDXGIFactory() const { return m_dxgi_factory.Get(); }
+  IDXGIAdapter* GetAdapter() const { return m_adapter.Get(); }
   ID3D12Device* GetDevice() const { return m_device.Get(); }
   ID3D12CommandQueue* GetCommandQueue() const { return m_command_queue.Get(); }
 
@@ -116,6 +120,9 @@ public:
   // Waits for a specific fence.
   void WaitForFence(u64 fence);
 
+  // Returns whether a specific fence has completed, without waiting for it.
+  bool IsFenceComplete(u64 fence);
+
   // Defers destruction of a D3D resource (associates it with the current list).
   void DeferResourceDestruction(ID3D12Resource* resource);
 
@@ -128,6 +135,19 @@ public:
   // Re-creates the root signature. Call when the host config changes (e.g. bbox/per-pixel shading).
   void RecreateGXRootSignature();
 
+  // Pipeline library holding the driver's compiled PSOs, or null if it isn't supported.
+  ID3D12PipelineLibrary1* GetPipelineLibrary() const { return m_pipeline_library.Get(); }
+
+  // Opens the pipeline library stored at path. Starts with an empty library if the file doesn't
+  // exist or was written by a different driver.
+  void OpenPipelineLibrary(const std::string& path);
+
+  // Adds a newly created pipeline to the library. Can be called from any thread.
+  void StorePipeline(const wchar_t* name, ID3D12PipelineState* pipeline);
+
+  // Writes the library back to disk if any pipelines were added to it.
+  void SavePipelineLibrary();
+
 private:
   // Number of command lists. One is being built while the other(s) are executed.
   static const u32 NUM_COMMAND_LISTS = 3;
@@ -163,10 +183,19 @@ private:
   void DestroyPendingResources(CommandListResources& cmdlist);
 
   ComPtr<IDXGIFactory> m_dxgi_factory;
+  ComPtr<IDXGIAdapter> m_adapter;
   ComPtr<ID3D12Debug> m_debug_interface;
   ComPtr<ID3D12Device> m_device;
   ComPtr<ID3D12CommandQueue> m_command_queue;
 
+  // The library references the serialized data instead of copying it, so the data is declared
+  // first and outlives the library.
+  std::vector<u8> m_pipeline_library_data;
+  ComPtr<ID3D12PipelineLibrary1> m_pipeline_library;
+  std::string m_pipeline_library_path;
+  std::mutex m_pipeline_library_mutex;
+  bool m_pipeline_library_dirty = false;
+
   ComPtr<ID3D12Fence> m_fence = nullptr;
   HANDLE m_fence_event = {};
   u32 m_current_fence_value = 0;
@@ -3,8 +3,15 @@
 
 #include "VideoBackends/D3D12/DX12Pipeline.h"
 
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "Common/Assert.h"
+#include "Common/Hash.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
 
 #include "VideoBackends/D3D12/Common.h"
 #include "VideoBackends/D3D12/DX12Context.h"
@@ -156,6 +163,49 @@ static void GetD3DBlendDesc(D3D12_BLEND_DESC* desc, const BlendingState& state)
   }
 }
 
+template <typename T>
+static void AppendPipelineKey(std::vector<u8>* key, const T* data, size_t count = 1)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(data);
+  key->insert(key->end(), bytes, bytes + sizeof(T) * count);
+}
+
+// Names the pipeline in the pipeline library after everything which affects the compiled PSO.
+static std::wstring GetPipelineName(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+                                    AbstractPipelineUsage usage)
+{
+  // Pointers are replaced by what they point to.
+  D3D12_GRAPHICS_PIPELINE_STATE_DESC fixed_desc;
+  std::memcpy(&fixed_desc, &desc, sizeof(fixed_desc));
+  fixed_desc.pRootSignature = nullptr;
+  fixed_desc.VS = {};
+  fixed_desc.GS = {};
+  fixed_desc.PS = {};
+  fixed_desc.InputLayout.pInputElementDescs = nullptr;
+  fixed_desc.CachedPSO = {};
+
+  std::vector<u8> key;
+  AppendPipelineKey(&key, &fixed_desc);
+  AppendPipelineKey(&key, &usage);
+  for (const D3D12_SHADER_BYTECODE& bytecode : {desc.VS, desc.GS, desc.PS})
+  {
+    AppendPipelineKey(&key, &bytecode.BytecodeLength);
+    AppendPipelineKey(&key, static_cast<const u8*>(bytecode.pShaderBytecode),
+                      bytecode.BytecodeLength);
+  }
+  for (u32 i = 0; i < desc.InputLayout.NumElements; i++)
+  {
+    D3D12_INPUT_ELEMENT_DESC element = desc.InputLayout.pInputElementDescs[i];
+    const std::string_view semantic_name = element.SemanticName;
+    element.SemanticName = nullptr;
+    AppendPipelineKey(&key, &element);
+    AppendPipelineKey(&key, semantic_name.data(), semantic_name.size() + 1);
+  }
+
+  const u64 hash = Common::GetHash64(key.data(), static_cast<u32>(key.size()), 0);
+  return UTF8ToWString(fmt::format("{:016x}", hash));
+}
+
 std::unique_ptr<DXPipeline> DXPipeline::Create(const AbstractPipelineConfig& config,
                                                const void* cache_data, size_t cache_data_size)
 {
@@ -207,13 +257,30 @@ std::unique_ptr<DXPipeline> DXPipeline::Create(const AbstractPipelineConfig& con
   desc.CachedPSO.pCachedBlob = cache_data;
   desc.CachedPSO.CachedBlobSizeInBytes = cache_data_size;
 
-  ID3D12PipelineState* pso;
-  HRESULT hr = g_dx_context->GetDevice()->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pso));
-  if (FAILED(hr))
+  ID3D12PipelineState* pso = nullptr;
+  ID3D12PipelineLibrary1* library = g_dx_context->GetPipelineLibrary();
+  std::wstring name;
+  if (library)
   {
-    WARN_LOG_FMT(VIDEO, "CreateGraphicsPipelineState() {}failed: {}",
-                 cache_data ? "with cache data " : "", DX12HRWrap(hr));
-    return nullptr;
+    // Fails if the pipeline hasn't been stored yet, in which case it's created as usual.
+    name = GetPipelineName(desc, config.usage);
+    if (FAILED(library->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(&pso))))
+      pso = nullptr;
+  }
+
+  if (!pso)
+  {
+    HRESULT hr =
+        g_dx_context->GetDevice()->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pso));
+    if (FAILED(hr))
+    {
+      WARN_LOG_FMT(VIDEO, "CreateGraphicsPipelineState() {}failed: {}",
+                   cache_data ? "with cache data " : "", DX12HRWrap(hr));
+      return nullptr;
+    }
+
+    if (library)
+      g_dx_context->StorePipeline(name.c_str(), pso);
   }
 
   const bool use_integer_rtv =
@@ -224,6 +291,10 @@ std::unique_ptr<DXPipeline> DXPipeline::Create(const AbstractPipelineConfig& con
 
 AbstractPipeline::CacheData DXPipeline::GetCacheData() const
 {
+  // The pipeline library already holds the driver's blob.
+  if (g_dx_context->GetPipelineLibrary())
+    return {};
+
   ComPtr<ID3DBlob> blob;
   HRESULT hr = m_pipeline->GetCachedBlob(&blob);
   if (FAILED(hr))
@@ -19,6 +19,7 @@
 
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/ShaderCache.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -88,6 +89,7 @@ void VideoBackend::FillBackendInfo()
   g_Config.backend_info.bSupportsSettingObjectNames = true;
   g_Config.backend_info.bSupportsPartialMultisampleResolve = true;
   g_Config.backend_info.bSupportsDynamicVertexLoader = true;
+  g_Config.backend_info.bSupportsDynamicDepthAndCullState = false;
 
   // We can only check texture support once we have a device.
   if (g_dx_context)
@@ -98,6 +100,9 @@ void VideoBackend::FillBackendInfo()
         g_dx_context->SupportsTextureFormat(DXGI_FORMAT_BC3_UNORM);
     g_Config.backend_info.bSupportsBPTCTextures =
         g_dx_context->SupportsTextureFormat(DXGI_FORMAT_BC7_UNORM);
+
+    // Driver blobs are stored in the pipeline library instead of the pipeline cache files.
+    g_Config.backend_info.bSupportsPipelineCacheData = !g_dx_context->GetPipelineLibrary();
   }
 }
 
@@ -109,6 +114,12 @@ bool VideoBackend::Initialize(const WindowSystemInfo& wsi)
     return false;
   }
 
+  if (g_Config.bShaderCache)
+  {
+    g_dx_context->OpenPipelineLibrary(GetDiskShaderCacheFileName(
+        APIType::D3D, "pipeline-library", !g_Config.bShareShaderCache, true));
+  }
+
   FillBackendInfo();
   InitializeShared();
 
@@ -159,6 +170,10 @@ void VideoBackend::Shutdown()
   if (g_shader_cache)
     g_shader_cache->Shutdown();
 
+  // The shader cache has stopped its compiler threads, so no more pipelines can be stored.
+  if (g_dx_context)
+    g_dx_context->SavePipelineLibrary();
+
   if (g_renderer)
     g_renderer->Shutdown();
 
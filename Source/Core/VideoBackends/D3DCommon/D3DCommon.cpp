@@ -5,12 +5,13 @@
 
 #include <d3d11.h>
 #include <d3d12.h>
-#include <dxgi1_3.h>
+#include <dxgi1_4.h>
 #include <wrl/client.h>
 
 #include "Common/Assert.h"
 #include "Common/DynamicLibrary.h"
 #include "Common/HRWrap.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
@@ -120,6 +121,25 @@ std::vector<std::string> GetAdapterNames()
   return adapters;
 }
 
+bool QueryVideoMemoryInfo(IDXGIAdapter* adapter, u64* usage, u64* budget)
+{
+  Microsoft::WRL::ComPtr<IDXGIAdapter3> adapter3;
+  if (!adapter || FAILED(adapter->QueryInterface(IID_PPV_ARGS(&adapter3))))
+    return false;
+
+  DXGI_QUERY_VIDEO_MEMORY_INFO info = {};
+  const HRESULT hr = adapter3->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info);
+  if (FAILED(hr))
+  {
+    WARN_LOG_FMT(VIDEO, "QueryVideoMemoryInfo failed: {}", Common::HRWrap(hr));
+    return false;
+  }
+
+  *usage = info.CurrentUsage;
+  *budget = info.Budget;
+  return true;
+}
+
 DXGI_FORMAT GetDXGIFormatForAbstractFormat(AbstractTextureFormat format, bool typeless)
 {
   switch (format)
@@ -11,6 +11,7 @@
 
 #include "Common/CommonTypes.h"
 
+struct IDXGIAdapter;
 struct IDXGIFactory;
 
 enum class AbstractTextureFormat : u32;
@@ -27,6 +28,10 @@ std::vector<std::string> GetAdapterNames();
 // Helper function which creates a DXGI factory.
 Microsoft::WRL::ComPtr<IDXGIFactory> CreateDXGIFactory(bool debug_device);
 
+// Queries the local video memory used by the process and its budget, in bytes. Returns false if
+// IDXGIAdapter3 is unavailable, which requires Windows 10.
+bool QueryVideoMemoryInfo(IDXGIAdapter* adapter, u64* usage, u64* budget);
+
 // Globally-accessible D3DCompiler function.
 extern pD3DCompile d3d_compile;
 
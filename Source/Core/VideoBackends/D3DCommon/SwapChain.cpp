@@ -11,9 +11,13 @@
 #include "Common/HRWrap.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/PerformanceTrace.h"
 
 #include "VideoCommon/VideoConfig.h"
 
+// Bounds the wait for the swap chain, in case the window is hidden and frames are never shown.
+constexpr DWORD FRAME_LATENCY_WAIT_TIMEOUT_MS = 100;
+
 static bool IsTearingSupported(IDXGIFactory2* dxgi_factory)
 {
   Microsoft::WRL::ComPtr<IDXGIFactory5> factory5;
@@ -41,6 +45,9 @@ SwapChain::SwapChain(const WindowSystemInfo& wsi, IDXGIFactory* dxgi_factory, IU
 
 SwapChain::~SwapChain()
 {
+  if (m_frame_latency_object)
+    CloseHandle(m_frame_latency_object);
+
   // Can't destroy swap chain while it's fullscreen.
   if (m_swap_chain && GetFullscreenState(m_swap_chain.Get()))
     m_swap_chain->SetFullscreenState(FALSE, nullptr);
@@ -54,7 +61,10 @@ bool SwapChain::WantsStereo()
 u32 SwapChain::GetSwapChainFlags() const
 {
   // This flag is necessary if we want to use a flip-model swapchain without locking the framerate
-  return m_allow_tearing_supported ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+  u32 flags = m_allow_tearing_supported ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+  if (m_frame_latency_waitable)
+    flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+  return flags;
 }
 
 bool SwapChain::CreateSwapChain(bool stereo)
@@ -72,6 +82,7 @@ bool SwapChain::CreateSwapChain(bool stereo)
   if (SUCCEEDED(hr))
   {
     m_allow_tearing_supported = IsTearingSupported(dxgi_factory2.Get());
+    m_frame_latency_waitable = g_ActiveConfig.bLowLatencyMode;
 
     DXGI_SWAP_CHAIN_DESC1 swap_chain_desc = {};
     swap_chain_desc.Width = m_width;
@@ -122,6 +133,7 @@ bool SwapChain::CreateSwapChain(bool stereo)
     desc.Flags = 0;
 
     m_allow_tearing_supported = false;
+    m_frame_latency_waitable = false;
     hr = m_dxgi_factory->CreateSwapChain(m_d3d_device.Get(), &desc, &m_swap_chain);
   }
 
@@ -137,6 +149,21 @@ bool SwapChain::CreateSwapChain(bool stereo)
   if (FAILED(hr))
     WARN_LOG_FMT(VIDEO, "MakeWindowAssociation() failed: {}", Common::HRWrap(hr));
 
+  if (m_frame_latency_waitable)
+  {
+    // Only queue a single frame, and wait for it to be shown before starting the next one.
+    Microsoft::WRL::ComPtr<IDXGISwapChain2> swap_chain2;
+    if (SUCCEEDED(m_swap_chain.As(&swap_chain2)) &&
+        SUCCEEDED(swap_chain2->SetMaximumFrameLatency(1)))
+    {
+      m_frame_latency_object = swap_chain2->GetFrameLatencyWaitableObject();
+    }
+    else
+    {
+      WARN_LOG_FMT(VIDEO, "Failed to set up frame latency waitable swap chain.");
+    }
+  }
+
   m_stereo = stereo;
   if (!CreateSwapChainBuffers())
   {
@@ -158,6 +185,12 @@ void SwapChain::DestroySwapChain()
     m_swap_chain->SetFullscreenState(FALSE, nullptr);
 
   m_swap_chain.Reset();
+
+  if (m_frame_latency_object)
+  {
+    CloseHandle(m_frame_latency_object);
+    m_frame_latency_object = nullptr;
+  }
 }
 
 bool SwapChain::ResizeSwapChain()
@@ -242,6 +275,12 @@ bool SwapChain::Present()
     return false;
   }
 
+  if (m_frame_latency_object)
+  {
+    Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::PresentWait);
+    WaitForSingleObjectEx(m_frame_latency_object, FRAME_LATENCY_WAIT_TIMEOUT_MS, TRUE);
+  }
+
   return true;
 }
 
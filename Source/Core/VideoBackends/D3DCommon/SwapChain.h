@@ -65,6 +65,11 @@ protected:
   bool m_allow_tearing_supported = false;
   bool m_has_fullscreen = false;
   bool m_fullscreen_request = false;
+
+  // In low latency mode, Present() waits until DXGI is ready to queue another frame, so that the
+  // CPU doesn't render ahead of the display.
+  bool m_frame_latency_waitable = false;
+  HANDLE m_frame_latency_object = nullptr;
 };
 
 }  // namespace D3DCommon
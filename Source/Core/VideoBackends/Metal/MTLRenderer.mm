@@ -3,6 +3,8 @@
 
 #include "VideoBackends/Metal/MTLRenderer.h"
 
+#include "Common/Logging/Log.h"
+
 #include "VideoBackends/Metal/MTLBoundingBox.h"
 #include "VideoBackends/Metal/MTLObjectCache.h"
 #include "VideoBackends/Metal/MTLPipeline.h"
@@ -128,7 +130,14 @@ std::unique_ptr<AbstractShader> Metal::Renderer::CreateShaderFromBinary(ShaderSt
                                                                         size_t length,
                                                                         std::string_view name)
 {
-  return CreateShaderFromMSL(stage, std::string(static_cast<const char*>(data), length), {}, name);
+  std::string msl(static_cast<const char*>(data), length);
+  if (!msl.starts_with(Util::GetMSLTranslationTag()))
+  {
+    INFO_LOG_FMT(VIDEO, "Cached MSL for shader {} was translated with different options", name);
+    return nullptr;
+  }
+
+  return CreateShaderFromMSL(stage, std::move(msl), {}, name);
 }
 
 // clang-format off
@@ -210,6 +210,10 @@ private:
     id<MTLRenderPipelineState> pipeline;
     std::array<id<MTLBuffer>, 2> vertex_buffers;
     std::array<id<MTLBuffer>, 2> fragment_buffers;
+    std::array<id<MTLTexture>, 8> textures;
+    std::array<id<MTLSamplerState>, 8> samplers;
+    std::array<float, 8> sampler_min_lod;
+    std::array<float, 8> sampler_max_lod;
     u32 width;
     u32 height;
     MathUtil::Rectangle<int> scissor_rect;
@@ -679,20 +679,54 @@ void Metal::StateTracker::PrepareRender()
     if (m_state.vertices)
       SetVertexBufferNow(0, m_state.vertices, 0);
   }
+  // Games often swap a texture or sampler out and back in between draws, so only bind the ones
+  // that the encoder doesn't already have.
   if (u8 dirty = m_dirty_textures & pipe->GetTextures())
   {
     m_dirty_textures &= ~pipe->GetTextures();
-    NSRange range = RangeOfBits(dirty);
-    [enc setFragmentTextures:&m_state.textures[range.location] withRange:range];
+    u32 changed = 0;
+    for (u32 bits = dirty; bits; bits &= bits - 1)
+    {
+      const u32 i = Common::CountTrailingZeros(bits);
+      if (m_current.textures[i] != m_state.textures[i])
+        changed |= 1u << i;
+    }
+    if (changed)
+    {
+      NSRange range = RangeOfBits(changed);
+      [enc setFragmentTextures:&m_state.textures[range.location] withRange:range];
+      std::copy_n(&m_state.textures[range.location], range.length,
+                  &m_current.textures[range.location]);
+    }
   }
   if (u8 dirty = m_dirty_samplers & pipe->GetSamplers())
   {
     m_dirty_samplers &= ~pipe->GetSamplers();
-    NSRange range = RangeOfBits(dirty);
-    [enc setFragmentSamplerStates:&m_state.samplers[range.location]
-                     lodMinClamps:m_state.sampler_min_lod.data()
-                     lodMaxClamps:m_state.sampler_max_lod.data()
-                        withRange:range];
+    u32 changed = 0;
+    for (u32 bits = dirty; bits; bits &= bits - 1)
+    {
+      const u32 i = Common::CountTrailingZeros(bits);
+      if (m_current.samplers[i] != m_state.samplers[i] ||
+          m_current.sampler_min_lod[i] != m_state.sampler_min_lod[i] ||
+          m_current.sampler_max_lod[i] != m_state.sampler_max_lod[i])
+      {
+        changed |= 1u << i;
+      }
+    }
+    if (changed)
+    {
+      NSRange range = RangeOfBits(changed);
+      [enc setFragmentSamplerStates:&m_state.samplers[range.location]
+                       lodMinClamps:&m_state.sampler_min_lod[range.location]
+                       lodMaxClamps:&m_state.sampler_max_lod[range.location]
+                          withRange:range];
+      std::copy_n(&m_state.samplers[range.location], range.length,
+                  &m_current.samplers[range.location]);
+      std::copy_n(&m_state.sampler_min_lod[range.location], range.length,
+                  &m_current.sampler_min_lod[range.location]);
+      std::copy_n(&m_state.sampler_max_lod[range.location], range.length,
+                  &m_current.sampler_max_lod[range.location]);
+    }
   }
   if (m_state.perf_query_group != m_current.perf_query_group)
   {
@@ -49,5 +49,9 @@ static inline bool HasStencil(AbstractTextureFormat format)
 
 std::optional<std::string> TranslateShaderToMSL(ShaderStage stage, std::string_view source);
 
+/// Returns the first line of translated MSL, which identifies the options it was translated with,
+/// so that MSL cached on a different device or OS version is not used.
+std::string GetMSLTranslationTag();
+
 }  // namespace Util
 }  // namespace Metal
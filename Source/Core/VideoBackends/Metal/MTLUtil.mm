@@ -5,8 +5,10 @@
 
 #include <fstream>
 #include <string>
+#include <utility>
 
 #include <TargetConditionals.h>
+#include <fmt/format.h>
 #include <spirv_msl.hpp>
 
 #include "Common/MsgHandler.h"
@@ -66,7 +68,8 @@ void Metal::Util::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsLargePoints = true;
   config->backend_info.bSupportsPartialDepthCopies = true;
   config->backend_info.bSupportsDepthReadback = true;
-  config->backend_info.bSupportsShaderBinaries = false;
+  // The translated MSL is cached, which skips glslang and SPIRV-Cross for known shaders.
+  config->backend_info.bSupportsShaderBinaries = true;
   config->backend_info.bSupportsPipelineCacheData = false;
   config->backend_info.bSupportsCoarseDerivatives = false;
   config->backend_info.bSupportsTextureQueryLevels = true;
@@ -75,6 +78,7 @@ void Metal::Util::PopulateBackendInfo(VideoConfig* config)
   // Metal requires multisample resolve to be done on a render pass
   config->backend_info.bSupportsPartialMultisampleResolve = false;
   config->backend_info.bSupportsDynamicVertexLoader = true;
+  config->backend_info.bSupportsDynamicDepthAndCullState = false;
 }
 
 void Metal::Util::PopulateBackendInfoAdapters(VideoConfig* config,
@@ -391,6 +395,24 @@ MakeResourceBinding(spv::ExecutionModel stage, u32 set, u32 binding,  //
   return resource;
 }
 
+static std::pair<u32, u32> GetMSLVersion()
+{
+  if (@available(macOS 11, iOS 14, *))
+    return {2, 3};
+  else if (@available(macOS 10.15, iOS 13, *))
+    return {2, 2};
+  else if (@available(macOS 10.14, iOS 12, *))
+    return {2, 1};
+  else
+    return {2, 0};
+}
+
+std::string Metal::Util::GetMSLTranslationTag()
+{
+  const auto [major, minor] = GetMSLVersion();
+  return fmt::format("// MSL {}.{}, subgroup ops: {}\n", major, minor, g_features.subgroup_ops);
+}
+
 std::optional<std::string> Metal::Util::TranslateShaderToMSL(ShaderStage stage,
                                                              std::string_view source)
 {
@@ -458,21 +480,16 @@ std::optional<std::string> Metal::Util::TranslateShaderToMSL(ShaderStage stage,
 
   spirv_cross::CompilerMSL compiler(std::move(*code));
 
-  if (@available(macOS 11, iOS 14, *))
-    options.set_msl_version(2, 3);
-  else if (@available(macOS 10.15, iOS 13, *))
-    options.set_msl_version(2, 2);
-  else if (@available(macOS 10.14, iOS 12, *))
-    options.set_msl_version(2, 1);
-  else
-    options.set_msl_version(2, 0);
+  const auto [msl_major, msl_minor] = GetMSLVersion();
+  options.set_msl_version(msl_major, msl_minor);
   options.use_framebuffer_fetch_subpasses = true;
   compiler.set_msl_options(options);
 
   for (auto& binding : resource_bindings)
     compiler.add_msl_resource_binding(binding);
 
-  std::string msl(MSL_HEADER);
+  std::string msl = GetMSLTranslationTag();
+  msl += MSL_HEADER;
   msl += compiler.compile();
   return msl;
 }
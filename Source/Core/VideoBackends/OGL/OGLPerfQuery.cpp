@@ -165,7 +165,7 @@ void PerfQueryGL::FlushOne()
   // TODO: Dropping the lower 2 bits from this count should be closer to actual
   // hardware behavior when drawing triangles.
   result = static_cast<u64>(result) * EFB_WIDTH * EFB_HEIGHT /
-           (g_renderer->GetTargetWidth() * g_renderer->GetTargetHeight());
+           (g_renderer->EFBToScaledX(EFB_WIDTH) * g_renderer->EFBToScaledY(EFB_HEIGHT));
 
   // Adjust for multisampling
   if (g_ActiveConfig.iMultisamples > 1)
@@ -264,8 +264,9 @@ void PerfQueryGLESNV::FlushOne()
   // NOTE: Reported pixel metrics should be referenced to native resolution
   // TODO: Dropping the lower 2 bits from this count should be closer to actual
   // hardware behavior when drawing triangles.
-  const u64 native_res_result = static_cast<u64>(result) * EFB_WIDTH * EFB_HEIGHT /
-                                (g_renderer->GetTargetWidth() * g_renderer->GetTargetHeight());
+  const u64 native_res_result =
+      static_cast<u64>(result) * EFB_WIDTH * EFB_HEIGHT /
+      (g_renderer->EFBToScaledX(EFB_WIDTH) * g_renderer->EFBToScaledY(EFB_HEIGHT));
   m_results[entry.query_type].fetch_add(static_cast<u32>(native_res_result),
                                         std::memory_order_relaxed);
 
@@ -3,6 +3,7 @@
 
 #include "VideoBackends/OGL/OGLShader.h"
 
+#include "VideoBackends/OGL/OGLRender.h"
 #include "VideoBackends/OGL/ProgramShaderCache.h"
 
 #include "VideoCommon/VideoConfig.h"
@@ -64,7 +65,10 @@ std::unique_ptr<OGLShader> OGLShader::CreateFromSource(ShaderStage stage, std::s
   if (stage != ShaderStage::Compute)
   {
     GLenum shader_type = GetGLShaderTypeForStage(stage);
-    GLuint shader_id = ProgramShaderCache::CompileSingleShader(shader_type, source_str);
+    // The compile result is checked when the shader is linked into a pipeline, so that the shader
+    // compiler threads don't wait for the driver to finish compiling every stage one by one.
+    GLuint shader_id = ProgramShaderCache::CompileSingleShader(
+        shader_type, source_str, !g_ogl_config.bSupportsParallelShaderCompile);
     if (!shader_id)
       return nullptr;
 
@@ -217,38 +217,31 @@ u32 ProgramShaderCache::GetUniformBufferAlignment()
   return s_ubo_align;
 }
 
-void ProgramShaderCache::UploadConstants()
+// Only the blocks which changed are streamed and rebound, as draws commonly differ in just one of
+// them (e.g. the vertex shader matrices), and every binding has a cost on some drivers.
+template <typename T>
+static void UploadConstantBlock(GLuint index, bool* dirty, const T& constants, s32 align)
 {
-  if (PixelShaderManager::dirty || VertexShaderManager::dirty || GeometryShaderManager::dirty)
-  {
-    auto buffer = s_buffer->Map(s_ubo_buffer_size, s_ubo_align);
-
-    memcpy(buffer.first, &PixelShaderManager::constants, sizeof(PixelShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-           &VertexShaderManager::constants, sizeof(VertexShaderConstants));
-
-    memcpy(buffer.first + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-               Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-           &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
+  if (!*dirty)
+    return;
 
-    s_buffer->Unmap(s_ubo_buffer_size);
-    glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second,
-                      sizeof(PixelShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align),
-                      sizeof(VertexShaderConstants));
-    glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer,
-                      buffer.second + Common::AlignUp(sizeof(PixelShaderConstants), s_ubo_align) +
-                          Common::AlignUp(sizeof(VertexShaderConstants), s_ubo_align),
-                      sizeof(GeometryShaderConstants));
+  const u32 alloc_size = Common::AlignUp(static_cast<u32>(sizeof(T)), align);
+  auto buffer = s_buffer->Map(alloc_size, align);
+  std::memcpy(buffer.first, &constants, sizeof(T));
+  s_buffer->Unmap(alloc_size);
+  glBindBufferRange(GL_UNIFORM_BUFFER, index, s_buffer->m_buffer, buffer.second, sizeof(T));
 
-    PixelShaderManager::dirty = false;
-    VertexShaderManager::dirty = false;
-    GeometryShaderManager::dirty = false;
+  *dirty = false;
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, sizeof(T));
+}
 
-    ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, s_ubo_buffer_size);
-  }
+void ProgramShaderCache::UploadConstants()
+{
+  UploadConstantBlock(1, &PixelShaderManager::dirty, PixelShaderManager::constants, s_ubo_align);
+  UploadConstantBlock(2, &VertexShaderManager::dirty, VertexShaderManager::constants,
+                      s_ubo_align);
+  UploadConstantBlock(3, &GeometryShaderManager::dirty, GeometryShaderManager::constants,
+                      s_ubo_align);
 }
 
 void ProgramShaderCache::UploadConstants(const void* data, u32 data_size)
@@ -300,7 +293,8 @@ bool ProgramShaderCache::CompileComputeShader(SHADER& shader, std::string_view c
   return true;
 }
 
-GLuint ProgramShaderCache::CompileSingleShader(GLenum type, std::string_view code)
+GLuint ProgramShaderCache::CompileSingleShader(GLenum type, std::string_view code,
+                                               bool check_result)
 {
   const GLuint result = glCreateShader(type);
 
@@ -317,7 +311,7 @@ GLuint ProgramShaderCache::CompileSingleShader(GLenum type, std::string_view cod
   glShaderSource(result, num_strings, src.data(), src_sizes.data());
   glCompileShader(result);
 
-  if (!CheckShaderCompileResult(result, type, code))
+  if (check_result && !CheckShaderCompileResult(result, type, code))
   {
     // Don't try to use this shader
     glDeleteShader(result);
@@ -447,6 +441,7 @@ void ProgramShaderCache::Init()
 
   CreateHeader();
   CreateAttributelessVAO();
+  SetMaxShaderCompilerThreads();
 
   CurrentProgram = 0;
 }
@@ -485,6 +480,17 @@ void ProgramShaderCache::CreateAttributelessVAO()
   glEnableVertexAttribArray(0);
 }
 
+void ProgramShaderCache::SetMaxShaderCompilerThreads()
+{
+  if (!g_ogl_config.bSupportsParallelShaderCompile)
+    return;
+
+  // The maximum value leaves the number of threads up to the driver. Shaders which are created on
+  // the main thread or the shader compiler threads, and are only linked later, then compile
+  // concurrently with each other.
+  glMaxShaderCompilerThreads(0xFFFFFFFF);
+}
+
 void ProgramShaderCache::BindVertexFormat(const GLVertexFormat* vertex_format)
 {
   u32 new_VAO = vertex_format ? vertex_format->VAO : s_attributeless_VAO;
@@ -599,6 +605,20 @@ PipelineProgram* ProgramShaderCache::GetPipelineProgram(const GLVertexFormat* ve
                                 geometry_shader ? geometry_shader->GetSource() : std::string_view{},
                                 pixel_shader ? pixel_shader->GetSource() : std::string_view{}))
     {
+      // With parallel shader compiling, the compile status of the shaders isn't checked when
+      // they are created, so report which of them failed to compile here.
+      if (g_ogl_config.bSupportsParallelShaderCompile)
+      {
+        for (const OGLShader* shader : {vertex_shader, geometry_shader, pixel_shader})
+        {
+          if (shader)
+          {
+            CheckShaderCompileResult(shader->GetGLShaderID(), shader->GetGLShaderType(),
+                                     shader->GetSource());
+          }
+        }
+      }
+
       prog->shader.Destroy();
       return nullptr;
     }
@@ -885,6 +905,7 @@ bool SharedContextAsyncShaderCompiler::WorkerThreadInitWorkerThread(void* param)
   if (g_ActiveConfig.backend_info.bSupportsPrimitiveRestart)
     GLUtil::EnablePrimitiveRestart(context);
 
+  ProgramShaderCache::SetMaxShaderCompilerThreads();
   return true;
 }
 
@@ -75,7 +75,9 @@ public:
   static void InvalidateLastProgram();
 
   static bool CompileComputeShader(SHADER& shader, std::string_view code);
-  static GLuint CompileSingleShader(GLenum type, std::string_view code);
+  // If check_result is false, the compile status isn't queried, which would wait for the driver
+  // to finish compiling the shader. Compile errors are then reported when linking fails instead.
+  static GLuint CompileSingleShader(GLenum type, std::string_view code, bool check_result = true);
   static bool CheckShaderCompileResult(GLuint id, GLenum type, std::string_view code);
   static bool CheckProgramLinkResult(GLuint id, std::string_view vcode, std::string_view pcode,
                                      std::string_view gcode);
@@ -88,6 +90,9 @@ public:
   static void Shutdown();
   static void CreateHeader();
 
+  // Lets the driver compile shaders on its own threads, for the current context.
+  static void SetMaxShaderCompilerThreads();
+
   // This counter increments with each shader object allocated, in order to give it a unique ID.
   // Since the shaders can be destroyed after a pipeline is created, we can't use the shader pointer
   // as a key for GL programs. For the same reason, we can't use the GL objects either. This ID is
@@ -37,6 +37,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VideoBackends/Software/Clipper.h"
 
 #include "Common/Assert.h"
+#include "Common/Intrinsics.h"
 
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Rasterizer.h"
@@ -45,6 +46,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/XFMemory.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace Clipper
 {
 enum
@@ -78,6 +83,25 @@ static inline int CalcClipMask(const OutputVertexData* v)
   int cmask = 0;
   Vec4 pos = v->projectedPosition;
 
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+  // The X and Y planes are tested together, with the lanes in the order of their bits:
+  // w - x, x + w, w - y, y + w. Subtracting is the same as adding the negated value.
+  static_assert(CLIP_POS_X_BIT == 1 && CLIP_NEG_X_BIT == 2 && CLIP_POS_Y_BIT == 4 &&
+                CLIP_NEG_Y_BIT == 8);
+#if defined(_M_X86_64)
+  const __m128 xyzw = _mm_loadu_ps(&pos.x);
+  const __m128 xxyy = _mm_shuffle_ps(xyzw, xyzw, _MM_SHUFFLE(1, 1, 0, 0));
+  const __m128 negate_x_and_y = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+  const __m128 sum = _mm_add_ps(_mm_set1_ps(pos.w), _mm_xor_ps(xxyy, negate_x_and_y));
+  cmask = _mm_movemask_ps(_mm_cmplt_ps(sum, _mm_setzero_ps()));
+#else
+  const float32x4_t xxyy = {pos.x, pos.x, pos.y, pos.y};
+  const float32x4_t signs = {-1.0f, 1.0f, -1.0f, 1.0f};
+  const float32x4_t sum = vaddq_f32(vdupq_n_f32(pos.w), vmulq_f32(xxyy, signs));
+  const uint32x4_t bits = {CLIP_POS_X_BIT, CLIP_NEG_X_BIT, CLIP_POS_Y_BIT, CLIP_NEG_Y_BIT};
+  cmask = static_cast<int>(vaddvq_u32(vandq_u32(vcltq_f32(sum, vdupq_n_f32(0.0f)), bits)));
+#endif
+#else
   if (pos.w - pos.x < 0)
     cmask |= CLIP_POS_X_BIT;
 
@@ -89,6 +113,7 @@ static inline int CalcClipMask(const OutputVertexData* v)
 
   if (pos.y + pos.w < 0)
     cmask |= CLIP_NEG_Y_BIT;
+#endif
 
   if (pos.w * pos.z > 0)
     cmask |= CLIP_POS_Z_BIT;
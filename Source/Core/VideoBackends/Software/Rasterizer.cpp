@@ -4,14 +4,24 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <thread>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/Thread.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/Tev.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
@@ -25,6 +35,17 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// With worker threads, triangles are binned into tiles of TILE_SIZE x TILE_SIZE pixels, and each
+// tile is rasterized by a single thread in the order the triangles were drawn. Tiles are made of
+// whole blocks, so that they split triangles exactly where the blocks are split anyway.
+static constexpr s32 TILE_SIZE = 32;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0, "Tiles must be made of whole blocks");
+static constexpr u32 TILES_WIDE = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr u32 TILES_HIGH = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+
+// Larger batches are rasterized in several parts, to bound the memory used by the bins.
+static constexpr size_t MAX_QUEUED_TRIANGLES = 4096;
+
 struct SlopeContext
 {
   SlopeContext(const OutputVertexData* v0, const OutputVertexData* v1, const OutputVertexData* v2,
@@ -96,13 +117,52 @@ struct Slope
   }
 };
 
+// A triangle which has been set up for one scissor rectangle.
+struct Triangle
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Bounding rectangle, clipped to the scissor rectangle
+  s32 minx;
+  s32 maxx;
+  s32 miny;
+  s32 maxy;
+
+  // Deltas and half-edge constants
+  s32 DX12;
+  s32 DX23;
+  s32 DX31;
+  s32 DY12;
+  s32 DY23;
+  s32 DY31;
+  s32 C1;
+  s32 C2;
+  s32 C3;
+};
+
+// State of a thread which rasterizes triangles.
+struct RasterizerContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+
+  // Statistics and bounding box of the pixels drawn since the last Flush().
+  int rasterized_pixels = 0;
+  int tev_pixels_in = 0;
+  int tev_pixels_out = 0;
+  u16 bbox_left = std::numeric_limits<u16>::max();
+  u16 bbox_right = 0;
+  u16 bbox_top = std::numeric_limits<u16>::max();
+  u16 bbox_bottom = 0;
+};
+
+// The z slope is kept across triangles for zfreeze.
 static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
 
-static Tev tev;
-static RasterBlock rasterBlock;
+static RasterizerContext s_context;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
@@ -142,14 +202,15 @@ static inline int iround(float x)
 
 void SetTevKonstColors()
 {
-  tev.SetKonstColors();
+  s_context.tev.SetKonstColors();
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(RasterizerContext& context, const Triangle& triangle, s32 x, s32 y, s32 xi,
+                 s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  context.rasterized_pixels++;
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(triangle.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
@@ -164,7 +225,9 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlock& rasterBlock = context.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  Tev& tev = context.tev;
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -175,7 +238,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      u16 color = (u16)triangle.ColorSlopes[i][comp].GetValue(x, y);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -204,10 +267,21 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     tev.TextureLinear[i] = rasterBlock.TextureLinear[i];
   }
 
-  tev.Draw();
+  context.tev_pixels_in++;
+  if (!tev.Draw())
+    return;
+  context.tev_pixels_out++;
+
+  // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
+  // extents of these groups, rather than the exact pixel.
+  context.bbox_left = std::min(context.bbox_left, static_cast<u16>(x & ~1));
+  context.bbox_right = std::max(context.bbox_right, static_cast<u16>(x | 1));
+  context.bbox_top = std::min(context.bbox_top, static_cast<u16>(y & ~1));
+  context.bbox_bottom = std::max(context.bbox_bottom, static_cast<u16>(y | 1));
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -218,9 +292,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -258,7 +332,7 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const Triangle& triangle, s32 blockX, s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -269,19 +343,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / triangle.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = triangle.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = triangle.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = triangle.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -291,7 +365,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -303,7 +378,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -320,34 +396,22 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
   }
 }
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
+// Rasterizes the part of the triangle within [minx, maxx) x [miny, maxy), which must be within the
+// triangle's bounding rectangle.
+static void RasterizeTriangle(RasterizerContext& context, const Triangle& triangle, s32 minx,
+                              s32 maxx, s32 miny, s32 maxy)
 {
-  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
-  // zfreeze depends on it
-  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
+  const s32 DX12 = triangle.DX12;
+  const s32 DX23 = triangle.DX23;
+  const s32 DX31 = triangle.DX31;
 
-  // adapted from http://devmaster.net/posts/6145/advanced-rasterization
+  const s32 DY12 = triangle.DY12;
+  const s32 DY23 = triangle.DY23;
+  const s32 DY31 = triangle.DY31;
 
-  // 28.4 fixed-pou32 coordinates. rounded to nearest and adjusted to match hardware output
-  // could also take floor and adjust -8
-  const s32 Y1 = iround(16.0f * (v0->screenPosition.y - scissor.y_off)) - 9;
-  const s32 Y2 = iround(16.0f * (v1->screenPosition.y - scissor.y_off)) - 9;
-  const s32 Y3 = iround(16.0f * (v2->screenPosition.y - scissor.y_off)) - 9;
-
-  const s32 X1 = iround(16.0f * (v0->screenPosition.x - scissor.x_off)) - 9;
-  const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
-  const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
-
-  // Deltas
-  const s32 DX12 = X1 - X2;
-  const s32 DX23 = X2 - X3;
-  const s32 DX31 = X3 - X1;
-
-  const s32 DY12 = Y1 - Y2;
-  const s32 DY23 = Y2 - Y3;
-  const s32 DY31 = Y3 - Y1;
+  const s32 C1 = triangle.C1;
+  const s32 C2 = triangle.C2;
+  const s32 C3 = triangle.C3;
 
   // Fixed-pos32 deltas
   const s32 FDX12 = DX12 * 16;
@@ -358,62 +422,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 FDY23 = DY23 * 16;
   const s32 FDY31 = DY31 * 16;
 
-  // Bounding rectangle
-  s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
-  s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
-  s32 miny = (std::min(std::min(Y1, Y2), Y3) + 0xF) >> 4;
-  s32 maxy = (std::max(std::max(Y1, Y2), Y3) + 0xF) >> 4;
-
-  // scissor
-  ASSERT(scissor.rect.left >= 0);
-  ASSERT(scissor.rect.right <= static_cast<int>(EFB_WIDTH));
-  ASSERT(scissor.rect.top >= 0);
-  ASSERT(scissor.rect.bottom <= static_cast<int>(EFB_HEIGHT));
-
-  minx = std::max(minx, scissor.rect.left);
-  maxx = std::min(maxx, scissor.rect.right);
-  miny = std::max(miny, scissor.rect.top);
-  maxy = std::min(maxy, scissor.rect.bottom);
-
-  if (minx >= maxx || miny >= maxy)
-    return;
-
-  // Set up the remaining slopes
-  const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
-                         scissor.y_off);
-
-  float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
-                1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
-
-  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
-  {
-    for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
-  }
-
-  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
-  {
-    for (int comp = 0; comp < 3; comp++)
-    {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
-    }
-  }
-
-  // Half-edge constants
-  s32 C1 = DY12 * X1 - DX12 * Y1;
-  s32 C2 = DY23 * X2 - DX23 * Y2;
-  s32 C3 = DY31 * X3 - DX31 * Y3;
-
-  // Correct for fill convention
-  if (DY12 < 0 || (DY12 == 0 && DX12 > 0))
-    C1++;
-  if (DY23 < 0 || (DY23 == 0 && DX23 > 0))
-    C2++;
-  if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
-    C3++;
-
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
@@ -455,7 +463,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context.rasterBlock, triangle, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -465,7 +473,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(context, triangle, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -488,7 +496,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(context, triangle, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -505,6 +513,266 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+// Triangles queued for the worker threads, and the indices of the triangles touching each tile.
+static std::vector<Triangle> s_queued_triangles;
+static std::array<std::vector<u32>, TILES_WIDE * TILES_HIGH> s_tile_triangles;
+static std::vector<u32> s_queued_tiles;
+
+static void RasterizeTile(RasterizerContext& context, u32 tile)
+{
+  const s32 tile_left = static_cast<s32>(tile % TILES_WIDE) * TILE_SIZE;
+  const s32 tile_top = static_cast<s32>(tile / TILES_WIDE) * TILE_SIZE;
+  for (const u32 index : s_tile_triangles[tile])
+  {
+    const Triangle& triangle = s_queued_triangles[index];
+    RasterizeTriangle(context, triangle, std::max(triangle.minx, tile_left),
+                      std::min(triangle.maxx, tile_left + TILE_SIZE),
+                      std::max(triangle.miny, tile_top),
+                      std::min(triangle.maxy, tile_top + TILE_SIZE));
+  }
+}
+
+namespace
+{
+// Threads which rasterize tiles alongside the video thread.
+class RasterizerWorkers
+{
+public:
+  ~RasterizerWorkers() { Resize(0); }
+
+  size_t Size() const { return m_workers.size(); }
+
+  void Resize(size_t num_workers)
+  {
+    if (num_workers == m_workers.size())
+      return;
+
+    m_shutdown.Set();
+    for (auto& worker : m_workers)
+      worker->start.Set();
+    for (auto& worker : m_workers)
+      worker->thread.join();
+    m_workers.clear();
+    m_shutdown.Clear();
+
+    for (size_t i = 0; i < num_workers; ++i)
+    {
+      auto& worker = m_workers.emplace_back(std::make_unique<Worker>());
+      worker->thread = std::thread(&RasterizerWorkers::WorkerLoop, this, worker.get());
+    }
+  }
+
+  // Rasterizes the tiles on the calling thread and the workers, and returns once all are done.
+  void Run(std::span<const u32> tiles)
+  {
+    const size_t num_workers = std::min(m_workers.size(), tiles.size() - 1);
+
+    m_tiles = tiles;
+    m_next_tile.store(0, std::memory_order_relaxed);
+    m_pending.store(static_cast<u32>(num_workers), std::memory_order_relaxed);
+    for (size_t i = 0; i < num_workers; ++i)
+      m_workers[i]->start.Set();
+
+    RasterizeTiles(s_context);
+
+    if (num_workers > 0)
+      m_done.Wait();
+  }
+
+  template <typename Func>
+  void ForEachContext(Func func)
+  {
+    for (auto& worker : m_workers)
+      func(worker->context);
+  }
+
+private:
+  struct Worker
+  {
+    std::thread thread;
+    Common::Event start;
+    RasterizerContext context;
+  };
+
+  void RasterizeTiles(RasterizerContext& context)
+  {
+    while (true)
+    {
+      const size_t index = m_next_tile.fetch_add(1, std::memory_order_relaxed);
+      if (index >= m_tiles.size())
+        return;
+      RasterizeTile(context, m_tiles[index]);
+    }
+  }
+
+  void WorkerLoop(Worker* worker)
+  {
+    Common::SetCurrentThreadName("Software rasterizer worker");
+
+    while (true)
+    {
+      worker->start.Wait();
+      if (m_shutdown.IsSet())
+        return;
+
+      // The constants can change between batches.
+      worker->context.tev.SetKonstColors();
+      RasterizeTiles(worker->context);
+      if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_done.Set();
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::span<const u32> m_tiles;
+  std::atomic<size_t> m_next_tile{0};
+  std::atomic<u32> m_pending{0};
+  Common::Event m_done;
+  Common::Flag m_shutdown;
+};
+}  // namespace
+
+static RasterizerWorkers s_workers;
+
+static void RasterizeQueuedTriangles()
+{
+  if (s_queued_triangles.empty())
+    return;
+
+  s_workers.Run(s_queued_tiles);
+
+  for (const u32 tile : s_queued_tiles)
+    s_tile_triangles[tile].clear();
+  s_queued_tiles.clear();
+  s_queued_triangles.clear();
+}
+
+static void QueueTriangle(const Triangle& triangle)
+{
+  const u32 index = static_cast<u32>(s_queued_triangles.size());
+  s_queued_triangles.push_back(triangle);
+
+  const u32 first_tile_x = static_cast<u32>(triangle.minx / TILE_SIZE);
+  const u32 last_tile_x = static_cast<u32>((triangle.maxx - 1) / TILE_SIZE);
+  const u32 first_tile_y = static_cast<u32>(triangle.miny / TILE_SIZE);
+  const u32 last_tile_y = static_cast<u32>((triangle.maxy - 1) / TILE_SIZE);
+  for (u32 tile_y = first_tile_y; tile_y <= last_tile_y; tile_y++)
+  {
+    for (u32 tile_x = first_tile_x; tile_x <= last_tile_x; tile_x++)
+    {
+      const u32 tile = tile_y * TILES_WIDE + tile_x;
+      if (s_tile_triangles[tile].empty())
+        s_queued_tiles.push_back(tile);
+      s_tile_triangles[tile].push_back(index);
+    }
+  }
+
+  if (s_queued_triangles.size() >= MAX_QUEUED_TRIANGLES)
+    RasterizeQueuedTriangles();
+}
+
+static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
+                                  const OutputVertexData* v2,
+                                  const BPFunctions::ScissorRect& scissor)
+{
+  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
+  // zfreeze depends on it
+  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
+
+  // adapted from http://devmaster.net/posts/6145/advanced-rasterization
+
+  // 28.4 fixed-pou32 coordinates. rounded to nearest and adjusted to match hardware output
+  // could also take floor and adjust -8
+  const s32 Y1 = iround(16.0f * (v0->screenPosition.y - scissor.y_off)) - 9;
+  const s32 Y2 = iround(16.0f * (v1->screenPosition.y - scissor.y_off)) - 9;
+  const s32 Y3 = iround(16.0f * (v2->screenPosition.y - scissor.y_off)) - 9;
+
+  const s32 X1 = iround(16.0f * (v0->screenPosition.x - scissor.x_off)) - 9;
+  const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
+  const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
+
+  // Bounding rectangle
+  s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
+  s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
+  s32 miny = (std::min(std::min(Y1, Y2), Y3) + 0xF) >> 4;
+  s32 maxy = (std::max(std::max(Y1, Y2), Y3) + 0xF) >> 4;
+
+  // scissor
+  ASSERT(scissor.rect.left >= 0);
+  ASSERT(scissor.rect.right <= static_cast<int>(EFB_WIDTH));
+  ASSERT(scissor.rect.top >= 0);
+  ASSERT(scissor.rect.bottom <= static_cast<int>(EFB_HEIGHT));
+
+  minx = std::max(minx, scissor.rect.left);
+  maxx = std::min(maxx, scissor.rect.right);
+  miny = std::max(miny, scissor.rect.top);
+  maxy = std::min(maxy, scissor.rect.bottom);
+
+  if (minx >= maxx || miny >= maxy)
+    return;
+
+  Triangle triangle;
+  triangle.ZSlope = ZSlope;
+  triangle.minx = minx;
+  triangle.maxx = maxx;
+  triangle.miny = miny;
+  triangle.maxy = maxy;
+
+  // Set up the remaining slopes
+  const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
+                         scissor.y_off);
+
+  float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
+                1.0f / v2->projectedPosition.w};
+  triangle.WSlope = Slope(w[0], w[1], w[2], ctx);
+
+  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
+  {
+    for (int comp = 0; comp < 4; comp++)
+    {
+      triangle.ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
+  }
+
+  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
+  {
+    for (int comp = 0; comp < 3; comp++)
+    {
+      triangle.TexSlopes[i][comp] =
+          Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
+                v2->texCoords[i][comp] * w[2], ctx);
+    }
+  }
+
+  // Deltas
+  triangle.DX12 = X1 - X2;
+  triangle.DX23 = X2 - X3;
+  triangle.DX31 = X3 - X1;
+
+  triangle.DY12 = Y1 - Y2;
+  triangle.DY23 = Y2 - Y3;
+  triangle.DY31 = Y3 - Y1;
+
+  // Half-edge constants
+  triangle.C1 = triangle.DY12 * X1 - triangle.DX12 * Y1;
+  triangle.C2 = triangle.DY23 * X2 - triangle.DX23 * Y2;
+  triangle.C3 = triangle.DY31 * X3 - triangle.DX31 * Y3;
+
+  // Correct for fill convention
+  if (triangle.DY12 < 0 || (triangle.DY12 == 0 && triangle.DX12 > 0))
+    triangle.C1++;
+  if (triangle.DY23 < 0 || (triangle.DY23 == 0 && triangle.DX23 > 0))
+    triangle.C2++;
+  if (triangle.DY31 < 0 || (triangle.DY31 == 0 && triangle.DX31 > 0))
+    triangle.C3++;
+
+  if (s_workers.Size() == 0)
+    RasterizeTriangle(s_context, triangle, minx, maxx, miny, maxy);
+  else
+    QueueTriangle(triangle);
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
@@ -513,4 +781,37 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   for (const auto& scissor : scissors)
     DrawTriangleFrontFace(v0, v1, v2, scissor);
 }
+
+static void FlushContext(RasterizerContext& context)
+{
+  context.tev.ClearTexelCache();
+
+  ADDSTAT(g_stats.this_frame.rasterized_pixels, context.rasterized_pixels);
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, context.tev_pixels_in);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, context.tev_pixels_out);
+  context.rasterized_pixels = 0;
+  context.tev_pixels_in = 0;
+  context.tev_pixels_out = 0;
+
+  if (context.bbox_left <= context.bbox_right)
+  {
+    BBoxManager::Update(context.bbox_left, context.bbox_right, context.bbox_top,
+                        context.bbox_bottom);
+    context.bbox_left = std::numeric_limits<u16>::max();
+    context.bbox_right = 0;
+    context.bbox_top = std::numeric_limits<u16>::max();
+    context.bbox_bottom = 0;
+  }
+}
+
+void Flush()
+{
+  RasterizeQueuedTriangles();
+
+  FlushContext(s_context);
+  s_workers.ForEachContext(FlushContext);
+
+  // Only resize between batches, where no triangles are queued.
+  s_workers.Resize(static_cast<size_t>(std::max(g_ActiveConfig.iSWRasterizerThreads, 0)));
+}
 }  // namespace Rasterizer
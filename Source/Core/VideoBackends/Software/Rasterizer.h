@@ -19,6 +19,10 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
 
 void SetTevKonstColors();
 
+// Waits for the triangles drawn so far to be rasterized, and updates the statistics and bounding
+// box. Must be called at the end of each batch, before the EFB or the GX state is accessed.
+void Flush();
+
 struct RasterBlockPixel
 {
   float InvW;
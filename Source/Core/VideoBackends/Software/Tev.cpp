@@ -9,17 +9,20 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "VideoBackends/Software/EfbInterface.h"
-#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderManager.h"
-#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #ifdef _DEBUG
 #define ALLOW_TEV_DUMPS 1
 #else
@@ -103,6 +106,112 @@ void Tev::DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const Inpu
   }
 }
 
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+void Tev::DrawRegularSIMD(const TevStageCombiner::ColorCombiner& cc,
+                          const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
+{
+  // Per-lane parameters, in the order of the channel indices (alpha, blue, green, red).
+  const auto lanes = [](s32 alpha, s32 color) -> std::array<s32, 4> {
+    return {alpha, color, color, color};
+  };
+  const auto round = [](TevScale scale, TevOp op) -> s32 {
+    return (scale == TevScale::Divide2) ? 0 : (op == TevOp::Sub) ? 127 : 128;
+  };
+  const auto gather = [inputs](auto member) -> std::array<s32, 4> {
+    return {s32(member(inputs[ALP_C])), s32(member(inputs[BLU_C])), s32(member(inputs[GRN_C])),
+            s32(member(inputs[RED_C]))};
+  };
+  const std::array<s32, 4> a_values = gather([](const InputRegType& in) { return in.a; });
+  const std::array<s32, 4> b_values = gather([](const InputRegType& in) { return in.b; });
+  const std::array<s32, 4> c_values = gather([](const InputRegType& in) { return in.c; });
+  const std::array<s32, 4> d_values = gather([](const InputRegType& in) { return in.d; });
+  const std::array<s32, 4> lshift = lanes(s_ScaleLShiftLUT[ac.scale], s_ScaleLShiftLUT[cc.scale]);
+  const std::array<s32, 4> rshift = lanes(s_ScaleRShiftLUT[ac.scale], s_ScaleRShiftLUT[cc.scale]);
+  const std::array<s32, 4> rounding = lanes(round(ac.scale, ac.op), round(cc.scale, cc.op));
+  const std::array<s32, 4> bias = lanes(s_BiasLUT[ac.bias], s_BiasLUT[cc.bias]);
+  // The alpha combiner negates before the shift by 8, the color combiner after it.
+  const std::array<s32, 4> negate_before = lanes(ac.op == TevOp::Sub ? -1 : 0, 0);
+  const std::array<s32, 4> negate_after = lanes(0, cc.op == TevOp::Sub ? -1 : 0);
+  const std::array<s16, 4> lower = {s16(ac.clamp ? 0 : -1024), s16(cc.clamp ? 0 : -1024),
+                                    s16(cc.clamp ? 0 : -1024), s16(cc.clamp ? 0 : -1024)};
+  const std::array<s16, 4> upper = {s16(ac.clamp ? 255 : 1023), s16(cc.clamp ? 255 : 1023),
+                                    s16(cc.clamp ? 255 : 1023), s16(cc.clamp ? 255 : 1023)};
+  std::array<s16, 4> output;
+
+#if defined(_M_X86_64)
+  const auto load = [](const std::array<s32, 4>& values) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data()));
+  };
+  // Shifts left by 0, 1 or 2, by doubling the lanes which need it.
+  const __m128i shift1 = _mm_cmpgt_epi32(load(lshift), _mm_setzero_si128());
+  const __m128i shift2 = _mm_cmpgt_epi32(load(lshift), _mm_set1_epi32(1));
+  const auto shift_left = [&](__m128i value) {
+    value = _mm_add_epi32(value, _mm_and_si128(value, shift1));
+    return _mm_add_epi32(value, _mm_and_si128(value, shift2));
+  };
+
+  // a * (256 - c) + b * c, as a pair of 16-bit multiplies per lane.
+  const __m128i c = load(c_values);
+  const __m128i c_adj = _mm_add_epi32(c, _mm_srli_epi32(c, 7));
+  const __m128i ab = _mm_or_si128(load(a_values), _mm_slli_epi32(load(b_values), 16));
+  const __m128i weights =
+      _mm_or_si128(_mm_sub_epi32(_mm_set1_epi32(256), c_adj), _mm_slli_epi32(c_adj, 16));
+  __m128i temp = shift_left(_mm_madd_epi16(ab, weights));
+  temp = _mm_add_epi32(temp, load(rounding));
+  const __m128i negate_before_mask = load(negate_before);
+  const __m128i negate_after_mask = load(negate_after);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_before_mask), negate_before_mask);
+  temp = _mm_srai_epi32(temp, 8);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_after_mask), negate_after_mask);
+
+  __m128i result = _mm_add_epi32(shift_left(_mm_add_epi32(load(d_values), load(bias))), temp);
+  const __m128i rshift_mask = _mm_cmpgt_epi32(load(rshift), _mm_setzero_si128());
+  result = _mm_or_si128(_mm_andnot_si128(rshift_mask, result),
+                        _mm_and_si128(rshift_mask, _mm_srai_epi32(result, 1)));
+
+  // Truncate to 16 bits like the assignment to the registers, then clamp.
+  result = _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+  __m128i packed = _mm_packs_epi32(result, result);
+  packed = _mm_max_epi16(packed, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(lower.data())));
+  packed = _mm_min_epi16(packed, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(upper.data())));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(output.data()), packed);
+#else
+  const int32x4_t lshift_vec = vld1q_s32(lshift.data());
+
+  // a * (256 - c) + b * c
+  const int32x4_t c = vld1q_s32(c_values.data());
+  const int32x4_t c_adj = vaddq_s32(c, vshrq_n_s32(c, 7));
+  int32x4_t temp = vmulq_s32(vld1q_s32(a_values.data()), vsubq_s32(vdupq_n_s32(256), c_adj));
+  temp = vmlaq_s32(temp, vld1q_s32(b_values.data()), c_adj);
+  temp = vshlq_s32(temp, lshift_vec);
+  temp = vaddq_s32(temp, vld1q_s32(rounding.data()));
+  const uint32x4_t negate_before_mask = vreinterpretq_u32_s32(vld1q_s32(negate_before.data()));
+  const uint32x4_t negate_after_mask = vreinterpretq_u32_s32(vld1q_s32(negate_after.data()));
+  temp = vbslq_s32(negate_before_mask, vnegq_s32(temp), temp);
+  temp = vshrq_n_s32(temp, 8);
+  temp = vbslq_s32(negate_after_mask, vnegq_s32(temp), temp);
+
+  int32x4_t result =
+      vaddq_s32(vshlq_s32(vaddq_s32(vld1q_s32(d_values.data()), vld1q_s32(bias.data())),
+                          lshift_vec),
+                temp);
+  // Shifting left by a negative amount is an arithmetic shift right.
+  result = vshlq_s32(result, vnegq_s32(vld1q_s32(rshift.data())));
+
+  // Truncate to 16 bits like the assignment to the registers, then clamp.
+  int16x4_t narrowed = vmovn_s32(result);
+  narrowed = vmax_s16(narrowed, vld1_s16(lower.data()));
+  narrowed = vmin_s16(narrowed, vld1_s16(upper.data()));
+  vst1_s16(output.data(), narrowed);
+#endif
+
+  Reg[cc.dest].b = output[BLU_C];
+  Reg[cc.dest].g = output[GRN_C];
+  Reg[cc.dest].r = output[RED_C];
+  Reg[ac.dest].a = output[ALP_C];
+}
+#endif
+
 void Tev::DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4])
 {
   for (int i = BLU_C; i <= RED_C; i++)
@@ -389,13 +498,11 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
   }
 }
 
-void Tev::Draw()
+bool Tev::Draw()
 {
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
-
   // initial color values
   for (int i = 0; i < 4; i++)
   {
@@ -426,7 +533,7 @@ void Tev::Draw()
 
     TextureSampler::Sample(Uv[texcoordSel].s >> scaleS, Uv[texcoordSel].t >> scaleT,
                            IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
-                           IndirectTex[stageNum]);
+                           IndirectTex[stageNum], &m_texel_cache);
   }
 
   for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
@@ -458,7 +565,7 @@ void Tev::Draw()
       if (bpmem.genMode.numtexgens > 0)
       {
         TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum],
-                               TextureLinear[stageNum], texmap, texel);
+                               TextureLinear[stageNum], texmap, texel, &m_texel_cache);
       }
       else
       {
@@ -504,6 +611,14 @@ void Tev::Draw()
     inputs[ALP_C].c = m_AlphaInputLUT[ac.c].a;
     inputs[ALP_C].d = m_AlphaInputLUT[ac.d].a;
 
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+    if (cc.bias != TevBias::Compare && ac.bias != TevBias::Compare)
+    {
+      DrawRegularSIMD(cc, ac, inputs);
+      continue;
+    }
+#endif
+
     if (cc.bias != TevBias::Compare)
       DrawColorRegular(cc, inputs);
     else
@@ -542,7 +657,7 @@ void Tev::Draw()
                   (u8)Reg[color_index].r};
 
   if (!TevAlphaTest(output[ALP_C]))
-    return;
+    return false;
 
   // Hardware testing indicates that an alpha of 1 can pass an alpha test,
   // but doesn't do anything in blending
@@ -676,20 +791,15 @@ void Tev::Draw()
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
-      return;
+      return false;
 
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
   }
 
-  // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
-  // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
-
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
   EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
+  return true;
 }
 
 void Tev::SetKonstColors()
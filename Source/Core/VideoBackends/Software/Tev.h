@@ -6,6 +6,7 @@
 #include <array>
 
 #include "Common/EnumMap.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoCommon/BPMemory.h"
 
 class Tev
@@ -122,6 +123,7 @@ class Tev
   u8 AlphaBump;
   u8 IndirectTex[4][4];
   TextureCoordinateType TexCoord;
+  TextureSampler::TexelCache m_texel_cache;
 
   const Common::EnumMap<TevColorRef, TevColorArg::Zero> m_ColorInputLUT{
       TevColorRef::Color(Reg[TevOutput::Prev]),    // prev.rgb
@@ -206,6 +208,12 @@ class Tev
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+  // Evaluates regular color and alpha combiners together, with a SIMD lane per channel. Gives the
+  // same results as DrawColorRegular and DrawAlphaRegular followed by the clamping in Draw.
+  void DrawRegularSIMD(const TevStageCombiner::ColorCombiner& cc,
+                       const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+#endif
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
@@ -227,5 +235,8 @@ public:
   };
 
   void SetKonstColors();
-  void Draw();
+  // Must be called after every batch, since textures can change between batches.
+  void ClearTexelCache() { m_texel_cache.Clear(); }
+  // Returns false if the pixel was discarded by the alpha or depth test.
+  bool Draw();
 };
@@ -5,14 +5,20 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureDecoder.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #define ALLOW_MIPMAP 1
 
 namespace TextureSampler
@@ -67,7 +73,113 @@ static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
   outTexel[3] += inTexel[3] * fract;
 }
 
-void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
+// Where and how the texels of one mip level of a texture are decoded from.
+struct TexelSource
+{
+  const u8* imageSrc;
+  const u8* imageSrcOdd;
+  int image_width_minus_1;
+  TextureFormat texfmt;
+  const u8* tlut;
+  TLUTFormat tlutfmt;
+  bool rgba8_from_tmem;
+  // The texture map and mip level, as part of a TexelCache tag.
+  u32 tag;
+};
+
+static void DecodeTexel(const TexelSource& source, int s, int t, u8* texel)
+{
+  if (!source.rgba8_from_tmem)
+  {
+    TexDecoder_DecodeTexel(texel, source.imageSrc, s, t, source.image_width_minus_1, source.texfmt,
+                           source.tlut, source.tlutfmt);
+  }
+  else
+  {
+    TexDecoder_DecodeTexelRGBA8FromTmem(texel, source.imageSrc, source.imageSrcOdd, s, t,
+                                        source.image_width_minus_1);
+  }
+}
+
+// Returns the texel at the wrapped coordinates s and t, decoding it only if it isn't cached.
+static const u8* GetTexel(TexelCache* cache, const TexelSource& source, int s, int t)
+{
+  const u32 block_s = static_cast<u32>(s) >> 2;
+  const u32 block_t = static_cast<u32>(t) >> 2;
+  const u32 tag = source.tag | (block_s << 8) | (block_t << 20);
+  TexelCache::Entry& entry =
+      cache->entries[(block_s ^ (block_t << 4) ^ (source.tag << 3)) % TexelCache::NUM_ENTRIES];
+  if (entry.tag != tag)
+  {
+    entry.tag = tag;
+    entry.valid = 0;
+  }
+
+  const u32 index = (t & 3) * 4 + (s & 3);
+  u8* texel = &entry.texels[index * 4];
+  if (!(entry.valid & (1 << index)))
+  {
+    DecodeTexel(source, s, t, texel);
+    entry.valid |= 1 << index;
+  }
+  return texel;
+}
+
+// Blends four texels with weights which add up to 128 * 128.
+static void Bilinear(const u8* texel00, const u8* texel10, const u8* texel01, const u8* texel11,
+                     u32 fractS, u32 fractT, u8* sample)
+{
+  const u32 weight00 = (128 - fractS) * (128 - fractT);
+  const u32 weight10 = fractS * (128 - fractT);
+  const u32 weight01 = (128 - fractS) * fractT;
+  const u32 weight11 = fractS * fractT;
+
+#if defined(_M_X86_64)
+  const auto load = [](const u8* texel) {
+    u32 value;
+    std::memcpy(&value, texel, sizeof(value));
+    return _mm_cvtsi32_si128(static_cast<int>(value));
+  };
+  // Interleaves the channels of two texels as 16-bit values, to be multiplied and added in pairs.
+  const auto interleave = [&load](const u8* a, const u8* b) {
+    return _mm_unpacklo_epi8(_mm_unpacklo_epi8(load(a), load(b)), _mm_setzero_si128());
+  };
+  const auto weights = [](u32 a, u32 b) { return _mm_set1_epi32(static_cast<int>(a | b << 16)); };
+  const __m128i top = _mm_madd_epi16(interleave(texel00, texel10), weights(weight00, weight10));
+  const __m128i bottom = _mm_madd_epi16(interleave(texel01, texel11), weights(weight01, weight11));
+  const __m128i sum = _mm_srli_epi32(_mm_add_epi32(top, bottom), 14);
+  const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(sum, sum), sum);
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(packed));
+  std::memcpy(sample, &result, sizeof(result));
+#elif defined(_M_ARM_64)
+  const auto load = [](const u8* texel) {
+    u32 value;
+    std::memcpy(&value, texel, sizeof(value));
+    return vget_low_u16(vmovl_u8(vcreate_u8(value)));
+  };
+  uint32x4_t sum = vmull_n_u16(load(texel00), static_cast<u16>(weight00));
+  sum = vmlal_n_u16(sum, load(texel10), static_cast<u16>(weight10));
+  sum = vmlal_n_u16(sum, load(texel01), static_cast<u16>(weight01));
+  sum = vmlal_n_u16(sum, load(texel11), static_cast<u16>(weight11));
+  const uint16x4_t narrowed = vshrn_n_u32(sum, 14);
+  const u32 result =
+      vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(narrowed, narrowed))), 0);
+  std::memcpy(sample, &result, sizeof(result));
+#else
+  u32 texel[4];
+  SetTexel(texel00, texel, weight00);
+  AddTexel(texel10, texel, weight10);
+  AddTexel(texel01, texel, weight01);
+  AddTexel(texel11, texel, weight11);
+
+  sample[0] = (u8)(texel[0] >> 14);
+  sample[1] = (u8)(texel[1] >> 14);
+  sample[2] = (u8)(texel[2] >> 14);
+  sample[3] = (u8)(texel[3] >> 14);
+#endif
+}
+
+void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample, TexelCache* cache)
 {
   int baseMip = 0;
   bool mipLinear = false;
@@ -94,10 +206,10 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
     u8 sampledTex[4];
     u32 texel[4];
 
-    SampleMip(s, t, baseMip, linear, texmap, sampledTex);
+    SampleMip(s, t, baseMip, linear, texmap, sampledTex, cache);
     SetTexel(sampledTex, texel, (16 - lodFract));
 
-    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex);
+    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex, cache);
     AddTexel(sampledTex, texel, lodFract);
 
     sample[0] = (u8)(texel[0] >> 4);
@@ -108,11 +220,11 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
   else
 #endif
   {
-    SampleMip(s, t, baseMip, linear, texmap, sample);
+    SampleMip(s, t, baseMip, linear, texmap, sample, cache);
   }
 }
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample, TexelCache* cache)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -142,6 +254,8 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
   const int tlutAddress = texTlut.tmem_offset << 9;
   const u8* tlut = &texMem[tlutAddress];
 
+  const u32 mip_level = static_cast<u32>(mip);
+
   // reduce sample location and texture size to mip level
   // move texture pointer to mip location
   if (mip)
@@ -171,6 +285,17 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     }
   }
 
+  const TexelSource source = {
+      imageSrc,
+      imageSrcOdd,
+      image_width_minus_1,
+      texfmt,
+      tlut,
+      tlutfmt,
+      texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed,
+      1u | static_cast<u32>(texmap) << 1 | static_cast<u32>(mip_level) << 4,
+  };
+
   if (linear)
   {
     // offset linear sampling
@@ -188,55 +313,14 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
-
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
     WrapCoord(&imageSPlus1, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageTPlus1, tm0.wrap_t, image_height_minus_1 + 1);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
-    {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
-                                          image_width_minus_1);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
-                                          imageTPlus1, image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    Bilinear(GetTexel(cache, source, imageS, imageT), GetTexel(cache, source, imageSPlus1, imageT),
+             GetTexel(cache, source, imageS, imageTPlus1),
+             GetTexel(cache, source, imageSPlus1, imageTPlus1), fractS, fractT, sample);
   }
   else
   {
@@ -248,12 +332,7 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
-      TexDecoder_DecodeTexel(sample, imageSrc, imageS, imageT, image_width_minus_1, texfmt, tlut,
-                             tlutfmt);
-    else
-      TexDecoder_DecodeTexelRGBA8FromTmem(sample, imageSrc, imageSrcOdd, imageS, imageT,
-                                          image_width_minus_1);
+    std::memcpy(sample, GetTexel(cache, source, imageS, imageT), 4);
   }
 }
 }  // namespace TextureSampler
@@ -3,13 +3,39 @@
 
 #pragma once
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 
 namespace TextureSampler
 {
-void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
+// Texels decoded since the last Clear(), in 4x4 blocks. Textures can't change while a batch is
+// rasterized, so each rasterizer thread keeps its own cache and clears it after every batch.
+struct TexelCache
+{
+  static constexpr u32 NUM_ENTRIES = 256;
+
+  struct Entry
+  {
+    // The texture map, mip level and block coordinates. 0 is never a valid tag.
+    u32 tag = 0;
+    // One bit per texel which has been decoded.
+    u16 valid = 0;
+    std::array<u8, 4 * 16> texels;
+  };
+
+  void Clear()
+  {
+    for (Entry& entry : entries)
+      entry.tag = 0;
+  }
+
+  std::array<Entry, NUM_ENTRIES> entries;
+};
+
+void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample, TexelCache* cache);
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
+void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample, TexelCache* cache);
 
 enum
 {
@@ -10,6 +10,7 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
@@ -20,6 +21,10 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/XFMemory.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace TransformUnit
 {
 static void MultiplyVec2Mat24(const Vec3& vec, const float* mat, Vec3& result)
@@ -36,11 +41,65 @@ static void MultiplyVec2Mat34(const Vec3& vec, const float* mat, Vec3& result)
   result.z = mat[8] * vec.x + mat[9] * vec.y + mat[10] + mat[11];
 }
 
+#if defined(_M_X86_64)
+// Multiplies the three rows by vec with a SIMD lane per row. The products are added in the same
+// order as in the scalar code below, so the results are identical. For 3x3 matrices, column 3 is
+// ignored and can hold anything.
+template <bool translate>
+static void MultiplyVec3Rows(const Vec3& vec, __m128 row0, __m128 row1, __m128 row2,
+                             Vec3& result)
+{
+  __m128 row3 = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+  __m128 sum = _mm_mul_ps(row0, _mm_set1_ps(vec.x));
+  sum = _mm_add_ps(sum, _mm_mul_ps(row1, _mm_set1_ps(vec.y)));
+  sum = _mm_add_ps(sum, _mm_mul_ps(row2, _mm_set1_ps(vec.z)));
+  if constexpr (translate)
+    sum = _mm_add_ps(sum, row3);
+
+  alignas(16) float out[4];
+  _mm_store_ps(out, sum);
+  result = Vec3(out);
+}
+#elif defined(_M_ARM_64)
+template <bool translate>
+static void MultiplyVec3Rows(const Vec3& vec, float32x4_t row0, float32x4_t row1,
+                             float32x4_t row2, Vec3& result)
+{
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  const float32x4_t low02 = vzip1q_f32(row0, row2);
+  const float32x4_t low1z = vzip1q_f32(row1, zero);
+  const float32x4_t high02 = vzip2q_f32(row0, row2);
+  const float32x4_t high1z = vzip2q_f32(row1, zero);
+  // Separate multiplies and adds rather than vmlaq_f32, which may be fused.
+  float32x4_t sum = vmulq_n_f32(vzip1q_f32(low02, low1z), vec.x);
+  sum = vaddq_f32(sum, vmulq_n_f32(vzip2q_f32(low02, low1z), vec.y));
+  sum = vaddq_f32(sum, vmulq_n_f32(vzip1q_f32(high02, high1z), vec.z));
+  if constexpr (translate)
+    sum = vaddq_f32(sum, vzip2q_f32(high02, high1z));
+
+  float out[4];
+  vst1q_f32(out, sum);
+  result = Vec3(out);
+}
+#endif
+
 static void MultiplyVec3Mat33(const Vec3& vec, const float* mat, Vec3& result)
 {
+#if defined(_M_X86_64)
+  // The last row is loaded from one float earlier, so that nothing past the matrix is read.
+  const __m128 row2 = _mm_loadu_ps(mat + 5);
+  MultiplyVec3Rows<false>(vec, _mm_loadu_ps(mat), _mm_loadu_ps(mat + 3),
+                          _mm_shuffle_ps(row2, row2, _MM_SHUFFLE(0, 3, 2, 1)), result);
+#elif defined(_M_ARM_64)
+  const float32x4_t row2 = vld1q_f32(mat + 5);
+  MultiplyVec3Rows<false>(vec, vld1q_f32(mat), vld1q_f32(mat + 3), vextq_f32(row2, row2, 1),
+                          result);
+#else
   result.x = mat[0] * vec.x + mat[1] * vec.y + mat[2] * vec.z;
   result.y = mat[3] * vec.x + mat[4] * vec.y + mat[5] * vec.z;
   result.z = mat[6] * vec.x + mat[7] * vec.y + mat[8] * vec.z;
+#endif
 }
 
 static void MultiplyVec3Mat24(const Vec3& vec, const float* mat, Vec3& result)
@@ -52,9 +111,16 @@ static void MultiplyVec3Mat24(const Vec3& vec, const float* mat, Vec3& result)
 
 static void MultiplyVec3Mat34(const Vec3& vec, const float* mat, Vec3& result)
 {
+#if defined(_M_X86_64)
+  MultiplyVec3Rows<true>(vec, _mm_loadu_ps(mat), _mm_loadu_ps(mat + 4), _mm_loadu_ps(mat + 8),
+                         result);
+#elif defined(_M_ARM_64)
+  MultiplyVec3Rows<true>(vec, vld1q_f32(mat), vld1q_f32(mat + 4), vld1q_f32(mat + 8), result);
+#else
   result.x = mat[0] * vec.x + mat[1] * vec.y + mat[2] * vec.z + mat[3];
   result.y = mat[4] * vec.x + mat[5] * vec.y + mat[6] * vec.z + mat[7];
   result.z = mat[8] * vec.x + mat[9] * vec.y + mat[10] * vec.z + mat[11];
+#endif
 }
 
 static void MultipleVec3Perspective(const Vec3& vec, const Projection::Raw& proj, Vec4& result)
@@ -238,7 +238,7 @@ bool CommandBufferManager::CreateSubmitThread()
       }
 
       SubmitCommandBuffer(submit.command_buffer_index, submit.present_swap_chain,
-                          submit.present_image_index);
+                          submit.present_image_index, submit.present_id);
 
       {
         std::lock_guard<std::mutex> guard(m_pending_submit_lock);
@@ -282,6 +282,35 @@ void CommandBufferManager::WaitForFenceCounter(u64 fence_counter)
   WaitForCommandBufferCompletion(index);
 }
 
+bool CommandBufferManager::IsFenceCounterComplete(u64 fence_counter)
+{
+  if (m_completed_fence_counter >= fence_counter)
+    return true;
+
+  // Find the first command buffer which covers this counter value.
+  u32 index = (m_current_cmd_buffer + 1) % NUM_COMMAND_BUFFERS;
+  while (index != m_current_cmd_buffer)
+  {
+    if (m_command_buffers[index].fence_counter >= fence_counter)
+      break;
+
+    index = (index + 1) % NUM_COMMAND_BUFFERS;
+  }
+
+  // Commands in the current command buffer haven't even been submitted yet.
+  if (index == m_current_cmd_buffer)
+    return false;
+
+  // The fence can't be accessed while the submit thread may still be submitting with it.
+  WaitForWorkerThreadIdle();
+  if (vkGetFenceStatus(g_vulkan_context->GetDevice(), m_command_buffers[index].fence) != VK_SUCCESS)
+    return false;
+
+  // Already complete, so this only cleans up resources.
+  WaitForCommandBufferCompletion(index);
+  return true;
+}
+
 void CommandBufferManager::WaitForCommandBufferCompletion(u32 index)
 {
   // Ensure this command buffer has been submitted.
@@ -323,18 +352,11 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
                                                VkSwapchainKHR present_swap_chain,
                                                uint32_t present_image_index)
 {
-  // End the current command buffer.
-  CmdBufferResources& resources = GetCurrentCmdBufferResources();
-  for (VkCommandBuffer command_buffer : resources.command_buffers)
-  {
-    VkResult res = vkEndCommandBuffer(command_buffer);
-    if (res != VK_SUCCESS)
-    {
-      LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
-      PanicAlertFmt("Failed to end command buffer: {} ({})", VkResultToString(res),
-                    static_cast<int>(res));
-    }
-  }
+  // The command buffers are ended by whichever thread submits them, as some drivers do a
+  // significant amount of work in vkEndCommandBuffer. This thread won't touch them again until
+  // BeginCommandBuffer has waited for the worker to go idle.
+
+  const u64 present_id = present_swap_chain != VK_NULL_HANDLE ? ++m_last_present_id : 0;
 
   // Submitting off-thread?
   if (m_use_threaded_submission && submit_on_worker_thread && !wait_for_completion)
@@ -343,7 +365,8 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
     {
       std::lock_guard<std::mutex> guard(m_pending_submit_lock);
       m_submit_worker_idle = false;
-      m_pending_submits.push_back({present_swap_chain, present_image_index, m_current_cmd_buffer});
+      m_pending_submits.push_back(
+          {present_swap_chain, present_image_index, m_current_cmd_buffer, present_id});
     }
 
     // Wake up the worker thread for a single iteration.
@@ -354,7 +377,8 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
     WaitForWorkerThreadIdle();
 
     // Pass through to normal submission path.
-    SubmitCommandBuffer(m_current_cmd_buffer, present_swap_chain, present_image_index);
+    SubmitCommandBuffer(m_current_cmd_buffer, present_swap_chain, present_image_index,
+                        present_id);
     if (wait_for_completion)
       WaitForCommandBufferCompletion(m_current_cmd_buffer);
   }
@@ -399,6 +423,7 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
     }
 
     frame_resources.current_descriptor_pool_index = 0;
+    m_descriptor_pool_generation++;
   }
 
   // Switch to next cmdbuffer.
@@ -407,11 +432,22 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
 
 void CommandBufferManager::SubmitCommandBuffer(u32 command_buffer_index,
                                                VkSwapchainKHR present_swap_chain,
-                                               u32 present_image_index)
+                                               u32 present_image_index, u64 present_id)
 {
   CmdBufferResources& resources = m_command_buffers[command_buffer_index];
 
   // This may be executed on the worker thread, so don't modify any state of the manager class.
+  for (VkCommandBuffer command_buffer : resources.command_buffers)
+  {
+    VkResult res = vkEndCommandBuffer(command_buffer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
+      PanicAlertFmt("Failed to end command buffer: {} ({})", VkResultToString(res),
+                    static_cast<int>(res));
+    }
+  }
+
   uint32_t wait_bits = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
   VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO,
                               nullptr,
@@ -464,6 +500,10 @@ void CommandBufferManager::SubmitCommandBuffer(u32 command_buffer_index,
                                      &present_image_index,
                                      nullptr};
 
+    VkPresentIdKHR present_id_info = {VK_STRUCTURE_TYPE_PRESENT_ID_KHR, nullptr, 1, &present_id};
+    if (g_vulkan_context->SupportsPresentWait())
+      present_info.pNext = &present_id_info;
+
     m_last_present_result = vkQueuePresentKHR(g_vulkan_context->GetPresentQueue(), &present_info);
     if (m_last_present_result != VK_SUCCESS)
     {
@@ -567,5 +607,11 @@ void CommandBufferManager::DeferImageViewDestruction(VkImageView object)
       [object]() { vkDestroyImageView(g_vulkan_context->GetDevice(), object, nullptr); });
 }
 
+void CommandBufferManager::DeferCallback(std::function<void()> callback)
+{
+  CmdBufferResources& cmd_buffer_resources = GetCurrentCmdBufferResources();
+  cmd_buffer_resources.cleanup_resources.push_back(std::move(callback));
+}
+
 std::unique_ptr<CommandBufferManager> g_command_buffer_mgr;
 }  // namespace Vulkan
@@ -76,6 +76,9 @@ public:
   // Also invokes callbacks for completion.
   void WaitForFenceCounter(u64 fence_counter);
 
+  // Returns whether a fence has been completed, without waiting for it.
+  bool IsFenceCounterComplete(u64 fence_counter);
+
   void SubmitCommandBuffer(bool submit_on_worker_thread, bool wait_for_completion,
                            VkSwapchainKHR present_swap_chain = VK_NULL_HANDLE,
                            uint32_t present_image_index = 0xFFFFFFFF);
@@ -84,6 +87,15 @@ public:
   bool CheckLastPresentFail() { return m_last_present_failed.TestAndClear(); }
   VkResult GetLastPresentResult() const { return m_last_present_result; }
 
+  // Returns the present ID which was assigned to the last submitted present, for use with
+  // vkWaitForPresentKHR. Present IDs start at 1, and are only passed to the driver when the
+  // device supports VK_KHR_present_wait.
+  u64 GetLastPresentId() const { return m_last_present_id; }
+
+  // Incremented whenever the descriptor pools of a frame are reset, which frees every descriptor
+  // set allocated before it for that frame.
+  u64 GetDescriptorPoolGeneration() const { return m_descriptor_pool_generation; }
+
   // Schedule a vulkan resource for destruction later on. This will occur when the command buffer
   // is next re-used, and the GPU has finished working with the specified resource.
   void DeferBufferDestruction(VkBuffer object);
@@ -92,6 +104,8 @@ public:
   void DeferFramebufferDestruction(VkFramebuffer object);
   void DeferImageDestruction(VkImage object);
   void DeferImageViewDestruction(VkImageView object);
+  // Calls the function once the GPU has finished executing the current command buffer.
+  void DeferCallback(std::function<void()> callback);
 
 private:
   bool CreateCommandBuffers();
@@ -101,7 +115,7 @@ private:
 
   void WaitForCommandBufferCompletion(u32 command_buffer_index);
   void SubmitCommandBuffer(u32 command_buffer_index, VkSwapchainKHR present_swap_chain,
-                           u32 present_image_index);
+                           u32 present_image_index, u64 present_id);
   void BeginCommandBuffer();
 
   VkDescriptorPool CreateDescriptorPool(u32 descriptor_sizes);
@@ -152,6 +166,7 @@ private:
     VkSwapchainKHR present_swap_chain;
     u32 present_image_index;
     u32 command_buffer_index;
+    u64 present_id;
   };
   VkSemaphore m_present_semaphore = VK_NULL_HANDLE;
   std::deque<PendingCommandBufferSubmit> m_pending_submits;
@@ -160,6 +175,8 @@ private:
   bool m_submit_worker_idle = true;
   Common::Flag m_last_present_failed;
   VkResult m_last_present_result = VK_SUCCESS;
+  u64 m_last_present_id = 0;
+  u64 m_descriptor_pool_generation = 0;
   bool m_use_threaded_submission = false;
   u32 m_descriptor_set_count = 0;
 };
@@ -459,27 +459,6 @@ void ObjectCache::DestroyRenderPassCache()
   m_render_pass_cache.clear();
 }
 
-class PipelineCacheReadCallback : public LinearDiskCacheReader<u32, u8>
-{
-public:
-  PipelineCacheReadCallback(std::vector<u8>* data) : m_data(data) {}
-  void Read(const u32& key, const u8* value, u32 value_size) override
-  {
-    m_data->resize(value_size);
-    if (value_size > 0)
-      memcpy(m_data->data(), value, value_size);
-  }
-
-private:
-  std::vector<u8>* m_data;
-};
-
-class PipelineCacheReadIgnoreCallback : public LinearDiskCacheReader<u32, u8>
-{
-public:
-  void Read(const u32& key, const u8* value, u32 value_size) override {}
-};
-
 bool ObjectCache::CreatePipelineCache()
 {
   // Vulkan pipeline caches can be shared between games for shader compile time reduction.
@@ -512,8 +491,7 @@ bool ObjectCache::LoadPipelineCache()
 
   std::vector<u8> disk_data;
   LinearDiskCache<u32, u8> disk_cache;
-  PipelineCacheReadCallback read_callback(&disk_data);
-  if (disk_cache.OpenAndRead(m_pipeline_cache_filename, read_callback) != 1)
+  if (disk_cache.Open(m_pipeline_cache_filename) != 1 || !disk_cache.Lookup(1, &disk_data))
     disk_data.clear();
 
   if (!disk_data.empty() && !ValidatePipelineCache(disk_data.data(), disk_data.size()))
@@ -638,8 +616,7 @@ void ObjectCache::SavePipelineCache()
   // Not ideal, but our disk cache class does not support just writing a single blob
   // of data without specifying a key.
   LinearDiskCache<u32, u8> disk_cache;
-  PipelineCacheReadIgnoreCallback callback;
-  disk_cache.OpenAndRead(m_pipeline_cache_filename, callback);
+  disk_cache.Open(m_pipeline_cache_filename);
   disk_cache.Append(1, data.data(), static_cast<u32>(data.size()));
   disk_cache.Close();
 }
@@ -3,6 +3,9 @@
 
 #include "VideoBackends/Vulkan/StateTracker.h"
 
+#include <algorithm>
+#include <functional>
+
 #include "Common/Assert.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
@@ -125,8 +128,10 @@ void StateTracker::SetPipeline(const VKPipeline* pipeline)
 
   m_pipeline = pipeline;
   m_dirty_flags |= DIRTY_FLAG_PIPELINE;
+
+  // Utility pipelines have static depth and cull state, which replaces the dynamic state.
   if (new_usage)
-    m_dirty_flags |= DIRTY_FLAG_DESCRIPTOR_SETS;
+    m_dirty_flags |= DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_DEPTH_AND_CULL_STATE;
 }
 
 void StateTracker::SetComputeShader(const VKShader* shader)
@@ -242,6 +247,13 @@ void StateTracker::UnbindTexture(VkImageView view)
     m_bindings.image_texture.imageView = m_dummy_texture->GetView();
     m_bindings.image_texture.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
   }
+
+  // The handle of the view may be reused by a new texture, which the cached sets must not match.
+  std::erase_if(m_gx_sampler_set_cache, [view](const auto& it) {
+    return std::any_of(it.first.begin(), it.first.end(), [view](const VkDescriptorImageInfo& info) {
+      return info.imageView == view;
+    });
+  });
 }
 
 void StateTracker::InvalidateCachedState()
@@ -251,7 +263,7 @@ void StateTracker::InvalidateCachedState()
   m_compute_descriptor_set = VK_NULL_HANDLE;
   m_dirty_flags |= DIRTY_FLAG_ALL_DESCRIPTORS | DIRTY_FLAG_VIEWPORT | DIRTY_FLAG_SCISSOR |
                    DIRTY_FLAG_PIPELINE | DIRTY_FLAG_COMPUTE_SHADER | DIRTY_FLAG_DESCRIPTOR_SETS |
-                   DIRTY_FLAG_COMPUTE_DESCRIPTOR_SET;
+                   DIRTY_FLAG_COMPUTE_DESCRIPTOR_SET | DIRTY_FLAG_DEPTH_AND_CULL_STATE;
   if (m_vertex_buffer != VK_NULL_HANDLE)
     m_dirty_flags |= DIRTY_FLAG_VERTEX_BUFFER;
   if (m_index_buffer != VK_NULL_HANDLE)
@@ -263,6 +275,7 @@ void StateTracker::BeginRenderPass()
   if (InRenderPass())
     return;
 
+  m_framebuffer->TransitionForRender();
   m_current_render_pass = m_framebuffer->GetLoadRenderPass();
   m_framebuffer_render_area = m_framebuffer->GetRect();
 
@@ -283,6 +296,7 @@ void StateTracker::BeginDiscardRenderPass()
   if (InRenderPass())
     return;
 
+  m_framebuffer->TransitionForRender();
   m_current_render_pass = m_framebuffer->GetDiscardRenderPass();
   m_framebuffer_render_area = m_framebuffer->GetRect();
 
@@ -312,6 +326,7 @@ void StateTracker::BeginClearRenderPass(const VkRect2D& area, const VkClearValue
 {
   ASSERT(!InRenderPass());
 
+  m_framebuffer->TransitionForRender();
   m_current_render_pass = m_framebuffer->GetClearRenderPass();
   m_framebuffer_render_area = area;
 
@@ -345,6 +360,22 @@ void StateTracker::SetScissor(const VkRect2D& scissor)
   m_dirty_flags |= DIRTY_FLAG_SCISSOR;
 }
 
+void StateTracker::SetDepthAndCullState(VkCullModeFlags cull_mode, VkBool32 depth_test_enable,
+                                        VkBool32 depth_write_enable, VkCompareOp depth_compare_op)
+{
+  if (m_cull_mode == cull_mode && m_depth_test_enable == depth_test_enable &&
+      m_depth_write_enable == depth_write_enable && m_depth_compare_op == depth_compare_op)
+  {
+    return;
+  }
+
+  m_cull_mode = cull_mode;
+  m_depth_test_enable = depth_test_enable;
+  m_depth_write_enable = depth_write_enable;
+  m_depth_compare_op = depth_compare_op;
+  m_dirty_flags |= DIRTY_FLAG_DEPTH_AND_CULL_STATE;
+}
+
 bool StateTracker::Bind()
 {
   // Must have a pipeline.
@@ -384,6 +415,17 @@ bool StateTracker::Bind()
   if (m_dirty_flags & DIRTY_FLAG_SCISSOR)
     vkCmdSetScissor(command_buffer, 0, 1, &m_scissor);
 
+  if (g_ActiveConfig.backend_info.bSupportsDynamicDepthAndCullState &&
+      m_pipeline->GetUsage() != AbstractPipelineUsage::Utility &&
+      (m_dirty_flags & DIRTY_FLAG_DEPTH_AND_CULL_STATE))
+  {
+    vkCmdSetCullModeEXT(command_buffer, m_cull_mode);
+    vkCmdSetDepthTestEnableEXT(command_buffer, m_depth_test_enable);
+    vkCmdSetDepthWriteEnableEXT(command_buffer, m_depth_write_enable);
+    vkCmdSetDepthCompareOpEXT(command_buffer, m_depth_compare_op);
+    m_dirty_flags &= ~DIRTY_FLAG_DEPTH_AND_CULL_STATE;
+  }
+
   m_dirty_flags &=
       ~(DIRTY_FLAG_INDEX_BUFFER | DIRTY_FLAG_PIPELINE | DIRTY_FLAG_VIEWPORT | DIRTY_FLAG_SCISSOR);
   return true;
@@ -488,19 +530,22 @@ void StateTracker::UpdateGXDescriptorSet()
 
   if (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS || m_gx_descriptor_sets[1] == VK_NULL_HANDLE)
   {
-    m_gx_descriptor_sets[1] = g_command_buffer_mgr->AllocateDescriptorSet(
-        g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS));
+    bool needs_write;
+    m_gx_descriptor_sets[1] = GetGXSamplerDescriptorSet(&needs_write);
 
-    writes[num_writes++] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                            nullptr,
-                            m_gx_descriptor_sets[1],
-                            0,
-                            0,
-                            static_cast<u32>(NUM_PIXEL_SHADER_SAMPLERS),
-                            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                            m_bindings.samplers.data(),
-                            nullptr,
-                            nullptr};
+    if (needs_write)
+    {
+      writes[num_writes++] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                              nullptr,
+                              m_gx_descriptor_sets[1],
+                              0,
+                              0,
+                              static_cast<u32>(NUM_PIXEL_SHADER_SAMPLERS),
+                              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                              m_bindings.samplers.data(),
+                              nullptr,
+                              nullptr};
+    }
     m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_GX_SAMPLERS) | DIRTY_FLAG_DESCRIPTOR_SETS;
   }
 
@@ -565,6 +610,57 @@ void StateTracker::UpdateGXDescriptorSet()
   }
 }
 
+VkDescriptorSet StateTracker::GetGXSamplerDescriptorSet(bool* needs_write)
+{
+  const u64 generation = g_command_buffer_mgr->GetDescriptorPoolGeneration();
+  if (m_gx_sampler_set_cache_generation != generation)
+  {
+    m_gx_sampler_set_cache.clear();
+    m_gx_sampler_set_cache_generation = generation;
+  }
+
+  auto [it, inserted] = m_gx_sampler_set_cache.try_emplace(m_bindings.samplers, VK_NULL_HANDLE);
+  if (inserted)
+  {
+    it->second = g_command_buffer_mgr->AllocateDescriptorSet(
+        g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS));
+    if (it->second == VK_NULL_HANDLE)
+    {
+      m_gx_sampler_set_cache.erase(it);
+      *needs_write = false;
+      return VK_NULL_HANDLE;
+    }
+  }
+
+  *needs_write = inserted;
+  return it->second;
+}
+
+size_t StateTracker::SamplerBindingsHash::operator()(const SamplerBindings& bindings) const
+{
+  size_t hash = 0;
+  for (const VkDescriptorImageInfo& info : bindings)
+  {
+    for (const size_t value :
+         {std::hash<VkSampler>{}(info.sampler), std::hash<VkImageView>{}(info.imageView),
+          static_cast<size_t>(info.imageLayout)})
+    {
+      hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+  }
+  return hash;
+}
+
+bool StateTracker::SamplerBindingsEqual::operator()(const SamplerBindings& lhs,
+                                                      const SamplerBindings& rhs) const
+{
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(),
+                    [](const VkDescriptorImageInfo& a, const VkDescriptorImageInfo& b) {
+                      return a.sampler == b.sampler && a.imageView == b.imageView &&
+                             a.imageLayout == b.imageLayout;
+                    });
+}
+
 void StateTracker::UpdateUtilityDescriptorSet()
 {
   // Max number of updates - UBO, Samplers, TexelBuffer
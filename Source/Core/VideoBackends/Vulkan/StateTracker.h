@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <unordered_map>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/Constants.h"
@@ -66,6 +67,10 @@ public:
   void SetViewport(const VkViewport& viewport);
   void SetScissor(const VkRect2D& scissor);
 
+  // Depth and cull state of GX pipelines, with VK_EXT_extended_dynamic_state.
+  void SetDepthAndCullState(VkCullModeFlags cull_mode, VkBool32 depth_test_enable,
+                            VkBool32 depth_write_enable, VkCompareOp depth_compare_op);
+
   // Binds all dirty state to the commmand buffer.
   // If this returns false, you should not issue the draw.
   bool Bind();
@@ -104,6 +109,7 @@ private:
     DIRTY_FLAG_COMPUTE_SHADER = (1 << 13),
     DIRTY_FLAG_DESCRIPTOR_SETS = (1 << 14),
     DIRTY_FLAG_COMPUTE_DESCRIPTOR_SET = (1 << 15),
+    DIRTY_FLAG_DEPTH_AND_CULL_STATE = (1 << 16),
 
     DIRTY_FLAG_ALL_DESCRIPTORS = DIRTY_FLAG_GX_UBOS | DIRTY_FLAG_UTILITY_UBO |
                                  DIRTY_FLAG_GX_SAMPLERS | DIRTY_FLAG_GX_SSBO |
@@ -118,6 +124,7 @@ private:
 
   void UpdateDescriptorSet();
   void UpdateGXDescriptorSet();
+  VkDescriptorSet GetGXSamplerDescriptorSet(bool* needs_write);
   void UpdateUtilityDescriptorSet();
   void UpdateComputeDescriptorSet();
 
@@ -149,12 +156,32 @@ private:
     VkDescriptorImageInfo image_texture;
   } m_bindings = {};
   std::array<VkDescriptorSet, NUM_GX_DESCRIPTOR_SETS> m_gx_descriptor_sets = {};
+
+  // Sampler descriptor sets which were written during the current frame, so that going back to a
+  // combination of textures which was already used this frame rebinds its set, instead of
+  // allocating and writing a new one. Cleared when the frame's descriptor pool is reset.
+  using SamplerBindings = std::array<VkDescriptorImageInfo, NUM_PIXEL_SHADER_SAMPLERS>;
+  struct SamplerBindingsHash
+  {
+    size_t operator()(const SamplerBindings& bindings) const;
+  };
+  struct SamplerBindingsEqual
+  {
+    bool operator()(const SamplerBindings& lhs, const SamplerBindings& rhs) const;
+  };
+  std::unordered_map<SamplerBindings, VkDescriptorSet, SamplerBindingsHash, SamplerBindingsEqual>
+      m_gx_sampler_set_cache;
+  u64 m_gx_sampler_set_cache_generation = 0;
   std::array<VkDescriptorSet, NUM_UTILITY_DESCRIPTOR_SETS> m_utility_descriptor_sets = {};
   VkDescriptorSet m_compute_descriptor_set = VK_NULL_HANDLE;
 
   // rasterization
   VkViewport m_viewport = {0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f};
   VkRect2D m_scissor = {{0, 0}, {1, 1}};
+  VkCullModeFlags m_cull_mode = VK_CULL_MODE_NONE;
+  VkBool32 m_depth_test_enable = VK_FALSE;
+  VkBool32 m_depth_write_enable = VK_FALSE;
+  VkCompareOp m_depth_compare_op = VK_COMPARE_OP_ALWAYS;
 
   // uniform buffers
   std::unique_ptr<VKTexture> m_dummy_texture;
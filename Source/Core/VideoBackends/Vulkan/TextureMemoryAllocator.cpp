@@ -0,0 +1,144 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Vulkan/TextureMemoryAllocator.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "Common/Assert.h"
+#include "Common/Logging/Log.h"
+
+#include "VideoBackends/Vulkan/CommandBufferManager.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
+
+namespace Vulkan
+{
+std::unique_ptr<TextureMemoryAllocator> g_texture_memory_allocator;
+
+TextureMemoryAllocator::~TextureMemoryAllocator()
+{
+  for (const Block& block : m_blocks)
+  {
+    if (block.memory == VK_NULL_HANDLE)
+      continue;
+
+    WARN_LOG_FMT(VIDEO, "Freeing texture memory block with {} of {} slots still allocated",
+                 block.num_slots - block.free_slots.size(), block.num_slots);
+    vkFreeMemory(g_vulkan_context->GetDevice(), block.memory, nullptr);
+  }
+}
+
+std::optional<TextureMemoryAllocation>
+TextureMemoryAllocator::Allocate(const VkMemoryRequirements& requirements, u32 memory_type)
+{
+  // Slots are aligned to their size, which has to cover the alignment of the image as well.
+  const VkDeviceSize slot_size =
+      std::max(std::bit_ceil(std::max(requirements.size, requirements.alignment)), MIN_SLOT_SIZE);
+  if (slot_size > MAX_SLOT_SIZE)
+  {
+    const VkMemoryAllocateInfo memory_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr,
+                                              requirements.size, memory_type};
+    VkDeviceMemory memory;
+    const VkResult res =
+        vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_info, nullptr, &memory);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
+      return std::nullopt;
+    }
+
+    return TextureMemoryAllocation{memory, 0, TextureMemoryAllocation::DEDICATED, 0};
+  }
+
+  auto it = std::find_if(m_blocks.begin(), m_blocks.end(), [&](const Block& block) {
+    return block.memory != VK_NULL_HANDLE && block.memory_type == memory_type &&
+           block.slot_size == slot_size && !block.free_slots.empty();
+  });
+
+  u32 block_index;
+  if (it != m_blocks.end())
+  {
+    block_index = static_cast<u32>(it - m_blocks.begin());
+  }
+  else
+  {
+    const std::optional<u32> new_block = CreateBlock(memory_type, slot_size);
+    if (!new_block)
+      return std::nullopt;
+    block_index = *new_block;
+  }
+
+  Block& block = m_blocks[block_index];
+  const u32 slot = block.free_slots.back();
+  block.free_slots.pop_back();
+  return TextureMemoryAllocation{block.memory, slot * slot_size, block_index, slot};
+}
+
+void TextureMemoryAllocator::DeferFree(const TextureMemoryAllocation& allocation)
+{
+  g_command_buffer_mgr->DeferCallback([this, allocation]() { Free(allocation); });
+}
+
+void TextureMemoryAllocator::Free(const TextureMemoryAllocation& allocation)
+{
+  if (allocation.block == TextureMemoryAllocation::DEDICATED)
+  {
+    vkFreeMemory(g_vulkan_context->GetDevice(), allocation.memory, nullptr);
+    return;
+  }
+
+  Block& block = m_blocks[allocation.block];
+  ASSERT(block.memory == allocation.memory);
+  block.free_slots.push_back(allocation.slot);
+  if (block.free_slots.size() < block.num_slots)
+    return;
+
+  // Keep one empty block of each size class around, so that textures which are repeatedly
+  // created and destroyed don't allocate a new block every time.
+  const bool has_other_empty_block =
+      std::any_of(m_blocks.begin(), m_blocks.end(), [&block](const Block& other) {
+        return &other != &block && other.memory != VK_NULL_HANDLE &&
+               other.memory_type == block.memory_type && other.slot_size == block.slot_size &&
+               other.free_slots.size() == other.num_slots;
+      });
+  if (!has_other_empty_block)
+    return;
+
+  vkFreeMemory(g_vulkan_context->GetDevice(), block.memory, nullptr);
+  block = {};
+}
+
+std::optional<u32> TextureMemoryAllocator::CreateBlock(u32 memory_type, VkDeviceSize slot_size)
+{
+  const VkDeviceSize block_size = std::max(MIN_BLOCK_SIZE, slot_size * MIN_SLOTS_PER_BLOCK);
+  const VkMemoryAllocateInfo memory_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr,
+                                            block_size, memory_type};
+  VkDeviceMemory memory;
+  const VkResult res =
+      vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_info, nullptr, &memory);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
+    return std::nullopt;
+  }
+
+  auto it = std::find_if(m_blocks.begin(), m_blocks.end(),
+                         [](const Block& block) { return block.memory == VK_NULL_HANDLE; });
+  if (it == m_blocks.end())
+    it = m_blocks.emplace(m_blocks.end());
+
+  it->memory = memory;
+  it->memory_type = memory_type;
+  it->slot_size = slot_size;
+  it->num_slots = static_cast<u32>(block_size / slot_size);
+  it->free_slots.resize(it->num_slots);
+  // Hand out the slots from the start of the block first.
+  for (u32 i = 0; i < it->num_slots; i++)
+    it->free_slots[i] = it->num_slots - 1 - i;
+
+  DEBUG_LOG_FMT(VIDEO, "Allocated {} KiB texture memory block for {} KiB slots", block_size / 1024,
+                slot_size / 1024);
+  return static_cast<u32>(it - m_blocks.begin());
+}
+}  // namespace Vulkan
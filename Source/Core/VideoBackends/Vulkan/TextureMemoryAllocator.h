@@ -0,0 +1,65 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Vulkan/VulkanLoader.h"
+
+namespace Vulkan
+{
+struct TextureMemoryAllocation
+{
+  static constexpr u32 DEDICATED = ~0u;
+
+  VkDeviceMemory memory = VK_NULL_HANDLE;
+  VkDeviceSize offset = 0;
+  u32 block = DEDICATED;
+  u32 slot = 0;
+};
+
+// Suballocates the memory of small and medium sized textures from larger blocks, so that creating
+// textures, such as the render targets of EFB copies, doesn't call into the driver's allocator
+// every time. Each block is split into equally sized slots of a power of two size class. Textures
+// larger than the largest size class get a dedicated allocation.
+class TextureMemoryAllocator
+{
+public:
+  static constexpr VkDeviceSize MIN_SLOT_SIZE = 64 * 1024;
+  static constexpr VkDeviceSize MAX_SLOT_SIZE = 4 * 1024 * 1024;
+  static constexpr VkDeviceSize MIN_BLOCK_SIZE = 16 * 1024 * 1024;
+  static constexpr u32 MIN_SLOTS_PER_BLOCK = 16;
+
+  TextureMemoryAllocator() = default;
+  ~TextureMemoryAllocator();
+
+  std::optional<TextureMemoryAllocation> Allocate(const VkMemoryRequirements& requirements,
+                                                  u32 memory_type);
+
+  // Frees the allocation once the GPU has finished executing the current command buffer.
+  void DeferFree(const TextureMemoryAllocation& allocation);
+
+private:
+  struct Block
+  {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    u32 memory_type = 0;
+    VkDeviceSize slot_size = 0;
+    u32 num_slots = 0;
+    std::vector<u32> free_slots;
+  };
+
+  void Free(const TextureMemoryAllocation& allocation);
+  std::optional<u32> CreateBlock(u32 memory_type, VkDeviceSize slot_size);
+
+  // Allocations refer to their block by index, so released blocks are left in place without any
+  // memory, and are reused by the next block which is created.
+  std::vector<Block> m_blocks;
+};
+
+extern std::unique_ptr<TextureMemoryAllocator> g_texture_memory_allocator;
+}  // namespace Vulkan
@@ -30,7 +30,7 @@ bool VKBoundingBox::Initialize()
   if (!CreateGPUBuffer())
     return false;
 
-  if (!CreateReadbackBuffer())
+  if (!CreateReadbackBuffers())
     return false;
 
   // Bind bounding box to state tracker
@@ -39,6 +39,43 @@ bool VKBoundingBox::Initialize()
 }
 
 std::vector<BBoxType> VKBoundingBox::Read(u32 index, u32 length)
+{
+  CopyToReadbackBuffer(m_readback_buffer.get());
+
+  // Wait until these commands complete.
+  Renderer::GetInstance()->ExecuteCommandBuffer(false, true);
+
+  // Cache is now valid.
+  m_readback_buffer->InvalidateCPUCache();
+
+  // Read out the values and return
+  std::vector<BBoxType> values(length);
+  m_readback_buffer->Read(index * sizeof(BBoxType), values.data(), length * sizeof(BBoxType),
+                          false);
+  return values;
+}
+
+bool VKBoundingBox::QueueRead(u32 slot)
+{
+  CopyToReadbackBuffer(m_queued_readback_buffers[slot].get());
+  m_queued_readback_fence_counters[slot] = g_command_buffer_mgr->GetCurrentFenceCounter();
+
+  // Submit the copy so that the GPU gets to it, but don't wait for it.
+  Renderer::GetInstance()->ExecuteCommandBuffer(true, false);
+  return true;
+}
+
+bool VKBoundingBox::GetQueuedRead(u32 slot, std::array<BBoxType, NUM_BBOX_VALUES>* values)
+{
+  if (!g_command_buffer_mgr->IsFenceCounterComplete(m_queued_readback_fence_counters[slot]))
+    return false;
+
+  m_queued_readback_buffers[slot]->InvalidateCPUCache();
+  m_queued_readback_buffers[slot]->Read(0, values->data(), BUFFER_SIZE, false);
+  return true;
+}
+
+void VKBoundingBox::CopyToReadbackBuffer(StagingBuffer* buffer)
 {
   // Can't be done within a render pass.
   StateTracker::GetInstance()->EndRenderPass();
@@ -48,34 +85,21 @@ std::vector<BBoxType> VKBoundingBox::Read(u32 index, u32 length)
       g_command_buffer_mgr->GetCurrentCommandBuffer(), m_gpu_buffer,
       VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT, 0,
       BUFFER_SIZE, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
-  m_readback_buffer->PrepareForGPUWrite(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT);
+  buffer->PrepareForGPUWrite(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                             VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 
   // Copy from GPU -> readback buffer.
   VkBufferCopy region = {0, 0, BUFFER_SIZE};
   vkCmdCopyBuffer(g_command_buffer_mgr->GetCurrentCommandBuffer(), m_gpu_buffer,
-                  m_readback_buffer->GetBuffer(), 1, &region);
+                  buffer->GetBuffer(), 1, &region);
 
   // Restore GPU buffer access.
   StagingBuffer::BufferMemoryBarrier(
       g_command_buffer_mgr->GetCurrentCommandBuffer(), m_gpu_buffer, VK_ACCESS_TRANSFER_READ_BIT,
       VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT, 0, BUFFER_SIZE,
       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-  m_readback_buffer->FlushGPUCache(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-                                   VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
-
-  // Wait until these commands complete.
-  Renderer::GetInstance()->ExecuteCommandBuffer(false, true);
-
-  // Cache is now valid.
-  m_readback_buffer->InvalidateCPUCache();
-
-  // Read out the values and return
-  std::vector<BBoxType> values(length);
-  m_readback_buffer->Read(index * sizeof(BBoxType), values.data(), length * sizeof(BBoxType),
-                          false);
-  return values;
+  buffer->FlushGPUCache(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                        VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
 }
 
 void VKBoundingBox::Write(u32 index, const std::vector<BBoxType>& values)
@@ -162,14 +186,23 @@ bool VKBoundingBox::CreateGPUBuffer()
   return true;
 }
 
-bool VKBoundingBox::CreateReadbackBuffer()
+bool VKBoundingBox::CreateReadbackBuffers()
 {
-  m_readback_buffer = StagingBuffer::Create(STAGING_BUFFER_TYPE_READBACK, BUFFER_SIZE,
-                                            VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+  auto create_buffer = [](std::unique_ptr<StagingBuffer>* buffer) {
+    *buffer = StagingBuffer::Create(STAGING_BUFFER_TYPE_READBACK, BUFFER_SIZE,
+                                    VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    return *buffer && (*buffer)->Map();
+  };
 
-  if (!m_readback_buffer || !m_readback_buffer->Map())
+  if (!create_buffer(&m_readback_buffer))
     return false;
 
+  for (std::unique_ptr<StagingBuffer>& buffer : m_queued_readback_buffers)
+  {
+    if (!create_buffer(&buffer))
+      return false;
+  }
+
   return true;
 }
 
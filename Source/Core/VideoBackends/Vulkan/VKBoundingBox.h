@@ -26,10 +26,13 @@ public:
 protected:
   std::vector<BBoxType> Read(u32 index, u32 length) override;
   void Write(u32 index, const std::vector<BBoxType>& values) override;
+  bool QueueRead(u32 slot) override;
+  bool GetQueuedRead(u32 slot, std::array<BBoxType, NUM_BBOX_VALUES>* values) override;
 
 private:
   bool CreateGPUBuffer();
-  bool CreateReadbackBuffer();
+  bool CreateReadbackBuffers();
+  void CopyToReadbackBuffer(StagingBuffer* buffer);
 
   VkBuffer m_gpu_buffer = VK_NULL_HANDLE;
   VkDeviceMemory m_gpu_memory = VK_NULL_HANDLE;
@@ -37,6 +40,8 @@ private:
   static constexpr size_t BUFFER_SIZE = sizeof(BBoxType) * NUM_BBOX_VALUES;
 
   std::unique_ptr<StagingBuffer> m_readback_buffer;
+  std::array<std::unique_ptr<StagingBuffer>, NUM_READBACK_SLOTS> m_queued_readback_buffers;
+  std::array<u64, NUM_READBACK_SLOTS> m_queued_readback_fence_counters = {};
 };
 
 }  // namespace Vulkan
@@ -12,6 +12,7 @@
 #include "VideoBackends/Vulkan/Constants.h"
 #include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/StateTracker.h"
+#include "VideoBackends/Vulkan/TextureMemoryAllocator.h"
 #include "VideoBackends/Vulkan/VKPerfQuery.h"
 #include "VideoBackends/Vulkan/VKRenderer.h"
 #include "VideoBackends/Vulkan/VKSwapChain.h"
@@ -189,6 +190,9 @@ bool VideoBackend::Initialize(const WindowSystemInfo& wsi)
       &g_Config, g_vulkan_context->GetPhysicalDevice(), g_vulkan_context->GetDeviceProperties());
   g_Config.backend_info.bSupportsExclusiveFullscreen =
       enable_surface && g_vulkan_context->SupportsExclusiveFullscreen(wsi, surface);
+  g_Config.backend_info.bSupportsDynamicDepthAndCullState =
+      g_vulkan_context->SupportsExtendedDynamicState() && vkCmdSetCullModeEXT &&
+      vkCmdSetDepthTestEnableEXT && vkCmdSetDepthWriteEnableEXT && vkCmdSetDepthCompareOpEXT;
 
   // With the backend information populated, we can now initialize videocommon.
   InitializeShared();
@@ -202,6 +206,8 @@ bool VideoBackend::Initialize(const WindowSystemInfo& wsi)
     return false;
   }
 
+  g_texture_memory_allocator = std::make_unique<TextureMemoryAllocator>();
+
   // Remaining classes are also dependent on object cache.
   g_object_cache = std::make_unique<ObjectCache>();
   if (!g_object_cache->Initialize())
@@ -275,6 +281,7 @@ void VideoBackend::Shutdown()
   g_object_cache.reset();
   StateTracker::DestroyInstance();
   g_command_buffer_mgr.reset();
+  g_texture_memory_allocator.reset();
   g_vulkan_context.reset();
   ShutdownShared();
   UnloadVulkanLibrary();
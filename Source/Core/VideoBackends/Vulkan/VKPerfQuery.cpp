@@ -205,8 +205,8 @@ void PerfQuery::ReadbackQueries(u32 query_count)
 
     // NOTE: Reported pixel metrics should be referenced to native resolution
     const u64 native_res_result = static_cast<u64>(m_query_result_buffer[i]) * EFB_WIDTH /
-                                  g_renderer->GetTargetWidth() * EFB_HEIGHT /
-                                  g_renderer->GetTargetHeight();
+                                  g_renderer->EFBToScaledX(EFB_WIDTH) * EFB_HEIGHT /
+                                  g_renderer->EFBToScaledY(EFB_HEIGHT);
     m_results[entry.query_type].fetch_add(static_cast<u32>(native_res_result),
                                           std::memory_order_relaxed);
   }
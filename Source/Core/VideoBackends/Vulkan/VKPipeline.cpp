@@ -37,8 +37,8 @@ static bool IsStripPrimitiveTopology(VkPrimitiveTopology topology)
          topology == VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY;
 }
 
-static VkPipelineRasterizationStateCreateInfo
-GetVulkanRasterizationState(const RasterizationState& state)
+VkPipelineRasterizationStateCreateInfo
+VKPipeline::GetVulkanRasterizationState(const RasterizationState& state)
 {
   static constexpr std::array<VkCullModeFlags, 4> cull_modes = {
       {VK_CULL_MODE_NONE, VK_CULL_MODE_BACK_BIT, VK_CULL_MODE_FRONT_BIT,
@@ -79,7 +79,8 @@ static VkPipelineMultisampleStateCreateInfo GetVulkanMultisampleState(const Fram
   };
 }
 
-static VkPipelineDepthStencilStateCreateInfo GetVulkanDepthStencilState(const DepthState& state)
+VkPipelineDepthStencilStateCreateInfo
+VKPipeline::GetVulkanDepthStencilState(const DepthState& state)
 {
   // Less/greater are swapped due to inverted depth.
   VkCompareOp compare_op;
@@ -359,14 +360,22 @@ std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& con
   };
 
   // Set viewport and scissor dynamic state so we can change it elsewhere.
-  static const std::array<VkDynamicState, 2> dynamic_states{
+  // GX pipelines also leave the depth and cull state to StateTracker when it's supported.
+  static const std::array<VkDynamicState, 6> dynamic_states{
       VK_DYNAMIC_STATE_VIEWPORT,
       VK_DYNAMIC_STATE_SCISSOR,
+      VK_DYNAMIC_STATE_CULL_MODE_EXT,
+      VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT,
+      VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT,
+      VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT,
   };
-  static const VkPipelineDynamicStateCreateInfo dynamic_state = {
+  const bool dynamic_depth_and_cull_state =
+      g_ActiveConfig.backend_info.bSupportsDynamicDepthAndCullState &&
+      config.usage != AbstractPipelineUsage::Utility;
+  const VkPipelineDynamicStateCreateInfo dynamic_state = {
       VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO, nullptr,
-      0,                                        // VkPipelineDynamicStateCreateFlags    flags
-      static_cast<u32>(dynamic_states.size()),  // uint32_t dynamicStateCount
+      0,                                       // VkPipelineDynamicStateCreateFlags    flags
+      dynamic_depth_and_cull_state ? 6u : 2u,  // uint32_t dynamicStateCount
       dynamic_states.data()  // const VkDynamicState*                pDynamicStates
   };
 
@@ -22,6 +22,11 @@ public:
   AbstractPipelineUsage GetUsage() const { return m_usage; }
   static std::unique_ptr<VKPipeline> Create(const AbstractPipelineConfig& config);
 
+  // Also used for the dynamic depth and cull state of GX pipelines.
+  static VkPipelineRasterizationStateCreateInfo
+  GetVulkanRasterizationState(const RasterizationState& state);
+  static VkPipelineDepthStencilStateCreateInfo GetVulkanDepthStencilState(const DepthState& state);
+
 private:
   VkPipeline m_pipeline;
   VkPipelineLayout m_pipeline_layout;
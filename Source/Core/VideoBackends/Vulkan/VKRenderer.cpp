@@ -14,6 +14,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/PerformanceTrace.h"
 
 #include "Core/Core.h"
 
@@ -42,6 +43,9 @@
 
 namespace Vulkan
 {
+// Bounds the wait for a present, in case the window is hidden and the frame is never shown.
+constexpr u64 PRESENT_WAIT_TIMEOUT_NS = 100000000;
+
 Renderer::Renderer(std::unique_ptr<SwapChain> swap_chain, float backbuffer_scale)
     : ::Renderer(swap_chain ? static_cast<int>(swap_chain->GetWidth()) : 1,
                  swap_chain ? static_cast<int>(swap_chain->GetHeight()) : 0, backbuffer_scale,
@@ -127,6 +131,18 @@ void Renderer::SetPipeline(const AbstractPipeline* pipeline)
   StateTracker::GetInstance()->SetPipeline(static_cast<const VKPipeline*>(pipeline));
 }
 
+void Renderer::SetDynamicDepthAndCullState(const RasterizationState& rasterization_state,
+                                           const DepthState& depth_state)
+{
+  const VkPipelineRasterizationStateCreateInfo rs_info =
+      VKPipeline::GetVulkanRasterizationState(rasterization_state);
+  const VkPipelineDepthStencilStateCreateInfo ds_info =
+      VKPipeline::GetVulkanDepthStencilState(depth_state);
+  StateTracker::GetInstance()->SetDepthAndCullState(rs_info.cullMode, ds_info.depthTestEnable,
+                                                    ds_info.depthWriteEnable,
+                                                    ds_info.depthCompareOp);
+}
+
 std::unique_ptr<BoundingBox> Renderer::CreateBoundingBox() const
 {
   return std::make_unique<VKBoundingBox>();
@@ -257,6 +273,36 @@ void Renderer::WaitForGPUIdle()
   ExecuteCommandBuffer(false, true);
 }
 
+std::optional<Renderer::VideoMemoryInfo> Renderer::GetVideoMemoryInfo() const
+{
+  if (!g_vulkan_context->SupportsMemoryBudget())
+    return std::nullopt;
+
+  VkPhysicalDeviceMemoryBudgetPropertiesEXT budget_properties = {};
+  budget_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+  VkPhysicalDeviceMemoryProperties2 memory_properties = {};
+  memory_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+  memory_properties.pNext = &budget_properties;
+  vkGetPhysicalDeviceMemoryProperties2(g_vulkan_context->GetPhysicalDevice(), &memory_properties);
+
+  // Textures are placed in device local memory, so only count its heaps.
+  VideoMemoryInfo info = {};
+  const VkPhysicalDeviceMemoryProperties& properties = memory_properties.memoryProperties;
+  for (u32 i = 0; i < properties.memoryHeapCount; i++)
+  {
+    if (!(properties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+      continue;
+
+    info.usage += budget_properties.heapUsage[i];
+    info.budget += budget_properties.heapBudget[i];
+  }
+
+  if (info.budget == 0)
+    return std::nullopt;
+
+  return info;
+}
+
 void Renderer::BindBackbuffer(const ClearColor& clear_color)
 {
   StateTracker::GetInstance()->EndRenderPass();
@@ -346,6 +392,24 @@ void Renderer::PresentBackbuffer()
   g_command_buffer_mgr->SubmitCommandBuffer(true, false, m_swap_chain->GetSwapChain(),
                                             m_swap_chain->GetCurrentImageIndex());
 
+  // In low latency mode, wait until the previous frame is on screen before starting the next one,
+  // so that at most one frame is queued in the swap chain rather than rendering ahead of it.
+  if (g_ActiveConfig.bLowLatencyMode && g_vulkan_context->SupportsPresentWait())
+  {
+    // The swap chain must be externally synchronized with the present on the worker thread.
+    g_command_buffer_mgr->WaitForWorkerThreadIdle();
+    const u64 present_id = g_command_buffer_mgr->GetLastPresentId();
+    if (present_id > 1)
+    {
+      Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::PresentWait);
+      const VkResult res = vkWaitForPresentKHR(g_vulkan_context->GetDevice(),
+                                               m_swap_chain->GetSwapChain(), present_id - 1,
+                                               PRESENT_WAIT_TIMEOUT_NS);
+      if (res != VK_SUCCESS && res != VK_TIMEOUT && res != VK_ERROR_OUT_OF_DATE_KHR)
+        LOG_VULKAN_ERROR(res, "vkWaitForPresentKHR failed: ");
+    }
+  }
+
   // New cmdbuffer, so invalidate state.
   StateTracker::GetInstance()->InvalidateCachedState();
 }
@@ -465,7 +529,8 @@ void Renderer::BindFramebuffer(VKFramebuffer* fb)
         static_cast<VKTexture*>(fb->GetDepthAttachment())->GetView());
   }
 
-  fb->TransitionForRender();
+  // The attachments are transitioned when a render pass begins. Until then they can still be
+  // sampled, e.g. by several EFB copies in a row, without going back and forth between layouts.
   StateTracker::GetInstance()->SetFramebuffer(fb);
   m_current_framebuffer = fb;
 }
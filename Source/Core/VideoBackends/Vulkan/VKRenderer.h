@@ -58,12 +58,15 @@ public:
 
   void Flush() override;
   void WaitForGPUIdle() override;
+  std::optional<VideoMemoryInfo> GetVideoMemoryInfo() const override;
   void OnConfigChanged(u32 bits) override;
 
   void ClearScreen(const MathUtil::Rectangle<int>& rc, bool color_enable, bool alpha_enable,
                    bool z_enable, u32 color, u32 z) override;
 
   void SetPipeline(const AbstractPipeline* pipeline) override;
+  void SetDynamicDepthAndCullState(const RasterizationState& rasterization_state,
+                                   const DepthState& depth_state) override;
   void SetFramebuffer(AbstractFramebuffer* framebuffer) override;
   void SetAndDiscardFramebuffer(AbstractFramebuffer* framebuffer) override;
   void SetAndClearFramebuffer(AbstractFramebuffer* framebuffer, const ClearColor& color_value = {},
@@ -10,9 +10,11 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
+#include "VideoCommon/Statistics.h"
 
 namespace Vulkan
 {
@@ -316,7 +318,10 @@ bool StreamBuffer::WaitForClearSpace(u32 num_bytes)
   }
 
   // Wait until this fence is signaled. This will fire the callback, updating the GPU position.
+  const u64 wait_start_us = Common::Timer::NowUs();
   g_command_buffer_mgr->WaitForFenceCounter(iter->first);
+  INCSTAT(g_stats.this_frame.num_stream_buffer_waits);
+  ADDSTAT(g_stats.this_frame.stream_buffer_wait_us, Common::Timer::NowUs() - wait_start_us);
   m_tracked_fences.erase(m_tracked_fences.begin(),
                          m_current_offset == iter->second ? m_tracked_fences.end() : ++iter);
   m_current_offset = new_offset;
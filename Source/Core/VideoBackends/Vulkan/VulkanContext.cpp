@@ -299,6 +299,7 @@ void VulkanContext::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsSettingObjectNames = false;        // Dependent on features.
   config->backend_info.bSupportsPartialMultisampleResolve = true;  // Assumed support.
   config->backend_info.bSupportsDynamicVertexLoader = true;        // Assumed support.
+  config->backend_info.bSupportsDynamicDepthAndCullState = false;  // Dependent on features.
 }
 
 void VulkanContext::PopulateBackendInfoAdapters(VideoConfig* config, const GPUList& gpu_list)
@@ -502,6 +503,21 @@ bool VulkanContext::SelectDeviceExtensions(bool enable_surface)
   if (enable_surface && !AddExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME, true))
     return false;
 
+  // VK_KHR_present_wait, for waiting until a frame is on screen in low latency mode.
+  m_supports_present_wait = enable_surface &&
+                            AddExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME, false) &&
+                            AddExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME, false);
+
+  // VK_EXT_memory_budget, for keeping the texture cache within the budget of the driver.
+  m_supports_memory_budget = vkGetPhysicalDeviceMemoryProperties2 &&
+                             AddExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, false);
+
+  // VK_EXT_extended_dynamic_state, for setting the depth and cull state of GX pipelines when
+  // drawing, so that pipelines which only differ in them can be shared.
+  m_supports_extended_dynamic_state =
+      vkGetPhysicalDeviceFeatures2 &&
+      AddExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME, false);
+
 #ifdef SUPPORTS_VULKAN_EXCLUSIVE_FULLSCREEN
   // VK_EXT_full_screen_exclusive
   if (AddExtension(VK_EXT_FULL_SCREEN_EXCLUSIVE_EXTENSION_NAME, true))
@@ -667,6 +683,48 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
 
   device_info.pEnabledFeatures = &m_device_features;
 
+  // The present wait extensions are only usable if the device also supports their features.
+  VkPhysicalDevicePresentIdFeaturesKHR present_id_features = {};
+  present_id_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+  VkPhysicalDevicePresentWaitFeaturesKHR present_wait_features = {};
+  present_wait_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+  present_wait_features.pNext = &present_id_features;
+  if (m_supports_present_wait && vkGetPhysicalDeviceFeatures2)
+  {
+    VkPhysicalDeviceFeatures2 features_2 = {};
+    features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features_2.pNext = &present_wait_features;
+    vkGetPhysicalDeviceFeatures2(m_physical_device, &features_2);
+    m_supports_present_wait = present_id_features.presentId && present_wait_features.presentWait;
+  }
+  else
+  {
+    m_supports_present_wait = false;
+  }
+  if (m_supports_present_wait)
+  {
+    INFO_LOG_FMT(VIDEO, "Using VK_KHR_present_wait for low latency presentation.");
+    device_info.pNext = &present_wait_features;
+  }
+
+  VkPhysicalDeviceExtendedDynamicStateFeaturesEXT extended_dynamic_state_features = {};
+  extended_dynamic_state_features.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+  if (m_supports_extended_dynamic_state)
+  {
+    VkPhysicalDeviceFeatures2 features_2 = {};
+    features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features_2.pNext = &extended_dynamic_state_features;
+    vkGetPhysicalDeviceFeatures2(m_physical_device, &features_2);
+    m_supports_extended_dynamic_state = extended_dynamic_state_features.extendedDynamicState;
+  }
+  if (m_supports_extended_dynamic_state)
+  {
+    INFO_LOG_FMT(VIDEO, "Using VK_EXT_extended_dynamic_state for depth and cull state.");
+    extended_dynamic_state_features.pNext = const_cast<void*>(device_info.pNext);
+    device_info.pNext = &extended_dynamic_state_features;
+  }
+
   // Enable debug layer on debug builds
   if (enable_validation_layer)
   {
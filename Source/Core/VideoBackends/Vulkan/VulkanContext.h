@@ -83,6 +83,9 @@ public:
   }
   u32 GetShaderSubgroupSize() const { return m_shader_subgroup_size; }
   bool SupportsShaderSubgroupOperations() const { return m_supports_shader_subgroup_operations; }
+  bool SupportsPresentWait() const { return m_supports_present_wait; }
+  bool SupportsMemoryBudget() const { return m_supports_memory_budget; }
+  bool SupportsExtendedDynamicState() const { return m_supports_extended_dynamic_state; }
 
   // Helpers for getting constants
   VkDeviceSize GetUniformBufferAlignment() const
@@ -146,6 +149,9 @@ private:
 
   u32 m_shader_subgroup_size = 1;
   bool m_supports_shader_subgroup_operations = false;
+  bool m_supports_present_wait = false;
+  bool m_supports_memory_budget = false;
+  bool m_supports_extended_dynamic_state = false;
 
   std::vector<std::string> m_device_extensions;
 };
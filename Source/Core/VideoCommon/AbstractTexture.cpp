@@ -4,6 +4,7 @@
 #include "VideoCommon/AbstractTexture.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "Common/Assert.h"
 #include "Common/Image.h"
@@ -20,6 +21,18 @@ void AbstractTexture::FinishedRendering()
 }
 
 bool AbstractTexture::Save(const std::string& filename, unsigned int level)
+{
+  std::vector<u8> data;
+  u32 width;
+  u32 height;
+  if (!Download(level, &data, &width, &height))
+    return false;
+
+  return Common::SavePNG(filename, data.data(), Common::ImageByteFormat::RGBA, width, height,
+                         width * 4);
+}
+
+bool AbstractTexture::Download(unsigned int level, std::vector<u8>* data, u32* width, u32* height)
 {
   // We can't dump compressed textures currently (it would mean drawing them to a RGBA8
   // framebuffer, and saving that). TextureCache does not call Save for custom textures
@@ -44,14 +57,20 @@ bool AbstractTexture::Save(const std::string& filename, unsigned int level)
   readback_texture->CopyFromTexture(this, 0, level);
   readback_texture->Flush();
 
-  // Map it so we can encode it to the file.
+  // Map it so we can copy the rows out.
   if (!readback_texture->Map())
     return false;
 
-  return Common::SavePNG(filename,
-                         reinterpret_cast<const u8*>(readback_texture->GetMappedPointer()),
-                         Common::ImageByteFormat::RGBA, level_width, level_height,
-                         static_cast<int>(readback_texture->GetMappedStride()));
+  const u32 row_size = level_width * 4;
+  const u8* src = reinterpret_cast<const u8*>(readback_texture->GetMappedPointer());
+  const size_t src_stride = readback_texture->GetMappedStride();
+  data->resize(static_cast<size_t>(row_size) * level_height);
+  for (u32 y = 0; y < level_height; ++y)
+    std::memcpy(data->data() + static_cast<size_t>(y) * row_size, src + y * src_stride, row_size);
+
+  *width = level_width;
+  *height = level_height;
+  return true;
 }
 
 bool AbstractTexture::IsCompressedFormat(AbstractTextureFormat format)
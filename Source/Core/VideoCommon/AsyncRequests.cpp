@@ -8,6 +8,7 @@
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/Statistics.h"
+#include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
@@ -164,11 +165,17 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
 
   case Event::PERF_QUERY:
     g_perf_query->FlushResults();
+    g_perf_query->SaveCompletedResults();
     break;
 
   case Event::DO_SAVE_STATE:
     VideoCommon_DoState(*e.do_save_state.p);
     break;
+
+  case Event::FLUSH_LAZY_EFB_COPIES:
+    g_texture_cache->FlushLazyEFBCopies(e.flush_lazy_efb_copies.address,
+                                        e.flush_lazy_efb_copies.size);
+    break;
   }
 }
 
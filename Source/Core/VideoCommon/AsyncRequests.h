@@ -30,6 +30,7 @@ public:
       FIFO_RESET,
       PERF_QUERY,
       DO_SAVE_STATE,
+      FLUSH_LAZY_EFB_COPIES,
     } type;
     u64 time;
 
@@ -75,6 +76,12 @@ public:
       {
         PointerWrap* p;
       } do_save_state;
+
+      struct
+      {
+        u32 address;
+        u32 size;
+      } flush_lazy_efb_copies;
     };
   };
 
@@ -37,6 +37,7 @@
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
@@ -92,6 +93,8 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
   FlushPipeline();
 
   ((u32*)&bpmem)[bp.address] = bp.newvalue;
+  g_vertex_manager->SetVertexShaderUidChanged();
+  g_vertex_manager->SetPixelShaderUidChanged();
 
   switch (bp.address)
   {
@@ -360,7 +363,7 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
     if (OpcodeDecoder::g_record_fifo_data)
       FifoRecorder::GetInstance().UseMemory(addr, tlutXferCount, MemoryUpdate::TMEM);
 
-    TMEM::InvalidateAll();
+    TMEM::Write(tlutTMemAddr, tlutXferCount);
 
     return;
   }
@@ -548,6 +551,7 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
           bytes_read = TMEM_SIZE - tmem_addr_even;
 
         Memory::CopyFromEmu(texMem + tmem_addr_even, src_addr, bytes_read);
+        TMEM::Write(tmem_addr_even, bytes_read);
       }
       else  // RGBA8 tiles (and CI14, but that might just be stupid libogc!)
       {
@@ -556,6 +560,8 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
         // AR and GB tiles are stored in separate TMEM banks => can't use a single memcpy for
         // everything
         u32 tmem_addr_odd = tmem_cfg.preload_tmem_odd * TMEM_LINE_SIZE;
+        const u32 tmem_start_even = tmem_addr_even;
+        const u32 tmem_start_odd = tmem_addr_odd;
 
         for (u32 i = 0; i < tmem_cfg.preload_tile_info.count; ++i)
         {
@@ -569,12 +575,13 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
           tmem_addr_odd += TMEM_LINE_SIZE;
           bytes_read += TMEM_LINE_SIZE * 2;
         }
+
+        TMEM::Write(tmem_start_even, tmem_addr_even - tmem_start_even);
+        TMEM::Write(tmem_start_odd, tmem_addr_odd - tmem_start_odd);
       }
 
       if (OpcodeDecoder::g_record_fifo_data)
         FifoRecorder::GetInstance().UseMemory(src_addr, bytes_read, MemoryUpdate::TMEM);
-
-      TMEM::InvalidateAll();
     }
     return;
 
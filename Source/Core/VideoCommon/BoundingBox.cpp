@@ -4,11 +4,13 @@
 #include "VideoCommon/BoundingBox.h"
 
 #include <algorithm>
+#include <tuple>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
 #include <algorithm>
@@ -31,10 +33,14 @@ void BoundingBox::Flush()
     return;
 
   m_is_valid = false;
+  m_generation++;
 
   if (std::none_of(m_dirty.begin(), m_dirty.end(), [](bool dirty) { return dirty; }))
     return;
 
+  // Reads queued before these writes would overwrite the new values once they complete.
+  m_queued_reads = {};
+
   // TODO: Does this make any difference over just writing all the values?
   // Games only ever seem to write all 4 values at once anyways.
   for (u32 start = 0; start < NUM_BBOX_VALUES; ++start)
@@ -70,12 +76,95 @@ void BoundingBox::Readback()
   m_is_valid = true;
 }
 
+void BoundingBox::AsyncReadback()
+{
+  if (!g_ActiveConfig.backend_info.bSupportsBBox)
+    return;
+
+  // Take the values of the most recently queued read which has completed.
+  std::array<BBoxType, NUM_BBOX_VALUES> read_values;
+  std::optional<u64> read_generation;
+  for (u32 slot = 0; slot < NUM_READBACK_SLOTS; slot++)
+  {
+    QueuedRead& read = m_queued_reads[slot];
+    std::array<BBoxType, NUM_BBOX_VALUES> values;
+    if (!read.pending || !GetQueuedRead(slot, &values))
+      continue;
+
+    read.pending = false;
+    if (!read_generation || read.generation > *read_generation)
+    {
+      read_values = values;
+      read_generation = read.generation;
+    }
+  }
+
+  if (read_generation)
+  {
+    const bool compare_stale_values = *read_generation == m_stale_generation;
+    for (u32 i = 0; i < NUM_BBOX_VALUES; i++)
+    {
+      if (m_dirty[i])
+        continue;
+
+      if (compare_stale_values && m_stale_values[i] && *m_stale_values[i] != read_values[i])
+        INCSTAT(g_stats.this_frame.num_bbox_stale_mismatches);
+      m_values[i] = read_values[i];
+    }
+
+    if (*read_generation == m_generation)
+    {
+      m_is_valid = true;
+      return;
+    }
+  }
+
+  // Queue a read of the current values unless one is already in flight, overwriting the oldest
+  // pending read if every slot is in use.
+  if (std::any_of(m_queued_reads.begin(), m_queued_reads.end(), [this](const QueuedRead& read) {
+        return read.pending && read.generation == m_generation;
+      }))
+  {
+    return;
+  }
+
+  const auto slot = std::min_element(m_queued_reads.begin(), m_queued_reads.end(),
+                                     [](const QueuedRead& a, const QueuedRead& b) {
+                                       return std::tie(a.pending, a.generation) <
+                                              std::tie(b.pending, b.generation);
+                                     });
+  if (!QueueRead(static_cast<u32>(slot - m_queued_reads.begin())))
+  {
+    Readback();
+    return;
+  }
+  *slot = {true, m_generation};
+}
+
 u16 BoundingBox::Get(u32 index)
 {
   ASSERT(index < NUM_BBOX_VALUES);
 
   if (!m_is_valid)
-    Readback();
+  {
+    if (g_ActiveConfig.bBBoxAsyncReadback)
+      AsyncReadback();
+    else
+      Readback();
+  }
+
+  INCSTAT(g_stats.this_frame.num_bbox_reads);
+  if (!m_is_valid)
+  {
+    // Return the last known value while the current one is being read back.
+    INCSTAT(g_stats.this_frame.num_bbox_stale_reads);
+    if (m_stale_generation != m_generation)
+    {
+      m_stale_values = {};
+      m_stale_generation = m_generation;
+    }
+    m_stale_values[index] = m_values[index];
+  }
 
   return static_cast<u16>(m_values[index]);
 }
@@ -100,6 +189,8 @@ void BoundingBox::DoState(PointerWrap& p)
   p.DoArray(m_values);
   p.DoArray(m_dirty);
   p.Do(m_is_valid);
+  if (p.IsReadMode())
+    m_queued_reads = {};
 
   // We handle saving the backend values specially rather than using Readback() and Flush() so that
   // we don't mess up the current cache state
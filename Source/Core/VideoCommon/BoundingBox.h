@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <optional>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -35,16 +36,44 @@ public:
   virtual bool Initialize() = 0;
 
 protected:
+  static constexpr u32 NUM_READBACK_SLOTS = 2;
+
   virtual std::vector<BBoxType> Read(u32 index, u32 length) = 0;
   // TODO: This can likely use std::span once we're on C++20
   virtual void Write(u32 index, const std::vector<BBoxType>& values) = 0;
 
+  // Asynchronous readback, used when bBBoxAsyncReadback is enabled. QueueRead copies the current
+  // values to the readback slot without waiting for the GPU, and GetQueuedRead returns the values
+  // of the last copy to the slot once it has completed. Backends which return false from QueueRead
+  // are always read back synchronously.
+  virtual bool QueueRead(u32 slot) { return false; }
+  virtual bool GetQueuedRead(u32 slot, std::array<BBoxType, NUM_BBOX_VALUES>* values)
+  {
+    return false;
+  }
+
 private:
+  struct QueuedRead
+  {
+    bool pending;
+    // Value of m_generation when the read was queued.
+    u64 generation;
+  };
+
   void Readback();
+  void AsyncReadback();
 
   bool m_is_active = false;
 
   std::array<BBoxType, NUM_BBOX_VALUES> m_values = {};
   std::array<bool, NUM_BBOX_VALUES> m_dirty = {};
   bool m_is_valid = true;
+
+  // Incremented by every draw which may change the values on the GPU.
+  u64 m_generation = 0;
+  std::array<QueuedRead, NUM_READBACK_SLOTS> m_queued_reads = {};
+  // Values returned to the CPU while out of date, and the generation they were returned in, so
+  // that they can be compared against the up-to-date values once those have been read back.
+  std::array<std::optional<BBoxType>, NUM_BBOX_VALUES> m_stale_values = {};
+  u64 m_stale_generation = 0;
 };
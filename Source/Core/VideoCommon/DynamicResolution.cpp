@@ -0,0 +1,60 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/DynamicResolution.h"
+
+#include <algorithm>
+
+namespace VideoCommon
+{
+void DynamicResolution::Reset(u32 min_scale, u32 max_scale)
+{
+  m_max_scale = std::max(max_scale, 1u);
+  m_min_scale = std::clamp(min_scale, 1u, m_max_scale);
+  m_scale = m_max_scale;
+  m_slow_frames = 0;
+  m_fast_frames = 0;
+  m_fast_frames_to_raise = MIN_FAST_FRAMES_TO_RAISE;
+  m_probing = false;
+}
+
+u32 DynamicResolution::Update(u64 frame_time_us, u64 target_time_us)
+{
+  // Allow 5% of jitter, so that frames which are only delivered slightly late don't count.
+  if (frame_time_us * 20 > target_time_us * 21)
+  {
+    m_fast_frames = 0;
+    if (++m_slow_frames < SLOW_FRAMES_TO_LOWER)
+      return m_scale;
+
+    m_slow_frames = 0;
+    if (m_scale > m_min_scale)
+      m_scale--;
+
+    // Back off further when the last raise is what made frames slow.
+    if (m_probing)
+      m_fast_frames_to_raise = std::min(m_fast_frames_to_raise * 2, MAX_FAST_FRAMES_TO_RAISE);
+    m_probing = false;
+    return m_scale;
+  }
+
+  m_slow_frames = 0;
+  if (++m_fast_frames < m_fast_frames_to_raise)
+    return m_scale;
+
+  m_fast_frames = 0;
+  if (m_probing)
+  {
+    // The raised scale has held up, so it's likely that there's headroom again.
+    m_fast_frames_to_raise = MIN_FAST_FRAMES_TO_RAISE;
+    m_probing = false;
+  }
+
+  if (m_scale < m_max_scale)
+  {
+    m_scale++;
+    m_probing = true;
+  }
+  return m_scale;
+}
+}  // namespace VideoCommon
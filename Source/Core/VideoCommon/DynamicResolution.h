@@ -0,0 +1,45 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace VideoCommon
+{
+// Picks the internal resolution scale to render at, based on how long frames take compared to the
+// time which is available for them. The scale is lowered when frames keep taking too long, and
+// raised again after a run of frames on time. As frames can't finish early when the frame rate is
+// limited, raising the scale is a probe: if it makes frames slow, the next probe waits longer.
+class DynamicResolution
+{
+public:
+  // Number of consecutive slow frames before the scale is lowered.
+  static constexpr u32 SLOW_FRAMES_TO_LOWER = 3;
+  // Number of consecutive frames on time before the scale is first raised.
+  static constexpr u32 MIN_FAST_FRAMES_TO_RAISE = 120;
+  static constexpr u32 MAX_FAST_FRAMES_TO_RAISE = 120 * 32;
+
+  void Reset(u32 min_scale, u32 max_scale);
+
+  // Updates the scale with the time a frame took and the time which was available for it, in
+  // microseconds, and returns the scale for the next frame.
+  u32 Update(u64 frame_time_us, u64 target_time_us);
+
+  u32 GetScale() const { return m_scale; }
+  u32 GetMinScale() const { return m_min_scale; }
+  u32 GetMaxScale() const { return m_max_scale; }
+
+private:
+  u32 m_min_scale = 1;
+  u32 m_max_scale = 1;
+  u32 m_scale = 1;
+
+  u32 m_slow_frames = 0;
+  u32 m_fast_frames = 0;
+  u32 m_fast_frames_to_raise = MIN_FAST_FRAMES_TO_RAISE;
+
+  // Whether the scale was raised and hasn't been on time for the same number of frames since.
+  bool m_probing = false;
+};
+}  // namespace VideoCommon
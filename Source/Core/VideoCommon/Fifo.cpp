@@ -3,14 +3,18 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstring>
+#include <memory>
 
 #include "Common/Assert.h"
 #include "Common/BlockingLoop.h"
 #include "Common/ChunkFile.h"
 #include "Common/Event.h"
 #include "Common/FPURoundMode.h"
+#include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 
@@ -37,6 +41,13 @@ namespace Fifo
 static constexpr u32 FIFO_SIZE = 2 * 1024 * 1024;
 static constexpr int GPU_TIME_SLOT_SIZE = 1000;
 
+// The adaptive sync distance is reevaluated after this many emulated CPU ticks.
+static constexpr int ADAPTIVE_SYNC_WINDOW = 1000 * GPU_TIME_SLOT_SIZE;
+// Games which read the CP or PE registers this often within a window depend on the GPU thread
+// being close behind, so the distance is reduced for them.
+static constexpr u32 ADAPTIVE_SYNC_SENSITIVE_ACCESSES = 4;
+static constexpr int MIN_ADAPTIVE_SYNC_DISTANCE = 10 * GPU_TIME_SLOT_SIZE;
+
 static Common::BlockingLoop s_gpu_mainloop;
 
 static Common::Flag s_emu_running_state;
@@ -52,6 +63,9 @@ static bool s_use_deterministic_gpu_thread;
 
 static CoreTiming::EventType* s_event_sync_gpu;
 
+// Only touched by the CPU thread.
+static std::array<u64, static_cast<size_t>(SyncGPUReason::Count)> s_sync_gpu_counts;
+
 // STATE_TO_SAVE
 static u8* s_video_buffer;
 static u8* s_video_buffer_read_ptr;
@@ -70,6 +84,26 @@ static u8* s_video_buffer_pp_read_ptr;
 // polls, it's just atomic.
 // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
 
+// In dual core mode without the deterministic GPU thread, the CPU thread can also hand the gather
+// pipe bursts it writes to RAM to the GPU thread through this ring. A burst is only used if its
+// address is the one the GPU thread is about to read; anything else, such as the FIFO being moved
+// or the gather pipe not being linked to it, discards the ring and the GPU thread reads from RAM.
+// When the ring is full, the CPU thread skips pushing, which ends up with the same result.
+struct GatherPipeBurst
+{
+  u32 address;
+  std::array<u8, GPFifo::GATHER_PIPE_SIZE> data;
+};
+static constexpr u32 BURST_RING_SIZE = 32768;
+static std::unique_ptr<GatherPipeBurst[]> s_burst_ring;
+static std::atomic<u32> s_burst_ring_write_index;
+static std::atomic<u32> s_burst_ring_read_index;
+// Only touched by the CPU thread.
+static bool s_stream_gather_pipe;
+// Only touched by the GPU thread.
+static u64 s_streamed_bursts;
+static u64 s_read_bursts;
+
 static std::atomic<int> s_sync_ticks;
 static bool s_syncing_suspended;
 static Common::Event s_sync_wakeup_event;
@@ -79,6 +113,37 @@ static bool s_config_sync_gpu = false;
 static int s_config_sync_gpu_max_distance = 0;
 static int s_config_sync_gpu_min_distance = 0;
 static float s_config_sync_gpu_overclock = 0.0f;
+static bool s_config_sync_gpu_adaptive = false;
+
+// How far the CPU thread may run ahead of the GPU thread. This is the configured maximum distance,
+// unless the adaptive sync distance is enabled. Only written by the CPU thread and RefreshConfig.
+static std::atomic<int> s_sync_max_distance;
+// Only touched by the CPU thread.
+static int s_adaptive_window_ticks;
+static u32 s_adaptive_window_waits;
+static u32 s_adaptive_window_register_syncs;
+static std::atomic<u64> s_sync_waits;
+static std::atomic<u64> s_sync_register_syncs;
+
+static void UpdateStreamGatherPipe()
+{
+  s_stream_gather_pipe = s_burst_ring && Core::System::GetInstance().IsDualCoreMode() &&
+                         !s_use_deterministic_gpu_thread;
+}
+
+static void DiscardGatherPipeBursts()
+{
+  s_burst_ring_read_index.store(s_burst_ring_write_index.load(std::memory_order_acquire),
+                                std::memory_order_release);
+}
+
+static int GetMinAdaptiveSyncDistance()
+{
+  // The GPU thread must still be woken up before the CPU thread waits for it.
+  const int min_distance = std::max(MIN_ADAPTIVE_SYNC_DISTANCE,
+                                    s_config_sync_gpu_min_distance + GPU_TIME_SLOT_SIZE);
+  return std::min(min_distance, s_config_sync_gpu_max_distance);
+}
 
 static void RefreshConfig()
 {
@@ -86,6 +151,15 @@ static void RefreshConfig()
   s_config_sync_gpu_max_distance = Config::Get(Config::MAIN_SYNC_GPU_MAX_DISTANCE);
   s_config_sync_gpu_min_distance = Config::Get(Config::MAIN_SYNC_GPU_MIN_DISTANCE);
   s_config_sync_gpu_overclock = Config::Get(Config::MAIN_SYNC_GPU_OVERCLOCK);
+  s_config_sync_gpu_adaptive = Config::Get(Config::MAIN_SYNC_GPU_ADAPTIVE);
+
+  // Keep the adapted distance across unrelated config changes.
+  const int distance = s_sync_max_distance.load();
+  if (s_config_sync_gpu_adaptive && distance != 0)
+    s_sync_max_distance.store(std::clamp(distance, GetMinAdaptiveSyncDistance(),
+                                         s_config_sync_gpu_max_distance));
+  else
+    s_sync_max_distance.store(s_config_sync_gpu_max_distance);
 }
 
 void DoState(PointerWrap& p)
@@ -103,6 +177,9 @@ void DoState(PointerWrap& p)
 
   p.Do(s_sync_ticks);
   p.Do(s_syncing_suspended);
+
+  if (p.IsReadMode())
+    DiscardGatherPipeBursts();
 }
 
 void PauseAndLock(bool doLock, bool unpauseOnUnlock)
@@ -128,7 +205,13 @@ void Init()
 {
   if (!s_config_callback_id)
     s_config_callback_id = Config::AddConfigChangedCallback(RefreshConfig);
+  s_sync_max_distance.store(0);
   RefreshConfig();
+  s_adaptive_window_ticks = 0;
+  s_adaptive_window_waits = 0;
+  s_adaptive_window_register_syncs = 0;
+  s_sync_waits.store(0);
+  s_sync_register_syncs.store(0);
 
   // Padded so that SIMD overreads in the vertex loader are safe
   s_video_buffer = static_cast<u8*>(Common::AllocateMemoryPages(FIFO_SIZE + 4));
@@ -136,6 +219,15 @@ void Init()
   if (Core::System::GetInstance().IsDualCoreMode())
     s_gpu_mainloop.Prepare();
   s_sync_ticks.store(0);
+  s_sync_gpu_counts = {};
+
+  if (Config::Get(Config::MAIN_STREAM_GATHER_PIPE))
+    s_burst_ring = std::make_unique<GatherPipeBurst[]>(BURST_RING_SIZE);
+  s_burst_ring_write_index.store(0);
+  s_burst_ring_read_index.store(0);
+  s_streamed_bursts = 0;
+  s_read_bursts = 0;
+  UpdateStreamGatherPipe();
 }
 
 void Shutdown()
@@ -143,6 +235,24 @@ void Shutdown()
   if (s_gpu_mainloop.IsRunning())
     PanicAlertFmt("FIFO shutting down while active");
 
+  const auto& counts = s_sync_gpu_counts;
+  static_assert(s_sync_gpu_counts.size() == 7, "Update the log message below");
+  if (std::any_of(counts.begin(), counts.end(), [](u64 count) { return count != 0; }))
+  {
+    INFO_LOG_FMT(VIDEO,
+                 "Deterministic GPU thread syncs: other {}, wraparound {}, EFB peek {}, "
+                 "perf query {}, bbox {}, swap {}, aux space {}",
+                 counts[0], counts[1], counts[2], counts[3], counts[4], counts[5], counts[6]);
+  }
+
+  if (s_burst_ring)
+  {
+    INFO_LOG_FMT(VIDEO, "Gather pipe bursts streamed to the GPU thread: {}, read from RAM: {}",
+                 s_streamed_bursts, s_read_bursts);
+  }
+  s_burst_ring.reset();
+  s_stream_gather_pipe = false;
+
   Common::FreeMemoryPages(s_video_buffer, FIFO_SIZE + 4);
   s_video_buffer = nullptr;
   s_video_buffer_write_ptr = nullptr;
@@ -185,6 +295,8 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (s_use_deterministic_gpu_thread)
   {
+    ++s_sync_gpu_counts[static_cast<size_t>(reason)];
+
     s_gpu_mainloop.Wait();
     if (!s_gpu_mainloop.IsRunning())
       return;
@@ -219,6 +331,41 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
   }
 }
 
+void PushGatherPipeBurst(u32 address, const u8* data)
+{
+  if (!s_stream_gather_pipe)
+    return;
+
+  const u32 write_index = s_burst_ring_write_index.load(std::memory_order_relaxed);
+  if (write_index - s_burst_ring_read_index.load(std::memory_order_acquire) == BURST_RING_SIZE)
+    return;
+
+  GatherPipeBurst& burst = s_burst_ring[write_index % BURST_RING_SIZE];
+  burst.address = address;
+  std::memcpy(burst.data.data(), data, GPFifo::GATHER_PIPE_SIZE);
+  s_burst_ring_write_index.store(write_index + 1, std::memory_order_release);
+}
+
+// Copies the burst at address out of the ring, if the CPU thread streamed it.
+static bool PopGatherPipeBurst(u32 address, u8* dest)
+{
+  const u32 read_index = s_burst_ring_read_index.load(std::memory_order_relaxed);
+  const u32 write_index = s_burst_ring_write_index.load(std::memory_order_acquire);
+  if (read_index == write_index)
+    return false;
+
+  const GatherPipeBurst& burst = s_burst_ring[read_index % BURST_RING_SIZE];
+  if (burst.address != address)
+  {
+    s_burst_ring_read_index.store(write_index, std::memory_order_release);
+    return false;
+  }
+
+  std::memcpy(dest, burst.data.data(), GPFifo::GATHER_PIPE_SIZE);
+  s_burst_ring_read_index.store(read_index + 1, std::memory_order_release);
+  return true;
+}
+
 void PushFifoAuxBuffer(const void* ptr, size_t size)
 {
   if (size > (size_t)(s_fifo_aux_data + FIFO_SIZE - s_fifo_aux_write_ptr))
@@ -266,7 +413,15 @@ static void ReadDataFromFifo(u32 readPtr)
     s_video_buffer_read_ptr = s_video_buffer;
   }
   // Copy new video instructions to s_video_buffer for future use in rendering the new picture
-  Memory::CopyFromEmu(s_video_buffer_write_ptr, readPtr, GPFifo::GATHER_PIPE_SIZE);
+  if (s_burst_ring && PopGatherPipeBurst(readPtr, s_video_buffer_write_ptr))
+  {
+    ++s_streamed_bursts;
+  }
+  else
+  {
+    Memory::CopyFromEmu(s_video_buffer_write_ptr, readPtr, GPFifo::GATHER_PIPE_SIZE);
+    ++s_read_bursts;
+  }
   s_video_buffer_write_ptr += GPFifo::GATHER_PIPE_SIZE;
 }
 
@@ -314,6 +469,7 @@ void ResetVideoBuffer()
   s_video_buffer_pp_read_ptr = s_video_buffer;
   s_fifo_aux_write_ptr = s_fifo_aux_data;
   s_fifo_aux_read_ptr = s_fifo_aux_data;
+  DiscardGatherPipeBursts();
 }
 
 // Description: Main FIFO update loop
@@ -393,8 +549,8 @@ void RunGpuLoop()
             {
               cyclesExecuted = (int)(cyclesExecuted / s_config_sync_gpu_overclock);
               int old = s_sync_ticks.fetch_sub(cyclesExecuted);
-              if (old >= s_config_sync_gpu_max_distance &&
-                  old - (int)cyclesExecuted < s_config_sync_gpu_max_distance)
+              const int max_distance = s_sync_max_distance.load();
+              if (old >= max_distance && old - (int)cyclesExecuted < max_distance)
                 s_sync_wakeup_event.Set();
             }
 
@@ -409,7 +565,7 @@ void RunGpuLoop()
           if (s_sync_ticks.load() > 0)
           {
             int old = s_sync_ticks.exchange(0);
-            if (old >= s_config_sync_gpu_max_distance)
+            if (old >= s_sync_max_distance.load())
               s_sync_wakeup_event.Set();
           }
 
@@ -558,6 +714,8 @@ void UpdateWantDeterminism(bool want)
       CopyPreprocessCPStateFromMain();
       VertexLoaderManager::MarkAllDirty();
     }
+    UpdateStreamGatherPipe();
+    DiscardGatherPipeBursts();
   }
 }
 
@@ -566,6 +724,38 @@ bool UseDeterministicGPUThread()
   return s_use_deterministic_gpu_thread;
 }
 
+// Grows the sync distance while the CPU thread has to wait for a lagging GPU thread, so that the
+// threads overlap more in GPU bound games, and shrinks it for games which frequently read back
+// GPU state, where a GPU thread that is far behind is more likely to cause desyncs.
+static void UpdateAdaptiveSyncDistance(int ticks)
+{
+  s_adaptive_window_ticks += ticks;
+  if (s_adaptive_window_ticks < ADAPTIVE_SYNC_WINDOW)
+    return;
+
+  const int distance = s_sync_max_distance.load();
+  int new_distance;
+  if (s_adaptive_window_register_syncs >= ADAPTIVE_SYNC_SENSITIVE_ACCESSES)
+    new_distance = distance / 2;
+  else if (s_adaptive_window_waits != 0)
+    new_distance = distance + distance / 4 + GPU_TIME_SLOT_SIZE;
+  else
+    new_distance = distance + distance / 16 + GPU_TIME_SLOT_SIZE;
+  new_distance =
+      std::clamp(new_distance, GetMinAdaptiveSyncDistance(), s_config_sync_gpu_max_distance);
+
+  if (new_distance != distance)
+  {
+    DEBUG_LOG_FMT(VIDEO, "Sync distance {} -> {} ({} waits, {} register syncs)", distance,
+                  new_distance, s_adaptive_window_waits, s_adaptive_window_register_syncs);
+    s_sync_max_distance.store(new_distance);
+  }
+
+  s_adaptive_window_ticks = 0;
+  s_adaptive_window_waits = 0;
+  s_adaptive_window_register_syncs = 0;
+}
+
 /* This function checks the emulated CPU - GPU distance and may wake up the GPU,
  * or block the CPU if required. It should be called by the CPU thread regularly.
  * @ticks The gone emulated CPU time.
@@ -580,6 +770,9 @@ static int WaitForGpuThread(int ticks)
   if (old >= 0 && s_gpu_mainloop.IsDone())
     return -1;
 
+  if (s_config_sync_gpu_adaptive)
+    UpdateAdaptiveSyncDistance(ticks);
+
   // Wakeup GPU
   if (old < s_config_sync_gpu_min_distance && now >= s_config_sync_gpu_min_distance)
     RunGpu();
@@ -589,8 +782,12 @@ static int WaitForGpuThread(int ticks)
     return GPU_TIME_SLOT_SIZE + s_config_sync_gpu_min_distance - now;
 
   // Wait for GPU
-  if (now >= s_config_sync_gpu_max_distance)
+  if (now >= s_sync_max_distance.load())
+  {
+    s_sync_waits.fetch_add(1, std::memory_order_relaxed);
+    ++s_adaptive_window_waits;
     s_sync_wakeup_event.Wait();
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
@@ -616,12 +813,24 @@ static void SyncGPUCallback(u64 ticks, s64 cyclesLate)
 
 void SyncGPUForRegisterAccess()
 {
-  SyncGPU(SyncGPUReason::Other);
-
+  // The CPU thread preprocesses the FIFO in deterministic GPU thread mode, so the registers are
+  // already up to date once it has run. Games poll these a lot, so waiting for the GPU thread here
+  // would make up most of the syncs.
   if (!Core::System::GetInstance().IsDualCoreMode() || s_use_deterministic_gpu_thread)
     RunGpuOnCpu(GPU_TIME_SLOT_SIZE);
   else if (s_config_sync_gpu)
+  {
+    s_sync_register_syncs.fetch_add(1, std::memory_order_relaxed);
+    ++s_adaptive_window_register_syncs;
     WaitForGpuThread(GPU_TIME_SLOT_SIZE);
+  }
+}
+
+SyncGPUStats GetSyncGPUStats()
+{
+  return {s_sync_max_distance.load(std::memory_order_relaxed),
+          s_sync_waits.load(std::memory_order_relaxed),
+          s_sync_register_syncs.load(std::memory_order_relaxed)};
 }
 
 // Initialize GPU - CPU thread syncing, this gives us a deterministic way to start the GPU thread.
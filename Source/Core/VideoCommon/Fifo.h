@@ -23,19 +23,40 @@ enum class SyncGPUReason
 {
   Other,
   Wraparound,
-  EFBPoke,
+  EFBPeek,
   PerfQuery,
   BBox,
   Swap,
   AuxSpace,
+  Count,
 };
 // In deterministic GPU thread mode this waits for the GPU to be done with pending work.
+// The number of syncs for each reason is logged when emulation stops.
 void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr = true);
 
 // In single core mode, this runs the GPU for a single slice.
-// In dual core mode, this synchronizes with the GPU thread.
+// In dual core mode, this synchronizes with the GPU thread. In deterministic GPU thread mode the
+// CP and PE registers are only ever touched by the CPU thread, so the GPU thread isn't waited on.
 void SyncGPUForRegisterAccess();
 
+struct SyncGPUStats
+{
+  // How many ticks the CPU thread may currently run ahead of the GPU thread with "Sync GPU thread"
+  // enabled. With SyncGpuAdaptive, this changes depending on how the game behaves.
+  int max_distance;
+  // Number of times the CPU thread waited for the GPU thread to catch up since emulation started.
+  u64 waits;
+  // Number of CP/PE register accesses which synchronized with the GPU thread.
+  u64 register_syncs;
+};
+// Can be called from any thread.
+SyncGPUStats GetSyncGPUStats();
+
+// Called by the CPU thread for every gather pipe burst it writes to RAM. If streaming the gather
+// pipe is enabled, this also hands the burst to the GPU thread so that it doesn't have to read it
+// back from RAM.
+void PushGatherPipeBurst(u32 address, const u8* data);
+
 void PushFifoAuxBuffer(const void* ptr, size_t size);
 void* PopFifoAuxBuffer(size_t size);
 
@@ -18,6 +18,7 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/error.h>
+#include <libavutil/hwcontext.h>
 #include <libavutil/log.h>
 #include <libavutil/mathematics.h>
 #include <libavutil/opt.h>
@@ -49,6 +50,11 @@ struct FrameDumpContext
   AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
 
+  // Only used by encoders which take frames in video memory.
+  AVBufferRef* hw_device = nullptr;
+  AVBufferRef* hw_frames = nullptr;
+  AVFrame* hw_frame = nullptr;
+
   s64 last_pts = AV_NOPTS_VALUE;
 
   int width = 0;
@@ -155,6 +161,75 @@ std::string AVErrorString(int error)
   return fmt::format("{:8x} {}", (u32)error, &msg[0]);
 }
 
+bool IsHardwarePixelFormat(AVPixelFormat pix_fmt)
+{
+  const AVPixFmtDescriptor* const desc = av_pix_fmt_desc_get(pix_fmt);
+  return desc && (desc->flags & AV_PIX_FMT_FLAG_HWACCEL);
+}
+
+// Returns the hardware configuration to use for encoders which don't take frames in system memory
+// at all, like the VAAPI ones, or nullptr for other encoders.
+const AVCodecHWConfig* GetRequiredHardwareConfig(const AVCodec* codec)
+{
+  if (!codec->pix_fmts)
+    return nullptr;
+
+  for (const AVPixelFormat* pix_fmt = codec->pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; ++pix_fmt)
+  {
+    if (!IsHardwarePixelFormat(*pix_fmt))
+      return nullptr;
+  }
+
+  for (int i = 0;; ++i)
+  {
+    const AVCodecHWConfig* const config = avcodec_get_hw_config(codec, i);
+    if (!config || (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_FRAMES_CTX))
+      return config;
+  }
+}
+
+bool CreateHardwareFrames(FrameDumpContext* context, const AVCodecHWConfig& config,
+                          AVPixelFormat sw_pix_fmt)
+{
+  const char* const device_type_name = av_hwdevice_get_type_name(config.device_type);
+  const std::string& device = g_Config.sDumpHWDevice;
+  if (const int error =
+          av_hwdevice_ctx_create(&context->hw_device, config.device_type,
+                                 device.empty() ? nullptr : device.c_str(), nullptr, 0))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not create {} device: {}", device_type_name,
+                  AVErrorString(error));
+    return false;
+  }
+
+  context->hw_frames = av_hwframe_ctx_alloc(context->hw_device);
+  if (!context->hw_frames)
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not allocate {} frames context", device_type_name);
+    return false;
+  }
+
+  auto* const frames = reinterpret_cast<AVHWFramesContext*>(context->hw_frames->data);
+  frames->format = config.pix_fmt;
+  frames->sw_format = sw_pix_fmt;
+  frames->width = context->width;
+  frames->height = context->height;
+  if (const int error = av_hwframe_ctx_init(context->hw_frames))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not initialize {} frames context: {}", device_type_name,
+                  AVErrorString(error));
+    return false;
+  }
+
+  context->codec->hw_frames_ctx = av_buffer_ref(context->hw_frames);
+  context->hw_frame = av_frame_alloc();
+  if (!context->codec->hw_frames_ctx || !context->hw_frame)
+    return false;
+
+  INFO_LOG_FMT(FRAMEDUMP, "Uploading frames to {} for encoding", device_type_name);
+  return true;
+}
+
 }  // namespace
 
 bool FrameDump::Start(int w, int h, u64 start_ticks)
@@ -272,9 +347,13 @@ bool FrameDump::CreateVideoFile()
       WARN_LOG_FMT(FRAMEDUMP, "Invalid pixel format {}", pixel_format_string);
   }
 
+  const AVCodecHWConfig* const hw_config = GetRequiredHardwareConfig(codec);
+
   if (pix_fmt == AV_PIX_FMT_NONE)
   {
-    if (m_context->codec->codec_id == AV_CODEC_ID_FFV1)
+    if (hw_config)
+      pix_fmt = AV_PIX_FMT_NV12;
+    else if (m_context->codec->codec_id == AV_CODEC_ID_FFV1)
       pix_fmt = AV_PIX_FMT_BGR0;
     else if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
       pix_fmt = AV_PIX_FMT_GBRP;
@@ -282,7 +361,17 @@ bool FrameDump::CreateVideoFile()
       pix_fmt = AV_PIX_FMT_YUV420P;
   }
 
-  m_context->codec->pix_fmt = pix_fmt;
+  // Frames are still converted in system memory, and then uploaded for hardware encoders.
+  if (hw_config)
+  {
+    if (!CreateHardwareFrames(m_context.get(), *hw_config, pix_fmt))
+      return false;
+    m_context->codec->pix_fmt = hw_config->pix_fmt;
+  }
+  else
+  {
+    m_context->codec->pix_fmt = pix_fmt;
+  }
 
   if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
     av_opt_set_int(m_context->codec->priv_data, "pred", 3, 0);  // median
@@ -299,7 +388,7 @@ bool FrameDump::CreateVideoFile()
   m_context->src_frame = av_frame_alloc();
   m_context->scaled_frame = av_frame_alloc();
 
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
+  m_context->scaled_frame->format = pix_fmt;
   m_context->scaled_frame->width = m_context->width;
   m_context->scaled_frame->height = m_context->height;
 
@@ -383,7 +472,8 @@ void FrameDump::AddFrame(const FrameData& frame)
   // Convert image from RGBA to desired pixel format.
   m_context->sws = sws_getCachedContext(
       m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
+      static_cast<AVPixelFormat>(m_context->scaled_frame->format), SWS_BICUBIC, nullptr, nullptr,
+      nullptr);
   if (m_context->sws)
   {
     sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
@@ -393,7 +483,26 @@ void FrameDump::AddFrame(const FrameData& frame)
   m_context->last_pts = pts;
   m_context->scaled_frame->pts = pts;
 
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
+  AVFrame* encoded_frame = m_context->scaled_frame;
+  if (m_context->hw_frame)
+  {
+    av_frame_unref(m_context->hw_frame);
+    if (const int error = av_hwframe_get_buffer(m_context->hw_frames, m_context->hw_frame, 0))
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not allocate hardware frame: {}", AVErrorString(error));
+      return;
+    }
+    if (const int error =
+            av_hwframe_transfer_data(m_context->hw_frame, m_context->scaled_frame, 0))
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not upload hardware frame: {}", AVErrorString(error));
+      return;
+    }
+    m_context->hw_frame->pts = pts;
+    encoded_frame = m_context->hw_frame;
+  }
+
+  if (const int error = avcodec_send_frame(m_context->codec, encoded_frame))
   {
     ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
     return;
@@ -466,8 +575,11 @@ void FrameDump::CloseVideoFile()
 {
   av_frame_free(&m_context->src_frame);
   av_frame_free(&m_context->scaled_frame);
+  av_frame_free(&m_context->hw_frame);
 
   avcodec_free_context(&m_context->codec);
+  av_buffer_unref(&m_context->hw_frames);
+  av_buffer_unref(&m_context->hw_device);
 
   if (m_context->format)
     avio_closep(&m_context->format->pb);
@@ -70,6 +70,9 @@ inline FrameDump::~FrameDump() = default;
 
 inline FrameDump::FrameState FrameDump::FetchState(u64 ticks, int frame_number) const
 {
-  return {};
+  FrameState state;
+  state.ticks = ticks;
+  state.frame_number = frame_number;
+  return state;
 }
 #endif
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/FramebufferManager.h"
 
+#include <algorithm>
 #include <fmt/format.h>
 #include <memory>
 
@@ -414,19 +415,24 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
     y = EFB_HEIGHT - 1 - y;
 
   u32 tile_index;
-  if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
-    PopulateEFBCache(false, tile_index);
-
+  const bool present = IsEFBCacheTilePresent(false, x, y, &tile_index);
   if (IsUsingTiledEFBCache())
     m_efb_color_cache.tiles[tile_index].frame_access_mask |= 1;
 
+  u32 value;
+  if (!present)
+  {
+    if (ReadEFBAsyncReadback(false, tile_index, x, y, &value))
+      return value;
+    PopulateEFBCache(false, tile_index);
+  }
+
   if (m_efb_color_cache.needs_flush)
   {
     m_efb_color_cache.readback_texture->Flush();
     m_efb_color_cache.needs_flush = false;
   }
 
-  u32 value;
   m_efb_color_cache.readback_texture->ReadTexel(x, y, &value);
   return value;
 }
@@ -438,19 +444,24 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
     y = EFB_HEIGHT - 1 - y;
 
   u32 tile_index;
-  if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
-    PopulateEFBCache(true, tile_index);
-
+  const bool present = IsEFBCacheTilePresent(true, x, y, &tile_index);
   if (IsUsingTiledEFBCache())
     m_efb_depth_cache.tiles[tile_index].frame_access_mask |= 1;
 
+  float value;
+  if (!present)
+  {
+    if (ReadEFBAsyncReadback(true, tile_index, x, y, &value))
+      return value;
+    PopulateEFBCache(true, tile_index);
+  }
+
   if (m_efb_depth_cache.needs_flush)
   {
     m_efb_depth_cache.readback_texture->Flush();
     m_efb_depth_cache.needs_flush = false;
   }
 
-  float value;
   m_efb_depth_cache.readback_texture->ReadTexel(x, y, &value);
   return value;
 }
@@ -559,6 +570,15 @@ void FramebufferManager::FlagPeekCacheAsOutOfDate()
 
 void FramebufferManager::EndOfFrame()
 {
+  // The copies issued during this frame are read by the next one, and the buffer which was read
+  // during this frame receives the copies of the next one.
+  m_efb_async_readback_index ^= 1;
+  for (EFBCacheData* data : {&m_efb_color_cache, &m_efb_depth_cache})
+  {
+    EFBAsyncReadback& readback = data->async_readbacks[m_efb_async_readback_index];
+    std::fill(readback.tiles_copied.begin(), readback.tiles_copied.end(), false);
+  }
+
   if (!IsUsingTiledEFBCache())
     return;
 
@@ -648,7 +668,7 @@ void FramebufferManager::DestroyReadbackPipelines()
 
 bool FramebufferManager::CreateReadbackFramebuffer()
 {
-  if (g_renderer->GetEFBScale() != 1)
+  if (g_renderer->GetMaxEFBScale() != 1)
   {
     const TextureConfig color_config(IsUsingTiledEFBCache() ? m_efb_cache_tile_size : EFB_WIDTH,
                                      IsUsingTiledEFBCache() ? m_efb_cache_tile_size : EFB_HEIGHT, 1,
@@ -669,7 +689,7 @@ bool FramebufferManager::CreateReadbackFramebuffer()
       (IsUsingTiledEFBCache() && !g_ActiveConfig.backend_info.bSupportsPartialDepthCopies) ||
       !AbstractTexture::IsCompatibleDepthAndColorFormats(m_efb_depth_texture->GetFormat(),
                                                          GetEFBDepthCopyFormat()) ||
-      g_renderer->GetEFBScale() != 1)
+      g_renderer->GetMaxEFBScale() != 1)
   {
     const TextureConfig depth_config(IsUsingTiledEFBCache() ? m_efb_cache_tile_size : EFB_WIDTH,
                                      IsUsingTiledEFBCache() ? m_efb_cache_tile_size : EFB_HEIGHT, 1,
@@ -715,6 +735,11 @@ bool FramebufferManager::CreateReadbackFramebuffer()
 void FramebufferManager::DestroyReadbackFramebuffer()
 {
   auto DestroyCache = [](EFBCacheData& data) {
+    for (EFBAsyncReadback& readback : data.async_readbacks)
+    {
+      readback.texture.reset();
+      readback.tiles_copied.clear();
+    }
     data.readback_texture.reset();
     data.framebuffer.reset();
     data.texture.reset();
@@ -725,6 +750,60 @@ void FramebufferManager::DestroyReadbackFramebuffer()
 }
 
 void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index, bool async)
+{
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  CopyEFBCacheTile(depth, tile_index, data.readback_texture.get());
+
+  // Wait until the copy is complete.
+  if (!async)
+  {
+    data.readback_texture->Flush();
+    data.needs_flush = false;
+  }
+  else
+  {
+    data.needs_flush = true;
+  }
+  data.valid = true;
+  data.out_of_date = false;
+  if (IsUsingTiledEFBCache())
+    data.tiles[tile_index].present = true;
+}
+
+bool FramebufferManager::ReadEFBAsyncReadback(bool depth, u32 tile_index, u32 x, u32 y,
+                                              void* value)
+{
+  if (!g_ActiveConfig.bEFBAccessAsyncReadback)
+    return false;
+
+  // Copy the tile as it is at this point of the frame, so that the same peek in the next frame
+  // finds the data ready without waiting for the GPU.
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  EFBAsyncReadback& current = data.async_readbacks[m_efb_async_readback_index];
+  if (!current.texture)
+  {
+    current.texture = g_renderer->CreateStagingTexture(
+        StagingTextureType::Readback, data.readback_texture->GetConfig());
+    if (!current.texture)
+      return false;
+    current.tiles_copied.assign(std::max<size_t>(data.tiles.size(), 1), false);
+  }
+  if (!current.tiles_copied[tile_index])
+  {
+    CopyEFBCacheTile(depth, tile_index, current.texture.get());
+    current.tiles_copied[tile_index] = true;
+  }
+
+  // The copy of the previous frame has normally completed by now, so this does not stall.
+  EFBAsyncReadback& previous = data.async_readbacks[m_efb_async_readback_index ^ 1];
+  if (!previous.texture || !previous.tiles_copied[tile_index])
+    return false;
+
+  previous.texture->ReadTexel(x, y, value);
+  return true;
+}
+
+void FramebufferManager::CopyEFBCacheTile(bool depth, u32 tile_index, AbstractStagingTexture* dst)
 {
   FlushEFBPokes();
   g_vertex_manager->OnCPUEFBAccess();
@@ -739,7 +818,7 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index, bool async
                                                           GetEFBDepthCopyFormat()));
 
   // Issue a copy from framebuffer -> copy texture if we have >1xIR or MSAA on.
-  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  const EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
   const MathUtil::Rectangle<int> rect = GetEFBCacheTileRect(tile_index);
   const MathUtil::Rectangle<int> native_rect = g_renderer->ConvertEFBRectangle(rect);
   AbstractTexture* src_texture =
@@ -772,31 +851,16 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index, bool async
 
     // Copy from EFB or copy texture to staging texture.
     // No need to call FinishedRendering() here because CopyFromTexture() transitions.
-    data.readback_texture->CopyFromTexture(
-        data.texture.get(), MathUtil::Rectangle<int>(0, 0, rect.GetWidth(), rect.GetHeight()), 0, 0,
-        rect);
+    dst->CopyFromTexture(data.texture.get(),
+                         MathUtil::Rectangle<int>(0, 0, rect.GetWidth(), rect.GetHeight()), 0, 0,
+                         rect);
 
     g_renderer->EndUtilityDrawing();
   }
   else
   {
-    data.readback_texture->CopyFromTexture(src_texture, rect, 0, 0, rect);
-  }
-
-  // Wait until the copy is complete.
-  if (!async)
-  {
-    data.readback_texture->Flush();
-    data.needs_flush = false;
-  }
-  else
-  {
-    data.needs_flush = true;
+    dst->CopyFromTexture(src_texture, rect, 0, 0, rect);
   }
-  data.valid = true;
-  data.out_of_date = false;
-  if (IsUsingTiledEFBCache())
-    data.tiles[tile_index].present = true;
 }
 
 void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool clear_color,
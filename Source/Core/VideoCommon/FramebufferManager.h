@@ -125,6 +125,13 @@ protected:
     u8 frame_access_mask;
   };
 
+  // Tiles read back without waiting for the GPU, for the peeks of the next frame.
+  struct EFBAsyncReadback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    std::vector<bool> tiles_copied;
+  };
+
   // EFB cache - for CPU EFB access
   // Tiles are ordered left-to-right, then top-to-bottom
   struct EFBCacheData
@@ -134,6 +141,9 @@ protected:
     std::unique_ptr<AbstractStagingTexture> readback_texture;
     std::unique_ptr<AbstractPipeline> copy_pipeline;
     std::vector<EFBCacheTile> tiles;
+    // Indexed by m_efb_async_readback_index for the copies of the current frame, and by the other
+    // index for the copies of the previous frame.
+    std::array<EFBAsyncReadback, 2> async_readbacks;
     bool out_of_date;
     bool valid;
     bool needs_flush;
@@ -161,6 +171,8 @@ protected:
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
   void PopulateEFBCache(bool depth, u32 tile_index, bool async = false);
+  void CopyEFBCacheTile(bool depth, u32 tile_index, AbstractStagingTexture* dst);
+  bool ReadEFBAsyncReadback(bool depth, u32 tile_index, u32 x, u32 y, void* value);
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -195,6 +207,7 @@ protected:
   u32 m_efb_cache_tiles_wide = 0;
   EFBCacheData m_efb_color_cache = {};
   EFBCacheData m_efb_depth_cache = {};
+  u32 m_efb_async_readback_index = 0;
 
   // EFB clear pipelines
   // Indexed by [color_write_enabled][alpha_write_enabled][depth_write_enabled]
@@ -3,11 +3,10 @@
 
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 
-#include "Common/Hash.h"
-
 u32 FBInfo::CalculateHash() const
 {
-  return Common::HashAdler32(reinterpret_cast<const u8*>(this), sizeof(FBInfo));
+  // Copies are at most 1024 texels wide and high, so this doesn't collide in practice.
+  return m_width | (m_height << 12) | (static_cast<u32>(m_texture_format) << 24);
 }
 
 bool FBInfo::operator==(const FBInfo& other) const
@@ -80,9 +80,11 @@ const std::vector<GraphicsModAction*>&
 GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
                                                 const std::string& texture_name) const
 {
-  const auto lookup = fmt::format("{}_{}", texture_name, static_cast<int>(projection_type));
-  if (const auto it = m_projection_texture_target_to_actions.find(lookup);
-      it != m_projection_texture_target_to_actions.end())
+  const auto type_it = m_projection_texture_target_to_actions.find(projection_type);
+  if (type_it == m_projection_texture_target_to_actions.end())
+    return m_default;
+
+  if (const auto it = type_it->second.find(texture_name); it != type_it->second.end())
   {
     return it->second;
   }
@@ -126,7 +128,7 @@ const std::vector<GraphicsModAction*>& GraphicsModManager::GetEFBActions(const F
 
 const std::vector<GraphicsModAction*>& GraphicsModManager::GetXFBActions(const FBInfo& xfb) const
 {
-  if (const auto it = m_efb_target_to_actions.find(xfb); it != m_efb_target_to_actions.end())
+  if (const auto it = m_xfb_target_to_actions.find(xfb); it != m_xfb_target_to_actions.end())
   {
     return it->second;
   }
@@ -216,9 +218,9 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
                 [&](const ProjectionTarget& the_target) {
                   if (the_target.m_texture_info_string)
                   {
-                    const auto lookup = fmt::format("{}_{}", *the_target.m_texture_info_string,
-                                                    static_cast<int>(the_target.m_projection_type));
-                    m_projection_texture_target_to_actions[lookup].push_back(
+                    auto& texture_to_actions =
+                        m_projection_texture_target_to_actions[the_target.m_projection_type];
+                    texture_to_actions[*the_target.m_texture_info_string].push_back(
                         m_actions.back().get());
                   }
                   else
@@ -30,6 +30,21 @@ public:
   const std::vector<GraphicsModAction*>& GetEFBActions(const FBInfo& efb) const;
   const std::vector<GraphicsModAction*>& GetXFBActions(const FBInfo& xfb) const;
 
+  // Whether any loaded mod targets the category at all, so that callers can skip gathering what's
+  // needed for the lookup.
+  bool HasProjectionActions() const
+  {
+    return !m_projection_target_to_actions.empty() ||
+           !m_projection_texture_target_to_actions.empty();
+  }
+  bool HasDrawStartedActions() const { return !m_draw_started_target_to_actions.empty(); }
+  bool HasEFBActions() const { return !m_efb_target_to_actions.empty(); }
+  bool HasXFBActions() const { return !m_xfb_target_to_actions.empty(); }
+  bool NeedsTextureNames() const
+  {
+    return HasDrawStartedActions() || !m_projection_texture_target_to_actions.empty();
+  }
+
   void Load(const GraphicsModGroupConfig& config);
 
   void EndOfFrame();
@@ -43,7 +58,8 @@ private:
   std::list<std::unique_ptr<GraphicsModAction>> m_actions;
   std::unordered_map<ProjectionType, std::vector<GraphicsModAction*>>
       m_projection_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
+  std::unordered_map<ProjectionType,
+                     std::unordered_map<std::string, std::vector<GraphicsModAction*>>>
       m_projection_texture_target_to_actions;
   std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
   std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_load_target_to_actions;
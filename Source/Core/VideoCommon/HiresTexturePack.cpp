@@ -0,0 +1,221 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/HiresTexturePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <xxhash.h>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+std::shared_ptr<HiresTexturePack> HiresTexturePack::Open(const std::string& path)
+{
+  auto pack = std::make_shared<HiresTexturePack>();
+  pack->m_path = path;
+  if (!pack->m_file.Open(path))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open custom texture pack {}", path);
+    return nullptr;
+  }
+
+  if (pack->m_file.GetSize() < sizeof(Header))
+  {
+    ERROR_LOG_FMT(VIDEO, "Custom texture pack {} is truncated", path);
+    return nullptr;
+  }
+  std::memcpy(&pack->m_header, pack->m_file.GetData(), sizeof(Header));
+
+  if (!pack->Validate())
+    return nullptr;
+
+  INFO_LOG_FMT(VIDEO, "Opened custom texture pack {} with {} textures", path,
+               pack->m_header.num_textures);
+  return pack;
+}
+
+bool HiresTexturePack::Validate() const
+{
+  const u64 file_size = m_file.GetSize();
+  const auto is_in_file = [file_size](u64 offset, u64 size) {
+    return offset <= file_size && size <= file_size - offset;
+  };
+
+  if (m_header.magic != MAGIC || m_header.version != VERSION)
+  {
+    ERROR_LOG_FMT(VIDEO, "{} is not a supported custom texture pack", m_path);
+    return false;
+  }
+
+  // The tables are used in place, so they have to be aligned.
+  if (m_header.textures_offset % alignof(TextureEntry) != 0 ||
+      m_header.levels_offset % alignof(LevelEntry) != 0 ||
+      !is_in_file(m_header.textures_offset, u64{m_header.num_textures} * sizeof(TextureEntry)) ||
+      !is_in_file(m_header.levels_offset, u64{m_header.num_levels} * sizeof(LevelEntry)) ||
+      !is_in_file(m_header.names_offset, m_header.names_size))
+  {
+    ERROR_LOG_FMT(VIDEO, "Custom texture pack {} has an invalid header", m_path);
+    return false;
+  }
+
+  const std::span<const TextureEntry> textures = GetTextures();
+  for (size_t i = 0; i < textures.size(); ++i)
+  {
+    const TextureEntry& texture = textures[i];
+    if ((i > 0 && textures[i - 1].name_hash > texture.name_hash) || texture.num_levels == 0 ||
+        texture.first_level > m_header.num_levels ||
+        texture.num_levels > m_header.num_levels - texture.first_level ||
+        texture.name_offset > m_header.names_size ||
+        texture.name_size > m_header.names_size - texture.name_offset)
+    {
+      ERROR_LOG_FMT(VIDEO, "Custom texture pack {} has an invalid texture table", m_path);
+      return false;
+    }
+  }
+
+  const auto* levels = reinterpret_cast<const LevelEntry*>(m_file.GetData() +
+                                                           m_header.levels_offset);
+  for (u32 i = 0; i < m_header.num_levels; ++i)
+  {
+    if (!is_in_file(levels[i].data_offset, levels[i].data_size))
+    {
+      ERROR_LOG_FMT(VIDEO, "Custom texture pack {} has an invalid level table", m_path);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+u64 HiresTexturePack::HashName(std::string_view name)
+{
+  return XXH64(name.data(), name.size(), 0);
+}
+
+std::span<const HiresTexturePack::TextureEntry> HiresTexturePack::GetTextures() const
+{
+  const auto* textures =
+      reinterpret_cast<const TextureEntry*>(m_file.GetData() + m_header.textures_offset);
+  return {textures, m_header.num_textures};
+}
+
+const HiresTexturePack::TextureEntry* HiresTexturePack::Find(std::string_view name) const
+{
+  const std::span<const TextureEntry> textures = GetTextures();
+  const u64 hash = HashName(name);
+  auto iter = std::lower_bound(
+      textures.begin(), textures.end(), hash,
+      [](const TextureEntry& texture, u64 value) { return texture.name_hash < value; });
+  for (; iter != textures.end() && iter->name_hash == hash; ++iter)
+  {
+    if (GetName(*iter) == name)
+      return &*iter;
+  }
+
+  return nullptr;
+}
+
+std::string_view HiresTexturePack::GetName(const TextureEntry& texture) const
+{
+  const char* names = reinterpret_cast<const char*>(m_file.GetData() + m_header.names_offset);
+  return {names + texture.name_offset, texture.name_size};
+}
+
+std::span<const HiresTexturePack::LevelEntry>
+HiresTexturePack::GetLevels(const TextureEntry& texture) const
+{
+  const auto* levels =
+      reinterpret_cast<const LevelEntry*>(m_file.GetData() + m_header.levels_offset);
+  return {levels + texture.first_level, texture.num_levels};
+}
+
+std::span<const u8> HiresTexturePack::GetData(const LevelEntry& level) const
+{
+  return {m_file.GetData() + level.data_offset, static_cast<size_t>(level.data_size)};
+}
+
+bool HiresTexturePackWriter::Open(const std::string& path)
+{
+  m_textures.clear();
+  m_levels.clear();
+  m_names.clear();
+
+  // The header is written by Finish, once the table offsets are known.
+  const HiresTexturePack::Header header{};
+  return m_file.Open(path, "wb") && m_file.WriteArray(&header, 1) &&
+         Pad(HiresTexturePack::DATA_ALIGNMENT);
+}
+
+bool HiresTexturePackWriter::Pad(u64 alignment)
+{
+  const u64 position = m_file.Tell();
+  const std::vector<u8> zeroes(Common::AlignUp(position, alignment) - position);
+  return m_file.WriteBytes(zeroes.data(), zeroes.size());
+}
+
+bool HiresTexturePackWriter::AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                                        std::span<const HiresTexture::Level> levels)
+{
+  HiresTexturePack::TextureEntry& texture = m_textures.emplace_back();
+  texture.name_hash = HiresTexturePack::HashName(name);
+  texture.name_offset = static_cast<u32>(m_names.size());
+  texture.name_size = static_cast<u32>(name.size());
+  texture.first_level = static_cast<u32>(m_levels.size());
+  texture.num_levels = static_cast<u32>(levels.size());
+  texture.format = levels.empty() ? AbstractTextureFormat::RGBA8 : levels[0].format;
+  texture.flags = has_arbitrary_mipmaps ? HiresTexturePack::TEXTURE_FLAG_ARBITRARY_MIPMAPS : 0;
+  m_names += name;
+
+  for (const HiresTexture::Level& level : levels)
+  {
+    if (!Pad(HiresTexturePack::DATA_ALIGNMENT))
+      return false;
+
+    const std::span<const u8> data = level.GetData();
+    m_levels.push_back({m_file.Tell(), data.size(), level.width, level.height, level.row_length,
+                        0});
+    if (!m_file.WriteBytes(data.data(), data.size()))
+      return false;
+  }
+
+  return true;
+}
+
+bool HiresTexturePackWriter::Finish()
+{
+  std::sort(m_textures.begin(), m_textures.end(),
+            [](const auto& a, const auto& b) { return a.name_hash < b.name_hash; });
+
+  HiresTexturePack::Header header{};
+  header.magic = HiresTexturePack::MAGIC;
+  header.version = HiresTexturePack::VERSION;
+  header.num_textures = static_cast<u32>(m_textures.size());
+  header.num_levels = static_cast<u32>(m_levels.size());
+
+  if (!Pad(alignof(HiresTexturePack::TextureEntry)))
+    return false;
+  header.textures_offset = m_file.Tell();
+  if (!m_file.WriteArray(m_textures.data(), m_textures.size()))
+    return false;
+
+  header.levels_offset = m_file.Tell();
+  if (!m_file.WriteArray(m_levels.data(), m_levels.size()))
+    return false;
+
+  header.names_offset = m_file.Tell();
+  header.names_size = m_names.size();
+  if (!m_file.WriteBytes(m_names.data(), m_names.size()))
+    return false;
+
+  return m_file.Seek(0, File::SeekOrigin::Begin) && m_file.WriteArray(&header, 1) &&
+         m_file.Close();
+}
@@ -0,0 +1,113 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/TextureConfig.h"
+
+// A pack of custom textures in a single file, which is memory-mapped so that the texture data can
+// be uploaded straight from it. Textures are looked up by the hash of their name.
+//
+// All values are stored in host byte order, which is little-endian on every supported platform.
+// The file consists of:
+// - the header
+// - the data of every level, each aligned to DATA_ALIGNMENT
+// - the texture table, sorted by name hash
+// - the level table
+// - the texture names, which aren't null-terminated
+class HiresTexturePack
+{
+public:
+  static constexpr u32 MAGIC = 0x4B505444;  // "DTPK"
+  static constexpr u32 VERSION = 1;
+  static constexpr u32 DATA_ALIGNMENT = 256;
+  static constexpr const char* EXTENSION = ".dtp";
+
+  struct Header
+  {
+    u32 magic;
+    u32 version;
+    u32 num_textures;
+    u32 num_levels;
+    u64 textures_offset;
+    u64 levels_offset;
+    u64 names_offset;
+    u64 names_size;
+  };
+  static_assert(sizeof(Header) == 48);
+
+  enum TextureFlags : u32
+  {
+    TEXTURE_FLAG_ARBITRARY_MIPMAPS = 1 << 0,
+  };
+
+  struct TextureEntry
+  {
+    u64 name_hash;
+    u32 name_offset;
+    u32 name_size;
+    u32 first_level;
+    u32 num_levels;
+    AbstractTextureFormat format;
+    u32 flags;
+  };
+  static_assert(sizeof(TextureEntry) == 32);
+
+  struct LevelEntry
+  {
+    u64 data_offset;
+    u64 data_size;
+    u32 width;
+    u32 height;
+    u32 row_length;
+    u32 padding;
+  };
+  static_assert(sizeof(LevelEntry) == 32);
+
+  // Returns nullptr if the file can't be mapped or isn't a valid pack.
+  static std::shared_ptr<HiresTexturePack> Open(const std::string& path);
+
+  static u64 HashName(std::string_view name);
+
+  std::span<const TextureEntry> GetTextures() const;
+  const TextureEntry* Find(std::string_view name) const;
+  std::string_view GetName(const TextureEntry& texture) const;
+  std::span<const LevelEntry> GetLevels(const TextureEntry& texture) const;
+  std::span<const u8> GetData(const LevelEntry& level) const;
+
+private:
+  bool Validate() const;
+
+  std::string m_path;
+  Common::MappedFile m_file;
+  Header m_header{};
+};
+
+// Builds a HiresTexturePack, writing the level data as textures are added.
+class HiresTexturePackWriter
+{
+public:
+  bool Open(const std::string& path);
+  bool AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                  std::span<const HiresTexture::Level> levels);
+  // Writes the tables. The pack is unusable if this isn't called or fails.
+  bool Finish();
+
+private:
+  bool Pad(u64 alignment);
+
+  File::IOFile m_file;
+  std::vector<HiresTexturePack::TextureEntry> m_textures;
+  std::vector<HiresTexturePack::LevelEntry> m_levels;
+  std::string m_names;
+};
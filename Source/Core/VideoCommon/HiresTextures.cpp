@@ -4,6 +4,8 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <array>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -28,8 +30,10 @@
 #include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/HiresTexturePack.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -42,12 +46,38 @@ struct DiskTexture
 constexpr std::string_view s_format_prefix{"tex1_"};
 
 static std::unordered_map<std::string, DiskTexture> s_textureMap;
+static std::vector<std::shared_ptr<HiresTexturePack>> s_texture_packs;
 static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_textureCache;
 static std::mutex s_textureCacheMutex;
 static Common::Flag s_textureCacheAbortLoading;
 
 static std::thread s_prefetcher;
 
+struct AsyncLoadRequest
+{
+  std::string base_filename;
+  u32 width;
+  u32 height;
+  std::shared_ptr<HiresTexture> texture;
+};
+
+// Custom textures loaded in the background. They are evicted in least recently used order once
+// their total size exceeds the memory budget. Guarded by s_textureCacheMutex.
+struct AsyncTexture
+{
+  std::shared_ptr<HiresTexture> texture;
+  std::list<std::string>::iterator lru_iter;
+  size_t size = 0;
+};
+
+static std::unordered_map<std::string, AsyncTexture> s_async_textures;
+// Most recently used first.
+static std::list<std::string> s_async_lru;
+static size_t s_async_textures_size = 0;
+static size_t s_async_textures_budget = 0;
+static std::array<Common::WorkQueueThread<AsyncLoadRequest>, 2> s_async_loaders;
+static size_t s_next_async_loader = 0;
+
 void HiresTexture::Init()
 {
   // Note: Update is not called here so that we handle dynamic textures on startup more gracefully
@@ -65,6 +95,7 @@ void HiresTexture::Update()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  StopAsyncLoaders();
 
   if (!g_ActiveConfig.bHiresTextures)
   {
@@ -80,36 +111,11 @@ void HiresTexture::Update()
   const std::string& game_id = SConfig::GetInstance().GetGameID();
   const std::set<std::string> texture_directories =
       GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
 
+  s_texture_packs.clear();
   for (const auto& texture_directory : texture_directories)
   {
-    const auto texture_paths =
-        Common::DoFileSearch({texture_directory}, extensions, /*recursive*/ true);
-
-    bool failed_insert = false;
-    for (auto& path : texture_paths)
-    {
-      std::string filename;
-      SplitPath(path, nullptr, &filename, nullptr);
-
-      if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
-      {
-        const size_t arb_index = filename.rfind("_arb");
-        const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
-        if (has_arbitrary_mipmaps)
-          filename.erase(arb_index, 4);
-
-        const auto [it, inserted] =
-            s_textureMap.try_emplace(filename, DiskTexture{path, has_arbitrary_mipmaps});
-        if (!inserted)
-        {
-          failed_insert = true;
-        }
-      }
-    }
-
-    if (failed_insert)
+    if (!FindTextures(texture_directory, &s_textureMap, &s_texture_packs))
     {
       ERROR_LOG_FMT(VIDEO, "One or more textures at path '{}' were already inserted",
                     texture_directory);
@@ -122,7 +128,7 @@ void HiresTexture::Update()
     auto iter = s_textureCache.begin();
     while (iter != s_textureCache.end())
     {
-      if (s_textureMap.find(iter->first) == s_textureMap.end())
+      if (!HasTexture(iter->first))
       {
         iter = s_textureCache.erase(iter);
       }
@@ -135,6 +141,13 @@ void HiresTexture::Update()
     s_textureCacheAbortLoading.Clear();
     s_prefetcher = std::thread(Prefetch);
   }
+
+  if (g_ActiveConfig.bAsyncHiresTextures)
+  {
+    s_async_textures_budget =
+        static_cast<size_t>(std::max(g_ActiveConfig.iHiresTextureMemoryBudget, 0)) * 1024 * 1024;
+    StartAsyncLoaders();
+  }
 }
 
 void HiresTexture::Clear()
@@ -144,8 +157,132 @@ void HiresTexture::Clear()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  StopAsyncLoaders();
   s_textureMap.clear();
   s_textureCache.clear();
+  s_texture_packs.clear();
+}
+
+bool HiresTexture::FindTextures(const std::string& directory, DiskTextureMap* texture_map,
+                                std::vector<std::shared_ptr<HiresTexturePack>>* packs)
+{
+  std::vector<std::string> extensions{".png", ".dds"};
+  if (packs)
+    extensions.emplace_back(HiresTexturePack::EXTENSION);
+
+  const auto texture_paths = Common::DoFileSearch({directory}, extensions, /*recursive*/ true);
+
+  bool failed_insert = false;
+  for (auto& path : texture_paths)
+  {
+    std::string filename;
+    std::string extension;
+    SplitPath(path, nullptr, &filename, &extension);
+    Common::ToLower(&extension);
+
+    if (packs && extension == HiresTexturePack::EXTENSION)
+    {
+      if (auto pack = HiresTexturePack::Open(path))
+        packs->push_back(std::move(pack));
+      continue;
+    }
+
+    if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
+    {
+      const size_t arb_index = filename.rfind("_arb");
+      const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+      if (has_arbitrary_mipmaps)
+        filename.erase(arb_index, 4);
+
+      const auto [it, inserted] =
+          texture_map->try_emplace(filename, DiskTexture{path, has_arbitrary_mipmaps});
+      if (!inserted)
+      {
+        failed_insert = true;
+      }
+    }
+  }
+
+  return !failed_insert;
+}
+
+bool HiresTexture::HasTexture(const std::string& name)
+{
+  if (s_textureMap.find(name) != s_textureMap.end())
+    return true;
+
+  return std::any_of(s_texture_packs.begin(), s_texture_packs.end(),
+                     [&name](const auto& pack) { return pack->Find(name) != nullptr; });
+}
+
+bool HiresTexture::BuildPack(const std::string& directory, const std::string& pack_path)
+{
+  DiskTextureMap texture_map;
+  if (!FindTextures(directory, &texture_map, nullptr))
+    ERROR_LOG_FMT(VIDEO, "One or more textures at path '{}' were already inserted", directory);
+
+  HiresTexturePackWriter writer;
+  if (!writer.Open(pack_path))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to create custom texture pack {}", pack_path);
+    return false;
+  }
+
+  size_t num_textures = 0;
+  for (const auto& [name, disk_texture] : texture_map)
+  {
+    // Mip levels are stored along with their base texture.
+    if (name.find("_mip") != std::string::npos)
+      continue;
+
+    const std::unique_ptr<HiresTexture> texture = Load(texture_map, name, 0, 0);
+    if (!texture)
+      continue;
+
+    if (!writer.AddTexture(name, texture->m_has_arbitrary_mipmaps, texture->m_levels))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to write custom texture pack {}", pack_path);
+      return false;
+    }
+    ++num_textures;
+  }
+
+  if (!writer.Finish())
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write custom texture pack {}", pack_path);
+    return false;
+  }
+
+  NOTICE_LOG_FMT(VIDEO, "Packed {} custom textures into {}", num_textures, pack_path);
+  return true;
+}
+
+void HiresTexture::StartAsyncLoaders()
+{
+  for (auto& loader : s_async_loaders)
+  {
+    loader.Reset([](AsyncLoadRequest request) {
+      LoadAsync(request.base_filename, request.width, request.height, std::move(request.texture));
+    });
+  }
+}
+
+void HiresTexture::StopAsyncLoaders()
+{
+  for (auto& loader : s_async_loaders)
+  {
+    loader.Clear();
+    loader.Shutdown();
+  }
+
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+
+  // Texture cache entries waiting for a load which was dropped just get recreated.
+  for (auto& [name, entry] : s_async_textures)
+    entry.texture->m_loading.store(false, std::memory_order_release);
+  s_async_textures.clear();
+  s_async_lru.clear();
+  s_async_textures_size = 0;
 }
 
 void HiresTexture::Prefetch()
@@ -159,11 +296,20 @@ void HiresTexture::Prefetch()
   const size_t max_mem =
       (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
 
+  std::vector<std::string_view> base_filenames;
+  for (const auto& entry : s_textureMap)
+    base_filenames.emplace_back(entry.first);
+  for (const auto& pack : s_texture_packs)
+  {
+    for (const HiresTexturePack::TextureEntry& texture : pack->GetTextures())
+      base_filenames.emplace_back(pack->GetName(texture));
+  }
+
   Common::Timer timer;
   timer.Start();
-  for (const auto& entry : s_textureMap)
+  for (const std::string_view base_filename_view : base_filenames)
   {
-    const std::string& base_filename = entry.first;
+    const std::string base_filename(base_filename_view);
 
     if (base_filename.find("_mip") == std::string::npos)
     {
@@ -215,14 +361,14 @@ void HiresTexture::Prefetch()
 
 std::string HiresTexture::GenBaseName(const TextureInfo& texture_info, bool dump)
 {
-  if (!dump && s_textureMap.empty())
+  if (!dump && s_textureMap.empty() && s_texture_packs.empty())
     return "";
 
   const auto texture_name_details = texture_info.CalculateTextureName();
 
   // look for an exact match first
   const std::string full_name = texture_name_details.GetFullName();
-  if (dump || s_textureMap.find(full_name) != s_textureMap.end())
+  if (dump || HasTexture(full_name))
     return full_name;
 
   // else try and find a wildcard
@@ -232,14 +378,14 @@ std::string HiresTexture::GenBaseName(const TextureInfo& texture_info, bool dump
     const std::string texture_name_single_wildcard_tlut =
         fmt::format("{}_{}_$_{}", texture_name_details.base_name, texture_name_details.texture_name,
                     texture_name_details.format_name);
-    if (s_textureMap.find(texture_name_single_wildcard_tlut) != s_textureMap.end())
+    if (HasTexture(texture_name_single_wildcard_tlut))
       return texture_name_single_wildcard_tlut;
 
     // Single wildcard ignoring the texture hash
     const std::string texture_name_single_wildcard_tex =
         fmt::format("{}_${}_{}", texture_name_details.base_name, texture_name_details.tlut_name,
                     texture_name_details.format_name);
-    if (s_textureMap.find(texture_name_single_wildcard_tex) != s_textureMap.end())
+    if (HasTexture(texture_name_single_wildcard_tex))
       return texture_name_single_wildcard_tex;
   }
 
@@ -273,6 +419,9 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_in
     return iter->second;
   }
 
+  if (g_ActiveConfig.bAsyncHiresTextures)
+    return SearchAsync(base_filename, texture_info.GetRawWidth(), texture_info.GetRawHeight());
+
   std::shared_ptr<HiresTexture> ptr(
       Load(base_filename, texture_info.GetRawWidth(), texture_info.GetRawHeight()));
 
@@ -284,12 +433,134 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_in
   return ptr;
 }
 
+std::shared_ptr<HiresTexture> HiresTexture::SearchAsync(const std::string& base_filename,
+                                                        u32 width, u32 height)
+{
+  if (!HasTexture(base_filename))
+    return nullptr;
+
+  const auto [iter, inserted] = s_async_textures.try_emplace(base_filename);
+  AsyncTexture& entry = iter->second;
+  if (inserted)
+  {
+    // Can't use make_shared due to private constructor.
+    entry.texture = std::shared_ptr<HiresTexture>(new HiresTexture());
+    entry.texture->m_loading.store(true, std::memory_order_relaxed);
+    s_async_lru.push_front(base_filename);
+    entry.lru_iter = s_async_lru.begin();
+
+    s_async_loaders[s_next_async_loader].EmplaceItem(
+        AsyncLoadRequest{base_filename, width, height, entry.texture});
+    s_next_async_loader = (s_next_async_loader + 1) % s_async_loaders.size();
+  }
+  else
+  {
+    s_async_lru.splice(s_async_lru.begin(), s_async_lru, entry.lru_iter);
+  }
+
+  // Textures which failed to load stay in the map so that they aren't loaded over and over.
+  if (!entry.texture->IsLoading() && entry.texture->m_levels.empty())
+    return nullptr;
+
+  return entry.texture;
+}
+
+void HiresTexture::LoadAsync(const std::string& base_filename, u32 width, u32 height,
+                             std::shared_ptr<HiresTexture> texture)
+{
+  std::unique_ptr<HiresTexture> loaded = Load(base_filename, width, height);
+
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+
+  if (loaded)
+  {
+    texture->m_levels = std::move(loaded->m_levels);
+    texture->m_has_arbitrary_mipmaps = loaded->m_has_arbitrary_mipmaps;
+    texture->m_pack = std::move(loaded->m_pack);
+  }
+  texture->m_loading.store(false, std::memory_order_release);
+
+  const auto iter = s_async_textures.find(base_filename);
+  if (iter == s_async_textures.end() || iter->second.texture != texture)
+    return;
+
+  for (const Level& level : texture->m_levels)
+    iter->second.size += level.data.size();
+  s_async_textures_size += iter->second.size;
+
+  // Evict the least recently used textures which are done loading, except the new one.
+  auto lru_iter = s_async_lru.end();
+  while (s_async_textures_size > s_async_textures_budget && lru_iter != s_async_lru.begin())
+  {
+    --lru_iter;
+    const auto evicted = s_async_textures.find(*lru_iter);
+    if (evicted == iter || evicted->second.texture->IsLoading())
+      continue;
+
+    s_async_textures_size -= evicted->second.size;
+    s_async_textures.erase(evicted);
+    lru_iter = s_async_lru.erase(lru_iter);
+  }
+}
+
 std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filename, u32 width,
                                                  u32 height)
+{
+  // Loose files take priority over packs, so that single textures of a pack can be replaced.
+  if (s_textureMap.find(base_filename) != s_textureMap.end())
+    return Load(s_textureMap, base_filename, width, height);
+
+  return LoadFromPack(base_filename);
+}
+
+std::unique_ptr<HiresTexture> HiresTexture::LoadFromPack(const std::string& base_filename)
+{
+  for (const auto& pack : s_texture_packs)
+  {
+    const HiresTexturePack::TextureEntry* entry = pack->Find(base_filename);
+    if (!entry)
+      continue;
+
+    const bool is_bc = entry->format == AbstractTextureFormat::DXT1 ||
+                       entry->format == AbstractTextureFormat::DXT3 ||
+                       entry->format == AbstractTextureFormat::DXT5;
+    if ((is_bc && !g_ActiveConfig.backend_info.bSupportsST3CTextures) ||
+        (entry->format == AbstractTextureFormat::BPTC &&
+         !g_ActiveConfig.backend_info.bSupportsBPTCTextures))
+    {
+      ERROR_LOG_FMT(VIDEO, "Custom texture {} uses a format unsupported by the backend",
+                    base_filename);
+      continue;
+    }
+
+    // Can't use make_unique due to private constructor.
+    std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
+    ret->m_has_arbitrary_mipmaps =
+        (entry->flags & HiresTexturePack::TEXTURE_FLAG_ARBITRARY_MIPMAPS) != 0;
+    for (const HiresTexturePack::LevelEntry& level_entry : pack->GetLevels(*entry))
+    {
+      Level level;
+      level.format = entry->format;
+      level.width = level_entry.width;
+      level.height = level_entry.height;
+      level.row_length = level_entry.row_length;
+      level.mapped_data = pack->GetData(level_entry);
+      ret->m_levels.push_back(std::move(level));
+    }
+    ret->m_pack = pack;
+    return ret;
+  }
+
+  return nullptr;
+}
+
+std::unique_ptr<HiresTexture> HiresTexture::Load(const DiskTextureMap& texture_map,
+                                                 const std::string& base_filename, u32 width,
+                                                 u32 height)
 {
   // We need to have a level 0 custom texture to even consider loading.
-  auto filename_iter = s_textureMap.find(base_filename);
-  if (filename_iter == s_textureMap.end())
+  auto filename_iter = texture_map.find(base_filename);
+  if (filename_iter == texture_map.end())
     return nullptr;
 
   // Try to load level 0 (and any mipmaps) from a DDS file.
@@ -307,8 +578,8 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     if (mip_level != 0)
       filename += fmt::format("_mip{}", mip_level);
 
-    filename_iter = s_textureMap.find(filename);
-    if (filename_iter == s_textureMap.end())
+    filename_iter = texture_map.find(filename);
+    if (filename_iter == texture_map.end())
       break;
 
     // Try loading DDS textures first, that way we maintain compression of DXT formats.
@@ -3,9 +3,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <set>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -13,6 +17,8 @@
 #include "VideoCommon/TextureInfo.h"
 
 enum class TextureFormat;
+struct DiskTexture;
+class HiresTexturePack;
 
 std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_directory,
                                                       const std::string& game_id);
@@ -25,16 +31,22 @@ public:
   static void Clear();
   static void Shutdown();
 
+  // With bAsyncHiresTextures, this may return a texture which is still loading in the background,
+  // in which case it has no levels yet.
   static std::shared_ptr<HiresTexture> Search(const TextureInfo& texture_info);
 
   static std::string GenBaseName(const TextureInfo& texture_info, bool dump = false);
 
   static u32 CalculateMipCount(u32 width, u32 height);
 
+  // Packs all custom textures found in the directory into a HiresTexturePack.
+  static bool BuildPack(const std::string& directory, const std::string& pack_path);
+
   ~HiresTexture();
 
   AbstractTextureFormat GetFormat() const;
   bool HasArbitraryMipmaps() const;
+  bool IsLoading() const { return m_loading.load(std::memory_order_acquire); }
 
   struct Level
   {
@@ -43,17 +55,42 @@ public:
     u32 width = 0;
     u32 height = 0;
     u32 row_length = 0;
+    // Used instead of data for textures from a HiresTexturePack.
+    std::span<const u8> mapped_data;
+
+    std::span<const u8> GetData() const
+    {
+      return data.empty() ? mapped_data : std::span<const u8>(data);
+    }
   };
   std::vector<Level> m_levels;
 
 private:
+  using DiskTextureMap = std::unordered_map<std::string, DiskTexture>;
+
+  static bool FindTextures(const std::string& directory, DiskTextureMap* texture_map,
+                           std::vector<std::shared_ptr<HiresTexturePack>>* packs);
+  static bool HasTexture(const std::string& name);
   static std::unique_ptr<HiresTexture> Load(const std::string& base_filename, u32 width,
                                             u32 height);
+  static std::unique_ptr<HiresTexture> Load(const DiskTextureMap& texture_map,
+                                            const std::string& base_filename, u32 width,
+                                            u32 height);
+  static std::unique_ptr<HiresTexture> LoadFromPack(const std::string& base_filename);
   static bool LoadDDSTexture(HiresTexture* tex, const std::string& filename);
   static bool LoadDDSTexture(Level& level, const std::string& filename, u32 mip_level);
   static bool LoadTexture(Level& level, const std::vector<u8>& buffer);
   static void Prefetch();
+  static std::shared_ptr<HiresTexture> SearchAsync(const std::string& base_filename, u32 width,
+                                                   u32 height);
+  static void LoadAsync(const std::string& base_filename, u32 width, u32 height,
+                        std::shared_ptr<HiresTexture> texture);
+  static void StartAsyncLoaders();
+  static void StopAsyncLoaders();
 
   HiresTexture() = default;
   bool m_has_arbitrary_mipmaps = false;
+  std::atomic<bool> m_loading = false;
+  // Keeps the pack mapped while its data is referenced by the levels.
+  std::shared_ptr<const HiresTexturePack> m_pack;
 };
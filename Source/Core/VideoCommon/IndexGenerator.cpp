@@ -239,6 +239,19 @@ void IndexGenerator::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vert
   m_base_index += num_vertices;
 }
 
+void IndexGenerator::AddRemappedIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices,
+                                        const u16* remap, u32 num_unique_vertices)
+{
+  u16* const start = m_index_buffer_current;
+  m_index_buffer_current = m_primitive_table[primitive](start, num_vertices, 0);
+  for (u16* index = start; index != m_index_buffer_current; ++index)
+  {
+    if (*index != s_primitive_restart)
+      *index = static_cast<u16>(m_base_index + remap[*index]);
+  }
+  m_base_index += num_unique_vertices;
+}
+
 void IndexGenerator::AddExternalIndices(const u16* indices, u32 num_indices, u32 num_vertices)
 {
   std::memcpy(m_index_buffer_current, indices, sizeof(u16) * num_indices);
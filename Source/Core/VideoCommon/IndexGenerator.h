@@ -18,6 +18,11 @@ public:
 
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
 
+  // Like AddIndices, for a primitive whose num_vertices vertices were deduplicated into
+  // num_unique_vertices. remap gives the unique vertex for each of the original ones.
+  void AddRemappedIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices, const u16* remap,
+                          u32 num_unique_vertices);
+
   void AddExternalIndices(const u16* indices, u32 num_indices, u32 num_vertices);
 
   // returns numprimitives
@@ -47,6 +47,12 @@ struct Message
 static std::multimap<MessageType, Message> s_messages;
 static std::mutex s_messages_mutex;
 
+// What DrawMessages last drew, guarded by s_messages_mutex.
+static bool s_messages_changed = true;
+static bool s_drew_messages = false;
+static int s_drawn_obscured_pixels_left = 0;
+static int s_drawn_obscured_pixels_top = 0;
+
 static ImVec4 ARGBToImVec4(const u32 argb)
 {
   return ImVec4(static_cast<float>((argb >> 16) & 0xFF) / 255.0f,
@@ -96,23 +102,31 @@ void AddTypedMessage(MessageType type, std::string message, u32 ms, u32 argb)
   std::lock_guard lock{s_messages_mutex};
   s_messages.erase(type);
   s_messages.emplace(type, Message(std::move(message), ms, argb));
+  s_messages_changed = true;
 }
 
 void AddMessage(std::string message, u32 ms, u32 argb)
 {
   std::lock_guard lock{s_messages_mutex};
   s_messages.emplace(MessageType::Typeless, Message(std::move(message), ms, argb));
+  s_messages_changed = true;
 }
 
 void DrawMessages()
 {
   const bool draw_messages = Config::Get(Config::MAIN_OSD_MESSAGES);
+  const int obscured_pixels_left = s_obscured_pixels_left;
+  const int obscured_pixels_top = s_obscured_pixels_top;
   const float current_x =
-      LEFT_MARGIN * ImGui::GetIO().DisplayFramebufferScale.x + s_obscured_pixels_left;
-  float current_y = TOP_MARGIN * ImGui::GetIO().DisplayFramebufferScale.y + s_obscured_pixels_top;
+      LEFT_MARGIN * ImGui::GetIO().DisplayFramebufferScale.x + obscured_pixels_left;
+  float current_y = TOP_MARGIN * ImGui::GetIO().DisplayFramebufferScale.y + obscured_pixels_top;
   int index = 0;
 
   std::lock_guard lock{s_messages_mutex};
+  s_messages_changed = false;
+  s_drew_messages = draw_messages;
+  s_drawn_obscured_pixels_left = obscured_pixels_left;
+  s_drawn_obscured_pixels_top = obscured_pixels_top;
 
   for (auto it = s_messages.begin(); it != s_messages.end();)
   {
@@ -136,10 +150,30 @@ void DrawMessages()
   }
 }
 
+bool NeedsRedraw()
+{
+  std::lock_guard lock{s_messages_mutex};
+  if (s_messages_changed || s_drew_messages != Config::Get(Config::MAIN_OSD_MESSAGES) ||
+      s_drawn_obscured_pixels_left != s_obscured_pixels_left ||
+      s_drawn_obscured_pixels_top != s_obscured_pixels_top)
+  {
+    return true;
+  }
+  if (!s_drew_messages)
+    return false;
+
+  // Messages fade away at the end of their life, and are removed once it is over.
+  return std::any_of(s_messages.begin(), s_messages.end(), [](const auto& entry) {
+    const Message& msg = entry.second;
+    return !msg.ever_drawn || msg.TimeRemaining() < MESSAGE_FADE_TIME;
+  });
+}
+
 void ClearMessages()
 {
   std::lock_guard lock{s_messages_mutex};
   s_messages.clear();
+  s_messages_changed = true;
 }
 
 void SetObscuredPixelsLeft(int width)
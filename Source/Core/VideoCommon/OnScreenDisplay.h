@@ -42,6 +42,8 @@ void AddTypedMessage(MessageType type, std::string message, u32 ms = Duration::S
 
 // Draw the current messages on the screen. Only call once per frame.
 void DrawMessages();
+// Returns whether DrawMessages would draw anything different from what it drew last time.
+bool NeedsRedraw();
 void ClearMessages();
 
 void SetObscuredPixelsLeft(int width);
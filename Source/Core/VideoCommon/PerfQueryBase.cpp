@@ -11,3 +11,18 @@ bool PerfQueryBase::ShouldEmulate()
 {
   return g_ActiveConfig.bPerfQueriesEnable;
 }
+
+void PerfQueryBase::SaveCompletedResults()
+{
+  for (int i = 0; i < PQ_NUM_MEMBERS; ++i)
+  {
+    m_completed_results[i].store(GetQueryResult(static_cast<PerfQueryType>(i)),
+                                 std::memory_order_relaxed);
+  }
+  m_completed_results_requested.store(false);
+}
+
+u32 PerfQueryBase::GetCompletedResult(PerfQueryType type) const
+{
+  return m_completed_results[type].load(std::memory_order_relaxed);
+}
@@ -62,9 +62,21 @@ public:
   // NOTE: Called from CPU thread
   virtual bool IsFlushed() const { return true; }
 
+  // Lets the CPU thread use results that lag behind instead of waiting for the GPU, see
+  // VideoConfig::iPerfQueriesMaxLatency. The GPU thread saves the results once all queries have
+  // completed, after being requested to.
+  void RequestCompletedResults() { m_completed_results_requested.store(true); }
+  bool IsCompletedResultsRequestPending() const { return m_completed_results_requested.load(); }
+  void SaveCompletedResults();
+  u32 GetCompletedResult(PerfQueryType type) const;
+
 protected:
   std::atomic<u32> m_query_count;
   std::array<std::atomic<u32>, PQG_NUM_MEMBERS> m_results;
+
+private:
+  std::array<std::atomic<u32>, PQ_NUM_MEMBERS> m_completed_results{};
+  std::atomic<bool> m_completed_results_requested = false;
 };
 
 extern std::unique_ptr<PerfQueryBase> g_perf_query;
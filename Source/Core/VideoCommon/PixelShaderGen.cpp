@@ -5,6 +5,9 @@
 
 #include <cmath>
 #include <cstdio>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
@@ -326,8 +329,8 @@ void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& hos
   uid_data->bounding_box &= host_config.bounding_box & host_config.backend_bbox;
 }
 
-void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
-                                  const ShaderHostConfig& host_config, bool bounding_box)
+static void GeneratePixelShaderCommonHeader(ShaderCode& out, const ShaderHostConfig& host_config,
+                                            bool bounding_box)
 {
   // dot product for integer vectors
   out.Write("int idot(int3 x, int3 y)\n"
@@ -733,6 +736,29 @@ uint WrapCoord(int coord, uint wrap, int size) {{
   }
 }
 
+void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
+                                  const ShaderHostConfig& host_config, bool bounding_box)
+{
+  // The header is the same for every shader with the same host config, so it is only generated
+  // once. Shaders are generated on several threads at the same time.
+  using Key = std::tuple<APIType, u32, bool, bool, bool>;
+  static std::mutex s_mutex;
+  static std::map<Key, std::string> s_headers;
+
+  const Key key{api_type, host_config.bits, bounding_box,
+                g_ActiveConfig.backend_info.bSupportsTextureQueryLevels,
+                g_ActiveConfig.backend_info.bSupportsCoarseDerivatives};
+  std::lock_guard guard(s_mutex);
+  auto it = s_headers.find(key);
+  if (it == s_headers.end())
+  {
+    ShaderCode header;
+    GeneratePixelShaderCommonHeader(header, host_config, bounding_box);
+    it = s_headers.emplace(key, header.GetBuffer()).first;
+  }
+  out.WriteRaw(it->second);
+}
+
 static void WriteStage(ShaderCode& out, const pixel_shader_uid_data* uid_data, int n,
                        APIType api_type, bool stereo);
 static void WriteTevRegular(ShaderCode& out, std::string_view components, TevBias bias, TevOp op,
@@ -33,11 +33,15 @@
 #include "Common/Image.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/PerformanceTrace.h"
 #include "Common/Profiler.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
+#ifdef USE_AGENT_INTERFACE
+#include "Core/AgentInterface.h"
+#endif
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Config/NetplaySettings.h"
@@ -63,6 +67,7 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/FPSCounter.h"
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
@@ -90,6 +95,11 @@
 
 std::unique_ptr<Renderer> g_renderer;
 
+// Dynamic resolution changes are applied when at least this many lines of the EFB are cleared.
+constexpr int MIN_DYNAMIC_RESOLUTION_CLEAR_HEIGHT = 480;
+// Number of frames after which a dynamic resolution change is applied without a clear.
+constexpr u32 MAX_PENDING_EFB_SCALE_FRAMES = 60;
+
 static float AspectToWidescreen(float aspect)
 {
   return aspect * ((16.0f / 9.0f) / (4.0f / 3.0f));
@@ -164,6 +174,9 @@ void Renderer::Shutdown()
   // can require additional graphics sub-systems so it needs to be done first
   ShutdownFrameDumping();
   ShutdownImGui();
+  m_output_copy_pipeline.reset();
+  m_output_framebuffer.reset();
+  m_output_texture.reset();
   m_post_processor.reset();
   m_bounding_box.reset();
 }
@@ -367,6 +380,11 @@ unsigned int Renderer::GetEFBScale() const
   return m_efb_scale;
 }
 
+unsigned int Renderer::GetMaxEFBScale() const
+{
+  return m_max_efb_scale;
+}
+
 int Renderer::EFBToScaledX(int x) const
 {
   return x * static_cast<int>(m_efb_scale);
@@ -379,12 +397,12 @@ int Renderer::EFBToScaledY(int y) const
 
 float Renderer::EFBToScaledXf(float x) const
 {
-  return x * ((float)GetTargetWidth() / (float)EFB_WIDTH);
+  return x * static_cast<float>(m_efb_scale);
 }
 
 float Renderer::EFBToScaledYf(float y) const
 {
-  return y * ((float)GetTargetHeight() / (float)EFB_HEIGHT);
+  return y * static_cast<float>(m_efb_scale);
 }
 
 std::tuple<int, int> Renderer::CalculateTargetScale(int x, int y) const
@@ -400,22 +418,37 @@ bool Renderer::CalculateTargetSize()
     // Set a scale based on the window size
     int width = EFB_WIDTH * m_target_rectangle.GetWidth() / m_last_xfb_width;
     int height = EFB_HEIGHT * m_target_rectangle.GetHeight() / m_last_xfb_height;
-    m_efb_scale = std::max((width - 1) / EFB_WIDTH + 1, (height - 1) / EFB_HEIGHT + 1);
+    m_max_efb_scale = std::max((width - 1) / EFB_WIDTH + 1, (height - 1) / EFB_HEIGHT + 1);
   }
   else
   {
-    m_efb_scale = g_ActiveConfig.iEFBScale;
+    m_max_efb_scale = g_ActiveConfig.iEFBScale;
   }
 
   const u32 max_size = g_ActiveConfig.backend_info.MaxTextureSize;
-  if (max_size < EFB_WIDTH * m_efb_scale)
-    m_efb_scale = max_size / EFB_WIDTH;
+  if (max_size < EFB_WIDTH * m_max_efb_scale)
+    m_max_efb_scale = max_size / EFB_WIDTH;
 
-  auto [new_efb_width, new_efb_height] = CalculateTargetScale(EFB_WIDTH, EFB_HEIGHT);
-  new_efb_width = std::max(new_efb_width, 1);
-  new_efb_height = std::max(new_efb_height, 1);
+  // The configured scale is the upper bound of dynamic resolution, so restart from it whenever the
+  // range changes.
+  const unsigned int min_efb_scale =
+      g_ActiveConfig.bDynamicResolution ?
+          static_cast<unsigned int>(std::max(g_ActiveConfig.iDynamicResolutionMinScale, 1)) :
+          m_max_efb_scale;
+  const unsigned int old_efb_scale = m_efb_scale;
+  if (m_dynamic_resolution.GetMaxScale() != m_max_efb_scale ||
+      m_dynamic_resolution.GetMinScale() != std::min(min_efb_scale, m_max_efb_scale))
+  {
+    m_dynamic_resolution.Reset(min_efb_scale, m_max_efb_scale);
+    m_efb_scale = m_max_efb_scale;
+    m_pending_efb_scale = 0;
+  }
+
+  const int new_efb_width = std::max(static_cast<int>(EFB_WIDTH * m_max_efb_scale), 1);
+  const int new_efb_height = std::max(static_cast<int>(EFB_HEIGHT * m_max_efb_scale), 1);
 
-  if (new_efb_width != m_target_width || new_efb_height != m_target_height)
+  if (new_efb_width != m_target_width || new_efb_height != m_target_height ||
+      m_efb_scale != old_efb_scale)
   {
     m_target_width = new_efb_width;
     m_target_height = new_efb_height;
@@ -425,6 +458,75 @@ bool Renderer::CalculateTargetSize()
   return false;
 }
 
+void Renderer::UpdateDynamicResolution(u64 ticks)
+{
+  const u64 emulated_ticks = ticks - m_dynamic_resolution_last_ticks;
+  m_dynamic_resolution_last_ticks = ticks;
+
+  const float emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
+  if (!g_ActiveConfig.bDynamicResolution || emulation_speed <= 0.0f ||
+      Core::GetIsThrottlerTempDisabled() || m_max_efb_scale <= 1)
+  {
+    return;
+  }
+
+  // The time which is available for the frame is the emulated time between this frame and the
+  // last one. Frames which take longer than that fall behind, and are eventually dropped.
+  const u64 target_time_us = static_cast<u64>(
+      emulated_ticks * 1000000.0 / SystemTimers::GetTicksPerSecond() / emulation_speed);
+  const u64 frame_time_us = static_cast<u64>(m_fps_counter.GetDeltaTime() * 1000000.0);
+  if (target_time_us == 0 || target_time_us > 1000000)
+    return;
+
+  const unsigned int scale = m_dynamic_resolution.Update(frame_time_us, target_time_us);
+  if (scale == m_efb_scale)
+  {
+    m_pending_efb_scale = 0;
+    return;
+  }
+
+  if (m_pending_efb_scale != scale)
+  {
+    m_pending_efb_scale = scale;
+    m_pending_efb_scale_frames = 0;
+  }
+
+  // Don't wait forever for games which never clear the whole frame, at the cost of a frame
+  // which mixes the scales.
+  if (++m_pending_efb_scale_frames > MAX_PENDING_EFB_SCALE_FRAMES)
+    SetDynamicEFBScale(m_pending_efb_scale);
+}
+
+void Renderer::OnEFBClear(const MathUtil::Rectangle<int>& rc, bool color_enable,
+                          bool alpha_enable, bool z_enable)
+{
+  if (m_pending_efb_scale == 0)
+    return;
+
+  // Games often don't clear the lines below the visible area of the EFB, which aren't shown.
+  const bool whole_frame = rc.left <= 0 && rc.top <= 0 && rc.right >= static_cast<int>(EFB_WIDTH) &&
+                           rc.bottom >= MIN_DYNAMIC_RESOLUTION_CLEAR_HEIGHT;
+  if (whole_frame && color_enable && z_enable && (alpha_enable || !EFBHasAlphaChannel()))
+    SetDynamicEFBScale(m_pending_efb_scale);
+}
+
+void Renderer::SetDynamicEFBScale(unsigned int scale)
+{
+  m_pending_efb_scale = 0;
+  if (scale == m_efb_scale)
+    return;
+
+  // Pokes and peeks are in the old scale.
+  g_framebuffer_manager->FlushEFBPokes();
+  g_framebuffer_manager->InvalidatePeekCache(true);
+
+  m_efb_scale = scale;
+  PixelShaderManager::SetEfbScaleChanged(EFBToScaledXf(1), EFBToScaledYf(1));
+  PixelShaderManager::SetViewportChanged();
+  VertexShaderManager::SetViewportChanged();
+  BPFunctions::SetScissorAndViewport();
+}
+
 std::tuple<MathUtil::Rectangle<int>, MathUtil::Rectangle<int>>
 Renderer::ConvertStereoRectangle(const MathUtil::Rectangle<int>& rc) const
 {
@@ -586,6 +688,13 @@ void Renderer::CheckForConfigChanges()
   }
 }
 
+static bool IsMovieWindowShown()
+{
+  return Config::Get(Config::MAIN_SHOW_FRAME_COUNT) || Config::Get(Config::MAIN_SHOW_LAG) ||
+         Config::Get(Config::MAIN_MOVIE_SHOW_INPUT_DISPLAY) ||
+         Config::Get(Config::MAIN_MOVIE_SHOW_RTC) || Config::Get(Config::MAIN_MOVIE_SHOW_RERECORD);
+}
+
 // Create On-Screen-Messages
 void Renderer::DrawDebugText()
 {
@@ -608,11 +717,7 @@ void Renderer::DrawDebugText()
     ImGui::End();
   }
 
-  const bool show_movie_window =
-      Config::Get(Config::MAIN_SHOW_FRAME_COUNT) || Config::Get(Config::MAIN_SHOW_LAG) ||
-      Config::Get(Config::MAIN_MOVIE_SHOW_INPUT_DISPLAY) ||
-      Config::Get(Config::MAIN_MOVIE_SHOW_RTC) || Config::Get(Config::MAIN_MOVIE_SHOW_RERECORD);
-  if (show_movie_window)
+  if (IsMovieWindowShown())
   {
     // Position under the FPS display.
     ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - (10.0f * m_backbuffer_scale),
@@ -663,7 +768,8 @@ void Renderer::DrawDebugText()
     g_stats.DisplayScissor();
 
   const std::string profile_output = Common::Profiler::ToString();
-  if (!profile_output.empty())
+  m_showed_profile_output = !profile_output.empty();
+  if (m_showed_profile_output)
     ImGui::TextUnformatted(profile_output.c_str());
 }
 
@@ -1153,12 +1259,87 @@ void Renderer::BeginImGuiFrame()
   ImGui::NewFrame();
 }
 
-void Renderer::DrawImGui()
+void Renderer::RenderImGui()
 {
+  ImGui::Render();
+
+  // The geometry of all draw lists is kept in one buffer, so that it can be drawn again in frames
+  // in which the UI isn't rebuilt, and uploaded at once.
+  m_imgui_vertices.clear();
+  m_imgui_indices.clear();
+  m_imgui_draws.clear();
+
   ImDrawData* draw_data = ImGui::GetDrawData();
   if (!draw_data)
     return;
 
+  static_assert(sizeof(ImDrawIdx) == sizeof(u16));
+  for (int i = 0; i < draw_data->CmdListsCount; i++)
+  {
+    const ImDrawList* cmdlist = draw_data->CmdLists[i];
+    if (cmdlist->VtxBuffer.empty() || cmdlist->IdxBuffer.empty())
+      continue;
+
+    const u32 base_vertex = static_cast<u32>(m_imgui_vertices.size() / sizeof(ImDrawVert));
+    const u32 base_index = static_cast<u32>(m_imgui_indices.size());
+    const u8* vertices = reinterpret_cast<const u8*>(cmdlist->VtxBuffer.Data);
+    m_imgui_vertices.insert(m_imgui_vertices.end(), vertices,
+                            vertices + cmdlist->VtxBuffer.size_in_bytes());
+    m_imgui_indices.insert(m_imgui_indices.end(), cmdlist->IdxBuffer.begin(),
+                           cmdlist->IdxBuffer.end());
+
+    for (const ImDrawCmd& cmd : cmdlist->CmdBuffer)
+    {
+      // None of our windows use callbacks.
+      if (cmd.UserCallback)
+        continue;
+
+      m_imgui_draws.push_back(
+          {MathUtil::Rectangle<int>(
+               static_cast<int>(cmd.ClipRect.x), static_cast<int>(cmd.ClipRect.y),
+               static_cast<int>(cmd.ClipRect.z), static_cast<int>(cmd.ClipRect.w)),
+           reinterpret_cast<const AbstractTexture*>(cmd.TextureId), base_index + cmd.IdxOffset,
+           cmd.ElemCount, base_vertex + cmd.VtxOffset});
+    }
+  }
+}
+
+bool Renderer::ShouldRebuildImGuiFrame()
+{
+  ImGuiFrameState state;
+  state.interactive = (g_ActiveConfig.bShowNetPlayMessages && g_netplay_chat_ui) ||
+                      (Config::Get(Config::NETPLAY_GOLF_MODE_OVERLAY) && g_netplay_golf_ui);
+  state.dynamic = g_ActiveConfig.bOverlayStats || g_ActiveConfig.bOverlayProjStats ||
+                  g_ActiveConfig.bOverlayScissorStats || IsMovieWindowShown() ||
+                  m_showed_profile_output;
+  state.fps = g_ActiveConfig.bShowFPS ? m_fps_counter.GetFPS() : -1.0f;
+  state.width = m_backbuffer_width;
+  state.height = m_backbuffer_height;
+
+  const u64 current_time_us = Common::Timer::NowUs();
+  const u64 interval_us =
+      static_cast<u64>(std::max(g_ActiveConfig.iOverlayUpdateIntervalMs, 0)) * 1000;
+  const bool same_size = m_imgui_last_state && m_imgui_last_state->width == state.width &&
+                         m_imgui_last_state->height == state.height;
+  if (!state.interactive && same_size &&
+      current_time_us - m_imgui_last_build_time < interval_us)
+  {
+    return false;
+  }
+
+  if (!state.interactive && !state.dynamic && m_imgui_last_state == state && !OSD::NeedsRedraw())
+    return false;
+
+  m_imgui_last_state = state;
+  m_imgui_last_build_time = current_time_us;
+  return true;
+}
+
+void Renderer::DrawImGui()
+{
+  if (m_imgui_draws.empty())
+    return;
+
   SetViewport(0.0f, 0.0f, static_cast<float>(m_backbuffer_width),
               static_cast<float>(m_backbuffer_height), 0.0f, 1.0f);
 
@@ -1175,34 +1356,17 @@ void Renderer::DrawImGui()
   SetSamplerState(0, RenderState::GetPointSamplerState());
   g_vertex_manager->UploadUtilityUniforms(&ubo, sizeof(ubo));
 
-  for (int i = 0; i < draw_data->CmdListsCount; i++)
-  {
-    const ImDrawList* cmdlist = draw_data->CmdLists[i];
-    if (cmdlist->VtxBuffer.empty() || cmdlist->IdxBuffer.empty())
-      return;
-
-    u32 base_vertex, base_index;
-    g_vertex_manager->UploadUtilityVertices(cmdlist->VtxBuffer.Data, sizeof(ImDrawVert),
-                                            cmdlist->VtxBuffer.Size, cmdlist->IdxBuffer.Data,
-                                            cmdlist->IdxBuffer.Size, &base_vertex, &base_index);
+  u32 base_vertex, base_index;
+  g_vertex_manager->UploadUtilityVertices(
+      m_imgui_vertices.data(), sizeof(ImDrawVert),
+      static_cast<u32>(m_imgui_vertices.size() / sizeof(ImDrawVert)), m_imgui_indices.data(),
+      static_cast<u32>(m_imgui_indices.size()), &base_vertex, &base_index);
 
-    for (const ImDrawCmd& cmd : cmdlist->CmdBuffer)
-    {
-      if (cmd.UserCallback)
-      {
-        cmd.UserCallback(cmdlist, &cmd);
-        continue;
-      }
-
-      SetScissorRect(ConvertFramebufferRectangle(
-          MathUtil::Rectangle<int>(
-              static_cast<int>(cmd.ClipRect.x), static_cast<int>(cmd.ClipRect.y),
-              static_cast<int>(cmd.ClipRect.z), static_cast<int>(cmd.ClipRect.w)),
-          m_current_framebuffer));
-      SetTexture(0, reinterpret_cast<const AbstractTexture*>(cmd.TextureId));
-      DrawIndexed(base_index, cmd.ElemCount, base_vertex);
-      base_index += cmd.ElemCount;
-    }
+  for (const ImGuiDraw& draw : m_imgui_draws)
+  {
+    SetScissorRect(ConvertFramebufferRectangle(draw.clip_rect, m_current_framebuffer));
+    SetTexture(0, draw.texture);
+    DrawIndexed(base_index + draw.base_index, draw.num_indices, base_vertex + draw.base_vertex);
   }
 
   // Some capture software (such as OBS) hooks SwapBuffers and uses glBlitFramebuffer to copy our
@@ -1242,7 +1406,10 @@ void Renderer::EndUIFrame()
 {
   {
     auto lock = GetImGuiLock();
-    ImGui::Render();
+    RenderImGui();
+
+    // The next frame in Swap has to replace this UI.
+    m_imgui_last_state.reset();
   }
 
   if (!IsHeadless())
@@ -1336,10 +1503,10 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
       m_is_game_widescreen = true;
   }
 
-  // Ensure the last frame was written to the dump.
-  // This is required even if frame dumping has stopped, since the frame dump is one frame
-  // behind the renderer.
-  FlushFrameDump();
+  // Ensure the frames read back earlier are written to the dump.
+  // This is required even if frame dumping has stopped, since the frame dump is behind the
+  // renderer.
+  FlushFrameDump(false);
 
   if (g_ActiveConfig.bGraphicMods)
   {
@@ -1350,52 +1517,86 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
 
   if (xfb_addr && fb_width && fb_stride && fb_height)
   {
+    // When skipping presentation, the XFB isn't even looked up, and every swap counts as a new
+    // frame. Everything the game can observe, such as EFB copies, still happens as usual.
+    const bool skip_presentation = g_ActiveConfig.bSkipPresentation;
+
     // Get the current XFB from texture cache
     MathUtil::Rectangle<int> xfb_rect;
-    const auto* xfb_entry =
-        g_texture_cache->GetXFBTexture(xfb_addr, fb_width, fb_height, fb_stride, &xfb_rect);
-    if (xfb_entry &&
-        (!g_ActiveConfig.bSkipPresentingDuplicateXFBs || xfb_entry->id != m_last_xfb_id))
+    const TextureCacheBase::TCacheEntry* xfb_entry = nullptr;
+    if (!skip_presentation)
     {
-      const bool is_duplicate_frame = xfb_entry->id == m_last_xfb_id;
-      m_last_xfb_id = xfb_entry->id;
+      xfb_entry =
+          g_texture_cache->GetXFBTexture(xfb_addr, fb_width, fb_height, fb_stride, &xfb_rect);
+    }
+    if (skip_presentation ||
+        (xfb_entry &&
+         (!g_ActiveConfig.bSkipPresentingDuplicateXFBs || xfb_entry->id != m_last_xfb_id)))
+    {
+      const bool is_duplicate_frame = xfb_entry && xfb_entry->id == m_last_xfb_id;
+      if (xfb_entry)
+        m_last_xfb_id = xfb_entry->id;
 
       // Since we use the common pipelines here and draw vertices if a batch is currently being
       // built by the vertex loader, we end up trampling over its pointer, as we share the buffer
       // with the loader, and it has not been unmapped yet. Force a pipeline flush to avoid this.
       g_vertex_manager->Flush();
 
-      // Render any UI elements to the draw list.
+      // Render any UI elements to the draw list. If the UI isn't rebuilt, the ImGui frame stays
+      // open, and the geometry of the last one is drawn again.
+      const bool rebuild_ui = ShouldRebuildImGuiFrame();
+      if (rebuild_ui)
       {
         auto lock = GetImGuiLock();
 
         DrawDebugText();
         OSD::DrawMessages();
-        ImGui::Render();
+        RenderImGui();
       }
 
       // Render the XFB to the screen.
       BeginUtilityDrawing();
-      if (!IsHeadless())
+      if (!IsHeadless() && !skip_presentation)
       {
-        BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
-
         if (!is_duplicate_frame)
           UpdateWidescreenHeuristic();
 
-        UpdateDrawRectangle();
+        // With async post-processing, the post-processing is submitted to the GPU before the
+        // backbuffer is acquired, so that it doesn't have to wait for the previous frame to be
+        // presented, and overlaps with the next frame being queued.
+        bool post_processed = false;
+        if (g_ActiveConfig.bAsyncPostProcessing &&
+            g_ActiveConfig.stereo_mode != StereoMode::QuadBuffer)
+        {
+          post_processed = PostProcessToOutputTexture(xfb_entry->texture.get(), xfb_rect);
+          if (post_processed)
+            Flush();
+        }
+
+        BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
 
-        // Adjust the source rectangle instead of using an oversized viewport to render the XFB.
-        auto render_target_rc = GetTargetRectangle();
-        auto render_source_rc = xfb_rect;
-        AdjustRectanglesToFitBounds(&render_target_rc, &render_source_rc, m_backbuffer_width,
-                                    m_backbuffer_height);
-        RenderXFBToScreen(render_target_rc, xfb_entry->texture.get(), render_source_rc);
+        if (post_processed)
+        {
+          CopyOutputTextureToBackbuffer();
+        }
+        else
+        {
+          UpdateDrawRectangle();
+
+          // Adjust the source rectangle instead of using an oversized viewport to render the XFB.
+          auto render_target_rc = GetTargetRectangle();
+          auto render_source_rc = xfb_rect;
+          AdjustRectanglesToFitBounds(&render_target_rc, &render_source_rc, m_backbuffer_width,
+                                      m_backbuffer_height);
+          RenderXFBToScreen(render_target_rc, xfb_entry->texture.get(), render_source_rc);
+        }
 
         DrawImGui();
 
         // Present to the window system.
         {
+          Common::PerformanceTrace::ScopedStage stage(
+              Common::PerformanceTrace::Stage::PresentWait);
           std::lock_guard<std::mutex> guard(m_swap_mutex);
           PresentBackbuffer();
         }
@@ -1413,19 +1614,24 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         perf_sample.speed_ratio = SystemTimers::GetEstimatedEmulationPerformance();
         perf_sample.num_prims = g_stats.this_frame.num_prims + g_stats.this_frame.num_dl_prims;
         perf_sample.num_draw_calls = g_stats.this_frame.num_draw_calls;
+        perf_sample.sync_gpu_distance = Fifo::GetSyncGPUStats().max_distance;
         DolphinAnalytics::Instance().ReportPerformanceInfo(std::move(perf_sample));
 
-        if (IsFrameDumping())
+        if (IsFrameDumping() && xfb_entry)
           DumpCurrentFrame(xfb_entry->texture.get(), xfb_rect, ticks, m_frame_count);
 
+        UpdateDynamicResolution(ticks);
+
         // Begin new frame
+        Common::PerformanceTrace::RecordFrame(m_frame_count);
         m_frame_count++;
         g_stats.ResetFrame();
       }
 
       g_shader_cache->RetrieveAsyncShaders();
       g_vertex_manager->OnEndFrame();
-      BeginImGuiFrame();
+      if (rebuild_ui)
+        BeginImGuiFrame();
 
       // We invalidate the pipeline object at the start of the frame.
       // This is for the rare case where only a single pipeline configuration is used,
@@ -1499,6 +1705,77 @@ void Renderer::RenderXFBToScreen(const MathUtil::Rectangle<int>& target_rc,
   }
 }
 
+bool Renderer::PostProcessToOutputTexture(const AbstractTexture* source_texture,
+                                          const MathUtil::Rectangle<int>& source_rc)
+{
+  // The backbuffer size is that of the last frame, as host window resizes are only handled once the
+  // backbuffer is bound, so the frame after a resize is stretched to the new size.
+  if (m_backbuffer_width <= 0 || m_backbuffer_height <= 0)
+    return false;
+
+  const u32 width = static_cast<u32>(m_backbuffer_width);
+  const u32 height = static_cast<u32>(m_backbuffer_height);
+  if (!m_output_texture || m_output_texture->GetWidth() != width ||
+      m_output_texture->GetHeight() != height ||
+      m_output_texture->GetFormat() != m_backbuffer_format)
+  {
+    m_output_framebuffer.reset();
+    m_output_texture = CreateTexture(TextureConfig(width, height, 1, 1, 1, m_backbuffer_format,
+                                                   AbstractTextureFlag_RenderTarget),
+                                     "Post-processing output texture");
+    if (m_output_texture)
+      m_output_framebuffer = CreateFramebuffer(m_output_texture.get(), nullptr);
+    if (!m_output_framebuffer)
+    {
+      m_output_texture.reset();
+      return false;
+    }
+  }
+
+  if (!m_output_copy_pipeline || m_output_copy_format != m_backbuffer_format)
+  {
+    AbstractPipelineConfig config = {};
+    config.vertex_shader = g_shader_cache->GetTextureCopyVertexShader();
+    config.pixel_shader = g_shader_cache->GetTextureCopyPixelShader();
+    config.rasterization_state = RenderState::GetNoCullRasterizationState(PrimitiveType::Triangles);
+    config.depth_state = RenderState::GetNoDepthTestingDepthState();
+    config.blending_state = RenderState::GetNoBlendingBlendState();
+    config.framebuffer_state = RenderState::GetColorFramebufferState(m_backbuffer_format);
+    config.usage = AbstractPipelineUsage::Utility;
+    m_output_copy_pipeline = CreatePipeline(config);
+    m_output_copy_format = m_backbuffer_format;
+    if (!m_output_copy_pipeline)
+      return false;
+  }
+
+  SetAndClearFramebuffer(m_output_framebuffer.get(), {{0.0f, 0.0f, 0.0f, 1.0f}});
+  UpdateDrawRectangle();
+
+  // Adjust the source rectangle instead of using an oversized viewport to render the XFB.
+  auto render_target_rc = GetTargetRectangle();
+  auto render_source_rc = source_rc;
+  AdjustRectanglesToFitBounds(&render_target_rc, &render_source_rc, m_backbuffer_width,
+                              m_backbuffer_height);
+  RenderXFBToScreen(render_target_rc, source_texture, render_source_rc);
+  return true;
+}
+
+void Renderer::CopyOutputTextureToBackbuffer()
+{
+  struct Uniforms
+  {
+    float src_left, src_top, src_width, src_height;
+  };
+  const Uniforms uniforms = {0.0f, 0.0f, 1.0f, 1.0f};
+  g_vertex_manager->UploadUtilityUniforms(&uniforms, sizeof(uniforms));
+
+  SetViewportAndScissor(MathUtil::Rectangle<int>(0, 0, m_backbuffer_width, m_backbuffer_height));
+  SetPipeline(m_output_copy_pipeline.get());
+  SetTexture(0, m_output_texture.get());
+  SetSamplerState(0, RenderState::GetLinearSamplerState());
+  Draw(0, 3);
+}
+
 bool Renderer::IsFrameDumping() const
 {
   if (m_screenshot_request.IsSet())
@@ -1507,6 +1784,11 @@ bool Renderer::IsFrameDumping() const
   if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
     return true;
 
+#ifdef USE_AGENT_INTERFACE
+  if (AgentInterface::WantsFrames())
+    return true;
+#endif
+
   return false;
 }
 
@@ -1541,13 +1823,17 @@ void Renderer::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  // The dump thread may still be encoding the frame which was last read back to this buffer.
+  FrameDumpBuffer& buffer = m_frame_dump_buffers[m_frame_dump_buffer_index];
+  FinishFrameData(buffer);
+  if (!CheckFrameDumpReadbackTexture(buffer, target_width, target_height))
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_frame_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  buffer.readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
+                                           buffer.readback_texture->GetRect());
+  buffer.state = m_frame_dump.FetchState(ticks, frame_number);
+  m_frame_dump_buffer_index = (m_frame_dump_buffer_index + 1) % NUM_FRAME_DUMP_BUFFERS;
+  m_frame_dump_pending_readbacks++;
 }
 
 bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -1577,9 +1863,10 @@ bool Renderer::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
   return true;
 }
 
-bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool Renderer::CheckFrameDumpReadbackTexture(FrameDumpBuffer& buffer, u32 target_width,
+                                             u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  std::unique_ptr<AbstractStagingTexture>& rbtex = buffer.readback_texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -1593,30 +1880,34 @@ bool Renderer::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height
   return true;
 }
 
-void Renderer::FlushFrameDump()
+void Renderer::FlushFrameDump(bool flush_all)
 {
-  if (!m_frame_dump_needs_flush)
+  if (m_frame_dump_pending_readbacks == 0)
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
-
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  // Screenshots shouldn't wait for later frames.
+  bool is_continuous = Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES);
+#ifdef USE_AGENT_INTERFACE
+  is_continuous |= AgentInterface::WantsFrames();
+#endif
+  const u32 readbacks_in_flight =
+      (!flush_all && is_continuous) ? FRAME_DUMP_READBACK_LATENCY - 1 : 0;
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
+  // Queue encoding of the oldest frames dumped.
+  while (m_frame_dump_pending_readbacks > readbacks_in_flight)
   {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
-  else
-  {
-    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
-  }
+    const u32 index = (m_frame_dump_buffer_index + NUM_FRAME_DUMP_BUFFERS -
+                       m_frame_dump_pending_readbacks) %
+                      NUM_FRAME_DUMP_BUFFERS;
+    m_frame_dump_pending_readbacks--;
 
-  m_frame_dump_needs_flush = false;
+    FrameDumpBuffer& buffer = m_frame_dump_buffers[index];
+    buffer.readback_texture->Flush();
+    if (buffer.readback_texture->Map())
+      DumpFrameData(buffer);
+    else
+      ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+  }
 
   // Shutdown frame dumping if it is no longer active.
   if (!IsFrameDumping())
@@ -1625,13 +1916,13 @@ void Renderer::FlushFrameDump()
 
 void Renderer::ShutdownFrameDumping()
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
+  // Ensure the queued readbacks have been sent to the encoder.
+  FlushFrameDump(true);
 
   if (!m_frame_dump_thread_running.IsSet())
     return;
 
-  // Ensure previous frame has been encoded.
+  // Ensure previous frames have been encoded.
   FinishFrameData();
 
   // Wake thread up, and wait for it to exit.
@@ -1642,13 +1933,21 @@ void Renderer::ShutdownFrameDumping()
   m_frame_dump_render_framebuffer.reset();
   m_frame_dump_render_texture.reset();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  for (FrameDumpBuffer& buffer : m_frame_dump_buffers)
+    buffer.readback_texture.reset();
 }
 
-void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
+void Renderer::DumpFrameData(FrameDumpBuffer& buffer)
 {
-  m_frame_dump_data = FrameDump::FrameData{data, w, h, stride, m_last_frame_state};
+  const AbstractStagingTexture* texture = buffer.readback_texture.get();
+  {
+    std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+    m_frame_dump_queue.push_back(FrameDump::FrameData{
+        reinterpret_cast<const u8*>(texture->GetMappedPointer()),
+        static_cast<int>(texture->GetConfig().width), static_cast<int>(texture->GetConfig().height),
+        static_cast<int>(texture->GetMappedStride()), buffer.state});
+    buffer.queued_frame = ++m_frame_dump_frames_queued;
+  }
 
   if (!m_frame_dump_thread_running.IsSet())
   {
@@ -1660,18 +1959,35 @@ void Renderer::DumpFrameData(const u8* data, int w, int h, int stride)
 
   // Wake worker thread up.
   m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
 }
 
-void Renderer::FinishFrameData()
+void Renderer::FinishFrameData(FrameDumpBuffer& buffer)
 {
-  if (!m_frame_dump_frame_running)
+  if (buffer.queued_frame == 0)
     return;
 
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  while (true)
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+      if (m_frame_dump_frames_done >= buffer.queued_frame)
+        break;
+    }
+    m_frame_dump_done.Wait();
+  }
+  buffer.queued_frame = 0;
 
-  m_frame_dump_output_texture->Unmap();
+  buffer.readback_texture->Unmap();
+}
+
+void Renderer::FinishFrameData()
+{
+  // Frames are encoded in the order they were queued in.
+  for (u32 i = 0; i < NUM_FRAME_DUMP_BUFFERS; i++)
+  {
+    const u32 index = (m_frame_dump_buffer_index + i) % NUM_FRAME_DUMP_BUFFERS;
+    FinishFrameData(m_frame_dump_buffers[index]);
+  }
 }
 
 void Renderer::FrameDumpThreadFunc()
@@ -1697,46 +2013,65 @@ void Renderer::FrameDumpThreadFunc()
     if (!m_frame_dump_thread_running.IsSet())
       break;
 
-    auto frame = m_frame_dump_data;
-
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    while (true)
     {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
+      FrameDump::FrameData frame;
+      {
+        std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+        if (m_frame_dump_queue.empty())
+          break;
+        frame = m_frame_dump_queue.front();
+        m_frame_dump_queue.pop_front();
+      }
 
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+      // Save screenshot
+      if (m_screenshot_request.TestAndClear())
+      {
+        std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
+        if (DumpFrameToPNG(frame, m_screenshot_name))
+          OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
 
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
-    {
-      if (!frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
+        // Reset settings
+        m_screenshot_name.clear();
+        m_screenshot_completed.Set();
+      }
 
-        // Stop frame dumping if we fail to start.
+      if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+      {
         if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+        {
+          if (dump_to_ffmpeg)
+            frame_dump_started = StartFrameDumpToFFMPEG(frame);
+          else
+            frame_dump_started = StartFrameDumpToImage(frame);
+
+          // Stop frame dumping if we fail to start.
+          if (!frame_dump_started)
+            Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+        }
+
+        // If we failed to start frame dumping, don't write a frame.
+        if (frame_dump_started)
+        {
+          if (dump_to_ffmpeg)
+            DumpFrameToFFMPEG(frame);
+          else
+            DumpFrameToImage(frame);
+        }
       }
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
+#ifdef USE_AGENT_INTERFACE
+      AgentInterface::PublishFrame(frame.data, frame.width, frame.height, frame.stride,
+                                   frame.state.ticks, frame.state.frame_number);
+#endif
+
       {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
+        std::lock_guard<std::mutex> lk(m_frame_dump_lock);
+        m_frame_dump_frames_done++;
       }
+      m_frame_dump_done.Set();
     }
-
-    m_frame_dump_done.Set();
   }
 
   if (frame_dump_started)
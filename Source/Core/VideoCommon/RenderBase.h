@@ -14,8 +14,10 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -28,6 +30,7 @@
 #include "Common/MathUtil.h"
 #include "VideoCommon/AsyncShaderCompiler.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/DynamicResolution.h"
 #include "VideoCommon/FPSCounter.h"
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
@@ -82,6 +85,12 @@ public:
   virtual void Shutdown();
 
   virtual void SetPipeline(const AbstractPipeline* pipeline) {}
+  // Only called when backend_info.bSupportsDynamicDepthAndCullState is set, after SetPipeline()
+  // with a GX pipeline, whose depth and cull state is then ignored.
+  virtual void SetDynamicDepthAndCullState(const RasterizationState& rasterization_state,
+                                           const DepthState& depth_state)
+  {
+  }
   virtual void SetScissorRect(const MathUtil::Rectangle<int>& rc) {}
   virtual void SetTexture(u32 index, const AbstractTexture* texture) {}
   virtual void SetSamplerState(u32 index, const SamplerState& state) {}
@@ -193,6 +202,14 @@ public:
   ConvertStereoRectangle(const MathUtil::Rectangle<int>& rc) const;
 
   unsigned int GetEFBScale() const;
+  // The scale the EFB is allocated for. With dynamic resolution, the EFB is rendered at a lower
+  // scale to the top-left part of it.
+  unsigned int GetMaxEFBScale() const;
+
+  // Called before the EFB is cleared, to apply a pending dynamic resolution change once the whole
+  // frame is overwritten.
+  void OnEFBClear(const MathUtil::Rectangle<int>& rc, bool color_enable, bool alpha_enable,
+                  bool z_enable);
 
   // Use this to upscale native EFB coordinates to IDEAL internal resolution
   int EFBToScaledX(int x) const;
@@ -225,6 +242,16 @@ public:
   virtual void Flush() {}
   virtual void WaitForGPUIdle() {}
 
+  struct VideoMemoryInfo
+  {
+    u64 usage;
+    u64 budget;
+  };
+
+  // Returns how much video memory the process uses, and how much it can use before the driver
+  // starts paging it out, if the backend is able to query it.
+  virtual std::optional<VideoMemoryInfo> GetVideoMemoryInfo() const { return std::nullopt; }
+
   // Finish up the current frame, print some stats
   void Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks);
 
@@ -306,10 +333,25 @@ protected:
   // Destroys all ImGui GPU resources, must do before shutdown.
   void ShutdownImGui();
 
-  // Renders ImGui windows to the currently-bound framebuffer.
+  // Ends the ImGui frame, and keeps its geometry until the next call.
   // Should be called with the ImGui lock held.
+  void RenderImGui();
+
+  // Returns false if the UI would look the same as in the last frame built, or if it was built
+  // more recently than the configured overlay update interval allows, in which case its geometry
+  // is drawn again without building a new ImGui frame.
+  bool ShouldRebuildImGuiFrame();
+
+  // Renders the geometry of the last ImGui frame to the currently-bound framebuffer.
   void DrawImGui();
 
+  // Async post-processing: post-processes the XFB into an intermediate output texture before the
+  // backbuffer is acquired, and copies it to the backbuffer once it is. Returns false if the
+  // output texture couldn't be created, in which case the XFB has to be rendered directly.
+  bool PostProcessToOutputTexture(const AbstractTexture* source_texture,
+                                  const MathUtil::Rectangle<int>& source_rc);
+  void CopyOutputTextureToBackbuffer();
+
   virtual std::unique_ptr<BoundingBox> CreateBoundingBox() const = 0;
 
   AbstractFramebuffer* m_current_framebuffer = nullptr;
@@ -351,11 +393,52 @@ protected:
   std::mutex m_imgui_mutex;
   u64 m_imgui_last_frame_time;
 
+  // Geometry of the last ImGui frame.
+  struct ImGuiDraw
+  {
+    MathUtil::Rectangle<int> clip_rect;
+    const AbstractTexture* texture;
+    u32 base_index;
+    u32 num_indices;
+    u32 base_vertex;
+  };
+  std::vector<u8> m_imgui_vertices;
+  std::vector<u16> m_imgui_indices;
+  std::vector<ImGuiDraw> m_imgui_draws;
+
+  // What the last ImGui frame built in Swap depends on.
+  struct ImGuiFrameState
+  {
+    // Windows which take input, such as the netplay chat.
+    bool interactive;
+    // Windows which change nearly every frame, such as the statistics.
+    bool dynamic;
+    float fps;
+    int width;
+    int height;
+
+    bool operator==(const ImGuiFrameState&) const = default;
+  };
+  std::optional<ImGuiFrameState> m_imgui_last_state;
+  u64 m_imgui_last_build_time = 0;
+  bool m_showed_profile_output = false;
+
 private:
   std::tuple<int, int> CalculateOutputDimensions(int width, int height) const;
 
+  // Dynamic resolution: picks a new scale on every frame, which is applied at the next clear of
+  // the whole frame so that the EFB doesn't contain pixels rendered at different scales.
+  void UpdateDynamicResolution(u64 ticks);
+  void SetDynamicEFBScale(unsigned int scale);
+
   PixelFormat m_prev_efb_format = PixelFormat::INVALID_FMT;
   unsigned int m_efb_scale = 1;
+  unsigned int m_max_efb_scale = 1;
+
+  VideoCommon::DynamicResolution m_dynamic_resolution;
+  unsigned int m_pending_efb_scale = 0;
+  u32 m_pending_efb_scale_frames = 0;
+  u64 m_dynamic_resolution_last_ticks = 0;
 
   // These will be set on the first call to SetWindowSize.
   int m_last_window_request_width = 0;
@@ -372,23 +455,34 @@ private:
   // Set by frame dump thread on frame completion.
   Common::Event m_frame_dump_done;
 
-  // Holds emulation state during the last swap when dumping.
-  FrameDump::FrameState m_last_frame_state;
-
-  // Communication of frame between video and dump threads.
-  FrameDump::FrameData m_frame_dump_data;
+  // Communication of frames between video and dump threads, guarded by m_frame_dump_lock.
+  std::mutex m_frame_dump_lock;
+  std::deque<FrameDump::FrameData> m_frame_dump_queue;
+  u64 m_frame_dump_frames_queued = 0;
+  u64 m_frame_dump_frames_done = 0;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  // Frames are read back to a ring of staging textures. While dumping frames, a readback is only
+  // mapped FRAME_DUMP_READBACK_LATENCY frames later, so that the GPU has finished the copy by then,
+  // and the dump thread can encode the frames of the remaining buffers in the meantime.
+  static constexpr u32 NUM_FRAME_DUMP_BUFFERS = 4;
+  static constexpr u32 FRAME_DUMP_READBACK_LATENCY = 2;
+  struct FrameDumpBuffer
+  {
+    std::unique_ptr<AbstractStagingTexture> readback_texture;
+    // Holds emulation state during the swap which was read back.
+    FrameDump::FrameState state;
+    // Number of the queued frame while the dump thread uses the mapped texture, otherwise 0.
+    u64 queued_frame = 0;
+  };
+  std::array<FrameDumpBuffer, NUM_FRAME_DUMP_BUFFERS> m_frame_dump_buffers;
+  // Buffer which the next frame is read back to.
+  u32 m_frame_dump_buffer_index = 0;
+  // Number of frames before m_frame_dump_buffer_index which still need to be dumped.
+  u32 m_frame_dump_pending_readbacks = 0;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
@@ -401,6 +495,12 @@ private:
   u32 m_last_xfb_stride = 0;
   u32 m_last_xfb_height = 0;
 
+  // Output of async post-processing, sized to the backbuffer.
+  std::unique_ptr<AbstractTexture> m_output_texture;
+  std::unique_ptr<AbstractFramebuffer> m_output_framebuffer;
+  std::unique_ptr<AbstractPipeline> m_output_copy_pipeline;
+  AbstractTextureFormat m_output_copy_format = AbstractTextureFormat::Undefined;
+
   std::unique_ptr<BoundingBox> m_bounding_box;
 
   // Nintendo's SDK seems to write "default" bounding box values before every draw (1023 0 1023 0
@@ -431,18 +531,23 @@ private:
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Checks that the readback texture of the buffer exists and is the correct size.
+  bool CheckFrameDumpReadbackTexture(FrameDumpBuffer& buffer, u32 target_width,
+                                     u32 target_height);
 
   // Fills the frame dump staging texture with the current XFB texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect, u64 ticks, int frame_number);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Asynchronously encodes the mapped readback texture of the buffer to the frame dump.
+  void DumpFrameData(FrameDumpBuffer& buffer);
+
+  // Queues rendered frames for encoding. Unless flush_all is set, the most recent readbacks are
+  // left in flight while dumping frames.
+  void FlushFrameDump(bool flush_all);
 
-  // Ensures all rendered frames are queued for encoding.
-  void FlushFrameDump();
+  // Ensures the dump thread is done with the buffer, and unmaps it.
+  void FinishFrameData(FrameDumpBuffer& buffer);
 
   // Ensures all encoded frames have been written to the output file.
   void FinishFrameData();
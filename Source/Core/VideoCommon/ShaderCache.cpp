@@ -3,11 +3,17 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <fmt/format.h>
+#include <xxhash.h>
 
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/PerformanceTrace.h"
+#include "Common/Thread.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/DriverDetails.h"
@@ -80,12 +86,12 @@ void ShaderCache::Reload()
   if (!CompileSharedPipelines())
     PanicAlertFmt("Failed to compile shared pipelines after reload.");
 
-  if (g_ActiveConfig.bShaderCache)
-    LoadCaches();
-
   // Switch to the precompiling shader configuration while we rebuild.
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderPrecompilerThreads());
 
+  if (g_ActiveConfig.bShaderCache)
+    LoadCaches();
+
   // We don't need to explicitly recompile the individual ubershaders here, as the pipelines
   // UIDs are still be in the map. Therefore, when these are rebuilt, the shaders will also
   // be recompiled.
@@ -98,6 +104,7 @@ void ShaderCache::Reload()
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+  m_frame_count++;
 }
 
 void ShaderCache::Shutdown()
@@ -110,12 +117,33 @@ void ShaderCache::Shutdown()
   ClosePipelineUIDCache();
 }
 
-const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
+/// Clears the parts of the UID that the backend sets dynamically, so that pipelines which only
+/// differ in them share a cache entry.
+template <typename Uid>
+static Uid ApplyDynamicState(const Uid& in)
 {
+  Uid out;
+  memcpy(&out, &in, sizeof(out));  // copy padding
+  if (!g_ActiveConfig.backend_info.bSupportsDynamicDepthAndCullState)
+    return out;
+
+  out.rasterization_state.cullmode = CullMode::None;
+  out.depth_state.hex = 0;
+  // Keep depth writes enabled, so that ApplyDriverBugs() doesn't drop forced early depth testing
+  // from the pixel shader.
+  out.depth_state.updateenable = true;
+  return out;
+}
+
+const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid_in)
+{
+  const GXPipelineUid uid = ApplyDynamicState(uid_in);
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  Common::PerformanceTrace::ScopedStage stage(
+      Common::PerformanceTrace::Stage::ShaderCompileWait);
   const bool exists_in_cache = it != m_gx_pipeline_cache.end();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
@@ -126,8 +154,10 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
   return InsertGXPipeline(uid, std::move(pipeline));
 }
 
-std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& uid)
+std::optional<const AbstractPipeline*>
+ShaderCache::GetPipelineForUidAsync(const GXPipelineUid& uid_in)
 {
+  const GXPipelineUid uid = ApplyDynamicState(uid_in);
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end())
   {
@@ -143,12 +173,33 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
   return {};
 }
 
-const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineUid& uid)
+std::optional<const AbstractPipeline*>
+ShaderCache::GetUberPipelineForUidAsync(const GXUberPipelineUid& uid_in)
 {
+  const GXUberPipelineUid uid = ApplyDynamicState(uid_in);
+  auto it = m_gx_uber_pipeline_cache.find(uid);
+  if (it != m_gx_uber_pipeline_cache.end())
+  {
+    // .second is the pending flag, i.e. compiling in the background.
+    if (!it->second.second)
+      return it->second.first.get();
+    else
+      return {};
+  }
+
+  QueueUberPipelineCompile(uid, COMPILE_PRIORITY_PARTIAL_UBERSHADER_PIPELINE);
+  return {};
+}
+
+const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineUid& uid_in)
+{
+  const GXUberPipelineUid uid = ApplyDynamicState(uid_in);
   auto it = m_gx_uber_pipeline_cache.find(uid);
   if (it != m_gx_uber_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  Common::PerformanceTrace::ScopedStage stage(
+      Common::PerformanceTrace::Stage::ShaderCompileWait);
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
@@ -224,46 +275,116 @@ static void UnserializePipelineUid(const SerializedUidType& uid, UidType& real_u
   real_uid.blending_state.hex = uid.blending_state_bits;
 }
 
+template <typename K>
+void ShaderCache::DiskCache<K>::Discard()
+{
+  if (discarded)
+    return;
+
+  // Binaries which fail to load were most likely created by a different driver version. They
+  // would be created again and appended as duplicates, which adds up quickly when the cache is
+  // shared between games, so start over instead. Entries loaded so far stay in memory.
+  WARN_LOG_FMT(VIDEO, "Failed to load one or more entries from cache '{}'. Discarding.", filename);
+  this->Close();
+  File::Delete(filename);
+  this->Open(filename);
+  discarded = true;
+}
+
 template <ShaderStage stage, typename K, typename T>
 void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid)
 {
-  class CacheReader : public LinearDiskCacheReader<K, u8>
+  // Creating the shaders is left to the async compiler workers, so that the driver can process
+  // several binaries at once.
+  class ShaderLoadWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    CacheReader(T& cache_) : cache(cache_) {}
-    void Read(const K& key, const u8* value, u32 value_size)
+    ShaderLoadWorkItem(ShaderCache* shader_cache_, T& cache_, const K& key_, const u8* value,
+                       u32 value_size)
+        : shader_cache(shader_cache_), cache(cache_), key(key_), binary(value, value + value_size)
+    {
+    }
+
+    bool Compile() override
+    {
+      shader = g_renderer->CreateShaderFromBinary(stage, binary.data(), binary.size());
+      return true;
+    }
+
+    void Retrieve() override
     {
-      auto shader = g_renderer->CreateShaderFromBinary(stage, value, value_size);
-      if (shader)
+      shader_cache->m_pending_cache_loads--;
+
+      // The shader may have been compiled from source in the meantime, if a pipeline needed it
+      // before it was loaded.
+      auto iter = cache.shader_map.find(key);
+      if (iter == cache.shader_map.end() || iter->second.shader)
+        return;
+
+      if (!shader)
       {
-        auto& entry = cache.shader_map[key];
-        entry.shader = std::move(shader);
-        entry.pending = false;
+        // Compiled from source once a pipeline needs it.
+        cache.shader_map.erase(iter);
+        cache.disk_cache.Discard();
+        return;
+      }
 
-        switch (stage)
-        {
-        case ShaderStage::Vertex:
-          INCSTAT(g_stats.num_vertex_shaders_created);
-          INCSTAT(g_stats.num_vertex_shaders_alive);
-          break;
-        case ShaderStage::Pixel:
-          INCSTAT(g_stats.num_pixel_shaders_created);
-          INCSTAT(g_stats.num_pixel_shaders_alive);
-          break;
-        default:
-          break;
-        }
+      iter->second.shader = std::move(shader);
+      iter->second.pending = false;
+      switch (stage)
+      {
+      case ShaderStage::Vertex:
+        INCSTAT(g_stats.num_vertex_shaders_created);
+        INCSTAT(g_stats.num_vertex_shaders_alive);
+        break;
+      case ShaderStage::Pixel:
+        INCSTAT(g_stats.num_pixel_shaders_created);
+        INCSTAT(g_stats.num_pixel_shaders_alive);
+        break;
+      default:
+        break;
       }
     }
 
   private:
+    ShaderCache* shader_cache;
     T& cache;
+    K key;
+    std::vector<u8> binary;
+    std::unique_ptr<AbstractShader> shader;
   };
 
-  std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
-  CacheReader reader(cache);
-  u32 count = cache.disk_cache.OpenAndRead(filename, reader);
-  INFO_LOG_FMT(VIDEO, "Loaded {} cached shaders from {}", count, filename);
+  class CacheReader : public LinearDiskCacheReader<K, u8>
+  {
+  public:
+    CacheReader(ShaderCache* this_ptr_, T& cache_) : this_ptr(this_ptr_), cache(cache_) {}
+    void Read(const K& key, const u8* value, u32 value_size)
+    {
+      // Skip duplicates.
+      auto& entry = cache.shader_map[key];
+      if (entry.pending || entry.shader)
+        return;
+
+      // Pipelines wait for pending shaders rather than compiling them again.
+      entry.pending = true;
+      this_ptr->m_pending_cache_loads++;
+      auto wi = this_ptr->m_async_shader_compiler->CreateWorkItem<ShaderLoadWorkItem>(
+          this_ptr, cache, key, value, value_size);
+      this_ptr->m_async_shader_compiler->QueueWorkItem(std::move(wi),
+                                                       COMPILE_PRIORITY_CACHED_SHADER);
+      this_ptr->WaitForPendingCacheLoads(MAX_PENDING_CACHE_LOADS);
+    }
+
+  private:
+    ShaderCache* this_ptr;
+    T& cache;
+  };
+
+  cache.disk_cache.filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
+  cache.disk_cache.discarded = false;
+  CacheReader reader(this, cache);
+  const u32 count = cache.disk_cache.OpenAndRead(cache.disk_cache.filename, reader);
+  INFO_LOG_FMT(VIDEO, "Read {} cached shaders from {}", count, cache.disk_cache.filename);
 }
 
 template <typename T>
@@ -275,63 +396,38 @@ void ShaderCache::ClearShaderCache(T& cache)
 }
 
 template <typename KeyType, typename DiskKeyType, typename T>
-void ShaderCache::LoadPipelineCache(T& cache, LinearDiskCache<DiskKeyType, u8>& disk_cache,
+void ShaderCache::LoadPipelineCache(T& cache, DiskCache<DiskKeyType>& disk_cache,
                                     APIType api_type, const char* type, bool include_gameid)
 {
   class CacheReader : public LinearDiskCacheReader<DiskKeyType, u8>
   {
   public:
     CacheReader(ShaderCache* this_ptr_, T& cache_) : this_ptr(this_ptr_), cache(cache_) {}
-    bool AnyFailed() const { return failed; }
     void Read(const DiskKeyType& key, const u8* value, u32 value_size)
     {
       KeyType real_uid;
       UnserializePipelineUid(key, real_uid);
 
-      // Skip those which are already compiled.
-      if (failed || cache.find(real_uid) != cache.end())
+      // Skip duplicates.
+      if (cache.find(real_uid) != cache.end())
         return;
 
-      auto config = this_ptr->GetGXPipelineConfig(real_uid);
-      if (!config)
-        return;
-
-      auto pipeline = g_renderer->CreatePipeline(*config, value, value_size);
-      if (!pipeline)
-      {
-        // If any of the pipelines fail to create, consider the cache stale.
-        failed = true;
-        return;
-      }
-
-      auto& entry = cache[real_uid];
-      entry.first = std::move(pipeline);
-      entry.second = false;
+      // The pipelines are created by the async compiler once their shaders have loaded.
+      this_ptr->m_pending_cache_loads++;
+      this_ptr->QueueCachedPipeline(real_uid, std::vector<u8>(value, value + value_size));
+      this_ptr->WaitForPendingCacheLoads(MAX_PENDING_CACHE_LOADS);
     }
 
   private:
     ShaderCache* this_ptr;
     T& cache;
-    bool failed = false;
   };
 
-  std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
+  disk_cache.filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
+  disk_cache.discarded = false;
   CacheReader reader(this, cache);
-  const u32 count = disk_cache.OpenAndRead(filename, reader);
-  INFO_LOG_FMT(VIDEO, "Loaded {} cached pipelines from {}", count, filename);
-
-  // If any of the pipelines in the cache failed to create, it's likely because of a change of
-  // driver version, or system configuration. In this case, when the UID cache picks up the pipeline
-  // later on, we'll write a duplicate entry to the pipeline cache. There's also no point in keeping
-  // the old cache data around, so discard and recreate the disk cache.
-  if (reader.AnyFailed())
-  {
-    WARN_LOG_FMT(VIDEO, "Failed to load one or more pipelines from cache '{}'. Discarding.",
-                 filename);
-    disk_cache.Close();
-    File::Delete(filename);
-    disk_cache.OpenAndRead(filename, reader);
-  }
+  const u32 count = disk_cache.OpenAndRead(disk_cache.filename, reader);
+  INFO_LOG_FMT(VIDEO, "Read {} cached pipelines from {}", count, disk_cache.filename);
 }
 
 template <typename T, typename Y>
@@ -348,8 +444,22 @@ void ShaderCache::ClearPipelineCache(T& cache, Y& disk_cache)
   }
 }
 
+void ShaderCache::WaitForPendingCacheLoads(u32 max_pending)
+{
+  while (m_pending_cache_loads > max_pending)
+  {
+    m_async_shader_compiler->RetrieveWorkItems();
+    if (m_pending_cache_loads > max_pending)
+      Common::SleepCurrentThread(1);
+  }
+}
+
 void ShaderCache::LoadCaches()
 {
+  // Specialized shaders and pipelines are only keyed by their UIDs, so they can be shared between
+  // games. The UID cache stays per game, so only the shaders a game has used are precompiled.
+  const bool per_game = !g_ActiveConfig.bShareShaderCache;
+
   // Ubershader caches, if present.
   if (g_ActiveConfig.backend_info.bSupportsShaderBinaries)
   {
@@ -363,17 +473,18 @@ void ShaderCache::LoadCaches()
       LoadShaderCache<ShaderStage::Geometry, GeometryShaderUid>(m_gs_cache, m_api_type, "gs",
                                                                 false);
 
-    // Specialized shaders, gameid-specific.
+    // Specialized shaders, gameid-specific unless shared.
     LoadShaderCache<ShaderStage::Vertex, VertexShaderUid>(m_vs_cache, m_api_type, "specialized-vs",
-                                                          true);
+                                                          per_game);
     LoadShaderCache<ShaderStage::Pixel, PixelShaderUid>(m_ps_cache, m_api_type, "specialized-ps",
-                                                        true);
+                                                        per_game);
   }
 
   if (g_ActiveConfig.backend_info.bSupportsPipelineCacheData)
   {
     LoadPipelineCache<GXPipelineUid, SerializedGXPipelineUid>(
-        m_gx_pipeline_cache, m_gx_pipeline_disk_cache, m_api_type, "specialized-pipeline", true);
+        m_gx_pipeline_cache, m_gx_pipeline_disk_cache, m_api_type, "specialized-pipeline",
+        per_game);
     LoadPipelineCache<GXUberPipelineUid, SerializedGXUberPipelineUid>(
         m_gx_uber_pipeline_cache, m_gx_uber_pipeline_disk_cache, m_api_type, "uber-pipeline",
         false);
@@ -416,19 +527,38 @@ void ShaderCache::ClearCaches()
 
 void ShaderCache::CompileMissingPipelines()
 {
-  // Queue all uids with a null pipeline for compilation.
+  // Queue all uids with a null pipeline for compilation, skipping those still loading from the
+  // pipeline cache.
   for (auto& it : m_gx_pipeline_cache)
   {
-    if (!it.second.first)
-      QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+    if (!it.second.first && !it.second.second)
+      QueuePipelineCompile(it.first, GetPrecompilePriority(it.first));
   }
   for (auto& it : m_gx_uber_pipeline_cache)
   {
-    if (!it.second.first)
+    if (!it.second.first && !it.second.second)
       QueueUberPipelineCompile(it.first, COMPILE_PRIORITY_UBERSHADER_PIPELINE);
   }
 }
 
+size_t ShaderCache::HashUidData(const void* data, size_t size)
+{
+  return static_cast<size_t>(XXH64(data, size, 0));
+}
+
+u32 ShaderCache::GetPrecompilePriority(const GXPipelineUid& uid) const
+{
+  // Pipelines which have never been recorded in the UID cache only come from the pipeline disk
+  // cache, so they are cheap to create and can go first.
+  const auto iter = m_gx_pipeline_first_use_frames.find(uid);
+  if (iter == m_gx_pipeline_first_use_frames.end())
+    return COMPILE_PRIORITY_SHADERCACHE_PIPELINE;
+
+  constexpr u32 max_frame =
+      std::numeric_limits<u32>::max() - COMPILE_PRIORITY_SHADERCACHE_PIPELINE;
+  return COMPILE_PRIORITY_SHADERCACHE_PIPELINE + std::min(iter->second, max_frame);
+}
+
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
   const ShaderCode source_code =
@@ -805,7 +935,8 @@ ShaderCache::GetGXPipelineConfig(const GXUberPipelineUid& config_in)
 }
 
 const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& config,
-                                                      std::unique_ptr<AbstractPipeline> pipeline)
+                                                      std::unique_ptr<AbstractPipeline> pipeline,
+                                                      bool append_to_disk_cache)
 {
   auto& entry = m_gx_pipeline_cache[config];
   entry.second = false;
@@ -813,7 +944,7 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
   {
     entry.first = std::move(pipeline);
 
-    if (g_ActiveConfig.bShaderCache)
+    if (g_ActiveConfig.bShaderCache && append_to_disk_cache)
     {
       auto cache_data = entry.first->GetCacheData();
       if (!cache_data.empty())
@@ -831,7 +962,8 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
 
 const AbstractPipeline*
 ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
-                                  std::unique_ptr<AbstractPipeline> pipeline)
+                                  std::unique_ptr<AbstractPipeline> pipeline,
+                                  bool append_to_disk_cache)
 {
   auto& entry = m_gx_uber_pipeline_cache[config];
   entry.second = false;
@@ -839,7 +971,7 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
   {
     entry.first = std::move(pipeline);
 
-    if (g_ActiveConfig.bShaderCache)
+    if (g_ActiveConfig.bShaderCache && append_to_disk_cache)
     {
       auto cache_data = entry.first->GetCacheData();
       if (!cache_data.empty())
@@ -857,7 +989,10 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
 
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
+  // Older files only contain the UIDs, in the order they were first used. Newer files follow
+  // each UID with the frame it was first used in.
+  constexpr u32 OLD_CACHE_FILE_MAGIC = 0x44495550;  // PUID
+  constexpr u32 CACHE_FILE_MAGIC = 0x46495550;      // PUIF
   constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
   std::string filename =
       File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
@@ -869,25 +1004,31 @@ void ShaderCache::LoadPipelineUIDCache()
     bool uid_file_valid = false;
     if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
         m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
+        (existing_magic == CACHE_FILE_MAGIC || existing_magic == OLD_CACHE_FILE_MAGIC) &&
+        existing_version == GX_PIPELINE_UID_VERSION)
     {
+      const bool has_frames = existing_magic == CACHE_FILE_MAGIC;
+      const size_t entry_size = sizeof(SerializedGXPipelineUid) + (has_frames ? sizeof(u32) : 0);
+
       // Ensure the expected size matches the actual size of the file. If it doesn't, it means
       // the cache file may be corrupted, and we should not proceed with loading potentially
       // garbage or invalid UIDs.
       const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
-      const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
+      const size_t uid_count = static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / entry_size;
+      const size_t expected_size = uid_count * entry_size + CACHE_HEADER_SIZE;
       uid_file_valid = file_size == expected_size;
       if (uid_file_valid)
       {
         for (size_t i = 0; i < uid_count; i++)
         {
           SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
+          u32 first_use_frame = static_cast<u32>(i);
+          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)) &&
+              (!has_frames ||
+               m_gx_pipeline_uid_cache_file.ReadBytes(&first_use_frame, sizeof(first_use_frame))))
           {
             // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
+            AddSerializedGXPipelineUID(serialized_uid, first_use_frame);
           }
           else
           {
@@ -897,12 +1038,16 @@ void ShaderCache::LoadPipelineUIDCache()
         }
       }
 
+      // New entries can't be appended to files in the old format, so rewrite those below.
+      if (!has_frames)
+        uid_file_valid = false;
+
       // We open the file for reading and writing, so we must seek to the end before writing.
       if (uid_file_valid)
         uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, File::SeekOrigin::Begin);
     }
 
-    // If the file is invalid, close it. We re-open and truncate it below.
+    // If the file is invalid or outdated, close it. We re-open and truncate it below.
     if (!uid_file_valid)
       m_gx_pipeline_uid_cache_file.Close();
   }
@@ -934,10 +1079,13 @@ void ShaderCache::ClosePipelineUIDCache()
   m_gx_pipeline_uid_cache_file.Close();
 }
 
-void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
+void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid,
+                                             u32 first_use_frame)
 {
-  GXPipelineUid real_uid;
-  UnserializePipelineUid(uid, real_uid);
+  GXPipelineUid unserialized_uid;
+  UnserializePipelineUid(uid, unserialized_uid);
+  const GXPipelineUid real_uid = ApplyDynamicState(unserialized_uid);
+  m_gx_pipeline_first_use_frames.try_emplace(real_uid, first_use_frame);
 
   auto iter = m_gx_pipeline_cache.find(real_uid);
   if (iter != m_gx_pipeline_cache.end())
@@ -953,9 +1101,12 @@ void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
   if (!m_gx_pipeline_uid_cache_file.IsOpen())
     return;
 
+  const u32 first_use_frame =
+      m_gx_pipeline_first_use_frames.try_emplace(config, m_frame_count).first->second;
   SerializedGXPipelineUid disk_uid;
   SerializePipelineUid(config, disk_uid);
-  if (!m_gx_pipeline_uid_cache_file.WriteBytes(&disk_uid, sizeof(disk_uid)))
+  if (!m_gx_pipeline_uid_cache_file.WriteBytes(&disk_uid, sizeof(disk_uid)) ||
+      !m_gx_pipeline_uid_cache_file.WriteBytes(&first_use_frame, sizeof(first_use_frame)))
   {
     WARN_LOG_FMT(VIDEO, "Writing pipeline UID to cache failed, closing file.");
     m_gx_pipeline_uid_cache_file.Close();
@@ -1078,13 +1229,43 @@ void ShaderCache::QueuePixelUberShaderCompile(const UberShader::PixelShaderUid&
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
-void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
+// Creates the pipeline from the driver's cache data if there is any, and falls back to a full
+// compile if that fails.
+static std::unique_ptr<AbstractPipeline> CreatePipeline(const AbstractPipelineConfig& config,
+                                                        const std::vector<u8>& cache_data,
+                                                        bool* cache_data_failed)
+{
+  if (!cache_data.empty())
+  {
+    auto pipeline = g_renderer->CreatePipeline(config, cache_data.data(), cache_data.size());
+    if (pipeline)
+      return pipeline;
+    *cache_data_failed = true;
+  }
+
+  return g_renderer->CreatePipeline(config);
+}
+
+void ShaderCache::QueueCachedPipeline(const GXPipelineUid& uid, std::vector<u8> cache_data)
+{
+  QueuePipelineCompile(uid, GetPrecompilePriority(uid), std::move(cache_data));
+}
+
+void ShaderCache::QueueCachedPipeline(const GXUberPipelineUid& uid, std::vector<u8> cache_data)
+{
+  QueueUberPipelineCompile(uid, COMPILE_PRIORITY_UBERSHADER_PIPELINE, std::move(cache_data));
+}
+
+void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority,
+                                       std::vector<u8> cache_data)
 {
   class PipelineWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    PipelineWorkItem(ShaderCache* shader_cache_, const GXPipelineUid& uid_, u32 priority_)
-        : shader_cache(shader_cache_), uid(uid_), priority(priority_)
+    PipelineWorkItem(ShaderCache* shader_cache_, const GXPipelineUid& uid_, u32 priority_,
+                     std::vector<u8> cache_data_)
+        : shader_cache(shader_cache_), uid(uid_), priority(priority_),
+          cache_data(std::move(cache_data_))
     {
       // Check if all the stages required for this pipeline have been compiled.
       // If not, this work item becomes a no-op, and re-queues the pipeline for the next frame.
@@ -1117,7 +1298,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     bool Compile() override
     {
       if (config)
-        pipeline = g_renderer->CreatePipeline(*config);
+        pipeline = CreatePipeline(*config, cache_data, &cache_data_failed);
       return true;
     }
 
@@ -1125,13 +1306,21 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     {
       if (stages_ready)
       {
-        shader_cache->InsertGXPipeline(uid, std::move(pipeline));
+        const bool loaded_from_disk_cache = !cache_data.empty() && !cache_data_failed &&
+                                            !shader_cache->m_gx_pipeline_disk_cache.discarded;
+        if (!cache_data.empty())
+        {
+          shader_cache->m_pending_cache_loads--;
+          if (cache_data_failed)
+            shader_cache->m_gx_pipeline_disk_cache.Discard();
+        }
+        shader_cache->InsertGXPipeline(uid, std::move(pipeline), !loaded_from_disk_cache);
       }
       else
       {
         // Re-queue for next frame.
         auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
-            shader_cache, uid, priority);
+            shader_cache, uid, priority, std::move(cache_data));
         shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
       }
     }
@@ -1141,22 +1330,28 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     std::unique_ptr<AbstractPipeline> pipeline;
     GXPipelineUid uid;
     u32 priority;
+    std::vector<u8> cache_data;
     std::optional<AbstractPipelineConfig> config;
     bool stages_ready;
+    bool cache_data_failed = false;
   };
 
-  auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority);
+  auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority,
+                                                                      std::move(cache_data));
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
   m_gx_pipeline_cache[uid].second = true;
 }
 
-void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority)
+void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority,
+                                           std::vector<u8> cache_data)
 {
   class UberPipelineWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    UberPipelineWorkItem(ShaderCache* shader_cache_, const GXUberPipelineUid& uid_, u32 priority_)
-        : shader_cache(shader_cache_), uid(uid_), priority(priority_)
+    UberPipelineWorkItem(ShaderCache* shader_cache_, const GXUberPipelineUid& uid_, u32 priority_,
+                         std::vector<u8> cache_data_)
+        : shader_cache(shader_cache_), uid(uid_), priority(priority_),
+          cache_data(std::move(cache_data_))
     {
       // Check if all the stages required for this UberPipeline have been compiled.
       // If not, this work item becomes a no-op, and re-queues the UberPipeline for the next frame.
@@ -1192,7 +1387,7 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
     bool Compile() override
     {
       if (config)
-        UberPipeline = g_renderer->CreatePipeline(*config);
+        UberPipeline = CreatePipeline(*config, cache_data, &cache_data_failed);
       return true;
     }
 
@@ -1200,13 +1395,21 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
     {
       if (stages_ready)
       {
-        shader_cache->InsertGXUberPipeline(uid, std::move(UberPipeline));
+        const bool loaded_from_disk_cache = !cache_data.empty() && !cache_data_failed &&
+                                            !shader_cache->m_gx_uber_pipeline_disk_cache.discarded;
+        if (!cache_data.empty())
+        {
+          shader_cache->m_pending_cache_loads--;
+          if (cache_data_failed)
+            shader_cache->m_gx_uber_pipeline_disk_cache.Discard();
+        }
+        shader_cache->InsertGXUberPipeline(uid, std::move(UberPipeline), !loaded_from_disk_cache);
       }
       else
       {
         // Re-queue for next frame.
         auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<UberPipelineWorkItem>(
-            shader_cache, uid, priority);
+            shader_cache, uid, priority, std::move(cache_data));
         shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
       }
     }
@@ -1216,11 +1419,14 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
     std::unique_ptr<AbstractPipeline> UberPipeline;
     GXUberPipelineUid uid;
     u32 priority;
+    std::vector<u8> cache_data;
     std::optional<AbstractPipelineConfig> config;
     bool stages_ready;
+    bool cache_data_failed = false;
   };
 
-  auto wi = m_async_shader_compiler->CreateWorkItem<UberPipelineWorkItem>(this, uid, priority);
+  auto wi = m_async_shader_compiler->CreateWorkItem<UberPipelineWorkItem>(this, uid, priority,
+                                                                          std::move(cache_data));
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
   m_gx_uber_pipeline_cache[uid].second = true;
 }
@@ -1254,6 +1460,7 @@ void ShaderCache::QueueUberShaderPipelines()
           config.blending_state.logicopenable = true;
           config.blending_state.logicmode = LogicOp::And;
         }
+        config = ApplyDynamicState(config);
 
         auto iter = m_gx_uber_pipeline_cache.find(config);
         if (iter != m_gx_uber_pipeline_cache.end())
@@ -12,6 +12,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -68,6 +69,7 @@ public:
   // Accesses ShaderGen shader caches asynchronously.
   // The optional will be empty if this pipeline is now background compiling.
   std::optional<const AbstractPipeline*> GetPipelineForUidAsync(const GXPipelineUid& uid);
+  std::optional<const AbstractPipeline*> GetUberPipelineForUidAsync(const GXUberPipelineUid& uid);
 
   // Shared shaders
   const AbstractShader* GetScreenQuadVertexShader() const
@@ -155,10 +157,12 @@ private:
   std::optional<AbstractPipelineConfig> GetGXPipelineConfig(const GXPipelineUid& uid);
   std::optional<AbstractPipelineConfig> GetGXPipelineConfig(const GXUberPipelineUid& uid);
   const AbstractPipeline* InsertGXPipeline(const GXPipelineUid& config,
-                                           std::unique_ptr<AbstractPipeline> pipeline);
+                                           std::unique_ptr<AbstractPipeline> pipeline,
+                                           bool append_to_disk_cache = true);
   const AbstractPipeline* InsertGXUberPipeline(const GXUberPipelineUid& config,
-                                               std::unique_ptr<AbstractPipeline> pipeline);
-  void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
+                                               std::unique_ptr<AbstractPipeline> pipeline,
+                                               bool append_to_disk_cache = true);
+  void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid, u32 first_use_frame);
   void AppendGXPipelineUID(const GXPipelineUid& config);
 
   // ASync Compiler Methods
@@ -166,8 +170,25 @@ private:
   void QueueVertexUberShaderCompile(const UberShader::VertexShaderUid& uid, u32 priority);
   void QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority);
   void QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority);
-  void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority);
-  void QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority);
+  // cache_data is the driver's data from the pipeline cache, if the pipeline is being loaded.
+  void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority,
+                            std::vector<u8> cache_data = {});
+  u32 GetPrecompilePriority(const GXPipelineUid& uid) const;
+  void QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority,
+                                std::vector<u8> cache_data = {});
+  void QueueCachedPipeline(const GXPipelineUid& uid, std::vector<u8> cache_data);
+  void QueueCachedPipeline(const GXUberPipelineUid& uid, std::vector<u8> cache_data);
+
+  // Disk cache whose entries are created by the async compiler workers, after the file has been
+  // read. If any of them fail to load, the file is recreated.
+  template <typename K>
+  struct DiskCache : LinearDiskCache<K, u8>
+  {
+    void Discard();
+
+    std::string filename;
+    bool discarded = false;
+  };
 
   // Populating various caches.
   template <ShaderStage stage, typename K, typename T>
@@ -175,17 +196,24 @@ private:
   template <typename T>
   void ClearShaderCache(T& cache);
   template <typename KeyType, typename DiskKeyType, typename T>
-  void LoadPipelineCache(T& cache, LinearDiskCache<DiskKeyType, u8>& disk_cache, APIType api_type,
+  void LoadPipelineCache(T& cache, DiskCache<DiskKeyType>& disk_cache, APIType api_type,
                          const char* type, bool include_gameid);
   template <typename T, typename Y>
   void ClearPipelineCache(T& cache, Y& disk_cache);
+  // Retrieves finished work until no more than max_pending cache entries are loading.
+  void WaitForPendingCacheLoads(u32 max_pending);
 
   // Priorities for compiling. The lower the value, the sooner the pipeline is compiled.
   // The shader cache is compiled last, as it is the least likely to be required. On demand
   // shaders are always compiled before pending ubershaders, as we want to use the ubershader
-  // for as few frames as possible, otherwise we risk framerate drops.
+  // for as few frames as possible, otherwise we risk framerate drops. Partially specialized
+  // ubershaders go first, as there are only a few of them and each replaces a slow generic
+  // ubershader for many on demand shaders. Shader binaries from the disk cache are cheap to
+  // create and hold up the pipelines which use them, so they are loaded before anything else.
   enum : u32
   {
+    COMPILE_PRIORITY_CACHED_SHADER = 0,
+    COMPILE_PRIORITY_PARTIAL_UBERSHADER_PIPELINE = 50,
     COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
     COMPILE_PRIORITY_UBERSHADER_PIPELINE = 200,
     COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
@@ -205,6 +233,22 @@ private:
   std::unique_ptr<AbstractShader> m_texture_copy_pixel_shader;
   std::unique_ptr<AbstractShader> m_color_pixel_shader;
 
+  // Hashes all bytes of a UID. UIDs are compared with memcmp() and have their padding zeroed, so
+  // equal UIDs always have the same hash.
+  struct UidHash
+  {
+    template <typename Uid>
+    size_t operator()(const Uid& uid) const
+    {
+      return HashUidData(&uid, sizeof(uid));
+    }
+  };
+  static size_t HashUidData(const void* data, size_t size);
+
+  // Limits the number of cache entries being loaded at once, as each holds on to its binary.
+  static constexpr u32 MAX_PENDING_CACHE_LOADS = 1024;
+  u32 m_pending_cache_loads = 0;
+
   // GX Shader Caches
   template <typename Uid>
   struct ShaderModuleCache
@@ -214,8 +258,8 @@ private:
       std::unique_ptr<AbstractShader> shader;
       bool pending = false;
     };
-    std::map<Uid, Shader> shader_map;
-    LinearDiskCache<Uid, u8> disk_cache;
+    std::unordered_map<Uid, Shader, UidHash> shader_map;
+    DiskCache<Uid> disk_cache;
   };
   ShaderModuleCache<VertexShaderUid> m_vs_cache;
   ShaderModuleCache<GeometryShaderUid> m_gs_cache;
@@ -224,12 +268,18 @@ private:
   ShaderModuleCache<UberShader::PixelShaderUid> m_uber_ps_cache;
 
   // GX Pipeline Caches - .first - pipeline, .second - pending
-  std::map<GXPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>> m_gx_pipeline_cache;
-  std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
+  std::unordered_map<GXPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>, UidHash>
+      m_gx_pipeline_cache;
+  std::unordered_map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>,
+                     UidHash>
       m_gx_uber_pipeline_cache;
   File::IOFile m_gx_pipeline_uid_cache_file;
-  LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
-  LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
+  // Frame each pipeline was first used in, counted from when the cache was created. Cached
+  // pipelines are precompiled in this order, so the ones needed right after booting come first.
+  std::unordered_map<GXPipelineUid, u32, UidHash> m_gx_pipeline_first_use_frames;
+  u32 m_frame_count = 0;
+  DiskCache<SerializedGXPipelineUid> m_gx_pipeline_disk_cache;
+  DiskCache<SerializedGXUberPipelineUid> m_gx_uber_pipeline_disk_cache;
 
   // EFB copy to VRAM/RAM pipelines
   std::map<TextureConversionShaderGen::TCShaderUid, std::unique_ptr<AbstractPipeline>>
@@ -7,6 +7,7 @@
 #include <functional>
 #include <iterator>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -106,7 +107,8 @@ private:
 class ShaderCode : public ShaderGeneratorInterface
 {
 public:
-  ShaderCode() { m_buffer.reserve(16384); }
+  // Most shaders fit into the default size, but ubershaders are several times larger.
+  explicit ShaderCode(size_t reserve_size = 16384) { m_buffer.reserve(reserve_size); }
   const std::string& GetBuffer() const { return m_buffer; }
 
   // Writes format strings using fmtlib format strings.
@@ -116,6 +118,9 @@ public:
     fmt::format_to(std::back_inserter(m_buffer), format, std::forward<Args>(args)...);
   }
 
+  // Appends already generated code, which isn't parsed as a format string.
+  void WriteRaw(std::string_view code) { m_buffer.append(code); }
+
 protected:
   std::string m_buffer;
 };
@@ -71,6 +71,13 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  draw_statistic("Textures evicted", "%d", num_textures_evicted);
+  draw_statistic("Texture memory", "%d MiB (%d MiB free)", texture_cache_memory_mb,
+                 texture_pool_memory_mb);
+  if (video_memory_budget_mb != 0)
+  {
+    draw_statistic("Video memory", "%d / %d MiB", video_memory_usage_mb, video_memory_budget_mb);
+  }
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
@@ -90,9 +97,16 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Uniform uploads skipped", "%d", this_frame.num_uniform_uploads_skipped);
+  draw_statistic("Stream buffer waits", "%d (%d us)", this_frame.num_stream_buffer_waits,
+                 this_frame.stream_buffer_wait_us);
+  draw_statistic("Stream buffer forced submits", "%d",
+                 this_frame.num_stream_buffer_forced_submits);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("BBox reads:", "%d (%d stale, %d differed)", this_frame.num_bbox_reads,
+                 this_frame.num_bbox_stale_reads, this_frame.num_bbox_stale_mismatches);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
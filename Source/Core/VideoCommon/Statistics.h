@@ -18,9 +18,21 @@ struct Statistics
   int num_textures_created;
   int num_textures_uploaded;
   int num_textures_alive;
+  // Textures evicted to stay within the texture cache's video memory budget.
+  int num_textures_evicted;
+
+  // Video memory used by the textures in the texture cache and in its pool of free textures, and
+  // by the whole process along with its budget, if the backend can query them.
+  int texture_cache_memory_mb;
+  int texture_pool_memory_mb;
+  int video_memory_usage_mb;
+  int video_memory_budget_mb;
 
   int num_vertex_loaders;
 
+  // Unlike this_frame.num_draw_calls, this is never reset.
+  int num_draw_calls_total;
+
   std::array<float, 6> proj;
   std::array<float, 16> gproj;
   std::array<float, 16> g2proj;
@@ -57,6 +69,14 @@ struct Statistics
     int bytes_vertex_streamed;
     int bytes_index_streamed;
     int bytes_uniform_streamed;
+    // Uploads skipped because the constants were set to the values they already had.
+    int num_uniform_uploads_skipped;
+
+    // Times the video thread had to wait for the GPU to free up stream buffer space, and for how
+    // long in total. Forced submissions are command buffers executed early to free up space.
+    int num_stream_buffer_waits;
+    int stream_buffer_wait_us;
+    int num_stream_buffer_forced_submits;
 
     int num_triangles_clipped;
     int num_triangles_in;
@@ -72,6 +92,12 @@ struct Statistics
     int num_efb_peeks;
     int num_efb_pokes;
 
+    // Bounding box reads, the reads which returned the last known values because of asynchronous
+    // readback, and how many of those turned out to differ from the values at the time of the read.
+    int num_bbox_reads;
+    int num_bbox_stale_reads;
+    int num_bbox_stale_mismatches;
+
     int num_draw_done;
     int num_token;
     int num_token_int;
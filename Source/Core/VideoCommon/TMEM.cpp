@@ -4,10 +4,12 @@
 
 #include "VideoCommon/TMEM.h"
 
+#include <algorithm>
 #include <array>
 
 #include "Common/ChunkFile.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/TextureDecoder.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
@@ -99,6 +101,15 @@ static u32 CalculateUnitSize(TextureUnitState::BankConfig bank_config);
 
 static std::array<TextureUnitState, 8> s_unit;
 
+// The palettes of the bound textures. Kept out of TextureUnitState so that the savestate layout
+// stays the same.
+static std::array<TextureUnitState::BankConfig, 8> s_unit_palette;
+
+// The stamp of the last write to each region of TMEM.
+constexpr u32 WRITE_STAMP_REGION_SIZE = 4096;
+static u64 s_write_stamp;
+static std::array<u64, TMEM_SIZE / WRITE_STAMP_REGION_SIZE> s_region_write_stamps;
+
 // On TMEM configuration changed:
 // 1. invalidate stage.
 
@@ -157,9 +168,11 @@ void Invalidate([[maybe_unused]] u32 param)
 // 2. if texture size is small enough to fit in region mark as cached.
 //    otherwise, mark as valid
 
-void Bind(u32 unit, int width, int height, bool is_mipmapped, bool is_32_bit)
+void Bind(u32 unit, int width, int height, bool is_mipmapped, bool is_32_bit, u32 palette_address,
+          u32 palette_size)
 {
   TextureUnitState& unit_state = s_unit[unit];
+  s_unit_palette[unit] = {0, 0, palette_address, palette_size};
 
   // All textures use the even bank.
   // It holds the level 0 mipmap (and other even mipmap LODs, if mipmapping is enabled)
@@ -267,6 +280,53 @@ void FinalizeBinds(BitSet32 used_textures)
   }
 }
 
+void Write(u32 address, u32 size)
+{
+  if (size == 0)
+    return;
+
+  const TextureUnitState::BankConfig written = {0, 0, address, size};
+  for (size_t i = 0; i < s_unit.size(); ++i)
+  {
+    TextureUnitState& unit = s_unit[i];
+    if (unit.even.Overlaps(written) || unit.odd.Overlaps(written) ||
+        s_unit_palette[i].Overlaps(written))
+    {
+      unit.state = TextureUnitState::State::INVALID;
+    }
+  }
+
+  ++s_write_stamp;
+  const u32 end = std::min<u32>(address + size, TMEM_SIZE);
+  for (u32 region = address / WRITE_STAMP_REGION_SIZE;
+       region * WRITE_STAMP_REGION_SIZE < end; ++region)
+  {
+    s_region_write_stamps[region] = s_write_stamp;
+  }
+}
+
+u64 GetWriteStamp()
+{
+  return s_write_stamp;
+}
+
+bool IsUnchangedSince(u32 address, u32 size, u64 stamp)
+{
+  if (size == 0)
+    return true;
+  if (address >= TMEM_SIZE)
+    return false;
+
+  const u32 end = std::min<u32>(address + size, TMEM_SIZE);
+  for (u32 region = address / WRITE_STAMP_REGION_SIZE;
+       region * WRITE_STAMP_REGION_SIZE < end; ++region)
+  {
+    if (s_region_write_stamps[region] > stamp)
+      return false;
+  }
+  return true;
+}
+
 bool IsCached(u32 unit)
 {
   return s_unit[unit].state == TextureUnitState::State::CACHED;
@@ -280,11 +340,23 @@ bool IsValid(u32 unit)
 void Init()
 {
   s_unit.fill({});
+  s_unit_palette.fill({});
+  // Start past the stamps of the regions, so that nothing from before counts as unchanged.
+  s_write_stamp = 1;
+  s_region_write_stamps.fill(s_write_stamp);
 }
 
 void DoState(PointerWrap& p)
 {
   p.DoArray(s_unit);
+
+  if (p.IsReadMode())
+  {
+    // The palettes of the bound textures aren't saved, and all of TMEM may have changed.
+    s_unit_palette.fill({});
+    InvalidateAll();
+    Write(0, TMEM_SIZE);
+  }
 }
 
 }  // namespace TMEM
@@ -15,11 +15,21 @@ namespace TMEM
 void InvalidateAll();
 void Invalidate(u32 param);
 void ConfigurationChanged(TexUnitAddress bp_addr, u32 config);
-void Bind(u32 unit, int num_blocks_width, int num_blocks_height, bool is_mipmapped, bool is_32_bit);
+void Bind(u32 unit, int num_blocks_width, int num_blocks_height, bool is_mipmapped, bool is_32_bit,
+          u32 palette_address, u32 palette_size);
 void FinalizeBinds(BitSet32 used_textures);
 bool IsCached(u32 unit);
 bool IsValid(u32 unit);
 
+// Called when TMEM is loaded from RAM, by a preload or a TLUT load. Only the texture units whose
+// banks or palette overlap the written range are invalidated.
+void Write(u32 address, u32 size);
+
+// Every write to TMEM gets a new stamp, so that data read from TMEM can be recognized as unchanged
+// without hashing it again.
+u64 GetWriteStamp();
+bool IsUnchangedSince(u32 address, u32 size, u64 stamp);
+
 void Init();
 void DoState(PointerWrap& p);
 
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -22,9 +23,11 @@
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
+#include "Common/Image.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/PerformanceTrace.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
@@ -34,7 +37,9 @@
 
 #include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractStagingTexture.h"
+#include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
@@ -57,6 +62,19 @@ static const u64 TEXHASH_INVALID = 0;
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
 
+// When the driver reports a video memory budget, the cache is trimmed once the process uses more
+// than this fraction of it, leaving room for the textures allocated until the next check.
+static constexpr u64 VIDEO_MEMORY_BUDGET_HEADROOM_PERCENT = 10;
+
+// How much more expensive it is to recreate a texture after it was evicted, relative to decoding
+// it from RAM again. EFB copies lose their resolution and any later partial updates, and custom
+// textures have to be loaded again.
+static constexpr double EFB_COPY_EVICTION_COST = 16.0;
+static constexpr double CUSTOM_TEXTURE_EVICTION_COST = 4.0;
+
+// Each lazily flushed EFB copy holds on to a staging texture of the maximum EFB copy size.
+static constexpr size_t MAX_LAZY_EFB_COPIES = 16;
+
 static int xfb_count = 0;
 
 std::unique_ptr<TextureCacheBase> g_texture_cache;
@@ -83,6 +101,24 @@ void TextureCacheBase::CheckTempSize(size_t required_size)
   temp = static_cast<u8*>(Common::AllocateAlignedMemory(temp_size, 16));
 }
 
+// Called through the memory fault handler on the thread which accessed the memory.
+static void OnLazyEFBCopyAccess(u32 address, u32 size)
+{
+  AsyncRequests::Event e;
+  e.type = AsyncRequests::Event::FLUSH_LAZY_EFB_COPIES;
+  e.time = 0;
+  e.flush_lazy_efb_copies.address = address;
+  e.flush_lazy_efb_copies.size = size;
+  AsyncRequests::GetInstance()->PushEvent(e, true);
+}
+
+// Returns the number of bytes of guest RAM written by a pending EFB copy.
+static u32 GetPendingEFBCopySize(const TextureCacheBase::TCacheEntry& entry)
+{
+  return (entry.pending_efb_copy_height - 1) * entry.memory_stride +
+         entry.pending_efb_copy_width * sizeof(u32);
+}
+
 TextureCacheBase::TextureCacheBase()
 {
   SetBackupConfig(g_ActiveConfig);
@@ -96,12 +132,17 @@ TextureCacheBase::TextureCacheBase()
   HiresTexture::Init();
 
   TMEM::InvalidateAll();
+
+  Memory::SetAccessWatchHandler(OnLazyEFBCopyAccess);
 }
 
 TextureCacheBase::~TextureCacheBase()
 {
+  Memory::SetAccessWatchHandler(nullptr);
+
   // Clear pending EFB copies first, so we don't try to flush them.
   m_pending_efb_copies.clear();
+  m_lazy_efb_copies.clear();
 
   HiresTexture::Shutdown();
   Invalidate();
@@ -122,7 +163,7 @@ bool TextureCacheBase::Initialize()
 
 void TextureCacheBase::Invalidate()
 {
-  FlushEFBCopies();
+  FlushAllEFBCopies();
   TMEM::InvalidateAll();
 
   bound_textures.fill(nullptr);
@@ -131,9 +172,11 @@ void TextureCacheBase::Invalidate()
     delete tex.second;
   }
   textures_by_address.clear();
+  texture_size_counts.clear();
   textures_by_hash.clear();
 
   texture_pool.clear();
+  m_watched_texture_hashes.clear();
 }
 
 void TextureCacheBase::ForceReload()
@@ -150,7 +193,8 @@ void TextureCacheBase::ForceReload()
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.bAsyncHiresTextures != backup_config.async_hires_textures)
   {
     HiresTexture::Update();
   }
@@ -237,6 +281,18 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter2;
     }
   }
+
+  EnforceMemoryBudget(_frameCount);
+
+  for (auto iter3 = m_watched_texture_hashes.begin(); iter3 != m_watched_texture_hashes.end();)
+  {
+    if (iter3->second.frameCount == FRAMECOUNT_INVALID)
+      iter3->second.frameCount = _frameCount;
+    if (_frameCount > TEXTURE_KILL_THRESHOLD + iter3->second.frameCount)
+      iter3 = m_watched_texture_hashes.erase(iter3);
+    else
+      ++iter3;
+  }
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -257,6 +313,7 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.async_hires_textures = config.bAsyncHiresTextures;
   backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
@@ -331,7 +388,7 @@ TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLU
     g_renderer->EndUtilityDrawing();
   }
 
-  textures_by_address.emplace(decoded_entry->addr, decoded_entry);
+  AddTextureByAddress(decoded_entry->addr, decoded_entry);
 
   return decoded_entry;
 }
@@ -377,7 +434,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::ReinterpretEntry(const TCacheEn
   g_renderer->EndUtilityDrawing();
   reinterpreted_entry->texture->FinishedRendering();
 
-  textures_by_address.emplace(reinterpreted_entry->addr, reinterpreted_entry);
+  AddTextureByAddress(reinterpreted_entry->addr, reinterpreted_entry);
 
   return reinterpreted_entry;
 }
@@ -420,6 +477,23 @@ void TextureCacheBase::ScaleTextureCacheEntryTo(TextureCacheBase::TCacheEntry* e
       config, TexPoolEntry(std::move(new_texture->texture), std::move(new_texture->framebuffer)));
 }
 
+u64 TextureCacheBase::GetTextureDataHash(const u8* ptr, u32 size, u32 samples)
+{
+  if (!g_ActiveConfig.bWatchTextureWrites || !Memory::IsWriteWatchEnabled())
+    return Common::GetHash64(ptr, size, samples);
+
+  WatchedTextureHash& entry = m_watched_texture_hashes[{ptr, size}];
+  entry.frameCount = FRAMECOUNT_INVALID;
+  if (entry.samples == samples && !Memory::WasWrittenSince(ptr, size, entry.write_watch_token))
+    return entry.hash;
+
+  // Start watching before hashing, so that a write which races with the hash is noticed next time.
+  entry.write_watch_token = Memory::WatchWrites(ptr, size);
+  entry.hash = Common::GetHash64(ptr, size, samples);
+  entry.samples = samples;
+  return entry.hash;
+}
+
 bool TextureCacheBase::CheckReadbackTexture(u32 width, u32 height, AbstractTextureFormat format)
 {
   if (m_readback_texture && m_readback_texture->GetConfig().width >= width &&
@@ -546,7 +620,7 @@ std::optional<TextureCacheBase::TexPoolEntry> TextureCacheBase::DeserializeTextu
 void TextureCacheBase::DoState(PointerWrap& p)
 {
   // Flush all pending XFB copies before either loading or saving.
-  FlushEFBCopies();
+  FlushAllEFBCopies();
 
   p.Do(last_entry_id);
 
@@ -727,7 +801,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     TCacheEntry* entry = GetEntry(id);
     if (entry)
-      textures_by_address.emplace(addr, entry);
+      AddTextureByAddress(addr, entry);
   }
 
   // Fill in hash map.
@@ -951,10 +1025,6 @@ void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, uns
 {
   std::string szDir = File::GetUserPath(D_DUMPTEXTURES_IDX) + SConfig::GetInstance().GetGameID();
 
-  // make sure that the directory exists
-  if (!File::IsDirectory(szDir))
-    File::CreateDir(szDir);
-
   if (is_arbitrary)
   {
     basename += "_arb";
@@ -972,11 +1042,50 @@ void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, uns
       return;
   }
 
-  const std::string filename = fmt::format("{}/{}.png", szDir, basename);
-  if (File::Exists(filename))
+  std::string filename = fmt::format("{}/{}.png", szDir, basename);
+  if (!m_dumped_textures.insert(filename).second || File::Exists(filename))
     return;
 
-  entry->texture->Save(filename, level);
+  // make sure that the directory exists
+  if (!File::IsDirectory(szDir))
+    File::CreateDir(szDir);
+
+  SaveTextureAsync(entry->texture.get(), std::move(filename), level);
+}
+
+void TextureCacheBase::SaveTextureAsync(AbstractTexture* texture, std::string filename,
+                                        unsigned int level)
+{
+  TextureDump dump;
+  dump.filename = std::move(filename);
+  dump.compression_level = Config::Get(Config::GFX_PNG_COMPRESSION_LEVEL);
+  if (!texture->Download(level, &dump.data, &dump.width, &dump.height))
+    return;
+
+  const size_t size = dump.data.size();
+  if (m_queued_dump_bytes.load(std::memory_order_relaxed) + size > MAX_QUEUED_DUMP_BYTES)
+  {
+    WriteTextureDump(std::move(dump));
+    return;
+  }
+
+  if (!m_dump_threads_started)
+  {
+    for (auto& thread : m_dump_threads)
+      thread.Reset([this](TextureDump queued_dump) { WriteTextureDump(std::move(queued_dump)); });
+    m_dump_threads_started = true;
+  }
+
+  m_queued_dump_bytes.fetch_add(size, std::memory_order_relaxed);
+  m_dump_threads[m_next_dump_thread].EmplaceItem(std::move(dump));
+  m_next_dump_thread = (m_next_dump_thread + 1) % m_dump_threads.size();
+}
+
+void TextureCacheBase::WriteTextureDump(TextureDump dump)
+{
+  Common::SavePNG(dump.filename, dump.data.data(), Common::ImageByteFormat::RGBA, dump.width,
+                  dump.height, dump.width * 4, dump.compression_level);
+  m_queued_dump_bytes.fetch_sub(dump.data.size(), std::memory_order_relaxed);
 }
 
 // Helper for checking if a BPMemory TexMode0 register is set to Point
@@ -1248,12 +1357,32 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture
 
   // We need to keep track of invalided textures until they have actually been replaced or
   // re-loaded
+  const u32 palette_address = static_cast<u32>(texture_info.GetTlutAddress() - texMem);
   TMEM::Bind(texture_info.GetStage(), entry->NumBlocksX(), entry->NumBlocksY(),
-             entry->GetNumLevels() > 1, entry->format == TextureFormat::RGBA8);
+             entry->GetNumLevels() > 1, entry->format == TextureFormat::RGBA8, palette_address,
+             texture_info.GetPaletteSize().value_or(0));
 
   return entry;
 }
 
+const TextureCacheBase::TCacheEntry*
+TextureCacheBase::FindUnchangedTmemEntry(const TextureInfo& texture_info) const
+{
+  const u32 tmem_address = static_cast<u32>(texture_info.GetData() - texMem);
+  const auto iter_range = textures_by_address.equal_range(texture_info.GetRawAddress());
+  for (auto iter = iter_range.first; iter != iter_range.second; ++iter)
+  {
+    const TCacheEntry* entry = iter->second;
+    if (entry->tmem_data == texture_info.GetData() &&
+        entry->size_in_bytes == texture_info.GetTextureSize() &&
+        TMEM::IsUnchangedSince(tmem_address, entry->size_in_bytes, entry->tmem_write_stamp))
+    {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
 TextureCacheBase::TCacheEntry*
 TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
                              const TextureInfo& texture_info)
@@ -1299,19 +1428,46 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
-  u32 palette_size = 0;
-  if (texture_info.GetPaletteSize())
+  // Textures read from the memory of lazily flushed EFB copies need the copied data, unless the
+  // texture is one of the copies, in which case its VRAM copy is used anyway.
+  if (!m_lazy_efb_copies.empty() && !texture_info.IsFromTmem())
   {
-    palette_size = *texture_info.GetPaletteSize();
-    full_hash =
-        base_hash ^ Common::GetHash64(texture_info.GetTlutAddress(), *texture_info.GetPaletteSize(),
-                                      textureCacheSafetyColorSampleSize);
+    const u32 address = texture_info.GetRawAddress();
+    if (std::none_of(m_lazy_efb_copies.begin(), m_lazy_efb_copies.end(),
+                     [address](const TCacheEntry* entry) { return entry->addr == address; }))
+    {
+      FlushLazyEFBCopies(address, texture_info.GetFullLevelSize());
+    }
   }
-  else
+
+  u32 palette_size = 0;
   {
-    full_hash = base_hash;
+    Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::TextureHashing);
+    if (texture_info.IsFromTmem())
+    {
+      // Preloaded textures are often bound many times between loads, so skip hashing them again
+      // if the data hasn't been written since an entry for it was hashed.
+      const TCacheEntry* unchanged = FindUnchangedTmemEntry(texture_info);
+      base_hash = unchanged ? unchanged->base_hash :
+                              Common::GetHash64(texture_info.GetData(),
+                                                texture_info.GetTextureSize(),
+                                                textureCacheSafetyColorSampleSize);
+    }
+    else
+    {
+      base_hash = GetTextureDataHash(texture_info.GetData(), texture_info.GetTextureSize(),
+                                     textureCacheSafetyColorSampleSize);
+    }
+    if (texture_info.GetPaletteSize())
+    {
+      palette_size = *texture_info.GetPaletteSize();
+      full_hash = base_hash ^ Common::GetHash64(texture_info.GetTlutAddress(), palette_size,
+                                                textureCacheSafetyColorSampleSize);
+    }
+    else
+    {
+      full_hash = base_hash;
+    }
   }
 
   // Search the texture cache for textures by address
@@ -1435,6 +1591,13 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
+        // Swap in the custom texture once it's done loading.
+        if (entry->pending_custom_tex && !entry->pending_custom_tex->IsLoading())
+        {
+          iter = InvalidateTexture(iter);
+          continue;
+        }
+
         entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
         entry->texture->FinishedRendering();
@@ -1501,7 +1664,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
       // All parameters, except the address, need to match here
       if (entry->format == full_format && entry->native_levels >= texture_info.GetLevelCount() &&
           entry->native_width == texture_info.GetRawWidth() &&
-          entry->native_height == texture_info.GetRawHeight())
+          entry->native_height == texture_info.GetRawHeight() &&
+          !(entry->pending_custom_tex && !entry->pending_custom_tex->IsLoading()))
       {
         entry = DoPartialTextureUpdates(hash_iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
@@ -1520,10 +1684,15 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
+  std::shared_ptr<HiresTexture> pending_hires_tex;
   if (g_ActiveConfig.bHiresTextures)
   {
     hires_tex = HiresTexture::Search(texture_info);
 
+    // Use the native texture until the custom one is loaded.
+    if (hires_tex && hires_tex->IsLoading())
+      pending_hires_tex = std::move(hires_tex);
+
     if (hires_tex)
     {
       const auto& level = hires_tex->m_levels[0];
@@ -1560,12 +1729,13 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
   if (hires_tex)
   {
     const auto& level = hires_tex->m_levels[0];
-    entry->texture->Load(0, level.width, level.height, level.row_length, level.data.data(),
-                         level.data.size());
+    entry->texture->Load(0, level.width, level.height, level.row_length, level.GetData().data(),
+                         level.GetData().size());
   }
 
   // Initialized to null because only software loading uses this buffer
   u8* dst_buffer = nullptr;
+  bool mips_decoded = false;
 
   if (!hires_tex)
   {
@@ -1596,11 +1766,15 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
 
       CheckTempSize(total_texture_size);
       dst_buffer = temp;
+
+      // Decode all levels at once, so that they can be split across the texture decoder threads.
+      // They are uploaded once everything has been decoded.
+      std::vector<TexDecoderJob> decode_jobs;
       if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
       {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
+        decode_jobs.push_back({dst_buffer, texture_info.GetData(), static_cast<int>(expanded_width),
+                               static_cast<int>(expanded_height), texture_info.GetTextureFormat(),
+                               texture_info.GetTlutAddress(), texture_info.GetTlutFormat()});
       }
       else
       {
@@ -1609,6 +1783,27 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
                                        expanded_height);
       }
 
+      if (!decode_on_gpu)
+      {
+        u8* mip_dst_buffer = dst_buffer + decoded_texture_size;
+        for (u32 level = 1; level != texLevels; ++level)
+        {
+          auto mip_level = texture_info.GetMipMapLevel(level - 1);
+          if (!mip_level)
+            continue;
+
+          const int mip_width = static_cast<int>(mip_level->GetExpandedWidth());
+          const int mip_height = static_cast<int>(mip_level->GetExpandedHeight());
+          decode_jobs.push_back({mip_dst_buffer, mip_level->GetData(), mip_width, mip_height,
+                                 texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
+                                 texture_info.GetTlutFormat()});
+          mip_dst_buffer += mip_width * sizeof(u32) * mip_height;
+        }
+        mips_decoded = true;
+      }
+
+      TexDecoder_DecodeJobs(decode_jobs, g_ActiveConfig.iTextureDecoderThreads);
+
       entry->texture->Load(0, width, height, expanded_width, dst_buffer, decoded_texture_size);
 
       arbitrary_mip_detector.AddLevel(width, height, expanded_width, dst_buffer);
@@ -1617,7 +1812,10 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
     }
   }
 
-  iter = textures_by_address.emplace(texture_info.GetRawAddress(), entry);
+  entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
+                              full_format, false);
+
+  iter = AddTextureByAddress(texture_info.GetRawAddress(), entry);
   if (textureCacheSafetyColorSampleSize == 0 ||
       std::max(texture_info.GetTextureSize(), palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
@@ -1625,12 +1823,16 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
     entry->textures_by_hash_iter = textures_by_hash.emplace(full_hash, entry);
   }
 
-  entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
-                              full_format, false);
   entry->SetDimensions(texture_info.GetRawWidth(), texture_info.GetRawHeight(),
                        texture_info.GetLevelCount());
   entry->SetHashes(base_hash, full_hash);
+  if (texture_info.IsFromTmem())
+  {
+    entry->tmem_data = texture_info.GetData();
+    entry->tmem_write_stamp = TMEM::GetWriteStamp();
+  }
   entry->is_custom_tex = hires_tex != nullptr;
+  entry->pending_custom_tex = std::move(pending_hires_tex);
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
 
@@ -1646,7 +1848,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
     {
       const auto& level = hires_tex->m_levels[level_index];
       entry->texture->Load(level_index, level.width, level.height, level.row_length,
-                           level.data.data(), level.data.size());
+                           level.GetData().data(), level.GetData().size());
     }
   }
   else
@@ -1668,9 +1870,12 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        if (!mips_decoded)
+        {
+          TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
+                            mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
+                            texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        }
         entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
                              mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
 
@@ -1745,6 +1950,7 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
 
   // Compute total texture size. XFB textures aren't tiled, so this is simple.
   const u32 total_size = height * stride;
+  FlushLazyEFBCopies(address, total_size);
   entry->SetGeneralParameters(address, total_size,
                               TextureAndTLUTFormat(TextureFormat::XFB, TLUTFormat::IA8), true);
   entry->SetDimensions(width, height, 1);
@@ -1771,7 +1977,7 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
   entry->texture->FinishedRendering();
 
   // Insert into the texture cache so we can re-use it next frame, if needed.
-  textures_by_address.emplace(entry->addr, entry);
+  AddTextureByAddress(entry->addr, entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
 
@@ -1785,9 +1991,10 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
 
     if (g_ActiveConfig.bDumpXFBTarget)
     {
-      entry->texture->Save(fmt::format("{}{}_n{:06}_{}.png", File::GetUserPath(D_DUMPTEXTURES_IDX),
-                                       XFB_DUMP_PREFIX, xfb_count++, id),
-                           0);
+      SaveTextureAsync(entry->texture.get(),
+                       fmt::format("{}{}_n{:06}_{}.png", File::GetUserPath(D_DUMPTEXTURES_IDX),
+                                   XFB_DUMP_PREFIX, xfb_count++, id),
+                       0);
     }
   }
 
@@ -1849,8 +2056,14 @@ void TextureCacheBase::StitchXFBCopy(TCacheEntry* stitched_entry)
     // our force progressive hack means that an XFB copy should always have a matching stride. If
     // the hack is disabled, XFB2RAM should also be enabled. Should we wish to implement interlaced
     // stitching in the future, this would require a shader which grabs every second line.
+    //
+    // Copies that were already stitched into this entry are skipped, as in DoPartialTextureUpdates.
+    // A reused XFB container is then only drawn to when a new copy overlaps it, instead of every
+    // time it is presented. Newer copies have higher IDs, so applying only the new ones gives the
+    // same result as applying all of them again.
     TCacheEntry* entry = iter.first->second;
     if (entry != stitched_entry && entry->IsCopy() && !entry->tmem_only &&
+        entry->references.count(stitched_entry) == 0 &&
         entry->OverlapsMemoryRange(stitched_entry->addr, stitched_entry->size_in_bytes) &&
         entry->memory_stride == stitched_entry->memory_stride)
     {
@@ -2143,7 +2356,12 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   const u32 bytes_per_row = num_blocks_x * bytes_per_block;
   const u32 covered_range = num_blocks_y * dstStride;
 
-  if (g_ActiveConfig.bGraphicMods)
+  // Lazily flushed copies of the same memory would overwrite this copy once they're written.
+  FlushLazyEFBCopies(dstAddr, covered_range);
+
+  const GraphicsModManager& graphics_mod_manager = g_renderer->GetGraphicsModManager();
+  if (g_ActiveConfig.bGraphicMods && (is_xfb_copy ? graphics_mod_manager.HasXFBActions() :
+                                                    graphics_mod_manager.HasEFBActions()))
   {
     FBInfo info;
     info.m_width = tex_w;
@@ -2151,7 +2369,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     info.m_texture_format = baseFormat;
     if (is_xfb_copy)
     {
-      for (const auto action : g_renderer->GetGraphicsModManager().GetXFBActions(info))
+      for (const auto action : graphics_mod_manager.GetXFBActions(info))
       {
         action->OnXFB();
       }
@@ -2160,7 +2378,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     {
       bool skip = false;
       GraphicsModActionData::EFB efb{tex_w, tex_h, &skip, &scaled_tex_w, &scaled_tex_h};
-      for (const auto action : g_renderer->GetGraphicsModManager().GetEFBActions(info))
+      for (const auto action : graphics_mod_manager.GetEFBActions(info))
       {
         action->OnEFB(&efb);
       }
@@ -2232,10 +2450,10 @@ void TextureCacheBase::CopyRenderTargetToTexture(
 
         if (g_ActiveConfig.bDumpXFBTarget)
         {
-          entry->texture->Save(fmt::format("{}{}_n{:06}_{}.png",
-                                           File::GetUserPath(D_DUMPTEXTURES_IDX), XFB_DUMP_PREFIX,
-                                           xfb_count++, id),
-                               0);
+          SaveTextureAsync(entry->texture.get(),
+                           fmt::format("{}{}_n{:06}_{}.png", File::GetUserPath(D_DUMPTEXTURES_IDX),
+                                       XFB_DUMP_PREFIX, xfb_count++, id),
+                           0);
         }
       }
       else if (g_ActiveConfig.bDumpEFBTarget || g_ActiveConfig.bGraphicMods)
@@ -2249,10 +2467,10 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         if (g_ActiveConfig.bDumpEFBTarget)
         {
           static int efb_count = 0;
-          entry->texture->Save(fmt::format("{}{}_n{:06}_{}.png",
-                                           File::GetUserPath(D_DUMPTEXTURES_IDX), EFB_DUMP_PREFIX,
-                                           efb_count++, id),
-                               0);
+          SaveTextureAsync(entry->texture.get(),
+                           fmt::format("{}{}_n{:06}_{}.png", File::GetUserPath(D_DUMPTEXTURES_IDX),
+                                       EFB_DUMP_PREFIX, efb_count++, id),
+                           0);
         }
       }
     }
@@ -2383,25 +2601,113 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
-    textures_by_address.emplace(dstAddr, entry);
+    AddTextureByAddress(dstAddr, entry);
   }
 }
 
 void TextureCacheBase::FlushEFBCopies()
 {
-  if (m_pending_efb_copies.empty())
+  if (m_pending_efb_copies.empty() && m_lazy_efb_copies.empty())
+    return;
+
+  if (!CanFlushEFBCopiesLazily())
+  {
+    FlushAllEFBCopies();
+    return;
+  }
+
+  // Instead of waiting for the copies to finish, watch their memory and write them to it once the
+  // CPU accesses it, which many games never do.
+  for (TCacheEntry* entry : m_pending_efb_copies)
+  {
+    const u32 size = GetPendingEFBCopySize(*entry);
+    if (Memory::WatchAccesses(Memory::GetPointer(entry->addr), size))
+    {
+      m_lazy_efb_copies.push_back(entry);
+    }
+    else
+    {
+      FlushLazyEFBCopies(entry->addr, size);
+      FlushEFBCopy(entry);
+    }
+  }
+  m_pending_efb_copies.clear();
+
+  while (m_lazy_efb_copies.size() > MAX_LAZY_EFB_COPIES)
+  {
+    FlushEFBCopy(m_lazy_efb_copies.front());
+    m_lazy_efb_copies.erase(m_lazy_efb_copies.begin());
+  }
+}
+
+void TextureCacheBase::FlushLazyEFBCopies(u32 address, u32 size)
+{
+  if (m_lazy_efb_copies.empty())
     return;
 
+  // Going from the newest copy to the oldest, a copy has to be written if it overlaps the range
+  // or a newer copy which is written.
+  std::vector<std::pair<u32, u32>> written_ranges{{address, size}};
+  std::vector<bool> write_copy(m_lazy_efb_copies.size());
+  for (size_t i = m_lazy_efb_copies.size(); i-- > 0;)
+  {
+    const TCacheEntry* entry = m_lazy_efb_copies[i];
+    const u32 entry_size = GetPendingEFBCopySize(*entry);
+    write_copy[i] = std::any_of(written_ranges.begin(), written_ranges.end(),
+                                [entry, entry_size](const std::pair<u32, u32>& range) {
+                                  return entry->addr < range.first + range.second &&
+                                         range.first < entry->addr + entry_size;
+                                });
+    if (write_copy[i])
+      written_ranges.emplace_back(entry->addr, entry_size);
+  }
+
+  size_t num_kept = 0;
+  for (size_t i = 0; i < m_lazy_efb_copies.size(); ++i)
+  {
+    if (write_copy[i])
+      FlushEFBCopy(m_lazy_efb_copies[i]);
+    else
+      m_lazy_efb_copies[num_kept++] = m_lazy_efb_copies[i];
+  }
+  m_lazy_efb_copies.resize(num_kept);
+
+  // Access watches end for whole pages, which may contain other copies as well.
+  WatchLazyEFBCopies();
+}
+
+void TextureCacheBase::FlushAllEFBCopies()
+{
+  // The lazily flushed copies are older than the pending ones.
+  for (TCacheEntry* entry : m_lazy_efb_copies)
+    FlushEFBCopy(entry);
+  m_lazy_efb_copies.clear();
+
   for (TCacheEntry* entry : m_pending_efb_copies)
     FlushEFBCopy(entry);
   m_pending_efb_copies.clear();
 }
 
+bool TextureCacheBase::CanFlushEFBCopiesLazily() const
+{
+  // The deterministic GPU thread mode can't have the GPU thread interrupt the CPU thread.
+  return g_ActiveConfig.bWritebackEFBCopiesOnAccess && Memory::IsAccessWatchEnabled() &&
+         !Fifo::UseDeterministicGPUThread();
+}
+
+void TextureCacheBase::WatchLazyEFBCopies()
+{
+  for (const TCacheEntry* entry : m_lazy_efb_copies)
+    Memory::WatchAccesses(Memory::GetPointer(entry->addr), GetPendingEFBCopySize(*entry));
+}
+
 void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32 stride,
                                          std::unique_ptr<AbstractStagingTexture> staging_texture)
 {
   MathUtil::Rectangle<int> copy_rect(0, 0, static_cast<int>(width), static_cast<int>(height));
-  staging_texture->ReadTexels(copy_rect, dst_ptr, stride);
+  const size_t size = size_t{height - 1} * stride + width * sizeof(u32);
+  Memory::WriteAccessWatchedMemory(
+      dst_ptr, size, [&] { staging_texture->ReadTexels(copy_rect, dst_ptr, stride); });
   ReleaseEFBCopyStagingTexture(std::move(staging_texture));
 }
 
@@ -2474,12 +2780,15 @@ void TextureCacheBase::UninitializeEFBMemory(u8* dst, u32 stride, u32 bytes_per_
   // Hack: Most games don't actually need the correct texture data in RAM
   //       and we can just keep a copy in VRAM. We zero the memory so we
   //       can check it hasn't changed before using our copy in VRAM.
-  u8* ptr = dst;
-  for (u32 i = 0; i < num_blocks_y; i++)
-  {
-    std::memset(ptr, 0, bytes_per_row);
-    ptr += stride;
-  }
+  const size_t size = size_t{num_blocks_y - 1} * stride + bytes_per_row;
+  Memory::WriteAccessWatchedMemory(dst, size, [&] {
+    u8* ptr = dst;
+    for (u32 i = 0; i < num_blocks_y; i++)
+    {
+      std::memset(ptr, 0, bytes_per_row);
+      ptr += stride;
+    }
+  });
 }
 
 void TextureCacheBase::UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row,
@@ -2497,31 +2806,34 @@ void TextureCacheBase::UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_
   __m128i sixteenBytes = _mm_set1_epi16((s16)(u16)0xFE01);
 #endif
 
-  for (u32 i = 0; i < num_blocks_y; i++)
-  {
-    u32 size = bytes_per_row;
-    u8* rowdst = dst;
-#if defined(_M_X86) || defined(_M_X86_64)
-    while (size >= 16)
-    {
-      _mm_storeu_si128((__m128i*)rowdst, sixteenBytes);
-      size -= 16;
-      rowdst += 16;
-    }
-#endif
-    for (u32 offset = 0; offset < size; offset++)
+  const size_t total_size = size_t{num_blocks_y - 1} * stride + bytes_per_row;
+  Memory::WriteAccessWatchedMemory(dst, total_size, [&] {
+    for (u32 i = 0; i < num_blocks_y; i++)
     {
-      if (offset & 1)
+      u32 size = bytes_per_row;
+      u8* rowdst = dst;
+#if defined(_M_X86) || defined(_M_X86_64)
+      while (size >= 16)
       {
-        rowdst[offset] = 254;
+        _mm_storeu_si128((__m128i*)rowdst, sixteenBytes);
+        size -= 16;
+        rowdst += 16;
       }
-      else
+#endif
+      for (u32 offset = 0; offset < size; offset++)
       {
-        rowdst[offset] = 1;
+        if (offset & 1)
+        {
+          rowdst[offset] = 254;
+        }
+        else
+        {
+          rowdst[offset] = 1;
+        }
       }
+      dst += stride;
     }
-    dst += stride;
-  }
+  });
 }
 
 TextureCacheBase::TCacheEntry* TextureCacheBase::AllocateCacheEntry(const TextureConfig& config)
@@ -2603,16 +2915,22 @@ TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
   return textures_by_address.end();
 }
 
+TextureCacheBase::TexAddrCache::iterator TextureCacheBase::AddTextureByAddress(u32 addr,
+                                                                               TCacheEntry* entry)
+{
+  ++texture_size_counts[entry->size_in_bytes];
+  return textures_by_address.emplace(addr, entry);
+}
+
 std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
 TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
 {
   // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
+  // which end after the given addr. But the textures have a limited size, so we
+  // look for all textures which have a start address bigger than addr minus the size
+  // of the largest live texture. But this yields false-positives which must be checked later on.
+  const u32 max_texture_size =
+      texture_size_counts.empty() ? 0 : texture_size_counts.rbegin()->first;
   u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
   auto begin = textures_by_address.lower_bound(lower_addr);
   auto end = textures_by_address.upper_bound(addr + size_in_bytes);
@@ -2620,6 +2938,125 @@ TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
   return std::make_pair(begin, end);
 }
 
+void TextureCacheBase::EnforceMemoryBudget(int frame_count)
+{
+  u64 cache_memory = 0;
+  for (const auto& it : textures_by_address)
+    cache_memory += it.second->texture->GetConfig().GetMemorySize();
+  u64 pool_memory = 0;
+  for (const auto& it : texture_pool)
+    pool_memory += it.first.GetMemorySize();
+
+  u64 budget = std::numeric_limits<u64>::max();
+  if (g_ActiveConfig.iTextureCacheBudgetMB > 0)
+    budget = static_cast<u64>(g_ActiveConfig.iTextureCacheBudgetMB) * 1024 * 1024;
+
+  const std::optional<Renderer::VideoMemoryInfo> video_memory = g_renderer->GetVideoMemoryInfo();
+  if (video_memory)
+  {
+    // Free up as much as the whole process is over its budget, as far as the cache can.
+    const u64 process_budget =
+        video_memory->budget / 100 * (100 - VIDEO_MEMORY_BUDGET_HEADROOM_PERCENT);
+    if (video_memory->usage > process_budget)
+    {
+      const u64 excess = video_memory->usage - process_budget;
+      const u64 texture_memory = cache_memory + pool_memory;
+      budget = std::min(budget, texture_memory > excess ? texture_memory - excess : 0);
+    }
+  }
+
+  const auto update_stats = [&] {
+    constexpr u64 MiB = 1024 * 1024;
+    SETSTAT(g_stats.texture_cache_memory_mb, cache_memory / MiB);
+    SETSTAT(g_stats.texture_pool_memory_mb, pool_memory / MiB);
+    SETSTAT(g_stats.video_memory_usage_mb, video_memory ? video_memory->usage / MiB : 0);
+    SETSTAT(g_stats.video_memory_budget_mb, video_memory ? video_memory->budget / MiB : 0);
+  };
+  const auto trim_pool = [&] {
+    for (auto iter = texture_pool.begin();
+         iter != texture_pool.end() && cache_memory + pool_memory > budget;)
+    {
+      pool_memory -= iter->first.GetMemorySize();
+      iter = texture_pool.erase(iter);
+    }
+  };
+
+  trim_pool();
+  if (cache_memory + pool_memory <= budget)
+  {
+    update_stats();
+    return;
+  }
+
+  struct EvictionCandidate
+  {
+    TCacheEntry* entry;
+    u64 size;
+    double priority;
+  };
+  std::vector<EvictionCandidate> candidates;
+  for (const auto& it : textures_by_address)
+  {
+    TCacheEntry* entry = it.second;
+    if (!CanEvictForMemoryBudget(entry, frame_count))
+      continue;
+
+    // Prefer the textures which were reused the longest time ago, and the largest ones.
+    const u64 size = entry->texture->GetConfig().GetMemorySize();
+    const double cost = entry->IsCopy()       ? EFB_COPY_EVICTION_COST :
+                        entry->is_custom_tex ? CUSTOM_TEXTURE_EVICTION_COST :
+                                               1.0;
+    const double priority = static_cast<double>(frame_count - entry->frameCount) *
+                            static_cast<double>(size) / cost;
+    candidates.push_back({entry, size, priority});
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const EvictionCandidate& a, const EvictionCandidate& b) {
+              return a.priority > b.priority;
+            });
+
+  u32 num_evicted = 0;
+  for (const EvictionCandidate& candidate : candidates)
+  {
+    if (cache_memory + pool_memory <= budget)
+      break;
+
+    InvalidateTexture(GetTexCacheIter(candidate.entry));
+    cache_memory -= candidate.size;
+    pool_memory += candidate.size;
+    num_evicted++;
+  }
+  trim_pool();
+
+  DEBUG_LOG_FMT(VIDEO, "Evicted {} textures to stay within {} MiB of texture memory", num_evicted,
+                budget / (1024 * 1024));
+  ADDSTAT(g_stats.num_textures_evicted, num_evicted);
+  SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
+  update_stats();
+}
+
+bool TextureCacheBase::CanEvictForMemoryBudget(const TCacheEntry* entry, int frame_count) const
+{
+  // Textures used in the current frame would just be recreated right away.
+  if (entry->frameCount == FRAMECOUNT_INVALID || entry->frameCount >= frame_count ||
+      entry->tmem_only || entry->pending_efb_copy)
+  {
+    return false;
+  }
+
+  if (std::find(bound_textures.begin(), bound_textures.end(), entry) != bound_textures.end())
+    return false;
+
+  // Copies which were never written to RAM can't be recreated at all.
+  if ((entry->is_efb_copy && g_ActiveConfig.bSkipEFBCopyToRam) ||
+      (entry->is_xfb_copy && g_ActiveConfig.bSkipXFBCopyToRam))
+  {
+    return false;
+  }
+
+  return true;
+}
+
 TextureCacheBase::TexAddrCache::iterator
 TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pending_efb_copy)
 {
@@ -2628,6 +3065,10 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
 
   TCacheEntry* entry = iter->second;
 
+  const auto size_count = texture_size_counts.find(entry->size_in_bytes);
+  if (size_count != texture_size_counts.end() && --size_count->second == 0)
+    texture_size_counts.erase(size_count);
+
   if (entry->textures_by_hash_iter != textures_by_hash.end())
   {
     textures_by_hash.erase(entry->textures_by_hash_iter);
@@ -2673,6 +3114,9 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
       auto pending_it = std::find(m_pending_efb_copies.begin(), m_pending_efb_copies.end(), entry);
       if (pending_it != m_pending_efb_copies.end())
         m_pending_efb_copies.erase(pending_it);
+      auto lazy_it = std::find(m_lazy_efb_copies.begin(), m_lazy_efb_copies.end(), entry);
+      if (lazy_it != m_lazy_efb_copies.end())
+        m_lazy_efb_copies.erase(lazy_it);
     }
     else
     {
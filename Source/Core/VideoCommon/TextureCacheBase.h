@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <fmt/format.h>
 #include <map>
@@ -19,6 +20,7 @@
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
@@ -27,6 +29,7 @@
 
 class AbstractFramebuffer;
 class AbstractStagingTexture;
+class HiresTexture;
 class PointerWrap;
 struct VideoConfig;
 
@@ -122,6 +125,9 @@ public:
     u32 memory_stride = 0;
     bool is_efb_copy = false;
     bool is_custom_tex = false;
+    // Custom texture which was still loading when this entry was created. The entry is recreated
+    // once it's done.
+    std::shared_ptr<HiresTexture> pending_custom_tex;
     bool may_have_overlapping_textures = true;
     bool tmem_only = false;           // indicates that this texture only exists in the tmem cache
     bool has_arbitrary_mips = false;  // indicates that the mips in this texture are arbitrary
@@ -133,6 +139,11 @@ public:
 
     bool reference_changed = false;  // used by xfb to determine when a reference xfb changed
 
+    // For textures read from TMEM, where the data was and when it was hashed. While that part of
+    // TMEM hasn't been written since, base_hash is still up to date.
+    const u8* tmem_data = nullptr;
+    u64 tmem_write_stamp = 0;
+
     // Texture dimensions from the GameCube's point of view
     u32 native_width = 0;
     u32 native_height = 0;
@@ -258,9 +269,14 @@ public:
 
   void ScaleTextureCacheEntryTo(TCacheEntry* entry, u32 new_width, u32 new_height);
 
-  // Flushes all pending EFB copies to emulated RAM.
+  // Flushes all pending EFB copies to emulated RAM. With bWritebackEFBCopiesOnAccess, they're
+  // only written once the CPU accesses their memory instead.
   void FlushEFBCopies();
 
+  // Writes the lazily flushed EFB copies which overlap the range to emulated RAM, along with any
+  // older copies overlapping those, so that the copies still land in the order they were issued.
+  void FlushLazyEFBCopies(u32 address, u32 size);
+
   // Texture Serialization
   void SerializeTexture(AbstractTexture* tex, const TextureConfig& config, PointerWrap& p);
   std::optional<TexPoolEntry> DeserializeTexture(PointerWrap& p);
@@ -310,6 +326,9 @@ private:
 
   TCacheEntry* GetXFBFromCache(u32 address, u32 width, u32 height, u32 stride);
 
+  // Returns an entry for the same TMEM texture data, if it's still unchanged.
+  const TCacheEntry* FindUnchangedTmemEntry(const TextureInfo& texture_info) const;
+
   TCacheEntry* ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLUTFormat tlutfmt);
 
   TCacheEntry* ReinterpretEntry(const TCacheEntry* existing_entry, TextureFormat new_format);
@@ -318,7 +337,19 @@ private:
                                        TLUTFormat tlutfmt);
   void StitchXFBCopy(TCacheEntry* entry_to_update);
 
+  struct TextureDump
+  {
+    std::string filename;
+    std::vector<u8> data;
+    u32 width;
+    u32 height;
+    int compression_level;
+  };
+
   void DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level, bool is_arbitrary);
+  // Reads the level back now, and encodes and writes the PNG on one of the dump threads.
+  void SaveTextureAsync(AbstractTexture* texture, std::string filename, unsigned int level);
+  void WriteTextureDump(TextureDump dump);
   void CheckTempSize(size_t required_size);
 
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
@@ -326,11 +357,19 @@ private:
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
+  // Adds an entry to textures_by_address. The entry's size must not change until it's removed.
+  TexAddrCache::iterator AddTextureByAddress(u32 addr, TCacheEntry* entry);
+
   // Return all possible overlapping textures. As addr+size of the textures is not
   // indexed, this may return false positives.
   std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
   FindOverlappingTextures(u32 addr, u32 size_in_bytes);
 
+  // Evicts textures until the cache fits into its video memory budget, starting with the free
+  // textures in the pool, followed by the entries which are the cheapest to lose.
+  void EnforceMemoryBudget(int frame_count);
+  bool CanEvictForMemoryBudget(const TCacheEntry* entry, int frame_count) const;
+
   // Removes and unlinks texture from texture cache and returns it to the pool
   TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter,
                                            bool discard_pending_efb_copy = false);
@@ -348,6 +387,11 @@ private:
   void WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32 stride,
                          std::unique_ptr<AbstractStagingTexture> staging_texture);
   void FlushEFBCopy(TCacheEntry* entry);
+  // Writes every pending and lazily flushed EFB copy to emulated RAM.
+  void FlushAllEFBCopies();
+  bool CanFlushEFBCopiesLazily() const;
+  // Watches the memory of the lazily flushed EFB copies again after it was written to.
+  void WatchLazyEFBCopies();
 
   // Returns a staging texture of the maximum EFB copy size.
   std::unique_ptr<AbstractStagingTexture> GetEFBCopyStagingTexture();
@@ -355,15 +399,31 @@ private:
   // Returns an EFB copy staging texture to the pool, so it can be re-used.
   void ReleaseEFBCopyStagingTexture(std::unique_ptr<AbstractStagingTexture> tex);
 
+  // Hashes texture data in RAM. With bWatchTextureWrites, the hash of the same range is reused
+  // until the memory is written to.
+  u64 GetTextureDataHash(const u8* ptr, u32 size, u32 samples);
+
   bool CheckReadbackTexture(u32 width, u32 height, AbstractTextureFormat format);
   void DoSaveState(PointerWrap& p);
   void DoLoadState(PointerWrap& p);
 
   TexAddrCache textures_by_address;
+  // Number of entries in textures_by_address for each size, so that overlap queries only need to
+  // look back as far as the largest live texture.
+  std::map<u32, u32> texture_size_counts;
   TexHashCache textures_by_hash;
   TexPool texture_pool;
   u64 last_entry_id = 0;
 
+  struct WatchedTextureHash
+  {
+    u64 hash = 0;
+    u64 write_watch_token = 0;
+    u32 samples = 0;
+    int frameCount = FRAMECOUNT_INVALID;
+  };
+  std::map<std::pair<const u8*, u32>, WatchedTextureHash> m_watched_texture_hashes;
+
   // Backup configuration values
   struct BackupConfig
   {
@@ -372,6 +432,7 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    bool async_hires_textures;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
@@ -397,10 +458,29 @@ private:
   // so that overlapping textures are written to guest RAM in the order they are issued.
   std::vector<TCacheEntry*> m_pending_efb_copies;
 
+  // EFB copies which have been flushed while bWritebackEFBCopiesOnAccess was enabled, but are only
+  // written to guest RAM once the CPU accesses their memory. They're older than the pending copies
+  // and kept in the order they were issued as well.
+  std::vector<TCacheEntry*> m_lazy_efb_copies;
+
   // Staging texture used for readbacks.
   // We store this in the class so that the same staging texture can be used for multiple
   // readbacks, saving the overhead of allocating a new buffer every time.
   std::unique_ptr<AbstractStagingTexture> m_readback_texture;
+
+  // Files which have been dumped or queued for dumping, so that textures which are loaded again
+  // aren't looked up on disk every time.
+  std::unordered_set<std::string> m_dumped_textures;
+
+  // Size of the texture data waiting on the dump threads. Past MAX_QUEUED_DUMP_BYTES, textures are
+  // saved on the video thread instead, which bounds the memory used and slows emulation down to
+  // the pace of the dump threads.
+  static constexpr size_t MAX_QUEUED_DUMP_BYTES = 256 * 1024 * 1024;
+  std::atomic<size_t> m_queued_dump_bytes = 0;
+  // Started on the first dump. Destroying them writes the dumps which are still queued.
+  std::array<Common::WorkQueueThread<TextureDump>, 2> m_dump_threads;
+  bool m_dump_threads_started = false;
+  size_t m_next_dump_thread = 0;
 };
 
 extern std::unique_ptr<TextureCacheBase> g_texture_cache;
@@ -38,3 +38,15 @@ size_t TextureConfig::GetMipStride(u32 level) const
 {
   return AbstractTexture::CalculateStrideForFormat(format, std::max(width >> level, 1u));
 }
+
+size_t TextureConfig::GetMemorySize() const
+{
+  const bool compressed = AbstractTexture::IsCompressedFormat(format);
+  size_t size = 0;
+  for (u32 level = 0; level < levels; level++)
+  {
+    const u32 mip_height = std::max(height >> level, 1u);
+    size += GetMipStride(level) * (compressed ? (mip_height + 3) / 4 : mip_height);
+  }
+  return size * layers * samples;
+}
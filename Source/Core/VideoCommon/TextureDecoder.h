@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <span>
 #include <tuple>
 #include "Common/CommonTypes.h"
 #include "Common/EnumFormatter.h"
@@ -182,6 +183,23 @@ TextureFormat TexDecoder_GetEFBCopyBaseFormat(EFBCopyFormat format);
 
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
                        const u8* tlut, TLUTFormat tlutfmt);
+
+// Arguments of one TexDecoder_Decode call.
+struct TexDecoderJob
+{
+  u8* dst;
+  const u8* src;
+  int width;
+  int height;
+  TextureFormat texformat;
+  const u8* tlut;
+  TLUTFormat tlutfmt;
+};
+
+// Decodes all jobs like TexDecoder_Decode, and returns once they are done. Large textures are
+// split into bands of block rows, which num_threads worker threads decode alongside the calling
+// thread. With num_threads = 0, everything is decoded on the calling thread.
+void TexDecoder_DecodeJobs(std::span<const TexDecoderJob> jobs, int num_threads);
 void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
                                     int height);
 void TexDecoder_DecodeTexel(u8* dst, const u8* src, int s, int t, int imageWidth,
@@ -2,12 +2,21 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/MsgHandler.h"
+#include "Common/PerformanceTrace.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -304,6 +313,160 @@ void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFor
     TexDecoder_DrawOverlay(dst, width, height, texformat);
 }
 
+namespace
+{
+// Bands smaller than this aren't worth waking up a worker for.
+constexpr int MIN_TEXELS_PER_BAND = 256 * 256;
+
+// Rows [first_row, first_row + num_rows) of a job, which are a whole number of block rows.
+struct DecodeBand
+{
+  const TexDecoderJob* job;
+  int first_row;
+  int num_rows;
+};
+
+void DecodeBandImpl(const DecodeBand& band)
+{
+  const TexDecoderJob& job = *band.job;
+  const int block_height = TexDecoder_GetBlockHeightInTexels(job.texformat);
+  const int block_row_size = TexDecoder_GetTextureSizeInBytes(job.width, block_height,
+                                                              job.texformat);
+  _TexDecoder_DecodeImpl(reinterpret_cast<u32*>(job.dst) + band.first_row * job.width,
+                         job.src + band.first_row / block_height * block_row_size, job.width,
+                         band.num_rows, job.texformat, job.tlut, job.tlutfmt);
+}
+
+// Threads which decode bands of large textures alongside the video thread.
+class TextureDecoderWorkers
+{
+public:
+  ~TextureDecoderWorkers() { Resize(0); }
+
+  size_t Size() const { return m_workers.size(); }
+
+  void Resize(size_t num_workers)
+  {
+    if (num_workers == m_workers.size())
+      return;
+
+    m_shutdown.Set();
+    for (auto& worker : m_workers)
+      worker->start.Set();
+    for (auto& worker : m_workers)
+      worker->thread.join();
+    m_workers.clear();
+    m_shutdown.Clear();
+
+    for (size_t i = 0; i < num_workers; ++i)
+    {
+      auto& worker = m_workers.emplace_back(std::make_unique<Worker>());
+      worker->thread = std::thread(&TextureDecoderWorkers::WorkerLoop, this, worker.get());
+    }
+  }
+
+  // Decodes the bands on the calling thread and the workers, and returns once all are decoded.
+  void Run(std::span<const DecodeBand> bands)
+  {
+    const size_t num_workers = std::min(m_workers.size(), bands.size() - 1);
+
+    m_bands = bands;
+    m_next_band.store(0, std::memory_order_relaxed);
+    m_pending.store(static_cast<u32>(num_workers), std::memory_order_relaxed);
+    for (size_t i = 0; i < num_workers; ++i)
+      m_workers[i]->start.Set();
+
+    DecodeBands();
+
+    if (num_workers > 0)
+      m_done.Wait();
+  }
+
+private:
+  struct Worker
+  {
+    std::thread thread;
+    Common::Event start;
+  };
+
+  void DecodeBands()
+  {
+    while (true)
+    {
+      const size_t index = m_next_band.fetch_add(1, std::memory_order_relaxed);
+      if (index >= m_bands.size())
+        return;
+      DecodeBandImpl(m_bands[index]);
+    }
+  }
+
+  void WorkerLoop(Worker* worker)
+  {
+    Common::SetCurrentThreadName("Texture decoder worker");
+
+    while (true)
+    {
+      worker->start.Wait();
+      if (m_shutdown.IsSet())
+        return;
+
+      DecodeBands();
+      if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_done.Set();
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::span<const DecodeBand> m_bands;
+  std::atomic<size_t> m_next_band{0};
+  std::atomic<u32> m_pending{0};
+  Common::Event m_done;
+  Common::Flag m_shutdown;
+};
+}  // namespace
+
+static TextureDecoderWorkers s_texture_decoder_workers;
+static std::vector<DecodeBand> s_decode_bands;
+
+void TexDecoder_DecodeJobs(std::span<const TexDecoderJob> jobs, int num_threads)
+{
+  Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::TextureDecoding);
+  s_texture_decoder_workers.Resize(static_cast<size_t>(std::max(num_threads, 0)));
+
+  int total_texels = 0;
+  for (const TexDecoderJob& job : jobs)
+    total_texels += job.width * job.height;
+
+  if (s_texture_decoder_workers.Size() == 0 || total_texels < 2 * MIN_TEXELS_PER_BAND)
+  {
+    for (const TexDecoderJob& job : jobs)
+    {
+      TexDecoder_Decode(job.dst, job.src, job.width, job.height, job.texformat, job.tlut,
+                        job.tlutfmt);
+    }
+    return;
+  }
+
+  // Small mip levels end up as one band each, and are picked up by whichever thread is free.
+  s_decode_bands.clear();
+  for (const TexDecoderJob& job : jobs)
+  {
+    const int block_height = TexDecoder_GetBlockHeightInTexels(job.texformat);
+    const int min_rows = MIN_TEXELS_PER_BAND / std::max(job.width, 1);
+    const int rows_per_band = std::max(block_height, min_rows / block_height * block_height);
+    for (int row = 0; row < job.height; row += rows_per_band)
+      s_decode_bands.push_back({&job, row, std::min(rows_per_band, job.height - row)});
+  }
+
+  s_texture_decoder_workers.Run(s_decode_bands);
+
+  if (TexFmt_Overlay_Enable)
+  {
+    for (const TexDecoderJob& job : jobs)
+      TexDecoder_DrawOverlay(job.dst, job.width, job.height, job.texformat);
+  }
+}
+
 static inline u32 DecodePixel_IA8(u16 val)
 {
   int a = val & 0xFF;
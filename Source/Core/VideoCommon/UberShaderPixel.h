@@ -20,6 +20,12 @@ struct pixel_ubershader_uid_data
   u32 uint_output : 1;
   u32 no_dual_src : 1;
 
+  // Partially specialized ubershaders bake in a few of the most expensive dynamic states. They
+  // are compiled on demand and used until the specialized shader is ready.
+  u32 partially_specialized : 1;
+  u32 num_stages : 4;
+  u32 alpha_test_passes : 1;
+
   u32 NumValues() const { return sizeof(pixel_ubershader_uid_data); }
 };
 #pragma pack()
@@ -27,6 +33,7 @@ struct pixel_ubershader_uid_data
 using PixelShaderUid = ShaderUid<pixel_ubershader_uid_data>;
 
 PixelShaderUid GetPixelShaderUid();
+void PartiallySpecializePixelShaderUid(PixelShaderUid* uid);
 
 ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
                           const pixel_ubershader_uid_data* uid_data);
@@ -43,9 +50,15 @@ struct fmt::formatter<UberShader::pixel_ubershader_uid_data>
   template <typename FormatContext>
   auto format(const UberShader::pixel_ubershader_uid_data& uid, FormatContext& ctx) const
   {
-    return fmt::format_to(
+    auto out = fmt::format_to(
         ctx.out(), "Pixel UberShader for {} texgens{}{}{}{}", uid.num_texgens,
         uid.early_depth ? ", early-depth" : "", uid.per_pixel_depth ? ", per-pixel depth" : "",
         uid.uint_output ? ", uint output" : "", uid.no_dual_src ? ", no dual-source blending" : "");
+    if (uid.partially_specialized)
+    {
+      out = fmt::format_to(out, ", {} TEV stages{}", uid.num_stages + 1,
+                           uid.alpha_test_passes ? ", alpha test passes" : "");
+    }
+    return out;
   }
 };
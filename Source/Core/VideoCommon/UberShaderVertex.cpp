@@ -36,7 +36,7 @@ ShaderCode GenVertexShader(APIType api_type, const ShaderHostConfig& host_config
   const bool per_pixel_lighting = host_config.per_pixel_lighting;
   const bool vertex_rounding = host_config.vertex_rounding;
   const u32 num_texgen = uid_data->num_texgens;
-  ShaderCode out;
+  ShaderCode out(32768);
 
   out.Write("// {}\n\n", *uid_data);
   out.Write("{}", s_lighting_struct);
@@ -6,6 +6,7 @@
 #include <array>
 
 #include "Common/CommonTypes.h"
+#include "Common/JitRegister.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -58,6 +59,9 @@ VertexLoaderARM64::VertexLoaderARM64(const TVtxDesc& vtx_desc, const VAT& vtx_at
   ClearCodeSpace();
   GenerateVertexLoader();
   WriteProtect();
+
+  JitRegister::Register(region, GetCodePtr(), "VertexLoaderARM64\nVtx desc: \n{}\nVAT:\n{}",
+                        vtx_desc, vtx_att);
 }
 
 // Returns the register to use as the base and an offset from that register.
@@ -520,6 +524,11 @@ void VertexLoaderARM64::GenerateVertexLoader()
 int VertexLoaderARM64::RunVertices(DataReader src, DataReader dst, int count)
 {
   m_numLoadedVertices += count;
+  return LoadVertices(src, dst, count);
+}
+
+int VertexLoaderARM64::LoadVertices(DataReader src, DataReader dst, int count) const
+{
   return ((int (*)(u8 * src, u8 * dst, int count)) region)(src.GetPointer(), dst.GetPointer(),
                                                            count - 1);
 }
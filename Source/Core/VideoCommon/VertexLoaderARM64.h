@@ -22,6 +22,8 @@ public:
 
 protected:
   int RunVertices(DataReader src, DataReader dst, int count) override;
+  bool SupportsParallelLoading() const override { return true; }
+  int LoadVertices(DataReader src, DataReader dst, int count) const override;
 
 private:
   u32 m_src_ofs = 0;
@@ -157,6 +157,29 @@ u32 VertexLoaderBase::GetVertexComponents(const TVtxDesc& vtx_desc, const VAT& v
   return components;
 }
 
+bool VertexLoaderBase::HasIndexedAttributes(const TVtxDesc& vtx_desc)
+{
+  if (IsIndexed(vtx_desc.low.Position) || IsIndexed(vtx_desc.low.Normal))
+    return true;
+  for (u32 i = 0; i < vtx_desc.low.Color.Size(); i++)
+  {
+    if (IsIndexed(vtx_desc.low.Color[i]))
+      return true;
+  }
+  for (u32 i = 0; i < vtx_desc.high.TexCoord.Size(); i++)
+  {
+    if (IsIndexed(vtx_desc.high.TexCoord[i]))
+      return true;
+  }
+  return false;
+}
+
+int VertexLoaderBase::LoadVertices(DataReader src, DataReader dst, int count) const
+{
+  ASSERT_MSG(VIDEO, false, "Vertex loader doesn't support parallel loading");
+  return 0;
+}
+
 std::unique_ptr<VertexLoaderBase> VertexLoaderBase::CreateVertexLoader(const TVtxDesc& vtx_desc,
                                                                        const VAT& vtx_attr)
 {
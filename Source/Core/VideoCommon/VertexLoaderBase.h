@@ -62,15 +62,25 @@ class VertexLoaderBase
 public:
   static u32 GetVertexSize(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
   static u32 GetVertexComponents(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
+  static bool HasIndexedAttributes(const TVtxDesc& vtx_desc);
   static std::unique_ptr<VertexLoaderBase> CreateVertexLoader(const TVtxDesc& vtx_desc,
                                                               const VAT& vtx_attr);
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(DataReader src, DataReader dst, int count) = 0;
 
+  // Whether LoadVertices may be called from several threads at once, on disjoint parts of the
+  // same draw. Such loaders write nothing but dst and the VertexLoaderManager caches.
+  virtual bool SupportsParallelLoading() const { return false; }
+  // Like RunVertices, but without updating any per-loader state.
+  // Only called if SupportsParallelLoading() returns true.
+  virtual int LoadVertices(DataReader src, DataReader dst, int count) const;
+
   // per loader public state
   PortableVertexDeclaration m_native_vtx_decl{};
   const u32 m_vertex_size;  // number of bytes of a raw GC vertex
   const u32 m_native_components;
+  // Whether any attribute is read from the vertex arrays in RAM rather than from the FIFO.
+  const bool m_has_indexed_attributes;
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
@@ -78,9 +88,10 @@ public:
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
-      : m_vertex_size{GetVertexSize(vtx_desc, vtx_attr)}, m_native_components{GetVertexComponents(
-                                                              vtx_desc, vtx_attr)},
-        m_VtxAttr{vtx_attr}, m_VtxDesc{vtx_desc}
+      : m_vertex_size{GetVertexSize(vtx_desc, vtx_attr)},
+        m_native_components{GetVertexComponents(vtx_desc, vtx_attr)},
+        m_has_indexed_attributes{HasIndexedAttributes(vtx_desc)}, m_VtxAttr{vtx_attr},
+        m_VtxDesc{vtx_desc}
   {
   }
 
@@ -4,17 +4,27 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/PerformanceTrace.h"
+#include "Common/Thread.h"
 
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/Memmap.h"
@@ -29,6 +39,7 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace VertexLoaderManager
@@ -57,6 +68,199 @@ bool g_bases_dirty;  // Main only
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_main_vertex_loaders;
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_preprocess_vertex_loaders;
 
+namespace
+{
+// Smaller parts of a draw aren't worth waking up a worker for.
+constexpr int MIN_VERTICES_PER_THREAD = 2048;
+
+struct VertexSlice
+{
+  DataReader src;
+  DataReader dst;
+  int count = 0;
+  int loaded = 0;
+};
+
+// Threads which load parts of large draws alongside the video thread.
+class VertexLoaderWorkers
+{
+public:
+  ~VertexLoaderWorkers() { Resize(0); }
+
+  size_t Size() const { return m_workers.size(); }
+
+  void Resize(size_t num_workers)
+  {
+    if (num_workers == m_workers.size())
+      return;
+
+    m_shutdown.Set();
+    for (auto& worker : m_workers)
+      worker->start.Set();
+    for (auto& worker : m_workers)
+      worker->thread.join();
+    m_workers.clear();
+    m_shutdown.Clear();
+
+    for (size_t i = 0; i < num_workers; ++i)
+    {
+      auto& worker = m_workers.emplace_back(std::make_unique<Worker>());
+      worker->thread = std::thread(&VertexLoaderWorkers::WorkerLoop, this, worker.get());
+    }
+  }
+
+  // Loads the first slice on the calling thread and the others on the workers, and returns once
+  // all of them are loaded. There must not be more slices than Size() + 1.
+  void Run(const VertexLoaderBase* loader, std::span<VertexSlice> slices)
+  {
+    ASSERT(slices.size() <= m_workers.size() + 1);
+
+    m_pending.store(static_cast<u32>(slices.size() - 1), std::memory_order_relaxed);
+    for (size_t i = 1; i < slices.size(); ++i)
+    {
+      Worker* worker = m_workers[i - 1].get();
+      worker->loader = loader;
+      worker->slice = &slices[i];
+      worker->start.Set();
+    }
+
+    VertexSlice& slice = slices[0];
+    slice.loaded = loader->LoadVertices(slice.src, slice.dst, slice.count);
+
+    if (slices.size() > 1)
+      m_done.Wait();
+  }
+
+private:
+  struct Worker
+  {
+    std::thread thread;
+    Common::Event start;
+    const VertexLoaderBase* loader = nullptr;
+    VertexSlice* slice = nullptr;
+  };
+
+  void WorkerLoop(Worker* worker)
+  {
+    Common::SetCurrentThreadName("Vertex loader worker");
+
+    while (true)
+    {
+      worker->start.Wait();
+      if (m_shutdown.IsSet())
+        return;
+
+      VertexSlice& slice = *worker->slice;
+      slice.loaded = worker->loader->LoadVertices(slice.src, slice.dst, slice.count);
+      if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_done.Set();
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::atomic<u32> m_pending{0};
+  Common::Event m_done;
+  Common::Flag m_shutdown;
+};
+}  // namespace
+
+static VertexLoaderWorkers s_vertex_loader_workers;
+static std::vector<VertexSlice> s_vertex_slices;
+static std::vector<u8> s_tail_vertex_buffer;
+static std::unordered_map<std::string_view, u16> s_unique_vertex_map;
+static std::vector<u8> s_unique_vertex_src;
+static std::vector<u16> s_vertex_remap;
+
+// Loads the last vertices of a draw into a scratch buffer, so that the zfreeze and tangent caches
+// end up as if the whole draw was loaded.
+static void ReloadTailVertices(VertexLoaderBase* loader, DataReader src, int count)
+{
+  const int num_tail_vertices =
+      std::min(count, static_cast<int>(std::tuple_size_v<decltype(position_cache)>));
+  const u32 src_stride = loader->m_vertex_size;
+  u8* const tail_src = src.GetPointer() + (count - num_tail_vertices) * src_stride;
+  s_tail_vertex_buffer.resize(num_tail_vertices * loader->m_native_vtx_decl.stride);
+  loader->RunVertices(DataReader(tail_src, tail_src + num_tail_vertices * src_stride),
+                      DataReader(s_tail_vertex_buffer.data(),
+                                 s_tail_vertex_buffer.data() + s_tail_vertex_buffer.size()),
+                      num_tail_vertices);
+}
+
+static bool ShouldLoadInParallel(const VertexLoaderBase* loader, int count)
+{
+  return g_ActiveConfig.iVertexLoaderThreads > 0 && count >= 2 * MIN_VERTICES_PER_THREAD &&
+         loader->SupportsParallelLoading();
+}
+
+// Splits the draw into contiguous slices, which are loaded into their part of dst at once.
+static int LoadVerticesInParallel(VertexLoaderBase* loader, DataReader src, DataReader dst,
+                                  int count)
+{
+  s_vertex_loader_workers.Resize(static_cast<size_t>(g_ActiveConfig.iVertexLoaderThreads));
+
+  const int max_slices = static_cast<int>(s_vertex_loader_workers.Size()) + 1;
+  const int num_slices = std::min(max_slices, count / MIN_VERTICES_PER_THREAD);
+  const u32 src_stride = loader->m_vertex_size;
+  const u32 dst_stride = loader->m_native_vtx_decl.stride;
+
+  s_vertex_slices.resize(num_slices);
+  int first = 0;
+  for (int i = 0; i < num_slices; ++i)
+  {
+    VertexSlice& slice = s_vertex_slices[i];
+    slice.count = count / num_slices + (i < count % num_slices ? 1 : 0);
+    u8* const slice_src = src.GetPointer() + first * src_stride;
+    u8* const slice_dst = dst.GetPointer() + first * dst_stride;
+    slice.src = DataReader(slice_src, slice_src + slice.count * src_stride);
+    slice.dst = DataReader(slice_dst, slice_dst + slice.count * dst_stride);
+    first += slice.count;
+  }
+
+  s_vertex_loader_workers.Run(loader, s_vertex_slices);
+
+  // Vertices with skipped indices leave gaps at the end of their slice, so close those.
+  u8* out = dst.GetPointer();
+  int loaded = 0;
+  for (VertexSlice& slice : s_vertex_slices)
+  {
+    if (slice.dst.GetPointer() != out)
+      std::memmove(out, slice.dst.GetPointer(), slice.loaded * dst_stride);
+    out += slice.loaded * dst_stride;
+    loaded += slice.loaded;
+  }
+
+  // Every slice wrote its own last vertices to the zfreeze and tangent caches.
+  ReloadTailVertices(loader, src, count);
+
+  loader->m_numLoadedVertices += count;
+  return loaded;
+}
+
+static int LoadVertices(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+{
+  if (ShouldLoadInParallel(loader, count))
+    return LoadVerticesInParallel(loader, src, dst, count);
+  return loader->RunVertices(src, dst, count);
+}
+
+static int LoadVerticesCached(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+{
+  const u32 src_size = count * loader->m_vertex_size;
+  u64 hash = 0;
+  const int cached_count = g_vertex_manager->GetCachedVertices(loader, src.GetPointer(), src_size,
+                                                               dst.GetPointer(), &hash);
+  if (cached_count >= 0)
+  {
+    ReloadTailVertices(loader, src, count);
+    return cached_count;
+  }
+
+  const int loaded = LoadVertices(loader, src, dst, count);
+  g_vertex_manager->CacheVertices(hash, loader, src.GetPointer(), src_size, dst.GetPointer(),
+                                  loaded, loader->m_native_vtx_decl.stride);
+  return loaded;
+}
+
 void Init()
 {
   MarkAllDirty();
@@ -69,6 +273,8 @@ void Init()
 
 void Clear()
 {
+  s_vertex_loader_workers.Resize(0);
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
@@ -326,6 +532,43 @@ static void CheckCPConfiguration(int vtx_attr_group)
   }
 }
 
+// The vertices of indexed draws are often used by several primitives. As identical raw vertices
+// are converted to identical vertices, each distinct one only needs to be loaded once.
+// Returns false if the draw wasn't loaded, as it has no duplicates or some vertices were skipped.
+static bool RunDeduplicatedVertices(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                                    DataReader src, DataReader dst, int count)
+{
+  const u32 vertex_size = loader->m_vertex_size;
+  s_unique_vertex_map.clear();
+  s_unique_vertex_src.clear();
+  s_vertex_remap.resize(count);
+  for (int i = 0; i < count; ++i)
+  {
+    const char* vertex = reinterpret_cast<const char*>(src.GetPointer() + i * vertex_size);
+    const auto [iter, inserted] = s_unique_vertex_map.try_emplace(
+        std::string_view(vertex, vertex_size), static_cast<u16>(s_unique_vertex_map.size()));
+    if (inserted)
+      s_unique_vertex_src.insert(s_unique_vertex_src.end(), vertex, vertex + vertex_size);
+    s_vertex_remap[i] = iter->second;
+  }
+
+  const int num_unique = static_cast<int>(s_unique_vertex_map.size());
+  if (num_unique == count)
+    return false;
+
+  DataReader unique_src(s_unique_vertex_src.data(),
+                        s_unique_vertex_src.data() + s_unique_vertex_src.size());
+  if (LoadVertices(loader, unique_src, dst, num_unique) != num_unique)
+    return false;
+
+  // The caches were written with the last unique vertices rather than the last vertices.
+  ReloadTailVertices(loader, src, count);
+
+  g_vertex_manager->AddRemappedIndices(primitive, count, s_vertex_remap.data(), num_unique);
+  g_vertex_manager->FlushData(num_unique, loader->m_native_vtx_decl.stride);
+  return true;
+}
+
 template <bool IsPreprocess>
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, DataReader src)
 {
@@ -352,6 +595,8 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     {
       g_vertex_manager->Flush();
     }
+    if (loader->m_native_components != g_current_components)
+      g_vertex_manager->SetVertexShaderUidChanged();
     s_current_vtx_fmt = loader->m_native_vertex_format;
     g_current_components = loader->m_native_components;
     VertexShaderManager::SetVertexFormat(loader->m_native_components,
@@ -366,10 +611,19 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     DataReader dst = g_vertex_manager->PrepareForAdditionalData(
         primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-    count = loader->RunVertices(src, dst, count);
-
-    g_vertex_manager->AddIndices(primitive, count);
-    g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
+    Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::VertexLoading);
+    if (!g_ActiveConfig.bDeduplicateVertices || !loader->m_has_indexed_attributes ||
+        !RunDeduplicatedVertices(loader, primitive, src, dst, count))
+    {
+      // Indexed attributes are read from RAM, which the cache can't check cheaply.
+      if (g_ActiveConfig.bCacheConvertedVertices && !loader->m_has_indexed_attributes)
+        count = LoadVerticesCached(loader, src, dst, count);
+      else
+        count = LoadVertices(loader, src, dst, count);
+
+      g_vertex_manager->AddIndices(primitive, count);
+      g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
+    }
 
     ADDSTAT(g_stats.this_frame.num_prims, count);
     INCSTAT(g_stats.this_frame.num_primitive_joins);
@@ -31,6 +31,9 @@ static const X64Reg scratch3 = ABI_PARAM4;
 static const X64Reg remaining_reg = R10;
 static const X64Reg skipped_reg = R11;
 static const X64Reg base_reg = RBX;
+// Callee-saved on both ABIs, and not used by anything else.
+static constexpr std::array<X64Reg, 2> array_base_regs = {R12, R14};
+static constexpr std::array<X64Reg, 2> array_stride_regs = {R13, R15};
 
 static const u8* memory_base_ptr = (u8*)&g_main_cp_state.array_strides;
 
@@ -56,6 +59,35 @@ VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
                         vtx_att);
 }
 
+void VertexLoaderX64::AssignArrayRegisters()
+{
+  const auto assign = [this](CPArray array, VertexComponentFormat attribute) {
+    if (!IsIndexed(attribute) || m_num_array_registers == m_array_registers.size())
+      return;
+    m_array_registers[m_num_array_registers] = {array, array_base_regs[m_num_array_registers],
+                                                array_stride_regs[m_num_array_registers]};
+    m_num_array_registers++;
+  };
+
+  // In the order the attributes are read, so the earliest ones get the registers.
+  assign(CPArray::Position, m_VtxDesc.low.Position);
+  assign(CPArray::Normal, m_VtxDesc.low.Normal);
+  for (u8 i = 0; i < m_VtxDesc.low.Color.Size(); i++)
+    assign(CPArray::Color0 + i, m_VtxDesc.low.Color[i]);
+  for (u8 i = 0; i < m_VtxDesc.high.TexCoord.Size(); i++)
+    assign(CPArray::TexCoord0 + i, m_VtxDesc.high.TexCoord[i]);
+}
+
+const VertexLoaderX64::ArrayRegisters* VertexLoaderX64::GetArrayRegisters(CPArray array) const
+{
+  for (size_t i = 0; i < m_num_array_registers; i++)
+  {
+    if (m_array_registers[i].array == array)
+      return &m_array_registers[i];
+  }
+  return nullptr;
+}
+
 OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attribute)
 {
   OpArg data = MDisp(src_reg, m_src_ofs);
@@ -69,6 +101,11 @@ OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attrib
       CMP(bits, R(scratch1), Imm8(-1));
       m_skip_vertex = J_CC(CC_E, true);
     }
+    if (const ArrayRegisters* array_regs = GetArrayRegisters(array))
+    {
+      IMUL(32, scratch1, R(array_regs->stride));
+      return MRegSum(scratch1, array_regs->base);
+    }
     IMUL(32, scratch1, MPIC(&g_main_cp_state.array_strides[array]));
     MOV(64, R(scratch2), MPIC(&VertexLoaderManager::cached_arraybases[array]));
     return MRegSum(scratch1, scratch2);
@@ -400,8 +437,15 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
 
 void VertexLoaderX64::GenerateVertexLoader()
 {
+  AssignArrayRegisters();
+
   BitSet32 regs = {src_reg,  dst_reg,       scratch1,    scratch2,
                    scratch3, remaining_reg, skipped_reg, base_reg};
+  for (size_t i = 0; i < m_num_array_registers; i++)
+  {
+    regs[m_array_registers[i].base] = true;
+    regs[m_array_registers[i].stride] = true;
+  }
   regs &= ABI_ALL_CALLEE_SAVED;
   ABI_PushRegistersAndAdjustStack(regs, 0);
 
@@ -418,7 +462,15 @@ void VertexLoaderX64::GenerateVertexLoader()
   if (IsIndexed(m_VtxDesc.low.Position))
     XOR(32, R(skipped_reg), R(skipped_reg));
 
-  // TODO: load constants into registers outside the main loop
+  // The array bases and strides can't change during a draw.
+  for (size_t i = 0; i < m_num_array_registers; i++)
+  {
+    const ArrayRegisters& array_regs = m_array_registers[i];
+    MOV(32, R(array_regs.stride), MPIC(&g_main_cp_state.array_strides[array_regs.array]));
+    MOV(64, R(array_regs.base), MPIC(&VertexLoaderManager::cached_arraybases[array_regs.array]));
+  }
+
+  // TODO: load the remaining constants into registers outside the main loop
 
   const u8* loop_start = GetCodePtr();
 
@@ -585,6 +637,11 @@ void VertexLoaderX64::GenerateVertexLoader()
 int VertexLoaderX64::RunVertices(DataReader src, DataReader dst, int count)
 {
   m_numLoadedVertices += count;
+  return LoadVertices(src, dst, count);
+}
+
+int VertexLoaderX64::LoadVertices(DataReader src, DataReader dst, int count) const
+{
   return ((int (*)(u8*, u8*, int, const void*))region)(src.GetPointer(), dst.GetPointer(), count,
                                                        memory_base_ptr);
 }
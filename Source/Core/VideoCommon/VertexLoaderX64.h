@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -19,11 +21,26 @@ public:
 
 protected:
   int RunVertices(DataReader src, DataReader dst, int count) override;
+  bool SupportsParallelLoading() const override { return true; }
+  int LoadVertices(DataReader src, DataReader dst, int count) const override;
 
 private:
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
   Gen::FixupBranch m_skip_vertex;
+
+  // Indexed arrays whose base pointer and stride are kept in registers for the whole loop.
+  struct ArrayRegisters
+  {
+    CPArray array;
+    Gen::X64Reg base;
+    Gen::X64Reg stride;
+  };
+  std::array<ArrayRegisters, 2> m_array_registers{};
+  size_t m_num_array_registers = 0;
+
+  void AssignArrayRegisters();
+  const ArrayRegisters* GetArrayRegisters(CPArray array) const;
   Gen::OpArg GetVertexAddr(CPArray array, VertexComponentFormat attribute);
   void ReadVertex(Gen::OpArg data, VertexComponentFormat attribute, ComponentFormat format,
                   int count_in, int count_out, bool dequantize, u8 scaling_exponent,
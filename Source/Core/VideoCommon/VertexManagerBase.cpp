@@ -5,13 +5,16 @@
 
 #include <array>
 #include <cmath>
+#include <cstring>
 #include <memory>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/PerformanceTrace.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/DolphinAnalytics.h"
@@ -103,6 +106,7 @@ VertexManagerBase::~VertexManagerBase() = default;
 bool VertexManagerBase::Initialize()
 {
   m_index_generator.Init();
+  InvalidateConstants();
   return true;
 }
 
@@ -116,6 +120,12 @@ void VertexManagerBase::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_v
   m_index_generator.AddIndices(primitive, num_vertices);
 }
 
+void VertexManagerBase::AddRemappedIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices,
+                                           const u16* remap, u32 num_unique_vertices)
+{
+  m_index_generator.AddRemappedIndices(primitive, num_vertices, remap, num_unique_vertices);
+}
+
 DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive primitive,
                                                        u32 count, u32 stride, bool cullall)
 {
@@ -136,6 +146,7 @@ DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive
     // Have to update the rasterization state for point/line cull modes.
     m_current_primitive_type = new_primitive_type;
     SetRasterizationStateChanged();
+    SetGeometryShaderUidChanged();
   }
 
   // Check for size in buffer, if the buffer gets full, call Flush()
@@ -285,8 +296,70 @@ void VertexManagerBase::UploadUniforms()
 {
 }
 
+namespace
+{
+// The GX constants as the backend last uploaded them. Games often set constants to the values they
+// already had, such as loading the same matrices before every draw, so the ones marked dirty are
+// compared against these to skip uploads that wouldn't change anything.
+template <typename T>
+struct UploadedConstants
+{
+  T constants;
+  bool valid = false;
+};
+UploadedConstants<VertexShaderConstants> s_uploaded_vertex_constants;
+UploadedConstants<GeometryShaderConstants> s_uploaded_geometry_constants;
+UploadedConstants<PixelShaderConstants> s_uploaded_pixel_constants;
+
+template <typename T>
+void SkipRedundantUpload(bool* dirty, const T& constants, const UploadedConstants<T>& uploaded)
+{
+  if (*dirty && uploaded.valid && std::memcmp(&constants, &uploaded.constants, sizeof(T)) == 0)
+  {
+    *dirty = false;
+    INCSTAT(g_stats.this_frame.num_uniform_uploads_skipped);
+  }
+}
+
+// Backends clear the dirty flag once they have uploaded the constants.
+template <typename T>
+void RecordUpload(bool was_dirty, bool dirty, const T& constants, UploadedConstants<T>* uploaded)
+{
+  if (!was_dirty || dirty)
+    return;
+
+  std::memcpy(&uploaded->constants, &constants, sizeof(T));
+  uploaded->valid = true;
+}
+}  // namespace
+
+void VertexManagerBase::UploadGXUniforms()
+{
+  SkipRedundantUpload(&VertexShaderManager::dirty, VertexShaderManager::constants,
+                      s_uploaded_vertex_constants);
+  SkipRedundantUpload(&GeometryShaderManager::dirty, GeometryShaderManager::constants,
+                      s_uploaded_geometry_constants);
+  SkipRedundantUpload(&PixelShaderManager::dirty, PixelShaderManager::constants,
+                      s_uploaded_pixel_constants);
+
+  const bool vertex_dirty = VertexShaderManager::dirty;
+  const bool geometry_dirty = GeometryShaderManager::dirty;
+  const bool pixel_dirty = PixelShaderManager::dirty;
+  UploadUniforms();
+
+  RecordUpload(vertex_dirty, VertexShaderManager::dirty, VertexShaderManager::constants,
+               &s_uploaded_vertex_constants);
+  RecordUpload(geometry_dirty, GeometryShaderManager::dirty, GeometryShaderManager::constants,
+               &s_uploaded_geometry_constants);
+  RecordUpload(pixel_dirty, PixelShaderManager::dirty, PixelShaderManager::constants,
+               &s_uploaded_pixel_constants);
+}
+
 void VertexManagerBase::InvalidateConstants()
 {
+  s_uploaded_vertex_constants.valid = false;
+  s_uploaded_geometry_constants.valid = false;
+  s_uploaded_pixel_constants.valid = false;
   VertexShaderManager::dirty = true;
   GeometryShaderManager::dirty = true;
   PixelShaderManager::dirty = true;
@@ -359,6 +432,7 @@ void VertexManagerBase::Flush()
     return;
 
   m_is_flushed = true;
+  Common::PerformanceTrace::ScopedStage stage(Common::PerformanceTrace::Stage::BackendSubmit);
 
   if (xfmem.numTexGen.numTexGens != bpmem.genMode.numtexgens ||
       xfmem.numChan.numColorChans != bpmem.genMode.numcolchans)
@@ -457,7 +531,7 @@ void VertexManagerBase::Flush()
   std::vector<std::string> texture_names;
   if (!m_cull_all)
   {
-    if (!g_ActiveConfig.bGraphicMods)
+    if (!g_ActiveConfig.bGraphicMods || !g_renderer->GetGraphicsModManager().NeedsTextureNames())
     {
       for (const u32 i : used_textures)
       {
@@ -490,17 +564,21 @@ void VertexManagerBase::Flush()
 
   if (!m_cull_all)
   {
-    for (const auto& texture_name : texture_names)
+    // The names are only gathered if a mod needs them.
+    const GraphicsModManager& graphics_mod_manager = g_renderer->GetGraphicsModManager();
+    if (!texture_names.empty() && graphics_mod_manager.HasDrawStartedActions())
     {
-      bool skip = false;
-      GraphicsModActionData::DrawStarted draw_started{&skip};
-      for (const auto action :
-           g_renderer->GetGraphicsModManager().GetDrawStartedActions(texture_name))
+      for (const auto& texture_name : texture_names)
       {
-        action->OnDrawStarted(&draw_started);
+        bool skip = false;
+        GraphicsModActionData::DrawStarted draw_started{&skip};
+        for (const auto action : graphics_mod_manager.GetDrawStartedActions(texture_name))
+        {
+          action->OnDrawStarted(&draw_started);
+        }
+        if (skip == true)
+          return;
       }
-      if (skip == true)
-        return;
     }
 
     // Now the vertices can be flushed to the GPU. Everything following the CommitBuffer() call
@@ -519,7 +597,7 @@ void VertexManagerBase::Flush()
     // Now we can upload uniforms, as nothing else will override them.
     GeometryShaderManager::SetConstants();
     PixelShaderManager::SetConstants();
-    UploadUniforms();
+    UploadGXUniforms();
 
     // Update the pipeline, or compile one if needed.
     UpdatePipelineConfig();
@@ -527,11 +605,17 @@ void VertexManagerBase::Flush()
     if (m_current_pipeline_object)
     {
       g_renderer->SetPipeline(m_current_pipeline_object);
+      if (g_ActiveConfig.backend_info.bSupportsDynamicDepthAndCullState)
+      {
+        g_renderer->SetDynamicDepthAndCullState(m_current_pipeline_config.rasterization_state,
+                                                m_current_pipeline_config.depth_state);
+      }
       if (PerfQueryBase::ShouldEmulate())
         g_perf_query->EnableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
 
       DrawCurrentBatch(base_index, num_indices, base_vertex);
       INCSTAT(g_stats.this_frame.num_draw_calls);
+      INCSTAT(g_stats.num_draw_calls_total);
 
       if (PerfQueryBase::ShouldEmulate())
         g_perf_query->DisableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
@@ -562,6 +646,14 @@ void VertexManagerBase::DoState(PointerWrap& p)
   p.Do(m_zslope);
   p.Do(VertexLoaderManager::tangent_cache);
   p.Do(VertexLoaderManager::binormal_cache);
+
+  if (p.IsReadMode())
+  {
+    // The registers the shader UIDs are built from have been replaced.
+    SetVertexShaderUidChanged();
+    SetPixelShaderUidChanged();
+    SetGeometryShaderUidChanged();
+  }
 }
 
 void VertexManagerBase::CalculateZSlope(NativeVertexFormat* format)
@@ -664,28 +756,46 @@ void VertexManagerBase::UpdatePipelineConfig()
     m_pipeline_config_changed = true;
   }
 
-  VertexShaderUid vs_uid = GetVertexShaderUid();
-  if (vs_uid != m_current_pipeline_config.vs_uid)
+  if (m_vertex_shader_uid_changed)
   {
-    m_current_pipeline_config.vs_uid = vs_uid;
-    m_current_uber_pipeline_config.vs_uid = UberShader::GetVertexShaderUid();
-    m_pipeline_config_changed = true;
+    m_vertex_shader_uid_changed = false;
+
+    VertexShaderUid vs_uid = GetVertexShaderUid();
+    if (vs_uid != m_current_pipeline_config.vs_uid)
+    {
+      m_current_pipeline_config.vs_uid = vs_uid;
+      m_current_uber_pipeline_config.vs_uid = UberShader::GetVertexShaderUid();
+      m_pipeline_config_changed = true;
+    }
   }
 
-  PixelShaderUid ps_uid = GetPixelShaderUid();
-  if (ps_uid != m_current_pipeline_config.ps_uid)
+  // The bounding box can also be disabled by the CPU reading it back, without any register write.
+  const bool bounding_box = g_ActiveConfig.bBBoxEnable && g_renderer->IsBBoxEnabled();
+  const pixel_shader_uid_data* ps_uid_data = m_current_pipeline_config.ps_uid.GetUidData();
+  if (m_pixel_shader_uid_changed || bounding_box != static_cast<bool>(ps_uid_data->bounding_box))
   {
-    m_current_pipeline_config.ps_uid = ps_uid;
-    m_current_uber_pipeline_config.ps_uid = UberShader::GetPixelShaderUid();
-    m_pipeline_config_changed = true;
+    m_pixel_shader_uid_changed = false;
+
+    PixelShaderUid ps_uid = GetPixelShaderUid();
+    if (ps_uid != m_current_pipeline_config.ps_uid)
+    {
+      m_current_pipeline_config.ps_uid = ps_uid;
+      m_current_uber_pipeline_config.ps_uid = UberShader::GetPixelShaderUid();
+      m_pipeline_config_changed = true;
+    }
   }
 
-  GeometryShaderUid gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
-  if (gs_uid != m_current_pipeline_config.gs_uid)
+  if (m_geometry_shader_uid_changed)
   {
-    m_current_pipeline_config.gs_uid = gs_uid;
-    m_current_uber_pipeline_config.gs_uid = gs_uid;
-    m_pipeline_config_changed = true;
+    m_geometry_shader_uid_changed = false;
+
+    GeometryShaderUid gs_uid = GetGeometryShaderUid(GetCurrentPrimitiveType());
+    if (gs_uid != m_current_pipeline_config.gs_uid)
+    {
+      m_current_pipeline_config.gs_uid = gs_uid;
+      m_current_uber_pipeline_config.gs_uid = gs_uid;
+      m_pipeline_config_changed = true;
+    }
   }
 
   if (m_rasterization_state_changed)
@@ -770,7 +880,24 @@ void VertexManagerBase::UpdatePipelineObject()
 
     if (g_ActiveConfig.iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders)
     {
-      // Specialized shaders not ready, use the ubershaders.
+      // Specialized shaders not ready, use the ubershaders. Prefer the ones specialized on the
+      // current TEV stage count and alpha test, if those have been compiled.
+      if (g_ActiveConfig.bPartiallySpecializeUberShaders)
+      {
+        VideoCommon::GXUberPipelineUid partial_uid = m_current_uber_pipeline_config;
+        UberShader::PartiallySpecializePixelShaderUid(&partial_uid.ps_uid);
+        auto partial_res = g_shader_cache->GetUberPipelineForUidAsync(partial_uid);
+        if (partial_res && *partial_res)
+        {
+          m_current_pipeline_object = *partial_res;
+          return;
+        }
+
+        // Check again next draw, so that we switch over as soon as it is ready.
+        if (!partial_res)
+          m_pipeline_config_changed = true;
+      }
+
       m_current_pipeline_object =
           g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
     }
@@ -847,8 +974,71 @@ void VertexManagerBase::OnEFBCopyToRAM()
   g_renderer->Flush();
 }
 
+int VertexManagerBase::GetCachedVertices(const VertexLoaderBase* loader, const u8* src,
+                                         u32 src_size, u8* dst, u64* hash)
+{
+  if (src_size < MIN_CACHED_VERTEX_DATA_SIZE)
+    return -1;
+
+  *hash = Common::GetHash64(src, src_size, CACHED_VERTEX_HASH_SAMPLES);
+  auto iter = m_cached_vertices.find(*hash);
+  if (iter == m_cached_vertices.end())
+    return -1;
+
+  // The hash only samples the data, so compare all of it.
+  CachedVertices& entry = iter->second;
+  if (entry.loader != loader || entry.src.size() != src_size ||
+      std::memcmp(entry.src.data(), src, src_size) != 0)
+  {
+    return -1;
+  }
+
+  entry.last_used_frame = m_frame_count;
+  std::memcpy(dst, entry.vertices.data(), entry.vertices.size());
+  return static_cast<int>(entry.num_vertices);
+}
+
+void VertexManagerBase::CacheVertices(u64 hash, const VertexLoaderBase* loader, const u8* src,
+                                      u32 src_size, const u8* vertices, u32 num_vertices,
+                                      u32 stride)
+{
+  if (src_size < MIN_CACHED_VERTEX_DATA_SIZE)
+    return;
+
+  auto [iter, inserted] = m_cached_vertices.try_emplace(hash);
+  CachedVertices& entry = iter->second;
+  const bool seen_before = !inserted && entry.loader == loader;
+
+  m_cached_vertex_memory -= entry.src.size() + entry.vertices.size();
+  entry.src.clear();
+  entry.src.shrink_to_fit();
+  entry.vertices.clear();
+  entry.vertices.shrink_to_fit();
+  entry.loader = loader;
+  entry.num_vertices = 0;
+  entry.last_used_frame = m_frame_count;
+
+  const size_t vertices_size = num_vertices * stride;
+  if (!seen_before || m_cached_vertex_memory + src_size + vertices_size > MAX_CACHED_VERTEX_MEMORY)
+    return;
+
+  entry.src.assign(src, src + src_size);
+  entry.vertices.assign(vertices, vertices + vertices_size);
+  entry.num_vertices = num_vertices;
+  m_cached_vertex_memory += src_size + vertices_size;
+}
+
 void VertexManagerBase::OnEndFrame()
 {
+  m_frame_count++;
+  std::erase_if(m_cached_vertices, [this](const auto& iter) {
+    const CachedVertices& entry = iter.second;
+    if (m_frame_count - entry.last_used_frame <= CACHED_VERTEX_MAX_AGE)
+      return false;
+    m_cached_vertex_memory -= entry.src.size() + entry.vertices.size();
+    return true;
+  });
+
   m_draw_counter = 0;
   m_last_efb_copy_draw_counter = 0;
   m_scheduled_command_buffer_kicks.clear();
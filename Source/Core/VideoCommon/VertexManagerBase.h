@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -17,6 +18,7 @@ class DataReader;
 class NativeVertexFormat;
 class PointerWrap;
 struct PortableVertexDeclaration;
+class VertexLoaderBase;
 
 struct Slope
 {
@@ -100,10 +102,20 @@ public:
 
   PrimitiveType GetCurrentPrimitiveType() const { return m_current_primitive_type; }
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
+  void AddRemappedIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices, const u16* remap,
+                          u32 num_unique_vertices);
   virtual DataReader PrepareForAdditionalData(OpcodeDecoder::Primitive primitive, u32 count,
                                               u32 stride, bool cullall);
   void FlushData(u32 count, u32 stride);
 
+  // Cache of converted vertices for draws which read all their vertex data from the FIFO, keyed
+  // by a sampled hash of that data. Returns the number of vertices copied to dst, or -1 if they
+  // aren't cached, in which case the caller converts them and passes them to CacheVertices.
+  int GetCachedVertices(const VertexLoaderBase* loader, const u8* src, u32 src_size, u8* dst,
+                        u64* hash);
+  void CacheVertices(u64 hash, const VertexLoaderBase* loader, const u8* src, u32 src_size,
+                     const u8* vertices, u32 num_vertices, u32 stride);
+
   void Flush();
 
   void DoState(PointerWrap& p);
@@ -114,10 +126,17 @@ public:
   void SetRasterizationStateChanged() { m_rasterization_state_changed = true; }
   void SetDepthStateChanged() { m_depth_state_changed = true; }
   void SetBlendingStateChanged() { m_blending_state_changed = true; }
+  // The shader UIDs are only rebuilt when the state they are generated from has changed.
+  void SetVertexShaderUidChanged() { m_vertex_shader_uid_changed = true; }
+  void SetPixelShaderUidChanged() { m_pixel_shader_uid_changed = true; }
+  void SetGeometryShaderUidChanged() { m_geometry_shader_uid_changed = true; }
   void InvalidatePipelineObject()
   {
     m_current_pipeline_object = nullptr;
     m_pipeline_config_changed = true;
+    m_vertex_shader_uid_changed = true;
+    m_pixel_shader_uid_changed = true;
+    m_geometry_shader_uid_changed = true;
   }
 
   // Utility pipeline drawing (e.g. EFB copies, post-processing, UI).
@@ -166,6 +185,10 @@ protected:
   // Uploads uniform buffers for GX draws.
   virtual void UploadUniforms();
 
+  // Calls UploadUniforms(), skipping the constants that are the same as when they were last
+  // uploaded.
+  void UploadGXUniforms();
+
   // Issues the draw call for the current batch in the backend.
   virtual void DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_vertex);
 
@@ -195,6 +218,9 @@ protected:
   bool m_rasterization_state_changed = true;
   bool m_depth_state_changed = true;
   bool m_blending_state_changed = true;
+  bool m_vertex_shader_uid_changed = true;
+  bool m_pixel_shader_uid_changed = true;
+  bool m_geometry_shader_uid_changed = true;
   bool m_cull_all = false;
 
   IndexGenerator m_index_generator;
@@ -203,6 +229,24 @@ private:
   // Minimum number of draws per command buffer when attempting to preempt a readback operation.
   static constexpr u32 MINIMUM_DRAW_CALLS_PER_COMMAND_BUFFER_FOR_READBACK = 10;
 
+  // Smaller draws are cheaper to convert again than to look up.
+  static constexpr u32 MIN_CACHED_VERTEX_DATA_SIZE = 1024;
+  static constexpr u32 CACHED_VERTEX_HASH_SAMPLES = 128;
+  static constexpr size_t MAX_CACHED_VERTEX_MEMORY = 64 * 1024 * 1024;
+  // Number of frames after which unused entries are dropped.
+  static constexpr u32 CACHED_VERTEX_MAX_AGE = 60;
+
+  struct CachedVertices
+  {
+    const VertexLoaderBase* loader = nullptr;
+    // Both empty until the draw is seen a second time, so that geometry which is regenerated
+    // every frame doesn't get copied.
+    std::vector<u8> src;
+    std::vector<u8> vertices;
+    u32 num_vertices = 0;
+    u32 last_used_frame = 0;
+  };
+
   void UpdatePipelineConfig();
   void UpdatePipelineObject();
 
@@ -216,6 +260,10 @@ private:
   std::vector<u32> m_cpu_accesses_this_frame;
   std::vector<u32> m_scheduled_command_buffer_kicks;
   bool m_allow_background_execution = true;
+
+  std::unordered_map<u64, CachedVertices> m_cached_vertices;
+  size_t m_cached_vertex_memory = 0;
+  u32 m_frame_count = 0;
 };
 
 extern std::unique_ptr<VertexManagerBase> g_vertex_manager;
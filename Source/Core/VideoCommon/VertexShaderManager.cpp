@@ -3,7 +3,9 @@
 
 #include "VideoCommon/VertexShaderManager.h"
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cmath>
 #include <cstring>
 #include <iterator>
@@ -41,10 +43,47 @@ static bool bTexMtxInfoChanged;
 static bool bLightingConfigChanged;
 static bool bProjectionGraphicsModChange;
 static BitSet32 nMaterialsChanged;
-static std::array<int, 2> nTransformMatricesChanged;      // min,max
-static std::array<int, 2> nNormalMatricesChanged;         // min,max
-static std::array<int, 2> nPostTransformMatricesChanged;  // min,max
-static std::array<int, 2> nLightsChanged;                 // min,max
+// Changes are tracked per matrix row and per light, so that games updating a few scattered
+// matrices, such as the bones of skinned models, don't convert everything in between.
+static BitSet64 s_transform_matrix_rows_changed;
+static BitSet32 s_normal_matrix_rows_changed;
+static BitSet64 s_post_transform_matrix_rows_changed;
+static BitSet32 s_lights_changed;
+
+constexpr int MATRIX_ROW_SIZE = 4;
+constexpr int NORMAL_MATRIX_ROW_SIZE = 3;
+constexpr int LIGHT_SIZE = 0x10;
+
+// Returns which of the rows of row_size words starting at base overlap the XF range [start, end).
+template <typename IntTy>
+static Common::BitSet<IntTy> GetChangedRows(int start, int end, int base, int row_size)
+{
+  using Rows = Common::BitSet<IntTy>;
+  constexpr int num_rows = sizeof(IntTy) * 8;
+  const int first = std::clamp((start - base) / row_size, 0, num_rows);
+  const int last = std::clamp((end - base + row_size - 1) / row_size, 0, num_rows);
+  if (first >= last)
+    return Rows{};
+  return Rows::AllTrue(last) & ~Rows::AllTrue(first);
+}
+
+// Savestates store the pending changes as the range of XF words that they cover.
+template <typename IntTy>
+static void DoChangedRows(PointerWrap& p, Common::BitSet<IntTy>* rows, int row_size)
+{
+  std::array<int, 2> range{-1, -1};
+  if (*rows)
+  {
+    range[0] = std::countr_zero(rows->m_val) * row_size;
+    range[1] = (static_cast<int>(sizeof(IntTy) * 8) - std::countl_zero(rows->m_val)) * row_size;
+  }
+  p.DoArray(range);
+  if (p.IsReadMode())
+  {
+    *rows = range[0] < 0 ? Common::BitSet<IntTy>{} :
+                           GetChangedRows<IntTy>(range[0], range[1], 0, row_size);
+  }
+}
 
 static Common::Matrix44 s_viewportCorrection;
 
@@ -54,10 +93,10 @@ bool VertexShaderManager::dirty;
 void VertexShaderManager::Init()
 {
   // Initialize state tracking variables
-  nTransformMatricesChanged.fill(-1);
-  nNormalMatricesChanged.fill(-1);
-  nPostTransformMatricesChanged.fill(-1);
-  nLightsChanged.fill(-1);
+  s_transform_matrix_rows_changed = BitSet64(0);
+  s_normal_matrix_rows_changed = BitSet32(0);
+  s_post_transform_matrix_rows_changed = BitSet64(0);
+  s_lights_changed = BitSet32(0);
   nMaterialsChanged = BitSet32(0);
   bTexMatricesChanged.fill(false);
   bPosNormalMatrixChanged = false;
@@ -102,46 +141,44 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
     dirty = true;
   }
 
-  if (nTransformMatricesChanged[0] >= 0)
+  // Each row is a single 16 byte copy.
+  if (s_transform_matrix_rows_changed)
   {
-    int startn = nTransformMatricesChanged[0] / 4;
-    int endn = (nTransformMatricesChanged[1] + 3) / 4;
-    memcpy(constants.transformmatrices[startn].data(), &xfmem.posMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
+    for (int row : s_transform_matrix_rows_changed)
+    {
+      memcpy(constants.transformmatrices[row].data(), &xfmem.posMatrices[row * MATRIX_ROW_SIZE],
+             sizeof(float4));
+    }
     dirty = true;
-    nTransformMatricesChanged[0] = nTransformMatricesChanged[1] = -1;
+    s_transform_matrix_rows_changed = BitSet64(0);
   }
 
-  if (nNormalMatricesChanged[0] >= 0)
+  if (s_normal_matrix_rows_changed)
   {
-    int startn = nNormalMatricesChanged[0] / 3;
-    int endn = (nNormalMatricesChanged[1] + 2) / 3;
-    for (int i = startn; i < endn; i++)
+    for (int row : s_normal_matrix_rows_changed)
     {
-      memcpy(constants.normalmatrices[i].data(), &xfmem.normalMatrices[3 * i], 12);
+      memcpy(constants.normalmatrices[row].data(),
+             &xfmem.normalMatrices[row * NORMAL_MATRIX_ROW_SIZE], 3 * sizeof(float));
     }
     dirty = true;
-    nNormalMatricesChanged[0] = nNormalMatricesChanged[1] = -1;
+    s_normal_matrix_rows_changed = BitSet32(0);
   }
 
-  if (nPostTransformMatricesChanged[0] >= 0)
+  if (s_post_transform_matrix_rows_changed)
   {
-    int startn = nPostTransformMatricesChanged[0] / 4;
-    int endn = (nPostTransformMatricesChanged[1] + 3) / 4;
-    memcpy(constants.posttransformmatrices[startn].data(), &xfmem.postMatrices[startn * 4],
-           (endn - startn) * sizeof(float4));
+    for (int row : s_post_transform_matrix_rows_changed)
+    {
+      memcpy(constants.posttransformmatrices[row].data(),
+             &xfmem.postMatrices[row * MATRIX_ROW_SIZE], sizeof(float4));
+    }
     dirty = true;
-    nPostTransformMatricesChanged[0] = nPostTransformMatricesChanged[1] = -1;
+    s_post_transform_matrix_rows_changed = BitSet64(0);
   }
 
-  if (nLightsChanged[0] >= 0)
+  if (s_lights_changed)
   {
-    // TODO: Outdated comment
     // lights don't have a 1 to 1 mapping, the color component needs to be converted to 4 floats
-    int istart = nLightsChanged[0] / 0x10;
-    int iend = (nLightsChanged[1] + 15) / 0x10;
-
-    for (int i = istart; i < iend; ++i)
+    for (int i : s_lights_changed)
     {
       const Light& light = xfmem.lights[i];
       VertexShaderConstants::Light& dstlight = constants.lights[i];
@@ -192,7 +229,7 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
     }
     dirty = true;
 
-    nLightsChanged[0] = nLightsChanged[1] = -1;
+    s_lights_changed = BitSet32(0);
   }
 
   for (int i : nMaterialsChanged)
@@ -314,18 +351,18 @@ void VertexShaderManager::SetConstants(const std::vector<std::string>& textures)
   }
 
   std::vector<GraphicsModAction*> projection_actions;
-  if (g_ActiveConfig.bGraphicMods)
+  if (g_ActiveConfig.bGraphicMods && g_renderer->GetGraphicsModManager().HasProjectionActions())
   {
-    for (const auto action :
-         g_renderer->GetGraphicsModManager().GetProjectionActions(xfmem.projection.type))
+    const GraphicsModManager& graphics_mod_manager = g_renderer->GetGraphicsModManager();
+    for (const auto action : graphics_mod_manager.GetProjectionActions(xfmem.projection.type))
     {
       projection_actions.push_back(action);
     }
 
     for (const auto& texture : textures)
     {
-      for (const auto action : g_renderer->GetGraphicsModManager().GetProjectionTextureActions(
-               xfmem.projection.type, texture))
+      for (const auto action :
+           graphics_mod_manager.GetProjectionTextureActions(xfmem.projection.type, texture))
       {
         projection_actions.push_back(action);
       }
@@ -493,81 +530,27 @@ void VertexShaderManager::InvalidateXFRange(int start, int end)
 
   if (start < XFMEM_POSMATRICES_END)
   {
-    if (nTransformMatricesChanged[0] == -1)
-    {
-      nTransformMatricesChanged[0] = start;
-      nTransformMatricesChanged[1] = end > XFMEM_POSMATRICES_END ? XFMEM_POSMATRICES_END : end;
-    }
-    else
-    {
-      if (nTransformMatricesChanged[0] > start)
-        nTransformMatricesChanged[0] = start;
-
-      if (nTransformMatricesChanged[1] < end)
-        nTransformMatricesChanged[1] = end > XFMEM_POSMATRICES_END ? XFMEM_POSMATRICES_END : end;
-    }
+    s_transform_matrix_rows_changed |= GetChangedRows<u64>(
+        start, std::min<int>(end, XFMEM_POSMATRICES_END), XFMEM_POSMATRICES, MATRIX_ROW_SIZE);
   }
 
   if (start < XFMEM_NORMALMATRICES_END && end > XFMEM_NORMALMATRICES)
   {
-    int _start = start < XFMEM_NORMALMATRICES ? 0 : start - XFMEM_NORMALMATRICES;
-    int _end = end < XFMEM_NORMALMATRICES_END ? end - XFMEM_NORMALMATRICES :
-                                                XFMEM_NORMALMATRICES_END - XFMEM_NORMALMATRICES;
-
-    if (nNormalMatricesChanged[0] == -1)
-    {
-      nNormalMatricesChanged[0] = _start;
-      nNormalMatricesChanged[1] = _end;
-    }
-    else
-    {
-      if (nNormalMatricesChanged[0] > _start)
-        nNormalMatricesChanged[0] = _start;
-
-      if (nNormalMatricesChanged[1] < _end)
-        nNormalMatricesChanged[1] = _end;
-    }
+    s_normal_matrix_rows_changed |=
+        GetChangedRows<u32>(start, std::min<int>(end, XFMEM_NORMALMATRICES_END),
+                            XFMEM_NORMALMATRICES, NORMAL_MATRIX_ROW_SIZE);
   }
 
   if (start < XFMEM_POSTMATRICES_END && end > XFMEM_POSTMATRICES)
   {
-    int _start = start < XFMEM_POSTMATRICES ? XFMEM_POSTMATRICES : start - XFMEM_POSTMATRICES;
-    int _end = end < XFMEM_POSTMATRICES_END ? end - XFMEM_POSTMATRICES :
-                                              XFMEM_POSTMATRICES_END - XFMEM_POSTMATRICES;
-
-    if (nPostTransformMatricesChanged[0] == -1)
-    {
-      nPostTransformMatricesChanged[0] = _start;
-      nPostTransformMatricesChanged[1] = _end;
-    }
-    else
-    {
-      if (nPostTransformMatricesChanged[0] > _start)
-        nPostTransformMatricesChanged[0] = _start;
-
-      if (nPostTransformMatricesChanged[1] < _end)
-        nPostTransformMatricesChanged[1] = _end;
-    }
+    s_post_transform_matrix_rows_changed |= GetChangedRows<u64>(
+        start, std::min<int>(end, XFMEM_POSTMATRICES_END), XFMEM_POSTMATRICES, MATRIX_ROW_SIZE);
   }
 
   if (start < XFMEM_LIGHTS_END && end > XFMEM_LIGHTS)
   {
-    int _start = start < XFMEM_LIGHTS ? XFMEM_LIGHTS : start - XFMEM_LIGHTS;
-    int _end = end < XFMEM_LIGHTS_END ? end - XFMEM_LIGHTS : XFMEM_LIGHTS_END - XFMEM_LIGHTS;
-
-    if (nLightsChanged[0] == -1)
-    {
-      nLightsChanged[0] = _start;
-      nLightsChanged[1] = _end;
-    }
-    else
-    {
-      if (nLightsChanged[0] > _start)
-        nLightsChanged[0] = _start;
-
-      if (nLightsChanged[1] < _end)
-        nLightsChanged[1] = _end;
-    }
+    s_lights_changed |= GetChangedRows<u32>(start, std::min<int>(end, XFMEM_LIGHTS_END),
+                                            XFMEM_LIGHTS, LIGHT_SIZE);
   }
 }
 
@@ -687,10 +670,10 @@ void VertexShaderManager::DoState(PointerWrap& p)
   p.Do(s_viewportCorrection);
   g_freelook_camera.DoState(p);
 
-  p.DoArray(nTransformMatricesChanged);
-  p.DoArray(nNormalMatricesChanged);
-  p.DoArray(nPostTransformMatricesChanged);
-  p.DoArray(nLightsChanged);
+  DoChangedRows(p, &s_transform_matrix_rows_changed, MATRIX_ROW_SIZE);
+  DoChangedRows(p, &s_normal_matrix_rows_changed, NORMAL_MATRIX_ROW_SIZE);
+  DoChangedRows(p, &s_post_transform_matrix_rows_changed, MATRIX_ROW_SIZE);
+  DoChangedRows(p, &s_lights_changed, LIGHT_SIZE);
 
   p.Do(nMaterialsChanged);
   p.DoArray(bTexMatricesChanged);
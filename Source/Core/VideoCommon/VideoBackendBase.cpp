@@ -20,6 +20,8 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/VideoInterface.h"
 #include "Core/System.h"
 
 // TODO: ugly
@@ -127,6 +129,9 @@ u32 VideoBackendBase::Video_AccessEFB(EFBAccessType type, u32 x, u32 y, u32 data
   }
   else
   {
+    // The peek has to see everything the CPU sent before it.
+    Fifo::SyncGPU(Fifo::SyncGPUReason::EFBPeek);
+
     AsyncRequests::Event e;
     u32 result;
     e.type = type == EFBAccessType::PeekColor ? AsyncRequests::Event::EFB_PEEK_COLOR :
@@ -140,6 +145,9 @@ u32 VideoBackendBase::Video_AccessEFB(EFBAccessType type, u32 x, u32 y, u32 data
   }
 }
 
+// When the CPU thread last asked the GPU thread for completed perf query results.
+static u64 s_perf_query_request_ticks;
+
 u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
 {
   if (!g_perf_query->ShouldEmulate())
@@ -147,6 +155,30 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
     return 0;
   }
 
+  // Games that read the counters every frame, such as for lens flares, can usually live with the
+  // results of an earlier frame. Those are collected by the GPU thread without the CPU waiting, and
+  // the CPU only waits once they are older than the latency allows.
+  if (g_ActiveConfig.iPerfQueriesMaxLatency > 0 && !Core::WantsDeterminism() &&
+      !g_perf_query->IsFlushed())
+  {
+    const u64 ticks = CoreTiming::GetTicks();
+    if (!g_perf_query->IsCompletedResultsRequestPending())
+    {
+      g_perf_query->RequestCompletedResults();
+      s_perf_query_request_ticks = ticks;
+
+      AsyncRequests::Event e;
+      e.time = 0;
+      e.type = AsyncRequests::Event::PERF_QUERY;
+      AsyncRequests::GetInstance()->PushEvent(e, false);
+    }
+
+    const u64 max_latency_ticks =
+        u64{VideoInterface::GetTicksPerField()} * g_ActiveConfig.iPerfQueriesMaxLatency;
+    if (ticks - s_perf_query_request_ticks <= max_latency_ticks)
+      return g_perf_query->GetCompletedResult(type);
+  }
+
   Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
 
   AsyncRequests::Event e;
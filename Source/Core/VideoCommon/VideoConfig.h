@@ -60,11 +60,15 @@ struct VideoConfig final
   AspectMode suggested_aspect_mode{};
   bool bCrop = false;  // Aspect ratio controls.
   bool bShaderCache = false;
+  bool bShareShaderCache = false;  // Don't keep specialized shaders separate per game.
 
   // Enhancements
   u32 iMultisamples = 0;
   bool bSSAA = false;
   int iEFBScale = 0;
+  // Lowers the internal resolution down to iDynamicResolutionMinScale when frames take too long.
+  bool bDynamicResolution = false;
+  int iDynamicResolutionMinScale = 1;
   bool bForceFiltering = false;
   int iMaxAnisotropy = 0;
   std::string sPostProcessingShader;
@@ -80,6 +84,8 @@ struct VideoConfig final
   bool bOverlayStats = false;
   bool bOverlayProjStats = false;
   bool bOverlayScissorStats = false;
+  // Minimum time between updates of the on-screen display, or 0 to update it every frame.
+  int iOverlayUpdateIntervalMs = 0;
   bool bTexFmtOverlayEnable = false;
   bool bTexFmtOverlayCenter = false;
   bool bLogRenderTimeToFile = false;
@@ -94,6 +100,10 @@ struct VideoConfig final
   bool bDumpBaseTextures = false;
   bool bHiresTextures = false;
   bool bCacheHiresTextures = false;
+  // Load custom textures on background threads, using the native texture until they are ready.
+  bool bAsyncHiresTextures = false;
+  // How many MiB of custom textures loaded in the background are kept in memory.
+  int iHiresTextureMemoryBudget = 0;
   bool bDumpEFBTarget = false;
   bool bDumpXFBTarget = false;
   bool bDumpFramesAsImages = false;
@@ -101,6 +111,8 @@ struct VideoConfig final
   std::string sDumpCodec;
   std::string sDumpPixelFormat;
   std::string sDumpEncoder;
+  // Device for encoders which take frames in video memory, e.g. /dev/dri/renderD128 for VAAPI.
+  std::string sDumpHWDevice;
   std::string sDumpFormat;
   std::string sDumpPath;
   bool bInternalResolutionFrameDumps = false;
@@ -113,8 +125,14 @@ struct VideoConfig final
   // Hacks
   bool bEFBAccessEnable = false;
   bool bEFBAccessDeferInvalidation = false;
+  // Serve EFB peeks from a readback issued in the previous frame instead of waiting for the GPU.
+  bool bEFBAccessAsyncReadback = false;
   bool bPerfQueriesEnable = false;
+  // How many frames perf query results may lag behind instead of waiting for the GPU. 0 always
+  // waits.
+  int iPerfQueriesMaxLatency = 0;
   bool bBBoxEnable = false;
+  bool bBBoxAsyncReadback = false;
   bool bForceProgressive = false;
 
   bool bEFBEmulateFormatChanges = false;
@@ -122,10 +140,18 @@ struct VideoConfig final
   bool bSkipXFBCopyToRam = false;
   bool bDisableCopyToVRAM = false;
   bool bDeferEFBCopies = false;
+  // Only write deferred EFB copies to RAM once the CPU accesses their memory. Requires fastmem.
+  bool bWritebackEFBCopiesOnAccess = false;
   bool bImmediateXFB = false;
   bool bSkipPresentingDuplicateXFBs = false;
+  bool bSkipPresentation = false;
   bool bCopyEFBScaled = false;
   int iSafeTextureCache_ColorSamples = 0;
+  // Only rehash textures whose memory was written to. Requires fastmem.
+  bool bWatchTextureWrites = false;
+  // Limit for the video memory used by the texture cache, or 0 to only keep the process within the
+  // budget reported by the driver.
+  int iTextureCacheBudgetMB = 0;
   float fAspectRatioHackW = 1;  // Initial value needed for the first frame
   float fAspectRatioHackH = 1;
   bool bEnablePixelLighting = false;
@@ -158,9 +184,19 @@ struct VideoConfig final
   // Currently only supported with Vulkan.
   int iCommandBufferExecuteInterval = 0;
 
+  // Delays the start of frames and limits the frames queued for presentation, to reduce the
+  // latency between input and display. Not supported by all backends.
+  bool bLowLatencyMode = false;
+
+  // Post-processes frames into an intermediate texture which is submitted before the backbuffer
+  // is acquired, rather than drawing to the backbuffer directly.
+  bool bAsyncPostProcessing = false;
+
   // Shader compilation settings.
   bool bWaitForShadersBeforeStarting = false;
   ShaderCompilationMode iShaderCompilationMode{};
+  // Compile ubershaders specialized on a few states to use until specialized shaders are ready.
+  bool bPartiallySpecializeUberShaders = false;
 
   // Number of shader compiler threads.
   // 0 disables background compilation.
@@ -168,6 +204,24 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of threads which help the video thread load the vertices of large draws.
+  // 0 loads all vertices on the video thread.
+  int iVertexLoaderThreads = 0;
+
+  // Number of threads which help the video thread decode large textures and their mip levels.
+  // 0 decodes all textures on the video thread.
+  int iTextureDecoderThreads = 0;
+
+  // Number of threads which help the video thread rasterize with the software renderer.
+  // 0 rasterizes everything on the video thread.
+  int iSWRasterizerThreads = 0;
+
+  // Reuse the converted vertices of draws whose vertex data doesn't change between frames.
+  bool bCacheConvertedVertices = false;
+
+  // Convert and upload each distinct vertex of an indexed draw only once.
+  bool bDeduplicateVertices = false;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -222,6 +276,7 @@ struct VideoConfig final
     bool bSupportsSettingObjectNames = false;
     bool bSupportsPartialMultisampleResolve = false;
     bool bSupportsDynamicVertexLoader = false;
+    bool bSupportsDynamicDepthAndCullState = false;
   } backend_info;
 
   // Utility
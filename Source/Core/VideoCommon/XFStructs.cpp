@@ -3,6 +3,8 @@
 
 #include "VideoCommon/XFStructs.h"
 
+#include <algorithm>
+
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -222,12 +224,27 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
       base_address = XFMEM_REGISTERS_START;
     }
 
-    XFMemWritten(xf_mem_transfer_size, xf_mem_base);
+    // Games often load the same matrices again, which doesn't need a flush. Only the range
+    // which actually changes is written and invalidated.
+    u32* const xf_mem = (u32*)&xfmem + xf_mem_base;
+    u32 first_changed = xf_mem_transfer_size;
+    u32 last_changed = 0;
     for (u32 i = 0; i < xf_mem_transfer_size; i++)
     {
-      ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data);
-      data += 4;
+      if (xf_mem[i] != Common::swap32(data + i * sizeof(u32)))
+      {
+        first_changed = std::min(first_changed, i);
+        last_changed = i;
+      }
     }
+
+    if (first_changed < xf_mem_transfer_size)
+    {
+      XFMemWritten(last_changed - first_changed + 1, xf_mem_base + first_changed);
+      for (u32 i = first_changed; i <= last_changed; i++)
+        xf_mem[i] = Common::swap32(data + i * sizeof(u32));
+    }
+    data += xf_mem_transfer_size * sizeof(u32);
   }
 
   // write to XF regs
@@ -236,11 +253,22 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
     for (u32 address = base_address; address < end_address; address++)
     {
       const u32 value = Common::swap32(data);
+      data += 4;
+
+      // Rewriting a register with its current value changes no state, so skip the flush for
+      // redundant viewport, projection and texgen writes. The matrix indices are the exception,
+      // as they are shared with CP, which may have changed them since.
+      if (((u32*)&xfmem)[address] == value && address != XFMEM_SETMATRIXINDA &&
+          address != XFMEM_SETMATRIXINDB)
+      {
+        continue;
+      }
 
       XFRegWritten(address, value);
       ((u32*)&xfmem)[address] = value;
-
-      data += 4;
+      g_vertex_manager->SetVertexShaderUidChanged();
+      g_vertex_manager->SetPixelShaderUidChanged();
+      g_vertex_manager->SetGeometryShaderUidChanged();
     }
   }
 }
@@ -275,6 +303,12 @@ void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size)
   {
     for (u32 i = 0; i < size; ++i)
       currData[i] = Common::swap32(newData[i]);
+    if (address + size > XFMEM_REGISTERS_START)
+    {
+      g_vertex_manager->SetVertexShaderUidChanged();
+      g_vertex_manager->SetPixelShaderUidChanged();
+      g_vertex_manager->SetGeometryShaderUidChanged();
+    }
   }
 }
 
@@ -1,3 +1,5 @@
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "Common/Crypto/SHA1.h"
@@ -28,3 +30,24 @@ TEST(SHA1, Vectors)
     EXPECT_EQ(test.expected, actual);
   }
 }
+
+TEST(SHA1, MultipleMessages)
+{
+  std::vector<u8> data(0x400 * 31);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<u8>(i * 7 + i / 251);
+
+  for (size_t msg_len : {0, 1, 55, 56, 64, 100, 0x400})
+  {
+    for (size_t count : {1, 2, 3, 4, 5, 31})
+    {
+      if (msg_len * count > data.size())
+        continue;
+
+      std::vector<Common::SHA1::Digest> digests(count);
+      Common::SHA1::CalculateDigests(data.data(), msg_len, count, digests.data());
+      for (size_t i = 0; i < count; ++i)
+        EXPECT_EQ(Common::SHA1::CalculateDigest(data.data() + i * msg_len, msg_len), digests[i]);
+    }
+  }
+}
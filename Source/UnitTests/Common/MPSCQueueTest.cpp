@@ -0,0 +1,77 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32, 1024> q;
+
+  u32 v;
+  EXPECT_FALSE(q.Pop(v));
+
+  EXPECT_TRUE(q.TryPush(1));
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(1u, v);
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order and the capacity.
+  for (u32 i = 0; i < 1024; ++i)
+    EXPECT_TRUE(q.TryPush(i));
+  EXPECT_FALSE(q.TryPush(1024));
+  for (u32 i = 0; i < 1024; ++i)
+  {
+    u32 v2;
+    EXPECT_TRUE(q.Pop(v2));
+    EXPECT_EQ(i, v2);
+  }
+  EXPECT_FALSE(q.Pop(v));
+
+  for (u32 i = 0; i < 1000; ++i)
+    EXPECT_TRUE(q.TryPush(i));
+  q.Clear();
+  EXPECT_FALSE(q.Pop(v));
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 NUM_THREADS = 4;
+  constexpr u32 NUM_VALUES = 50000;
+  Common::MPSCQueue<u32, 64> q;
+
+  auto inserter = [&q](u32 thread) {
+    for (u32 i = 0; i < NUM_VALUES; ++i)
+    {
+      while (!q.TryPush(thread * NUM_VALUES + i))
+        std::this_thread::yield();
+    }
+  };
+
+  auto popper = [&q]() {
+    // Values from each producer must arrive in the order they were pushed.
+    std::array<u32, NUM_THREADS> next{};
+    for (u32 i = 0; i < NUM_THREADS * NUM_VALUES; ++i)
+    {
+      u32 v;
+      while (!q.Pop(v))
+        std::this_thread::yield();
+      const u32 thread = v / NUM_VALUES;
+      EXPECT_EQ(next[thread], v % NUM_VALUES);
+      ++next[thread];
+    }
+  };
+
+  std::thread popper_thread(popper);
+  std::vector<std::thread> inserter_threads;
+  for (u32 i = 0; i < NUM_THREADS; ++i)
+    inserter_threads.emplace_back(inserter, i);
+
+  popper_thread.join();
+  for (std::thread& thread : inserter_threads)
+    thread.join();
+}
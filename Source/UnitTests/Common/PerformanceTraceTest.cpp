@@ -0,0 +1,66 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+#include "Common/FileUtil.h"
+#include "Common/PerformanceTrace.h"
+
+namespace PerformanceTrace = Common::PerformanceTrace;
+
+TEST(PerformanceTrace, ExportChromeTrace)
+{
+  const std::string directory = File::CreateTempDir();
+  ASSERT_FALSE(directory.empty());
+  const std::string path = directory + "/trace.json";
+
+  // Nothing is recorded while disabled.
+  PerformanceTrace::SetEnabled(false);
+  {
+    PerformanceTrace::ScopedStage stage(PerformanceTrace::Stage::JITCompile);
+  }
+
+  PerformanceTrace::SetEnabled(true);
+  PerformanceTrace::SetCurrentThreadName("Test thread");
+  {
+    PerformanceTrace::ScopedStage stage(PerformanceTrace::Stage::FIFODecode);
+    PerformanceTrace::ScopedStage nested_stage(PerformanceTrace::Stage::VertexLoading);
+  }
+  PerformanceTrace::RecordFrame(42);
+  std::thread([] {
+    PerformanceTrace::SetCurrentThreadName("Other thread");
+    PerformanceTrace::ScopedStage stage(PerformanceTrace::Stage::TextureDecoding);
+  }).join();
+  PerformanceTrace::SetEnabled(false);
+
+  ASSERT_TRUE(PerformanceTrace::ExportChromeTrace(path));
+  std::string json;
+  ASSERT_TRUE(File::ReadFileToString(path, json));
+  File::DeleteDirRecursively(directory);
+
+  EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"Test thread\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"Other thread\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"FIFO decode\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"Vertex loading\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"Texture decoding\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, json.find("\"name\":\"Frame 42\",\"ph\":\"i\""));
+  EXPECT_EQ(std::string::npos, json.find("JIT compile"));
+}
+
+TEST(PerformanceTrace, StageTotals)
+{
+  PerformanceTrace::SetEnabled(true);
+  EXPECT_EQ(0u, PerformanceTrace::GetStageTotal(PerformanceTrace::Stage::JITCompile));
+
+  PerformanceTrace::RecordStage(PerformanceTrace::Stage::JITCompile, 100, 250);
+  std::thread([] {
+    PerformanceTrace::RecordStage(PerformanceTrace::Stage::JITCompile, 1000, 1050);
+  }).join();
+  PerformanceTrace::SetEnabled(false);
+
+  EXPECT_EQ(200u, PerformanceTrace::GetStageTotal(PerformanceTrace::Stage::JITCompile));
+  EXPECT_EQ(0u, PerformanceTrace::GetStageTotal(PerformanceTrace::Stage::FIFODecode));
+}
@@ -1,6 +1,8 @@
 // Copyright 2017 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+
 #include <gtest/gtest.h>
 
 #include "Common/Swap.h"
@@ -12,3 +14,34 @@ TEST(Swap, SwapByValue)
   EXPECT_EQ(0x12345678u, Common::swap32(0x78563412));
   EXPECT_EQ(0x123456789abcdef0ull, Common::swap64(0xf0debc9a78563412ull));
 }
+
+TEST(Swap, SwapArray)
+{
+  // Long enough to be swapped both in chunks and one element at a time.
+  std::array<u16, 45> values16;
+  std::array<u32, 45> values32;
+  std::array<u64, 45> values64;
+  for (size_t i = 0; i < values16.size(); ++i)
+  {
+    values16[i] = static_cast<u16>(0x0102 * (i + 1));
+    values32[i] = static_cast<u32>(0x01020304 * (i + 1));
+    values64[i] = 0x0102030405060708ull * (i + 1);
+  }
+
+  std::array<u16, 45> swapped16;
+  std::array<u32, 45> swapped32;
+  std::array<u64, 45> swapped64;
+  Common::FromBigEndianArray(swapped16.data(), values16.data(), values16.size());
+  Common::FromBigEndianArray(swapped32.data(), values32.data(), values32.size());
+  Common::FromBigEndianArray(swapped64.data(), values64.data(), values64.size());
+  for (size_t i = 0; i < values16.size(); ++i)
+  {
+    EXPECT_EQ(Common::swap16(values16[i]), swapped16[i]);
+    EXPECT_EQ(Common::swap32(values32[i]), swapped32[i]);
+    EXPECT_EQ(Common::swap64(values64[i]), swapped64[i]);
+  }
+
+  // In place
+  Common::FromBigEndianArray(swapped32.data(), swapped32.data(), swapped32.size());
+  EXPECT_EQ(values32, swapped32);
+}
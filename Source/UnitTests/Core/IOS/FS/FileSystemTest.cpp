@@ -6,12 +6,15 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Core/IOS/FS/FileSystem.h"
+#include "Core/IOS/FS/HostBackend/FS.h"
+#include "Core/IOS/FS/OverlayBackend/FS.h"
 #include "Core/IOS/IOS.h"
 #include "UICommon/UICommon.h"
 
@@ -417,6 +420,79 @@ TEST_F(FileSystemTest, MultipleHandles)
   EXPECT_EQ(TEST_DATA, read_buffer);
 }
 
+TEST_F(FileSystemTest, MetadataSizeFollowsWrites)
+{
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", 0, modes), ResultCode::Success);
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f")->size, 0u);
+
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::ReadWrite);
+    ASSERT_TRUE(file.Succeeded());
+    ASSERT_TRUE(file->Write(std::vector<u8>(10).data(), 10).Succeeded());
+    EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f")->size, 10u);
+
+    // Overwriting part of the file doesn't change its size.
+    ASSERT_TRUE(file->Seek(0, SeekMode::Set).Succeeded());
+    ASSERT_TRUE(file->Write(std::vector<u8>(5).data(), 5).Succeeded());
+    EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f")->size, 10u);
+  }
+
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f")->size, 10u);
+}
+
+TEST_F(FileSystemTest, RecreateDeletedFile)
+{
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", 0, modes), ResultCode::Success);
+  {
+    const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::ReadWrite);
+    ASSERT_TRUE(file.Succeeded());
+    ASSERT_TRUE(file->Write(std::vector<u8>(10).data(), 10).Succeeded());
+  }
+
+  // The host file may still be open internally, which must not get in the way.
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/f"), ResultCode::Success);
+  EXPECT_EQ(m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::Read).Error(), ResultCode::NotFound);
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f").Error(), ResultCode::NotFound);
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", 0, modes), ResultCode::Success);
+  const Result<FileHandle> file = m_fs->OpenFile(Uid{0}, Gid{0}, "/tmp/f", Mode::Read);
+  ASSERT_TRUE(file.Succeeded());
+  EXPECT_EQ(file->GetStatus()->size, 0u);
+}
+
+TEST_F(FileSystemTest, ReadDirectoryAfterChanges)
+{
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/d", 0, modes), ResultCode::Success);
+  EXPECT_TRUE(m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/d")->empty());
+
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/d/f", 0, modes), ResultCode::Success);
+  EXPECT_EQ(*m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/d"), std::vector<std::string>{"f"});
+
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/e", 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->Rename(Uid{0}, Gid{0}, "/tmp/d/f", "/tmp/e/f"), ResultCode::Success);
+  EXPECT_TRUE(m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/d")->empty());
+  EXPECT_EQ(*m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/e"), std::vector<std::string>{"f"});
+
+  ASSERT_EQ(m_fs->Delete(Uid{0}, Gid{0}, "/tmp/e/f"), ResultCode::Success);
+  EXPECT_TRUE(m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/e")->empty());
+}
+
+TEST_F(FileSystemTest, MetadataIsKeptAcrossInstances)
+{
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/f", 0, modes), ResultCode::Success);
+  ASSERT_EQ(m_fs->SetMetadata(Uid{0}, "/tmp/f", Uid{1234}, Gid{56}, 1, modes),
+            ResultCode::Success);
+
+  m_fs.reset();
+  m_fs = IOS::HLE::Kernel{}.GetFS();
+
+  const Result<Metadata> metadata = m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/f");
+  ASSERT_TRUE(metadata.Succeeded());
+  EXPECT_EQ(metadata->uid, 1234u);
+  EXPECT_EQ(metadata->gid, 56);
+  EXPECT_EQ(metadata->attribute, 1);
+}
+
 // ReadDirectory is used by official titles to determine whether a path is a file.
 // If it is not a file, ResultCode::Invalid must be returned.
 TEST_F(FileSystemTest, ReadDirectoryOnFile)
@@ -469,3 +545,70 @@ TEST_F(FileSystemTest, CreateFullPath)
   EXPECT_EQ(m_fs->CreateFullPath(Uid{0x1000}, Gid{1}, "/shared2/wc24/mbox/Readme.txt", 0, modes),
             ResultCode::Success);
 }
+
+TEST_F(FileSystemTest, OverlayKeepsChangesInMemory)
+{
+  ASSERT_EQ(m_fs->CreateDirectory(Uid{0}, Gid{0}, "/tmp/o", 0, modes), ResultCode::Success);
+  ASSERT_TRUE(m_fs->CreateAndOpenFile(Uid{0}, Gid{0}, "/tmp/o/f", modes)->Write("base", 4));
+
+  const auto overlay = std::make_shared<NandOverlay>();
+  OverlayFileSystem fs{overlay,
+                       std::make_unique<HostFileSystem>(File::GetUserPath(D_WIIROOT_IDX))};
+
+  {
+    const Result<FileHandle> file = fs.OpenFile(Uid{0}, Gid{0}, "/tmp/o/f", Mode::ReadWrite);
+    ASSERT_TRUE(file.Succeeded());
+    ASSERT_TRUE(file->Write("over", 4).Succeeded());
+  }
+  ASSERT_EQ(fs.CreateFile(Uid{0}, Gid{0}, "/tmp/o/new", 0, modes), ResultCode::Success);
+  ASSERT_EQ(fs.CreateDirectory(Uid{0}, Gid{0}, "/tmp/o/dir", 0, modes), ResultCode::Success);
+
+  const auto read_file = [](FileSystem* file_system) {
+    std::array<char, 4> data{};
+    const Result<FileHandle> file = file_system->OpenFile(Uid{0}, Gid{0}, "/tmp/o/f", Mode::Read);
+    if (!file || !file->Read(data.data(), data.size()))
+      return std::string();
+    return std::string(data.data(), data.size());
+  };
+  EXPECT_EQ(read_file(&fs), "over");
+  EXPECT_EQ(read_file(m_fs.get()), "base");
+
+  const Result<std::vector<std::string>> children = fs.ReadDirectory(Uid{0}, Gid{0}, "/tmp/o");
+  ASSERT_TRUE(children.Succeeded());
+  EXPECT_EQ(*children, (std::vector<std::string>{"dir", "new", "f"}));
+  EXPECT_EQ(*m_fs->ReadDirectory(Uid{0}, Gid{0}, "/tmp/o"), std::vector<std::string>{"f"});
+
+  ASSERT_EQ(fs.Rename(Uid{0}, Gid{0}, "/tmp/o/dir", "/tmp/o/dir2"), ResultCode::Success);
+  ASSERT_EQ(fs.Delete(Uid{0}, Gid{0}, "/tmp/o/f"), ResultCode::Success);
+  EXPECT_EQ(fs.GetMetadata(Uid{0}, Gid{0}, "/tmp/o/f").Error(), ResultCode::NotFound);
+  EXPECT_TRUE(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/o/f").Succeeded());
+  EXPECT_EQ(*fs.ReadDirectory(Uid{0}, Gid{0}, "/tmp/o"),
+            (std::vector<std::string>{"dir2", "new"}));
+}
+
+TEST_F(FileSystemTest, OverlayCommit)
+{
+  ASSERT_EQ(m_fs->CreateFile(Uid{0}, Gid{0}, "/tmp/deleted", 0, modes), ResultCode::Success);
+
+  const auto overlay = std::make_shared<NandOverlay>();
+  {
+    OverlayFileSystem fs{overlay,
+                         std::make_unique<HostFileSystem>(File::GetUserPath(D_WIIROOT_IDX))};
+    ASSERT_EQ(fs.Delete(Uid{0}, Gid{0}, "/tmp/deleted"), ResultCode::Success);
+    ASSERT_EQ(fs.CreateDirectory(Uid{0}, Gid{0}, "/tmp/d", 0, modes), ResultCode::Success);
+    ASSERT_EQ(fs.CreateFile(Uid{0}, Gid{0}, "/tmp/d/f", 0, modes), ResultCode::Success);
+    ASSERT_EQ(fs.SetMetadata(Uid{0}, "/tmp/d/f", Uid{1234}, Gid{56}, 1, modes),
+              ResultCode::Success);
+    ASSERT_TRUE(fs.OpenFile(Uid{0}, Gid{0}, "/tmp/d/f", Mode::Write)->Write("data", 4));
+  }
+
+  ASSERT_TRUE(overlay->Commit(m_fs.get()));
+
+  EXPECT_EQ(m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/deleted").Error(), ResultCode::NotFound);
+  const Result<Metadata> metadata = m_fs->GetMetadata(Uid{0}, Gid{0}, "/tmp/d/f");
+  ASSERT_TRUE(metadata.Succeeded());
+  EXPECT_EQ(metadata->size, 4u);
+  EXPECT_EQ(metadata->uid, 1234u);
+  EXPECT_EQ(metadata->gid, 56);
+  EXPECT_EQ(metadata->attribute, 1);
+}
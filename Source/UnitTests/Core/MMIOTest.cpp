@@ -139,3 +139,53 @@ TEST_F(MappingTest, ReadWriteComplex)
   EXPECT_TRUE(read_called);
   EXPECT_TRUE(write_called);
 }
+
+TEST_F(MappingTest, ReadSizeConversions)
+{
+  struct DirectCheckVisitor : public MMIO::ReadHandlingMethodVisitor<u32>
+  {
+    void VisitConstant(u32 value) override {}
+    void VisitDirect(const u32* addr, u32 mask) override { is_direct = true; }
+    void VisitComplex(const std::function<u32(u32)>* lambda) override {}
+    bool is_direct = false;
+  };
+
+  // A 32 bit register stored as two 16 bit halves, like most of the VI registers.
+  struct alignas(4)
+  {
+    u16 lo = 0x5678;
+    u16 hi = 0x1234;
+  } split;
+  m_mapping->Register(0x0C001000, MMIO::DirectRead<u16>(&split.hi), MMIO::Nop<u16>());
+  m_mapping->Register(0x0C001002, MMIO::DirectRead<u16>(&split.lo, 0xFF), MMIO::Nop<u16>());
+  m_mapping->Register(0x0C001004, MMIO::Constant<u16>(0xdead), MMIO::Nop<u16>());
+  m_mapping->Register(0x0C001006, MMIO::Constant<u16>(0xbeef), MMIO::Nop<u16>());
+  for (u32 i = 0; i < 8; i += 4)
+  {
+    m_mapping->Register(0x0C001000 | i, MMIO::ReadToSmaller<u32>(m_mapping, 0x0C001000 | i,
+                                                                 0x0C001002 | i),
+                        MMIO::Nop<u32>());
+  }
+
+  u32 full = 0x89abcdef;
+  m_mapping->Register(0x0C001010, MMIO::DirectRead<u32>(&full), MMIO::Nop<u32>());
+  m_mapping->Register(0x0C001010, MMIO::ReadToLarger<u16>(m_mapping, 0x0C001010, 16),
+                      MMIO::Nop<u16>());
+  m_mapping->Register(0x0C001012, MMIO::ReadToLarger<u16>(m_mapping, 0x0C001010, 0),
+                      MMIO::Nop<u16>());
+
+  EXPECT_EQ(0x12340078u, m_mapping->Read<u32>(0x0C001000));
+  EXPECT_EQ(0xdeadbeefu, m_mapping->Read<u32>(0x0C001004));
+  EXPECT_EQ(0x89ab, m_mapping->Read<u16>(0x0C001010));
+  EXPECT_EQ(0xcdef, m_mapping->Read<u16>(0x0C001012));
+
+  DirectCheckVisitor visitor;
+  m_mapping->GetHandlerForRead<u32>(0x0C001000).Visit(visitor);
+  EXPECT_TRUE(visitor.is_direct);
+
+  split.hi = 0x4321;
+  full = 0x01234567;
+  EXPECT_EQ(0x43210078u, m_mapping->Read<u32>(0x0C001000));
+  EXPECT_EQ(0x0123, m_mapping->Read<u16>(0x0C001010));
+  EXPECT_EQ(0x4567, m_mapping->Read<u16>(0x0C001012));
+}
@@ -0,0 +1,443 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/BitUtils.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Intrinsics.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/EXI/EXI.h"
+#include "Core/HW/EXI/EXI_Device.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MemTools.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "UICommon/UICommon.h"
+
+// Runs small guest kernels on each of the CPU cores that compile guest code, and prints how much
+// host time each guest instruction takes. The kernels are infinite loops which count their
+// iterations in r31, so the number of guest instructions executed is known exactly.
+
+namespace
+{
+constexpr u32 CODE_ADDRESS = 0x00003000;
+constexpr u32 MATRIX_ADDRESS = 0x00100000;
+constexpr u32 VECTOR_ADDRESS = 0x00100100;
+constexpr u32 OUTPUT_ADDRESS = 0x00100200;
+constexpr u32 QUANTIZED_INPUT_ADDRESS = 0x00101000;
+constexpr u32 QUANTIZED_OUTPUT_ADDRESS = 0x00101100;
+
+constexpr u32 ITERATION_GPR = 31;
+constexpr u32 WARMUP_ITERATIONS = 1000;
+constexpr auto MEASURE_TIME = std::chrono::milliseconds(100);
+
+// Instruction encoders, only covering the forms used below.
+constexpr u32 DForm(u32 op, u32 d, u32 a, s32 imm)
+{
+  return (op << 26) | (d << 21) | (a << 16) | (static_cast<u32>(imm) & 0xFFFF);
+}
+constexpr u32 XForm(u32 op, u32 d, u32 a, u32 b, u32 xo, bool rc = false)
+{
+  return (op << 26) | (d << 21) | (a << 16) | (b << 11) | (xo << 1) | rc;
+}
+constexpr u32 AForm(u32 op, u32 d, u32 a, u32 b, u32 c, u32 xo)
+{
+  return (op << 26) | (d << 21) | (a << 16) | (b << 11) | (c << 6) | (xo << 1);
+}
+
+constexpr u32 addi(u32 d, u32 a, s32 imm)
+{
+  return DForm(14, d, a, imm);
+}
+constexpr u32 cmpwi(u32 a, s32 imm)
+{
+  return DForm(11, 0, a, imm);
+}
+constexpr u32 add(u32 d, u32 a, u32 b)
+{
+  return XForm(31, d, a, b, 266);
+}
+constexpr u32 subf(u32 d, u32 a, u32 b)
+{
+  return XForm(31, d, a, b, 40);
+}
+constexpr u32 mullw(u32 d, u32 a, u32 b)
+{
+  return XForm(31, d, a, b, 235);
+}
+constexpr u32 and_(u32 a, u32 s, u32 b)
+{
+  return XForm(31, s, a, b, 28);
+}
+constexpr u32 or_(u32 a, u32 s, u32 b)
+{
+  return XForm(31, s, a, b, 444);
+}
+constexpr u32 xor_(u32 a, u32 s, u32 b)
+{
+  return XForm(31, s, a, b, 316);
+}
+constexpr u32 srawi(u32 a, u32 s, u32 sh)
+{
+  return XForm(31, s, a, sh, 824);
+}
+constexpr u32 rlwinm(u32 a, u32 s, u32 sh, u32 mb, u32 me, bool rc = false)
+{
+  return (21 << 26) | (s << 21) | (a << 16) | (sh << 11) | (mb << 6) | (me << 1) | rc;
+}
+constexpr u32 branch(s32 offset)
+{
+  return (18 << 26) | (static_cast<u32>(offset) & 0x03FFFFFC);
+}
+// Branches over the next instruction if the condition register bit has the given value.
+constexpr u32 bc_skip_one(u32 bi, bool branch_if_true)
+{
+  return (16 << 26) | ((branch_if_true ? 12u : 4u) << 21) | (bi << 16) | 8;
+}
+
+constexpr u32 ps_add(u32 d, u32 a, u32 b)
+{
+  return AForm(4, d, a, b, 0, 21);
+}
+constexpr u32 ps_sub(u32 d, u32 a, u32 b)
+{
+  return AForm(4, d, a, b, 0, 20);
+}
+constexpr u32 ps_mul(u32 d, u32 a, u32 c)
+{
+  return AForm(4, d, a, 0, c, 25);
+}
+constexpr u32 ps_madd(u32 d, u32 a, u32 c, u32 b)
+{
+  return AForm(4, d, a, b, c, 29);
+}
+constexpr u32 ps_nmsub(u32 d, u32 a, u32 c, u32 b)
+{
+  return AForm(4, d, a, b, c, 30);
+}
+constexpr u32 ps_madds0(u32 d, u32 a, u32 c, u32 b)
+{
+  return AForm(4, d, a, b, c, 14);
+}
+constexpr u32 ps_sum0(u32 d, u32 a, u32 c, u32 b)
+{
+  return AForm(4, d, a, b, c, 10);
+}
+constexpr u32 ps_merge10(u32 d, u32 a, u32 b)
+{
+  return XForm(4, d, a, b, 592);
+}
+constexpr u32 psq_l(u32 d, s32 offset, u32 a, bool w, u32 i)
+{
+  return (56 << 26) | (d << 21) | (a << 16) | (u32{w} << 15) | (i << 12) |
+         (static_cast<u32>(offset) & 0xFFF);
+}
+constexpr u32 psq_st(u32 s, s32 offset, u32 a, bool w, u32 i)
+{
+  return (60 << 26) | (s << 21) | (a << 16) | (u32{w} << 15) | (i << 12) |
+         (static_cast<u32>(offset) & 0xFFF);
+}
+
+struct Kernel
+{
+  const char* name;
+  std::vector<u32> body;
+  // GPRs which count how often the conditionally executed instructions in the body ran, one
+  // instruction per increment.
+  std::vector<u32> conditional_gprs;
+};
+
+std::vector<Kernel> GetKernels()
+{
+  std::vector<Kernel> kernels;
+
+  kernels.push_back({"Integer ALU",
+                     {
+                         add(10, 10, 11),
+                         xor_(11, 11, 10),
+                         rlwinm(12, 10, 3, 0, 28),
+                         subf(13, 12, 11),
+                         mullw(14, 13, 10),
+                         srawi(15, 14, 2),
+                         and_(16, 15, 11),
+                         add(17, 16, 14),
+                         or_(18, 17, 12),
+                         addi(11, 11, 7),
+                     },
+                     {}});
+
+  // A linear congruential generator decides which branches are taken, so that they are
+  // unpredictable for the host as well.
+  kernels.push_back({"Branchy",
+                     {
+                         mullw(20, 20, 21),
+                         addi(20, 20, 12345),
+                         rlwinm(22, 20, 0, 16, 16, true),
+                         bc_skip_one(2, true),
+                         addi(23, 23, 1),
+                         cmpwi(20, 0),
+                         bc_skip_one(0, true),
+                         addi(24, 24, 1),
+                         rlwinm(22, 20, 0, 8, 8, true),
+                         bc_skip_one(2, false),
+                         addi(25, 25, 1),
+                     },
+                     {23, 24, 25}});
+
+  // The multipliers are 0.5, so the values converge instead of overflowing.
+  kernels.push_back({"Paired single math",
+                     {
+                         ps_madd(1, 1, 2, 3),
+                         ps_madd(4, 4, 2, 3),
+                         ps_mul(5, 1, 4),
+                         ps_merge10(6, 5, 5),
+                         ps_add(7, 6, 5),
+                         ps_sum0(8, 7, 8, 7),
+                         ps_madds0(9, 8, 7, 2),
+                         ps_sub(10, 9, 3),
+                         ps_nmsub(11, 10, 2, 3),
+                     },
+                     {}});
+
+  // PSMTXMultVec from the GameCube SDK, with the matrix in r3, the vector in r4 and the result in
+  // r5.
+  kernels.push_back({"PSMTXMultVec",
+                     {
+                         psq_l(0, 0, 4, false, 0),
+                         psq_l(2, 0, 3, false, 0),
+                         psq_l(1, 8, 4, true, 0),
+                         ps_mul(4, 2, 0),
+                         psq_l(3, 8, 3, false, 0),
+                         ps_madd(5, 3, 1, 4),
+                         psq_l(8, 16, 3, false, 0),
+                         ps_sum0(6, 5, 6, 5),
+                         psq_l(9, 24, 3, false, 0),
+                         ps_mul(10, 8, 0),
+                         psq_st(6, 0, 5, true, 0),
+                         ps_madd(11, 9, 1, 10),
+                         psq_l(2, 32, 3, false, 0),
+                         ps_sum0(12, 11, 12, 11),
+                         psq_l(3, 40, 3, false, 0),
+                         ps_mul(4, 2, 0),
+                         psq_st(12, 4, 5, true, 0),
+                         ps_madd(5, 3, 1, 4),
+                         ps_sum0(6, 5, 6, 5),
+                         psq_st(6, 8, 5, true, 0),
+                     },
+                     {}});
+
+  // Unpacks u8 data like vertex colors, and round trips through s16 and u8 with scaling, using
+  // GQR2 and GQR3.
+  kernels.push_back({"Quantized load/store",
+                     {
+                         psq_l(1, 0, 6, false, 2),
+                         psq_l(2, 2, 6, false, 2),
+                         psq_l(3, 4, 6, true, 2),
+                         ps_add(4, 1, 2),
+                         psq_st(4, 0, 7, false, 2),
+                         psq_l(5, 0, 7, false, 3),
+                         ps_add(6, 5, 3),
+                         psq_st(6, 8, 7, false, 3),
+                         psq_st(4, 12, 7, true, 2),
+                     },
+                     {}});
+
+  return kernels;
+}
+
+class ScopeInit final
+{
+public:
+  explicit ScopeInit(PowerPC::CPUCore cpu_core) : m_profile_path(File::CreateTempDir())
+  {
+    if (!UserDirectoryExists())
+      return;
+
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    // Memory::Init needs the EXI channels to map their registers. Keep them empty.
+    Config::SetCurrent(Config::MAIN_SLOT_A, ExpansionInterface::EXIDeviceType::None);
+    Config::SetCurrent(Config::MAIN_SLOT_B, ExpansionInterface::EXIDeviceType::None);
+    Config::SetCurrent(Config::MAIN_SERIAL_PORT_1, ExpansionInterface::EXIDeviceType::None);
+    EMM::InstallExceptionHandler();
+    CoreTiming::Init();
+    ExpansionInterface::Init(nullptr);
+    Memory::Init();
+    PowerPC::Init(cpu_core);
+  }
+  ~ScopeInit()
+  {
+    if (!UserDirectoryExists())
+      return;
+
+    PowerPC::Shutdown();
+    Memory::Shutdown();
+    ExpansionInterface::Shutdown();
+    CoreTiming::Shutdown();
+    EMM::UninstallExceptionHandler();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+  bool UserDirectoryExists() const { return !m_profile_path.empty(); }
+
+private:
+  std::string m_profile_path;
+};
+
+void SetUpGuestState(const Kernel& kernel)
+{
+  u32 address = CODE_ADDRESS;
+  for (const u32 inst : kernel.body)
+  {
+    Memory::Write_U32(inst, address);
+    address += 4;
+  }
+  Memory::Write_U32(addi(ITERATION_GPR, ITERATION_GPR, 1), address);
+  address += 4;
+  Memory::Write_U32(branch(static_cast<s32>(CODE_ADDRESS - address)), address);
+
+  for (u32 i = 0; i < 12; ++i)
+    Memory::Write_U32(Common::BitCast<u32>(1.0f + i * 0.25f), MATRIX_ADDRESS + i * 4);
+  for (u32 i = 0; i < 3; ++i)
+    Memory::Write_U32(Common::BitCast<u32>(2.0f - i * 0.5f), VECTOR_ADDRESS + i * 4);
+  for (u32 i = 0; i < 8; ++i)
+    Memory::Write_U8(static_cast<u8>(i * 37), QUANTIZED_INPUT_ADDRESS + i);
+
+  auto& ppc_state = PowerPC::ppcState;
+  ppc_state.pc = CODE_ADDRESS;
+  ppc_state.npc = CODE_ADDRESS + 4;
+  ppc_state.msr.FP = 1;
+  HID2.PSE = 1;
+  HID2.LSQE = 1;
+
+  UGQR gqr2;
+  gqr2.ld_type = QUANTIZE_U8;
+  gqr2.st_type = QUANTIZE_S16;
+  GQR(2) = gqr2.Hex;
+  UGQR gqr3;
+  gqr3.ld_type = QUANTIZE_S16;
+  gqr3.ld_scale = 8;
+  gqr3.st_type = QUANTIZE_U8;
+  GQR(3) = gqr3.Hex;
+
+  ppc_state.gpr[3] = MATRIX_ADDRESS;
+  ppc_state.gpr[4] = VECTOR_ADDRESS;
+  ppc_state.gpr[5] = OUTPUT_ADDRESS;
+  ppc_state.gpr[6] = QUANTIZED_INPUT_ADDRESS;
+  ppc_state.gpr[7] = QUANTIZED_OUTPUT_ADDRESS;
+  ppc_state.gpr[10] = 0x12345678;
+  ppc_state.gpr[11] = 0x9ABCDEF0;
+  ppc_state.gpr[20] = 1;
+  ppc_state.gpr[21] = 1103515245;
+
+  ppc_state.ps[1].Fill(1.0);
+  ppc_state.ps[2].Fill(0.5);
+  ppc_state.ps[3].Fill(1.0);
+  ppc_state.ps[4].Fill(1.0);
+  ppc_state.ps[8].Fill(1.0);
+}
+
+void ResetCounters(const Kernel& kernel)
+{
+  PowerPC::ppcState.gpr[ITERATION_GPR] = 0;
+  for (const u32 gpr : kernel.conditional_gprs)
+    PowerPC::ppcState.gpr[gpr] = 0;
+}
+
+u64 CountGuestInstructions(const Kernel& kernel)
+{
+  const u64 unconditional = kernel.body.size() + 2 - kernel.conditional_gprs.size();
+  u64 count = PowerPC::ppcState.gpr[ITERATION_GPR] * unconditional;
+  for (const u32 gpr : kernel.conditional_gprs)
+    count += PowerPC::ppcState.gpr[gpr];
+  return count;
+}
+
+u64 ReadCycleCounter()
+{
+#ifdef _M_X86_64
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+const char* GetCoreName(PowerPC::CPUCore cpu_core)
+{
+  switch (cpu_core)
+  {
+  case PowerPC::CPUCore::JIT64:
+    return "Jit64";
+  case PowerPC::CPUCore::JITARM64:
+    return "JitArm64";
+  case PowerPC::CPUCore::CachedInterpreter:
+    return "CachedInterpreter";
+  default:
+    return "Interpreter";
+  }
+}
+}  // namespace
+
+// PowerPC::SingleStep runs a whole timing slice on the JITs, but only a single block on the
+// cached interpreter, so its numbers include calling CoreTiming::Advance for every block. The
+// interpreter steps single instructions and isn't measured at all.
+TEST(PowerPC, JitBenchmark)
+{
+  for (const Kernel& kernel : GetKernels())
+  {
+    for (const PowerPC::CPUCore cpu_core : PowerPC::AvailableCPUCores())
+    {
+      if (cpu_core == PowerPC::CPUCore::Interpreter)
+        continue;
+
+      ScopeInit guard(cpu_core);
+      ASSERT_TRUE(guard.UserDirectoryExists());
+
+      SetUpGuestState(kernel);
+
+      // Let blocks get compiled and linked first.
+      while (PowerPC::ppcState.gpr[ITERATION_GPR] < WARMUP_ITERATIONS)
+        PowerPC::SingleStep();
+      ResetCounters(kernel);
+
+      const auto start = std::chrono::steady_clock::now();
+      const u64 start_cycles = ReadCycleCounter();
+      auto end = start;
+      while (end - start < MEASURE_TIME)
+      {
+        for (int i = 0; i < 64; ++i)
+          PowerPC::SingleStep();
+        end = std::chrono::steady_clock::now();
+      }
+      const u64 cycles = ReadCycleCounter() - start_cycles;
+
+      const u64 guest_instructions = CountGuestInstructions(kernel);
+      ASSERT_GT(guest_instructions, 0u);
+
+      const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+      std::string result = fmt::format("{:<22} {:<18} {:8.3f} ns/instruction", kernel.name,
+                                       GetCoreName(cpu_core), ns / guest_instructions);
+      if (cycles != 0)
+      {
+        result += fmt::format(" {:8.3f} host cycles/instruction",
+                              static_cast<double>(cycles) / guest_instructions);
+      }
+      fmt::print("{}\n", result);
+    }
+  }
+}
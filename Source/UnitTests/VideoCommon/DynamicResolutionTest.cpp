@@ -0,0 +1,76 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/DynamicResolution.h"
+
+using VideoCommon::DynamicResolution;
+
+namespace
+{
+constexpr u64 TARGET_US = 16667;
+constexpr u64 ON_TIME_US = 16000;
+constexpr u64 SLOW_US = 25000;
+
+void RunFrames(DynamicResolution& controller, u32 count, u64 frame_time_us)
+{
+  for (u32 i = 0; i < count; ++i)
+    controller.Update(frame_time_us, TARGET_US);
+}
+}  // namespace
+
+TEST(DynamicResolution, StartsAtMaxScale)
+{
+  DynamicResolution controller;
+  controller.Reset(1, 4);
+  EXPECT_EQ(4u, controller.GetScale());
+  RunFrames(controller, 1000, ON_TIME_US);
+  EXPECT_EQ(4u, controller.GetScale());
+}
+
+TEST(DynamicResolution, LowersScaleOnSlowFrames)
+{
+  DynamicResolution controller;
+  controller.Reset(2, 4);
+
+  RunFrames(controller, DynamicResolution::SLOW_FRAMES_TO_LOWER - 1, SLOW_US);
+  EXPECT_EQ(4u, controller.GetScale());
+  RunFrames(controller, 1, SLOW_US);
+  EXPECT_EQ(3u, controller.GetScale());
+
+  // Never goes below the minimum.
+  RunFrames(controller, DynamicResolution::SLOW_FRAMES_TO_LOWER * 10, SLOW_US);
+  EXPECT_EQ(2u, controller.GetScale());
+}
+
+TEST(DynamicResolution, IgnoresIsolatedSlowFrames)
+{
+  DynamicResolution controller;
+  controller.Reset(1, 4);
+  for (u32 i = 0; i < 100; ++i)
+  {
+    controller.Update(SLOW_US, TARGET_US);
+    controller.Update(ON_TIME_US, TARGET_US);
+  }
+  EXPECT_EQ(4u, controller.GetScale());
+}
+
+TEST(DynamicResolution, BacksOffFailedRaises)
+{
+  DynamicResolution controller;
+  controller.Reset(1, 4);
+  RunFrames(controller, DynamicResolution::SLOW_FRAMES_TO_LOWER, SLOW_US);
+  ASSERT_EQ(3u, controller.GetScale());
+
+  RunFrames(controller, DynamicResolution::MIN_FAST_FRAMES_TO_RAISE, ON_TIME_US);
+  ASSERT_EQ(4u, controller.GetScale());
+
+  // The raise made frames slow, so the next raise waits twice as long.
+  RunFrames(controller, DynamicResolution::SLOW_FRAMES_TO_LOWER, SLOW_US);
+  ASSERT_EQ(3u, controller.GetScale());
+  RunFrames(controller, DynamicResolution::MIN_FAST_FRAMES_TO_RAISE, ON_TIME_US);
+  EXPECT_EQ(3u, controller.GetScale());
+  RunFrames(controller, DynamicResolution::MIN_FAST_FRAMES_TO_RAISE, ON_TIME_US);
+  EXPECT_EQ(4u, controller.GetScale());
+}
@@ -303,6 +303,71 @@ TEST_P(VertexLoaderSpeedTest, TexCoordSingleElement)
     RunVertices(100000);
 }
 
+TEST_P(VertexLoaderSpeedTest, PositionIndex16All)
+{
+  ComponentFormat format;
+  int elements_i;
+  std::tie(format, elements_i) = GetParam();
+  CoordComponentCount elements = static_cast<CoordComponentCount>(elements_i);
+  fmt::print("format: {}, elements: {}\n", format, elements);
+  const u32 elem_count = elements == CoordComponentCount::XY ? 2 : 3;
+  m_vtx_desc.low.Position = VertexComponentFormat::Index16;
+  m_vtx_attr.g0.PosFormat = format;
+  m_vtx_attr.g0.PosElements = elements;
+  const size_t elem_size = GetElementSize(format);
+  CreateAndCheckSizes(sizeof(u16), elem_count * sizeof(float));
+  VertexLoaderManager::cached_arraybases[CPArray::Position] = m_src.GetPointer();
+  g_main_cp_state.array_strides[CPArray::Position] = elem_count * elem_size;
+  for (int i = 0; i < 1000; ++i)
+    RunVertices(100000);
+}
+
+TEST_P(VertexLoaderSpeedTest, NormalIndex16All)
+{
+  ComponentFormat format;
+  int elements_i;
+  std::tie(format, elements_i) = GetParam();
+  NormalComponentCount elements = static_cast<NormalComponentCount>(elements_i);
+  fmt::print("format: {}, elements: {}\n", format, elements);
+  const u32 normal_count = elements == NormalComponentCount::N ? 1 : 3;
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Byte;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Index16;
+  m_vtx_attr.g0.NormalFormat = format;
+  m_vtx_attr.g0.NormalElements = elements;
+  CreateAndCheckSizes(2 * sizeof(s8) + sizeof(u16),
+                      2 * sizeof(float) + normal_count * 3 * sizeof(float));
+  VertexLoaderManager::cached_arraybases[CPArray::Normal] = m_src.GetPointer();
+  g_main_cp_state.array_strides[CPArray::Normal] = normal_count * 3 * GetElementSize(format);
+  for (int i = 0; i < 1000; ++i)
+    RunVertices(100000);
+}
+
+class VertexLoaderColorSpeedTest : public VertexLoaderTest,
+                                   public ::testing::WithParamInterface<ColorFormat>
+{
+};
+INSTANTIATE_TEST_CASE_P(AllColorFormats, VertexLoaderColorSpeedTest,
+                        ::testing::Values(ColorFormat::RGB565, ColorFormat::RGB888,
+                                          ColorFormat::RGB888x, ColorFormat::RGBA4444,
+                                          ColorFormat::RGBA6666, ColorFormat::RGBA8888));
+
+TEST_P(VertexLoaderColorSpeedTest, ColorIndex16)
+{
+  const ColorFormat format = GetParam();
+  fmt::print("format: {}\n", format);
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Byte;
+  m_vtx_desc.low.Color0 = VertexComponentFormat::Index16;
+  m_vtx_attr.g0.Color0Elements = ColorComponentCount::RGBA;
+  m_vtx_attr.g0.Color0Comp = format;
+  CreateAndCheckSizes(2 * sizeof(s8) + sizeof(u16), 2 * sizeof(float) + sizeof(u32));
+  VertexLoaderManager::cached_arraybases[CPArray::Color0] = m_src.GetPointer();
+  g_main_cp_state.array_strides[CPArray::Color0] = sizeof(u32);
+  for (int i = 0; i < 1000; ++i)
+    RunVertices(100000);
+}
+
 TEST_F(VertexLoaderTest, LargeFloatVertexSpeed)
 {
   // Enables most attributes in floating point indexed mode to test speed.
@@ -0,0 +1,333 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexLoader.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VideoConfig.h"
+
+#ifdef _M_X86_64
+#include "VideoCommon/VertexLoaderX64.h"
+#elif defined(_M_ARM_64)
+#include "VideoCommon/VertexLoaderARM64.h"
+#endif
+
+// include order is important
+#include <gtest/gtest.h>  // NOLINT
+
+// Throughput of the video code which runs on the CPU for every texture and vertex. These aren't
+// part of the unit tests; build the benchmarks target and run VideoCommonBenchmark.
+//
+// Code which checks cpu_info when it runs or generates code is measured once per feature level,
+// by hiding the host's newer instruction set extensions from it.
+
+namespace
+{
+constexpr auto MEASURE_TIME = std::chrono::milliseconds(50);
+
+// Calls function until MEASURE_TIME has passed, and returns how many GB/s that makes if each call
+// processes the given number of bytes.
+double MeasureThroughput(u64 bytes_per_call, const std::function<void()>& function)
+{
+  function();
+
+  u64 calls = 0;
+  const auto start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::duration elapsed;
+  do
+  {
+    function();
+    ++calls;
+    elapsed = std::chrono::steady_clock::now() - start;
+  } while (elapsed < MEASURE_TIME);
+
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  return static_cast<double>(bytes_per_call) * calls / seconds / 1e9;
+}
+
+void PrintResult(std::string_view group, std::string_view feature_level, std::string_view name,
+                 double gb_per_second)
+{
+  fmt::print("{:<16} {:<8} {:<44} {:8.2f} GB/s\n", group, feature_level, name, gb_per_second);
+}
+
+struct FeatureLevel
+{
+  const char* name;
+  void (*apply)(CPUInfo* info);
+};
+
+// Runs function once for the host's own features and once for each older feature level that the
+// host also supports.
+void ForEachFeatureLevel(const std::function<void(const char*)>& function)
+{
+  const CPUInfo host_info = cpu_info;
+
+  function("Host");
+
+#ifdef _M_X86_64
+  static constexpr FeatureLevel levels[] = {
+      {"SSE4.1",
+       [](CPUInfo* info) {
+         info->bAVX = info->bAVX2 = info->bFMA = false;
+         info->bBMI1 = info->bBMI2 = info->bBMI2FastParallelBitOps = false;
+       }},
+      {"SSSE3", [](CPUInfo* info) { info->bSSE4_1 = info->bSSE4_2 = false; }},
+      {"SSE2", [](CPUInfo* info) { info->bSSE3 = info->bSSSE3 = false; }},
+  };
+  for (const FeatureLevel& level : levels)
+  {
+    level.apply(&cpu_info);
+    function(level.name);
+  }
+#endif
+
+  cpu_info = host_info;
+}
+
+struct VertexAttributeFormat
+{
+  std::string name;
+  TVtxDesc vtx_desc;
+  VAT vtx_attr;
+};
+
+std::vector<VertexAttributeFormat> GetVertexAttributeFormats()
+{
+  static constexpr ComponentFormat component_formats[] = {
+      ComponentFormat::UByte, ComponentFormat::Byte, ComponentFormat::UShort,
+      ComponentFormat::Short, ComponentFormat::Float};
+  static constexpr ColorFormat color_formats[] = {ColorFormat::RGB565,   ColorFormat::RGB888,
+                                                  ColorFormat::RGB888x,  ColorFormat::RGBA4444,
+                                                  ColorFormat::RGBA6666, ColorFormat::RGBA8888};
+
+  // Every attribute other than the position is measured together with a float XYZ position,
+  // since vertices without positions don't occur in practice.
+  VertexAttributeFormat base;
+  base.vtx_desc.low.Position = VertexComponentFormat::Direct;
+  base.vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  base.vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  base.vtx_attr.g0.ByteDequant = true;
+
+  std::vector<VertexAttributeFormat> formats;
+  for (const ComponentFormat format : component_formats)
+  {
+    for (const CoordComponentCount elements : {CoordComponentCount::XY, CoordComponentCount::XYZ})
+    {
+      VertexAttributeFormat& position = formats.emplace_back(base);
+      position.name = fmt::format("Position {} {}", format, elements);
+      position.vtx_attr.g0.PosFormat = format;
+      position.vtx_attr.g0.PosElements = elements;
+    }
+  }
+  for (const ComponentFormat format : component_formats)
+  {
+    for (const NormalComponentCount elements : {NormalComponentCount::N, NormalComponentCount::NTB})
+    {
+      VertexAttributeFormat& normal = formats.emplace_back(base);
+      normal.name = fmt::format("Normal {} {}", format, elements);
+      normal.vtx_desc.low.Normal = VertexComponentFormat::Direct;
+      normal.vtx_attr.g0.NormalFormat = format;
+      normal.vtx_attr.g0.NormalElements = elements;
+    }
+  }
+  for (const ColorFormat format : color_formats)
+  {
+    VertexAttributeFormat& color = formats.emplace_back(base);
+    color.name = fmt::format("Color {}", format);
+    color.vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+    color.vtx_attr.g0.Color0Comp = format;
+    color.vtx_attr.g0.Color0Elements = ColorComponentCount::RGBA;
+  }
+  for (const ComponentFormat format : component_formats)
+  {
+    for (const TexComponentCount elements : {TexComponentCount::S, TexComponentCount::ST})
+    {
+      VertexAttributeFormat& tex_coord = formats.emplace_back(base);
+      tex_coord.name = fmt::format("TexCoord {} {}", format, elements);
+      tex_coord.vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+      tex_coord.vtx_attr.g0.Tex0CoordFormat = format;
+      tex_coord.vtx_attr.g0.Tex0CoordElements = elements;
+    }
+  }
+  return formats;
+}
+
+// Stops the compiler from removing calls whose results would be unused otherwise.
+volatile u64 s_sink;
+}  // namespace
+
+TEST(VideoCommonBenchmark, TextureDecoder)
+{
+  static constexpr TextureFormat formats[] = {
+      TextureFormat::I4,     TextureFormat::I8,     TextureFormat::IA4,   TextureFormat::IA8,
+      TextureFormat::RGB565, TextureFormat::RGB5A3, TextureFormat::RGBA8, TextureFormat::C4,
+      TextureFormat::C8,     TextureFormat::C14X2,  TextureFormat::CMPR,  TextureFormat::XFB};
+  static constexpr int sizes[] = {64, 256, 1024};
+
+  // Large enough for the 16384 entries of C14X2.
+  std::vector<u8> tlut(16384 * 2);
+  for (size_t i = 0; i < tlut.size(); ++i)
+    tlut[i] = static_cast<u8>(i * 7);
+
+  const int max_size = sizes[std::size(sizes) - 1];
+  std::vector<u8> src(TexDecoder_GetTextureSizeInBytes(max_size, max_size, TextureFormat::RGBA8));
+  for (size_t i = 0; i < src.size(); ++i)
+    src[i] = static_cast<u8>(i * 2654435761u >> 24);
+  std::vector<u8> dst(max_size * max_size * 4);
+
+  ForEachFeatureLevel([&](const char* feature_level) {
+    for (const TextureFormat format : formats)
+    {
+      for (const int size : sizes)
+      {
+        // Throughput is given in decoded RGBA8 bytes, so that formats can be compared.
+        const double gb_per_second = MeasureThroughput(size * size * 4, [&] {
+          TexDecoder_Decode(dst.data(), src.data(), size, size, format, tlut.data(),
+                            TLUTFormat::RGB5A3);
+        });
+        // XFB isn't a real texture format, so the formatter doesn't know its name.
+        const std::string format_name =
+            format == TextureFormat::XFB ? "XFB" : fmt::format("{}", format);
+        PrintResult("TextureDecoder", feature_level,
+                    fmt::format("{} {}x{}", format_name, size, size),
+                    gb_per_second);
+      }
+    }
+  });
+}
+
+TEST(VideoCommonBenchmark, VertexLoader)
+{
+  constexpr int NUM_VERTICES = 65536;
+  // Larger than any vertex in GetVertexAttributeFormats, in and out.
+  constexpr size_t MAX_VERTEX_SIZE = 64;
+
+  std::vector<u8> src(NUM_VERTICES * MAX_VERTEX_SIZE, 0x3F);
+  std::vector<u8> dst(NUM_VERTICES * MAX_VERTEX_SIZE);
+
+  struct Backend
+  {
+    const char* name;
+    std::unique_ptr<VertexLoaderBase> (*create)(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
+  };
+  static constexpr Backend backends[] = {
+      {"Software",
+       [](const TVtxDesc& vtx_desc, const VAT& vtx_attr) -> std::unique_ptr<VertexLoaderBase> {
+         return std::make_unique<VertexLoader>(vtx_desc, vtx_attr);
+       }},
+#ifdef _M_X86_64
+      {"X64",
+       [](const TVtxDesc& vtx_desc, const VAT& vtx_attr) -> std::unique_ptr<VertexLoaderBase> {
+         return std::make_unique<VertexLoaderX64>(vtx_desc, vtx_attr);
+       }},
+#elif defined(_M_ARM_64)
+      {"ARM64",
+       [](const TVtxDesc& vtx_desc, const VAT& vtx_attr) -> std::unique_ptr<VertexLoaderBase> {
+         return std::make_unique<VertexLoaderARM64>(vtx_desc, vtx_attr);
+       }},
+#endif
+  };
+
+  const std::vector<VertexAttributeFormat> formats = GetVertexAttributeFormats();
+  ForEachFeatureLevel([&](const char* feature_level) {
+    for (const Backend& backend : backends)
+    {
+      for (const VertexAttributeFormat& format : formats)
+      {
+        // The loaders generate code for the current feature level when they are created.
+        const std::unique_ptr<VertexLoaderBase> loader =
+            backend.create(format.vtx_desc, format.vtx_attr);
+        ASSERT_LE(loader->m_vertex_size, MAX_VERTEX_SIZE);
+        ASSERT_LE(static_cast<size_t>(loader->m_native_vtx_decl.stride), MAX_VERTEX_SIZE);
+
+        // Throughput is given in GameCube vertex bytes.
+        const double gb_per_second =
+            MeasureThroughput(u64{loader->m_vertex_size} * NUM_VERTICES, [&] {
+              loader->RunVertices(DataReader(src.data(), src.data() + src.size()),
+                                  DataReader(dst.data(), dst.data() + dst.size()), NUM_VERTICES);
+            });
+        PrintResult(fmt::format("VertexLoader{}", backend.name), feature_level, format.name,
+                    gb_per_second);
+      }
+    }
+  });
+}
+
+// GetHash64 picks its implementation on the first call, so only the host's features are measured.
+TEST(VideoCommonBenchmark, GetHash64)
+{
+  static constexpr u32 sizes[] = {4096, 65536, 1024 * 1024};
+
+  std::vector<u8> data(sizes[std::size(sizes) - 1]);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<u8>(i * 2654435761u >> 24);
+
+  for (const u32 size : sizes)
+  {
+    for (const u32 samples : {0u, 128u})
+    {
+      const double gb_per_second =
+          MeasureThroughput(size, [&] { s_sink = Common::GetHash64(data.data(), size, samples); });
+      PrintResult("GetHash64", "Host", fmt::format("{} bytes, {} samples", size, samples),
+                  gb_per_second);
+    }
+  }
+}
+
+TEST(VideoCommonBenchmark, IndexGenerator)
+{
+  using OpcodeDecoder::Primitive;
+  static constexpr Primitive primitives[] = {
+      Primitive::GX_DRAW_QUADS,          Primitive::GX_DRAW_TRIANGLES,
+      Primitive::GX_DRAW_TRIANGLE_STRIP, Primitive::GX_DRAW_TRIANGLE_FAN,
+      Primitive::GX_DRAW_LINES,          Primitive::GX_DRAW_LINE_STRIP,
+      Primitive::GX_DRAW_POINTS};
+  constexpr u32 NUM_VERTICES = 4092;
+  constexpr u32 NUM_PRIMITIVES = 16;
+
+  // Triangle fans produce the most indices, three for every vertex.
+  std::vector<u16> indices(NUM_VERTICES * NUM_PRIMITIVES * 3);
+
+  const bool supports_primitive_restart = g_Config.backend_info.bSupportsPrimitiveRestart;
+  for (const bool primitive_restart : {false, true})
+  {
+    g_Config.backend_info.bSupportsPrimitiveRestart = primitive_restart;
+    IndexGenerator generator;
+    generator.Init();
+
+    for (const Primitive primitive : primitives)
+    {
+      generator.Start(indices.data());
+      for (u32 i = 0; i < NUM_PRIMITIVES; ++i)
+        generator.AddIndices(primitive, NUM_VERTICES);
+      const u32 index_bytes = generator.GetIndexLen() * sizeof(u16);
+
+      // Throughput is given in generated index bytes.
+      const double gb_per_second = MeasureThroughput(index_bytes, [&] {
+        generator.Start(indices.data());
+        for (u32 i = 0; i < NUM_PRIMITIVES; ++i)
+          generator.AddIndices(primitive, NUM_VERTICES);
+      });
+      PrintResult("IndexGenerator", "Host",
+                  fmt::format("{}{}", primitive, primitive_restart ? ", primitive restart" : ""),
+                  gb_per_second);
+    }
+  }
+  g_Config.backend_info.bSupportsPrimitiveRestart = supports_primitive_restart;
+}
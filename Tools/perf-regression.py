@@ -0,0 +1,90 @@
+#! /usr/bin/env python3
+
+"""
+perf-regression.py <dolphin-emu-nogui> <suite.json> <output.json> [--baseline <old.json>]
+
+Boots every run of a suite headless with DolphinNoGUI's --perf_report and
+merges the reports into one file. With --baseline, the emulation speed and
+frame times are compared to an earlier output and the script fails if any run
+got slower than --tolerance allows.
+
+A suite is a list of runs:
+
+  [
+    {"name": "sms-intro", "game": "/games/GMSE01.rvz", "movie": "/movies/sms.dtm",
+     "frames": 3600, "args": ["-C", "Dolphin.Core.CPUCore=1"]}
+  ]
+
+"movie", "frames" and "args" are optional. For results that can be compared
+from run to run, use a movie that starts from a save state and a dedicated
+user directory (--user) so that no local settings leak in.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+def run(dolphin, user_dir, entry, report_path):
+    cmd = [dolphin, '--platform', 'headless', '--perf_report', report_path,
+           '--perf_frames', str(entry.get('frames', 3600))]
+    if user_dir:
+        cmd += ['--user', user_dir]
+    if 'movie' in entry:
+        cmd += ['--movie', entry['movie']]
+    cmd += entry.get('args', [])
+    cmd += ['--exec', entry['game']]
+    subprocess.run(cmd, check=True)
+    with open(report_path) as f:
+        return json.load(f)
+
+def compare(results, baseline, tolerance):
+    '''Returns the names of the runs that regressed.'''
+    regressed = []
+    for name, report in results.items():
+        old = baseline.get(name)
+        if old is None:
+            continue
+        speed = report['emulation_speed'] / old['emulation_speed'] - 1
+        p99 = report['frame_time_us']['p99'] / max(old['frame_time_us']['p99'], 1) - 1
+        print('%-24s speed %+6.1f%%  p99 frame time %+6.1f%%' % (name, speed * 100, p99 * 100))
+        if speed < -tolerance or p99 > tolerance:
+            regressed.append(name)
+    return regressed
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('dolphin')
+    parser.add_argument('suite')
+    parser.add_argument('output')
+    parser.add_argument('--user', help='user directory to pass to every run')
+    parser.add_argument('--baseline', help='an earlier output to compare against')
+    parser.add_argument('--tolerance', type=float, default=0.05,
+                        help='allowed relative slowdown [default: %(default)s]')
+    args = parser.parse_args()
+
+    with open(args.suite) as f:
+        suite = json.load(f)
+
+    results = {}
+    with tempfile.TemporaryDirectory() as temp_dir:
+        for entry in suite:
+            name = entry.get('name', os.path.basename(entry['game']))
+            results[name] = run(args.dolphin, args.user, entry,
+                                os.path.join(temp_dir, 'report.json'))
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            regressed = compare(results, json.load(f), args.tolerance)
+        if regressed:
+            print('Regressed: ' + ', '.join(regressed))
+            return 1
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())